@@ -7,6 +7,10 @@ AC_DEFUN([AX_LIBVMDK_CHECK_LOCAL],
   [dnl Check for internationalization functions in libvmdk/libvmdk_i18n.c
   AC_CHECK_FUNCS([bindtextdomain])
 
+  dnl Check for the monotonic clock used in libvmdk/libvmdk_statistics.c
+  AC_SEARCH_LIBS([clock_gettime], [rt])
+  AC_CHECK_FUNCS([clock_gettime])
+
   dnl Check if library should be build with verbose output
   AX_COMMON_CHECK_ENABLE_VERBOSE_OUTPUT
 
@@ -54,6 +58,32 @@ AC_DEFUN([AX_VMDKTOOLS_CHECK_LOCAL],
     [AC_CHECK_FUNCS([getegid geteuid time])
   ])
 
+  dnl Headers and functions included in vmdktools/export_handle.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([fcntl.h])
+
+    AC_CHECK_FUNCS([copy_file_range fileno open splice])
+  ])
+
+  dnl Functions included in vmdktools/parent_registry.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_FUNCS([realpath])
+  ])
+
+  dnl Headers and functions included in vmdktools/nbd_handle.c
+  AS_IF(
+    [test "x$ac_cv_enable_winapi" = xno],
+    [AC_CHECK_HEADERS([netinet/in.h netinet/tcp.h poll.h sys/socket.h sys/un.h])
+
+    AC_CHECK_FUNCS([accept bind listen poll socket unlink])
+  ])
+
+  dnl Check for the monotonic clock used in vmdktools/bench_handle.c
+  AC_SEARCH_LIBS([clock_gettime], [rt])
+  AC_CHECK_FUNCS([clock_gettime])
+
   dnl Check if tools should be build as static executables
   AX_COMMON_CHECK_ENABLE_STATIC_EXECUTABLES
 
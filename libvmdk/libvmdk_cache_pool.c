@@ -0,0 +1,995 @@
+/*
+ * Cache pool functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_cache_pool.h"
+#include "libvmdk_definitions.h"
+#include "libvmdk_grain_data.h"
+#include "libvmdk_io_handle.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_libfcache.h"
+
+/* Creates a cache pool
+ * Make sure the value cache_pool is referencing, is set to NULL
+ *
+ * The maximum cache size is the budget of cached grain data shared by all
+ * the handles attached to the cache pool. The budget is divided over
+ * partitions and the grain data of the handles is spread over the partitions,
+ * so that handles compete for cache entries fairly and reads of different
+ * handles seldom contend for the same partition. The number of cache entries
+ * is based on a grain size of 64 KiB and is reduced when a handle with larger
+ * grains is attached.
+ *
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_pool_initialize(
+     libvmdk_cache_pool_t **cache_pool,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_cache_pool_t *internal_cache_pool = NULL;
+	static char *function                              = "libvmdk_cache_pool_initialize";
+	size64_t number_of_partition_entries               = 0;
+	int partition_index                                = 0;
+
+	if( cache_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cache_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid cache pool value already set.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_partition_entries = maximum_cache_size
+	                            / LIBVMDK_CACHE_POOL_GRAIN_SIZE
+	                            / LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS;
+
+	if( number_of_partition_entries == 0 )
+	{
+		number_of_partition_entries = 1;
+	}
+	if( number_of_partition_entries > (size64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid maximum cache size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache_pool = memory_allocate_structure(
+	                       libvmdk_internal_cache_pool_t );
+
+	if( internal_cache_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create cache pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_cache_pool,
+	     0,
+	     sizeof( libvmdk_internal_cache_pool_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear cache pool.",
+		 function );
+
+		memory_free(
+		 internal_cache_pool );
+
+		return( -1 );
+	}
+	internal_cache_pool->maximum_cache_size          = maximum_cache_size;
+	internal_cache_pool->grain_size                  = LIBVMDK_CACHE_POOL_GRAIN_SIZE;
+	internal_cache_pool->number_of_partition_entries = (int) number_of_partition_entries;
+
+	for( partition_index = 0;
+	     partition_index < LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS;
+	     partition_index++ )
+	{
+		if( libfcache_cache_initialize(
+		     &( internal_cache_pool->grains_caches[ partition_index ] ),
+		     internal_cache_pool->number_of_partition_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create grains cache: %d.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_initialize(
+		     &( internal_cache_pool->partition_mutexes[ partition_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to intialize partition: %d mutex.",
+			 function,
+			 partition_index );
+
+			goto on_error;
+		}
+#endif
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_initialize(
+	     &( internal_cache_pool->read_write_lock ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to intialize read/write lock.",
+		 function );
+
+		goto on_error;
+	}
+#endif
+	*cache_pool = (libvmdk_cache_pool_t *) internal_cache_pool;
+
+	return( 1 );
+
+on_error:
+	if( internal_cache_pool != NULL )
+	{
+		for( partition_index = 0;
+		     partition_index < LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS;
+		     partition_index++ )
+		{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+			if( internal_cache_pool->partition_mutexes[ partition_index ] != NULL )
+			{
+				libcthreads_mutex_free(
+				 &( internal_cache_pool->partition_mutexes[ partition_index ] ),
+				 NULL );
+			}
+#endif
+			if( internal_cache_pool->grains_caches[ partition_index ] != NULL )
+			{
+				libfcache_cache_free(
+				 &( internal_cache_pool->grains_caches[ partition_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 internal_cache_pool );
+	}
+	return( -1 );
+}
+
+/* Frees a cache pool
+ * The cache pool must outlive the handles that are attached to it
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_pool_free(
+     libvmdk_cache_pool_t **cache_pool,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_cache_pool_t *internal_cache_pool = NULL;
+	static char *function                              = "libvmdk_cache_pool_free";
+	int partition_index                                = 0;
+	int result                                         = 1;
+
+	if( cache_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( *cache_pool != NULL )
+	{
+		internal_cache_pool = (libvmdk_internal_cache_pool_t *) *cache_pool;
+		*cache_pool         = NULL;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_read_write_lock_free(
+		     &( internal_cache_pool->read_write_lock ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free read/write lock.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		for( partition_index = 0;
+		     partition_index < LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS;
+		     partition_index++ )
+		{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+			if( libcthreads_mutex_free(
+			     &( internal_cache_pool->partition_mutexes[ partition_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free partition: %d mutex.",
+				 function,
+				 partition_index );
+
+				result = -1;
+			}
+#endif
+			if( libfcache_cache_free(
+			     &( internal_cache_pool->grains_caches[ partition_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free grains cache: %d.",
+				 function,
+				 partition_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 internal_cache_pool );
+	}
+	return( result );
+}
+
+/* Retrieves the maximum cache size
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_pool_get_maximum_cache_size(
+     libvmdk_cache_pool_t *cache_pool,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_cache_pool_t *internal_cache_pool = NULL;
+	static char *function                              = "libvmdk_cache_pool_get_maximum_cache_size";
+
+	if( cache_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache_pool = (libvmdk_internal_cache_pool_t *) cache_pool;
+
+	if( maximum_cache_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid maximum cache size.",
+		 function );
+
+		return( -1 );
+	}
+	*maximum_cache_size = internal_cache_pool->maximum_cache_size;
+
+	return( 1 );
+}
+
+/* Resizes the grains caches for a specific grain size
+ * The grains caches are recreated and the cached grain data is freed,
+ * hence no grains cache can be grabbed by the caller
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_pool_resize_grains_caches(
+     libvmdk_internal_cache_pool_t *internal_cache_pool,
+     size64_t grain_size,
+     libcerror_error_t **error )
+{
+	static char *function                = "libvmdk_cache_pool_resize_grains_caches";
+	size64_t number_of_partition_entries = 0;
+	int partition_index                  = 0;
+	int result                           = 1;
+
+	if( internal_cache_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_size < LIBVMDK_CACHE_POOL_GRAIN_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid grain size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	/* The number of cache entries does not exceed that of a grain size
+	 * of 64 KiB, which was checked on initialization
+	 */
+	number_of_partition_entries = internal_cache_pool->maximum_cache_size
+	                            / grain_size
+	                            / LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS;
+
+	if( number_of_partition_entries == 0 )
+	{
+		number_of_partition_entries = 1;
+	}
+	internal_cache_pool->grain_size = grain_size;
+
+	if( (int) number_of_partition_entries == internal_cache_pool->number_of_partition_entries )
+	{
+		return( 1 );
+	}
+	internal_cache_pool->number_of_partition_entries = (int) number_of_partition_entries;
+
+	for( partition_index = 0;
+	     partition_index < LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS;
+	     partition_index++ )
+	{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_cache_pool->partition_mutexes[ partition_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab partition: %d mutex.",
+			 function,
+			 partition_index );
+
+			return( -1 );
+		}
+#endif
+		if( libfcache_cache_free(
+		     &( internal_cache_pool->grains_caches[ partition_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free grains cache: %d.",
+			 function,
+			 partition_index );
+
+			result = -1;
+		}
+		else if( libfcache_cache_initialize(
+		          &( internal_cache_pool->grains_caches[ partition_index ] ),
+		          internal_cache_pool->number_of_partition_entries,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create grains cache: %d.",
+			 function,
+			 partition_index );
+
+			result = -1;
+		}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_cache_pool->partition_mutexes[ partition_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release partition: %d mutex.",
+			 function,
+			 partition_index );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Attaches a handle to the cache pool
+ * The handle identifier is unique for the handles attached to the cache pool
+ * The grains caches are resized when the grain size of the handle exceeds
+ * the grain size the number of cache entries is based on, so that the cached
+ * grain data does not exceed the maximum cache size
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_pool_attach_handle(
+     libvmdk_cache_pool_t *cache_pool,
+     size64_t grain_size,
+     int *handle_identifier,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_cache_pool_t *internal_cache_pool = NULL;
+	static char *function                              = "libvmdk_cache_pool_attach_handle";
+	int result                                         = 1;
+
+	if( cache_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache_pool = (libvmdk_internal_cache_pool_t *) cache_pool;
+
+	if( handle_identifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle identifier.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_cache_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( grain_size > internal_cache_pool->grain_size )
+	{
+		if( libvmdk_cache_pool_resize_grains_caches(
+		     internal_cache_pool,
+		     grain_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize grains caches.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 1 )
+	{
+		*handle_identifier = internal_cache_pool->next_handle_identifier;
+
+		if( internal_cache_pool->next_handle_identifier < INT_MAX )
+		{
+			internal_cache_pool->next_handle_identifier += 1;
+		}
+		else
+		{
+			internal_cache_pool->next_handle_identifier = 0;
+		}
+		internal_cache_pool->number_of_handles += 1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_cache_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Detaches a handle from the cache pool
+ * The grain data cached for the handle, identified by its IO handle, is removed from the cache pool
+ * since it must not be used after the handle is closed
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_pool_detach_handle(
+     libvmdk_cache_pool_t *cache_pool,
+     libvmdk_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	libfcache_cache_value_t *cache_value               = NULL;
+	libvmdk_grain_data_t *grain_data                   = NULL;
+	libvmdk_internal_cache_pool_t *internal_cache_pool = NULL;
+	static char *function                              = "libvmdk_cache_pool_detach_handle";
+	int cache_entry_index                              = 0;
+	int number_of_cache_entries                        = 0;
+	int partition_index                                = 0;
+	int result                                         = 1;
+
+	if( cache_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache_pool = (libvmdk_internal_cache_pool_t *) cache_pool;
+
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( partition_index = 0;
+	     partition_index < LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS;
+	     partition_index++ )
+	{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_grab(
+		     internal_cache_pool->partition_mutexes[ partition_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab partition: %d mutex.",
+			 function,
+			 partition_index );
+
+			return( -1 );
+		}
+#endif
+		if( libfcache_cache_get_number_of_entries(
+		     internal_cache_pool->grains_caches[ partition_index ],
+		     &number_of_cache_entries,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of entries of grains cache: %d.",
+			 function,
+			 partition_index );
+
+			result = -1;
+		}
+		for( cache_entry_index = 0;
+		     ( result == 1 ) && ( cache_entry_index < number_of_cache_entries );
+		     cache_entry_index++ )
+		{
+			if( libfcache_cache_get_value_by_index(
+			     internal_cache_pool->grains_caches[ partition_index ],
+			     cache_entry_index,
+			     &cache_value,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve cache value: %d from grains cache: %d.",
+				 function,
+				 cache_entry_index,
+				 partition_index );
+
+				result = -1;
+
+				break;
+			}
+			if( cache_value == NULL )
+			{
+				continue;
+			}
+			grain_data = NULL;
+
+			if( libfcache_cache_value_get_value(
+			     cache_value,
+			     (intptr_t **) &grain_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve grain data from cache value: %d of grains cache: %d.",
+				 function,
+				 cache_entry_index,
+				 partition_index );
+
+				result = -1;
+
+				break;
+			}
+			if( ( grain_data == NULL )
+			 || ( grain_data->io_handle != io_handle ) )
+			{
+				continue;
+			}
+			if( libfcache_cache_clear_value_by_index(
+			     internal_cache_pool->grains_caches[ partition_index ],
+			     cache_entry_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_REMOVE_FAILED,
+				 "%s: unable to clear cache value: %d of grains cache: %d.",
+				 function,
+				 cache_entry_index,
+				 partition_index );
+
+				result = -1;
+
+				break;
+			}
+		}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		if( libcthreads_mutex_release(
+		     internal_cache_pool->partition_mutexes[ partition_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release partition: %d mutex.",
+			 function,
+			 partition_index );
+
+			return( -1 );
+		}
+#endif
+		if( result != 1 )
+		{
+			return( -1 );
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_cache_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_cache_pool->number_of_handles > 0 )
+	{
+		internal_cache_pool->number_of_handles -= 1;
+	}
+	/* Once no handles are attached the number of cache entries is based
+	 * on the grain size of 64 KiB again
+	 */
+	if( ( internal_cache_pool->number_of_handles == 0 )
+	 && ( internal_cache_pool->grain_size > LIBVMDK_CACHE_POOL_GRAIN_SIZE ) )
+	{
+		if( libvmdk_cache_pool_resize_grains_caches(
+		     internal_cache_pool,
+		     LIBVMDK_CACHE_POOL_GRAIN_SIZE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_RESIZE_FAILED,
+			 "%s: unable to resize grains caches.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_cache_pool->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determines the partition that caches the grain data of a handle at a specific offset
+ * Consecutive regions of a handle, and the same region of different handles,
+ * map onto different partitions
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_pool_get_partition_index(
+     libvmdk_cache_pool_t *cache_pool,
+     int handle_identifier,
+     off64_t offset,
+     int *partition_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_cache_pool_get_partition_index";
+
+	if( cache_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( handle_identifier < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid handle identifier value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition index.",
+		 function );
+
+		return( -1 );
+	}
+	*partition_index = (int) ( ( (uint64_t) handle_identifier + ( (uint64_t) offset >> LIBVMDK_CACHE_POOL_REGION_SIZE_SHIFT ) )
+	                         % LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS );
+
+	return( 1 );
+}
+
+/* Grabs the grains cache of a partition
+ * The grains cache must be released with libvmdk_cache_pool_release_grains_cache
+ * after the cached grain data is no longer used
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_pool_grab_grains_cache(
+     libvmdk_cache_pool_t *cache_pool,
+     int partition_index,
+     libfcache_cache_t **grains_cache,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_cache_pool_t *internal_cache_pool = NULL;
+	static char *function                              = "libvmdk_cache_pool_grab_grains_cache";
+
+	if( cache_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache pool.",
+		 function );
+
+		return( -1 );
+	}
+	internal_cache_pool = (libvmdk_internal_cache_pool_t *) cache_pool;
+
+	if( ( partition_index < 0 )
+	 || ( partition_index >= LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( grains_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grains cache.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_mutex_grab(
+	     internal_cache_pool->partition_mutexes[ partition_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab partition: %d mutex.",
+		 function,
+		 partition_index );
+
+		return( -1 );
+	}
+#endif
+	*grains_cache = internal_cache_pool->grains_caches[ partition_index ];
+
+	return( 1 );
+}
+
+/* Releases the grains cache of a partition
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_cache_pool_release_grains_cache(
+     libvmdk_cache_pool_t *cache_pool,
+     int partition_index,
+     libcerror_error_t **error )
+{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libvmdk_internal_cache_pool_t *internal_cache_pool = NULL;
+#endif
+	static char *function                              = "libvmdk_cache_pool_release_grains_cache";
+
+	if( cache_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( partition_index < 0 )
+	 || ( partition_index >= LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid partition index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	internal_cache_pool = (libvmdk_internal_cache_pool_t *) cache_pool;
+
+	if( libcthreads_mutex_release(
+	     internal_cache_pool->partition_mutexes[ partition_index ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release partition: %d mutex.",
+		 function,
+		 partition_index );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
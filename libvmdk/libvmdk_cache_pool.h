@@ -0,0 +1,136 @@
+/*
+ * Cache pool functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_CACHE_POOL_H )
+#define _LIBVMDK_CACHE_POOL_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_extern.h"
+#include "libvmdk_io_handle.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_libfcache.h"
+#include "libvmdk_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_internal_cache_pool libvmdk_internal_cache_pool_t;
+
+struct libvmdk_internal_cache_pool
+{
+	/* The maximum cache size
+	 */
+	size64_t maximum_cache_size;
+
+	/* The grain size the number of cache entries is based on,
+	 * which is the largest grain size of the attached handles
+	 */
+	size64_t grain_size;
+
+	/* The number of cache entries per partition
+	 */
+	int number_of_partition_entries;
+
+	/* The number of attached handles
+	 */
+	int number_of_handles;
+
+	/* The identifier of the next attached handle
+	 */
+	int next_handle_identifier;
+
+	/* The grains caches of the partitions
+	 */
+	libfcache_cache_t *grains_caches[ LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS ];
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The mutexes of the partitions
+	 */
+	libcthreads_mutex_t *partition_mutexes[ LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS ];
+
+	/* The read/write lock
+	 */
+	libcthreads_read_write_lock_t *read_write_lock;
+#endif
+};
+
+LIBVMDK_EXTERN \
+int libvmdk_cache_pool_initialize(
+     libvmdk_cache_pool_t **cache_pool,
+     size64_t maximum_cache_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_cache_pool_free(
+     libvmdk_cache_pool_t **cache_pool,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_cache_pool_get_maximum_cache_size(
+     libvmdk_cache_pool_t *cache_pool,
+     size64_t *maximum_cache_size,
+     libcerror_error_t **error );
+
+int libvmdk_cache_pool_resize_grains_caches(
+     libvmdk_internal_cache_pool_t *internal_cache_pool,
+     size64_t grain_size,
+     libcerror_error_t **error );
+
+int libvmdk_cache_pool_attach_handle(
+     libvmdk_cache_pool_t *cache_pool,
+     size64_t grain_size,
+     int *handle_identifier,
+     libcerror_error_t **error );
+
+int libvmdk_cache_pool_detach_handle(
+     libvmdk_cache_pool_t *cache_pool,
+     libvmdk_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libvmdk_cache_pool_get_partition_index(
+     libvmdk_cache_pool_t *cache_pool,
+     int handle_identifier,
+     off64_t offset,
+     int *partition_index,
+     libcerror_error_t **error );
+
+int libvmdk_cache_pool_grab_grains_cache(
+     libvmdk_cache_pool_t *cache_pool,
+     int partition_index,
+     libfcache_cache_t **grains_cache,
+     libcerror_error_t **error );
+
+int libvmdk_cache_pool_release_grains_cache(
+     libvmdk_cache_pool_t *cache_pool,
+     int partition_index,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_CACHE_POOL_H ) */
+
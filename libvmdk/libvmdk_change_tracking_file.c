@@ -0,0 +1,1240 @@
+/*
+ * Change tracking file functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_change_tracking_file.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcnotify.h"
+
+#include "vmdk_change_tracking_file_header.h"
+
+const uint8_t vmdk_change_tracking_file_signature[ 4 ] = { 0xa2, 0x72, 0x19, 0xf6 };
+
+/* The change identifier consists of the change tracking identifier formatted as:
+ * "xx xx xx xx xx xx xx xx-xx xx xx xx xx xx xx xx" followed by "/" and the sequence number
+ */
+#define LIBVMDK_CHANGE_IDENTIFIER_UUID_LENGTH	47
+
+/* Creates a change tracking file
+ * Make sure the value change_tracking_file is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_initialize(
+     libvmdk_change_tracking_file_t **change_tracking_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_change_tracking_file_initialize";
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *change_tracking_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid change tracking file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*change_tracking_file = memory_allocate_structure(
+	                         libvmdk_change_tracking_file_t );
+
+	if( *change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create change tracking file.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *change_tracking_file,
+	     0,
+	     sizeof( libvmdk_change_tracking_file_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear change tracking file.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *change_tracking_file != NULL )
+	{
+		memory_free(
+		 *change_tracking_file );
+
+		*change_tracking_file = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a change tracking file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_free(
+     libvmdk_change_tracking_file_t **change_tracking_file,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_change_tracking_file_free";
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( *change_tracking_file != NULL )
+	{
+		if( ( *change_tracking_file )->block_sequence_numbers != NULL )
+		{
+			memory_free(
+			 ( *change_tracking_file )->block_sequence_numbers );
+		}
+		memory_free(
+		 *change_tracking_file );
+
+		*change_tracking_file = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads the change tracking file header data
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_read_file_header_data(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function              = "libvmdk_change_tracking_file_read_file_header_data";
+	size64_t expected_number_of_blocks = 0;
+	size_t padding_offset              = 0;
+	uint64_t number_of_blocks          = 0;
+	uint64_t number_of_sectors         = 0;
+	uint32_t block_number_of_sectors   = 0;
+	uint32_t unknown1                  = 0;
+	uint32_t unknown2                  = 0;
+	uint32_t unknown3                  = 0;
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < sizeof( vmdk_change_tracking_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data value too small.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: file header:\n",
+		 function );
+		libcnotify_print_data(
+		 data,
+		 sizeof( vmdk_change_tracking_file_header_t ),
+		 LIBCNOTIFY_PRINT_DATA_FLAG_GROUP_DATA );
+	}
+#endif
+	if( memory_compare(
+	     ( (vmdk_change_tracking_file_header_t *) data )->signature,
+	     vmdk_change_tracking_file_signature,
+	     4 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported change tracking file signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->version,
+	 change_tracking_file->format_version );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->unknown1,
+	 unknown1 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->block_number_of_sectors,
+	 block_number_of_sectors );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->number_of_sectors,
+	 number_of_sectors );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->number_of_blocks,
+	 number_of_blocks );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->sequence_number,
+	 change_tracking_file->sequence_number );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->unknown2,
+	 unknown2 );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 ( (vmdk_change_tracking_file_header_t *) data )->unknown3,
+	 unknown3 );
+
+	if( memory_copy(
+	     change_tracking_file->change_tracking_identifier,
+	     ( (vmdk_change_tracking_file_header_t *) data )->change_tracking_identifier,
+	     16 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy change tracking identifier.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: signature\t\t\t\t: 0x%02" PRIx8 " 0x%02" PRIx8 " 0x%02" PRIx8 " 0x%02" PRIx8 "\n",
+		 function,
+		 ( (vmdk_change_tracking_file_header_t *) data )->signature[ 0 ],
+		 ( (vmdk_change_tracking_file_header_t *) data )->signature[ 1 ],
+		 ( (vmdk_change_tracking_file_header_t *) data )->signature[ 2 ],
+		 ( (vmdk_change_tracking_file_header_t *) data )->signature[ 3 ] );
+
+		libcnotify_printf(
+		 "%s: version\t\t\t\t: %" PRIu32 "\n",
+		 function,
+		 change_tracking_file->format_version );
+
+		libcnotify_printf(
+		 "%s: unknown1\t\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 unknown1 );
+
+		libcnotify_printf(
+		 "%s: block number of sectors\t\t: %" PRIu32 "\n",
+		 function,
+		 block_number_of_sectors );
+
+		libcnotify_printf(
+		 "%s: number of sectors\t\t\t: %" PRIu64 "\n",
+		 function,
+		 number_of_sectors );
+
+		libcnotify_printf(
+		 "%s: number of blocks\t\t\t: %" PRIu64 "\n",
+		 function,
+		 number_of_blocks );
+
+		libcnotify_printf(
+		 "%s: sequence number\t\t\t: %" PRIu32 "\n",
+		 function,
+		 change_tracking_file->sequence_number );
+
+		libcnotify_printf(
+		 "%s: unknown2\t\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 unknown2 );
+
+		libcnotify_printf(
+		 "%s: unknown3\t\t\t\t: 0x%08" PRIx32 "\n",
+		 function,
+		 unknown3 );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	if( change_tracking_file->format_version != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported format version: %" PRIu32 ".",
+		 function,
+		 change_tracking_file->format_version );
+
+		return( -1 );
+	}
+	if( block_number_of_sectors == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block number of sectors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_sectors > ( (uint64_t) INT64_MAX / 512 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of sectors value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	expected_number_of_blocks = number_of_sectors / block_number_of_sectors;
+
+	if( ( number_of_sectors % block_number_of_sectors ) != 0 )
+	{
+		expected_number_of_blocks += 1;
+	}
+	if( ( number_of_blocks != (uint64_t) expected_number_of_blocks )
+	 || ( number_of_blocks > (uint64_t) UINT32_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of blocks: %" PRIu64 " does not match number of sectors.",
+		 function,
+		 number_of_blocks );
+
+		return( -1 );
+	}
+	change_tracking_file->number_of_blocks = (uint32_t) number_of_blocks;
+	change_tracking_file->block_size = (size64_t) block_number_of_sectors * 512;
+	change_tracking_file->media_size = (size64_t) number_of_sectors * 512;
+
+	/* The layout of the file header is not fully known, if any of the unknown
+	 * values is set the block sequence numbers are not trusted
+	 */
+	change_tracking_file->has_unexpected_values = 0;
+
+	if( ( unknown1 != 0 )
+	 || ( unknown2 != 0 )
+	 || ( unknown3 != 0 ) )
+	{
+		change_tracking_file->has_unexpected_values = 1;
+	}
+	for( padding_offset = 0;
+	     padding_offset < 452;
+	     padding_offset++ )
+	{
+		if( ( (vmdk_change_tracking_file_header_t *) data )->padding[ padding_offset ] != 0 )
+		{
+			change_tracking_file->has_unexpected_values = 1;
+
+			break;
+		}
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( ( libcnotify_verbose != 0 )
+	 && ( change_tracking_file->has_unexpected_values != 0 ) )
+	{
+		libcnotify_printf(
+		 "%s: file header contains unexpected values, all blocks are considered changed.\n",
+		 function );
+	}
+#endif
+	return( 1 );
+}
+
+/* Reads the change tracking file block entries data
+ * The file header data must be read before the block entries data
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_read_block_entries_data(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_change_tracking_file_read_block_entries_data";
+	size_t data_offset    = 0;
+	uint32_t block_index  = 0;
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( change_tracking_file->block_sequence_numbers != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid change tracking file - block sequence numbers value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( change_tracking_file->number_of_blocks == 0 )
+	 || ( (size_t) change_tracking_file->number_of_blocks > ( (size_t) SSIZE_MAX / 4 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid change tracking file - number of blocks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < ( (size_t) change_tracking_file->number_of_blocks * 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data value too small.",
+		 function );
+
+		return( -1 );
+	}
+	change_tracking_file->block_sequence_numbers = (uint32_t *) memory_allocate(
+	                                                             sizeof( uint32_t ) * change_tracking_file->number_of_blocks );
+
+	if( change_tracking_file->block_sequence_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block sequence numbers.",
+		 function );
+
+		return( -1 );
+	}
+	for( block_index = 0;
+	     block_index < change_tracking_file->number_of_blocks;
+	     block_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( data[ data_offset ] ),
+		 change_tracking_file->block_sequence_numbers[ block_index ] );
+
+		data_offset += 4;
+
+		if( change_tracking_file->block_sequence_numbers[ block_index ] > change_tracking_file->sequence_number )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid block: %" PRIu32 " sequence number value out of bounds.",
+			 function,
+			 block_index );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( change_tracking_file->block_sequence_numbers != NULL )
+	{
+		memory_free(
+		 change_tracking_file->block_sequence_numbers );
+
+		change_tracking_file->block_sequence_numbers = NULL;
+	}
+	return( -1 );
+}
+
+/* Reads the change tracking file using a Basic File IO (bfio) handle
+ * Any data after the block entries is expected to be 0-byte values
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_read_file_io_handle(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ sizeof( vmdk_change_tracking_file_header_t ) ];
+	uint8_t trailing_data[ 512 ];
+
+	uint8_t *block_entries_data    = NULL;
+	static char *function          = "libvmdk_change_tracking_file_read_file_io_handle";
+	size_t block_entries_data_size = 0;
+	ssize_t data_offset            = 0;
+	ssize_t read_count             = 0;
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file header offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              file_header_data,
+	              sizeof( vmdk_change_tracking_file_header_t ),
+	              error );
+
+	if( read_count != (ssize_t) sizeof( vmdk_change_tracking_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_change_tracking_file_read_file_header_data(
+	     change_tracking_file,
+	     file_header_data,
+	     sizeof( vmdk_change_tracking_file_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	if( (size_t) change_tracking_file->number_of_blocks > ( (size_t) SSIZE_MAX / 4 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of blocks value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	block_entries_data_size = (size_t) change_tracking_file->number_of_blocks * 4;
+
+	block_entries_data = (uint8_t *) memory_allocate(
+	                                  sizeof( uint8_t ) * block_entries_data_size );
+
+	if( block_entries_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block entries data.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              block_entries_data,
+	              block_entries_data_size,
+	              error );
+
+	if( read_count != (ssize_t) block_entries_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block entries data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_change_tracking_file_read_block_entries_data(
+	     change_tracking_file,
+	     block_entries_data,
+	     block_entries_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read block entries.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 block_entries_data );
+
+	block_entries_data = NULL;
+
+	/* The layout of the data after the block entries is not known, if any
+	 * of it is set the block sequence numbers are not trusted
+	 */
+	while( change_tracking_file->has_unexpected_values == 0 )
+	{
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              trailing_data,
+		              512,
+		              error );
+
+		if( read_count < 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read trailing data.",
+			 function );
+
+			goto on_error;
+		}
+		for( data_offset = 0;
+		     data_offset < read_count;
+		     data_offset++ )
+		{
+			if( trailing_data[ data_offset ] != 0 )
+			{
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: trailing data contains unexpected values, all blocks are considered changed.\n",
+					 function );
+				}
+#endif
+				change_tracking_file->has_unexpected_values = 1;
+
+				break;
+			}
+		}
+		if( read_count < 512 )
+		{
+			break;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( block_entries_data != NULL )
+	{
+		memory_free(
+		 block_entries_data );
+	}
+	return( -1 );
+}
+
+/* Retrieves the size of the UTF-8 encoded change identifier
+ * The size includes the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_get_utf8_change_identifier_size(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	static char *function    = "libvmdk_change_tracking_file_get_utf8_change_identifier_size";
+	uint32_t sequence_number = 0;
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The UUID, the "/" separator, at least 1 digit and the end of string character
+	 */
+	*utf8_string_size = LIBVMDK_CHANGE_IDENTIFIER_UUID_LENGTH + 3;
+
+	for( sequence_number = change_tracking_file->sequence_number;
+	     sequence_number >= 10;
+	     sequence_number /= 10 )
+	{
+		*utf8_string_size += 1;
+	}
+	return( 1 );
+}
+
+/* Retrieves the UTF-8 encoded change identifier
+ * The change identifier refers to the current state of the change tracking file
+ * The size should include the end of string character
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_get_utf8_change_identifier(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	const char *hexadecimal_digits = "0123456789abcdef";
+	static char *function          = "libvmdk_change_tracking_file_get_utf8_change_identifier";
+	size_t required_string_size    = 0;
+	size_t string_index            = 0;
+	uint32_t sequence_number       = 0;
+	uint8_t byte_value             = 0;
+	int byte_index                 = 0;
+
+	if( libvmdk_change_tracking_file_get_utf8_change_identifier_size(
+	     change_tracking_file,
+	     &required_string_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 change identifier size.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_size < required_string_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid UTF-8 string size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	for( byte_index = 0;
+	     byte_index < 16;
+	     byte_index++ )
+	{
+		byte_value = change_tracking_file->change_tracking_identifier[ byte_index ];
+
+		if( byte_index == 8 )
+		{
+			utf8_string[ string_index++ ] = (uint8_t) '-';
+		}
+		else if( byte_index > 0 )
+		{
+			utf8_string[ string_index++ ] = (uint8_t) ' ';
+		}
+		utf8_string[ string_index++ ] = (uint8_t) hexadecimal_digits[ byte_value >> 4 ];
+		utf8_string[ string_index++ ] = (uint8_t) hexadecimal_digits[ byte_value & 0x0f ];
+	}
+	utf8_string[ string_index++ ] = (uint8_t) '/';
+
+	/* Write the sequence number digits from the end of the string backwards
+	 */
+	string_index    = required_string_size - 1;
+	sequence_number = change_tracking_file->sequence_number;
+
+	utf8_string[ string_index ] = 0;
+
+	do
+	{
+		string_index--;
+
+		utf8_string[ string_index ] = (uint8_t) '0' + (uint8_t) ( sequence_number % 10 );
+
+		sequence_number /= 10;
+	}
+	while( sequence_number > 0 );
+
+	return( 1 );
+}
+
+/* Retrieves the sequence number of an UTF-8 encoded change identifier
+ * The change identifier "*" refers to the state when change tracking was enabled
+ * and corresponds to sequence number 0
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *sequence_number,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier";
+	size_t string_index        = 0;
+	uint64_t value_64bit       = 0;
+	uint8_t byte_value         = 0;
+	uint8_t character_value    = 0;
+	uint8_t expected_separator = 0;
+	int byte_index             = 0;
+	int nibble_index           = 0;
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid UTF-8 string.",
+		 function );
+
+		return( -1 );
+	}
+	if( utf8_string_length > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid UTF-8 string length value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( sequence_number == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid sequence number.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( utf8_string_length == 1 )
+	 && ( utf8_string[ 0 ] == (uint8_t) '*' ) )
+	{
+		*sequence_number = 0;
+
+		return( 1 );
+	}
+	/* The UUID, the "/" separator and 1 to 10 digits
+	 */
+	if( ( utf8_string_length < ( LIBVMDK_CHANGE_IDENTIFIER_UUID_LENGTH + 2 ) )
+	 || ( utf8_string_length > ( LIBVMDK_CHANGE_IDENTIFIER_UUID_LENGTH + 11 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported change identifier.",
+		 function );
+
+		return( -1 );
+	}
+	for( byte_index = 0;
+	     byte_index < 16;
+	     byte_index++ )
+	{
+		if( byte_index > 0 )
+		{
+			if( byte_index == 8 )
+			{
+				expected_separator = (uint8_t) '-';
+			}
+			else
+			{
+				expected_separator = (uint8_t) ' ';
+			}
+			if( utf8_string[ string_index++ ] != expected_separator )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported change identifier - invalid separator at index: %" PRIzd ".",
+				 function,
+				 string_index - 1 );
+
+				return( -1 );
+			}
+		}
+		byte_value = 0;
+
+		for( nibble_index = 0;
+		     nibble_index < 2;
+		     nibble_index++ )
+		{
+			character_value = utf8_string[ string_index++ ];
+
+			byte_value <<= 4;
+
+			if( ( character_value >= (uint8_t) '0' )
+			 && ( character_value <= (uint8_t) '9' ) )
+			{
+				byte_value |= character_value - (uint8_t) '0';
+			}
+			else if( ( character_value >= (uint8_t) 'a' )
+			      && ( character_value <= (uint8_t) 'f' ) )
+			{
+				byte_value |= character_value - (uint8_t) 'a' + 10;
+			}
+			else if( ( character_value >= (uint8_t) 'A' )
+			      && ( character_value <= (uint8_t) 'F' ) )
+			{
+				byte_value |= character_value - (uint8_t) 'A' + 10;
+			}
+			else
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+				 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported change identifier - invalid hexadecimal digit at index: %" PRIzd ".",
+				 function,
+				 string_index - 1 );
+
+				return( -1 );
+			}
+		}
+		if( byte_value != change_tracking_file->change_tracking_identifier[ byte_index ] )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: change identifier does not match change tracking identifier.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( utf8_string[ string_index++ ] != (uint8_t) '/' )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported change identifier - missing sequence number.",
+		 function );
+
+		return( -1 );
+	}
+	while( string_index < utf8_string_length )
+	{
+		character_value = utf8_string[ string_index++ ];
+
+		if( ( character_value < (uint8_t) '0' )
+		 || ( character_value > (uint8_t) '9' ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported change identifier - invalid sequence number.",
+			 function );
+
+			return( -1 );
+		}
+		value_64bit *= 10;
+		value_64bit += character_value - (uint8_t) '0';
+	}
+	if( value_64bit > (uint64_t) change_tracking_file->sequence_number )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid change identifier - sequence number value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*sequence_number = (uint32_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Retrieves the next range of blocks that changed after a specific sequence number
+ * The search starts at the offset, the range is clipped to the media size
+ * If the file header contains unexpected values the remainder of the media is considered changed
+ * Returns 1 if successful, 0 if no changed range was found or -1 on error
+ */
+int libvmdk_change_tracking_file_get_next_changed_block_range(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     uint32_t sequence_number,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	static char *function     = "libvmdk_change_tracking_file_get_next_changed_block_range";
+	size64_t range_end_offset = 0;
+	uint64_t block_index      = 0;
+	uint64_t last_block_index = 0;
+
+	if( change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid change tracking file.",
+		 function );
+
+		return( -1 );
+	}
+	if( change_tracking_file->block_sequence_numbers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid change tracking file - missing block sequence numbers.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= change_tracking_file->media_size )
+	{
+		return( 0 );
+	}
+	if( change_tracking_file->has_unexpected_values != 0 )
+	{
+		*range_offset = offset;
+		*range_size   = change_tracking_file->media_size - (size64_t) offset;
+
+		return( 1 );
+	}
+	for( block_index = (uint64_t) offset / change_tracking_file->block_size;
+	     block_index < (uint64_t) change_tracking_file->number_of_blocks;
+	     block_index++ )
+	{
+		if( change_tracking_file->block_sequence_numbers[ block_index ] > sequence_number )
+		{
+			break;
+		}
+	}
+	if( block_index >= (uint64_t) change_tracking_file->number_of_blocks )
+	{
+		return( 0 );
+	}
+	for( last_block_index = block_index + 1;
+	     last_block_index < (uint64_t) change_tracking_file->number_of_blocks;
+	     last_block_index++ )
+	{
+		if( change_tracking_file->block_sequence_numbers[ last_block_index ] <= sequence_number )
+		{
+			break;
+		}
+	}
+	*range_offset    = (off64_t) ( block_index * change_tracking_file->block_size );
+	range_end_offset = last_block_index * change_tracking_file->block_size;
+
+	if( *range_offset < offset )
+	{
+		*range_offset = offset;
+	}
+	if( range_end_offset > change_tracking_file->media_size )
+	{
+		range_end_offset = change_tracking_file->media_size;
+	}
+	*range_size = range_end_offset - (size64_t) *range_offset;
+
+	return( 1 );
+}
+
@@ -0,0 +1,132 @@
+/*
+ * Change tracking file functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_CHANGE_TRACKING_FILE_H )
+#define _LIBVMDK_CHANGE_TRACKING_FILE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+extern const uint8_t vmdk_change_tracking_file_signature[ 4 ];
+
+typedef struct libvmdk_change_tracking_file libvmdk_change_tracking_file_t;
+
+struct libvmdk_change_tracking_file
+{
+	/* The format version
+	 */
+	uint32_t format_version;
+
+	/* The block size
+	 */
+	size64_t block_size;
+
+	/* The (storage) media size
+	 */
+	size64_t media_size;
+
+	/* The number of blocks
+	 */
+	uint32_t number_of_blocks;
+
+	/* The (current) change sequence number
+	 */
+	uint32_t sequence_number;
+
+	/* The change tracking identifier
+	 */
+	uint8_t change_tracking_identifier[ 16 ];
+
+	/* The block sequence numbers
+	 * Contains the sequence number of the last change per block
+	 */
+	uint32_t *block_sequence_numbers;
+
+	/* Value to indicate the file header or the data after the block entries
+	 * contains unexpected values in which case the block sequence numbers are not trusted
+	 */
+	uint8_t has_unexpected_values;
+};
+
+int libvmdk_change_tracking_file_initialize(
+     libvmdk_change_tracking_file_t **change_tracking_file,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_free(
+     libvmdk_change_tracking_file_t **change_tracking_file,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_read_file_header_data(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_read_block_entries_data(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_read_file_io_handle(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_get_utf8_change_identifier_size(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_get_utf8_change_identifier(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     const uint8_t *utf8_string,
+     size_t utf8_string_length,
+     uint32_t *sequence_number,
+     libcerror_error_t **error );
+
+int libvmdk_change_tracking_file_get_next_changed_block_range(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     uint32_t sequence_number,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_CHANGE_TRACKING_FILE_H ) */
+
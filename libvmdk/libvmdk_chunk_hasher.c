@@ -0,0 +1,760 @@
+/*
+ * Chunk hasher functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_chunk_hasher.h"
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcnotify.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_sha256.h"
+
+/* Creates a chunk hasher
+ * Make sure the value chunk_hasher is referencing, is set to NULL
+ * A number of threads of 0 hashes the chunks in the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_chunk_hasher_initialize(
+     libvmdk_chunk_hasher_t **chunk_hasher,
+     size_t chunk_size,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_chunk_hasher_initialize";
+	int chunk_index       = 0;
+
+	if( chunk_hasher == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hasher.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_hasher != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid chunk hasher value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( chunk_size == 0 )
+	 || ( chunk_size > (size_t) ( SSIZE_MAX / ( 2 * LIBVMDK_MAXIMUM_NUMBER_OF_THREADS ) ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBVMDK_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*chunk_hasher = memory_allocate_structure(
+	                 libvmdk_chunk_hasher_t );
+
+	if( *chunk_hasher == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk hasher.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *chunk_hasher,
+	     0,
+	     sizeof( libvmdk_chunk_hasher_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunk hasher.",
+		 function );
+
+		memory_free(
+		 *chunk_hasher );
+
+		*chunk_hasher = NULL;
+
+		return( -1 );
+	}
+	( *chunk_hasher )->chunk_size        = chunk_size;
+	( *chunk_hasher )->number_of_threads = number_of_threads;
+
+	/* Keep twice as many chunks pending as there are threads so that
+	 * the next chunks are read while the previous ones are hashed
+	 */
+	if( number_of_threads > 0 )
+	{
+		( *chunk_hasher )->number_of_chunks = 2 * number_of_threads;
+	}
+	else
+	{
+		( *chunk_hasher )->number_of_chunks = 1;
+	}
+	( *chunk_hasher )->chunks = (libvmdk_chunk_hasher_chunk_t *) memory_allocate(
+	                                                              sizeof( libvmdk_chunk_hasher_chunk_t ) * ( *chunk_hasher )->number_of_chunks );
+
+	if( ( *chunk_hasher )->chunks == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunks.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *chunk_hasher )->chunks,
+	     0,
+	     sizeof( libvmdk_chunk_hasher_chunk_t ) * ( *chunk_hasher )->number_of_chunks ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear chunks.",
+		 function );
+
+		memory_free(
+		 ( *chunk_hasher )->chunks );
+
+		( *chunk_hasher )->chunks = NULL;
+
+		goto on_error;
+	}
+	for( chunk_index = 0;
+	     chunk_index < ( *chunk_hasher )->number_of_chunks;
+	     chunk_index++ )
+	{
+		( *chunk_hasher )->chunks[ chunk_index ].data = (uint8_t *) memory_allocate(
+		                                                             sizeof( uint8_t ) * chunk_size );
+
+		if( ( *chunk_hasher )->chunks[ chunk_index ].data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create data of chunk: %d.",
+			 function,
+			 chunk_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 0 )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( ( *chunk_hasher )->chunks_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunks mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_condition_initialize(
+		     &( ( *chunk_hasher )->chunks_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create chunks condition.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &( ( *chunk_hasher )->hashing_thread_pool ),
+		     NULL,
+		     number_of_threads,
+		     ( *chunk_hasher )->number_of_chunks,
+		     (int (*)(intptr_t *, void *)) &libvmdk_chunk_hasher_hash_chunk_callback,
+		     (void *) *chunk_hasher,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create hashing thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *chunk_hasher != NULL )
+	{
+		libvmdk_chunk_hasher_free(
+		 chunk_hasher,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a chunk hasher
+ * This waits for the chunks that are still being hashed
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_chunk_hasher_free(
+     libvmdk_chunk_hasher_t **chunk_hasher,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_chunk_hasher_free";
+	int chunk_index       = 0;
+	int result            = 1;
+
+	if( chunk_hasher == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hasher.",
+		 function );
+
+		return( -1 );
+	}
+	if( *chunk_hasher != NULL )
+	{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		/* Joining the thread pool waits for the chunks that are still being hashed
+		 */
+		if( ( *chunk_hasher )->hashing_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *chunk_hasher )->hashing_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join hashing thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *chunk_hasher )->chunks_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *chunk_hasher )->chunks_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunks condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *chunk_hasher )->chunks_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *chunk_hasher )->chunks_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free chunks mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *chunk_hasher )->chunks != NULL )
+		{
+			for( chunk_index = 0;
+			     chunk_index < ( *chunk_hasher )->number_of_chunks;
+			     chunk_index++ )
+			{
+				if( ( *chunk_hasher )->chunks[ chunk_index ].data != NULL )
+				{
+					memory_free(
+					 ( *chunk_hasher )->chunks[ chunk_index ].data );
+				}
+			}
+			memory_free(
+			 ( *chunk_hasher )->chunks );
+		}
+		memory_free(
+		 *chunk_hasher );
+
+		*chunk_hasher = NULL;
+	}
+	return( result );
+}
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+/* Hashes a chunk from a hashing thread
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_chunk_hasher_hash_chunk_callback(
+     libvmdk_chunk_hasher_chunk_t *chunk,
+     libvmdk_chunk_hasher_t *chunk_hasher )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libvmdk_chunk_hasher_hash_chunk_callback";
+	int result               = 0;
+
+	if( ( chunk == NULL )
+	 || ( chunk_hasher == NULL ) )
+	{
+		return( -1 );
+	}
+	result = libvmdk_sha256_calculate_digest(
+	          chunk->data,
+	          chunk->data_size,
+	          chunk->digest,
+	          LIBVMDK_SHA256_DIGEST_SIZE,
+	          &error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate digest of chunk.",
+		 function );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	/* Signal the hasher that the chunk was processed
+	 */
+	if( libcthreads_mutex_grab(
+	     chunk_hasher->chunks_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	chunk->result       = result;
+	chunk->is_processed = 1;
+
+	if( libcthreads_condition_broadcast(
+	     chunk_hasher->chunks_condition,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     chunk_hasher->chunks_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+/* Retrieves the data of the next chunk to submit
+ * If all chunks are pending this waits for the first pending chunk to be hashed
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_chunk_hasher_get_chunk_data(
+     libvmdk_chunk_hasher_t *chunk_hasher,
+     uint8_t **chunk_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_chunk_hasher_get_chunk_data";
+	int chunk_index       = 0;
+
+	if( chunk_hasher == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hasher.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk data.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_hasher->number_of_pending_chunks >= chunk_hasher->number_of_chunks )
+	{
+		if( libvmdk_chunk_hasher_check_pending_chunk(
+		     chunk_hasher,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to check pending chunk.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	chunk_index = ( chunk_hasher->first_pending_chunk + chunk_hasher->number_of_pending_chunks )
+	            % chunk_hasher->number_of_chunks;
+
+	*chunk_data = chunk_hasher->chunks[ chunk_index ].data;
+
+	return( 1 );
+}
+
+/* Submits the chunk data that was read for hashing
+ * The digest must refer to LIBVMDK_SHA256_DIGEST_SIZE bytes that remain valid until the chunk was checked
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_chunk_hasher_submit_chunk(
+     libvmdk_chunk_hasher_t *chunk_hasher,
+     size_t chunk_data_size,
+     uint8_t *digest,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *hashing_error    = NULL;
+	libvmdk_chunk_hasher_chunk_t *chunk = NULL;
+	static char *function               = "libvmdk_chunk_hasher_submit_chunk";
+	int chunk_index                     = 0;
+
+	if( chunk_hasher == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hasher.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_data_size > chunk_hasher->chunk_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid chunk data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_hasher->number_of_pending_chunks >= chunk_hasher->number_of_chunks )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of pending chunks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	chunk_index = ( chunk_hasher->first_pending_chunk + chunk_hasher->number_of_pending_chunks )
+	            % chunk_hasher->number_of_chunks;
+
+	chunk = &( chunk_hasher->chunks[ chunk_index ] );
+
+	chunk->data_size    = chunk_data_size;
+	chunk->digest       = digest;
+	chunk->is_processed = 0;
+	chunk->result       = 0;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( chunk_hasher->hashing_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_push(
+		     chunk_hasher->hashing_thread_pool,
+		     (intptr_t *) chunk,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push chunk onto hashing thread pool.",
+			 function );
+
+			return( -1 );
+		}
+		chunk_hasher->number_of_pending_chunks += 1;
+
+		return( 1 );
+	}
+#endif
+	chunk->result = libvmdk_sha256_calculate_digest(
+	                 chunk->data,
+	                 chunk->data_size,
+	                 chunk->digest,
+	                 LIBVMDK_SHA256_DIGEST_SIZE,
+	                 &hashing_error );
+
+	if( chunk->result != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 hashing_error );
+		}
+#endif
+		libcerror_error_free(
+		 &hashing_error );
+	}
+	chunk->is_processed = 1;
+
+	chunk_hasher->number_of_pending_chunks += 1;
+
+	return( 1 );
+}
+
+/* Waits for the first pending chunk to be hashed and checks its result
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_chunk_hasher_check_pending_chunk(
+     libvmdk_chunk_hasher_t *chunk_hasher,
+     libcerror_error_t **error )
+{
+	libvmdk_chunk_hasher_chunk_t *chunk = NULL;
+	static char *function               = "libvmdk_chunk_hasher_check_pending_chunk";
+
+	if( chunk_hasher == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hasher.",
+		 function );
+
+		return( -1 );
+	}
+	if( chunk_hasher->number_of_pending_chunks <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid chunk hasher - missing pending chunks.",
+		 function );
+
+		return( -1 );
+	}
+	chunk = &( chunk_hasher->chunks[ chunk_hasher->first_pending_chunk ] );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( chunk_hasher->hashing_thread_pool != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     chunk_hasher->chunks_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab chunks mutex.",
+			 function );
+
+			return( -1 );
+		}
+		while( chunk->is_processed == 0 )
+		{
+			if( libcthreads_condition_wait(
+			     chunk_hasher->chunks_condition,
+			     chunk_hasher->chunks_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for chunks condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 chunk_hasher->chunks_mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( libcthreads_mutex_release(
+		     chunk_hasher->chunks_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release chunks mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	chunk_hasher->first_pending_chunk += 1;
+
+	if( chunk_hasher->first_pending_chunk >= chunk_hasher->number_of_chunks )
+	{
+		chunk_hasher->first_pending_chunk = 0;
+	}
+	chunk_hasher->number_of_pending_chunks -= 1;
+
+	if( chunk->result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate digest of chunk.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Waits for all pending chunks to be hashed
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_chunk_hasher_flush(
+     libvmdk_chunk_hasher_t *chunk_hasher,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_chunk_hasher_flush";
+
+	if( chunk_hasher == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk hasher.",
+		 function );
+
+		return( -1 );
+	}
+	while( chunk_hasher->number_of_pending_chunks > 0 )
+	{
+		if( libvmdk_chunk_hasher_check_pending_chunk(
+		     chunk_hasher,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to check pending chunk.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
@@ -0,0 +1,147 @@
+/*
+ * Chunk hasher functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_CHUNK_HASHER_H )
+#define _LIBVMDK_CHUNK_HASHER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_chunk_hasher_chunk libvmdk_chunk_hasher_chunk_t;
+
+struct libvmdk_chunk_hasher_chunk
+{
+	/* The data
+	 */
+	uint8_t *data;
+
+	/* The data size
+	 */
+	size_t data_size;
+
+	/* The digest
+	 * Refers to the location where the digest of the chunk is stored
+	 */
+	uint8_t *digest;
+
+	/* The result of hashing the chunk
+	 */
+	int result;
+
+	/* Value to indicate the chunk was processed
+	 */
+	uint8_t is_processed;
+};
+
+typedef struct libvmdk_chunk_hasher libvmdk_chunk_hasher_t;
+
+struct libvmdk_chunk_hasher
+{
+	/* The chunk size
+	 */
+	size_t chunk_size;
+
+	/* The number of hashing threads
+	 */
+	int number_of_threads;
+
+	/* The chunks
+	 * Used as a ring buffer of the chunks that are being hashed
+	 */
+	libvmdk_chunk_hasher_chunk_t *chunks;
+
+	/* The number of chunks
+	 */
+	int number_of_chunks;
+
+	/* The index of the first pending chunk
+	 */
+	int first_pending_chunk;
+
+	/* The number of pending chunks
+	 */
+	int number_of_pending_chunks;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The hashing thread pool
+	 */
+	libcthreads_thread_pool_t *hashing_thread_pool;
+
+	/* The chunks mutex
+	 */
+	libcthreads_mutex_t *chunks_mutex;
+
+	/* The chunks condition
+	 */
+	libcthreads_condition_t *chunks_condition;
+#endif
+};
+
+int libvmdk_chunk_hasher_initialize(
+     libvmdk_chunk_hasher_t **chunk_hasher,
+     size_t chunk_size,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libvmdk_chunk_hasher_free(
+     libvmdk_chunk_hasher_t **chunk_hasher,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+int libvmdk_chunk_hasher_hash_chunk_callback(
+     libvmdk_chunk_hasher_chunk_t *chunk,
+     libvmdk_chunk_hasher_t *chunk_hasher );
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+int libvmdk_chunk_hasher_get_chunk_data(
+     libvmdk_chunk_hasher_t *chunk_hasher,
+     uint8_t **chunk_data,
+     libcerror_error_t **error );
+
+int libvmdk_chunk_hasher_submit_chunk(
+     libvmdk_chunk_hasher_t *chunk_hasher,
+     size_t chunk_data_size,
+     uint8_t *digest,
+     libcerror_error_t **error );
+
+int libvmdk_chunk_hasher_check_pending_chunk(
+     libvmdk_chunk_hasher_t *chunk_hasher,
+     libcerror_error_t **error );
+
+int libvmdk_chunk_hasher_flush(
+     libvmdk_chunk_hasher_t *chunk_hasher,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_CHUNK_HASHER_H ) */
+
@@ -36,6 +36,183 @@
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libcnotify.h"
 
+/* Compresses data using the compression method
+ * Returns 1 on success, 0 if the compressed data buffer is too small or -1 on error
+ * If the compressed data buffer is too small the required size is set in compressed data size
+ */
+int libvmdk_compress_data(
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error )
+{
+	static char *function            = "libvmdk_compress_data";
+	int result                       = 0;
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	uLongf zlib_compressed_data_size = 0;
+#endif
+
+	if( compressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compressed_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data == compressed_data )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid compressed data buffer equals uncompressed data buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( compression_method == LIBVMDK_COMPRESSION_METHOD_DEFLATE )
+	{
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+		if( uncompressed_data_size > (size_t) ULONG_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid uncompressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		if( *compressed_data_size > (size_t) ULONG_MAX )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid compressed data size value exceeds maximum.",
+			 function );
+
+			return( -1 );
+		}
+		zlib_compressed_data_size = (uLongf) *compressed_data_size;
+
+		result = compress2(
+			  (Bytef *) compressed_data,
+			  &zlib_compressed_data_size,
+			  (Bytef *) uncompressed_data,
+			  (uLong) uncompressed_data_size,
+			  compression_level );
+
+		if( result == Z_OK )
+		{
+			*compressed_data_size = (size_t) zlib_compressed_data_size;
+
+			result = 1;
+		}
+		else if( result == Z_BUF_ERROR )
+		{
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "%s: unable to write compressed data: target buffer too small.\n",
+				 function );
+			}
+#endif
+#if defined( HAVE_ZLIB_COMPRESSBOUND ) || defined( ZLIB_DLL )
+			*compressed_data_size = (size_t) compressBound(
+			                                  (uLong) uncompressed_data_size );
+#else
+			/* Use the zlib worst case estimate of the compressed data size
+			 */
+			*compressed_data_size = uncompressed_data_size
+			                      + ( uncompressed_data_size / 1000 ) + 13;
+#endif
+			result = 0;
+		}
+		else if( result == Z_MEM_ERROR )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to write compressed data: insufficient memory.",
+			 function );
+
+			*compressed_data_size = 0;
+
+			result = -1;
+		}
+		else
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: zlib returned undefined error: %d.",
+			 function,
+			 result );
+
+			*compressed_data_size = 0;
+
+			result = -1;
+		}
+#else
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: missing support for deflate compression.",
+		 function );
+
+		return( -1 );
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+	}
+	else
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported compression method.",
+		 function );
+
+		return( -1 );
+	}
+	return( result );
+}
+
 /* Decompresses data using the compression method
  * Returns 1 on success, 0 on failure or -1 on error
  */
@@ -31,6 +31,15 @@
 extern "C" {
 #endif
 
+int libvmdk_compress_data(
+     uint8_t *compressed_data,
+     size_t *compressed_data_size,
+     uint16_t compression_method,
+     int compression_level,
+     const uint8_t *uncompressed_data,
+     size_t uncompressed_data_size,
+     libcerror_error_t **error );
+
 int libvmdk_decompress_data(
      const uint8_t *compressed_data,
      size_t compressed_data_size,
@@ -0,0 +1,719 @@
+/*
+ * Delta (child) disk functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_delta_disk.h"
+#include "libvmdk_extent_file.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+
+#include "vmdk_sparse_file_header.h"
+
+/* The number of sectors reserved for the embedded descriptor
+ */
+#define LIBVMDK_DELTA_DISK_DESCRIPTOR_NUMBER_OF_SECTORS		20
+
+/* The number of grain table entries of a delta disk
+ */
+#define LIBVMDK_DELTA_DISK_NUMBER_OF_GRAIN_TABLE_ENTRIES	512
+
+/* Determines if the grain size is supported by the delta disk writer
+ * The grain size must be a power of 2 of at least 16 sectors and at most 1 MiB
+ * Returns 1 if supported, 0 if not
+ */
+int libvmdk_delta_disk_is_supported_grain_size(
+     size64_t grain_size )
+{
+	if( ( grain_size < LIBVMDK_DELTA_DISK_MINIMUM_GRAIN_SIZE )
+	 || ( grain_size > LIBVMDK_DELTA_DISK_MAXIMUM_GRAIN_SIZE )
+	 || ( ( grain_size & ( grain_size - 1 ) ) != 0 ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Determines the size of the metadata of a delta disk
+ * The metadata consists of the file header, the embedded descriptor,
+ * the secondary and the primary grain directory and is rounded up to the grain size
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_delta_disk_get_metadata_size(
+     size64_t media_size,
+     size64_t grain_size,
+     size_t *grain_directory_size,
+     size_t *metadata_size,
+     libcerror_error_t **error )
+{
+	static char *function                      = "libvmdk_delta_disk_get_metadata_size";
+	size64_t grain_table_media_size            = 0;
+	size64_t number_of_grain_directory_entries = 0;
+	size64_t safe_metadata_size                = 0;
+	size_t safe_grain_directory_size           = 0;
+
+	if( ( media_size == 0 )
+	 || ( ( media_size % 512 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_delta_disk_is_supported_grain_size(
+	     grain_size ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported grain size: %" PRIu64 ".",
+		 function,
+		 grain_size );
+
+		return( -1 );
+	}
+	if( grain_directory_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory size.",
+		 function );
+
+		return( -1 );
+	}
+	if( metadata_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid metadata size.",
+		 function );
+
+		return( -1 );
+	}
+	grain_table_media_size = (size64_t) LIBVMDK_DELTA_DISK_NUMBER_OF_GRAIN_TABLE_ENTRIES * grain_size;
+
+	number_of_grain_directory_entries = media_size / grain_table_media_size;
+
+	if( ( media_size % grain_table_media_size ) != 0 )
+	{
+		number_of_grain_directory_entries += 1;
+	}
+	if( number_of_grain_directory_entries > (size64_t) ( ( SSIZE_MAX / 4 ) - 512 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	safe_grain_directory_size = (size_t) number_of_grain_directory_entries * 4;
+
+	if( ( safe_grain_directory_size % 512 ) != 0 )
+	{
+		safe_grain_directory_size += 512 - ( safe_grain_directory_size % 512 );
+	}
+	safe_metadata_size = 512
+	                   + ( LIBVMDK_DELTA_DISK_DESCRIPTOR_NUMBER_OF_SECTORS * 512 )
+	                   + ( 2 * (size64_t) safe_grain_directory_size );
+
+	if( ( safe_metadata_size % grain_size ) != 0 )
+	{
+		safe_metadata_size += grain_size - ( safe_metadata_size % grain_size );
+	}
+	if( safe_metadata_size > (size64_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid metadata size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	*grain_directory_size = safe_grain_directory_size;
+	*metadata_size        = (size_t) safe_metadata_size;
+
+	return( 1 );
+}
+
+/* Writes an empty monolithic sparse disk
+ * If a parent filename is provided the disk is a delta disk that refers to its parent
+ * otherwise the parent content identifier is ignored
+ * If no extent filename is provided the extent is written without an embedded
+ * descriptor, as used by the extents of a split sparse disk
+ * The grain directories are written without grain tables, the grain tables are
+ * allocated on demand when the disk is written to
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_delta_disk_write(
+     libbfio_handle_t *file_io_handle,
+     size64_t media_size,
+     size64_t grain_size,
+     uint32_t content_identifier,
+     uint32_t parent_content_identifier,
+     const uint8_t *parent_filename,
+     size_t parent_filename_size,
+     const uint8_t *extent_filename,
+     size_t extent_filename_size,
+     libcerror_error_t **error )
+{
+	vmdk_sparse_file_header_t *file_header = NULL;
+	uint8_t *metadata                      = NULL;
+	static char *function                  = "libvmdk_delta_disk_write";
+	size64_t number_of_cylinders           = 0;
+	size_t descriptor_size                 = 0;
+	size_t grain_directory_size            = 0;
+	size_t metadata_size                   = 0;
+	ssize_t write_count                    = 0;
+	uint64_t grain_directory_sector_number = 0;
+	int print_count                        = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( parent_filename != NULL )
+	 && ( ( parent_filename_size <= 1 )
+	  || ( parent_filename_size > (size_t) SSIZE_MAX )
+	  || ( parent_filename[ parent_filename_size - 1 ] != 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid parent filename size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_filename != NULL )
+	 && ( ( extent_filename_size <= 1 )
+	  || ( extent_filename_size > (size_t) SSIZE_MAX )
+	  || ( extent_filename[ extent_filename_size - 1 ] != 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent filename size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_delta_disk_get_metadata_size(
+	     media_size,
+	     grain_size,
+	     &grain_directory_size,
+	     &metadata_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine metadata size.",
+		 function );
+
+		return( -1 );
+	}
+	metadata = (uint8_t *) memory_allocate(
+	                        sizeof( uint8_t ) * metadata_size );
+
+	if( metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata.",
+		 function );
+
+		goto on_error;
+	}
+	/* Empty grain directories indicate that none of the grain tables is allocated
+	 */
+	if( memory_set(
+	     metadata,
+	     0,
+	     metadata_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear metadata.",
+		 function );
+
+		goto on_error;
+	}
+	file_header = (vmdk_sparse_file_header_t *) metadata;
+
+	if( memory_copy(
+	     file_header->signature,
+	     vmdk_sparse_file_signature,
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		goto on_error;
+	}
+	grain_directory_sector_number = 1 + LIBVMDK_DELTA_DISK_DESCRIPTOR_NUMBER_OF_SECTORS;
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->version,
+	 1 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->flags,
+	 LIBVMDK_FLAG_NEW_LINE_DETECION_VALID | LIBVMDK_FLAG_USE_SECONDARY_GRAIN_DIRECTORY );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->maximum_data_number_of_sectors,
+	 media_size / 512 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->grain_number_of_sectors,
+	 (uint64_t) ( grain_size / 512 ) );
+
+	/* The sectors reserved for the embedded descriptor are kept when there is
+	 * no embedded descriptor so that all extents share the same layout
+	 */
+	if( extent_filename != NULL )
+	{
+		byte_stream_copy_from_uint64_little_endian(
+		 file_header->descriptor_sector_number,
+		 (uint64_t) 1 );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 file_header->descriptor_number_of_sectors,
+		 (uint64_t) LIBVMDK_DELTA_DISK_DESCRIPTOR_NUMBER_OF_SECTORS );
+	}
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->number_of_grain_table_entries,
+	 LIBVMDK_DELTA_DISK_NUMBER_OF_GRAIN_TABLE_ENTRIES );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->secondary_grain_directory_sector_number,
+	 grain_directory_sector_number );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->primary_grain_directory_sector_number,
+	 grain_directory_sector_number + ( grain_directory_size / 512 ) );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->metadata_number_of_sectors,
+	 (uint64_t) ( metadata_size / 512 ) );
+
+	file_header->single_end_of_line_character        = (uint8_t) '\n';
+	file_header->non_end_of_line_character           = (uint8_t) ' ';
+	file_header->first_double_end_of_line_character  = (uint8_t) '\r';
+	file_header->second_double_end_of_line_character = (uint8_t) '\n';
+
+	byte_stream_copy_from_uint16_little_endian(
+	 file_header->compression_method,
+	 LIBVMDK_COMPRESSION_METHOD_NONE );
+
+	if( parent_filename == NULL )
+	{
+		parent_content_identifier = 0xffffffffUL;
+	}
+	if( extent_filename != NULL )
+	{
+		number_of_cylinders = media_size / ( 255 * 63 * 512 );
+
+		if( number_of_cylinders > 65535 )
+		{
+			number_of_cylinders = 65535;
+		}
+		descriptor_size = LIBVMDK_DELTA_DISK_DESCRIPTOR_NUMBER_OF_SECTORS * 512;
+
+		print_count = narrow_string_snprintf(
+		               (char *) &( metadata[ 512 ] ),
+		               descriptor_size,
+		               "# Disk DescriptorFile\n"
+		               "version=1\n"
+		               "encoding=\"UTF-8\"\n"
+		               "CID=%08" PRIx32 "\n"
+		               "parentCID=%08" PRIx32 "\n"
+		               "createType=\"monolithicSparse\"\n"
+		               "%s%s%s"
+		               "\n"
+		               "# Extent description\n"
+		               "RW %" PRIu64 " SPARSE \"%s\"\n"
+		               "\n"
+		               "# The Disk Data Base\n"
+		               "#DDB\n"
+		               "\n"
+		               "ddb.virtualHWVersion = \"4\"\n"
+		               "ddb.geometry.cylinders = \"%" PRIu64 "\"\n"
+		               "ddb.geometry.heads = \"255\"\n"
+		               "ddb.geometry.sectors = \"63\"\n"
+		               "ddb.adapterType = \"lsilogic\"\n",
+		               content_identifier,
+		               parent_content_identifier,
+		               ( parent_filename != NULL ) ? "parentFileNameHint=\"" : "",
+		               ( parent_filename != NULL ) ? (char *) parent_filename : "",
+		               ( parent_filename != NULL ) ? "\"\n" : "",
+		               media_size / 512,
+		               (char *) extent_filename,
+		               number_of_cylinders );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= descriptor_size ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set descriptor.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek file header offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               metadata,
+	               metadata_size,
+	               error );
+
+	if( write_count != (ssize_t) metadata_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write metadata.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 metadata );
+
+	return( 1 );
+
+on_error:
+	if( metadata != NULL )
+	{
+		memory_free(
+		 metadata );
+	}
+	return( -1 );
+}
+
+/* Writes the descriptor file of an empty split (2GB extent) sparse disk
+ * The extent files are named: prefix-s###.vmdk where ### is the number of the extent
+ * starting with 001
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_delta_disk_write_split_descriptor(
+     libbfio_handle_t *file_io_handle,
+     size64_t media_size,
+     size64_t extent_media_size,
+     uint32_t content_identifier,
+     const uint8_t *extent_filename_prefix,
+     size_t extent_filename_prefix_size,
+     libcerror_error_t **error )
+{
+	uint8_t *descriptor           = NULL;
+	static char *function         = "libvmdk_delta_disk_write_split_descriptor";
+	size64_t extent_size          = 0;
+	size64_t number_of_cylinders  = 0;
+	size64_t remaining_media_size = 0;
+	size_t descriptor_offset      = 0;
+	size_t descriptor_size        = 0;
+	ssize_t write_count           = 0;
+	uint64_t number_of_extents    = 0;
+	uint64_t extent_number        = 0;
+	int print_count               = 0;
+
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_media_size == 0 )
+	 || ( ( extent_media_size % LIBVMDK_DELTA_DISK_MAXIMUM_GRAIN_SIZE ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_filename_prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent filename prefix.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_filename_prefix_size <= 1 )
+	 || ( extent_filename_prefix_size > (size_t) ( SSIZE_MAX / 1024 ) )
+	 || ( extent_filename_prefix[ extent_filename_prefix_size - 1 ] != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent filename prefix size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_extents = media_size / extent_media_size;
+
+	if( ( media_size % extent_media_size ) != 0 )
+	{
+		number_of_extents += 1;
+	}
+	if( ( number_of_extents == 0 )
+	 || ( number_of_extents > 999 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of extents value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Each extent description line consists of the prefix and at most 64 other characters
+	 */
+	descriptor_size = 1024 + ( (size_t) number_of_extents * ( extent_filename_prefix_size + 64 ) );
+
+	descriptor = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * descriptor_size );
+
+	if( descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	print_count = narrow_string_snprintf(
+	               (char *) descriptor,
+	               descriptor_size,
+	               "# Disk DescriptorFile\n"
+	               "version=1\n"
+	               "encoding=\"UTF-8\"\n"
+	               "CID=%08" PRIx32 "\n"
+	               "parentCID=ffffffff\n"
+	               "createType=\"twoGbMaxExtentSparse\"\n"
+	               "\n"
+	               "# Extent description\n",
+	               content_identifier );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= descriptor_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	descriptor_offset    = (size_t) print_count;
+	remaining_media_size = media_size;
+
+	for( extent_number = 1;
+	     extent_number <= number_of_extents;
+	     extent_number++ )
+	{
+		extent_size = extent_media_size;
+
+		if( extent_size > remaining_media_size )
+		{
+			extent_size = remaining_media_size;
+		}
+		print_count = narrow_string_snprintf(
+		               (char *) &( descriptor[ descriptor_offset ] ),
+		               descriptor_size - descriptor_offset,
+		               "RW %" PRIu64 " SPARSE \"%s-s%03" PRIu64 ".vmdk\"\n",
+		               extent_size / 512,
+		               (char *) extent_filename_prefix,
+		               extent_number );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( descriptor_size - descriptor_offset ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set extent: %" PRIu64 " description.",
+			 function,
+			 extent_number );
+
+			goto on_error;
+		}
+		descriptor_offset    += (size_t) print_count;
+		remaining_media_size -= extent_size;
+	}
+	number_of_cylinders = media_size / ( 255 * 63 * 512 );
+
+	if( number_of_cylinders > 65535 )
+	{
+		number_of_cylinders = 65535;
+	}
+	print_count = narrow_string_snprintf(
+	               (char *) &( descriptor[ descriptor_offset ] ),
+	               descriptor_size - descriptor_offset,
+	               "\n"
+	               "# The Disk Data Base\n"
+	               "#DDB\n"
+	               "\n"
+	               "ddb.virtualHWVersion = \"4\"\n"
+	               "ddb.geometry.cylinders = \"%" PRIu64 "\"\n"
+	               "ddb.geometry.heads = \"255\"\n"
+	               "ddb.geometry.sectors = \"63\"\n"
+	               "ddb.adapterType = \"lsilogic\"\n",
+	               number_of_cylinders );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= ( descriptor_size - descriptor_offset ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set disk database.",
+		 function );
+
+		goto on_error;
+	}
+	descriptor_offset += (size_t) print_count;
+
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek descriptor offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               descriptor,
+	               descriptor_offset,
+	               error );
+
+	if( write_count != (ssize_t) descriptor_offset )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 descriptor );
+
+	return( 1 );
+
+on_error:
+	if( descriptor != NULL )
+	{
+		memory_free(
+		 descriptor );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,88 @@
+/*
+ * Delta (child) disk functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_DELTA_DISK_H )
+#define _LIBVMDK_DELTA_DISK_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The maximum size of an extent of a split sparse disk, which is 4192256 sectors
+ */
+#define LIBVMDK_DELTA_DISK_SPLIT_EXTENT_SIZE	(size64_t) 2146435072UL
+
+/* The default grain size of a delta disk, which is 128 sectors
+ */
+#define LIBVMDK_DELTA_DISK_DEFAULT_GRAIN_SIZE	(size64_t) 65536
+
+/* The minimum grain size of a delta disk, which is 16 sectors
+ */
+#define LIBVMDK_DELTA_DISK_MINIMUM_GRAIN_SIZE	(size64_t) 8192
+
+/* The maximum grain size of a delta disk, which is 2048 sectors
+ * The extent size of a split sparse disk is a multiple of the maximum grain size
+ */
+#define LIBVMDK_DELTA_DISK_MAXIMUM_GRAIN_SIZE	(size64_t) 1048576
+
+int libvmdk_delta_disk_is_supported_grain_size(
+     size64_t grain_size );
+
+int libvmdk_delta_disk_get_metadata_size(
+     size64_t media_size,
+     size64_t grain_size,
+     size_t *grain_directory_size,
+     size_t *metadata_size,
+     libcerror_error_t **error );
+
+int libvmdk_delta_disk_write(
+     libbfio_handle_t *file_io_handle,
+     size64_t media_size,
+     size64_t grain_size,
+     uint32_t content_identifier,
+     uint32_t parent_content_identifier,
+     const uint8_t *parent_filename,
+     size_t parent_filename_size,
+     const uint8_t *extent_filename,
+     size_t extent_filename_size,
+     libcerror_error_t **error );
+
+int libvmdk_delta_disk_write_split_descriptor(
+     libbfio_handle_t *file_io_handle,
+     size64_t media_size,
+     size64_t extent_media_size,
+     uint32_t content_identifier,
+     const uint8_t *extent_filename_prefix,
+     size_t extent_filename_prefix_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_DELTA_DISK_H ) */
+
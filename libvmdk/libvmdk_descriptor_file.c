@@ -23,6 +23,7 @@
 #include <file_stream.h>
 #include <memory.h>
 #include <narrow_string.h>
+#include <system_string.h>
 #include <types.h>
 
 #include "libvmdk_definitions.h"
@@ -35,6 +36,7 @@
 #include "libvmdk_libcsplit.h"
 #include "libvmdk_libfvalue.h"
 #include "libvmdk_libuna.h"
+#include "libvmdk_statistics.h"
 
 const char *vmdk_descriptor_file_signature                       = "# Disk DescriptorFile";
 const char *vmdk_descriptor_file_extent_section_signature        = "# Extent description";
@@ -156,6 +158,11 @@ int libvmdk_descriptor_file_free(
 			memory_free(
 			 ( *descriptor_file )->parent_filename );
 		}
+		if( ( *descriptor_file )->change_tracking_file_path != NULL )
+		{
+			memory_free(
+			 ( *descriptor_file )->change_tracking_file_path );
+		}
 		if( libcdata_array_free(
 		     &( ( *descriptor_file )->extents_array ),
 		     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_internal_extent_descriptor_free,
@@ -184,12 +191,16 @@ int libvmdk_descriptor_file_free(
 int libvmdk_descriptor_file_read(
      libvmdk_descriptor_file_t *descriptor_file,
      libbfio_handle_t *file_io_handle,
+     libvmdk_statistics_t *statistics,
      libcerror_error_t **error )
 {
 	uint8_t *descriptor_data = NULL;
 	static char *function    = "libvmdk_descriptor_file_read";
 	size64_t file_size       = 0;
 	ssize_t read_count       = 0;
+	uint64_t end_timestamp   = 0;
+	uint64_t start_timestamp = 0;
+	int timestamp_result     = 0;
 
 	if( descriptor_file == NULL )
 	{
@@ -202,6 +213,10 @@ int libvmdk_descriptor_file_read(
 
 		return( -1 );
 	}
+	timestamp_result = libvmdk_statistics_start_timer(
+	                    statistics,
+	                    &start_timestamp );
+
 	if( libbfio_handle_get_size(
 	     file_io_handle,
 	     &file_size,
@@ -227,6 +242,10 @@ int libvmdk_descriptor_file_read(
 
 		goto on_error;
 	}
+	libvmdk_statistics_add_open_phase_seek(
+	 statistics,
+	 LIBVMDK_OPEN_PHASE_DESCRIPTOR );
+
 	if( libbfio_handle_seek_offset(
 	     file_io_handle,
 	     0,
@@ -262,6 +281,11 @@ int libvmdk_descriptor_file_read(
 	              (size_t) file_size,
 	              error );
 
+	libvmdk_statistics_add_open_phase_read(
+	 statistics,
+	 LIBVMDK_OPEN_PHASE_DESCRIPTOR,
+	 read_count );
+
 	if( read_count != (ssize_t) file_size )
 	{
 		libcerror_error_set(
@@ -293,6 +317,19 @@ int libvmdk_descriptor_file_read(
 
 	descriptor_data = NULL;
 
+	if( timestamp_result == 1 )
+	{
+		timestamp_result = libvmdk_statistics_get_timestamp(
+		                    &end_timestamp );
+	}
+	if( timestamp_result == 1 )
+	{
+		libvmdk_statistics_add_open_phase_time(
+		 statistics,
+		 LIBVMDK_OPEN_PHASE_DESCRIPTOR,
+		 start_timestamp,
+		 end_timestamp );
+	}
 	return( 1 );
 
 on_error:
@@ -1675,6 +1712,7 @@ int libvmdk_descriptor_file_read_change_tracking_file(
 	size_t line_string_segment_size  = 0;
 	size_t value_identifier_length   = 0;
 	size_t value_length              = 0;
+	int result                       = 0;
 
 	if( descriptor_file == NULL )
 	{
@@ -1994,7 +2032,131 @@ int libvmdk_descriptor_file_read_change_tracking_file(
 			     "changeTrackPath",
 			     15 ) == 0 )
 			{
-/* TODO */
+				if( descriptor_file->change_tracking_file_path != NULL )
+				{
+					memory_free(
+					 descriptor_file->change_tracking_file_path );
+
+					descriptor_file->change_tracking_file_path      = NULL;
+					descriptor_file->change_tracking_file_path_size = 0;
+				}
+				if( descriptor_file->encoding != 0 )
+				{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+					result = libuna_utf16_string_size_from_byte_stream(
+					          (uint8_t *) value,
+					          value_length + 1,
+					          descriptor_file->encoding,
+					          &( descriptor_file->change_tracking_file_path_size ),
+					          error );
+#else
+					result = libuna_utf8_string_size_from_byte_stream(
+					          (uint8_t *) value,
+					          value_length + 1,
+					          descriptor_file->encoding,
+					          &( descriptor_file->change_tracking_file_path_size ),
+					          error );
+#endif
+				}
+				else
+				{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+					result = libuna_utf16_string_size_from_utf8_stream(
+					          (uint8_t *) value,
+					          value_length + 1,
+					          &( descriptor_file->change_tracking_file_path_size ),
+					          error );
+#else
+					result = libuna_utf8_string_size_from_utf8_stream(
+					          (uint8_t *) value,
+					          value_length + 1,
+					          &( descriptor_file->change_tracking_file_path_size ),
+					          error );
+#endif
+				}
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine change tracking file path size.",
+					 function );
+
+					goto on_error;
+				}
+				descriptor_file->change_tracking_file_path = system_string_allocate(
+				                                              descriptor_file->change_tracking_file_path_size );
+
+				if( descriptor_file->change_tracking_file_path == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create change tracking file path.",
+					 function );
+
+					goto on_error;
+				}
+				if( descriptor_file->encoding != 0 )
+				{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+					result = libuna_utf16_string_copy_from_byte_stream(
+					          (uint16_t *) descriptor_file->change_tracking_file_path,
+					          descriptor_file->change_tracking_file_path_size,
+					          (uint8_t *) value,
+					          value_length + 1,
+					          descriptor_file->encoding,
+					          error );
+#else
+					result = libuna_utf8_string_copy_from_byte_stream(
+					          (uint8_t *) descriptor_file->change_tracking_file_path,
+					          descriptor_file->change_tracking_file_path_size,
+					          (uint8_t *) value,
+					          value_length + 1,
+					          descriptor_file->encoding,
+					          error );
+#endif
+				}
+				else
+				{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+					result = libuna_utf16_string_copy_from_utf8_stream(
+					          (uint16_t *) descriptor_file->change_tracking_file_path,
+					          descriptor_file->change_tracking_file_path_size,
+					          (uint8_t *) value,
+					          value_length + 1,
+					          error );
+#else
+					result = libuna_utf8_string_copy_from_utf8_stream(
+					          (uint8_t *) descriptor_file->change_tracking_file_path,
+					          descriptor_file->change_tracking_file_path_size,
+					          (uint8_t *) value,
+					          value_length + 1,
+					          error );
+#endif
+				}
+				if( result != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+					 "%s: unable to copy change tracking file path.",
+					 function );
+
+					goto on_error;
+				}
+#if defined( HAVE_DEBUG_OUTPUT )
+				if( libcnotify_verbose != 0 )
+				{
+					libcnotify_printf(
+					 "%s: change tracking file path\t\t: %" PRIs_SYSTEM "\n",
+					 function,
+					 descriptor_file->change_tracking_file_path );
+				}
+#endif
 			}
 		}
 #if defined( HAVE_DEBUG_OUTPUT )
@@ -2018,6 +2180,18 @@ int libvmdk_descriptor_file_read_change_tracking_file(
 	}
 #endif
 	return( 1 );
+
+on_error:
+	if( descriptor_file->change_tracking_file_path != NULL )
+	{
+		memory_free(
+		 descriptor_file->change_tracking_file_path );
+
+		descriptor_file->change_tracking_file_path = NULL;
+	}
+	descriptor_file->change_tracking_file_path_size = 0;
+
+	return( -1 );
 }
 
 /* Reads the disk database from the descriptor file
@@ -31,6 +31,7 @@
 #include "libvmdk_libcdata.h"
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libcsplit.h"
+#include "libvmdk_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -81,6 +82,14 @@ struct libvmdk_descriptor_file
 	/* The extents array
 	 */
 	libcdata_array_t *extents_array;
+
+	/* The change tracking file path
+	 */
+	system_character_t *change_tracking_file_path;
+
+	/* The change tracking file path size
+	 */
+	size_t change_tracking_file_path_size;
 };
 
 int libvmdk_descriptor_file_initialize(
@@ -94,6 +103,7 @@ int libvmdk_descriptor_file_free(
 int libvmdk_descriptor_file_read(
      libvmdk_descriptor_file_t *descriptor_file,
      libbfio_handle_t *file_io_handle,
+     libvmdk_statistics_t *statistics,
      libcerror_error_t **error );
 
 int libvmdk_descriptor_file_read_string(
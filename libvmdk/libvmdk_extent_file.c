@@ -24,6 +24,10 @@
 #include <memory.h>
 #include <types.h>
 
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
 #include "libvmdk_debug.h"
 #include "libvmdk_definitions.h"
 #include "libvmdk_extent_file.h"
@@ -34,8 +38,10 @@
 #include "libvmdk_libcnotify.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_statistics.h"
 #include "libvmdk_types.h"
 #include "libvmdk_unused.h"
+#include "libvmdk_zero_block.h"
 
 #include "cowd_sparse_file_header.h"
 #include "vmdk_sparse_file_header.h"
@@ -268,6 +274,16 @@ int libvmdk_extent_file_check_for_empty_block(
 
 		return( -1 );
 	}
+	/* Blocks filled with 0-byte values are the most common hence use the vectorized check
+	 */
+	if( ( data_size > 0 )
+	 && ( data[ 0 ] == 0 ) )
+	{
+		return( libvmdk_zero_block_check(
+		         data,
+		         data_size,
+		         error ) );
+	}
 	data_start = (uint8_t *) data;
 	data_index = (uint8_t *) data + 1;
 	data_size -= 1;
@@ -334,10 +350,15 @@ int libvmdk_extent_file_read_file_header_file_io_handle(
      off64_t file_offset,
      libcerror_error_t **error )
 {
-	uint8_t *file_header_data = NULL;
-	static char *function     = "libvmdk_extent_file_read_file_header";
-	size_t read_size          = 0;
-	ssize_t read_count        = 0;
+	libvmdk_statistics_t *statistics = NULL;
+	uint8_t *file_header_data        = NULL;
+	static char *function            = "libvmdk_extent_file_read_file_header";
+	size_t read_size                 = 0;
+	ssize_t read_count               = 0;
+	uint64_t end_timestamp           = 0;
+	uint64_t start_timestamp         = 0;
+	int open_phase                   = LIBVMDK_OPEN_PHASE_FILE_HEADER;
+	int timestamp_result             = 0;
 
 	if( extent_file == NULL )
 	{
@@ -360,6 +381,25 @@ int libvmdk_extent_file_read_file_header_file_io_handle(
 		 file_offset );
 	}
 #endif
+	/* The footer of a stream-optimized extent file is a copy of the file header
+	 * that is stored at the end of the file
+	 */
+	if( file_offset != 0 )
+	{
+		open_phase = LIBVMDK_OPEN_PHASE_FILE_FOOTER;
+	}
+	if( extent_file->io_handle != NULL )
+	{
+		statistics = &( extent_file->io_handle->statistics );
+	}
+	timestamp_result = libvmdk_statistics_start_timer(
+	                    statistics,
+	                    &start_timestamp );
+
+	libvmdk_statistics_add_open_phase_seek(
+	 statistics,
+	 open_phase );
+
 	if( libbfio_handle_seek_offset(
 	     file_io_handle,
 	     file_offset,
@@ -397,6 +437,11 @@ int libvmdk_extent_file_read_file_header_file_io_handle(
 	              4,
 	              error );
 
+	libvmdk_statistics_add_open_phase_read(
+	 statistics,
+	 open_phase,
+	 read_count );
+
 	if( read_count != (ssize_t) 4 )
 	{
 		libcerror_error_set(
@@ -439,6 +484,11 @@ int libvmdk_extent_file_read_file_header_file_io_handle(
 	              read_size - 4,
 	              error );
 
+	libvmdk_statistics_add_open_phase_read(
+	 statistics,
+	 open_phase,
+	 read_count );
+
 	if( read_count != (ssize_t) ( read_size - 4 ) )
 	{
 		libcerror_error_set(
@@ -470,6 +520,19 @@ int libvmdk_extent_file_read_file_header_file_io_handle(
 
 	file_header_data = NULL;
 
+	if( timestamp_result == 1 )
+	{
+		timestamp_result = libvmdk_statistics_get_timestamp(
+		                    &end_timestamp );
+	}
+	if( timestamp_result == 1 )
+	{
+		libvmdk_statistics_add_open_phase_time(
+		 statistics,
+		 open_phase,
+		 start_timestamp,
+		 end_timestamp );
+	}
 	return( 1 );
 
 on_error:
@@ -491,10 +554,15 @@ int libvmdk_extent_file_read_file_header(
      off64_t file_offset,
      libcerror_error_t **error )
 {
-	uint8_t *file_header_data = NULL;
-	static char *function     = "libvmdk_extent_file_read_file_header";
-	size_t read_size          = 0;
-	ssize_t read_count        = 0;
+	libvmdk_statistics_t *statistics = NULL;
+	uint8_t *file_header_data        = NULL;
+	static char *function            = "libvmdk_extent_file_read_file_header";
+	size_t read_size                 = 0;
+	ssize_t read_count               = 0;
+	uint64_t end_timestamp           = 0;
+	uint64_t start_timestamp         = 0;
+	int open_phase                   = LIBVMDK_OPEN_PHASE_FILE_HEADER;
+	int timestamp_result             = 0;
 
 	if( extent_file == NULL )
 	{
@@ -517,6 +585,25 @@ int libvmdk_extent_file_read_file_header(
 		 file_offset );
 	}
 #endif
+	/* The footer of a stream-optimized extent file is a copy of the file header
+	 * that is stored at the end of the file
+	 */
+	if( file_offset != 0 )
+	{
+		open_phase = LIBVMDK_OPEN_PHASE_FILE_FOOTER;
+	}
+	if( extent_file->io_handle != NULL )
+	{
+		statistics = &( extent_file->io_handle->statistics );
+	}
+	timestamp_result = libvmdk_statistics_start_timer(
+	                    statistics,
+	                    &start_timestamp );
+
+	libvmdk_statistics_add_open_phase_seek(
+	 statistics,
+	 open_phase );
+
 	if( libbfio_pool_seek_offset(
 	     file_io_pool,
 	     file_io_pool_entry,
@@ -556,6 +643,11 @@ int libvmdk_extent_file_read_file_header(
 	              4,
 	              error );
 
+	libvmdk_statistics_add_open_phase_read(
+	 statistics,
+	 open_phase,
+	 read_count );
+
 	if( read_count != (ssize_t) 4 )
 	{
 		libcerror_error_set(
@@ -599,6 +691,11 @@ int libvmdk_extent_file_read_file_header(
 	              read_size - 4,
 	              error );
 
+	libvmdk_statistics_add_open_phase_read(
+	 statistics,
+	 open_phase,
+	 read_count );
+
 	if( read_count != (ssize_t) ( read_size - 4 ) )
 	{
 		libcerror_error_set(
@@ -630,6 +727,19 @@ int libvmdk_extent_file_read_file_header(
 
 	file_header_data = NULL;
 
+	if( timestamp_result == 1 )
+	{
+		timestamp_result = libvmdk_statistics_get_timestamp(
+		                    &end_timestamp );
+	}
+	if( timestamp_result == 1 )
+	{
+		libvmdk_statistics_add_open_phase_time(
+		 statistics,
+		 open_phase,
+		 start_timestamp,
+		 end_timestamp );
+	}
 	return( 1 );
 
 on_error:
@@ -1276,8 +1386,13 @@ int libvmdk_extent_file_read_descriptor_data_file_io_handle(
      size_t descriptor_data_size,
      libcerror_error_t **error )
 {
-	static char *function = "libvmdk_extent_file_read_descriptor_data_file_io_handle";
-	ssize_t read_count    = 0;
+	libvmdk_statistics_t *statistics = NULL;
+	static char *function            = "libvmdk_extent_file_read_descriptor_data_file_io_handle";
+	ssize_t read_count               = 0;
+	uint64_t end_timestamp           = 0;
+	uint64_t start_timestamp         = 0;
+	int open_phase                   = LIBVMDK_OPEN_PHASE_DESCRIPTOR;
+	int timestamp_result             = 0;
 
 	if( extent_file == NULL )
 	{
@@ -1333,6 +1448,18 @@ int libvmdk_extent_file_read_descriptor_data_file_io_handle(
 		 extent_file->descriptor_offset );
 	}
 #endif
+	if( extent_file->io_handle != NULL )
+	{
+		statistics = &( extent_file->io_handle->statistics );
+	}
+	timestamp_result = libvmdk_statistics_start_timer(
+	                    statistics,
+	                    &start_timestamp );
+
+	libvmdk_statistics_add_open_phase_seek(
+	 statistics,
+	 open_phase );
+
 	if( libbfio_handle_seek_offset(
 	     file_io_handle,
 	     extent_file->descriptor_offset,
@@ -1355,6 +1482,11 @@ int libvmdk_extent_file_read_descriptor_data_file_io_handle(
 	              (size_t) extent_file->descriptor_size,
 	              error );
 
+	libvmdk_statistics_add_open_phase_read(
+	 statistics,
+	 open_phase,
+	 read_count );
+
 	if( read_count != (ssize_t) extent_file->descriptor_size )
 	{
 		libcerror_error_set(
@@ -1366,6 +1498,19 @@ int libvmdk_extent_file_read_descriptor_data_file_io_handle(
 
 		return( -1 );
 	}
+	if( timestamp_result == 1 )
+	{
+		timestamp_result = libvmdk_statistics_get_timestamp(
+		                    &end_timestamp );
+	}
+	if( timestamp_result == 1 )
+	{
+		libvmdk_statistics_add_open_phase_time(
+		 statistics,
+		 open_phase,
+		 start_timestamp,
+		 end_timestamp );
+	}
 	return( 1 );
 }
 
@@ -1565,6 +1710,7 @@ int libvmdk_extent_file_read_grain_directory(
      off64_t file_offset,
      libcerror_error_t **error )
 {
+	libvmdk_statistics_t *statistics     = NULL;
 	uint8_t *grain_directory_data        = NULL;
 	uint8_t *grain_directory_entry       = NULL;
 	static char *function                = "libvmdk_extent_file_read_grain_directory";
@@ -1575,8 +1721,12 @@ int libvmdk_extent_file_read_grain_directory(
 	ssize_t read_count                   = 0;
 	uint32_t grain_directory_entry_index = 0;
 	uint32_t range_flags                 = 0;
+	uint64_t end_timestamp               = 0;
+	uint64_t start_timestamp             = 0;
 	int element_index                    = 0;
 	int number_of_grain_table_entries    = 0;
+	int open_phase                       = LIBVMDK_OPEN_PHASE_GRAIN_DIRECTORY;
+	int timestamp_result                 = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	int result                           = 0;
@@ -1603,6 +1753,18 @@ int libvmdk_extent_file_read_grain_directory(
 		 file_offset );
 	}
 #endif
+	if( extent_file->io_handle != NULL )
+	{
+		statistics = &( extent_file->io_handle->statistics );
+	}
+	timestamp_result = libvmdk_statistics_start_timer(
+	                    statistics,
+	                    &start_timestamp );
+
+	libvmdk_statistics_add_open_phase_seek(
+	 statistics,
+	 open_phase );
+
 	if( libbfio_pool_seek_offset(
 	     file_io_pool,
 	     file_io_pool_entry,
@@ -1641,6 +1803,11 @@ int libvmdk_extent_file_read_grain_directory(
 	              extent_file->grain_directory_size,
 	              error );
 
+	libvmdk_statistics_add_open_phase_read(
+	 statistics,
+	 open_phase,
+	 read_count );
+
 	if( read_count != (ssize_t) extent_file->grain_directory_size )
 	{
 		libcerror_error_set(
@@ -1805,6 +1972,19 @@ int libvmdk_extent_file_read_grain_directory(
 
 	grain_directory_data = NULL;
 
+	if( timestamp_result == 1 )
+	{
+		timestamp_result = libvmdk_statistics_get_timestamp(
+		                    &end_timestamp );
+	}
+	if( timestamp_result == 1 )
+	{
+		libvmdk_statistics_add_open_phase_time(
+		 statistics,
+		 open_phase,
+		 start_timestamp,
+		 end_timestamp );
+	}
 	return( 1 );
 
 on_error:
@@ -1826,6 +2006,7 @@ int libvmdk_extent_file_read_backup_grain_directory(
      off64_t file_offset,
      libcerror_error_t **error )
 {
+	libvmdk_statistics_t *statistics     = NULL;
 	uint8_t *grain_directory_data        = NULL;
 	uint8_t *grain_directory_entry       = NULL;
 	static char *function                = "libvmdk_extent_file_read_backup_grain_directory";
@@ -1836,8 +2017,12 @@ int libvmdk_extent_file_read_backup_grain_directory(
 	ssize_t read_count                   = 0;
 	uint32_t grain_directory_entry_index = 0;
 	uint32_t grain_group_range_flags     = 0;
+	uint64_t end_timestamp               = 0;
+	uint64_t start_timestamp             = 0;
 	int grain_group_file_io_pool_entry   = 0;
 	int number_of_grain_table_entries    = 0;
+	int open_phase                       = LIBVMDK_OPEN_PHASE_BACKUP_GRAIN_DIRECTORY;
+	int timestamp_result                 = 0;
 
 #if defined( HAVE_DEBUG_OUTPUT )
 	off64_t grain_table_offset           = 0;
@@ -1866,6 +2051,18 @@ int libvmdk_extent_file_read_backup_grain_directory(
 		 file_offset );
 	}
 #endif
+	if( extent_file->io_handle != NULL )
+	{
+		statistics = &( extent_file->io_handle->statistics );
+	}
+	timestamp_result = libvmdk_statistics_start_timer(
+	                    statistics,
+	                    &start_timestamp );
+
+	libvmdk_statistics_add_open_phase_seek(
+	 statistics,
+	 open_phase );
+
 	if( libbfio_pool_seek_offset(
 	     file_io_pool,
 	     file_io_pool_entry,
@@ -1904,6 +2101,11 @@ int libvmdk_extent_file_read_backup_grain_directory(
 	              extent_file->grain_directory_size,
 	              error );
 
+	libvmdk_statistics_add_open_phase_read(
+	 statistics,
+	 open_phase,
+	 read_count );
+
 	if( read_count != (ssize_t) extent_file->grain_directory_size )
 	{
 		libcerror_error_set(
@@ -2069,6 +2271,19 @@ int libvmdk_extent_file_read_backup_grain_directory(
 
 	grain_directory_data = NULL;
 
+	if( timestamp_result == 1 )
+	{
+		timestamp_result = libvmdk_statistics_get_timestamp(
+		                    &end_timestamp );
+	}
+	if( timestamp_result == 1 )
+	{
+		libvmdk_statistics_add_open_phase_time(
+		 statistics,
+		 open_phase,
+		 start_timestamp,
+		 end_timestamp );
+	}
 	return( 1 );
 
 on_error:
@@ -2201,6 +2416,10 @@ int libvmdk_extent_file_read_element_data(
 
 		goto on_error;
 	}
+	LIBVMDK_STATISTICS_ADD(
+	 io_handle->statistics.extent_files_cache_misses,
+	 1 );
+
 	return( 1 );
 
 on_error:
@@ -2271,6 +2490,14 @@ int libvmdk_extent_file_read_grain_group_element_data(
 
 		return( -1 );
 	}
+	if( extent_file->io_handle->trace_callback != NULL )
+	{
+		libvmdk_io_handle_trace(
+		 extent_file->io_handle,
+		 LIBVMDK_TRACE_PHASE_GRAIN_GROUP_LOAD,
+		 LIBVMDK_TRACE_EVENT_BEGIN,
+		 (uint64_t) grain_group_data_size );
+	}
 	if( ( grain_group_data_size == 0 )
 	 || ( grain_group_data_size > (size64_t) SSIZE_MAX ) )
 	{
@@ -2342,6 +2569,10 @@ int libvmdk_extent_file_read_grain_group_element_data(
 	              (size_t) grain_group_data_size,
 	              error );
 
+	libvmdk_statistics_add_backing_read(
+	 &( extent_file->io_handle->statistics ),
+	 read_count );
+
 	if( read_count != (ssize_t) grain_group_data_size )
 	{
 		libcerror_error_set(
@@ -2393,6 +2624,7 @@ int libvmdk_extent_file_read_grain_group_element_data(
 	     extent_file->io_handle->grain_size,
 	     file_io_pool,
 	     file_io_pool_entry,
+	     &( extent_file->io_handle->statistics ),
 	     grain_table_data,
 	     (size_t) grain_group_data_size,
 	     number_of_entries,
@@ -2434,9 +2666,29 @@ int libvmdk_extent_file_read_grain_group_element_data(
 
 		goto on_error;
 	}
+	LIBVMDK_STATISTICS_ADD(
+	 extent_file->io_handle->statistics.grain_groups_cache_misses,
+	 1 );
+
+	if( extent_file->io_handle->trace_callback != NULL )
+	{
+		libvmdk_io_handle_trace(
+		 extent_file->io_handle,
+		 LIBVMDK_TRACE_PHASE_GRAIN_GROUP_LOAD,
+		 LIBVMDK_TRACE_EVENT_END,
+		 (uint64_t) grain_group_data_size );
+	}
 	return( 1 );
 
 on_error:
+	if( extent_file->io_handle->trace_callback != NULL )
+	{
+		libvmdk_io_handle_trace(
+		 extent_file->io_handle,
+		 LIBVMDK_TRACE_PHASE_GRAIN_GROUP_LOAD,
+		 LIBVMDK_TRACE_EVENT_ERROR,
+		 (uint64_t) grain_group_data_size );
+	}
 	if( grains_list != NULL )
 	{
 		libfdata_list_free(
@@ -2535,6 +2787,17 @@ int libvmdk_extent_file_get_grain_group_at_offset(
 
 		return( -1 );
 	}
+	if( extent_file->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent file - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	result = libfdata_list_get_element_value_at_offset(
 		  extent_file->grain_groups_list,
 		  (intptr_t *) file_io_pool,
@@ -2558,9 +2821,1217 @@ int libvmdk_extent_file_get_grain_group_at_offset(
 
 		return( -1 );
 	}
+	if( result == 1 )
+	{
+		LIBVMDK_STATISTICS_ADD(
+		 extent_file->io_handle->statistics.grain_groups_cache_lookups,
+		 1 );
+	}
 	return( result );
 }
 
+/* Retrieves the allocation values of the extent file
+ * The values are determined from the grain directory and grain tables only
+ * and are added to the values, which are indexed by the LIBVMDK_ALLOCATION_VALUE definitions
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_get_allocation_values(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     uint64_t *values,
+     libcerror_error_t **error )
+{
+	libfdata_list_t *grains_list        = NULL;
+	static char *function               = "libvmdk_extent_file_get_allocation_values";
+	off64_t grain_group_offset          = 0;
+	off64_t grain_offset                = 0;
+	off64_t next_grain_offset           = -1;
+	size64_t grain_group_mapped_size    = 0;
+	size64_t grain_group_size           = 0;
+	size64_t grain_size                 = 0;
+	uint32_t grain_flags                = 0;
+	uint32_t grain_group_flags          = 0;
+	int grain_file_io_pool_entry        = 0;
+	int grain_group_file_io_pool_entry  = 0;
+	int grain_groups_list_index         = 0;
+	int grains_list_index               = 0;
+	int number_of_grain_groups          = 0;
+	int number_of_grains                = 0;
+	int previous_file_io_pool_entry     = -1;
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file->grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent file - missing grain size.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     extent_file->grain_groups_list,
+	     &number_of_grain_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of grain groups.",
+		 function );
+
+		return( -1 );
+	}
+	values[ LIBVMDK_ALLOCATION_VALUE_GRAIN_SIZE ] = extent_file->grain_size;
+
+	for( grain_groups_list_index = 0;
+	     grain_groups_list_index < number_of_grain_groups;
+	     grain_groups_list_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     extent_file->grain_groups_list,
+		     grain_groups_list_index,
+		     &grain_group_file_io_pool_entry,
+		     &grain_group_offset,
+		     &grain_group_size,
+		     &grain_group_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain group: %d.",
+			 function,
+			 grain_groups_list_index );
+
+			return( -1 );
+		}
+		values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_GRAIN_TABLES ] += 1;
+
+		if( ( grain_group_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			/* A grain group without a grain table only contains sparse grains
+			 */
+			if( libfdata_list_get_mapped_size_by_index(
+			     extent_file->grain_groups_list,
+			     grain_groups_list_index,
+			     &grain_group_mapped_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve mapped size of grain group: %d.",
+				 function,
+				 grain_groups_list_index );
+
+				return( -1 );
+			}
+			number_of_grains = (int) ( grain_group_mapped_size / extent_file->grain_size );
+
+			if( ( grain_group_mapped_size % extent_file->grain_size ) != 0 )
+			{
+				number_of_grains += 1;
+			}
+			values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_GRAINS ]        += number_of_grains;
+			values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_SPARSE_GRAINS ] += number_of_grains;
+
+			continue;
+		}
+		values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_ALLOCATED_GRAIN_TABLES ] += 1;
+
+		if( libfdata_list_get_element_value_by_index(
+		     extent_file->grain_groups_list,
+		     (intptr_t *) file_io_pool,
+		     extent_file->grain_groups_cache,
+		     grain_groups_list_index,
+		     (intptr_t **) &grains_list,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grains list: %d.",
+			 function,
+			 grain_groups_list_index );
+
+			return( -1 );
+		}
+		if( libfdata_list_get_number_of_elements(
+		     grains_list,
+		     &number_of_grains,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of grains in grain group: %d.",
+			 function,
+			 grain_groups_list_index );
+
+			return( -1 );
+		}
+		values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_GRAINS ]              += number_of_grains;
+		values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_GRAIN_TABLE_ENTRIES ] += number_of_grains;
+
+		for( grains_list_index = 0;
+		     grains_list_index < number_of_grains;
+		     grains_list_index++ )
+		{
+			if( libfdata_list_get_element_by_index(
+			     grains_list,
+			     grains_list_index,
+			     &grain_file_io_pool_entry,
+			     &grain_offset,
+			     &grain_size,
+			     &grain_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve grain: %d from grain group: %d.",
+				 function,
+				 grains_list_index,
+				 grain_groups_list_index );
+
+				return( -1 );
+			}
+			if( ( grain_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+			{
+				values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_SPARSE_GRAINS ] += 1;
+
+				continue;
+			}
+			values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_ALLOCATED_GRAINS ] += 1;
+
+			/* A fragment starts at every allocated grain that is not stored
+			 * directly after the previous allocated grain in the extent file
+			 */
+			if( ( grain_file_io_pool_entry != previous_file_io_pool_entry )
+			 || ( grain_offset != next_grain_offset ) )
+			{
+				values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_FRAGMENTS ] += 1;
+			}
+			if( ( grain_flags & LIBVMDK_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+			{
+				values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_COMPRESSED_GRAINS ] += 1;
+				values[ LIBVMDK_ALLOCATION_VALUE_COMPRESSED_DATA_SIZE ]        += grain_size;
+
+				/* A compressed grain is stored after a 12-byte grain marker
+				 * and is padded to the next sector boundary
+				 */
+				next_grain_offset = grain_offset + 12 + (off64_t) grain_size;
+
+				if( ( next_grain_offset % 512 ) != 0 )
+				{
+					next_grain_offset += 512 - ( next_grain_offset % 512 );
+				}
+			}
+			else
+			{
+				next_grain_offset = grain_offset + (off64_t) grain_size;
+			}
+			previous_file_io_pool_entry = grain_file_io_pool_entry;
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the range flags of the grain group at a specific offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_get_grain_group_flags_at_offset(
+     libvmdk_extent_file_t *extent_file,
+     off64_t offset,
+     uint32_t *grain_group_flags,
+     libcerror_error_t **error )
+{
+	static char *function           = "libvmdk_extent_file_get_grain_group_flags_at_offset";
+	off64_t grain_group_data_offset = 0;
+	off64_t grain_group_offset      = 0;
+	size64_t grain_group_size       = 0;
+	int grain_group_file_index      = 0;
+	int grain_group_index           = 0;
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_element_at_offset(
+	     extent_file->grain_groups_list,
+	     offset,
+	     &grain_group_index,
+	     &grain_group_data_offset,
+	     &grain_group_file_index,
+	     &grain_group_offset,
+	     &grain_group_size,
+	     grain_group_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grains group element at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Adds range flags to a specific grain group
+ * This is used to mark a grain group as tainted or corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_set_grain_group_range_flags(
+     libvmdk_extent_file_t *extent_file,
+     int grain_group_index,
+     uint32_t range_flags,
+     libcerror_error_t **error )
+{
+	static char *function              = "libvmdk_extent_file_set_grain_group_range_flags";
+	off64_t grain_group_offset         = 0;
+	size64_t grain_group_mapped_size   = 0;
+	size64_t grain_group_size          = 0;
+	uint32_t grain_group_flags         = 0;
+	int grain_group_file_io_pool_entry = 0;
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_element_by_index(
+	     extent_file->grain_groups_list,
+	     grain_group_index,
+	     &grain_group_file_io_pool_entry,
+	     &grain_group_offset,
+	     &grain_group_size,
+	     &grain_group_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain group: %d.",
+		 function,
+		 grain_group_index );
+
+		return( -1 );
+	}
+	if( ( grain_group_flags & range_flags ) == range_flags )
+	{
+		return( 1 );
+	}
+	if( libfdata_list_get_mapped_size_by_index(
+	     extent_file->grain_groups_list,
+	     grain_group_index,
+	     &grain_group_mapped_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve mapped size of grain group: %d.",
+		 function,
+		 grain_group_index );
+
+		return( -1 );
+	}
+	if( libfdata_list_set_element_by_index_with_mapped_size(
+	     extent_file->grain_groups_list,
+	     grain_group_index,
+	     grain_group_file_io_pool_entry,
+	     grain_group_offset,
+	     grain_group_size,
+	     grain_group_flags | range_flags,
+	     grain_group_mapped_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set grain group: %d.",
+		 function,
+		 grain_group_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads a grain table for verification
+ * Returns 1 if successful, 0 if the grain table is outside the extent file or -1 on error
+ */
+int libvmdk_extent_file_read_grain_table_data(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     size64_t file_size,
+     uint8_t *grain_table_data,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_extent_file_read_grain_table_data";
+	ssize_t read_count    = 0;
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_offset <= 0 )
+	 || ( (size64_t) file_offset >= file_size )
+	 || ( extent_file->grain_table_size > ( file_size - (size64_t) file_offset ) ) )
+	{
+		return( 0 );
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     file_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek grain table offset: %" PRIi64 ".",
+		 function,
+		 file_offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              grain_table_data,
+	              extent_file->grain_table_size,
+	              error );
+
+	if( read_count != (ssize_t) extent_file->grain_table_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain table data.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Verifies the grain directory against the backup (redundant) grain directory
+ * The grain tables referenced by both grain directories are compared as well
+ * Grain groups that differ are marked as tainted
+ * The number of mismatches are added to the values, which are indexed by the LIBVMDK_VERIFICATION_VALUE definitions
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_verify_grain_directories(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint64_t *values,
+     libcerror_error_t **error )
+{
+	uint8_t *backup_grain_directory_data  = NULL;
+	uint8_t *backup_grain_table_data      = NULL;
+	uint8_t *grain_directory_entry        = NULL;
+	uint8_t *grain_table_data             = NULL;
+	static char *function                 = "libvmdk_extent_file_verify_grain_directories";
+	off64_t backup_grain_directory_offset = 0;
+	off64_t backup_grain_table_offset     = 0;
+	off64_t grain_group_offset            = 0;
+	size64_t file_size                    = 0;
+	size64_t grain_group_size             = 0;
+	ssize_t read_count                    = 0;
+	uint32_t grain_directory_entry_index  = 0;
+	uint32_t grain_group_flags            = 0;
+	int backup_result                     = 0;
+	int grain_group_file_io_pool_entry    = 0;
+	int number_of_grain_groups            = 0;
+	int result                            = 0;
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	/* Only VMDK sparse extent files have a backup grain directory
+	 */
+	if( extent_file->file_type != LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
+	{
+		return( 1 );
+	}
+	if( ( extent_file->flags & LIBVMDK_FLAG_USE_SECONDARY_GRAIN_DIRECTORY ) != 0 )
+	{
+		backup_grain_directory_offset = extent_file->primary_grain_directory_offset;
+	}
+	else
+	{
+		backup_grain_directory_offset = extent_file->secondary_grain_directory_offset;
+	}
+	if( backup_grain_directory_offset <= 0 )
+	{
+		return( 1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     extent_file->grain_groups_list,
+	     &number_of_grain_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of grain groups.",
+		 function );
+
+		goto on_error;
+	}
+	if( (uint32_t) number_of_grain_groups != extent_file->number_of_grain_directory_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of grain groups value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_get_size(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent file size.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( (size64_t) backup_grain_directory_offset >= file_size )
+	 || ( extent_file->grain_directory_size > ( file_size - (size64_t) backup_grain_directory_offset ) ) )
+	{
+		values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_GRAIN_DIRECTORY_MISMATCHES ] += extent_file->number_of_grain_directory_entries;
+
+		return( 1 );
+	}
+	backup_grain_directory_data = (uint8_t *) memory_allocate(
+	                                           sizeof( uint8_t ) * extent_file->grain_directory_size );
+
+	if( backup_grain_directory_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create backup grain directory data.",
+		 function );
+
+		goto on_error;
+	}
+	grain_table_data = (uint8_t *) memory_allocate(
+	                                sizeof( uint8_t ) * extent_file->grain_table_size );
+
+	if( grain_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain table data.",
+		 function );
+
+		goto on_error;
+	}
+	backup_grain_table_data = (uint8_t *) memory_allocate(
+	                                       sizeof( uint8_t ) * extent_file->grain_table_size );
+
+	if( backup_grain_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create backup grain table data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     backup_grain_directory_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek backup grain directory offset: %" PRIi64 ".",
+		 function,
+		 backup_grain_directory_offset );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              backup_grain_directory_data,
+	              extent_file->grain_directory_size,
+	              error );
+
+	if( read_count != (ssize_t) extent_file->grain_directory_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read backup grain directory data.",
+		 function );
+
+		goto on_error;
+	}
+	grain_directory_entry = backup_grain_directory_data;
+
+	for( grain_directory_entry_index = 0;
+	     grain_directory_entry_index < extent_file->number_of_grain_directory_entries;
+	     grain_directory_entry_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 grain_directory_entry,
+		 backup_grain_table_offset );
+
+		grain_directory_entry += sizeof( uint32_t );
+
+		if( libfdata_list_get_element_by_index(
+		     extent_file->grain_groups_list,
+		     (int) grain_directory_entry_index,
+		     &grain_group_file_io_pool_entry,
+		     &grain_group_offset,
+		     &grain_group_size,
+		     &grain_group_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain group: %" PRIu32 ".",
+			 function,
+			 grain_directory_entry_index );
+
+			goto on_error;
+		}
+		/* Both grain directories must agree on which grain tables are allocated
+		 */
+		if( ( ( grain_group_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+		 != ( backup_grain_table_offset == 0 ) )
+		{
+			values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_GRAIN_DIRECTORY_MISMATCHES ] += 1;
+		}
+		else if( backup_grain_table_offset == 0 )
+		{
+			continue;
+		}
+		else
+		{
+			/* A grain table outside the extent file is reported by libvmdk_extent_file_verify_grains
+			 */
+			result = libvmdk_extent_file_read_grain_table_data(
+			          extent_file,
+			          file_io_pool,
+			          file_io_pool_entry,
+			          grain_group_offset,
+			          file_size,
+			          grain_table_data,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read grain table: %" PRIu32 ".",
+				 function,
+				 grain_directory_entry_index );
+
+				goto on_error;
+			}
+			else if( result == 0 )
+			{
+				continue;
+			}
+			backup_result = libvmdk_extent_file_read_grain_table_data(
+			                 extent_file,
+			                 file_io_pool,
+			                 file_io_pool_entry,
+			                 backup_grain_table_offset * 512,
+			                 file_size,
+			                 backup_grain_table_data,
+			                 error );
+
+			if( backup_result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read backup grain table: %" PRIu32 ".",
+				 function,
+				 grain_directory_entry_index );
+
+				goto on_error;
+			}
+			/* The backup grain table is a copy of the grain table
+			 * and refers to the same grains
+			 */
+			if( ( backup_result == 0 )
+			 || ( memory_compare(
+			       grain_table_data,
+			       backup_grain_table_data,
+			       extent_file->grain_table_size ) != 0 ) )
+			{
+				values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_GRAIN_TABLE_MISMATCHES ] += 1;
+			}
+			else
+			{
+				continue;
+			}
+		}
+		if( libvmdk_extent_file_set_grain_group_range_flags(
+		     extent_file,
+		     (int) grain_directory_entry_index,
+		     LIBVMDK_RANGE_FLAG_IS_TAINTED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to mark grain group: %" PRIu32 " as tainted.",
+			 function,
+			 grain_directory_entry_index );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 backup_grain_table_data );
+
+	memory_free(
+	 grain_table_data );
+
+	memory_free(
+	 backup_grain_directory_data );
+
+	return( 1 );
+
+on_error:
+	if( backup_grain_table_data != NULL )
+	{
+		memory_free(
+		 backup_grain_table_data );
+	}
+	if( grain_table_data != NULL )
+	{
+		memory_free(
+		 grain_table_data );
+	}
+	if( backup_grain_directory_data != NULL )
+	{
+		memory_free(
+		 backup_grain_directory_data );
+	}
+	return( -1 );
+}
+
+/* Compares two grain ranges by their start offset
+ * Callback function for qsort
+ * Returns -1 if the first range starts before the second, 0 if they start at the same offset or 1 otherwise
+ */
+int libvmdk_extent_file_compare_grain_ranges(
+     const void *first_grain_range,
+     const void *second_grain_range )
+{
+	off64_t first_start_offset  = ( (libvmdk_extent_file_grain_range_t *) first_grain_range )->start_offset;
+	off64_t second_start_offset = ( (libvmdk_extent_file_grain_range_t *) second_grain_range )->start_offset;
+
+	if( first_start_offset < second_start_offset )
+	{
+		return( -1 );
+	}
+	else if( first_start_offset > second_start_offset )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Verifies that the grain tables and the grains they refer to are stored inside the extent file
+ * and that no grains overlap
+ * Grain groups that contain such grains are marked as corrupted
+ * The number of bad grain tables and grains are added to the values, which are indexed by the LIBVMDK_VERIFICATION_VALUE definitions
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_extent_file_verify_grains(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint64_t *values,
+     libcerror_error_t **error )
+{
+	libfdata_list_t *grains_list                    = NULL;
+	libvmdk_extent_file_grain_range_t *grain_ranges = NULL;
+	libvmdk_extent_file_grain_range_t *reallocation = NULL;
+	uint8_t *corrupted_grain_groups                 = NULL;
+	static char *function                           = "libvmdk_extent_file_verify_grains";
+	off64_t grain_end_offset                        = 0;
+	off64_t grain_group_offset                      = 0;
+	off64_t grain_offset                            = 0;
+	off64_t maximum_end_offset                      = 0;
+	size64_t file_size                              = 0;
+	size64_t grain_group_size                       = 0;
+	size64_t grain_size                             = 0;
+	size_t grain_range_index                        = 0;
+	size_t maximum_number_of_grain_ranges           = 0;
+	size_t number_of_grain_ranges                   = 0;
+	uint32_t grain_flags                            = 0;
+	uint32_t grain_group_flags                      = 0;
+	int grain_file_io_pool_entry                    = 0;
+	int grain_group_file_io_pool_entry              = 0;
+	int grain_groups_list_index                     = 0;
+	int grains_list_index                           = 0;
+	int maximum_end_grain_group_index               = 0;
+	int number_of_grain_groups                      = 0;
+	int number_of_grains                            = 0;
+
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     extent_file->grain_groups_list,
+	     &number_of_grain_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of grain groups.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_grain_groups == 0 )
+	{
+		return( 1 );
+	}
+	if( libbfio_pool_get_size(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent file size.",
+		 function );
+
+		goto on_error;
+	}
+	corrupted_grain_groups = (uint8_t *) memory_allocate(
+	                                      sizeof( uint8_t ) * number_of_grain_groups );
+
+	if( corrupted_grain_groups == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create corrupted grain groups.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     corrupted_grain_groups,
+	     0,
+	     sizeof( uint8_t ) * number_of_grain_groups ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear corrupted grain groups.",
+		 function );
+
+		goto on_error;
+	}
+	for( grain_groups_list_index = 0;
+	     grain_groups_list_index < number_of_grain_groups;
+	     grain_groups_list_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     extent_file->grain_groups_list,
+		     grain_groups_list_index,
+		     &grain_group_file_io_pool_entry,
+		     &grain_group_offset,
+		     &grain_group_size,
+		     &grain_group_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain group: %d.",
+			 function,
+			 grain_groups_list_index );
+
+			goto on_error;
+		}
+		if( ( grain_group_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			continue;
+		}
+		/* The grain table itself must be stored inside the extent file before it can be read
+		 */
+		if( ( grain_group_offset <= 0 )
+		 || ( (size64_t) grain_group_offset >= file_size )
+		 || ( grain_group_size > ( file_size - (size64_t) grain_group_offset ) ) )
+		{
+			values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_GRAIN_TABLES_OUT_OF_BOUNDS ] += 1;
+
+			corrupted_grain_groups[ grain_groups_list_index ] = 1;
+
+			continue;
+		}
+		if( libfdata_list_get_element_value_by_index(
+		     extent_file->grain_groups_list,
+		     (intptr_t *) file_io_pool,
+		     extent_file->grain_groups_cache,
+		     grain_groups_list_index,
+		     (intptr_t **) &grains_list,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grains list: %d.",
+			 function,
+			 grain_groups_list_index );
+
+			goto on_error;
+		}
+		if( libfdata_list_get_number_of_elements(
+		     grains_list,
+		     &number_of_grains,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of grains in grain group: %d.",
+			 function,
+			 grain_groups_list_index );
+
+			goto on_error;
+		}
+		for( grains_list_index = 0;
+		     grains_list_index < number_of_grains;
+		     grains_list_index++ )
+		{
+			if( libfdata_list_get_element_by_index(
+			     grains_list,
+			     grains_list_index,
+			     &grain_file_io_pool_entry,
+			     &grain_offset,
+			     &grain_size,
+			     &grain_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve grain: %d from grain group: %d.",
+				 function,
+				 grains_list_index,
+				 grain_groups_list_index );
+
+				goto on_error;
+			}
+			if( ( grain_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+			{
+				continue;
+			}
+			grain_end_offset = grain_offset + (off64_t) grain_size;
+
+			if( ( grain_flags & LIBVMDK_RANGE_FLAG_IS_COMPRESSED ) != 0 )
+			{
+				/* A compressed grain is stored after a 12-byte grain marker
+				 */
+				grain_end_offset += 12;
+			}
+			if( ( grain_offset <= 0 )
+			 || ( grain_end_offset <= grain_offset )
+			 || ( (size64_t) grain_end_offset > file_size ) )
+			{
+				values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_GRAINS_OUT_OF_BOUNDS ] += 1;
+
+				corrupted_grain_groups[ grain_groups_list_index ] = 1;
+
+				continue;
+			}
+			if( number_of_grain_ranges >= maximum_number_of_grain_ranges )
+			{
+				if( maximum_number_of_grain_ranges == 0 )
+				{
+					maximum_number_of_grain_ranges = (size_t) extent_file->number_of_grain_table_entries;
+				}
+				else
+				{
+					maximum_number_of_grain_ranges *= 2;
+				}
+				if( maximum_number_of_grain_ranges > ( (size_t) SSIZE_MAX / sizeof( libvmdk_extent_file_grain_range_t ) ) )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+					 "%s: invalid maximum number of grain ranges value exceeds maximum.",
+					 function );
+
+					goto on_error;
+				}
+				reallocation = (libvmdk_extent_file_grain_range_t *) memory_reallocate(
+				                                                      grain_ranges,
+				                                                      sizeof( libvmdk_extent_file_grain_range_t ) * maximum_number_of_grain_ranges );
+
+				if( reallocation == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to resize grain ranges.",
+					 function );
+
+					goto on_error;
+				}
+				grain_ranges = reallocation;
+			}
+			grain_ranges[ number_of_grain_ranges ].start_offset      = grain_offset;
+			grain_ranges[ number_of_grain_ranges ].end_offset        = grain_end_offset;
+			grain_ranges[ number_of_grain_ranges ].grain_group_index = grain_groups_list_index;
+
+			number_of_grain_ranges++;
+		}
+	}
+	if( number_of_grain_ranges > 1 )
+	{
+		qsort(
+		 grain_ranges,
+		 number_of_grain_ranges,
+		 sizeof( libvmdk_extent_file_grain_range_t ),
+		 &libvmdk_extent_file_compare_grain_ranges );
+
+		maximum_end_offset            = grain_ranges[ 0 ].end_offset;
+		maximum_end_grain_group_index = grain_ranges[ 0 ].grain_group_index;
+
+		for( grain_range_index = 1;
+		     grain_range_index < number_of_grain_ranges;
+		     grain_range_index++ )
+		{
+			/* A grain overlaps when it starts before the end of any grain stored before it
+			 */
+			if( grain_ranges[ grain_range_index ].start_offset < maximum_end_offset )
+			{
+				values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_OVERLAPPING_GRAINS ] += 1;
+
+				corrupted_grain_groups[ grain_ranges[ grain_range_index ].grain_group_index ] = 1;
+				corrupted_grain_groups[ maximum_end_grain_group_index ]                       = 1;
+			}
+			if( grain_ranges[ grain_range_index ].end_offset > maximum_end_offset )
+			{
+				maximum_end_offset            = grain_ranges[ grain_range_index ].end_offset;
+				maximum_end_grain_group_index = grain_ranges[ grain_range_index ].grain_group_index;
+			}
+		}
+	}
+	if( grain_ranges != NULL )
+	{
+		memory_free(
+		 grain_ranges );
+
+		grain_ranges = NULL;
+	}
+	/* The grain groups are marked after all grains lists were retrieved
+	 * since marking a grain group invalidates its cached grains list
+	 */
+	for( grain_groups_list_index = 0;
+	     grain_groups_list_index < number_of_grain_groups;
+	     grain_groups_list_index++ )
+	{
+		if( corrupted_grain_groups[ grain_groups_list_index ] == 0 )
+		{
+			continue;
+		}
+		if( libvmdk_extent_file_set_grain_group_range_flags(
+		     extent_file,
+		     grain_groups_list_index,
+		     LIBVMDK_RANGE_FLAG_IS_CORRUPTED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to mark grain group: %d as corrupted.",
+			 function,
+			 grain_groups_list_index );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 corrupted_grain_groups );
+
+	return( 1 );
+
+on_error:
+	if( grain_ranges != NULL )
+	{
+		memory_free(
+		 grain_ranges );
+	}
+	if( corrupted_grain_groups != NULL )
+	{
+		memory_free(
+		 corrupted_grain_groups );
+	}
+	return( -1 );
+}
+
 /* Reads segment data into a buffer
  * Callback function for the segments stream
  * Returns the number of bytes read or -1 on error
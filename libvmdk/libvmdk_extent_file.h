@@ -38,6 +38,23 @@ extern "C" {
 extern const char *cowd_sparse_file_signature;
 extern const char *vmdk_sparse_file_signature;
 
+typedef struct libvmdk_extent_file_grain_range libvmdk_extent_file_grain_range_t;
+
+struct libvmdk_extent_file_grain_range
+{
+	/* The start offset of the grain in the extent file
+	 */
+	off64_t start_offset;
+
+	/* The end offset of the grain in the extent file
+	 */
+	off64_t end_offset;
+
+	/* The index of the grain group that refers to the grain
+	 */
+	int grain_group_index;
+};
+
 typedef struct libvmdk_extent_file libvmdk_extent_file_t;
 
 struct libvmdk_extent_file
@@ -229,6 +246,51 @@ int libvmdk_extent_file_get_grain_group_at_offset(
      libfdata_list_t **grains_list,
      libcerror_error_t **error );
 
+int libvmdk_extent_file_get_allocation_values(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     uint64_t *values,
+     libcerror_error_t **error );
+
+int libvmdk_extent_file_get_grain_group_flags_at_offset(
+     libvmdk_extent_file_t *extent_file,
+     off64_t offset,
+     uint32_t *grain_group_flags,
+     libcerror_error_t **error );
+
+int libvmdk_extent_file_set_grain_group_range_flags(
+     libvmdk_extent_file_t *extent_file,
+     int grain_group_index,
+     uint32_t range_flags,
+     libcerror_error_t **error );
+
+int libvmdk_extent_file_read_grain_table_data(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     size64_t file_size,
+     uint8_t *grain_table_data,
+     libcerror_error_t **error );
+
+int libvmdk_extent_file_verify_grain_directories(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint64_t *values,
+     libcerror_error_t **error );
+
+int libvmdk_extent_file_compare_grain_ranges(
+     const void *first_grain_range,
+     const void *second_grain_range );
+
+int libvmdk_extent_file_verify_grains(
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint64_t *values,
+     libcerror_error_t **error );
+
 ssize_t libvmdk_extent_file_read_segment_data(
          intptr_t *data_handle,
          libbfio_pool_t *file_io_pool,
@@ -1362,6 +1362,17 @@ int libvmdk_extent_table_get_extent_file_at_offset(
 
 		return( -1 );
 	}
+	if( extent_table->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent table - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	result = libfdata_list_get_element_value_at_offset(
 	          extent_table->extent_files_list,
 	          (intptr_t *) file_io_pool,
@@ -1385,6 +1396,12 @@ int libvmdk_extent_table_get_extent_file_at_offset(
 
 		return( -1 );
 	}
+	if( result == 1 )
+	{
+		LIBVMDK_STATISTICS_ADD(
+		 extent_table->io_handle->statistics.extent_files_cache_lookups,
+		 1 );
+	}
 	return( result );
 }
 
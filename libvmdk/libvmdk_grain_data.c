@@ -33,7 +33,9 @@
 #include "libvmdk_libcnotify.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_statistics.h"
 #include "libvmdk_unused.h"
+#include "libvmdk_zero_block.h"
 
 /* Creates grain data
  * Make sure the value grain_data is referencing, is set to NULL
@@ -217,6 +219,10 @@ ssize_t libvmdk_grain_data_read_compressed_header(
 		      12,
 		      error );
 
+	libvmdk_statistics_add_backing_read(
+	 &( io_handle->statistics ),
+	 read_count );
+
 	if( read_count != (ssize_t) 12 )
 	{
 		libcerror_error_set(
@@ -291,6 +297,10 @@ int libvmdk_grain_data_read_element_data(
 	uint8_t *compressed_data         = NULL;
 	static char *function            = "libvmdk_grain_data_read_element_data";
 	ssize_t read_count               = 0;
+	uint64_t end_timestamp           = 0;
+	uint64_t start_timestamp         = 0;
+	int result                       = 0;
+	int timestamp_result             = 0;
 
 	LIBVMDK_UNREFERENCED_PARAMETER( read_flags )
 
@@ -328,6 +338,14 @@ int libvmdk_grain_data_read_element_data(
 
 		return( -1 );
 	}
+	if( io_handle->trace_callback != NULL )
+	{
+		libvmdk_io_handle_trace(
+		 io_handle,
+		 LIBVMDK_TRACE_PHASE_GRAIN_DATA_LOAD,
+		 LIBVMDK_TRACE_EVENT_BEGIN,
+		 (uint64_t) grain_data_size );
+	}
 	if( libbfio_pool_seek_offset(
 	     file_io_pool,
 	     file_io_pool_entry,
@@ -436,6 +454,10 @@ int libvmdk_grain_data_read_element_data(
 			      (size_t) grain_data->compressed_data_size,
 			      error );
 
+		libvmdk_statistics_add_backing_read(
+		 &( io_handle->statistics ),
+		 read_count );
+
 		if( read_count != (ssize_t) grain_data->compressed_data_size )
 		{
 			libcerror_error_set(
@@ -447,6 +469,18 @@ int libvmdk_grain_data_read_element_data(
 
 			goto on_error;
 		}
+		if( io_handle->trace_callback != NULL )
+		{
+			libvmdk_io_handle_trace(
+			 io_handle,
+			 LIBVMDK_TRACE_PHASE_DECOMPRESSION,
+			 LIBVMDK_TRACE_EVENT_BEGIN,
+			 (uint64_t) grain_data->compressed_data_size );
+		}
+		timestamp_result = libvmdk_statistics_start_timer(
+		                    &( io_handle->statistics ),
+		                    &start_timestamp );
+
 		if( libvmdk_decompress_data(
 		     compressed_data,
 		     (size_t) grain_data->compressed_data_size,
@@ -462,8 +496,44 @@ int libvmdk_grain_data_read_element_data(
 			 "%s: unable to decompress grain data.",
 			 function );
 
+			if( io_handle->trace_callback != NULL )
+			{
+				libvmdk_io_handle_trace(
+				 io_handle,
+				 LIBVMDK_TRACE_PHASE_DECOMPRESSION,
+				 LIBVMDK_TRACE_EVENT_ERROR,
+				 (uint64_t) grain_data->compressed_data_size );
+			}
 			goto on_error;
 		}
+		if( timestamp_result == 1 )
+		{
+			timestamp_result = libvmdk_statistics_get_timestamp(
+			                    &end_timestamp );
+		}
+		if( timestamp_result == 1 )
+		{
+			libvmdk_statistics_add_decompression_time(
+			 &( io_handle->statistics ),
+			 start_timestamp,
+			 end_timestamp );
+		}
+		if( io_handle->trace_callback != NULL )
+		{
+			libvmdk_io_handle_trace(
+			 io_handle,
+			 LIBVMDK_TRACE_PHASE_DECOMPRESSION,
+			 LIBVMDK_TRACE_EVENT_END,
+			 (uint64_t) grain_data->data_size );
+		}
+		LIBVMDK_STATISTICS_ADD(
+		 io_handle->statistics.number_of_decompressions,
+		 1 );
+
+		LIBVMDK_STATISTICS_ADD(
+		 io_handle->statistics.compressed_read_size,
+		 grain_data->compressed_data_size );
+
 		memory_free(
 		 compressed_data );
 
@@ -503,6 +573,10 @@ int libvmdk_grain_data_read_element_data(
 			      (size_t) grain_data_size,
 			      error );
 
+		libvmdk_statistics_add_backing_read(
+		 &( io_handle->statistics ),
+		 read_count );
+
 		if( read_count != (ssize_t) grain_data_size )
 		{
 			libcerror_error_set(
@@ -515,6 +589,34 @@ int libvmdk_grain_data_read_element_data(
 			goto on_error;
 		}
 	}
+	result = libvmdk_zero_block_check(
+	          grain_data->data,
+	          grain_data->data_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if grain data only contains 0-byte values.",
+		 function );
+
+		goto on_error;
+	}
+	else if( result != 0 )
+	{
+		/* Allocated grains that only contain 0-byte values are cached without their data
+		 */
+		memory_free(
+		 grain_data->data );
+
+		grain_data->data    = NULL;
+		grain_data->is_zero = 1;
+	}
+	grain_data->io_handle = io_handle;
+
 	if( libfdata_list_element_set_element_value(
 	     element,
 	     (intptr_t *) file_io_pool,
@@ -533,9 +635,29 @@ int libvmdk_grain_data_read_element_data(
 
 		goto on_error;
 	}
+	LIBVMDK_STATISTICS_ADD(
+	 io_handle->statistics.grains_cache_misses,
+	 1 );
+
+	if( io_handle->trace_callback != NULL )
+	{
+		libvmdk_io_handle_trace(
+		 io_handle,
+		 LIBVMDK_TRACE_PHASE_GRAIN_DATA_LOAD,
+		 LIBVMDK_TRACE_EVENT_END,
+		 (uint64_t) grain_data_size );
+	}
 	return( 1 );
 
 on_error:
+	if( io_handle->trace_callback != NULL )
+	{
+		libvmdk_io_handle_trace(
+		 io_handle,
+		 LIBVMDK_TRACE_PHASE_GRAIN_DATA_LOAD,
+		 LIBVMDK_TRACE_EVENT_ERROR,
+		 (uint64_t) grain_data_size );
+	}
 	if( compressed_data != NULL )
 	{
 		memory_free(
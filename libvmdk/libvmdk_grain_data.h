@@ -53,6 +53,16 @@ struct libvmdk_grain_data
 	/* The data size
 	 */
 	size_t data_size;
+
+	/* Value to indicate the grain data only contains 0-byte values
+	 * in which case the data is not stored
+	 */
+	uint8_t is_zero;
+
+	/* The IO handle that read the grain data, which identifies the handle
+	 * the grain data belongs to when the grains cache is shared
+	 */
+	libvmdk_io_handle_t *io_handle;
 };
 
 int libvmdk_grain_data_initialize(
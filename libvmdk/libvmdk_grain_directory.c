@@ -0,0 +1,1541 @@
+/*
+ * Grain directory functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_extent_file.h"
+#include "libvmdk_grain_directory.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcnotify.h"
+
+#include "vmdk_sparse_file_header.h"
+
+/* Creates a grain directory
+ * Make sure the value grain_directory is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_directory_initialize(
+     libvmdk_grain_directory_t **grain_directory,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_directory_initialize";
+
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_directory != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain directory value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*grain_directory = memory_allocate_structure(
+	                    libvmdk_grain_directory_t );
+
+	if( *grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain directory.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *grain_directory,
+	     0,
+	     sizeof( libvmdk_grain_directory_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain directory.",
+		 function );
+
+		goto on_error;
+	}
+	( *grain_directory )->file_io_pool_entry = -1;
+
+	return( 1 );
+
+on_error:
+	if( *grain_directory != NULL )
+	{
+		memory_free(
+		 *grain_directory );
+
+		*grain_directory = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a grain directory
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_directory_free(
+     libvmdk_grain_directory_t **grain_directory,
+     libcerror_error_t **error )
+{
+	static char *function        = "libvmdk_grain_directory_free";
+	uint32_t grain_table_index   = 0;
+
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_directory != NULL )
+	{
+		if( ( *grain_directory )->grain_tables_data != NULL )
+		{
+			for( grain_table_index = 0;
+			     grain_table_index < ( *grain_directory )->number_of_grain_directory_entries;
+			     grain_table_index++ )
+			{
+				if( ( *grain_directory )->grain_tables_data[ grain_table_index ] != NULL )
+				{
+					memory_free(
+					 ( *grain_directory )->grain_tables_data[ grain_table_index ] );
+				}
+			}
+			memory_free(
+			 ( *grain_directory )->grain_tables_data );
+		}
+		if( ( *grain_directory )->grain_tables_flags != NULL )
+		{
+			memory_free(
+			 ( *grain_directory )->grain_tables_flags );
+		}
+		if( ( *grain_directory )->secondary_grain_directory_data != NULL )
+		{
+			memory_free(
+			 ( *grain_directory )->secondary_grain_directory_data );
+		}
+		if( ( *grain_directory )->primary_grain_directory_data != NULL )
+		{
+			memory_free(
+			 ( *grain_directory )->primary_grain_directory_data );
+		}
+		memory_free(
+		 *grain_directory );
+
+		*grain_directory = NULL;
+	}
+	return( 1 );
+}
+
+/* Reads the data of a grain directory or grain table
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_directory_read_data(
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_directory_read_data";
+	ssize_t read_count    = 0;
+
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     file_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              data,
+	              data_size,
+	              error );
+
+	if( read_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes the data of a grain directory or grain table
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_directory_write_data(
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_directory_write_data";
+	ssize_t write_count   = 0;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: writing %" PRIzd " bytes at offset: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 data_size,
+		 file_offset,
+		 file_offset );
+	}
+#endif
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     file_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	write_count = libbfio_pool_write_buffer(
+	               file_io_pool,
+	               file_io_pool_entry,
+	               data,
+	               data_size,
+	               error );
+
+	if( write_count != (ssize_t) data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write data at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 file_offset,
+		 file_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the grain directories of a sparse extent file
+ * The extent file header and grain directories must have been read before
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_directory_read(
+     libvmdk_grain_directory_t *grain_directory,
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t media_offset,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_directory_read";
+	size64_t file_size    = 0;
+
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory->grain_tables_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain directory - grain tables data value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file->file_type != LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported extent file type.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_file->flags & ( LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION | LIBVMDK_FLAG_HAS_DATA_MARKERS ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported extent file flags: 0x%08" PRIx32 ".",
+		 function,
+		 extent_file->flags );
+
+		return( -1 );
+	}
+	if( ( extent_file->grain_size == 0 )
+	 || ( ( extent_file->grain_size % 512 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent file - grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_file->number_of_grain_table_entries == 0 )
+	 || ( extent_file->number_of_grain_directory_entries == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent file - number of grain table or directory entries value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( extent_file->primary_grain_directory_offset <= 0 )
+	 && ( extent_file->secondary_grain_directory_offset <= 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid extent file - missing grain directory offset.",
+		 function );
+
+		return( -1 );
+	}
+	grain_directory->file_io_pool_entry                = file_io_pool_entry;
+	grain_directory->media_offset                      = media_offset;
+	grain_directory->media_size                        = extent_file->storage_media_size;
+	grain_directory->grain_size                        = extent_file->grain_size;
+	grain_directory->number_of_grain_table_entries     = extent_file->number_of_grain_table_entries;
+	grain_directory->grain_table_size                  = extent_file->grain_table_size;
+	grain_directory->number_of_grain_directory_entries = extent_file->number_of_grain_directory_entries;
+	grain_directory->grain_directory_size              = extent_file->grain_directory_size;
+	grain_directory->primary_grain_directory_offset    = extent_file->primary_grain_directory_offset;
+	grain_directory->secondary_grain_directory_offset  = extent_file->secondary_grain_directory_offset;
+	grain_directory->was_dirty                         = extent_file->is_dirty;
+
+	if( ( extent_file->flags & LIBVMDK_FLAG_USE_SECONDARY_GRAIN_DIRECTORY ) != 0 )
+	{
+		grain_directory->use_secondary_grain_directory = 1;
+	}
+	else if( extent_file->primary_grain_directory_offset <= 0 )
+	{
+		grain_directory->use_secondary_grain_directory = 1;
+	}
+	if( grain_directory->primary_grain_directory_offset > 0 )
+	{
+		grain_directory->primary_grain_directory_data = (uint8_t *) memory_allocate(
+		                                                             sizeof( uint8_t ) * grain_directory->grain_directory_size );
+
+		if( grain_directory->primary_grain_directory_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create primary grain directory data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_grain_directory_read_data(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     grain_directory->primary_grain_directory_offset,
+		     grain_directory->primary_grain_directory_data,
+		     grain_directory->grain_directory_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read primary grain directory.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( grain_directory->secondary_grain_directory_offset > 0 )
+	{
+		grain_directory->secondary_grain_directory_data = (uint8_t *) memory_allocate(
+		                                                               sizeof( uint8_t ) * grain_directory->grain_directory_size );
+
+		if( grain_directory->secondary_grain_directory_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create secondary grain directory data.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_grain_directory_read_data(
+		     file_io_pool,
+		     file_io_pool_entry,
+		     grain_directory->secondary_grain_directory_offset,
+		     grain_directory->secondary_grain_directory_data,
+		     grain_directory->grain_directory_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read secondary grain directory.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	grain_directory->grain_tables_data = (uint8_t **) memory_allocate(
+	                                                   sizeof( uint8_t * ) * grain_directory->number_of_grain_directory_entries );
+
+	if( grain_directory->grain_tables_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain tables data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     grain_directory->grain_tables_data,
+	     0,
+	     sizeof( uint8_t * ) * grain_directory->number_of_grain_directory_entries ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain tables data.",
+		 function );
+
+		goto on_error;
+	}
+	grain_directory->grain_tables_flags = (uint8_t *) memory_allocate(
+	                                                   sizeof( uint8_t ) * grain_directory->number_of_grain_directory_entries );
+
+	if( grain_directory->grain_tables_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain tables flags.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     grain_directory->grain_tables_flags,
+	     0,
+	     sizeof( uint8_t ) * grain_directory->number_of_grain_directory_entries ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain tables flags.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_get_size(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent file size.",
+		 function );
+
+		goto on_error;
+	}
+	/* New grains and grain tables are allocated at the end of the extent file
+	 */
+	if( ( file_size % 512 ) != 0 )
+	{
+		file_size = ( ( file_size / 512 ) + 1 ) * 512;
+	}
+	grain_directory->allocation_offset = (off64_t) file_size;
+
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: allocation offset\t\t\t: %" PRIi64 " (0x%08" PRIx64 ")\n",
+		 function,
+		 grain_directory->allocation_offset,
+		 grain_directory->allocation_offset );
+
+		libcnotify_printf(
+		 "\n" );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( grain_directory->grain_tables_flags != NULL )
+	{
+		memory_free(
+		 grain_directory->grain_tables_flags );
+
+		grain_directory->grain_tables_flags = NULL;
+	}
+	if( grain_directory->grain_tables_data != NULL )
+	{
+		memory_free(
+		 grain_directory->grain_tables_data );
+
+		grain_directory->grain_tables_data = NULL;
+	}
+	if( grain_directory->secondary_grain_directory_data != NULL )
+	{
+		memory_free(
+		 grain_directory->secondary_grain_directory_data );
+
+		grain_directory->secondary_grain_directory_data = NULL;
+	}
+	if( grain_directory->primary_grain_directory_data != NULL )
+	{
+		memory_free(
+		 grain_directory->primary_grain_directory_data );
+
+		grain_directory->primary_grain_directory_data = NULL;
+	}
+	return( -1 );
+}
+
+/* Retrieves the data of a specific grain table
+ * The grain table is read on demand
+ * Returns 1 if successful, 0 if the grain table is not allocated or -1 on error
+ */
+int libvmdk_grain_directory_get_grain_table_data(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     uint32_t grain_table_index,
+     uint8_t **grain_table_data,
+     libcerror_error_t **error )
+{
+	uint8_t *grain_directory_data = NULL;
+	static char *function         = "libvmdk_grain_directory_get_grain_table_data";
+	off64_t grain_table_offset    = 0;
+
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory->grain_tables_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain directory - missing grain tables data.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table_index >= grain_directory->number_of_grain_directory_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain table index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( grain_directory->grain_tables_flags[ grain_table_index ] & LIBVMDK_GRAIN_TABLE_FLAG_IS_LOADED ) != 0 )
+	{
+		*grain_table_data = grain_directory->grain_tables_data[ grain_table_index ];
+
+		return( 1 );
+	}
+	if( grain_directory->use_secondary_grain_directory != 0 )
+	{
+		grain_directory_data = grain_directory->secondary_grain_directory_data;
+	}
+	else
+	{
+		grain_directory_data = grain_directory->primary_grain_directory_data;
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( grain_directory_data[ grain_table_index * 4 ] ),
+	 grain_table_offset );
+
+	if( grain_table_offset == 0 )
+	{
+		*grain_table_data = NULL;
+
+		return( 0 );
+	}
+	grain_table_offset *= 512;
+
+	grain_directory->grain_tables_data[ grain_table_index ] = (uint8_t *) memory_allocate(
+	                                                                       sizeof( uint8_t ) * grain_directory->grain_table_size );
+
+	if( grain_directory->grain_tables_data[ grain_table_index ] == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain table: %" PRIu32 " data.",
+		 function,
+		 grain_table_index );
+
+		return( -1 );
+	}
+	if( libvmdk_grain_directory_read_data(
+	     file_io_pool,
+	     grain_directory->file_io_pool_entry,
+	     grain_table_offset,
+	     grain_directory->grain_tables_data[ grain_table_index ],
+	     grain_directory->grain_table_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain table: %" PRIu32 ".",
+		 function,
+		 grain_table_index );
+
+		memory_free(
+		 grain_directory->grain_tables_data[ grain_table_index ] );
+
+		grain_directory->grain_tables_data[ grain_table_index ] = NULL;
+
+		return( -1 );
+	}
+	grain_directory->grain_tables_flags[ grain_table_index ] = LIBVMDK_GRAIN_TABLE_FLAG_IS_LOADED;
+
+	*grain_table_data = grain_directory->grain_tables_data[ grain_table_index ];
+
+	return( 1 );
+}
+
+/* Allocates a specific grain table at the end of the extent file
+ * A grain table is allocated for every grain directory that is present
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_directory_allocate_grain_table(
+     libvmdk_grain_directory_t *grain_directory,
+     uint32_t grain_table_index,
+     uint8_t **grain_table_data,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvmdk_grain_directory_allocate_grain_table";
+	off64_t allocation_offset  = 0;
+	uint64_t sector_number     = 0;
+
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory->grain_tables_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain directory - missing grain tables data.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_table_index >= grain_directory->number_of_grain_directory_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain table index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory->grain_tables_data[ grain_table_index ] != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain directory - grain table: %" PRIu32 " data value already set.",
+		 function,
+		 grain_table_index );
+
+		return( -1 );
+	}
+	if( grain_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table data.",
+		 function );
+
+		return( -1 );
+	}
+	allocation_offset = grain_directory->allocation_offset;
+
+	if( grain_directory->primary_grain_directory_data != NULL )
+	{
+		allocation_offset += grain_directory->grain_table_size;
+	}
+	if( grain_directory->secondary_grain_directory_data != NULL )
+	{
+		allocation_offset += grain_directory->grain_table_size;
+	}
+	if( ( (uint64_t) allocation_offset / 512 ) > (uint64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid allocation offset value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	grain_directory->grain_tables_data[ grain_table_index ] = (uint8_t *) memory_allocate(
+	                                                                       sizeof( uint8_t ) * grain_directory->grain_table_size );
+
+	if( grain_directory->grain_tables_data[ grain_table_index ] == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain table: %" PRIu32 " data.",
+		 function,
+		 grain_table_index );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     grain_directory->grain_tables_data[ grain_table_index ],
+	     0,
+	     sizeof( uint8_t ) * grain_directory->grain_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain table: %" PRIu32 " data.",
+		 function,
+		 grain_table_index );
+
+		memory_free(
+		 grain_directory->grain_tables_data[ grain_table_index ] );
+
+		grain_directory->grain_tables_data[ grain_table_index ] = NULL;
+
+		return( -1 );
+	}
+	if( grain_directory->primary_grain_directory_data != NULL )
+	{
+		sector_number = (uint64_t) grain_directory->allocation_offset / 512;
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( grain_directory->primary_grain_directory_data[ grain_table_index * 4 ] ),
+		 (uint32_t) sector_number );
+
+		grain_directory->allocation_offset += grain_directory->grain_table_size;
+	}
+	if( grain_directory->secondary_grain_directory_data != NULL )
+	{
+		sector_number = (uint64_t) grain_directory->allocation_offset / 512;
+
+		byte_stream_copy_from_uint32_little_endian(
+		 &( grain_directory->secondary_grain_directory_data[ grain_table_index * 4 ] ),
+		 (uint32_t) sector_number );
+
+		grain_directory->allocation_offset += grain_directory->grain_table_size;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libcnotify_verbose != 0 )
+	{
+		libcnotify_printf(
+		 "%s: allocated grain table: %" PRIu32 "\n",
+		 function,
+		 grain_table_index );
+	}
+#endif
+	grain_directory->grain_tables_flags[ grain_table_index ] = LIBVMDK_GRAIN_TABLE_FLAG_IS_LOADED | LIBVMDK_GRAIN_TABLE_FLAG_IS_MODIFIED;
+	grain_directory->grain_directories_modified              = 1;
+
+	*grain_table_data = grain_directory->grain_tables_data[ grain_table_index ];
+
+	return( 1 );
+}
+
+/* Retrieves the (extent) file offset of the grain at a specific offset
+ * The offset is relative to the start of the extent
+ * Returns 1 if successful, 0 if the grain is not allocated or -1 on error
+ */
+int libvmdk_grain_directory_get_grain_offset(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     off64_t *grain_offset,
+     libcerror_error_t **error )
+{
+	uint8_t *grain_table_data   = NULL;
+	static char *function       = "libvmdk_grain_directory_get_grain_offset";
+	uint64_t grain_index        = 0;
+	uint64_t sector_number      = 0;
+	uint32_t grain_table_index  = 0;
+	uint32_t grain_table_entry  = 0;
+	int result                  = 0;
+
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory->grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain directory - missing grain size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= grain_directory->media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain offset.",
+		 function );
+
+		return( -1 );
+	}
+	grain_index       = (uint64_t) offset / grain_directory->grain_size;
+	grain_table_index = (uint32_t) ( grain_index / grain_directory->number_of_grain_table_entries );
+	grain_table_entry = (uint32_t) ( grain_index % grain_directory->number_of_grain_table_entries );
+
+	result = libvmdk_grain_directory_get_grain_table_data(
+	          grain_directory,
+	          file_io_pool,
+	          grain_table_index,
+	          &grain_table_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain table: %" PRIu32 " data.",
+		 function,
+		 grain_table_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( grain_table_data[ grain_table_entry * 4 ] ),
+	 sector_number );
+
+	if( sector_number == 0 )
+	{
+		return( 0 );
+	}
+	*grain_offset = (off64_t) ( sector_number * 512 );
+
+	return( 1 );
+}
+
+/* Allocates the grain at a specific offset at the end of the extent file
+ * The offset is relative to the start of the extent
+ * The caller is responsible for writing the grain data at the grain offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_directory_allocate_grain(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     off64_t *grain_offset,
+     libcerror_error_t **error )
+{
+	uint8_t *grain_table_data   = NULL;
+	static char *function       = "libvmdk_grain_directory_allocate_grain";
+	uint64_t grain_index        = 0;
+	uint64_t sector_number      = 0;
+	uint32_t grain_table_index  = 0;
+	uint32_t grain_table_entry  = 0;
+	int result                  = 0;
+
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory->grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain directory - missing grain size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= grain_directory->media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain offset.",
+		 function );
+
+		return( -1 );
+	}
+	grain_index       = (uint64_t) offset / grain_directory->grain_size;
+	grain_table_index = (uint32_t) ( grain_index / grain_directory->number_of_grain_table_entries );
+	grain_table_entry = (uint32_t) ( grain_index % grain_directory->number_of_grain_table_entries );
+
+	result = libvmdk_grain_directory_get_grain_table_data(
+	          grain_directory,
+	          file_io_pool,
+	          grain_table_index,
+	          &grain_table_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain table: %" PRIu32 " data.",
+		 function,
+		 grain_table_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		if( libvmdk_grain_directory_allocate_grain_table(
+		     grain_directory,
+		     grain_table_index,
+		     &grain_table_data,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to allocate grain table: %" PRIu32 ".",
+			 function,
+			 grain_table_index );
+
+			return( -1 );
+		}
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( grain_table_data[ grain_table_entry * 4 ] ),
+	 sector_number );
+
+	if( sector_number != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain: %" PRIu64 " value already set.",
+		 function,
+		 grain_index );
+
+		return( -1 );
+	}
+	sector_number = (uint64_t) grain_directory->allocation_offset / 512;
+
+	if( sector_number > (uint64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid allocation offset value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( grain_table_data[ grain_table_entry * 4 ] ),
+	 (uint32_t) sector_number );
+
+	grain_directory->grain_tables_flags[ grain_table_index ] |= LIBVMDK_GRAIN_TABLE_FLAG_IS_MODIFIED;
+
+	*grain_offset = grain_directory->allocation_offset;
+
+	grain_directory->allocation_offset += grain_directory->grain_size;
+
+	return( 1 );
+}
+
+/* Discards the grain at a specific offset by marking it sparse in its grain table
+ * The offset is relative to the start of the extent
+ * The grain data is left in the extent file
+ * Returns 1 if successful, 0 if the grain was not allocated or -1 on error
+ */
+int libvmdk_grain_directory_discard_grain(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	uint8_t *grain_table_data   = NULL;
+	static char *function       = "libvmdk_grain_directory_discard_grain";
+	uint64_t grain_index        = 0;
+	uint64_t sector_number      = 0;
+	uint32_t grain_table_index  = 0;
+	uint32_t grain_table_entry  = 0;
+	int result                  = 0;
+
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory->grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain directory - missing grain size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= grain_directory->media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	grain_index       = (uint64_t) offset / grain_directory->grain_size;
+	grain_table_index = (uint32_t) ( grain_index / grain_directory->number_of_grain_table_entries );
+	grain_table_entry = (uint32_t) ( grain_index % grain_directory->number_of_grain_table_entries );
+
+	result = libvmdk_grain_directory_get_grain_table_data(
+	          grain_directory,
+	          file_io_pool,
+	          grain_table_index,
+	          &grain_table_data,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain table: %" PRIu32 " data.",
+		 function,
+		 grain_table_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_to_uint32_little_endian(
+	 &( grain_table_data[ grain_table_entry * 4 ] ),
+	 sector_number );
+
+	if( sector_number == 0 )
+	{
+		return( 0 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( grain_table_data[ grain_table_entry * 4 ] ),
+	 0 );
+
+	grain_directory->grain_tables_flags[ grain_table_index ] |= LIBVMDK_GRAIN_TABLE_FLAG_IS_MODIFIED;
+
+	return( 1 );
+}
+
+/* Writes the dirty flag in the extent file header
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_directory_write_dirty_flag(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     uint8_t is_dirty,
+     libcerror_error_t **error )
+{
+	vmdk_sparse_file_header_t file_header;
+
+	static char *function = "libvmdk_grain_directory_write_dirty_flag";
+
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_grain_directory_read_data(
+	     file_io_pool,
+	     grain_directory->file_io_pool_entry,
+	     0,
+	     (uint8_t *) &file_header,
+	     sizeof( vmdk_sparse_file_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_compare(
+	     file_header.signature,
+	     vmdk_sparse_file_signature,
+	     4 ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported file header signature.",
+		 function );
+
+		return( -1 );
+	}
+	file_header.is_dirty = is_dirty;
+
+	if( libvmdk_grain_directory_write_data(
+	     file_io_pool,
+	     grain_directory->file_io_pool_entry,
+	     0,
+	     (uint8_t *) &file_header,
+	     sizeof( vmdk_sparse_file_header_t ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Marks the extent file dirty before its first modification
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_directory_mark_dirty(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_grain_directory_mark_dirty";
+
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory->is_dirty != 0 )
+	{
+		return( 1 );
+	}
+	if( libvmdk_grain_directory_write_dirty_flag(
+	     grain_directory,
+	     file_io_pool,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to mark extent file dirty.",
+		 function );
+
+		return( -1 );
+	}
+	grain_directory->is_dirty = 1;
+
+	return( 1 );
+}
+
+/* Flushes the modified grain tables and grain directories to the extent file
+ * The dirty flag is cleared afterwards, unless the extent file was dirty when it was opened
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_directory_flush(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvmdk_grain_directory_flush";
+	off64_t grain_table_offset = 0;
+	uint32_t grain_table_index = 0;
+
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory->is_dirty == 0 )
+	{
+		return( 1 );
+	}
+	/* The grain tables are written before the grain directories that reference them
+	 */
+	for( grain_table_index = 0;
+	     grain_table_index < grain_directory->number_of_grain_directory_entries;
+	     grain_table_index++ )
+	{
+		if( ( grain_directory->grain_tables_flags[ grain_table_index ] & LIBVMDK_GRAIN_TABLE_FLAG_IS_MODIFIED ) == 0 )
+		{
+			continue;
+		}
+		if( grain_directory->primary_grain_directory_data != NULL )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( grain_directory->primary_grain_directory_data[ grain_table_index * 4 ] ),
+			 grain_table_offset );
+
+			if( grain_table_offset != 0 )
+			{
+				if( libvmdk_grain_directory_write_data(
+				     file_io_pool,
+				     grain_directory->file_io_pool_entry,
+				     grain_table_offset * 512,
+				     grain_directory->grain_tables_data[ grain_table_index ],
+				     grain_directory->grain_table_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write primary grain table: %" PRIu32 ".",
+					 function,
+					 grain_table_index );
+
+					return( -1 );
+				}
+			}
+		}
+		if( grain_directory->secondary_grain_directory_data != NULL )
+		{
+			byte_stream_copy_to_uint32_little_endian(
+			 &( grain_directory->secondary_grain_directory_data[ grain_table_index * 4 ] ),
+			 grain_table_offset );
+
+			if( grain_table_offset != 0 )
+			{
+				if( libvmdk_grain_directory_write_data(
+				     file_io_pool,
+				     grain_directory->file_io_pool_entry,
+				     grain_table_offset * 512,
+				     grain_directory->grain_tables_data[ grain_table_index ],
+				     grain_directory->grain_table_size,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write secondary grain table: %" PRIu32 ".",
+					 function,
+					 grain_table_index );
+
+					return( -1 );
+				}
+			}
+		}
+		grain_directory->grain_tables_flags[ grain_table_index ] &= ~( LIBVMDK_GRAIN_TABLE_FLAG_IS_MODIFIED );
+	}
+	if( grain_directory->grain_directories_modified != 0 )
+	{
+		if( grain_directory->primary_grain_directory_data != NULL )
+		{
+			if( libvmdk_grain_directory_write_data(
+			     file_io_pool,
+			     grain_directory->file_io_pool_entry,
+			     grain_directory->primary_grain_directory_offset,
+			     grain_directory->primary_grain_directory_data,
+			     grain_directory->grain_directory_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write primary grain directory.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		if( grain_directory->secondary_grain_directory_data != NULL )
+		{
+			if( libvmdk_grain_directory_write_data(
+			     file_io_pool,
+			     grain_directory->file_io_pool_entry,
+			     grain_directory->secondary_grain_directory_offset,
+			     grain_directory->secondary_grain_directory_data,
+			     grain_directory->grain_directory_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write secondary grain directory.",
+				 function );
+
+				return( -1 );
+			}
+		}
+		grain_directory->grain_directories_modified = 0;
+	}
+	if( grain_directory->was_dirty == 0 )
+	{
+		if( libvmdk_grain_directory_write_dirty_flag(
+		     grain_directory,
+		     file_io_pool,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to clear extent file dirty flag.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	grain_directory->is_dirty = 0;
+
+	return( 1 );
+}
+
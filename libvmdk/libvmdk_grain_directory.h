@@ -0,0 +1,203 @@
+/*
+ * Grain directory functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_GRAIN_DIRECTORY_H )
+#define _LIBVMDK_GRAIN_DIRECTORY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_extent_file.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_grain_directory libvmdk_grain_directory_t;
+
+struct libvmdk_grain_directory
+{
+	/* The file IO pool entry of the extent file
+	 */
+	int file_io_pool_entry;
+
+	/* The (storage) media offset of the extent
+	 */
+	off64_t media_offset;
+
+	/* The (storage) media size of the extent
+	 */
+	size64_t media_size;
+
+	/* The grain size
+	 */
+	size64_t grain_size;
+
+	/* The number of grain table entries
+	 */
+	uint32_t number_of_grain_table_entries;
+
+	/* The grain table size
+	 */
+	size_t grain_table_size;
+
+	/* The number of grain directory entries
+	 */
+	uint32_t number_of_grain_directory_entries;
+
+	/* The grain directory size
+	 */
+	size_t grain_directory_size;
+
+	/* The primary grain directory offset
+	 */
+	off64_t primary_grain_directory_offset;
+
+	/* The secondary grain directory offset
+	 */
+	off64_t secondary_grain_directory_offset;
+
+	/* Value to indicate the secondary grain directory should be used
+	 */
+	uint8_t use_secondary_grain_directory;
+
+	/* The primary grain directory data
+	 */
+	uint8_t *primary_grain_directory_data;
+
+	/* The secondary grain directory data
+	 */
+	uint8_t *secondary_grain_directory_data;
+
+	/* Value to indicate the grain directories were modified
+	 */
+	uint8_t grain_directories_modified;
+
+	/* The grain tables data
+	 */
+	uint8_t **grain_tables_data;
+
+	/* The grain tables flags
+	 */
+	uint8_t *grain_tables_flags;
+
+	/* The allocation offset, the offset of the next grain or grain table
+	 */
+	off64_t allocation_offset;
+
+	/* Value to indicate the extent file was dirty when it was opened
+	 */
+	uint8_t was_dirty;
+
+	/* Value to indicate the extent file has been marked dirty
+	 */
+	uint8_t is_dirty;
+};
+
+int libvmdk_grain_directory_initialize(
+     libvmdk_grain_directory_t **grain_directory,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_free(
+     libvmdk_grain_directory_t **grain_directory,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_read_data(
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_write_data(
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t file_offset,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_read(
+     libvmdk_grain_directory_t *grain_directory,
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t media_offset,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_get_grain_table_data(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     uint32_t grain_table_index,
+     uint8_t **grain_table_data,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_allocate_grain_table(
+     libvmdk_grain_directory_t *grain_directory,
+     uint32_t grain_table_index,
+     uint8_t **grain_table_data,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_get_grain_offset(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     off64_t *grain_offset,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_allocate_grain(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     off64_t *grain_offset,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_discard_grain(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_write_dirty_flag(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     uint8_t is_dirty,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_mark_dirty(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+int libvmdk_grain_directory_flush(
+     libvmdk_grain_directory_t *grain_directory,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_GRAIN_DIRECTORY_H ) */
+
@@ -29,6 +29,7 @@
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libcnotify.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_statistics.h"
 
 /* Creates a grain group
  * Make sure the value grain_group is referencing, is set to NULL
@@ -221,6 +222,7 @@ int libvmdk_grain_group_fill(
      size64_t grain_size,
      libbfio_pool_t *file_io_pool,
      int file_io_pool_entry,
+     libvmdk_statistics_t *statistics,
      const uint8_t *grain_group_data,
      size_t grain_group_data_size,
      int number_of_grain_group_entries,
@@ -356,6 +358,10 @@ int libvmdk_grain_group_fill(
 				      12,
 				      error );
 
+			libvmdk_statistics_add_backing_read(
+			 statistics,
+			 read_count );
+
 			if( read_count != (ssize_t) 12 )
 			{
 				libcerror_error_set(
@@ -28,6 +28,7 @@
 #include "libvmdk_libbfio.h"
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -69,6 +70,7 @@ int libvmdk_grain_group_fill(
      size64_t grain_size,
      libbfio_pool_t *file_io_pool,
      int file_io_pool_entry,
+     libvmdk_statistics_t *statistics,
      const uint8_t *grain_group_data,
      size_t grain_group_data_size,
      int number_of_grain_group_entries,
@@ -382,6 +382,85 @@ int libvmdk_grain_table_grain_is_sparse_at_offset(
 	return( 0 );
 }
 
+/* Retrieves the flags of the grain group that contains a specific offset
+ * The flags are set by verification, such as LIBVMDK_RANGE_FLAG_IS_TAINTED
+ * and LIBVMDK_RANGE_FLAG_IS_CORRUPTED
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_table_get_grain_group_flags_at_offset(
+     libvmdk_grain_table_t *grain_table,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     uint32_t *grain_group_flags,
+     libcerror_error_t **error )
+{
+	libvmdk_extent_file_t *extent_file = NULL;
+	static char *function              = "libvmdk_grain_table_get_grain_group_flags_at_offset";
+	off64_t extent_file_data_offset    = 0;
+	int extent_number                  = 0;
+
+	if( grain_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_extent_table_get_extent_file_at_offset(
+	     extent_table,
+	     offset,
+	     file_io_pool,
+	     &extent_number,
+	     &extent_file_data_offset,
+	     &extent_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent file at offset: %" PRIi64 " from extent table.",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_extent_file_get_grain_group_flags_at_offset(
+	     extent_file,
+	     extent_file_data_offset,
+	     grain_group_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain group flags from extent file: %d at offset: %" PRIi64 ".",
+		 function,
+		 extent_number,
+		 extent_file_data_offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
 /* Retrieves the grain data of a grain at a specific offset
  * Returns 1 if successful or -1 on error
  */
@@ -417,6 +496,17 @@ int libvmdk_grain_table_get_grain_data_at_offset(
 
 		return( -1 );
 	}
+	if( grain_table->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain table - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
 	result = libvmdk_extent_table_get_extent_file_at_offset(
 	          extent_table,
 	          offset,
@@ -497,6 +587,44 @@ int libvmdk_grain_table_get_grain_data_at_offset(
 
 		return( -1 );
 	}
+	/* A grains cache that is shared by multiple handles can contain grain data
+	 * of another handle with the same data range, e.g. an image with the same layout,
+	 * hence grain data that was not read by this handle is read again
+	 */
+	if( ( *grain_data != NULL )
+	 && ( ( *grain_data )->io_handle != grain_table->io_handle ) )
+	{
+		result = libfdata_list_get_element_value_at_offset(
+			  grains_list,
+			  (intptr_t *) file_io_pool,
+			  grains_cache,
+			  grain_group_data_offset,
+			  &grains_list_index,
+			  grain_data_offset,
+			  (intptr_t **) grain_data,
+			  LIBFDATA_READ_FLAG_IGNORE_CACHE,
+			  error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to read grain: %" PRIu64 " data from grain group: %d in extent file: %d at offset: %" PRIi64 ".",
+			 function,
+			 grain_index,
+			 grain_groups_list_index,
+			 extent_number,
+			 extent_file_data_offset );
+
+			return( -1 );
+		}
+	}
+	LIBVMDK_STATISTICS_ADD(
+	 grain_table->io_handle->statistics.grains_cache_lookups,
+	 1 );
+
 	return( 1 );
 }
 
@@ -80,6 +80,14 @@ int libvmdk_grain_table_grain_is_sparse_at_offset(
      off64_t offset,
      libcerror_error_t **error );
 
+int libvmdk_grain_table_get_grain_group_flags_at_offset(
+     libvmdk_grain_table_t *grain_table,
+     libbfio_pool_t *file_io_pool,
+     libvmdk_extent_table_t *extent_table,
+     off64_t offset,
+     uint32_t *grain_group_flags,
+     libcerror_error_t **error );
+
 int libvmdk_grain_table_get_grain_data_at_offset(
      libvmdk_grain_table_t *grain_table,
      uint64_t grain_index,
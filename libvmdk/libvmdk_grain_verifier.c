@@ -0,0 +1,1092 @@
+/*
+ * Grain verifier functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_extent_file.h"
+#include "libvmdk_grain_verifier.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcnotify.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_libfdata.h"
+#include "libvmdk_stream_grain.h"
+
+/* Creates a grain verifier
+ * Make sure the value grain_verifier is referencing, is set to NULL
+ * A number of threads of 0 decompresses the grains in the calling thread
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_verifier_initialize(
+     libvmdk_grain_verifier_t **grain_verifier,
+     size64_t grain_size,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	static char *function  = "libvmdk_grain_verifier_initialize";
+	int stream_grain_index = 0;
+
+	if( grain_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain verifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_verifier != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid grain verifier value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( grain_size == 0 )
+	 || ( ( grain_size % 512 ) != 0 )
+	 || ( grain_size > (size64_t) ( SSIZE_MAX / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBVMDK_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*grain_verifier = memory_allocate_structure(
+	                   libvmdk_grain_verifier_t );
+
+	if( *grain_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain verifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *grain_verifier,
+	     0,
+	     sizeof( libvmdk_grain_verifier_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain verifier.",
+		 function );
+
+		memory_free(
+		 *grain_verifier );
+
+		*grain_verifier = NULL;
+
+		return( -1 );
+	}
+	( *grain_verifier )->grain_size        = grain_size;
+	( *grain_verifier )->number_of_threads = number_of_threads;
+
+	/* Keep twice as many grains pending as there are threads so that
+	 * the next grains are read while the previous ones are decompressed
+	 */
+	if( number_of_threads > 0 )
+	{
+		( *grain_verifier )->number_of_stream_grains = 2 * number_of_threads;
+	}
+	else
+	{
+		( *grain_verifier )->number_of_stream_grains = 1;
+	}
+	( *grain_verifier )->stream_grains = (libvmdk_stream_grain_t **) memory_allocate(
+	                                                                  sizeof( libvmdk_stream_grain_t * ) * ( *grain_verifier )->number_of_stream_grains );
+
+	if( ( *grain_verifier )->stream_grains == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stream grains.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     ( *grain_verifier )->stream_grains,
+	     0,
+	     sizeof( libvmdk_stream_grain_t * ) * ( *grain_verifier )->number_of_stream_grains ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stream grains.",
+		 function );
+
+		memory_free(
+		 ( *grain_verifier )->stream_grains );
+
+		( *grain_verifier )->stream_grains = NULL;
+
+		goto on_error;
+	}
+	( *grain_verifier )->grain_group_indexes = (int *) memory_allocate(
+	                                                    sizeof( int ) * ( *grain_verifier )->number_of_stream_grains );
+
+	if( ( *grain_verifier )->grain_group_indexes == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain group indexes.",
+		 function );
+
+		goto on_error;
+	}
+	for( stream_grain_index = 0;
+	     stream_grain_index < ( *grain_verifier )->number_of_stream_grains;
+	     stream_grain_index++ )
+	{
+		if( libvmdk_stream_grain_initialize(
+		     &( ( *grain_verifier )->stream_grains[ stream_grain_index ] ),
+		     (size_t) grain_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create stream grain: %d.",
+			 function,
+			 stream_grain_index );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 0 )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( ( *grain_verifier )->stream_grains_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create stream grains mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_condition_initialize(
+		     &( ( *grain_verifier )->stream_grains_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create stream grains condition.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &( ( *grain_verifier )->decompression_thread_pool ),
+		     NULL,
+		     number_of_threads,
+		     ( *grain_verifier )->number_of_stream_grains,
+		     (int (*)(intptr_t *, void *)) &libvmdk_grain_verifier_decompress_stream_grain_callback,
+		     (void *) *grain_verifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create decompression thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( *grain_verifier != NULL )
+	{
+		libvmdk_grain_verifier_free(
+		 grain_verifier,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Frees a grain verifier
+ * This waits for the grains that are still being decompressed
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_verifier_free(
+     libvmdk_grain_verifier_t **grain_verifier,
+     libcerror_error_t **error )
+{
+	static char *function  = "libvmdk_grain_verifier_free";
+	int result             = 1;
+	int stream_grain_index = 0;
+
+	if( grain_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain verifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( *grain_verifier != NULL )
+	{
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+		/* Joining the thread pool waits for the grains that are still being decompressed
+		 */
+		if( ( *grain_verifier )->decompression_thread_pool != NULL )
+		{
+			if( libcthreads_thread_pool_join(
+			     &( ( *grain_verifier )->decompression_thread_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to join decompression thread pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *grain_verifier )->stream_grains_condition != NULL )
+		{
+			if( libcthreads_condition_free(
+			     &( ( *grain_verifier )->stream_grains_condition ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free stream grains condition.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *grain_verifier )->stream_grains_mutex != NULL )
+		{
+			if( libcthreads_mutex_free(
+			     &( ( *grain_verifier )->stream_grains_mutex ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free stream grains mutex.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( ( *grain_verifier )->stream_grains != NULL )
+		{
+			for( stream_grain_index = 0;
+			     stream_grain_index < ( *grain_verifier )->number_of_stream_grains;
+			     stream_grain_index++ )
+			{
+				if( libvmdk_stream_grain_free(
+				     &( ( *grain_verifier )->stream_grains[ stream_grain_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free stream grain: %d.",
+					 function,
+					 stream_grain_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *grain_verifier )->stream_grains );
+		}
+		if( ( *grain_verifier )->grain_group_indexes != NULL )
+		{
+			memory_free(
+			 ( *grain_verifier )->grain_group_indexes );
+		}
+		memory_free(
+		 *grain_verifier );
+
+		*grain_verifier = NULL;
+	}
+	return( result );
+}
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+/* Decompresses a stream grain from a decompression thread
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_verifier_decompress_stream_grain_callback(
+     libvmdk_stream_grain_t *stream_grain,
+     libvmdk_grain_verifier_t *grain_verifier )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libvmdk_grain_verifier_decompress_stream_grain_callback";
+	int result               = 0;
+
+	if( ( stream_grain == NULL )
+	 || ( grain_verifier == NULL ) )
+	{
+		return( -1 );
+	}
+	result = libvmdk_stream_grain_decompress(
+	          stream_grain,
+	          &error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to decompress grain: %" PRIu64 ".",
+		 function,
+		 stream_grain->grain_index );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	/* Signal the verifier that the stream grain was processed
+	 */
+	if( libcthreads_mutex_grab(
+	     grain_verifier->stream_grains_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	stream_grain->result       = result;
+	stream_grain->is_processed = 1;
+
+	if( libcthreads_condition_broadcast(
+	     grain_verifier->stream_grains_condition,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     grain_verifier->stream_grains_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+/* Submits the stream grain that was read for decompression
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_verifier_submit_stream_grain(
+     libvmdk_grain_verifier_t *grain_verifier,
+     int grain_group_index,
+     libcerror_error_t **error )
+{
+	libcerror_error_t *decompression_error = NULL;
+	libvmdk_stream_grain_t *stream_grain   = NULL;
+	static char *function                  = "libvmdk_grain_verifier_submit_stream_grain";
+	int stream_grain_index                 = 0;
+
+	if( grain_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain verifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_verifier->number_of_pending_stream_grains >= grain_verifier->number_of_stream_grains )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of pending stream grains value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	stream_grain_index = ( grain_verifier->first_pending_stream_grain + grain_verifier->number_of_pending_stream_grains )
+	                   % grain_verifier->number_of_stream_grains;
+
+	stream_grain = grain_verifier->stream_grains[ stream_grain_index ];
+
+	stream_grain->is_processed = 0;
+	stream_grain->result       = 0;
+
+	grain_verifier->grain_group_indexes[ stream_grain_index ] = grain_group_index;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( grain_verifier->decompression_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_push(
+		     grain_verifier->decompression_thread_pool,
+		     (intptr_t *) stream_grain,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push stream grain onto decompression thread pool.",
+			 function );
+
+			return( -1 );
+		}
+		grain_verifier->number_of_pending_stream_grains += 1;
+
+		return( 1 );
+	}
+#endif
+	/* A grain that cannot be decompressed is corrupted, which is not an error of the verifier
+	 */
+	stream_grain->result = libvmdk_stream_grain_decompress(
+	                        stream_grain,
+	                        &decompression_error );
+
+	if( stream_grain->result != 1 )
+	{
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 decompression_error );
+		}
+#endif
+		libcerror_error_free(
+		 &decompression_error );
+	}
+	stream_grain->is_processed = 1;
+
+	grain_verifier->number_of_pending_stream_grains += 1;
+
+	return( 1 );
+}
+
+/* Waits for the first pending stream grain to be decompressed and checks its result
+ * A grain that failed to decompress marks its grain group as corrupted
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_verifier_check_pending_stream_grain(
+     libvmdk_grain_verifier_t *grain_verifier,
+     uint8_t *corrupted_grain_groups,
+     uint64_t *values,
+     libcerror_error_t **error )
+{
+	libvmdk_stream_grain_t *stream_grain = NULL;
+	static char *function                = "libvmdk_grain_verifier_check_pending_stream_grain";
+
+	if( grain_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain verifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_verifier->number_of_pending_stream_grains <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid grain verifier - missing pending stream grains.",
+		 function );
+
+		return( -1 );
+	}
+	if( corrupted_grain_groups == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid corrupted grain groups.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	stream_grain = grain_verifier->stream_grains[ grain_verifier->first_pending_stream_grain ];
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( grain_verifier->decompression_thread_pool != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     grain_verifier->stream_grains_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab stream grains mutex.",
+			 function );
+
+			return( -1 );
+		}
+		while( stream_grain->is_processed == 0 )
+		{
+			if( libcthreads_condition_wait(
+			     grain_verifier->stream_grains_condition,
+			     grain_verifier->stream_grains_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for stream grains condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 grain_verifier->stream_grains_mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( libcthreads_mutex_release(
+		     grain_verifier->stream_grains_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release stream grains mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_DECOMPRESSED_GRAINS ] += 1;
+
+	if( stream_grain->result != 1 )
+	{
+		values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_CORRUPTED_GRAINS ] += 1;
+
+		corrupted_grain_groups[ grain_verifier->grain_group_indexes[ grain_verifier->first_pending_stream_grain ] ] = 1;
+	}
+	grain_verifier->first_pending_stream_grain += 1;
+
+	if( grain_verifier->first_pending_stream_grain >= grain_verifier->number_of_stream_grains )
+	{
+		grain_verifier->first_pending_stream_grain = 0;
+	}
+	grain_verifier->number_of_pending_stream_grains -= 1;
+
+	return( 1 );
+}
+
+/* Verifies the compressed grains of an extent file
+ * The grains are read sequentially in the calling thread and decompressed by the decompression threads,
+ * which validates the deflate streams, including their Adler-32 checksums, and the grain markers
+ * Grain groups that contain grains that fail to decompress are marked as corrupted
+ * The number of decompressed and corrupted grains are added to the values, which are indexed by the LIBVMDK_VERIFICATION_VALUE definitions
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_grain_verifier_verify_extent_file(
+     libvmdk_grain_verifier_t *grain_verifier,
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint64_t *values,
+     libcerror_error_t **error )
+{
+	libfdata_list_t *grains_list         = NULL;
+	libvmdk_stream_grain_t *stream_grain = NULL;
+	uint8_t *corrupted_grain_groups      = NULL;
+	static char *function                = "libvmdk_grain_verifier_verify_extent_file";
+	off64_t grain_group_offset           = 0;
+	off64_t grain_offset                 = 0;
+	size64_t file_size                   = 0;
+	size64_t grain_group_size            = 0;
+	size64_t grain_size                  = 0;
+	ssize_t read_count                   = 0;
+	uint32_t grain_flags                 = 0;
+	uint32_t grain_group_flags           = 0;
+	int grain_file_io_pool_entry         = 0;
+	int grain_group_file_io_pool_entry   = 0;
+	int grain_groups_list_index          = 0;
+	int grains_list_index                = 0;
+	int number_of_grain_groups           = 0;
+	int number_of_grains                 = 0;
+	int stream_grain_index               = 0;
+
+	if( grain_verifier == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain verifier.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent file.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_file->grain_size != grain_verifier->grain_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid extent file - grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libfdata_list_get_number_of_elements(
+	     extent_file->grain_groups_list,
+	     &number_of_grain_groups,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of grain groups.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_grain_groups == 0 )
+	{
+		return( 1 );
+	}
+	if( libbfio_pool_get_size(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent file size.",
+		 function );
+
+		goto on_error;
+	}
+	corrupted_grain_groups = (uint8_t *) memory_allocate(
+	                                      sizeof( uint8_t ) * number_of_grain_groups );
+
+	if( corrupted_grain_groups == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create corrupted grain groups.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     corrupted_grain_groups,
+	     0,
+	     sizeof( uint8_t ) * number_of_grain_groups ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear corrupted grain groups.",
+		 function );
+
+		goto on_error;
+	}
+	for( grain_groups_list_index = 0;
+	     grain_groups_list_index < number_of_grain_groups;
+	     grain_groups_list_index++ )
+	{
+		if( libfdata_list_get_element_by_index(
+		     extent_file->grain_groups_list,
+		     grain_groups_list_index,
+		     &grain_group_file_io_pool_entry,
+		     &grain_group_offset,
+		     &grain_group_size,
+		     &grain_group_flags,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain group: %d.",
+			 function,
+			 grain_groups_list_index );
+
+			goto on_error;
+		}
+		/* Grain groups that were found corrupted by libvmdk_extent_file_verify_grains
+		 * can refer to grain tables or grains outside the extent file
+		 */
+		if( ( grain_group_flags & ( LIBVMDK_RANGE_FLAG_IS_SPARSE | LIBVMDK_RANGE_FLAG_IS_CORRUPTED ) ) != 0 )
+		{
+			continue;
+		}
+		if( libfdata_list_get_element_value_by_index(
+		     extent_file->grain_groups_list,
+		     (intptr_t *) file_io_pool,
+		     extent_file->grain_groups_cache,
+		     grain_groups_list_index,
+		     (intptr_t **) &grains_list,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grains list: %d.",
+			 function,
+			 grain_groups_list_index );
+
+			goto on_error;
+		}
+		if( libfdata_list_get_number_of_elements(
+		     grains_list,
+		     &number_of_grains,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of grains in grain group: %d.",
+			 function,
+			 grain_groups_list_index );
+
+			goto on_error;
+		}
+		for( grains_list_index = 0;
+		     grains_list_index < number_of_grains;
+		     grains_list_index++ )
+		{
+			if( libfdata_list_get_element_by_index(
+			     grains_list,
+			     grains_list_index,
+			     &grain_file_io_pool_entry,
+			     &grain_offset,
+			     &grain_size,
+			     &grain_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve grain: %d from grain group: %d.",
+				 function,
+				 grains_list_index,
+				 grain_groups_list_index );
+
+				goto on_error;
+			}
+			if( ( grain_flags & LIBVMDK_RANGE_FLAG_IS_COMPRESSED ) == 0 )
+			{
+				continue;
+			}
+			if( grain_verifier->number_of_pending_stream_grains >= grain_verifier->number_of_stream_grains )
+			{
+				if( libvmdk_grain_verifier_check_pending_stream_grain(
+				     grain_verifier,
+				     corrupted_grain_groups,
+				     values,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to check pending grain.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			stream_grain_index = ( grain_verifier->first_pending_stream_grain + grain_verifier->number_of_pending_stream_grains )
+			                   % grain_verifier->number_of_stream_grains;
+
+			stream_grain = grain_verifier->stream_grains[ stream_grain_index ];
+
+			/* A compressed grain larger than the worst case deflate size of a grain is corrupted
+			 */
+			if( ( grain_size > (size64_t) ( stream_grain->allocated_block_data_size - 12 ) )
+			 || ( (size64_t) grain_offset > ( file_size - 12 - grain_size ) ) )
+			{
+				values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_DECOMPRESSED_GRAINS ] += 1;
+				values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_CORRUPTED_GRAINS ]    += 1;
+
+				corrupted_grain_groups[ grain_groups_list_index ] = 1;
+
+				continue;
+			}
+			if( libbfio_pool_seek_offset(
+			     file_io_pool,
+			     grain_file_io_pool_entry,
+			     grain_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek grain offset: %" PRIi64 ".",
+				 function,
+				 grain_offset );
+
+				goto on_error;
+			}
+			stream_grain->block_data_size = 12 + (size_t) grain_size;
+
+			read_count = libbfio_pool_read_buffer(
+			              file_io_pool,
+			              grain_file_io_pool_entry,
+			              stream_grain->block_data,
+			              stream_grain->block_data_size,
+			              error );
+
+			if( read_count != (ssize_t) stream_grain->block_data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read compressed grain: %d from grain group: %d.",
+				 function,
+				 grains_list_index,
+				 grain_groups_list_index );
+
+				goto on_error;
+			}
+			stream_grain->grain_index = ( (uint64_t) grain_groups_list_index * extent_file->number_of_grain_table_entries )
+			                          + grains_list_index;
+
+			if( libvmdk_grain_verifier_submit_stream_grain(
+			     grain_verifier,
+			     grain_groups_list_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to submit compressed grain: %d from grain group: %d.",
+				 function,
+				 grains_list_index,
+				 grain_groups_list_index );
+
+				goto on_error;
+			}
+		}
+	}
+	while( grain_verifier->number_of_pending_stream_grains > 0 )
+	{
+		if( libvmdk_grain_verifier_check_pending_stream_grain(
+		     grain_verifier,
+		     corrupted_grain_groups,
+		     values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to check pending grain.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	/* The grain groups are marked after all grains lists were retrieved
+	 * since marking a grain group invalidates its cached grains list
+	 */
+	for( grain_groups_list_index = 0;
+	     grain_groups_list_index < number_of_grain_groups;
+	     grain_groups_list_index++ )
+	{
+		if( corrupted_grain_groups[ grain_groups_list_index ] == 0 )
+		{
+			continue;
+		}
+		if( libvmdk_extent_file_set_grain_group_range_flags(
+		     extent_file,
+		     grain_groups_list_index,
+		     LIBVMDK_RANGE_FLAG_IS_CORRUPTED,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to mark grain group: %d as corrupted.",
+			 function,
+			 grain_groups_list_index );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 corrupted_grain_groups );
+
+	return( 1 );
+
+on_error:
+	/* Wait for the grains that are still being decompressed
+	 * so the stream grains can be reused
+	 */
+	while( grain_verifier->number_of_pending_stream_grains > 0 )
+	{
+		if( ( corrupted_grain_groups == NULL )
+		 || ( libvmdk_grain_verifier_check_pending_stream_grain(
+		       grain_verifier,
+		       corrupted_grain_groups,
+		       values,
+		       NULL ) != 1 ) )
+		{
+			break;
+		}
+	}
+	if( corrupted_grain_groups != NULL )
+	{
+		memory_free(
+		 corrupted_grain_groups );
+	}
+	return( -1 );
+}
+
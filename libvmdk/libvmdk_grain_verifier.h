@@ -0,0 +1,128 @@
+/*
+ * Grain verifier functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_GRAIN_VERIFIER_H )
+#define _LIBVMDK_GRAIN_VERIFIER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_extent_file.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_stream_grain.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_grain_verifier libvmdk_grain_verifier_t;
+
+struct libvmdk_grain_verifier
+{
+	/* The grain size
+	 */
+	size64_t grain_size;
+
+	/* The number of decompression threads
+	 */
+	int number_of_threads;
+
+	/* The stream grains
+	 * Used as a ring buffer of the grains that are being decompressed
+	 */
+	libvmdk_stream_grain_t **stream_grains;
+
+	/* The grain group index of each stream grain
+	 */
+	int *grain_group_indexes;
+
+	/* The number of stream grains
+	 */
+	int number_of_stream_grains;
+
+	/* The index of the first pending stream grain
+	 */
+	int first_pending_stream_grain;
+
+	/* The number of pending stream grains
+	 */
+	int number_of_pending_stream_grains;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The decompression thread pool
+	 */
+	libcthreads_thread_pool_t *decompression_thread_pool;
+
+	/* The stream grains mutex
+	 */
+	libcthreads_mutex_t *stream_grains_mutex;
+
+	/* The stream grains condition
+	 */
+	libcthreads_condition_t *stream_grains_condition;
+#endif
+};
+
+int libvmdk_grain_verifier_initialize(
+     libvmdk_grain_verifier_t **grain_verifier,
+     size64_t grain_size,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+int libvmdk_grain_verifier_free(
+     libvmdk_grain_verifier_t **grain_verifier,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+int libvmdk_grain_verifier_decompress_stream_grain_callback(
+     libvmdk_stream_grain_t *stream_grain,
+     libvmdk_grain_verifier_t *grain_verifier );
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+int libvmdk_grain_verifier_submit_stream_grain(
+     libvmdk_grain_verifier_t *grain_verifier,
+     int grain_group_index,
+     libcerror_error_t **error );
+
+int libvmdk_grain_verifier_check_pending_stream_grain(
+     libvmdk_grain_verifier_t *grain_verifier,
+     uint8_t *corrupted_grain_groups,
+     uint64_t *values,
+     libcerror_error_t **error );
+
+int libvmdk_grain_verifier_verify_extent_file(
+     libvmdk_grain_verifier_t *grain_verifier,
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     uint64_t *values,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_GRAIN_VERIFIER_H ) */
+
@@ -26,8 +26,21 @@
 #include <types.h>
 #include <wide_string.h>
 
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "libvmdk_cache_pool.h"
+#include "libvmdk_change_tracking_file.h"
+#include "libvmdk_chunk_hasher.h"
 #include "libvmdk_debug.h"
 #include "libvmdk_definitions.h"
+#include "libvmdk_delta_disk.h"
 #include "libvmdk_descriptor_file.h"
 #include "libvmdk_extent_descriptor.h"
 #include "libvmdk_extent_file.h"
@@ -35,6 +48,7 @@
 #include "libvmdk_handle.h"
 #include "libvmdk_grain_data.h"
 #include "libvmdk_grain_table.h"
+#include "libvmdk_grain_verifier.h"
 #include "libvmdk_io_handle.h"
 #include "libvmdk_libbfio.h"
 #include "libvmdk_libcerror.h"
@@ -43,7 +57,12 @@
 #include "libvmdk_libcthreads.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_libuna.h"
+#include "libvmdk_sha256.h"
+#include "libvmdk_statistics.h"
 #include "libvmdk_system_string.h"
+#include "libvmdk_write_io_handle.h"
+#include "libvmdk_zero_block.h"
 
 /* Creates a handle
  * Make sure the value handle is referencing, is set to NULL
@@ -152,6 +171,8 @@ int libvmdk_handle_initialize(
 	}
 #endif
 	internal_handle->maximum_number_of_open_handles = LIBBFIO_POOL_UNLIMITED_NUMBER_OF_OPEN_HANDLES;
+	internal_handle->cache_pool_handle_identifier   = -1;
+	internal_handle->create_grain_size              = LIBVMDK_DELTA_DISK_DEFAULT_GRAIN_SIZE;
 
 	*handle = (libvmdk_handle_t *) internal_handle;
 
@@ -221,6 +242,27 @@ int libvmdk_handle_free(
 				result = -1;
 			}
 		}
+		/* Make sure no grain data of the IO handle remains in the cache pool
+		 * since the IO handle is freed below
+		 */
+		if( internal_handle->cache_pool_handle_identifier != -1 )
+		{
+			if( libvmdk_cache_pool_detach_handle(
+			     internal_handle->cache_pool,
+			     internal_handle->io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to detach handle from cache pool.",
+				 function );
+
+				result = -1;
+			}
+			internal_handle->cache_pool_handle_identifier = -1;
+		}
 		*handle = NULL;
 
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
@@ -364,17 +406,6 @@ int libvmdk_handle_open(
 
 		return( -1 );
 	}
-	if( ( access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) != 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
-		 function );
-
-		return( -1 );
-	}
 	filename_length = narrow_string_length(
 	                   filename );
 
@@ -695,17 +726,6 @@ int libvmdk_handle_open_wide(
 
 		return( -1 );
 	}
-	if( ( access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) != 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
-		 function );
-
-		return( -1 );
-	}
 	filename_length = wide_string_length(
 	                   filename );
 
@@ -1050,21 +1070,10 @@ int libvmdk_handle_open_file_io_handle(
 
 		return( -1 );
 	}
-	if( ( access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) != 0 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
-		 function );
+	/* The descriptor is only read, also when opened for writing
+	 */
+	bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
 
-		return( -1 );
-	}
-	if( ( access_flags & LIBVMDK_ACCESS_FLAG_READ ) != 0 )
-	{
-		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
-	}
 	file_io_handle_is_open = libbfio_handle_is_open(
 	                          file_io_handle,
 	                          error );
@@ -1100,6 +1109,7 @@ int libvmdk_handle_open_file_io_handle(
 	}
 	result = libvmdk_handle_open_read_signature(
 		  file_io_handle,
+		  &( internal_handle->io_handle->statistics ),
 		  &file_type,
 		  error );
 
@@ -1137,6 +1147,7 @@ int libvmdk_handle_open_file_io_handle(
 			if( libvmdk_descriptor_file_read(
 			     descriptor_file,
 			     file_io_handle,
+			     &( internal_handle->io_handle->statistics ),
 			     error ) != 1 )
 			{
 				libcerror_error_set(
@@ -1374,26 +1385,29 @@ on_error:
 	return( -1 );
 }
 
-/* Opens the extent data files
- * If the extent data filenames were not set explicitly this function assumes the extent data files
- * are in the same location as the descriptor file
+/* Creates a delta (child) disk on top of a parent and opens it for reading and writing
+ * The delta disk is created as an empty monolithic sparse image that refers to the parent
+ * by its content identifier and the parent filename hint
+ * Grains that are not written to the delta disk are read from the parent, partially
+ * written grains are filled with the parent data (copy-on-write)
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_open_extent_data_files(
+int libvmdk_handle_create_child(
      libvmdk_handle_t *handle,
+     const char *filename,
+     libvmdk_handle_t *parent_handle,
+     const char *parent_filename,
      libcerror_error_t **error )
 {
-	libbfio_pool_t *file_io_pool                            = NULL;
-	libvmdk_internal_extent_descriptor_t *extent_descriptor = NULL;
-	libvmdk_internal_handle_t *internal_handle              = NULL;
-	system_character_t *extent_data_file_location           = NULL;
-	system_character_t *extent_data_filename_start          = NULL;
-	static char *function                                   = "libvmdk_handle_open_extent_data_files";
-	size_t extent_data_file_location_size                   = 0;
-	size_t extent_data_filename_size                        = 0;
-	int extent_index                                        = 0;
-	int number_of_extents                                   = 0;
-	int result                                              = 0;
+	libbfio_handle_t *file_io_handle           = NULL;
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	const char *basename                       = NULL;
+	static char *function                      = "libvmdk_handle_create_child";
+	size64_t media_size                        = 0;
+	size_t filename_length                     = 0;
+	uint32_t content_identifier                = 0;
+	uint32_t parent_content_identifier         = 0;
+	int handle_is_open                         = 0;
 
 	if( handle == NULL )
 	{
@@ -1408,325 +1422,271 @@ int libvmdk_handle_open_extent_data_files(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( ( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_READ ) == 0 )
-	 && ( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) == 0 ) )
+	if( internal_handle->descriptor_file != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - descriptor file value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) != 0 )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->descriptor_file == NULL )
+	if( parent_filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->extent_data_file_io_pool != NULL )
+	if( libvmdk_handle_get_media_size(
+	     parent_handle,
+	     &media_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - extent data file IO pool already exists.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size from parent handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libvmdk_handle_get_content_identifier(
+	     parent_handle,
+	     &parent_content_identifier,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve content identifier from parent handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libvmdk_descriptor_file_get_number_of_extents(
-	     internal_handle->descriptor_file,
-	     &number_of_extents,
+	content_identifier = (uint32_t) time( NULL );
+
+	if( ( content_identifier == parent_content_identifier )
+	 || ( content_identifier == 0xffffffffUL ) )
+	{
+		content_identifier ^= 0x00000001UL;
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	/* The embedded descriptor refers to the extent by its basename
+	 */
+	basename = narrow_string_search_character_reverse(
+	            filename,
+	            (int) LIBCPATH_SEPARATOR,
+	            filename_length + 1 );
+
+	if( basename != NULL )
+	{
+		basename += 1;
+	}
+	else
+	{
+		basename = filename;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of extents.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( number_of_extents == 0 )
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid number of extents value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libbfio_pool_initialize(
-	     &file_io_pool,
-	     number_of_extents,
-	     internal_handle->maximum_number_of_open_handles,
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	for( extent_index = 0;
-	     extent_index < number_of_extents;
-	     extent_index++ )
+	if( libvmdk_delta_disk_write(
+	     file_io_handle,
+	     media_size,
+	     internal_handle->create_grain_size,
+	     content_identifier,
+	     parent_content_identifier,
+	     (uint8_t *) parent_filename,
+	     narrow_string_length( parent_filename ) + 1,
+	     (uint8_t *) basename,
+	     narrow_string_length( basename ) + 1,
+	     error ) != 1 )
 	{
-		if( libvmdk_descriptor_file_get_extent_by_index(
-		     internal_handle->descriptor_file,
-		     extent_index,
-		     &extent_descriptor,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve extent: %d from descriptor file.",
-			 function,
-			 extent_index );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write delta disk.",
+		 function );
 
-			goto on_error;
-		}
-		if( extent_descriptor == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing extent descriptor: %d.",
-			 function,
-			 extent_index );
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
 
-			goto on_error;
-		}
-		if( extent_descriptor->type != LIBVMDK_EXTENT_TYPE_ZERO )
-		{
-			if( ( extent_descriptor->filename == NULL )
-			 || ( extent_descriptor->filename_size == 0 ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-				 "%s: invalid extent descriptor: %d - missing filename.",
-				 function,
-				 extent_index );
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
 
-				goto on_error;
-			}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-			extent_data_filename_start = wide_string_search_character_reverse(
-			                              extent_descriptor->filename,
-			                              (wint_t) LIBCPATH_SEPARATOR,
-			                              extent_descriptor->filename_size );
-#else
-			extent_data_filename_start = narrow_string_search_character_reverse(
-			                              extent_descriptor->filename,
-			                              (int) LIBCPATH_SEPARATOR,
-			                              extent_descriptor->filename_size );
-#endif
-			if( extent_data_filename_start != NULL )
-			{
-				/* Ignore the path separator itself
-				 */
-				extent_data_filename_start++;
+		goto on_error;
+	}
+	if( libvmdk_handle_open(
+	     handle,
+	     filename,
+	     LIBVMDK_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open delta disk: %s.",
+		 function,
+		 filename );
 
-/* TODO does this work for UTF-16 ? */
-				extent_data_filename_size = (size_t) ( extent_data_filename_start - extent_descriptor->filename );
-			}
-			else
-			{
-				extent_data_filename_start = extent_descriptor->filename;
-				extent_data_filename_size  = extent_descriptor->filename_size;
-			}
-/* TODO refactor to a function in extent table */
-			if( internal_handle->extent_table->data_files_path != NULL )
-			{
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-				if( libcpath_path_join_wide(
-				     &extent_data_file_location,
-				     &extent_data_file_location_size,
-				     internal_handle->extent_table->data_files_path,
-				     internal_handle->extent_table->data_files_path_size - 1,
-				     extent_data_filename_start,
-				     extent_data_filename_size - 1,
-				     error ) != 1 )
-#else
-				if( libcpath_path_join(
-				     &extent_data_file_location,
-				     &extent_data_file_location_size,
-				     internal_handle->extent_table->data_files_path,
-				     internal_handle->extent_table->data_files_path_size - 1,
-				     extent_data_filename_start,
-				     extent_data_filename_size - 1,
-				     error ) != 1 )
-#endif
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-					 "%s: unable to create extent data file location.",
-					 function );
-
-					goto on_error;
-				}
-			}
-			else
-			{
-				extent_data_file_location      = extent_data_filename_start;
-				extent_data_file_location_size = extent_data_filename_size;
-			}
-/* TODO add support for alternate extent file name */
-			/* Note that the open extent data file function will initialize extent_data_file_io_pool
-			 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-			result = libvmdk_handle_open_extent_data_file_wide(
-				  internal_handle,
-				  file_io_pool,
-				  extent_index,
-				  extent_data_file_location,
-				  error );
-#else
-			result = libvmdk_handle_open_extent_data_file(
-				  internal_handle,
-				  file_io_pool,
-				  extent_index,
-				  extent_data_file_location,
-				  error );
-#endif
-			if( result != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_OPEN_FAILED,
-				 "%s: unable to open extent data file: %" PRIs_SYSTEM ".",
-				 function,
-				 extent_data_file_location );
-
-				goto on_error;
-			}
-			if( ( extent_data_file_location != NULL )
-			 && ( extent_data_file_location != extent_data_filename_start ) )
-			{
-				memory_free(
-				 extent_data_file_location );
-			}
-			extent_data_filename_start = NULL;
-			extent_data_file_location  = NULL;
-		}
+		goto on_error;
 	}
-	if( libvmdk_handle_open_read_grain_table(
-	     internal_handle,
-	     file_io_pool,
+	handle_is_open = 1;
+
+	if( libvmdk_handle_open_extent_data_files(
+	     handle,
 	     error ) != 1 )
 	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to read grain table.",
-                 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
 
-                goto on_error;
+		goto on_error;
 	}
-	internal_handle->extent_data_file_io_pool                    = file_io_pool;
-	internal_handle->extent_data_file_io_pool_created_in_library = 1;
-
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	if( libvmdk_handle_set_parent_handle(
+	     handle,
+	     parent_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to set parent handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
 	return( 1 );
 
 on_error:
-	if( file_io_pool != NULL )
+	if( handle_is_open != 0 )
 	{
-		libbfio_pool_close_all(
-		 file_io_pool,
-		 NULL );
-		libbfio_pool_free(
-		 &file_io_pool,
+		libvmdk_handle_close(
+		 handle,
 		 NULL );
 	}
-	if( ( extent_data_file_location != NULL )
-	 && ( extent_data_file_location != extent_data_filename_start ) )
+	if( file_io_handle != NULL )
 	{
-		memory_free(
-		 extent_data_file_location );
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
 	return( -1 );
 }
 
-/* Opens the extent data files using a Basic File IO (bfio) pool
- * This function assumes the extent data files are in same order as defined by the descriptor file
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Creates a delta (child) disk on top of a parent and opens it for reading and writing
+ * The parent filename hint is stored UTF-8 encoded in the descriptor
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_open_extent_data_files_file_io_pool(
+int libvmdk_handle_create_child_wide(
      libvmdk_handle_t *handle,
-     libbfio_pool_t *file_io_pool,
+     const wchar_t *filename,
+     libvmdk_handle_t *parent_handle,
+     const wchar_t *parent_filename,
      libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle           = NULL;
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_open_extent_data_files_file_io_pool";
+	uint8_t *utf8_basename                     = NULL;
+	uint8_t *utf8_parent_filename              = NULL;
+	const wchar_t *basename                    = NULL;
+	static char *function                      = "libvmdk_handle_create_child_wide";
+	size64_t media_size                        = 0;
+	size_t filename_length                     = 0;
+	size_t utf8_basename_size                  = 0;
+	size_t utf8_parent_filename_size           = 0;
+	uint32_t content_identifier                = 0;
+	uint32_t parent_content_identifier         = 0;
+	int handle_is_open                         = 0;
+	int result                                 = 0;
 
 	if( handle == NULL )
 	{
@@ -1741,384 +1701,416 @@ int libvmdk_handle_open_extent_data_files_file_io_pool(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( ( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_READ ) == 0 )
-	 && ( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) == 0 ) )
+	if( internal_handle->descriptor_file != NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported access flags.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - descriptor file value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) != 0 )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->descriptor_file == NULL )
+	if( parent_filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->extent_data_file_io_pool != NULL )
+	if( libvmdk_handle_get_media_size(
+	     parent_handle,
+	     &media_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - extent data file IO pool already exists.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size from parent handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
+	if( libvmdk_handle_get_content_identifier(
+	     parent_handle,
+	     &parent_content_identifier,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve content identifier from parent handle.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libvmdk_handle_open_read_grain_table(
-	     internal_handle,
-	     file_io_pool,
-	     error ) != 1 )
+	content_identifier = (uint32_t) time( NULL );
+
+	if( ( content_identifier == parent_content_identifier )
+	 || ( content_identifier == 0xffffffffUL ) )
 	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to read grain table.",
-                 function );
+		content_identifier ^= 0x00000001UL;
+	}
+	filename_length = wide_string_length(
+	                   filename );
 
-                goto on_error;
+	/* The embedded descriptor refers to the extent by its basename
+	 */
+	basename = wide_string_search_character_reverse(
+	            filename,
+	            (wint_t) LIBCPATH_SEPARATOR,
+	            filename_length + 1 );
+
+	if( basename != NULL )
+	{
+		basename += 1;
 	}
-	internal_handle->extent_data_file_io_pool = file_io_pool;
+	else
+	{
+		basename = filename;
+	}
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_size_from_utf32(
+	          (libuna_utf32_character_t *) basename,
+	          wide_string_length( basename ) + 1,
+	          &utf8_basename_size,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_size_from_utf16(
+	          (libuna_utf16_character_t *) basename,
+	          wide_string_length( basename ) + 1,
+	          &utf8_basename_size,
+	          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
 
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine UTF-8 basename size.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Opens a specific extent data file
- * Returns 1 if successful or -1 on error
- */
-int libvmdk_handle_open_extent_data_file(
-     libvmdk_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
-     int extent_index,
-     const char *filename,
-     libcerror_error_t **error )
-{
-	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libvmdk_handle_open_extent_data_file";
-	size_t filename_length           = 0;
-	int bfio_access_flags            = 0;
+	utf8_basename = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * utf8_basename_size );
 
-	if( internal_handle == NULL )
+	if( utf8_basename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create UTF-8 basename.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( filename == NULL )
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_copy_from_utf32(
+	          utf8_basename,
+	          utf8_basename_size,
+	          (libuna_utf32_character_t *) basename,
+	          wide_string_length( basename ) + 1,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_copy_from_utf16(
+	          utf8_basename,
+	          utf8_basename_size,
+	          (libuna_utf16_character_t *) basename,
+	          wide_string_length( basename ) + 1,
+	          error );
+#endif /* SIZEOF_WCHAR_T */
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filename.",
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set UTF-8 basename.",
 		 function );
 
-		return( -1 );
-	}
-	if( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_READ ) != 0 )
-	{
-		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
+		goto on_error;
 	}
-	if( libbfio_file_initialize(
-	     &file_io_handle,
-	     error ) != 1 )
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_size_from_utf32(
+	          (libuna_utf32_character_t *) parent_filename,
+	          wide_string_length( parent_filename ) + 1,
+	          &utf8_parent_filename_size,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_size_from_utf16(
+	          (libuna_utf16_character_t *) parent_filename,
+	          wide_string_length( parent_filename ) + 1,
+	          &utf8_parent_filename_size,
+	          error );
+#endif /* SIZEOF_WCHAR_T */
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine UTF-8 parent filename size.",
 		 function );
 
 		goto on_error;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libbfio_handle_set_track_offsets_read(
-	     file_io_handle,
-	     1,
-	     error ) != 1 )
+	utf8_parent_filename = (uint8_t *) memory_allocate(
+	                                    sizeof( uint8_t ) * utf8_parent_filename_size );
+
+	if( utf8_parent_filename == NULL )
 	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to set track offsets read in file IO handle.",
-                 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create UTF-8 parent filename.",
+		 function );
 
-                goto on_error;
+		goto on_error;
 	}
-#endif
-	filename_length = narrow_string_length(
-	                   filename );
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_copy_from_utf32(
+	          utf8_parent_filename,
+	          utf8_parent_filename_size,
+	          (libuna_utf32_character_t *) parent_filename,
+	          wide_string_length( parent_filename ) + 1,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_copy_from_utf16(
+	          utf8_parent_filename,
+	          utf8_parent_filename_size,
+	          (libuna_utf16_character_t *) parent_filename,
+	          wide_string_length( parent_filename ) + 1,
+	          error );
+#endif /* SIZEOF_WCHAR_T */
 
-	if( libbfio_file_set_name(
-	     file_io_handle,
-	     filename,
-	     filename_length + 1,
-	     error ) != 1 )
+	if( result != 1 )
 	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to set filename in file IO handle.",
-                 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set UTF-8 parent filename.",
+		 function );
 
-                goto on_error;
+		goto on_error;
 	}
-	if( libbfio_handle_open(
-	     file_io_handle,
-	     bfio_access_flags,
+	if( libbfio_file_initialize(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open file IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( libbfio_pool_set_handle(
-	     file_io_pool,
-	     extent_index,
+	if( libbfio_file_set_name_wide(
 	     file_io_handle,
-	     bfio_access_flags,
+	     filename,
+	     filename_length + 1,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set file IO handle: %d in pool.",
-		 function,
-		 extent_index );
+		 "%s: unable to set name in file IO handle.",
+		 function );
 
 		goto on_error;
 	}
-	return( 1 );
-
-on_error:
-	if( file_io_handle != NULL )
-	{
-		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
-	}
-	return( -1 );
-}
-
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
-
-/* Opens a specific extent data file
- * Returns 1 if successful or -1 on error
- */
-int libvmdk_handle_open_extent_data_file_wide(
-     libvmdk_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
-     int extent_index,
-     const wchar_t *filename,
-     libcerror_error_t **error )
-{
-	libbfio_handle_t *file_io_handle = NULL;
-	static char *function            = "libvmdk_handle_open_extent_data_file_wide";
-	size_t filename_length           = 0;
-	int bfio_access_flags            = 0;
-
-	if( internal_handle == NULL )
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( filename == NULL )
+	if( libvmdk_delta_disk_write(
+	     file_io_handle,
+	     media_size,
+	     internal_handle->create_grain_size,
+	     content_identifier,
+	     parent_content_identifier,
+	     utf8_parent_filename,
+	     utf8_parent_filename_size,
+	     utf8_basename,
+	     utf8_basename_size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filename.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write delta disk.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_READ ) != 0 )
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
 	{
-		bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
 	}
-	if( libbfio_file_initialize(
+	if( libbfio_handle_free(
 	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create file IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
 		 function );
 
-                goto on_error;
+		goto on_error;
 	}
-#if defined( HAVE_DEBUG_OUTPUT )
-	if( libbfio_handle_set_track_offsets_read(
-	     file_io_handle,
-	     1,
-	     error ) != 1 )
-	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to set track offsets read in file IO handle.",
-                 function );
+	memory_free(
+	 utf8_parent_filename );
 
-                goto on_error;
-	}
-#endif
-	filename_length = wide_string_length(
-	                   filename );
+	utf8_parent_filename = NULL;
 
-	if( libbfio_file_set_name_wide(
-	     file_io_handle,
+	memory_free(
+	 utf8_basename );
+
+	utf8_basename = NULL;
+
+	if( libvmdk_handle_open_wide(
+	     handle,
 	     filename,
-	     filename_length + 1,
+	     LIBVMDK_OPEN_READ_WRITE,
 	     error ) != 1 )
 	{
-                libcerror_error_set(
-                 error,
-                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-                 "%s: unable to set filename in file IO handle.",
-                 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open delta disk.",
+		 function );
 
-                goto on_error;
+		goto on_error;
 	}
-	if( libbfio_handle_open(
-	     file_io_handle,
-	     bfio_access_flags,
+	handle_is_open = 1;
+
+	if( libvmdk_handle_open_extent_data_files(
+	     handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open file IO handle.",
+		 "%s: unable to open extent data files.",
 		 function );
 
 		goto on_error;
 	}
-	if( libbfio_pool_set_handle(
-	     file_io_pool,
-	     extent_index,
-	     file_io_handle,
-	     bfio_access_flags,
+	if( libvmdk_handle_set_parent_handle(
+	     handle,
+	     parent_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set file IO handle: %d in pool.",
-		 function,
-		 extent_index );
+		 "%s: unable to set parent handle.",
+		 function );
 
 		goto on_error;
 	}
 	return( 1 );
 
 on_error:
+	if( handle_is_open != 0 )
+	{
+		libvmdk_handle_close(
+		 handle,
+		 NULL );
+	}
 	if( file_io_handle != NULL )
 	{
 		libbfio_handle_free(
 		 &file_io_handle,
 		 NULL );
 	}
+	if( utf8_parent_filename != NULL )
+	{
+		memory_free(
+		 utf8_parent_filename );
+	}
+	if( utf8_basename != NULL )
+	{
+		memory_free(
+		 utf8_basename );
+	}
 	return( -1 );
 }
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
-/* Closes the VMDK file(s)
- * Returns 0 if successful or -1 on error
+/* Creates an empty monolithic sparse disk and opens it for reading and writing
+ * The media size must be a multiple of the sector size
+ * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_close(
+int libvmdk_handle_create_sparse(
      libvmdk_handle_t *handle,
+     const char *filename,
+     size64_t media_size,
      libcerror_error_t **error )
 {
+	libbfio_handle_t *file_io_handle           = NULL;
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_close";
-	int result                                 = 0;
+	const char *basename                       = NULL;
+	static char *function                      = "libvmdk_handle_create_sparse";
+	size_t filename_length                     = 0;
+	uint32_t content_identifier                = 0;
+	int handle_is_open                         = 0;
 
 	if( handle == NULL )
 	{
@@ -2133,163 +2125,225 @@ int libvmdk_handle_close(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->descriptor_file != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - descriptor file value already set.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( internal_handle->extent_data_file_io_pool_created_in_library != 0 )
+	if( filename == NULL )
 	{
-		if( libbfio_pool_close_all(
-		     internal_handle->extent_data_file_io_pool,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close all files.",
-			 function );
-
-			result = -1;
-		}
-		if( libbfio_pool_free(
-		     &( internal_handle->extent_data_file_io_pool ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to extent data free file IO pool.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
 
-			result = -1;
-		}
-		internal_handle->extent_data_file_io_pool_created_in_library = 0;
+		return( -1 );
 	}
-	internal_handle->extent_data_file_io_pool = NULL;
-	internal_handle->current_offset           = 0;
-
-	if( libvmdk_io_handle_clear(
-	     internal_handle->io_handle,
-	     error ) != 1 )
+	if( media_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear IO handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid media size value zero or less.",
 		 function );
 
-		result = -1;
+		return( -1 );
 	}
-	if( internal_handle->descriptor_file != NULL )
+	content_identifier = (uint32_t) time( NULL );
+
+	if( content_identifier == 0xffffffffUL )
 	{
-		if( libvmdk_descriptor_file_free(
-		     &( internal_handle->descriptor_file ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free descriptor file.",
-			 function );
+		content_identifier ^= 0x00000001UL;
+	}
+	filename_length = narrow_string_length(
+	                   filename );
 
-			result = -1;
-		}
+	/* The embedded descriptor refers to the extent by its basename
+	 */
+	basename = narrow_string_search_character_reverse(
+	            filename,
+	            (int) LIBCPATH_SEPARATOR,
+	            filename_length + 1 );
+
+	if( basename != NULL )
+	{
+		basename += 1;
 	}
-	if( internal_handle->grain_table != NULL )
+	else
 	{
-		if( libvmdk_grain_table_free(
-		     &( internal_handle->grain_table ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free grain table.",
-			 function );
+		basename = filename;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( internal_handle->grains_cache != NULL )
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
 	{
-		if( libfcache_cache_free(
-		     &( internal_handle->grains_cache ),
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free grains cache.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
 
-			result = -1;
-		}
+		goto on_error;
 	}
-	if( libvmdk_extent_table_clear(
-	     internal_handle->extent_table,
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_delta_disk_write(
+	     file_io_handle,
+	     media_size,
+	     internal_handle->create_grain_size,
+	     content_identifier,
+	     0xffffffffUL,
+	     NULL,
+	     0,
+	     (uint8_t *) basename,
+	     narrow_string_length( basename ) + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write sparse disk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-		 "%s: unable to clear extent table.",
+		 "%s: unable to free file IO handle.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
-	     internal_handle->read_write_lock,
+	if( libvmdk_handle_open(
+	     handle,
+	     filename,
+	     LIBVMDK_OPEN_READ_WRITE,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open sparse disk: %s.",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	handle_is_open = 1;
+
+	if( libvmdk_handle_open_extent_data_files(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	return( result );
+	return( 1 );
+
+on_error:
+	if( handle_is_open != 0 )
+	{
+		libvmdk_handle_close(
+		 handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
 }
 
-/* Reads the grain table
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Creates an empty monolithic sparse disk and opens it for reading and writing
+ * The media size must be a multiple of the sector size
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_open_read_grain_table(
-     libvmdk_internal_handle_t *internal_handle,
-     libbfio_pool_t *file_io_pool,
+int libvmdk_handle_create_sparse_wide(
+     libvmdk_handle_t *handle,
+     const wchar_t *filename,
+     size64_t media_size,
      libcerror_error_t **error )
 {
-	libvmdk_internal_extent_descriptor_t *extent_descriptor = NULL;
-	libvmdk_extent_file_t *extent_file                      = NULL;
-	static char *function                                   = "libvmdk_handle_open_read_grain_table";
-	size64_t extent_file_size                               = 0;
-	int extent_index                                        = 0;
-	int number_of_extents                                   = 0;
-	int number_of_file_io_handles                           = 0;
+	libbfio_handle_t *file_io_handle           = NULL;
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	uint8_t *utf8_basename                     = NULL;
+	const wchar_t *basename                    = NULL;
+	static char *function                      = "libvmdk_handle_create_sparse_wide";
+	size_t filename_length                     = 0;
+	size_t utf8_basename_size                  = 0;
+	uint32_t content_identifier                = 0;
+	int handle_is_open                         = 0;
+	int result                                 = 0;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2300,644 +2354,749 @@ int libvmdk_handle_open_read_grain_table(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - descriptor file value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->descriptor_file == NULL )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->grain_table != NULL )
+	if( media_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - grain table already set.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid media size value zero or less.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->grains_cache != NULL )
+	content_identifier = (uint32_t) time( NULL );
+
+	if( content_identifier == 0xffffffffUL )
+	{
+		content_identifier ^= 0x00000001UL;
+	}
+	filename_length = wide_string_length(
+	                   filename );
+
+	/* The embedded descriptor refers to the extent by its basename
+	 */
+	basename = wide_string_search_character_reverse(
+	            filename,
+	            (wint_t) LIBCPATH_SEPARATOR,
+	            filename_length + 1 );
+
+	if( basename != NULL )
+	{
+		basename += 1;
+	}
+	else
+	{
+		basename = filename;
+	}
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_size_from_utf32(
+	          (libuna_utf32_character_t *) basename,
+	          wide_string_length( basename ) + 1,
+	          &utf8_basename_size,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_size_from_utf16(
+	          (libuna_utf16_character_t *) basename,
+	          wide_string_length( basename ) + 1,
+	          &utf8_basename_size,
+	          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid handle - grains cache already set.",
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine UTF-8 basename size.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( libvmdk_descriptor_file_get_number_of_extents(
-	     internal_handle->descriptor_file,
-	     &number_of_extents,
-	     error ) != 1 )
+	utf8_basename = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * utf8_basename_size );
+
+	if( utf8_basename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of extents.",
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create UTF-8 basename.",
 		 function );
 
 		goto on_error;
 	}
-	if( number_of_extents == 0 )
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_copy_from_utf32(
+	          utf8_basename,
+	          utf8_basename_size,
+	          (libuna_utf32_character_t *) basename,
+	          wide_string_length( basename ) + 1,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_copy_from_utf16(
+	          utf8_basename,
+	          utf8_basename_size,
+	          (libuna_utf16_character_t *) basename,
+	          wide_string_length( basename ) + 1,
+	          error );
+#endif /* SIZEOF_WCHAR_T */
+
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing extents.",
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set UTF-8 basename.",
 		 function );
 
 		goto on_error;
 	}
-	if( libbfio_pool_get_number_of_handles(
-	     file_io_pool,
-	     &number_of_file_io_handles,
+	if( libbfio_file_initialize(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve the number of file IO handles.",
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	if( number_of_extents != number_of_file_io_handles )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: mismatch between number of file IO handles in pool and number of extents in metadata.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( libvmdk_extent_table_initialize_extents(
-	     internal_handle->extent_table,
-	     number_of_extents,
-	     internal_handle->descriptor_file->disk_type,
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize extent table extents.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( libvmdk_grain_table_initialize(
-	     &( internal_handle->grain_table ),
-	     internal_handle->io_handle,
+	if( libvmdk_delta_disk_write(
+	     file_io_handle,
+	     media_size,
+	     internal_handle->create_grain_size,
+	     content_identifier,
+	     0xffffffffUL,
+	     NULL,
+	     0,
+	     utf8_basename,
+	     utf8_basename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write sparse disk.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create grain table.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( libfcache_cache_initialize(
-	     &( internal_handle->grains_cache ),
-	     LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAINS,
+	memory_free(
+	 utf8_basename );
+
+	utf8_basename = NULL;
+
+	if( libvmdk_handle_open_wide(
+	     handle,
+	     filename,
+	     LIBVMDK_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open sparse disk.",
+		 function );
+
+		goto on_error;
+	}
+	handle_is_open = 1;
+
+	if( libvmdk_handle_open_extent_data_files(
+	     handle,
 	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle_is_open != 0 )
+	{
+		libvmdk_handle_close(
+		 handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( utf8_basename != NULL )
+	{
+		memory_free(
+		 utf8_basename );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Creates an empty split (2GB extent) sparse disk and opens it for reading and writing
+ * The filename is that of the descriptor file, the extent files are created
+ * next to it and named after the descriptor file without its .vmdk extension
+ * The media size must be a multiple of the sector size
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_create_split_sparse(
+     libvmdk_handle_t *handle,
+     const char *filename,
+     size64_t media_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle           = NULL;
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	char *extent_filename                      = NULL;
+	const char *basename                       = NULL;
+	static char *function                      = "libvmdk_handle_create_split_sparse";
+	size64_t extent_size                       = 0;
+	size64_t remaining_media_size              = 0;
+	size_t basename_offset                     = 0;
+	size_t extent_filename_size                = 0;
+	size_t filename_length                     = 0;
+	size_t prefix_length                       = 0;
+	uint32_t content_identifier                = 0;
+	int extent_number                          = 0;
+	int handle_is_open                         = 0;
+	int print_count                            = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to create grains cache.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - descriptor file value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid media size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size > ( (size64_t) 999 * LIBVMDK_DELTA_DISK_SPLIT_EXTENT_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	content_identifier = (uint32_t) time( NULL );
+
+	if( content_identifier == 0xffffffffUL )
+	{
+		content_identifier ^= 0x00000001UL;
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	prefix_length = filename_length;
+
+	if( ( filename_length > 5 )
+	 && ( narrow_string_compare_no_case(
+	       &( filename[ filename_length - 5 ] ),
+	       ".vmdk",
+	       5 ) == 0 ) )
+	{
+		prefix_length -= 5;
+	}
+	/* The descriptor refers to the extent files by their basename
+	 */
+	basename = narrow_string_search_character_reverse(
+	            filename,
+	            (int) LIBCPATH_SEPARATOR,
+	            filename_length + 1 );
+
+	if( basename != NULL )
+	{
+		basename_offset = (size_t) ( basename - filename ) + 1;
+	}
+	if( basename_offset >= prefix_length )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported filename: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	/* The extent filename consists of the prefix followed by -s###.vmdk
+	 */
+	extent_filename_size = prefix_length + 11;
+
+	extent_filename = narrow_string_allocate(
+	                   extent_filename_size );
+
+	if( extent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent filename.",
 		 function );
 
 		goto on_error;
 	}
-	for( extent_index = 0;
-	     extent_index < number_of_extents;
-	     extent_index++ )
+	if( narrow_string_copy(
+	     extent_filename,
+	     filename,
+	     prefix_length ) == NULL )
 	{
-		if( libvmdk_descriptor_file_get_extent_by_index(
-		     internal_handle->descriptor_file,
-		     extent_index,
-		     &extent_descriptor,
-		     error ) != 1 )
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extent filename prefix.",
+		 function );
+
+		goto on_error;
+	}
+	extent_filename[ prefix_length ] = 0;
+
+	remaining_media_size = media_size;
+
+	for( extent_number = 1;
+	     remaining_media_size > 0;
+	     extent_number++ )
+	{
+		extent_size = LIBVMDK_DELTA_DISK_SPLIT_EXTENT_SIZE;
+
+		if( extent_size > remaining_media_size )
+		{
+			extent_size = remaining_media_size;
+		}
+		print_count = narrow_string_snprintf(
+		               &( extent_filename[ prefix_length ] ),
+		               extent_filename_size - prefix_length,
+		               "-s%03d.vmdk",
+		               extent_number );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( extent_filename_size - prefix_length ) ) )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve extent: %d from descriptor file.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set extent: %d filename.",
 			 function,
-			 extent_index );
+			 extent_number );
 
 			goto on_error;
 		}
-		if( extent_descriptor == NULL )
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: missing extent descriptor: %d.",
-			 function,
-			 extent_index );
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
 
 			goto on_error;
 		}
-		if( libbfio_pool_get_size(
-		     file_io_pool,
-		     extent_index,
-		     &extent_file_size,
+		if( libbfio_file_set_name(
+		     file_io_handle,
+		     extent_filename,
+		     prefix_length + (size_t) print_count + 1,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve size of file IO pool entry: %d.",
-			 function,
-			 extent_index );
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in file IO handle.",
+			 function );
 
 			goto on_error;
 		}
-		if( libvmdk_extent_table_set_extent_by_extent_descriptor(
-		     internal_handle->extent_table,
-		     extent_descriptor,
-		     extent_index,
-		     extent_index,
-		     extent_file_size,
-		     extent_descriptor->offset,
-		     extent_descriptor->size,
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_WRITE_TRUNCATE,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set extent: %d in table.",
-			 function,
-			 extent_index );
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
 
 			goto on_error;
 		}
-		if( ( extent_descriptor->type == LIBVMDK_EXTENT_TYPE_SPARSE )
-		 || ( extent_descriptor->type == LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) )
+		if( libvmdk_delta_disk_write(
+		     file_io_handle,
+		     extent_size,
+		     internal_handle->create_grain_size,
+		     content_identifier,
+		     0xffffffffUL,
+		     NULL,
+		     0,
+		     NULL,
+		     0,
+		     error ) != 1 )
 		{
-			if( libvmdk_extent_file_initialize(
-			     &extent_file,
-			     internal_handle->io_handle,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-				 "%s: unable to create extent file: %d.",
-				 function,
-				 extent_index );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write extent: %d.",
+			 function,
+			 extent_number );
 
-				goto on_error;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "Reading extent file: %d file header:\n",
-				 extent_index );
-			}
-#endif
-			if( libvmdk_extent_file_read_file_header(
-			     extent_file,
-			     file_io_pool,
-			     extent_index,
-			     0,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read extent file: %d header.",
-				 function,
-				 extent_index );
-
-				goto on_error;
-			}
-			if( ( extent_file->file_type != LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA )
-			 && ( extent_file->file_type != LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: extent file type not supported for extent type.",
-				 function );
-
-				goto on_error;
-			}
-			if( ( internal_handle->descriptor_file->disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
-			 && ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
-			 && ( ( extent_file->flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != LIBVMDK_COMPRESSION_METHOD_NONE ) )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-				 "%s: grain compression not supported for disk type.",
-				 function );
-
-				goto on_error;
-			}
-			if( ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
-			 && ( extent_file->primary_grain_directory_offset == (off64_t) -1 )
-			 && ( extent_file->compression_method == LIBVMDK_COMPRESSION_METHOD_DEFLATE ) )
-			{
-				if( libvmdk_extent_file_read_file_header(
-				     extent_file,
-				     file_io_pool,
-				     extent_index,
-				     extent_file_size - 1024,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_IO,
-					 LIBCERROR_IO_ERROR_READ_FAILED,
-					 "%s: unable to read secondary extent file: %d header.",
-					 function,
-					 extent_index );
-
-					goto on_error;
-				}
-			}
-			if( extent_index == 0 )
-			{
-				internal_handle->io_handle->grain_size = extent_file->grain_size;
-			}
-			else if( extent_file->grain_size != internal_handle->io_handle->grain_size )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_INPUT,
-				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
-				 "%s: extent file: %d grain size mismatch.",
-				 function,
-				 extent_index );
-
-				goto on_error;
-			}
-			if( extent_file->is_dirty != 0 )
-			{
-				internal_handle->io_handle->is_dirty = 1;
-			}
-#if defined( HAVE_DEBUG_OUTPUT )
-			if( libcnotify_verbose != 0 )
-			{
-				libcnotify_printf(
-				 "Reading extent file: %d grain directories:\n",
-				 extent_index );
-			}
-#endif
-			if( libvmdk_extent_file_read_grain_directories(
-			     extent_file,
-			     file_io_pool,
-			     extent_index,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_READ_FAILED,
-				 "%s: unable to read extent file: %d grain directories.",
-				 function,
-				 extent_index );
-
-				goto on_error;
-			}
-			if( libvmdk_extent_table_set_extent_storage_media_size_by_index(
-			     internal_handle->extent_table,
-			     extent_index,
-			     extent_file->storage_media_size,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-				 "%s: unable to set mapped range of element: %d in extent table.",
-				 function,
-				 extent_index );
-
-				goto on_error;
-			}
-			if( libvmdk_extent_file_free(
-			     &extent_file,
-			     error ) != 1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-				 "%s: unable to free extent file.",
-				 function );
-
-				goto on_error;
-			}
+			goto on_error;
 		}
-		else if( ( extent_descriptor->type != LIBVMDK_EXTENT_TYPE_FLAT )
-		      && ( extent_descriptor->type != LIBVMDK_EXTENT_TYPE_VMFS_FLAT ) )
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported extent type.",
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
 			 function );
 
 			goto on_error;
 		}
-		if( internal_handle->io_handle->abort == 1 )
+		if( libbfio_handle_free(
+		     &file_io_handle,
+		     error ) != 1 )
 		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
 			goto on_error;
 		}
+		remaining_media_size -= extent_size;
 	}
-	return( 1 );
-
-on_error:
-	if( extent_file != NULL )
-	{
-		libvmdk_extent_file_free(
-		 &extent_file,
-		 NULL );
-	}
-	if( internal_handle->grains_cache != NULL )
-	{
-		libfcache_cache_free(
-		 &( internal_handle->grains_cache ),
-		 NULL );
-	}
-	if( internal_handle->grain_table != NULL )
-	{
-		libvmdk_grain_table_free(
-		 &( internal_handle->grain_table ),
-		 NULL );
-	}
-	return( -1 );
-}
-
-/* Reads the file signature and tries to determine the file type
- * Returns 1 if successful, 0 if no file type could be determined or -1 on error
- */
-int libvmdk_handle_open_read_signature(
-     libbfio_handle_t *file_io_handle,
-     uint8_t *file_type,
-     libcerror_error_t **error )
-{
-	libcsplit_narrow_split_string_t *lines = NULL;
-	uint8_t *signature                     = NULL;
-	static char *function                  = "libvmdk_handle_open_read_signature";
-	ssize_t read_count                     = 0;
-	int line_index                         = 0;
-	int number_of_lines                    = 0;
-	int result                             = 0;
+	extent_filename[ prefix_length ] = 0;
 
-	if( file_type == NULL )
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid file type.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
 		 function );
 
-		return( -1 );
+		goto on_error;
 	}
-	signature = (uint8_t *) memory_allocate(
-	                         sizeof( uint8_t ) * 2048 );
-
-	if( signature == NULL )
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create signature.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( memory_set(
-	     signature,
-	     0,
-	     sizeof( uint8_t ) * 2048 ) == NULL )
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-		 "%s: unable to clear signature.",
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( libbfio_handle_seek_offset(
+	if( libvmdk_delta_disk_write_split_descriptor(
 	     file_io_handle,
-	     0,
-	     SEEK_SET,
-	     error ) == -1 )
+	     media_size,
+	     LIBVMDK_DELTA_DISK_SPLIT_EXTENT_SIZE,
+	     content_identifier,
+	     (uint8_t *) &( extent_filename[ basename_offset ] ),
+	     prefix_length - basename_offset + 1,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset: 0.",
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write descriptor file.",
 		 function );
 
 		goto on_error;
 	}
-	read_count = libbfio_handle_read_buffer(
-	              file_io_handle,
-	              signature,
-	              32,
-	              error );
-
-	if( read_count != (ssize_t) 32 )
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read signature.",
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
 		 function );
 
 		goto on_error;
 	}
-	if( memory_compare(
-	     signature,
-	     cowd_sparse_file_signature,
-	     4 ) == 0 )
-	{
-		*file_type = LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA;
-		result     = 1;
-	}
-	else if( memory_compare(
-	          signature,
-	          vmdk_sparse_file_signature,
-	          4 ) == 0 )
-	{
-		*file_type = LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA;
-		result     = 1;
-	}
-	else if( signature[ 0 ] == '#' )
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
 	{
-		read_count = libbfio_handle_read_buffer(
-		              file_io_handle,
-		              &( signature[ 32 ] ),
-		              2048 - 32,
-		              error );
-
-		if( read_count == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read signature.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
 
-			goto on_error;
-		}
-		if( libcsplit_narrow_string_split(
-		     (char *) signature,
-		     32 + read_count,
-		     '\n',
-		     &lines,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to split file data into lines.",
-			 function );
+		goto on_error;
+	}
+	memory_free(
+	 extent_filename );
 
-			goto on_error;
-		}
-		if( libcsplit_narrow_split_string_get_number_of_segments(
-		     lines,
-		     &number_of_lines,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to retrieve number of lines.",
-			 function );
+	extent_filename = NULL;
 
-			goto on_error;
-		}
-		result = libvmdk_descriptor_file_read_signature(
-			  lines,
-			  number_of_lines,
-			  &line_index,
-		          error );
+	if( libvmdk_handle_open(
+	     handle,
+	     filename,
+	     LIBVMDK_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open split sparse disk: %s.",
+		 function,
+		 filename );
 
-		if( result == -1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read descriptor file.",
-			 function );
+		goto on_error;
+	}
+	handle_is_open = 1;
 
-			goto on_error;
-		}
-		else if( result != 0 )
-		{
-			*file_type = LIBVMDK_FILE_TYPE_DESCRIPTOR_FILE;
-		}
-		if( libcsplit_narrow_split_string_free(
-		     &lines,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free lines.",
-			 function );
+	if( libvmdk_handle_open_extent_data_files(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
 
-			goto on_error;
-		}
+		goto on_error;
 	}
-	memory_free(
-	 signature );
-
-	return( result );
+	return( 1 );
 
 on_error:
-	if( lines != NULL )
+	if( handle_is_open != 0 )
 	{
-		libcsplit_narrow_split_string_free(
-		 &lines,
+		libvmdk_handle_close(
+		 handle,
 		 NULL );
 	}
-	if( signature != NULL )
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( extent_filename != NULL )
 	{
 		memory_free(
-		 signature );
+		 extent_filename );
 	}
 	return( -1 );
 }
 
-/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of bytes read or -1 on error
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Creates an empty split (2GB extent) sparse disk and opens it for reading and writing
+ * The filename is that of the descriptor file, the extent files are created
+ * next to it and named after the descriptor file without its .vmdk extension
+ * The media size must be a multiple of the sector size
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
-         libvmdk_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libvmdk_handle_create_split_sparse_wide(
+     libvmdk_handle_t *handle,
+     const wchar_t *filename,
+     size64_t media_size,
+     libcerror_error_t **error )
 {
-	libvmdk_grain_data_t *grain_data = NULL;
-	static char *function            = "libvmdk_internal_handle_read_buffer_from_file_io_pool";
-	size_t buffer_offset             = 0;
-	size_t read_size                 = 0;
-	ssize_t read_count               = 0;
-	off64_t grain_data_offset        = 0;
-	uint64_t grain_index             = 0;
-	int grain_is_sparse              = 0;
+	libbfio_handle_t *file_io_handle           = NULL;
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	wchar_t *extent_filename                   = NULL;
+	uint8_t *utf8_prefix                       = NULL;
+	const wchar_t *basename                    = NULL;
+	static char *function                      = "libvmdk_handle_create_split_sparse_wide";
+	char extent_filename_suffix[ 12 ];
+	size64_t extent_size                       = 0;
+	size64_t remaining_media_size              = 0;
+	size_t basename_offset                     = 0;
+	size_t extent_filename_size                = 0;
+	size_t filename_length                     = 0;
+	size_t prefix_length                       = 0;
+	size_t suffix_index                        = 0;
+	size_t utf8_prefix_size                    = 0;
+	uint32_t content_identifier                = 0;
+	int extent_number                          = 0;
+	int handle_is_open                         = 0;
+	int print_count                            = 0;
+	int result                                 = 0;
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -2948,338 +3107,7114 @@ ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - descriptor file value already set.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->current_offset < 0 )
+	if( filename == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( internal_handle->descriptor_file == NULL )
+	if( media_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid media size value zero or less.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( internal_handle->descriptor_file->parent_content_identifier_set != 0 )
-	 && ( internal_handle->descriptor_file->parent_content_identifier != 0xffffffffUL ) )
-	{
-		if( internal_handle->parent_handle == NULL )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-			 "%s: invalid handle - missing parent handle.",
-			 function );
-
-			return( -1 );
-		}
-	}
-	if( buffer == NULL )
+	if( media_size > ( (size64_t) 999 * LIBVMDK_DELTA_DISK_SPLIT_EXTENT_SIZE ) )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid buffer.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid media size value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size > (size_t) SSIZE_MAX )
+	content_identifier = (uint32_t) time( NULL );
+
+	if( content_identifier == 0xffffffffUL )
+	{
+		content_identifier ^= 0x00000001UL;
+	}
+	filename_length = wide_string_length(
+	                   filename );
+
+	prefix_length = filename_length;
+
+	if( ( filename_length > 5 )
+	 && ( wide_string_compare_no_case(
+	       &( filename[ filename_length - 5 ] ),
+	       L".vmdk",
+	       5 ) == 0 ) )
+	{
+		prefix_length -= 5;
+	}
+	/* The descriptor refers to the extent files by their basename
+	 */
+	basename = wide_string_search_character_reverse(
+	            filename,
+	            (wint_t) LIBCPATH_SEPARATOR,
+	            filename_length + 1 );
+
+	if( basename != NULL )
+	{
+		basename_offset = (size_t) ( basename - filename ) + 1;
+	}
+	if( basename_offset >= prefix_length )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid element data size value exceeds maximum.",
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported filename.",
 		 function );
 
 		return( -1 );
 	}
-	if( buffer_size == 0 )
+	/* The extent filename consists of the prefix followed by -s###.vmdk
+	 */
+	extent_filename_size = prefix_length + 11;
+
+	extent_filename = wide_string_allocate(
+	                   extent_filename_size );
+
+	if( extent_filename == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create extent filename.",
+		 function );
+
+		goto on_error;
 	}
-	if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
+	if( wide_string_copy(
+	     extent_filename,
+	     filename,
+	     prefix_length ) == NULL )
 	{
-		return( 0 );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extent filename prefix.",
+		 function );
+
+		goto on_error;
 	}
-	if( internal_handle->extent_table->extent_files_stream != NULL )
+	extent_filename[ prefix_length ] = 0;
+
+	remaining_media_size = media_size;
+
+	for( extent_number = 1;
+	     remaining_media_size > 0;
+	     extent_number++ )
 	{
-		if( libfdata_stream_seek_offset(
-		     internal_handle->extent_table->extent_files_stream,
-		     internal_handle->current_offset,
-		     SEEK_SET,
-		     error ) == -1 )
+		extent_size = LIBVMDK_DELTA_DISK_SPLIT_EXTENT_SIZE;
+
+		if( extent_size > remaining_media_size )
+		{
+			extent_size = remaining_media_size;
+		}
+		print_count = narrow_string_snprintf(
+		               extent_filename_suffix,
+		               12,
+		               "-s%03d.vmdk",
+		               extent_number );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( extent_filename_size - prefix_length ) ) )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to seek offset in extent files stream.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set extent: %d filename.",
+			 function,
+			 extent_number );
 
-			return( -1 );
+			goto on_error;
 		}
-		read_size = buffer_size;
-
-		if( (size64_t) ( internal_handle->current_offset + read_size ) > internal_handle->io_handle->media_size )
+		/* The suffix only contains ASCII characters
+		 */
+		for( suffix_index = 0;
+		     suffix_index <= (size_t) print_count;
+		     suffix_index++ )
 		{
-			read_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
+			extent_filename[ prefix_length + suffix_index ] = (wchar_t) extent_filename_suffix[ suffix_index ];
 		}
-		read_count = libfdata_stream_read_buffer(
-		              internal_handle->extent_table->extent_files_stream,
-			      (intptr_t *) file_io_pool,
-			      (uint8_t *) buffer,
-			      read_size,
-			      0,
-			      error );
+		if( libbfio_file_initialize(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create file IO handle.",
+			 function );
 
-		if( read_count != (ssize_t) read_size )
+			goto on_error;
+		}
+		if( libbfio_file_set_name_wide(
+		     file_io_handle,
+		     extent_filename,
+		     prefix_length + (size_t) print_count + 1,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_READ_FAILED,
-			 "%s: unable to read buffer from extent files stream.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set name in file IO handle.",
 			 function );
 
-			return( -1 );
+			goto on_error;
 		}
-		buffer_offset = read_size;
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
 
-		internal_handle->current_offset += (off64_t) read_size;
-	}
-	else
-	{
-/* TODO refactor to separate function */
-#if defined( HAVE_DEBUG_OUTPUT )
-		if( libcnotify_verbose != 0 )
+			goto on_error;
+		}
+		if( libvmdk_delta_disk_write(
+		     file_io_handle,
+		     extent_size,
+		     internal_handle->create_grain_size,
+		     content_identifier,
+		     0xffffffffUL,
+		     NULL,
+		     0,
+		     NULL,
+		     0,
+		     error ) != 1 )
 		{
-			libcnotify_printf(
-			 "%s: requested offset\t\t\t\t: 0x%08" PRIx64 "\n",
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write extent: %d.",
 			 function,
-			 internal_handle->current_offset );
-		}
-#endif
-		grain_index       = internal_handle->current_offset / internal_handle->io_handle->grain_size;
-		grain_data_offset = (off64_t) ( internal_handle->current_offset % internal_handle->io_handle->grain_size );
+			 extent_number );
 
-		while( buffer_size > 0 )
+			goto on_error;
+		}
+		if( libbfio_handle_close(
+		     file_io_handle,
+		     error ) != 0 )
 		{
-			grain_is_sparse = libvmdk_grain_table_grain_is_sparse_at_offset(
-					   internal_handle->grain_table,
-					   grain_index,
-					   file_io_pool,
-					   internal_handle->extent_table,
-					   internal_handle->current_offset,
-					   error );
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
 
-			if( grain_is_sparse == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-				 "%s: unable to determine if the grain: %" PRIu64 " is sparse.",
-				 function,
-				 grain_index );
+			goto on_error;
+		}
+		if( libbfio_handle_free(
+		     &file_io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
 
-				return( -1 );
-			}
-			read_size = (size_t) ( internal_handle->io_handle->grain_size - grain_data_offset );
+			goto on_error;
+		}
+		remaining_media_size -= extent_size;
+	}
+	extent_filename[ prefix_length ] = 0;
 
-			if( read_size > buffer_size )
-			{
-				read_size = buffer_size;
-			}
-			if( (size64_t) ( internal_handle->current_offset + read_size ) > internal_handle->io_handle->media_size )
-			{
-				read_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
-			}
-			if( grain_is_sparse != 0 )
-			{
-				if( internal_handle->parent_handle == NULL )
-				{
-					if( memory_set(
-					     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-					     0,
-					     read_size ) == NULL )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_MEMORY,
-						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
-						 "%s: unable to fill buffer with sparse grain.",
-						 function );
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_size_from_utf32(
+	          (libuna_utf32_character_t *) &( extent_filename[ basename_offset ] ),
+	          prefix_length - basename_offset + 1,
+	          &utf8_prefix_size,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_size_from_utf16(
+	          (libuna_utf16_character_t *) &( extent_filename[ basename_offset ] ),
+	          prefix_length - basename_offset + 1,
+	          &utf8_prefix_size,
+	          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
 
-						return( -1 );
-					}
-				}
-				else
-				{
-/* TODO do we need grain offset or current offset ? */
-					if( libvmdk_handle_seek_offset(
-					     internal_handle->parent_handle,
-					     internal_handle->current_offset,
-					     SEEK_SET,
-					     error ) == -1 )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_SEEK_FAILED,
-						 "%s: unable to seek grain offset: %" PRIi64 " in parent.",
-						 function,
-						 internal_handle->current_offset );
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine UTF-8 extent filename prefix size.",
+		 function );
 
-						return( -1 );
-					}
-					read_count = libvmdk_handle_read_buffer(
-						      internal_handle->parent_handle,
-						      &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-						      read_size,
-						      error );
+		goto on_error;
+	}
+	utf8_prefix = (uint8_t *) memory_allocate(
+	                           sizeof( uint8_t ) * utf8_prefix_size );
 
-					if( read_count != (ssize_t) read_size )
-					{
-						libcerror_error_set(
-						 error,
-						 LIBCERROR_ERROR_DOMAIN_IO,
-						 LIBCERROR_IO_ERROR_READ_FAILED,
-						 "%s: unable to read grain data from parent.",
-						 function );
+	if( utf8_prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create UTF-8 extent filename prefix.",
+		 function );
 
-						return( -1 );
-					}
-				}
-			}
-			else
-			{
-				if( libvmdk_grain_table_get_grain_data_at_offset(
-				     internal_handle->grain_table,
-				     grain_index,
-				     file_io_pool,
-				     internal_handle->extent_table,
-				     internal_handle->grains_cache,
-				     internal_handle->current_offset,
-				     &grain_data,
-				     &grain_data_offset,
-				     error ) != 1 )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-					 "%s: unable to retrieve grain: %d data.",
-					 function,
-					 grain_index );
+		goto on_error;
+	}
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_copy_from_utf32(
+	          utf8_prefix,
+	          utf8_prefix_size,
+	          (libuna_utf32_character_t *) &( extent_filename[ basename_offset ] ),
+	          prefix_length - basename_offset + 1,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_copy_from_utf16(
+	          utf8_prefix,
+	          utf8_prefix_size,
+	          (libuna_utf16_character_t *) &( extent_filename[ basename_offset ] ),
+	          prefix_length - basename_offset + 1,
+	          error );
+#endif /* SIZEOF_WCHAR_T */
 
-					return( -1 );
-				}
-				if( grain_data == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-					 "%s: missing grain: %d data.",
-					 function,
-					 grain_index );
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set UTF-8 extent filename prefix.",
+		 function );
 
-					return( -1 );
-				}
-				if( (size64_t) grain_data_offset > grain_data->data_size )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: grain data offset value out of bounds.",
-					 function );
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
 
-					return( -1 );
-				}
-				if( read_size > (size_t) ( grain_data->data_size - grain_data_offset ) )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-					 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-					 "%s: read size value out of bounds.",
-					 function );
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
 
-					return( -1 );
-				}
-				if( memory_copy(
-				     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
-				     &( ( grain_data->data )[ grain_data_offset ] ),
-				     read_size ) == NULL )
-				{
-					libcerror_error_set(
-					 error,
-					 LIBCERROR_ERROR_DOMAIN_MEMORY,
-					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
-					 "%s: unable to copy grain data to buffer.",
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_delta_disk_write_split_descriptor(
+	     file_io_handle,
+	     media_size,
+	     LIBVMDK_DELTA_DISK_SPLIT_EXTENT_SIZE,
+	     content_identifier,
+	     utf8_prefix,
+	     utf8_prefix_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write descriptor file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 utf8_prefix );
+
+	utf8_prefix = NULL;
+
+	memory_free(
+	 extent_filename );
+
+	extent_filename = NULL;
+
+	if( libvmdk_handle_open_wide(
+	     handle,
+	     filename,
+	     LIBVMDK_OPEN_READ_WRITE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open split sparse disk.",
+		 function );
+
+		goto on_error;
+	}
+	handle_is_open = 1;
+
+	if( libvmdk_handle_open_extent_data_files(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle_is_open != 0 )
+	{
+		libvmdk_handle_close(
+		 handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( utf8_prefix != NULL )
+	{
+		memory_free(
+		 utf8_prefix );
+	}
+	if( extent_filename != NULL )
+	{
+		memory_free(
+		 extent_filename );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens the extent data files
+ * If the extent data filenames were not set explicitly this function assumes the extent data files
+ * are in the same location as the descriptor file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_open_extent_data_files(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libbfio_pool_t *file_io_pool                            = NULL;
+	libvmdk_internal_extent_descriptor_t *extent_descriptor = NULL;
+	libvmdk_internal_handle_t *internal_handle              = NULL;
+	system_character_t *extent_data_file_location           = NULL;
+	system_character_t *extent_data_filename_start          = NULL;
+	static char *function                                   = "libvmdk_handle_open_extent_data_files";
+	size_t extent_data_file_location_size                   = 0;
+	size_t extent_data_filename_size                        = 0;
+	uint64_t end_timestamp                                  = 0;
+	uint64_t start_timestamp                                = 0;
+	int extent_index                                        = 0;
+	int number_of_extents                                   = 0;
+	int result                                              = 0;
+	int timestamp_result                                    = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( ( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_READ ) == 0 )
+	 && ( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->extent_data_file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - extent data file IO pool already exists.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_descriptor_file_get_number_of_extents(
+	     internal_handle->descriptor_file,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_extents == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of extents value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_pool_initialize(
+	     &file_io_pool,
+	     number_of_extents,
+	     internal_handle->maximum_number_of_open_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO pool.",
+		 function );
+
+		goto on_error;
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libvmdk_descriptor_file_get_extent_by_index(
+		     internal_handle->descriptor_file,
+		     extent_index,
+		     &extent_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d from descriptor file.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( extent_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing extent descriptor: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( extent_descriptor->type != LIBVMDK_EXTENT_TYPE_ZERO )
+		{
+			if( ( extent_descriptor->filename == NULL )
+			 || ( extent_descriptor->filename_size == 0 ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+				 "%s: invalid extent descriptor: %d - missing filename.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			extent_data_filename_start = wide_string_search_character_reverse(
+			                              extent_descriptor->filename,
+			                              (wint_t) LIBCPATH_SEPARATOR,
+			                              extent_descriptor->filename_size );
+#else
+			extent_data_filename_start = narrow_string_search_character_reverse(
+			                              extent_descriptor->filename,
+			                              (int) LIBCPATH_SEPARATOR,
+			                              extent_descriptor->filename_size );
+#endif
+			if( extent_data_filename_start != NULL )
+			{
+				/* Ignore the path separator itself
+				 */
+				extent_data_filename_start++;
+
+/* TODO does this work for UTF-16 ? */
+				extent_data_filename_size = (size_t) ( extent_data_filename_start - extent_descriptor->filename );
+			}
+			else
+			{
+				extent_data_filename_start = extent_descriptor->filename;
+				extent_data_filename_size  = extent_descriptor->filename_size;
+			}
+/* TODO refactor to a function in extent table */
+			if( internal_handle->extent_table->data_files_path != NULL )
+			{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+				if( libcpath_path_join_wide(
+				     &extent_data_file_location,
+				     &extent_data_file_location_size,
+				     internal_handle->extent_table->data_files_path,
+				     internal_handle->extent_table->data_files_path_size - 1,
+				     extent_data_filename_start,
+				     extent_data_filename_size - 1,
+				     error ) != 1 )
+#else
+				if( libcpath_path_join(
+				     &extent_data_file_location,
+				     &extent_data_file_location_size,
+				     internal_handle->extent_table->data_files_path,
+				     internal_handle->extent_table->data_files_path_size - 1,
+				     extent_data_filename_start,
+				     extent_data_filename_size - 1,
+				     error ) != 1 )
+#endif
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create extent data file location.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			else
+			{
+				extent_data_file_location      = extent_data_filename_start;
+				extent_data_file_location_size = extent_data_filename_size;
+			}
+/* TODO add support for alternate extent file name */
+			/* Note that the open extent data file function will initialize extent_data_file_io_pool
+			 */
+			timestamp_result = libvmdk_statistics_start_timer(
+			                    &( internal_handle->io_handle->statistics ),
+			                    &start_timestamp );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			result = libvmdk_handle_open_extent_data_file_wide(
+				  internal_handle,
+				  file_io_pool,
+				  extent_index,
+				  extent_data_file_location,
+				  error );
+#else
+			result = libvmdk_handle_open_extent_data_file(
+				  internal_handle,
+				  file_io_pool,
+				  extent_index,
+				  extent_data_file_location,
+				  error );
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open extent data file: %" PRIs_SYSTEM ".",
+				 function,
+				 extent_data_file_location );
+
+				goto on_error;
+			}
+			if( timestamp_result == 1 )
+			{
+				timestamp_result = libvmdk_statistics_get_timestamp(
+				                    &end_timestamp );
+			}
+			if( timestamp_result == 1 )
+			{
+				libvmdk_statistics_add_open_phase_time(
+				 &( internal_handle->io_handle->statistics ),
+				 LIBVMDK_OPEN_PHASE_EXTENT_DATA_FILES,
+				 start_timestamp,
+				 end_timestamp );
+			}
+			if( ( extent_data_file_location != NULL )
+			 && ( extent_data_file_location != extent_data_filename_start ) )
+			{
+				memory_free(
+				 extent_data_file_location );
+			}
+			extent_data_filename_start = NULL;
+			extent_data_file_location  = NULL;
+		}
+	}
+	if( libvmdk_handle_open_read_grain_table(
+	     internal_handle,
+	     file_io_pool,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to read grain table.",
+                 function );
+
+                goto on_error;
+	}
+	internal_handle->extent_data_file_io_pool                    = file_io_pool;
+	internal_handle->extent_data_file_io_pool_created_in_library = 1;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( file_io_pool != NULL )
+	{
+		libbfio_pool_close_all(
+		 file_io_pool,
+		 NULL );
+		libbfio_pool_free(
+		 &file_io_pool,
+		 NULL );
+	}
+	if( ( extent_data_file_location != NULL )
+	 && ( extent_data_file_location != extent_data_filename_start ) )
+	{
+		memory_free(
+		 extent_data_file_location );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Opens the extent data files using a Basic File IO (bfio) pool
+ * This function assumes the extent data files are in same order as defined by the descriptor file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_open_extent_data_files_file_io_pool(
+     libvmdk_handle_t *handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_open_extent_data_files_file_io_pool";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( ( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_READ ) == 0 )
+	 && ( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) == 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->extent_data_file_io_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - extent data file IO pool already exists.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_handle_open_read_grain_table(
+	     internal_handle,
+	     file_io_pool,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to read grain table.",
+                 function );
+
+                goto on_error;
+	}
+	internal_handle->extent_data_file_io_pool = file_io_pool;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Opens the change tracking file
+ * The change tracking file is defined by the descriptor file and opened relative to the data files path
+ * Returns 1 if successful, 0 if the descriptor file does not define a change tracking file or -1 on error
+ */
+int libvmdk_handle_open_change_tracking_file(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle                     = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	libvmdk_internal_handle_t *internal_handle           = NULL;
+	system_character_t *change_tracking_file_location    = NULL;
+	system_character_t *change_tracking_filename_start   = NULL;
+	static char *function                                = "libvmdk_handle_open_change_tracking_file";
+	size_t change_tracking_file_location_size            = 0;
+	size_t change_tracking_filename_size                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->change_tracking_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - change tracking file already exists.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->descriptor_file->change_tracking_file_path == NULL )
+	 || ( internal_handle->descriptor_file->change_tracking_file_path_size == 0 ) )
+	{
+		return( 0 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	/* The change tracking file is stored in the same directory as the extent data files
+	 */
+	change_tracking_filename_start = system_string_search_character_reverse(
+	                                  internal_handle->descriptor_file->change_tracking_file_path,
+	                                  (system_character_t) LIBCPATH_SEPARATOR,
+	                                  internal_handle->descriptor_file->change_tracking_file_path_size );
+
+	if( change_tracking_filename_start != NULL )
+	{
+		/* Ignore the path separator itself
+		 */
+		change_tracking_filename_start++;
+
+		change_tracking_filename_size = internal_handle->descriptor_file->change_tracking_file_path_size
+		                              - (size_t) ( change_tracking_filename_start - internal_handle->descriptor_file->change_tracking_file_path );
+	}
+	else
+	{
+		change_tracking_filename_start = internal_handle->descriptor_file->change_tracking_file_path;
+		change_tracking_filename_size  = internal_handle->descriptor_file->change_tracking_file_path_size;
+	}
+	if( internal_handle->extent_table->data_files_path != NULL )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &change_tracking_file_location,
+		     &change_tracking_file_location_size,
+		     internal_handle->extent_table->data_files_path,
+		     internal_handle->extent_table->data_files_path_size - 1,
+		     change_tracking_filename_start,
+		     change_tracking_filename_size - 1,
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &change_tracking_file_location,
+		     &change_tracking_file_location_size,
+		     internal_handle->extent_table->data_files_path,
+		     internal_handle->extent_table->data_files_path_size - 1,
+		     change_tracking_filename_start,
+		     change_tracking_filename_size - 1,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create change tracking file location.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		change_tracking_file_location      = change_tracking_filename_start;
+		change_tracking_file_location_size = change_tracking_filename_size;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     change_tracking_file_location,
+	     change_tracking_file_location_size,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     change_tracking_file_location,
+	     change_tracking_file_location_size,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_ACCESS_FLAG_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open change tracking file: %" PRIs_SYSTEM ".",
+		 function,
+		 change_tracking_file_location );
+
+		goto on_error;
+	}
+	if( libvmdk_change_tracking_file_initialize(
+	     &change_tracking_file,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create change tracking file.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_change_tracking_file_read_file_io_handle(
+	     change_tracking_file,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read change tracking file: %" PRIs_SYSTEM ".",
+		 function,
+		 change_tracking_file_location );
+
+		goto on_error;
+	}
+	if( change_tracking_file->media_size != internal_handle->descriptor_file->media_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: change tracking file media size: %" PRIu64 " does not match media size: %" PRIu64 ".",
+		 function,
+		 change_tracking_file->media_size,
+		 internal_handle->descriptor_file->media_size );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( change_tracking_file_location != change_tracking_filename_start )
+	{
+		memory_free(
+		 change_tracking_file_location );
+	}
+	change_tracking_file_location = NULL;
+
+	internal_handle->change_tracking_file = change_tracking_file;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( ( change_tracking_file_location != NULL )
+	 && ( change_tracking_file_location != change_tracking_filename_start ) )
+	{
+		memory_free(
+		 change_tracking_file_location );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Opens a specific extent data file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_open_extent_data_file(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvmdk_handle_open_extent_data_file";
+	size_t filename_length           = 0;
+	int bfio_access_flags            = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	/* The extent file metadata is read, also when opened for writing
+	 */
+	bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
+
+	if( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		bfio_access_flags |= LIBBFIO_ACCESS_FLAG_WRITE;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libbfio_handle_set_track_offsets_read(
+	     file_io_handle,
+	     1,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set track offsets read in file IO handle.",
+                 function );
+
+                goto on_error;
+	}
+#endif
+	filename_length = narrow_string_length(
+	                   filename );
+
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set filename in file IO handle.",
+                 function );
+
+                goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     bfio_access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_handle(
+	     file_io_pool,
+	     extent_index,
+	     file_io_handle,
+	     bfio_access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file IO handle: %d in pool.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens a specific extent data file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_open_extent_data_file_wide(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     int extent_index,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	static char *function            = "libvmdk_handle_open_extent_data_file_wide";
+	size_t filename_length           = 0;
+	int bfio_access_flags            = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	/* The extent file metadata is read, also when opened for writing
+	 */
+	bfio_access_flags = LIBBFIO_ACCESS_FLAG_READ;
+
+	if( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		bfio_access_flags |= LIBBFIO_ACCESS_FLAG_WRITE;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+                goto on_error;
+	}
+#if defined( HAVE_DEBUG_OUTPUT )
+	if( libbfio_handle_set_track_offsets_read(
+	     file_io_handle,
+	     1,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set track offsets read in file IO handle.",
+                 function );
+
+                goto on_error;
+	}
+#endif
+	filename_length = wide_string_length(
+	                   filename );
+
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+                libcerror_error_set(
+                 error,
+                 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+                 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+                 "%s: unable to set filename in file IO handle.",
+                 function );
+
+                goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     bfio_access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_set_handle(
+	     file_io_pool,
+	     extent_index,
+	     file_io_handle,
+	     bfio_access_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set file IO handle: %d in pool.",
+		 function,
+		 extent_index );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Closes the VMDK file(s)
+ * Returns 0 if successful or -1 on error
+ */
+int libvmdk_handle_close(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_close";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle != NULL )
+	{
+		if( libvmdk_write_io_handle_flush(
+		     internal_handle->write_io_handle,
+		     internal_handle->extent_data_file_io_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libvmdk_write_io_handle_free(
+		     &( internal_handle->write_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free write IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->extent_data_file_io_pool_created_in_library != 0 )
+	{
+		if( libbfio_pool_close_all(
+		     internal_handle->extent_data_file_io_pool,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close all files.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_pool_free(
+		     &( internal_handle->extent_data_file_io_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to extent data free file IO pool.",
+			 function );
+
+			result = -1;
+		}
+		internal_handle->extent_data_file_io_pool_created_in_library = 0;
+	}
+	internal_handle->extent_data_file_io_pool = NULL;
+	internal_handle->current_offset           = 0;
+
+	if( internal_handle->cache_pool_handle_identifier != -1 )
+	{
+		if( libvmdk_cache_pool_detach_handle(
+		     internal_handle->cache_pool,
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to detach handle from cache pool.",
+			 function );
+
+			result = -1;
+		}
+		internal_handle->cache_pool_handle_identifier = -1;
+	}
+	if( libvmdk_io_handle_clear(
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear IO handle.",
+		 function );
+
+		result = -1;
+	}
+	if( internal_handle->descriptor_file != NULL )
+	{
+		if( libvmdk_descriptor_file_free(
+		     &( internal_handle->descriptor_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free descriptor file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->change_tracking_file != NULL )
+	{
+		if( libvmdk_change_tracking_file_free(
+		     &( internal_handle->change_tracking_file ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free change tracking file.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->grain_table != NULL )
+	{
+		if( libvmdk_grain_table_free(
+		     &( internal_handle->grain_table ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free grain table.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_handle->grains_cache != NULL )
+	{
+		if( libfcache_cache_free(
+		     &( internal_handle->grains_cache ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free grains cache.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libvmdk_extent_table_clear(
+	     internal_handle->extent_table,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to clear extent table.",
+		 function );
+
+		result = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Reads the grain table
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_open_read_grain_table(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_extent_descriptor_t *extent_descriptor = NULL;
+	libvmdk_extent_file_t *extent_file                      = NULL;
+	static char *function                                   = "libvmdk_handle_open_read_grain_table";
+	off64_t extent_media_offset                             = 0;
+	size64_t extent_file_size                               = 0;
+	int extent_index                                        = 0;
+	int number_of_extents                                   = 0;
+	int number_of_file_io_handles                           = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->grain_table != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - grain table already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->grains_cache != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - grains cache already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - write IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_descriptor_file_get_number_of_extents(
+	     internal_handle->descriptor_file,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_extents == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_get_number_of_handles(
+	     file_io_pool,
+	     &number_of_file_io_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve the number of file IO handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_extents != number_of_file_io_handles )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: mismatch between number of file IO handles in pool and number of extents in metadata.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_extent_table_initialize_extents(
+	     internal_handle->extent_table,
+	     number_of_extents,
+	     internal_handle->descriptor_file->disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize extent table extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_grain_table_initialize(
+	     &( internal_handle->grain_table ),
+	     internal_handle->io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create grain table.",
+		 function );
+
+		goto on_error;
+	}
+	if( libfcache_cache_initialize(
+	     &( internal_handle->grains_cache ),
+	     LIBVMDK_MAXIMUM_CACHE_ENTRIES_GRAINS,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create grains cache.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( internal_handle->access_flags & LIBVMDK_ACCESS_FLAG_WRITE ) != 0 )
+	{
+		if( ( internal_handle->descriptor_file->disk_type != LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+		 && ( internal_handle->descriptor_file->disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: write access not supported for disk type.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_write_io_handle_initialize(
+		     &( internal_handle->write_io_handle ),
+		     internal_handle->io_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create write IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( libvmdk_descriptor_file_get_extent_by_index(
+		     internal_handle->descriptor_file,
+		     extent_index,
+		     &extent_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d from descriptor file.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( extent_descriptor == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing extent descriptor: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libbfio_pool_get_size(
+		     file_io_pool,
+		     extent_index,
+		     &extent_file_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve size of file IO pool entry: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_table_set_extent_by_extent_descriptor(
+		     internal_handle->extent_table,
+		     extent_descriptor,
+		     extent_index,
+		     extent_index,
+		     extent_file_size,
+		     extent_descriptor->offset,
+		     extent_descriptor->size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set extent: %d in table.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( ( extent_descriptor->type == LIBVMDK_EXTENT_TYPE_SPARSE )
+		 || ( extent_descriptor->type == LIBVMDK_EXTENT_TYPE_VMFS_SPARSE ) )
+		{
+			if( libvmdk_extent_file_initialize(
+			     &extent_file,
+			     internal_handle->io_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create extent file: %d.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "Reading extent file: %d file header:\n",
+				 extent_index );
+			}
+#endif
+			if( libvmdk_extent_file_read_file_header(
+			     extent_file,
+			     file_io_pool,
+			     extent_index,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read extent file: %d header.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			if( ( extent_file->file_type != LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA )
+			 && ( extent_file->file_type != LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: extent file type not supported for extent type.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( internal_handle->descriptor_file->disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+			 && ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
+			 && ( ( extent_file->flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != LIBVMDK_COMPRESSION_METHOD_NONE ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: grain compression not supported for disk type.",
+				 function );
+
+				goto on_error;
+			}
+			if( ( extent_file->file_type == LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA )
+			 && ( extent_file->primary_grain_directory_offset == (off64_t) -1 )
+			 && ( extent_file->compression_method == LIBVMDK_COMPRESSION_METHOD_DEFLATE ) )
+			{
+				if( libvmdk_extent_file_read_file_header(
+				     extent_file,
+				     file_io_pool,
+				     extent_index,
+				     extent_file_size - 1024,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read secondary extent file: %d header.",
+					 function,
+					 extent_index );
+
+					goto on_error;
+				}
+			}
+			if( extent_index == 0 )
+			{
+				internal_handle->io_handle->grain_size = extent_file->grain_size;
+			}
+			else if( extent_file->grain_size != internal_handle->io_handle->grain_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_INPUT,
+				 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+				 "%s: extent file: %d grain size mismatch.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			if( extent_file->is_dirty != 0 )
+			{
+				internal_handle->io_handle->is_dirty = 1;
+			}
+#if defined( HAVE_DEBUG_OUTPUT )
+			if( libcnotify_verbose != 0 )
+			{
+				libcnotify_printf(
+				 "Reading extent file: %d grain directories:\n",
+				 extent_index );
+			}
+#endif
+			if( libvmdk_extent_file_read_grain_directories(
+			     extent_file,
+			     file_io_pool,
+			     extent_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read extent file: %d grain directories.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			if( libvmdk_extent_table_set_extent_storage_media_size_by_index(
+			     internal_handle->extent_table,
+			     extent_index,
+			     extent_file->storage_media_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to set mapped range of element: %d in extent table.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			if( internal_handle->write_io_handle != NULL )
+			{
+				if( libvmdk_write_io_handle_append_extent_file(
+				     internal_handle->write_io_handle,
+				     extent_file,
+				     file_io_pool,
+				     extent_index,
+				     extent_media_offset,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+					 "%s: unable to append extent file: %d to write IO handle.",
+					 function,
+					 extent_index );
+
+					goto on_error;
+				}
+			}
+			extent_media_offset += (off64_t) extent_file->storage_media_size;
+
+			if( libvmdk_extent_file_free(
+			     &extent_file,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free extent file.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else if( ( extent_descriptor->type != LIBVMDK_EXTENT_TYPE_FLAT )
+		      && ( extent_descriptor->type != LIBVMDK_EXTENT_TYPE_VMFS_FLAT ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported extent type.",
+			 function );
+
+			goto on_error;
+		}
+		else if( internal_handle->write_io_handle != NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: write access not supported for flat extent: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( internal_handle->io_handle->abort == 1 )
+		{
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( extent_file != NULL )
+	{
+		libvmdk_extent_file_free(
+		 &extent_file,
+		 NULL );
+	}
+	if( internal_handle->write_io_handle != NULL )
+	{
+		libvmdk_write_io_handle_free(
+		 &( internal_handle->write_io_handle ),
+		 NULL );
+	}
+	if( internal_handle->grains_cache != NULL )
+	{
+		libfcache_cache_free(
+		 &( internal_handle->grains_cache ),
+		 NULL );
+	}
+	if( internal_handle->grain_table != NULL )
+	{
+		libvmdk_grain_table_free(
+		 &( internal_handle->grain_table ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the file signature and tries to determine the file type
+ * Returns 1 if successful, 0 if no file type could be determined or -1 on error
+ */
+int libvmdk_handle_open_read_signature(
+     libbfio_handle_t *file_io_handle,
+     libvmdk_statistics_t *statistics,
+     uint8_t *file_type,
+     libcerror_error_t **error )
+{
+	libcsplit_narrow_split_string_t *lines = NULL;
+	uint8_t *signature                     = NULL;
+	static char *function                  = "libvmdk_handle_open_read_signature";
+	ssize_t read_count                     = 0;
+	uint64_t end_timestamp                 = 0;
+	uint64_t start_timestamp               = 0;
+	int line_index                         = 0;
+	int number_of_lines                    = 0;
+	int result                             = 0;
+	int timestamp_result                   = 0;
+
+	if( file_type == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file type.",
+		 function );
+
+		return( -1 );
+	}
+	signature = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * 2048 );
+
+	if( signature == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create signature.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     signature,
+	     0,
+	     sizeof( uint8_t ) * 2048 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear signature.",
+		 function );
+
+		goto on_error;
+	}
+	timestamp_result = libvmdk_statistics_start_timer(
+	                    statistics,
+	                    &start_timestamp );
+
+	libvmdk_statistics_add_open_phase_seek(
+	 statistics,
+	 LIBVMDK_OPEN_PHASE_DESCRIPTOR );
+
+	if( libbfio_handle_seek_offset(
+	     file_io_handle,
+	     0,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: 0.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libbfio_handle_read_buffer(
+	              file_io_handle,
+	              signature,
+	              32,
+	              error );
+
+	libvmdk_statistics_add_open_phase_read(
+	 statistics,
+	 LIBVMDK_OPEN_PHASE_DESCRIPTOR,
+	 read_count );
+
+	if( read_count != (ssize_t) 32 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read signature.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_compare(
+	     signature,
+	     cowd_sparse_file_signature,
+	     4 ) == 0 )
+	{
+		*file_type = LIBVMDK_FILE_TYPE_COWD_SPARSE_DATA;
+		result     = 1;
+	}
+	else if( memory_compare(
+	          signature,
+	          vmdk_sparse_file_signature,
+	          4 ) == 0 )
+	{
+		*file_type = LIBVMDK_FILE_TYPE_VMDK_SPARSE_DATA;
+		result     = 1;
+	}
+	else if( signature[ 0 ] == '#' )
+	{
+		read_count = libbfio_handle_read_buffer(
+		              file_io_handle,
+		              &( signature[ 32 ] ),
+		              2048 - 32,
+		              error );
+
+		libvmdk_statistics_add_open_phase_read(
+		 statistics,
+		 LIBVMDK_OPEN_PHASE_DESCRIPTOR,
+		 read_count );
+
+		if( read_count == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read signature.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcsplit_narrow_string_split(
+		     (char *) signature,
+		     32 + read_count,
+		     '\n',
+		     &lines,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to split file data into lines.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcsplit_narrow_split_string_get_number_of_segments(
+		     lines,
+		     &number_of_lines,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to retrieve number of lines.",
+			 function );
+
+			goto on_error;
+		}
+		result = libvmdk_descriptor_file_read_signature(
+			  lines,
+			  number_of_lines,
+			  &line_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read descriptor file.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			*file_type = LIBVMDK_FILE_TYPE_DESCRIPTOR_FILE;
+		}
+		if( libcsplit_narrow_split_string_free(
+		     &lines,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free lines.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	memory_free(
+	 signature );
+
+	if( timestamp_result == 1 )
+	{
+		timestamp_result = libvmdk_statistics_get_timestamp(
+		                    &end_timestamp );
+	}
+	if( timestamp_result == 1 )
+	{
+		libvmdk_statistics_add_open_phase_time(
+		 statistics,
+		 LIBVMDK_OPEN_PHASE_DESCRIPTOR,
+		 start_timestamp,
+		 end_timestamp );
+	}
+	return( result );
+
+on_error:
+	if( lines != NULL )
+	{
+		libcsplit_narrow_split_string_free(
+		 &lines,
+		 NULL );
+	}
+	if( signature != NULL )
+	{
+		memory_free(
+		 signature );
+	}
+	return( -1 );
+}
+
+/* Grabs the grains cache used for the grain data at a specific offset
+ * When a cache pool is set the grains cache of the corresponding partition
+ * of the cache pool is used, otherwise the grains cache of the handle
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_grab_grains_cache(
+     libvmdk_internal_handle_t *internal_handle,
+     off64_t offset,
+     libfcache_cache_t **grains_cache,
+     int *partition_index,
+     libcerror_error_t **error )
+{
+	static char *function          = "libvmdk_internal_handle_grab_grains_cache";
+	int cache_pool_partition_index = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( grains_cache == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grains cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( partition_index == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid partition index.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cache_pool == NULL )
+	{
+		*grains_cache    = internal_handle->grains_cache;
+		*partition_index = -1;
+
+		return( 1 );
+	}
+	/* The handle is attached to the cache pool while it caches grain data in it
+	 */
+	if( internal_handle->cache_pool_handle_identifier == -1 )
+	{
+		if( libvmdk_cache_pool_attach_handle(
+		     internal_handle->cache_pool,
+		     internal_handle->io_handle->grain_size,
+		     &( internal_handle->cache_pool_handle_identifier ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to attach handle to cache pool.",
+			 function );
+
+			internal_handle->cache_pool_handle_identifier = -1;
+
+			return( -1 );
+		}
+	}
+	if( libvmdk_cache_pool_get_partition_index(
+	     internal_handle->cache_pool,
+	     internal_handle->cache_pool_handle_identifier,
+	     offset,
+	     &cache_pool_partition_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve cache pool partition index.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_cache_pool_grab_grains_cache(
+	     internal_handle->cache_pool,
+	     cache_pool_partition_index,
+	     grains_cache,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab grains cache of cache pool partition: %d.",
+		 function,
+		 cache_pool_partition_index );
+
+		return( -1 );
+	}
+	*partition_index = cache_pool_partition_index;
+
+	return( 1 );
+}
+
+/* Releases the grains cache grabbed by libvmdk_internal_handle_grab_grains_cache
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_release_grains_cache(
+     libvmdk_internal_handle_t *internal_handle,
+     int partition_index,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_handle_release_grains_cache";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->cache_pool == NULL )
+	 || ( partition_index < 0 ) )
+	{
+		return( 1 );
+	}
+	if( libvmdk_cache_pool_release_grains_cache(
+	     internal_handle->cache_pool,
+	     partition_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release grains cache of cache pool partition: %d.",
+		 function,
+		 partition_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads the data of an allocated grain at a specific offset into a buffer using a Basic File IO (bfio) pool
+ * The read size must not exceed the end of the grain
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_read_grain_data_buffer(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t grain_index,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t read_size,
+     libcerror_error_t **error )
+{
+	libfcache_cache_t *grains_cache  = NULL;
+	libvmdk_grain_data_t *grain_data = NULL;
+	static char *function            = "libvmdk_internal_handle_read_grain_data_buffer";
+	off64_t grain_data_offset        = 0;
+	int partition_index              = -1;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	/* The cached grain data is only used while the grains cache is grabbed
+	 * since a handle that shares the cache pool can replace it afterwards
+	 */
+	if( libvmdk_internal_handle_grab_grains_cache(
+	     internal_handle,
+	     offset,
+	     &grains_cache,
+	     &partition_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to grab grains cache.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_grain_table_get_grain_data_at_offset(
+	     internal_handle->grain_table,
+	     grain_index,
+	     file_io_pool,
+	     internal_handle->extent_table,
+	     grains_cache,
+	     offset,
+	     &grain_data,
+	     &grain_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain: %" PRIu64 " data.",
+		 function,
+		 grain_index );
+
+		goto on_error;
+	}
+	if( grain_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing grain: %" PRIu64 " data.",
+		 function,
+		 grain_index );
+
+		goto on_error;
+	}
+	LIBVMDK_STATISTICS_ADD(
+	 internal_handle->io_handle->statistics.number_of_allocated_grains,
+	 1 );
+
+	if( grain_data->compressed_data_size != 0 )
+	{
+		LIBVMDK_STATISTICS_ADD(
+		 internal_handle->io_handle->statistics.number_of_compressed_grains,
+		 1 );
+	}
+	if( (size64_t) grain_data_offset > grain_data->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: grain data offset value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( read_size > (size_t) ( grain_data->data_size - grain_data_offset ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: read size value out of bounds.",
+		 function );
+
+		goto on_error;
+	}
+	if( grain_data->is_zero != 0 )
+	{
+		if( memory_set(
+		     buffer,
+		     0,
+		     read_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to fill buffer with zero grain.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( memory_copy(
+	          buffer,
+	          &( ( grain_data->data )[ grain_data_offset ] ),
+	          read_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy grain data to buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_internal_handle_release_grains_cache(
+	     internal_handle,
+	     partition_index,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release grains cache.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	libvmdk_internal_handle_release_grains_cache(
+	 internal_handle,
+	 partition_index,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Reads (media) data from the last current into a buffer using a Basic File IO (bfio) pool
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
+         libvmdk_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	static char *function     = "libvmdk_internal_handle_read_buffer_from_file_io_pool";
+	size_t buffer_offset      = 0;
+	size_t read_size          = 0;
+	ssize_t read_count        = 0;
+	off64_t grain_data_offset = 0;
+	off64_t grain_offset      = 0;
+	uint64_t end_timestamp    = 0;
+	uint64_t grain_index      = 0;
+	uint64_t start_timestamp  = 0;
+	int file_io_pool_entry    = 0;
+	int grain_is_sparse       = 0;
+	int result                = 0;
+	int timestamp_result      = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->descriptor_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->descriptor_file->parent_content_identifier_set != 0 )
+	 && ( internal_handle->descriptor_file->parent_content_identifier != 0xffffffffUL ) )
+	{
+		if( internal_handle->parent_handle == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid handle - missing parent handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid element data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
+	{
+		return( 0 );
+	}
+	LIBVMDK_STATISTICS_ADD(
+	 internal_handle->io_handle->statistics.number_of_reads,
+	 1 );
+
+	timestamp_result = libvmdk_statistics_start_timer(
+	                    &( internal_handle->io_handle->statistics ),
+	                    &start_timestamp );
+
+	if( internal_handle->extent_table->extent_files_stream != NULL )
+	{
+		if( libfdata_stream_seek_offset(
+		     internal_handle->extent_table->extent_files_stream,
+		     internal_handle->current_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to seek offset in extent files stream.",
+			 function );
+
+			return( -1 );
+		}
+		read_size = buffer_size;
+
+		if( (size64_t) ( internal_handle->current_offset + read_size ) > internal_handle->io_handle->media_size )
+		{
+			read_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
+		}
+		read_count = libfdata_stream_read_buffer(
+		              internal_handle->extent_table->extent_files_stream,
+			      (intptr_t *) file_io_pool,
+			      (uint8_t *) buffer,
+			      read_size,
+			      0,
+			      error );
+
+		libvmdk_statistics_add_backing_read(
+		 &( internal_handle->io_handle->statistics ),
+		 read_count );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read buffer from extent files stream.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset = read_size;
+
+		internal_handle->current_offset += (off64_t) read_size;
+	}
+	else
+	{
+/* TODO refactor to separate function */
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_printf(
+			 "%s: requested offset\t\t\t\t: 0x%08" PRIx64 "\n",
+			 function,
+			 internal_handle->current_offset );
+		}
+#endif
+		grain_index       = internal_handle->current_offset / internal_handle->io_handle->grain_size;
+		grain_data_offset = (off64_t) ( internal_handle->current_offset % internal_handle->io_handle->grain_size );
+
+		while( buffer_size > 0 )
+		{
+			if( internal_handle->io_handle->trace_callback != NULL )
+			{
+				libvmdk_io_handle_trace(
+				 internal_handle->io_handle,
+				 LIBVMDK_TRACE_PHASE_EXTENT_LOOKUP,
+				 LIBVMDK_TRACE_EVENT_BEGIN,
+				 internal_handle->io_handle->grain_size );
+			}
+			if( internal_handle->write_io_handle == NULL )
+			{
+				grain_is_sparse = libvmdk_grain_table_grain_is_sparse_at_offset(
+						   internal_handle->grain_table,
+						   grain_index,
+						   file_io_pool,
+						   internal_handle->extent_table,
+						   internal_handle->current_offset,
+						   error );
+			}
+			else
+			{
+				/* When writing the grain tables are maintained by the write IO handle
+				 * and can differ from the grain groups that are cached
+				 */
+				result = libvmdk_write_io_handle_get_grain_offset_at_offset(
+				          internal_handle->write_io_handle,
+				          file_io_pool,
+				          internal_handle->current_offset,
+				          &file_io_pool_entry,
+				          &grain_offset,
+				          error );
+
+				if( result == -1 )
+				{
+					grain_is_sparse = -1;
+				}
+				else if( result == 0 )
+				{
+					grain_is_sparse = 1;
+				}
+				else
+				{
+					grain_is_sparse = 0;
+				}
+			}
+			if( grain_is_sparse == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if the grain: %" PRIu64 " is sparse.",
+				 function,
+				 grain_index );
+
+				if( internal_handle->io_handle->trace_callback != NULL )
+				{
+					libvmdk_io_handle_trace(
+					 internal_handle->io_handle,
+					 LIBVMDK_TRACE_PHASE_EXTENT_LOOKUP,
+					 LIBVMDK_TRACE_EVENT_ERROR,
+					 internal_handle->io_handle->grain_size );
+				}
+				return( -1 );
+			}
+			if( internal_handle->io_handle->trace_callback != NULL )
+			{
+				libvmdk_io_handle_trace(
+				 internal_handle->io_handle,
+				 LIBVMDK_TRACE_PHASE_EXTENT_LOOKUP,
+				 LIBVMDK_TRACE_EVENT_END,
+				 internal_handle->io_handle->grain_size );
+			}
+			read_size = (size_t) ( internal_handle->io_handle->grain_size - grain_data_offset );
+
+			if( read_size > buffer_size )
+			{
+				read_size = buffer_size;
+			}
+			if( (size64_t) ( internal_handle->current_offset + read_size ) > internal_handle->io_handle->media_size )
+			{
+				read_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
+			}
+			if( grain_is_sparse != 0 )
+			{
+				LIBVMDK_STATISTICS_ADD(
+				 internal_handle->io_handle->statistics.number_of_sparse_grains,
+				 1 );
+
+				if( internal_handle->parent_handle == NULL )
+				{
+					if( memory_set(
+					     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+					     0,
+					     read_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to fill buffer with sparse grain.",
+						 function );
+
+						return( -1 );
+					}
+				}
+				else
+				{
+					LIBVMDK_STATISTICS_ADD(
+					 internal_handle->io_handle->statistics.number_of_parent_reads,
+					 1 );
+
+					if( internal_handle->io_handle->trace_callback != NULL )
+					{
+						libvmdk_io_handle_trace(
+						 internal_handle->io_handle,
+						 LIBVMDK_TRACE_PHASE_PARENT_FORWARD,
+						 LIBVMDK_TRACE_EVENT_BEGIN,
+						 (uint64_t) read_size );
+					}
+					/* The parent can be shared with other handles hence the offset
+					 * is passed with the read instead of seeking the parent first
+					 */
+					read_count = libvmdk_handle_read_buffer_at_offset(
+						      internal_handle->parent_handle,
+						      &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+						      read_size,
+						      internal_handle->current_offset,
+						      error );
+
+					if( read_count != (ssize_t) read_size )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_READ_FAILED,
+						 "%s: unable to read grain data from parent.",
+						 function );
+
+						if( internal_handle->io_handle->trace_callback != NULL )
+						{
+							libvmdk_io_handle_trace(
+							 internal_handle->io_handle,
+							 LIBVMDK_TRACE_PHASE_PARENT_FORWARD,
+							 LIBVMDK_TRACE_EVENT_ERROR,
+							 (uint64_t) read_size );
+						}
+						return( -1 );
+					}
+					if( internal_handle->io_handle->trace_callback != NULL )
+					{
+						libvmdk_io_handle_trace(
+						 internal_handle->io_handle,
+						 LIBVMDK_TRACE_PHASE_PARENT_FORWARD,
+						 LIBVMDK_TRACE_EVENT_END,
+						 (uint64_t) read_count );
+					}
+				}
+			}
+			else if( internal_handle->write_io_handle != NULL )
+			{
+				LIBVMDK_STATISTICS_ADD(
+				 internal_handle->io_handle->statistics.number_of_allocated_grains,
+				 1 );
+
+				if( libbfio_pool_seek_offset(
+				     file_io_pool,
+				     file_io_pool_entry,
+				     grain_offset + grain_data_offset,
+				     SEEK_SET,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to seek grain: %" PRIu64 " offset: %" PRIi64 " in extent file: %d.",
+					 function,
+					 grain_index,
+					 grain_offset + grain_data_offset,
+					 file_io_pool_entry );
+
+					return( -1 );
+				}
+				read_count = libbfio_pool_read_buffer(
+				              file_io_pool,
+				              file_io_pool_entry,
+				              &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+				              read_size,
+				              error );
+
+				libvmdk_statistics_add_backing_read(
+				 &( internal_handle->io_handle->statistics ),
+				 read_count );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read grain: %" PRIu64 " data from extent file: %d.",
+					 function,
+					 grain_index,
+					 file_io_pool_entry );
+
+					return( -1 );
+				}
+			}
+			else if( libvmdk_internal_handle_read_grain_data_buffer(
+			          internal_handle,
+			          file_io_pool,
+			          grain_index,
+			          internal_handle->current_offset,
+			          &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			          read_size,
+			          error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read grain: %" PRIu64 " data.",
+				 function,
+				 grain_index );
+
+				return( -1 );
+			}
+			buffer_offset    += read_size;
+			buffer_size      -= read_size;
+			grain_index      += 1;
+			grain_data_offset = 0;
+
+			internal_handle->current_offset += (off64_t) read_size;
+
+			if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
+			{
+				break;
+			}
+			if( internal_handle->io_handle->abort != 0 )
+			{
+				break;
+			}
+		}
+	}
+	LIBVMDK_STATISTICS_ADD(
+	 internal_handle->io_handle->statistics.read_size,
+	 (uint64_t) buffer_offset );
+
+	if( timestamp_result == 1 )
+	{
+		timestamp_result = libvmdk_statistics_get_timestamp(
+		                    &end_timestamp );
+	}
+	if( timestamp_result == 1 )
+	{
+		libvmdk_statistics_add_read_time(
+		 &( internal_handle->io_handle->statistics ),
+		 start_timestamp,
+		 end_timestamp );
+	}
+
+	return( (ssize_t) buffer_offset );
+}
+
+/* Reads (media) data from the last current into a buffer
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_handle_read_buffer(
+         libvmdk_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_read_buffer";
+	ssize_t read_count                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->extent_data_file_io_pool,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		read_count = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+}
+
+/* Reads (media) data at a specific offset
+ * Returns the number of bytes read or -1 on error
+ */
+ssize_t libvmdk_handle_read_buffer_at_offset(
+         libvmdk_handle_t *handle,
+         void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_read_buffer_at_offset";
+	ssize_t read_count                         = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+		      internal_handle,
+		      internal_handle->extent_data_file_io_pool,
+		      buffer,
+		      buffer_size,
+		      error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
+ * New grains are allocated at the end of the extent file, the grain tables and grain directories
+ * are updated in memory and written when the handle is flushed or closed
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libvmdk_internal_handle_write_buffer_to_file_io_pool(
+         libvmdk_internal_handle_t *internal_handle,
+         libbfio_pool_t *file_io_pool,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	uint8_t *grain_buffer     = NULL;
+	static char *function     = "libvmdk_internal_handle_write_buffer_to_file_io_pool";
+	size_t buffer_offset      = 0;
+	size_t read_size          = 0;
+	size_t write_size         = 0;
+	ssize_t read_count        = 0;
+	ssize_t write_count       = 0;
+	off64_t current_offset    = 0;
+	off64_t grain_data_offset = 0;
+	off64_t grain_offset      = 0;
+	int file_io_pool_entry    = 0;
+	int result                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle->grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid IO handle - missing grain size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->current_offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - current offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size == 0 )
+	{
+		return( 0 );
+	}
+	if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
+	{
+		return( 0 );
+	}
+	while( buffer_size > 0 )
+	{
+		grain_data_offset = (off64_t) ( internal_handle->current_offset % internal_handle->io_handle->grain_size );
+
+		write_size = (size_t) ( internal_handle->io_handle->grain_size - grain_data_offset );
+
+		if( write_size > buffer_size )
+		{
+			write_size = buffer_size;
+		}
+		if( (size64_t) ( internal_handle->current_offset + write_size ) > internal_handle->io_handle->media_size )
+		{
+			write_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
+		}
+		if( libvmdk_write_io_handle_mark_dirty_at_offset(
+		     internal_handle->write_io_handle,
+		     file_io_pool,
+		     internal_handle->current_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to mark extent file dirty.",
+			 function );
+
+			goto on_error;
+		}
+		result = libvmdk_write_io_handle_get_grain_offset_at_offset(
+		          internal_handle->write_io_handle,
+		          file_io_pool,
+		          internal_handle->current_offset,
+		          &file_io_pool_entry,
+		          &grain_offset,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain offset at offset: %" PRIi64 ".",
+			 function,
+			 internal_handle->current_offset );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			if( grain_buffer == NULL )
+			{
+				grain_buffer = (uint8_t *) memory_allocate(
+				                            sizeof( uint8_t ) * (size_t) internal_handle->io_handle->grain_size );
+
+				if( grain_buffer == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create grain buffer.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( write_size < (size_t) internal_handle->io_handle->grain_size )
+			{
+				/* The part of the grain that is not overwritten is either stored
+				 * in the parent or sparse hence read it using a single grain read
+				 */
+				if( memory_set(
+				     grain_buffer,
+				     0,
+				     (size_t) internal_handle->io_handle->grain_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear grain buffer.",
+					 function );
+
+					goto on_error;
+				}
+				current_offset = internal_handle->current_offset;
+
+				internal_handle->current_offset -= grain_data_offset;
+
+				read_size = (size_t) internal_handle->io_handle->grain_size;
+
+				if( (size64_t) ( internal_handle->current_offset + read_size ) > internal_handle->io_handle->media_size )
+				{
+					read_size = (size_t) ( internal_handle->io_handle->media_size - internal_handle->current_offset );
+				}
+				read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+				              internal_handle,
+				              file_io_pool,
+				              grain_buffer,
+				              read_size,
+				              error );
+
+				internal_handle->current_offset = current_offset;
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read grain data at offset: %" PRIi64 ".",
+					 function,
+					 current_offset - grain_data_offset );
+
+					goto on_error;
+				}
+			}
+			if( memory_copy(
+			     &( grain_buffer[ grain_data_offset ] ),
+			     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			     write_size ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy buffer to grain buffer.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_write_io_handle_allocate_grain_at_offset(
+			     internal_handle->write_io_handle,
+			     file_io_pool,
+			     internal_handle->current_offset,
+			     &file_io_pool_entry,
+			     &grain_offset,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to allocate grain at offset: %" PRIi64 ".",
+				 function,
+				 internal_handle->current_offset );
+
+				goto on_error;
+			}
+			if( libbfio_pool_seek_offset(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     grain_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek grain offset: %" PRIi64 " in extent file: %d.",
+				 function,
+				 grain_offset,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			write_count = libbfio_pool_write_buffer(
+			               file_io_pool,
+			               file_io_pool_entry,
+			               grain_buffer,
+			               (size_t) internal_handle->io_handle->grain_size,
+			               error );
+
+			if( write_count != (ssize_t) internal_handle->io_handle->grain_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write grain data to extent file: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			grain_offset += grain_data_offset;
+
+			if( libbfio_pool_seek_offset(
+			     file_io_pool,
+			     file_io_pool_entry,
+			     grain_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek grain offset: %" PRIi64 " in extent file: %d.",
+				 function,
+				 grain_offset,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+			write_count = libbfio_pool_write_buffer(
+			               file_io_pool,
+			               file_io_pool_entry,
+			               &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+			               write_size,
+			               error );
+
+			if( write_count != (ssize_t) write_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write grain data to extent file: %d.",
+				 function,
+				 file_io_pool_entry );
+
+				goto on_error;
+			}
+		}
+		buffer_offset += write_size;
+		buffer_size   -= write_size;
+
+		internal_handle->current_offset += (off64_t) write_size;
+
+		if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
+		{
+			break;
+		}
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			break;
+		}
+	}
+	if( grain_buffer != NULL )
+	{
+		memory_free(
+		 grain_buffer );
+	}
+	return( (ssize_t) buffer_offset );
+
+on_error:
+	if( grain_buffer != NULL )
+	{
+		memory_free(
+		 grain_buffer );
+	}
+	return( -1 );
+}
+
+/* Writes (media) data at the current offset
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libvmdk_handle_write_buffer(
+         libvmdk_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_write_buffer";
+	ssize_t write_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	write_count = libvmdk_internal_handle_write_buffer_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->extent_data_file_io_pool,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		write_count = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+}
+
+/* Writes (media) data at a specific offset
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libvmdk_handle_write_buffer_at_offset(
+         libvmdk_handle_t *handle,
+         const void *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_write_buffer_at_offset";
+	ssize_t write_count                        = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_internal_handle_seek_offset(
+	     internal_handle,
+	     offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libvmdk_internal_handle_write_buffer_to_file_io_pool(
+	               internal_handle,
+	               internal_handle->extent_data_file_io_pool,
+	               buffer,
+	               buffer_size,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( write_count );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Discards (media) data using a Basic File IO (bfio) pool
+ * Grains that are fully covered by the range are made sparse again by clearing their grain table entry,
+ * grains that are partially covered are overwritten with 0-byte values
+ * Discard is not supported on a delta disk, since a sparse grain would expose the data of the parent
+ * and overwriting the grains with 0-byte values would grow the delta disk
+ * The grain data of discarded grains is left in the extent file, the file is not truncated
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_handle_discard_from_file_io_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	uint8_t *zero_buffer      = NULL;
+	static char *function     = "libvmdk_internal_handle_discard_from_file_io_pool";
+	size_t discard_size       = 0;
+	ssize_t write_count       = 0;
+	off64_t current_offset    = 0;
+	off64_t grain_data_offset = 0;
+	off64_t grain_offset      = 0;
+	int file_io_pool_entry    = 0;
+	int result                = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle->grain_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - invalid IO handle - missing grain size.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->parent_handle != NULL )
+	 || ( ( internal_handle->descriptor_file != NULL )
+	  && ( internal_handle->descriptor_file->parent_content_identifier_set != 0 )
+	  && ( internal_handle->descriptor_file->parent_content_identifier != 0xffffffffUL ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: discard is not supported on a delta disk.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->io_handle->media_size )
+	{
+		return( 1 );
+	}
+	if( size > ( internal_handle->io_handle->media_size - (size64_t) offset ) )
+	{
+		size = internal_handle->io_handle->media_size - (size64_t) offset;
+	}
+	current_offset = internal_handle->current_offset;
+
+	while( size > 0 )
+	{
+		grain_data_offset = (off64_t) ( offset % internal_handle->io_handle->grain_size );
+
+		discard_size = (size_t) ( internal_handle->io_handle->grain_size - grain_data_offset );
+
+		if( (size64_t) discard_size > size )
+		{
+			discard_size = (size_t) size;
+		}
+		/* The last grain is fully covered when the range extends up to the end of the media
+		 */
+		if( ( grain_data_offset == 0 )
+		 && ( ( discard_size == (size_t) internal_handle->io_handle->grain_size )
+		  || ( (size64_t) ( offset + discard_size ) == internal_handle->io_handle->media_size ) ) )
+		{
+			if( libvmdk_write_io_handle_discard_grain_at_offset(
+			     internal_handle->write_io_handle,
+			     file_io_pool,
+			     offset,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to discard grain at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			result = libvmdk_write_io_handle_get_grain_offset_at_offset(
+			          internal_handle->write_io_handle,
+			          file_io_pool,
+			          offset,
+			          &file_io_pool_entry,
+			          &grain_offset,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve grain offset at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+			/* A sparse grain already reads as 0-byte values
+			 */
+			if( result != 0 )
+			{
+				if( zero_buffer == NULL )
+				{
+					zero_buffer = (uint8_t *) memory_allocate(
+					                           sizeof( uint8_t ) * (size_t) internal_handle->io_handle->grain_size );
+
+					if( zero_buffer == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+						 "%s: unable to create zero buffer.",
+						 function );
+
+						goto on_error;
+					}
+					if( memory_set(
+					     zero_buffer,
+					     0,
+					     (size_t) internal_handle->io_handle->grain_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to clear zero buffer.",
+						 function );
+
+						goto on_error;
+					}
+				}
+				internal_handle->current_offset = offset;
+
+				write_count = libvmdk_internal_handle_write_buffer_to_file_io_pool(
+				               internal_handle,
+				               file_io_pool,
+				               zero_buffer,
+				               discard_size,
+				               error );
+
+				if( write_count != (ssize_t) discard_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write 0-byte values at offset: %" PRIi64 ".",
+					 function,
+					 offset );
+
+					goto on_error;
+				}
+			}
+		}
+		offset += (off64_t) discard_size;
+		size   -= (size64_t) discard_size;
+	}
+	internal_handle->current_offset = current_offset;
+
+	if( zero_buffer != NULL )
+	{
+		memory_free(
+		 zero_buffer );
+	}
+	return( 1 );
+
+on_error:
+	internal_handle->current_offset = current_offset;
+
+	if( zero_buffer != NULL )
+	{
+		memory_free(
+		 zero_buffer );
+	}
+	return( -1 );
+}
+
+/* Discards (media) data at a specific offset
+ * Grains that are fully covered by the range are returned to sparse, other data is overwritten with 0-byte values
+ * The handle must be opened for writing and the current offset is not changed
+ * Discard is not supported on a delta disk
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_discard(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_discard";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( libvmdk_internal_handle_discard_from_file_io_pool(
+	     internal_handle,
+	     internal_handle->extent_data_file_io_pool,
+	     offset,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to discard data at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Flushes the buffered metadata changes to the extent files
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_flush(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_flush";
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->write_io_handle != NULL )
+	{
+		if( libvmdk_write_io_handle_flush(
+		     internal_handle->write_io_handle,
+		     internal_handle->extent_data_file_io_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush write IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Determines if the allocated grain at a specific offset only contains 0-byte values using a Basic File IO (bfio) pool
+ * In read-only mode the grain data is retrieved from the grains cache, where the check was done when the grain was read
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if the grain only contains 0-byte values, 0 if not or -1 on error
+ */
+int libvmdk_internal_handle_grain_is_zero_at_offset(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libfcache_cache_t *grains_cache  = NULL;
+	libvmdk_grain_data_t *grain_data = NULL;
+	uint8_t *grain_buffer            = NULL;
+	static char *function            = "libvmdk_internal_handle_grain_is_zero_at_offset";
+	size_t read_size                 = 0;
+	ssize_t read_count               = 0;
+	off64_t grain_data_offset        = 0;
+	off64_t grain_offset             = 0;
+	uint64_t grain_index             = 0;
+	int file_io_pool_entry           = 0;
+	int partition_index              = -1;
+	int result                       = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_handle->io_handle->grain_size == 0 )
+	 || ( internal_handle->io_handle->grain_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid handle - invalid IO handle - grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( offset < 0 )
+	 || ( (size64_t) offset >= internal_handle->io_handle->media_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	grain_index = (uint64_t) offset / internal_handle->io_handle->grain_size;
+
+	if( internal_handle->write_io_handle == NULL )
+	{
+		if( libvmdk_internal_handle_grab_grains_cache(
+		     internal_handle,
+		     offset,
+		     &grains_cache,
+		     &partition_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to grab grains cache.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_grain_table_get_grain_data_at_offset(
+		     internal_handle->grain_table,
+		     grain_index,
+		     file_io_pool,
+		     internal_handle->extent_table,
+		     grains_cache,
+		     offset,
+		     &grain_data,
+		     &grain_data_offset,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain: %" PRIu64 " data.",
+			 function,
+			 grain_index );
+
+			goto on_error;
+		}
+		if( grain_data == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing grain: %" PRIu64 " data.",
+			 function,
+			 grain_index );
+
+			goto on_error;
+		}
+		result = (int) grain_data->is_zero;
+
+		if( libvmdk_internal_handle_release_grains_cache(
+		     internal_handle,
+		     partition_index,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release grains cache.",
+			 function );
+
+			return( -1 );
+		}
+		return( result );
+	}
+	/* When writing the grains are not cached hence read the grain data
+	 */
+	result = libvmdk_write_io_handle_get_grain_offset_at_offset(
+	          internal_handle->write_io_handle,
+	          file_io_pool,
+	          offset,
+	          &file_io_pool_entry,
+	          &grain_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain offset at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	offset -= (off64_t) ( offset % internal_handle->io_handle->grain_size );
+
+	read_size = (size_t) internal_handle->io_handle->grain_size;
+
+	if( (size64_t) ( offset + read_size ) > internal_handle->io_handle->media_size )
+	{
+		read_size = (size_t) ( internal_handle->io_handle->media_size - offset );
+	}
+	grain_buffer = (uint8_t *) memory_allocate(
+	                            sizeof( uint8_t ) * read_size );
+
+	if( grain_buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain buffer.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_pool_seek_offset(
+	     file_io_pool,
+	     file_io_pool_entry,
+	     grain_offset,
+	     SEEK_SET,
+	     error ) == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek grain offset: %" PRIi64 " in extent file: %d.",
+		 function,
+		 grain_offset,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	read_count = libbfio_pool_read_buffer(
+	              file_io_pool,
+	              file_io_pool_entry,
+	              grain_buffer,
+	              read_size,
+	              error );
+
+	libvmdk_statistics_add_backing_read(
+	 &( internal_handle->io_handle->statistics ),
+	 read_count );
+
+	if( read_count != (ssize_t) read_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain: %" PRIu64 " data from extent file: %d.",
+		 function,
+		 grain_index,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	result = libvmdk_zero_block_check(
+	          grain_buffer,
+	          read_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if grain: %" PRIu64 " only contains 0-byte values.",
+		 function,
+		 grain_index );
+
+		goto on_error;
+	}
+	memory_free(
+	 grain_buffer );
+
+	return( result );
+
+on_error:
+	if( partition_index >= 0 )
+	{
+		libvmdk_internal_handle_release_grains_cache(
+		 internal_handle,
+		 partition_index,
+		 NULL );
+	}
+	if( grain_buffer != NULL )
+	{
+		memory_free(
+		 grain_buffer );
+	}
+	return( -1 );
+}
+
+/* Retrieves the data range at a specific offset using a Basic File IO (bfio) pool
+ * The range consists of consecutive grains with the same range flags and is limited to the maximum range size
+ * A grain that is sparse in this disk is looked up in the parent, if any
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libvmdk_internal_handle_get_data_range_at_offset(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t maximum_range_size,
+     size64_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_parent_handle = NULL;
+	static char *function                             = "libvmdk_internal_handle_get_data_range_at_offset";
+	size64_t grain_range_size                         = 0;
+	size64_t parent_range_size                        = 0;
+	off64_t grain_offset                              = 0;
+	uint64_t grain_index                              = 0;
+	uint32_t grain_group_flags                        = 0;
+	uint32_t grain_range_flags                        = 0;
+	uint32_t parent_range_flags                       = 0;
+	int file_io_pool_entry                            = 0;
+	int grain_is_sparse                               = 0;
+	int result                                        = 0;
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->extent_table == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent table.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( maximum_range_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid maximum range size value zero or less.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= internal_handle->io_handle->media_size )
+	{
+		return( 0 );
+	}
+	if( maximum_range_size > ( internal_handle->io_handle->media_size - offset ) )
+	{
+		maximum_range_size = internal_handle->io_handle->media_size - offset;
+	}
+	*range_size  = 0;
+	*range_flags = 0;
+
+	if( internal_handle->extent_table->extent_files_stream != NULL )
+	{
+		*range_size = maximum_range_size;
+
+		return( 1 );
+	}
+	grain_index = offset / internal_handle->io_handle->grain_size;
+
+	while( *range_size < maximum_range_size )
+	{
+		if( internal_handle->write_io_handle == NULL )
+		{
+			grain_is_sparse = libvmdk_grain_table_grain_is_sparse_at_offset(
+					   internal_handle->grain_table,
+					   grain_index,
+					   file_io_pool,
+					   internal_handle->extent_table,
+					   offset,
+					   error );
+		}
+		else
+		{
+			result = libvmdk_write_io_handle_get_grain_offset_at_offset(
+			          internal_handle->write_io_handle,
+			          file_io_pool,
+			          offset,
+			          &file_io_pool_entry,
+			          &grain_offset,
+			          error );
+
+			if( result == -1 )
+			{
+				grain_is_sparse = -1;
+			}
+			else if( result == 0 )
+			{
+				grain_is_sparse = 1;
+			}
+			else
+			{
+				grain_is_sparse = 0;
+			}
+		}
+		if( grain_is_sparse == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if the grain: %" PRIu64 " is sparse.",
+			 function,
+			 grain_index );
+
+			return( -1 );
+		}
+		grain_range_size = internal_handle->io_handle->grain_size - ( offset % internal_handle->io_handle->grain_size );
+
+		if( grain_range_size > ( maximum_range_size - *range_size ) )
+		{
+			grain_range_size = maximum_range_size - *range_size;
+		}
+		grain_range_flags = 0;
+
+		if( grain_is_sparse == 0 )
+		{
+			if( internal_handle->zero_detection != 0 )
+			{
+				result = libvmdk_internal_handle_grain_is_zero_at_offset(
+				          internal_handle,
+				          file_io_pool,
+				          offset,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to determine if the grain: %" PRIu64 " only contains 0-byte values.",
+					 function,
+					 grain_index );
+
+					return( -1 );
+				}
+				else if( result != 0 )
+				{
+					grain_range_flags = LIBVMDK_RANGE_FLAG_IS_ZERO;
+				}
+			}
+		}
+		else
+		{
+			if( internal_handle->parent_handle == NULL )
+			{
+				grain_range_flags = LIBVMDK_RANGE_FLAG_IS_SPARSE;
+			}
+			else
+			{
+				internal_parent_handle = (libvmdk_internal_handle_t *) internal_handle->parent_handle;
+
+				if( internal_parent_handle->extent_data_file_io_pool == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+					 "%s: invalid parent handle - missing extent data file IO pool.",
+					 function );
+
+					return( -1 );
+				}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+				if( libcthreads_read_write_lock_grab_for_write(
+				     internal_parent_handle->read_write_lock,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to grab parent read/write lock for writing.",
+					 function );
+
+					return( -1 );
+				}
+#endif
+				/* The parent range is bounded by the grain so that the grains of this disk
+				 * that were written take precedence over the parent data
+				 */
+				result = libvmdk_internal_handle_get_data_range_at_offset(
+				          internal_parent_handle,
+				          internal_parent_handle->extent_data_file_io_pool,
+				          offset,
+				          grain_range_size,
+				          &parent_range_size,
+				          &parent_range_flags,
+				          error );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+				if( libcthreads_read_write_lock_release_for_write(
+				     internal_parent_handle->read_write_lock,
+				     NULL ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+					 "%s: unable to release parent read/write lock for writing.",
+					 function );
+
+					return( -1 );
+				}
+#endif
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve data range at offset: %" PRIi64 " from parent.",
+					 function,
+					 offset );
+
+					return( -1 );
+				}
+				else if( result == 0 )
+				{
+					grain_range_flags = LIBVMDK_RANGE_FLAG_IS_SPARSE;
+				}
+				else
+				{
+					/* A range in the parent never crosses a grain boundary of this disk
+					 * but can be smaller when the parent uses a smaller grain size
+					 */
+					if( parent_range_size < grain_range_size )
+					{
+						grain_range_size = parent_range_size;
+					}
+					if( ( parent_range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+					{
+						grain_range_flags = LIBVMDK_RANGE_FLAG_IS_SPARSE;
+					}
+					else
+					{
+						grain_range_flags = LIBVMDK_RANGE_FLAG_IN_PARENT | ( parent_range_flags & LIBVMDK_RANGE_FLAG_IS_ZERO );
+					}
+				}
+			}
+		}
+		/* Grain groups that failed verification are reported for the data of this disk
+		 */
+		if( internal_handle->write_io_handle == NULL )
+		{
+			if( libvmdk_grain_table_get_grain_group_flags_at_offset(
+			     internal_handle->grain_table,
+			     file_io_pool,
+			     internal_handle->extent_table,
+			     offset,
+			     &grain_group_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve grain group flags of grain: %" PRIu64 ".",
+				 function,
+				 grain_index );
+
+				return( -1 );
+			}
+			grain_range_flags |= grain_group_flags & ( LIBVMDK_RANGE_FLAG_IS_TAINTED | LIBVMDK_RANGE_FLAG_IS_CORRUPTED );
+		}
+		if( *range_size == 0 )
+		{
+			*range_flags = grain_range_flags;
+		}
+		else if( grain_range_flags != *range_flags )
+		{
+			break;
+		}
+		*range_size += grain_range_size;
+		offset      += (off64_t) grain_range_size;
+		grain_index  = offset / internal_handle->io_handle->grain_size;
+	}
+	return( 1 );
+}
+
+/* Retrieves the data range at a specific offset
+ * The range consists of consecutive data with the same range flags, where
+ * LIBVMDK_RANGE_FLAG_IS_SPARSE indicates the data is sparse in this disk and all of its parents,
+ * LIBVMDK_RANGE_FLAG_IN_PARENT indicates the data is stored in one of the parents and
+ * LIBVMDK_RANGE_FLAG_IS_ZERO indicates the data is allocated but only contains 0-byte values,
+ * which is only reported if zero detection was enabled,
+ * LIBVMDK_RANGE_FLAG_IS_TAINTED indicates the grain directory and its backup disagree and
+ * LIBVMDK_RANGE_FLAG_IS_CORRUPTED indicates the grain table or its grains are invalid,
+ * which are only reported after libvmdk_handle_verify_extent found them
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int libvmdk_handle_get_data_range_at_offset(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     size64_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_data_range_at_offset";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( ( offset >= 0 )
+	 && ( (size64_t) offset < internal_handle->io_handle->media_size ) )
+	{
+		result = libvmdk_internal_handle_get_data_range_at_offset(
+		          internal_handle,
+		          internal_handle->extent_data_file_io_pool,
+		          offset,
+		          internal_handle->io_handle->media_size - offset,
+		          range_size,
+		          range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			goto on_error;
+		}
+	}
+	else if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_write(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
+
+/* Retrieves the data range at a specific offset to compare it with the data of another handle
+ * Beyond the media size the data is considered sparse up to the maximum offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_compare_range_at_offset(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     off64_t maximum_offset,
+     off64_t *range_end_offset,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_handle_get_compare_range_at_offset";
+	size64_t range_size   = 0;
+	int result            = 0;
+
+	if( range_end_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range end offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_flags == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range flags.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvmdk_handle_get_data_range_at_offset(
+	          handle,
+	          offset,
+	          &range_size,
+	          range_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		*range_end_offset = maximum_offset;
+		*range_flags      = LIBVMDK_RANGE_FLAG_IS_SPARSE;
+	}
+	else
+	{
+		*range_end_offset = offset + (off64_t) range_size;
+	}
+	return( 1 );
+}
+
+/* Reads the data of a handle at a specific offset to compare it with the data of another handle
+ * Beyond the media size the data is considered to contain 0-byte values
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_read_compare_buffer_at_offset(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_handle_read_compare_buffer_at_offset";
+	ssize_t read_count    = 0;
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( (size_t) read_count < size )
+	{
+		if( memory_set(
+		     &( buffer[ read_count ] ),
+		     0,
+		     size - (size_t) read_count ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the next range of the media data that differs from the data of another handle
+ * The search starts at the offset and the data beyond the media size of a handle is considered sparse
+ * When one of the handles is the parent of the other, as determined by the content identifiers,
+ * the changed ranges are the grains allocated in the child and no data is read
+ * Otherwise only the data that is allocated in either handle is read and compared per sector,
+ * data that is sparse in both handles or that is stored in the parent of two handles with the same
+ * parent content identifier is not read
+ * Returns 1 if successful, 0 if no changed range was found or -1 on error
+ */
+int libvmdk_handle_get_next_changed_range(
+     libvmdk_handle_t *handle,
+     libvmdk_handle_t *other_handle,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *child_handle             = NULL;
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	uint8_t *compare_buffer                    = NULL;
+	uint8_t *other_compare_buffer              = NULL;
+	static char *function                      = "libvmdk_handle_get_next_changed_range";
+	size64_t child_media_size                  = 0;
+	size64_t media_size                        = 0;
+	size64_t other_media_size                  = 0;
+	size_t compare_size                        = 0;
+	size_t sector_offset                       = 0;
+	size_t sector_size                         = 0;
+	off64_t maximum_offset                     = 0;
+	off64_t other_range_end_offset             = 0;
+	off64_t range_end_offset                   = 0;
+	off64_t segment_end_offset                 = 0;
+	uint32_t content_identifier                = 0;
+	uint32_t other_content_identifier          = 0;
+	uint32_t other_parent_content_identifier   = 0;
+	uint32_t other_range_flags                 = 0;
+	uint32_t parent_content_identifier         = 0;
+	uint32_t range_flags                       = 0;
+	uint8_t is_changed                         = 0;
+	uint8_t is_child_range                     = 0;
+	uint8_t sector_is_changed                  = 0;
+	int has_other_parent_content_identifier    = 0;
+	int has_parent_content_identifier          = 0;
+	int shares_parent                          = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( other_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid other handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( range_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid range size.",
+		 function );
+
+		return( -1 );
+	}
+	*range_offset = 0;
+	*range_size   = 0;
+
+	if( handle == other_handle )
+	{
+		return( 0 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_get_media_size(
+	     other_handle,
+	     &other_media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve other media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_get_content_identifier(
+	     handle,
+	     &content_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_get_content_identifier(
+	     other_handle,
+	     &other_content_identifier,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve other content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	has_parent_content_identifier = libvmdk_handle_get_parent_content_identifier(
+	                                 handle,
+	                                 &parent_content_identifier,
+	                                 error );
+
+	if( has_parent_content_identifier == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	has_other_parent_content_identifier = libvmdk_handle_get_parent_content_identifier(
+	                                       other_handle,
+	                                       &other_parent_content_identifier,
+	                                       error );
+
+	if( has_other_parent_content_identifier == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve other parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	/* A parent content identifier of 0xffffffff indicates the disk has no parent
+	 */
+	if( ( has_parent_content_identifier != 0 )
+	 && ( parent_content_identifier == 0xffffffffUL ) )
+	{
+		has_parent_content_identifier = 0;
+	}
+	if( ( has_other_parent_content_identifier != 0 )
+	 && ( other_parent_content_identifier == 0xffffffffUL ) )
+	{
+		has_other_parent_content_identifier = 0;
+	}
+	if( ( has_parent_content_identifier != 0 )
+	 && ( parent_content_identifier == other_content_identifier ) )
+	{
+		child_handle     = handle;
+		child_media_size = media_size;
+	}
+	else if( ( has_other_parent_content_identifier != 0 )
+	      && ( other_parent_content_identifier == content_identifier ) )
+	{
+		child_handle     = other_handle;
+		child_media_size = other_media_size;
+	}
+	else if( ( has_parent_content_identifier != 0 )
+	      && ( has_other_parent_content_identifier != 0 )
+	      && ( parent_content_identifier == other_parent_content_identifier ) )
+	{
+		shares_parent = 1;
+	}
+	if( media_size > other_media_size )
+	{
+		maximum_offset = (off64_t) media_size;
+	}
+	else
+	{
+		maximum_offset = (off64_t) other_media_size;
+	}
+	range_end_offset       = offset;
+	other_range_end_offset = offset;
+
+	while( offset < maximum_offset )
+	{
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+			 "%s: abort requested.",
+			 function );
+
+			goto on_error;
+		}
+		is_child_range = (uint8_t) ( ( child_handle != NULL ) && ( (size64_t) offset < child_media_size ) );
+
+		/* The grain tables of the parent are not needed to determine the changes of the child
+		 */
+		if( ( offset >= range_end_offset )
+		 && ( ( is_child_range == 0 )
+		  || ( child_handle == handle ) ) )
+		{
+			if( libvmdk_handle_get_compare_range_at_offset(
+			     handle,
+			     offset,
+			     maximum_offset,
+			     &range_end_offset,
+			     &range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve data range at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+		}
+		if( ( offset >= other_range_end_offset )
+		 && ( ( is_child_range == 0 )
+		  || ( child_handle == other_handle ) ) )
+		{
+			if( libvmdk_handle_get_compare_range_at_offset(
+			     other_handle,
+			     offset,
+			     maximum_offset,
+			     &other_range_end_offset,
+			     &other_range_flags,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve other data range at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+		}
+		if( is_child_range != 0 )
+		{
+			if( child_handle == handle )
+			{
+				other_range_end_offset = range_end_offset;
+			}
+			else
+			{
+				range_end_offset = other_range_end_offset;
+			}
+		}
+		segment_end_offset = range_end_offset;
+
+		if( segment_end_offset > other_range_end_offset )
+		{
+			segment_end_offset = other_range_end_offset;
+		}
+		if( is_child_range != 0 )
+		{
+			if( child_handle == handle )
+			{
+				is_changed = (uint8_t) ( ( range_flags & ( LIBVMDK_RANGE_FLAG_IS_SPARSE | LIBVMDK_RANGE_FLAG_IN_PARENT ) ) == 0 );
+			}
+			else
+			{
+				is_changed = (uint8_t) ( ( other_range_flags & ( LIBVMDK_RANGE_FLAG_IS_SPARSE | LIBVMDK_RANGE_FLAG_IN_PARENT ) ) == 0 );
+			}
+		}
+		else if( ( ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+		      && ( ( other_range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 ) )
+		{
+			is_changed = 0;
+		}
+		else if( ( shares_parent != 0 )
+		      && ( ( range_flags & LIBVMDK_RANGE_FLAG_IN_PARENT ) != 0 )
+		      && ( ( other_range_flags & LIBVMDK_RANGE_FLAG_IN_PARENT ) != 0 ) )
+		{
+			is_changed = 0;
+		}
+		else
+		{
+			if( compare_buffer == NULL )
+			{
+				compare_buffer = (uint8_t *) memory_allocate(
+				                              sizeof( uint8_t ) * LIBVMDK_COMPARE_BLOCK_SIZE );
+
+				if( compare_buffer == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create compare buffer.",
+					 function );
+
+					goto on_error;
+				}
+				other_compare_buffer = (uint8_t *) memory_allocate(
+				                                    sizeof( uint8_t ) * LIBVMDK_COMPARE_BLOCK_SIZE );
+
+				if( other_compare_buffer == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+					 "%s: unable to create other compare buffer.",
 					 function );
 
-					return( -1 );
-				}
-			}
-			buffer_offset    += read_size;
-			buffer_size      -= read_size;
-			grain_index      += 1;
-			grain_data_offset = 0;
+					goto on_error;
+				}
+			}
+			if( ( segment_end_offset - offset ) > (off64_t) LIBVMDK_COMPARE_BLOCK_SIZE )
+			{
+				segment_end_offset = offset + LIBVMDK_COMPARE_BLOCK_SIZE;
+			}
+			compare_size = (size_t) ( segment_end_offset - offset );
+
+			if( libvmdk_handle_read_compare_buffer_at_offset(
+			     handle,
+			     offset,
+			     compare_buffer,
+			     compare_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read data at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+			if( libvmdk_handle_read_compare_buffer_at_offset(
+			     other_handle,
+			     offset,
+			     other_compare_buffer,
+			     compare_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read other data at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+			for( sector_offset = 0;
+			     sector_offset < compare_size;
+			     sector_offset += sector_size )
+			{
+				sector_size = compare_size - sector_offset;
+
+				if( sector_size > 512 )
+				{
+					sector_size = 512;
+				}
+				sector_is_changed = (uint8_t) ( memory_compare(
+				                                 &( compare_buffer[ sector_offset ] ),
+				                                 &( other_compare_buffer[ sector_offset ] ),
+				                                 sector_size ) != 0 );
+
+				if( sector_is_changed != 0 )
+				{
+					if( *range_size == 0 )
+					{
+						*range_offset = offset + (off64_t) sector_offset;
+					}
+					*range_size += sector_size;
+				}
+				else if( *range_size != 0 )
+				{
+					break;
+				}
+			}
+			if( ( sector_offset < compare_size )
+			 && ( *range_size != 0 ) )
+			{
+				break;
+			}
+			offset = segment_end_offset;
+
+			continue;
+		}
+		if( is_changed != 0 )
+		{
+			if( *range_size == 0 )
+			{
+				*range_offset = offset;
+			}
+			*range_size += (size64_t) ( segment_end_offset - offset );
+		}
+		else if( *range_size != 0 )
+		{
+			break;
+		}
+		offset = segment_end_offset;
+	}
+	if( other_compare_buffer != NULL )
+	{
+		memory_free(
+		 other_compare_buffer );
+	}
+	if( compare_buffer != NULL )
+	{
+		memory_free(
+		 compare_buffer );
+	}
+	if( *range_size == 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( other_compare_buffer != NULL )
+	{
+		memory_free(
+		 other_compare_buffer );
+	}
+	if( compare_buffer != NULL )
+	{
+		memory_free(
+		 compare_buffer );
+	}
+	*range_offset = 0;
+	*range_size   = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the size of the UTF-8 encoded change identifier of the change tracking file
+ * The size includes the end of string character
+ * Returns 1 if successful, 0 if no change tracking file was opened or -1 on error
+ */
+int libvmdk_handle_get_utf8_change_identifier_size(
+     libvmdk_handle_t *handle,
+     size_t *utf8_string_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_utf8_change_identifier_size";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->change_tracking_file != NULL )
+	{
+		result = libvmdk_change_tracking_file_get_utf8_change_identifier_size(
+		          internal_handle->change_tracking_file,
+		          utf8_string_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve UTF-8 change identifier size.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the UTF-8 encoded change identifier of the change tracking file
+ * The change identifier refers to the current state of the change tracking file
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if no change tracking file was opened or -1 on error
+ */
+int libvmdk_handle_get_utf8_change_identifier(
+     libvmdk_handle_t *handle,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_utf8_change_identifier";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->change_tracking_file != NULL )
+	{
+		result = libvmdk_change_tracking_file_get_utf8_change_identifier(
+		          internal_handle->change_tracking_file,
+		          utf8_string,
+		          utf8_string_size,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve UTF-8 change identifier.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves the next range of the media data that changed after a change identifier
+ * The changed ranges are determined from the change tracking file, no data is read
+ * The change identifier "*" refers to the state when change tracking was enabled
+ * If the file header of the change tracking file contains unexpected values
+ * the remainder of the media data is reported as changed
+ * Returns 1 if successful, 0 if no changed range was found or -1 on error
+ */
+int libvmdk_handle_get_next_changed_block_range(
+     libvmdk_handle_t *handle,
+     const uint8_t *utf8_change_identifier,
+     size_t utf8_change_identifier_length,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_next_changed_block_range";
+	uint32_t sequence_number                   = 0;
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->change_tracking_file == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing change tracking file.",
+		 function );
+
+		result = -1;
+	}
+	else if( libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier(
+	          internal_handle->change_tracking_file,
+	          utf8_change_identifier,
+	          utf8_change_identifier_length,
+	          &sequence_number,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve sequence number from change identifier.",
+		 function );
+
+		result = -1;
+	}
+	else
+	{
+		result = libvmdk_change_tracking_file_get_next_changed_block_range(
+		          internal_handle->change_tracking_file,
+		          sequence_number,
+		          offset,
+		          range_offset,
+		          range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next changed block range.",
+			 function );
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Seeks a certain offset of the (media) data
+ * This function is not multi-thread safe acquire write lock before call
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvmdk_internal_handle_seek_offset(
+         libvmdk_internal_handle_t *internal_handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_handle_seek_offset";
+
+	if( internal_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( whence != SEEK_CUR )
+	 && ( whence != SEEK_END )
+	 && ( whence != SEEK_SET ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		return( -1 );
+	}
+	if( whence == SEEK_CUR )
+	{
+		offset += internal_handle->current_offset;
+	}
+	else if( whence == SEEK_END )
+	{
+		offset += (off64_t) internal_handle->io_handle->media_size;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle->current_offset = offset;
+
+	return( offset );
+}
+
+/* Seeks a certain offset of the (media) data
+ * Returns the offset if seek is successful or -1 on error
+ */
+off64_t libvmdk_handle_seek_offset(
+         libvmdk_handle_t *handle,
+         off64_t offset,
+         int whence,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_seek_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	offset = libvmdk_internal_handle_seek_offset(
+	          internal_handle,
+	          offset,
+	          whence,
+	          error );
+
+	if( offset == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset.",
+		 function );
+
+		offset = -1;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( offset );
+}
+
+/* Retrieves the current offset of the (media) data
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_get_offset(
+     libvmdk_handle_t *handle,
+     off64_t *offset,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_offset";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->extent_data_file_io_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid offset.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	*offset = internal_handle->current_offset;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the maximum number of (concurrent) open file handles
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_maximum_number_of_open_handles(
+     libvmdk_handle_t *handle,
+     int maximum_number_of_open_handles,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_maximum_number_of_open_handles";
+	int result                                 = 1;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	if( internal_handle->extent_data_file_io_pool != NULL )
+	{
+		result = libbfio_pool_set_maximum_number_of_open_handles(
+		          internal_handle->extent_data_file_io_pool,
+		          maximum_number_of_open_handles,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set maximum number of open handles in extent data file IO pool.",
+			 function );
+		}
+	}
+	if( result == 1 )
+	{
+		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Sets the grain size used to create a disk
+ * The grain size is used by libvmdk_handle_create_child, libvmdk_handle_create_sparse
+ * and libvmdk_handle_create_split_sparse and needs to be set before the disk is created
+ * The grain size must be a power of 2 of at least 8 KiB (16 sectors) and at most 1 MiB,
+ * the default is 64 KiB (128 sectors)
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_grain_size(
+     libvmdk_handle_t *handle,
+     size64_t grain_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_grain_size";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - descriptor file already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_delta_disk_is_supported_grain_size(
+	     grain_size ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported grain size: %" PRIu64 ".",
+		 function,
+		 grain_size );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->create_grain_size = grain_size;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets if the data ranges should report allocated grains that only contain 0-byte values
+ * When set, libvmdk_handle_get_data_range_at_offset reads the allocated grains
+ * and reports the ones that only contain 0-byte values with LIBVMDK_RANGE_FLAG_IS_ZERO
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_zero_detection(
+     libvmdk_handle_t *handle,
+     uint8_t zero_detection,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_zero_detection";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->zero_detection = zero_detection;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the cache pool
+ * The grain data of the handle is cached in the cache pool instead of the grains cache of the handle
+ * This function needs to be used before one of the open functions
+ * The handle is attached to the cache pool while it is open and its cached grain data
+ * is removed from the cache pool when it is closed
+ * The cache pool must outlive the handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_cache_pool(
+     libvmdk_handle_t *handle,
+     libvmdk_cache_pool_t *cache_pool,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_cache_pool";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - descriptor file already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_handle->cache_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid handle - cache pool already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( cache_pool == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache pool.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->cache_pool                   = cache_pool;
+	internal_handle->cache_pool_handle_identifier = -1;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Sets the statistics flags
+ * The statistics flags are a combination of the LIBVMDK_STATISTICS_FLAGS definitions
+ * The durations and histograms are only maintained if LIBVMDK_STATISTICS_FLAG_MEASURE_TIME is set
+ * This function needs to be used before one of the open functions to measure the open phases
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_handle_set_statistics_flags(
+     libvmdk_handle_t *handle,
+     uint8_t statistics_flags,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_set_statistics_flags";
+	uint8_t supported_flags                    = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	supported_flags = LIBVMDK_STATISTICS_FLAG_MEASURE_TIME;
+
+	if( ( statistics_flags & ~( supported_flags ) ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported statistics flags: 0x%02" PRIx8 ".",
+		 function,
+		 statistics_flags );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_handle->io_handle->statistics.flags = statistics_flags;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for writing.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( 1 );
+}
+
+/* Retrieves a specific statistics value
+ * The statistics are maintained by the read functions of this handle, reads of the parent handle are
+ * counted by the parent handle itself
+ * Returns 1 if successful, 0 if the value type is not supported or -1 on error
+ */
+int libvmdk_handle_get_statistics_value(
+     libvmdk_handle_t *handle,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_statistics_value";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_statistics_get_value(
+	          &( internal_handle->io_handle->statistics ),
+	          value_type,
+	          value,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics value.",
+		 function );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific statistics histogram
+ * The histogram must contain LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS buckets
+ * Returns 1 if successful, 0 if the histogram type is not supported or -1 on error
+ */
+int libvmdk_handle_get_statistics_histogram(
+     libvmdk_handle_t *handle,
+     int histogram_type,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_statistics_histogram";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_statistics_get_histogram(
+	          &( internal_handle->io_handle->statistics ),
+	          histogram_type,
+	          histogram,
+	          number_of_buckets,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics histogram.",
+		 function );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	return( result );
+}
+
+/* Retrieves a specific value of an open phase
+ * The open phases are maintained while opening this handle and its extent data files,
+ * reads of metadata when an extent file is reloaded into the extent files cache are
+ * counted in the corresponding phase
+ * Returns 1 if successful, 0 if the open phase or value type is not supported or -1 on error
+ */
+int libvmdk_handle_get_open_phase_value(
+     libvmdk_handle_t *handle,
+     int open_phase,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_open_phase_value";
+	int result                                 = 0;
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing IO handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	result = libvmdk_statistics_get_open_phase_value(
+	          &( internal_handle->io_handle->statistics ),
+	          open_phase,
+	          value_type,
+	          value,
+	          error );
 
-			internal_handle->current_offset += (off64_t) read_size;
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve open phase value.",
+		 function );
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
+		 function );
 
-			if( (size64_t) internal_handle->current_offset >= internal_handle->io_handle->media_size )
-			{
-				break;
-			}
-			if( internal_handle->io_handle->abort != 0 )
-			{
-				break;
-			}
-		}
+		return( -1 );
 	}
-	return( (ssize_t) buffer_offset );
+#endif
+	return( result );
 }
 
-/* Reads (media) data from the last current into a buffer
- * Returns the number of bytes read or -1 on error
+/* Sets the trace callback
+ * The callback is invoked at the begin and end of the phases of a read with
+ * a timestamp in nanoseconds and the size of the data involved
+ * A phase that fails ends with an error event instead of an end event
+ * A callback of NULL disables tracing
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvmdk_handle_read_buffer(
-         libvmdk_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libvmdk_handle_set_trace_callback(
+     libvmdk_handle_t *handle,
+     void (*trace_callback)(
+            int trace_phase,
+            int trace_event,
+            uint64_t timestamp,
+            uint64_t size,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_read_buffer";
-	ssize_t read_count                         = 0;
+	static char *function                      = "libvmdk_handle_set_trace_callback";
 
 	if( handle == NULL )
 	{
@@ -3294,13 +10229,13 @@ ssize_t libvmdk_handle_read_buffer(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
@@ -3320,24 +10255,9 @@ ssize_t libvmdk_handle_read_buffer(
 		return( -1 );
 	}
 #endif
-	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->extent_data_file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
-		 function );
+	internal_handle->io_handle->trace_callback      = trace_callback;
+	internal_handle->io_handle->trace_callback_data = callback_data;
 
-		read_count = -1;
-	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -3353,22 +10273,20 @@ ssize_t libvmdk_handle_read_buffer(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( 1 );
 }
 
-/* Reads (media) data at a specific offset
- * Returns the number of bytes read or -1 on error
+/* Sets the parent handle
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvmdk_handle_read_buffer_at_offset(
-         libvmdk_handle_t *handle,
-         void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libvmdk_handle_set_parent_handle(
+     libvmdk_handle_t *handle,
+     libvmdk_handle_t *parent_handle,
+     libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_read_buffer_at_offset";
-	ssize_t read_count                         = 0;
+	static char *function                      = "libvmdk_handle_set_parent_handle";
+	uint32_t content_identifier                = 0;
 
 	if( handle == NULL )
 	{
@@ -3383,13 +10301,13 @@ ssize_t libvmdk_handle_read_buffer_at_offset(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( internal_handle->descriptor_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 "%s: invalid handle - missing descriptor file.",
 		 function );
 
 		return( -1 );
@@ -3409,39 +10327,33 @@ ssize_t libvmdk_handle_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	if( libvmdk_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+	if( libvmdk_handle_get_content_identifier(
+	     parent_handle,
+	     &content_identifier,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve content identifier from parent handle.",
 		 function );
 
 		goto on_error;
 	}
-	read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
-		      internal_handle,
-		      internal_handle->extent_data_file_io_pool,
-		      buffer,
-		      buffer_size,
-		      error );
-
-	if( read_count == -1 )
+	if( content_identifier != internal_handle->descriptor_file->parent_content_identifier )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: mismatch in content identifier.",
 		 function );
 
 		goto on_error;
 	}
+	internal_handle->parent_handle = parent_handle;
+
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
@@ -3457,7 +10369,7 @@ ssize_t libvmdk_handle_read_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	return( read_count );
+	return( 1 );
 
 on_error:
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
@@ -3468,39 +10380,18 @@ on_error:
 	return( -1 );
 }
 
-#ifdef TODO_WRITE_SUPPORT
-
-/* Writes (media) data at the current offset from a buffer using a Basic File IO (bfio) pool
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * This function is not multi-thread safe acquire write lock before call
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
- */
-ssize_t libvmdk_internal_handle_write_buffer_to_file_io_pool(
-         libvmdk_internal_handle_t *internal_handle,
-         libbfio_pool_t *file_io_pool,
-         void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
-{
-/* TODO implement */
-	return( -1 );
-}
-
-/* Writes (media) data at the current offset
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+/* Sets the path to the extend data files
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvmdk_handle_write_buffer(
-         libvmdk_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         libcerror_error_t **error )
+int libvmdk_handle_set_extent_data_files_path(
+     libvmdk_handle_t *handle,
+     const char *path,
+     size_t path_length,
+     libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_write_buffer";
-	ssize_t write_count                        = 0;
+	static char *function                      = "libvmdk_handle_set_extent_data_files_path";
+	int result                                 = 1;
 
 	if( handle == NULL )
 	{
@@ -3515,13 +10406,24 @@ ssize_t libvmdk_handle_write_buffer(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( path == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
 		 function );
 
 		return( -1 );
@@ -3541,23 +10443,20 @@ ssize_t libvmdk_handle_write_buffer(
 		return( -1 );
 	}
 #endif
-	write_count = libvmdk_internal_handle_write_buffer_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->extent_data_file_io_pool,
-	               buffer,
-	               buffer_size,
-	               error );
-
-	if( write_count == -1 )
+	if( libvmdk_extent_table_set_data_files_path(
+	     internal_handle->extent_table,
+	     path,
+	     path_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data files path in extent table.",
 		 function );
 
-		write_count = -1;
+		result = -1;
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3574,24 +10473,23 @@ ssize_t libvmdk_handle_write_buffer(
 		return( -1 );
 	}
 #endif
-	return( write_count );
+	return( result );
 }
 
-/* Writes (media) data at a specific offset,
- * the necessary settings of the write values must have been made
- * Will initialize write if necessary
- * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Sets the path to the extend data files
+ * Returns 1 if successful or -1 on error
  */
-ssize_t libvmdk_handle_write_buffer_at_offset(
-         libvmdk_handle_t *handle,
-         const void *buffer,
-         size_t buffer_size,
-         off64_t offset,
-         libcerror_error_t **error )
+int libvmdk_handle_set_extent_data_files_path_wide(
+     libvmdk_handle_t *handle,
+     const wchar_t *path,
+     size_t path_length,
+     libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_write_buffer_at_offset";
-	ssize_t write_count                        = 0;
+	static char *function                      = "libvmdk_handle_set_extent_data_files_path_wide";
+	int result                                 = 1;
 
 	if( handle == NULL )
 	{
@@ -3606,64 +10504,57 @@ ssize_t libvmdk_handle_write_buffer_at_offset(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( path == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid path length value exceeds maximum.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libvmdk_internal_handle_seek_offset(
-	     internal_handle,
-	     offset,
-	     SEEK_SET,
-	     error ) == -1 )
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	write_count = libvmdk_internal_handle_write_buffer_to_file_io_pool(
-	               internal_handle,
-	               internal_handle->extent_data_file_io_pool,
-	               buffer,
-	               buffer_size,
-	               error );
-
-	if( write_count == -1 )
+#endif
+	if( libvmdk_extent_table_set_data_files_path_wide(
+	     internal_handle->extent_table,
+	     path,
+	     path_length,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to write buffer.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set data files path in extent table.",
 		 function );
 
-		goto on_error;
+		result = -1;
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_write(
@@ -3680,32 +10571,23 @@ ssize_t libvmdk_handle_write_buffer_at_offset(
 		return( -1 );
 	}
 #endif
-	return( write_count );
-
-on_error:
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
+	return( result );
 }
 
-#endif /* TODO_WRITE_SUPPORT */
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
-/* Seeks a certain offset of the (media) data
- * This function is not multi-thread safe acquire write lock before call
- * Returns the offset if seek is successful or -1 on error
+/* Retrieves the disk type
+ * Returns 1 if successful or -1 on error
  */
-off64_t libvmdk_internal_handle_seek_offset(
-         libvmdk_internal_handle_t *internal_handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libvmdk_handle_get_disk_type(
+     libvmdk_handle_t *handle,
+     int *disk_type,
+     libcerror_error_t **error )
 {
-	static char *function = "libvmdk_internal_handle_seek_offset";
+	libvmdk_internal_handle_t *internal_handle = NULL;
+	static char *function                      = "libvmdk_handle_get_disk_type";
 
-	if( internal_handle == NULL )
+	if( handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
@@ -3716,65 +10598,75 @@ off64_t libvmdk_internal_handle_seek_offset(
 
 		return( -1 );
 	}
-	if( internal_handle->io_handle == NULL )
+	internal_handle = (libvmdk_internal_handle_t *) handle;
+
+	if( internal_handle->descriptor_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
+		 "%s: invalid handle - missing descriptor file.",
 		 function );
 
 		return( -1 );
 	}
-	if( ( whence != SEEK_CUR )
-	 && ( whence != SEEK_END )
-	 && ( whence != SEEK_SET ) )
+	if( disk_type == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-		 "%s: unsupported whence.",
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid disk type.",
 		 function );
 
 		return( -1 );
 	}
-	if( whence == SEEK_CUR )
-	{
-		offset += internal_handle->current_offset;
-	}
-	else if( whence == SEEK_END )
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
-		offset += (off64_t) internal_handle->io_handle->media_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for reading.",
+		 function );
+
+		return( -1 );
 	}
-	if( offset < 0 )
+#endif
+	*disk_type = internal_handle->descriptor_file->disk_type;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_release_for_read(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: invalid offset value out of bounds.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle->current_offset = offset;
-
-	return( offset );
+#endif
+	return( 1 );
 }
 
-/* Seeks a certain offset of the (media) data
- * Returns the offset if seek is successful or -1 on error
+/* Retrieves the media size
+ * Returns 1 if successful or -1 on error
  */
-off64_t libvmdk_handle_seek_offset(
-         libvmdk_handle_t *handle,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int libvmdk_handle_get_media_size(
+     libvmdk_handle_t *handle,
+     size64_t *media_size,
+     libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_seek_offset";
+	static char *function                      = "libvmdk_handle_get_media_size";
 
 	if( handle == NULL )
 	{
@@ -3789,19 +10681,30 @@ off64_t libvmdk_handle_seek_offset(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( internal_handle->descriptor_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 "%s: invalid handle - missing descriptor file.",
+		 function );
+
+		return( -1 );
+	}
+	if( media_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid media size.",
 		 function );
 
 		return( -1 );
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3809,31 +10712,16 @@ off64_t libvmdk_handle_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	offset = libvmdk_internal_handle_seek_offset(
-	          internal_handle,
-	          offset,
-	          whence,
-	          error );
-
-	if( offset == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset.",
-		 function );
+	*media_size = internal_handle->descriptor_file->media_size;
 
-		offset = -1;
-	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3841,25 +10729,25 @@ off64_t libvmdk_handle_seek_offset(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( offset );
+	return( 1 );
 }
 
-/* Retrieves the current offset of the (media) data
+/* Retrieves the content identifier
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_get_offset(
+int libvmdk_handle_get_content_identifier(
      libvmdk_handle_t *handle,
-     off64_t *offset,
+     uint32_t *content_identifier,
      libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_offset";
+	static char *function                      = "libvmdk_handle_get_content_identifier";
 
 	if( handle == NULL )
 	{
@@ -3874,35 +10762,24 @@ int libvmdk_handle_get_offset(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->io_handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing IO handle.",
-		 function );
-
-		return( -1 );
-	}
-	if( internal_handle->extent_data_file_io_pool == NULL )
+	if( internal_handle->descriptor_file == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing extent data file IO pool.",
+		 "%s: invalid handle - missing descriptor file.",
 		 function );
 
 		return( -1 );
 	}
-	if( offset == NULL )
+	if( content_identifier == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid offset.",
+		 "%s: invalid content identifier.",
 		 function );
 
 		return( -1 );
@@ -3922,7 +10799,7 @@ int libvmdk_handle_get_offset(
 		return( -1 );
 	}
 #endif
-	*offset = internal_handle->current_offset;
+	*content_identifier = internal_handle->descriptor_file->content_identifier;
 
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
@@ -3942,17 +10819,17 @@ int libvmdk_handle_get_offset(
 	return( 1 );
 }
 
-/* Sets the maximum number of (concurrent) open file handles
- * Returns 1 if successful or -1 on error
+/* Retrieves the parent content identifier
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libvmdk_handle_set_maximum_number_of_open_handles(
+int libvmdk_handle_get_parent_content_identifier(
      libvmdk_handle_t *handle,
-     int maximum_number_of_open_handles,
+     uint32_t *parent_content_identifier,
      libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_set_maximum_number_of_open_handles";
-	int result                                 = 1;
+	static char *function                      = "libvmdk_handle_get_parent_content_identifier";
+	int result                                 = 0;
 
 	if( handle == NULL )
 	{
@@ -3968,7 +10845,7 @@ int libvmdk_handle_set_maximum_number_of_open_handles(
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -3976,35 +10853,30 @@ int libvmdk_handle_set_maximum_number_of_open_handles(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( internal_handle->extent_data_file_io_pool != NULL )
-	{
-		result = libbfio_pool_set_maximum_number_of_open_handles(
-		          internal_handle->extent_data_file_io_pool,
-		          maximum_number_of_open_handles,
-		          error );
+	result = libvmdk_descriptor_file_get_parent_content_identifier(
+	          internal_handle->descriptor_file,
+	          parent_content_identifier,
+	          error );
 
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set maximum number of open handles in extent data file IO pool.",
-			 function );
-		}
-	}
-	if( result == 1 )
+	if( result == -1 )
 	{
-		internal_handle->maximum_number_of_open_handles = maximum_number_of_open_handles;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4012,26 +10884,35 @@ int libvmdk_handle_set_maximum_number_of_open_handles(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( result );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Sets the parent handle
- * Returns 1 if successful or -1 on error
+/* Retrieves the size of the UTF-8 encoded parent filename
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libvmdk_handle_set_parent_handle(
+int libvmdk_handle_get_utf8_parent_filename_size(
      libvmdk_handle_t *handle,
-     libvmdk_handle_t *parent_handle,
+     size_t *utf8_string_size,
      libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_set_parent_handle";
-	uint32_t content_identifier                = 0;
+	static char *function                      = "libvmdk_handle_get_utf8_parent_filename_size";
+	int result                                 = 0;
 
 	if( handle == NULL )
 	{
@@ -4046,19 +10927,8 @@ int libvmdk_handle_set_parent_handle(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->descriptor_file == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4066,41 +10936,30 @@ int libvmdk_handle_set_parent_handle(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libvmdk_handle_get_content_identifier(
-	     parent_handle,
-	     &content_identifier,
-	     error ) != 1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve content identifier from parent handle.",
-		 function );
+	result = libvmdk_descriptor_file_get_utf8_parent_filename_size(
+	          internal_handle->descriptor_file,
+	          utf8_string_size,
+	          error );
 
-		goto on_error;
-	}
-	if( content_identifier != internal_handle->descriptor_file->parent_content_identifier )
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: mismatch in content identifier.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 parent filename size.",
 		 function );
 
 		goto on_error;
 	}
-	internal_handle->parent_handle = parent_handle;
-
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4108,35 +10967,36 @@ int libvmdk_handle_set_parent_handle(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
 
 on_error:
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_write(
+	libcthreads_read_write_lock_release_for_read(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Sets the path to the extend data files
- * Returns 1 if successful or -1 on error
+/* Retrieves the UTF-8 encoded parent filename
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libvmdk_handle_set_extent_data_files_path(
+int libvmdk_handle_get_utf8_parent_filename(
      libvmdk_handle_t *handle,
-     const char *path,
-     size_t path_length,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
      libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_set_extent_data_files_path";
-	int result                                 = 1;
+	static char *function                      = "libvmdk_handle_get_utf8_parent_filename";
+	int result                                 = 0;
 
 	if( handle == NULL )
 	{
@@ -4151,30 +11011,8 @@ int libvmdk_handle_set_extent_data_files_path(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( path == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid path.",
-		 function );
-
-		return( -1 );
-	}
-	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid path length value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4182,29 +11020,31 @@ int libvmdk_handle_set_extent_data_files_path(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libvmdk_extent_table_set_data_files_path(
-	     internal_handle->extent_table,
-	     path,
-	     path_length,
-	     error ) != 1 )
+	result = libvmdk_descriptor_file_get_utf8_parent_filename(
+	          internal_handle->descriptor_file,
+	          utf8_string,
+	          utf8_string_size,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data files path in extent table.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-8 parent filename.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4212,29 +11052,35 @@ int libvmdk_handle_set_extent_data_files_path(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( result );
-}
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
 
-/* Sets the path to the extend data files
- * Returns 1 if successful or -1 on error
+/* Retrieves the size of the UTF-16 encoded parent filename
+ * The returned size includes the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libvmdk_handle_set_extent_data_files_path_wide(
+int libvmdk_handle_get_utf16_parent_filename_size(
      libvmdk_handle_t *handle,
-     const wchar_t *path,
-     size_t path_length,
+     size_t *utf16_string_size,
      libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_set_extent_data_files_path_wide";
-	int result                                 = 1;
+	static char *function                      = "libvmdk_handle_get_utf16_parent_filename_size";
+	int result                                 = 0;
 
 	if( handle == NULL )
 	{
@@ -4249,30 +11095,8 @@ int libvmdk_handle_set_extent_data_files_path_wide(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( path == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid path.",
-		 function );
-
-		return( -1 );
-	}
-	if( path_length > (size_t) ( SSIZE_MAX - 1 ) )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid path length value exceeds maximum.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_write(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4280,29 +11104,30 @@ int libvmdk_handle_set_extent_data_files_path_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for writing.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	if( libvmdk_extent_table_set_data_files_path_wide(
-	     internal_handle->extent_table,
-	     path,
-	     path_length,
-	     error ) != 1 )
+	result = libvmdk_descriptor_file_get_utf16_parent_filename_size(
+	          internal_handle->descriptor_file,
+	          utf16_string_size,
+	          error );
+
+	if( result == -1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to set data files path in extent table.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 parent filename size.",
 		 function );
 
-		result = -1;
+		goto on_error;
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_write(
+	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4310,27 +11135,36 @@ int libvmdk_handle_set_extent_data_files_path_wide(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for writing.",
+		 "%s: unable to release read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
 	return( result );
-}
 
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
+}
 
-/* Retrieves the disk type
- * Returns 1 if successful or -1 on error
+/* Retrieves the UTF-16 encoded parent filename
+ * The size should include the end of string character
+ * Returns 1 if successful, 0 if not available or -1 on error
  */
-int libvmdk_handle_get_disk_type(
+int libvmdk_handle_get_utf16_parent_filename(
      libvmdk_handle_t *handle,
-     int *disk_type,
+     uint16_t *utf16_string,
+     size_t utf16_string_size,
      libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_disk_type";
+	static char *function                      = "libvmdk_handle_get_utf16_parent_filename";
+	int result                                 = 0;
 
 	if( handle == NULL )
 	{
@@ -4345,28 +11179,6 @@ int libvmdk_handle_get_disk_type(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->descriptor_file == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
-		 function );
-
-		return( -1 );
-	}
-	if( disk_type == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid disk type.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -4382,8 +11194,23 @@ int libvmdk_handle_get_disk_type(
 		return( -1 );
 	}
 #endif
-	*disk_type = internal_handle->descriptor_file->disk_type;
+	result = libvmdk_descriptor_file_get_utf16_parent_filename(
+	          internal_handle->descriptor_file,
+	          utf16_string,
+	          utf16_string_size,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve UTF-16 parent filename.",
+		 function );
 
+		goto on_error;
+	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -4399,19 +11226,27 @@ int libvmdk_handle_get_disk_type(
 		return( -1 );
 	}
 #endif
-	return( 1 );
+	return( result );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the media size
+/* Retrieves the number of extents
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_get_media_size(
+int libvmdk_handle_get_number_of_extents(
      libvmdk_handle_t *handle,
-     size64_t *media_size,
+     int *number_of_extents,
      libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_media_size";
+	static char *function                      = "libvmdk_handle_get_number_of_extents";
 
 	if( handle == NULL )
 	{
@@ -4437,17 +11272,6 @@ int libvmdk_handle_get_media_size(
 
 		return( -1 );
 	}
-	if( media_size == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid media size.",
-		 function );
-
-		return( -1 );
-	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
@@ -4463,8 +11287,20 @@ int libvmdk_handle_get_media_size(
 		return( -1 );
 	}
 #endif
-	*media_size = internal_handle->descriptor_file->media_size;
+	if( libvmdk_descriptor_file_get_number_of_extents(
+	     internal_handle->descriptor_file,
+	     number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
 
+		goto on_error;
+	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	if( libcthreads_read_write_lock_release_for_read(
 	     internal_handle->read_write_lock,
@@ -4481,18 +11317,27 @@ int libvmdk_handle_get_media_size(
 	}
 #endif
 	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	libcthreads_read_write_lock_release_for_read(
+	 internal_handle->read_write_lock,
+	 NULL );
+#endif
+	return( -1 );
 }
 
-/* Retrieves the content identifier
+/* Retrieves a specific extent descriptor
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_get_content_identifier(
+int libvmdk_handle_get_extent_descriptor(
      libvmdk_handle_t *handle,
-     uint32_t *content_identifier,
+     int extent_index,
+     libvmdk_extent_descriptor_t **extent_descriptor,
      libcerror_error_t **error )
 {
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_content_identifier";
+	static char *function                      = "libvmdk_handle_get_extent_descriptor";
 
 	if( handle == NULL )
 	{
@@ -4518,36 +11363,30 @@ int libvmdk_handle_get_content_identifier(
 
 		return( -1 );
 	}
-	if( content_identifier == NULL )
+	if( extent_descriptor == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid content identifier.",
+		 "%s: invalid extent descriptor.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( *extent_descriptor != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid extent descriptor value already set.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	*content_identifier = internal_handle->descriptor_file->content_identifier;
-
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_grab_for_read(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4555,68 +11394,37 @@ int libvmdk_handle_get_content_identifier(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to grab read/write lock for reading.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	return( 1 );
-}
-
-/* Retrieves the parent content identifier
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libvmdk_handle_get_parent_content_identifier(
-     libvmdk_handle_t *handle,
-     uint32_t *parent_content_identifier,
-     libcerror_error_t **error )
-{
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_parent_content_identifier";
-	int result                                 = 0;
-
-	if( handle == NULL )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
-		 function );
-
-		return( -1 );
-	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
-
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
+	if( libvmdk_descriptor_file_get_extent_by_index(
+	     internal_handle->descriptor_file,
+	     extent_index,
+	     (libvmdk_internal_extent_descriptor_t **) extent_descriptor,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve extent: %d from descriptor file.",
+		 function,
+		 extent_index );
 
-		return( -1 );
+		goto on_error;
 	}
-#endif
-	result = libvmdk_descriptor_file_get_parent_content_identifier(
-	          internal_handle->descriptor_file,
-	          parent_content_identifier,
-	          error );
-
-	if( result == -1 )
+	if( *extent_descriptor == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve parent content identifier.",
-		 function );
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing extent descriptor: %d.",
+		 function,
+		 extent_index );
 
 		goto on_error;
 	}
@@ -4635,7 +11443,7 @@ int libvmdk_handle_get_parent_content_identifier(
 		return( -1 );
 	}
 #endif
-	return( result );
+	return( 1 );
 
 on_error:
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
@@ -4646,18 +11454,24 @@ on_error:
 	return( -1 );
 }
 
-/* Retrieves the size of the UTF-8 encoded parent filename
- * The returned size includes the end of string character
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Retrieves the allocation values of a specific extent
+ * The values are determined from the grain directory and grain tables without reading grain data,
+ * are indexed by the LIBVMDK_ALLOCATION_VALUE definitions and the values must contain
+ * LIBVMDK_NUMBER_OF_ALLOCATION_VALUES values
+ * Returns 1 if successful, 0 if the extent has no grain tables or -1 on error
  */
-int libvmdk_handle_get_utf8_parent_filename_size(
+int libvmdk_handle_get_extent_allocation_values(
      libvmdk_handle_t *handle,
-     size_t *utf8_string_size,
+     int extent_index,
+     uint64_t *values,
+     int number_of_values,
      libcerror_error_t **error )
 {
+	libvmdk_extent_file_t *extent_file         = NULL;
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_utf8_parent_filename_size";
-	int result                                 = 0;
+	static char *function                      = "libvmdk_handle_get_extent_allocation_values";
+	int number_of_extents                      = 0;
+	int result                                 = 1;
 
 	if( handle == NULL )
 	{
@@ -4672,92 +11486,66 @@ int libvmdk_handle_get_utf8_parent_filename_size(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->extent_data_file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = libvmdk_descriptor_file_get_utf8_parent_filename_size(
-	          internal_handle->descriptor_file,
-	          utf8_string_size,
-	          error );
-
-	if( result == -1 )
+	if( internal_handle->extent_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 parent filename size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent table.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( values == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
-
-on_error:
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Retrieves the UTF-8 encoded parent filename
- * The size should include the end of string character
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libvmdk_handle_get_utf8_parent_filename(
-     libvmdk_handle_t *handle,
-     uint8_t *utf8_string,
-     size_t utf8_string_size,
-     libcerror_error_t **error )
-{
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_utf8_parent_filename";
-	int result                                 = 0;
-
-	if( handle == NULL )
+	if( number_of_values != LIBVMDK_NUMBER_OF_ALLOCATION_VALUES )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of values value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
+	if( memory_set(
+	     values,
+	     0,
+	     sizeof( uint64_t ) * LIBVMDK_NUMBER_OF_ALLOCATION_VALUES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear values.",
+		 function );
 
+		return( -1 );
+	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4765,31 +11553,82 @@ int libvmdk_handle_get_utf8_parent_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libvmdk_descriptor_file_get_utf8_parent_filename(
-	          internal_handle->descriptor_file,
-	          utf8_string,
-	          utf8_string_size,
-	          error );
+	/* Flat extents have no grain directory and grain tables
+	 */
+	if( internal_handle->extent_table->extent_files_stream != NULL )
+	{
+		result = 0;
+	}
+	else
+	{
+		if( libvmdk_extent_table_get_number_of_extents(
+		     internal_handle->extent_table,
+		     &number_of_extents,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of extents.",
+			 function );
+
+			goto on_error;
+		}
+		if( ( extent_index < 0 )
+		 || ( extent_index >= number_of_extents ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent index value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_table_get_extent_file_by_index(
+		     internal_handle->extent_table,
+		     extent_index,
+		     internal_handle->extent_data_file_io_pool,
+		     &extent_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent file: %d.",
+			 function,
+			 extent_index );
 
-	if( result == -1 )
-	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-8 parent filename.",
-		 function );
+			goto on_error;
+		}
+		if( libvmdk_extent_file_get_allocation_values(
+		     extent_file,
+		     internal_handle->extent_data_file_io_pool,
+		     values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve allocation values of extent file: %d.",
+			 function,
+			 extent_index );
 
-		goto on_error;
+			goto on_error;
+		}
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4797,7 +11636,7 @@ int libvmdk_handle_get_utf8_parent_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -4807,25 +11646,36 @@ int libvmdk_handle_get_utf8_parent_filename(
 
 on_error:
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Retrieves the size of the UTF-16 encoded parent filename
- * The returned size includes the end of string character
- * Returns 1 if successful, 0 if not available or -1 on error
+/* Verifies the integrity of a specific extent
+ * The grain directory is compared with its backup, the grain tables and grains are checked
+ * against the extent file size and for overlap and, if LIBVMDK_VERIFICATION_FLAG_DECOMPRESS_GRAINS
+ * is set, the compressed grains are decompressed using number_of_threads decompression threads
+ * Grain groups that fail verification are marked as tainted or corrupted
+ * The values are indexed by the LIBVMDK_VERIFICATION_VALUE definitions
+ * Returns 1 if successful, 0 if the extent has no grain tables or -1 on error
  */
-int libvmdk_handle_get_utf16_parent_filename_size(
+int libvmdk_handle_verify_extent(
      libvmdk_handle_t *handle,
-     size_t *utf16_string_size,
+     int extent_index,
+     uint8_t verification_flags,
+     int number_of_threads,
+     uint64_t *values,
+     int number_of_values,
      libcerror_error_t **error )
 {
+	libvmdk_extent_file_t *extent_file         = NULL;
+	libvmdk_grain_verifier_t *grain_verifier   = NULL;
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_utf16_parent_filename_size";
-	int result                                 = 0;
+	static char *function                      = "libvmdk_handle_verify_extent";
+	int number_of_extents                      = 0;
+	int result                                 = 1;
 
 	if( handle == NULL )
 	{
@@ -4840,92 +11690,103 @@ int libvmdk_handle_get_utf16_parent_filename_size(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->extent_data_file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	result = libvmdk_descriptor_file_get_utf16_parent_filename_size(
-	          internal_handle->descriptor_file,
-	          utf16_string_size,
-	          error );
-
-	if( result == -1 )
+	if( internal_handle->extent_table == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 parent filename size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent table.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( ( verification_flags & ~( LIBVMDK_VERIFICATION_FLAG_DECOMPRESS_GRAINS ) ) != 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported verification flags: 0x%02" PRIx8 ".",
+		 function,
+		 verification_flags );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBVMDK_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( result );
+#if !defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
 
-on_error:
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
-	 internal_handle->read_write_lock,
-	 NULL );
+		return( -1 );
+	}
 #endif
-	return( -1 );
-}
-
-/* Retrieves the UTF-16 encoded parent filename
- * The size should include the end of string character
- * Returns 1 if successful, 0 if not available or -1 on error
- */
-int libvmdk_handle_get_utf16_parent_filename(
-     libvmdk_handle_t *handle,
-     uint16_t *utf16_string,
-     size_t utf16_string_size,
-     libcerror_error_t **error )
-{
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_utf16_parent_filename";
-	int result                                 = 0;
-
-	if( handle == NULL )
+	if( values == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid values.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
+	if( number_of_values != LIBVMDK_NUMBER_OF_VERIFICATION_VALUES )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of values value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     values,
+	     0,
+	     sizeof( uint64_t ) * LIBVMDK_NUMBER_OF_VERIFICATION_VALUES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear values.",
+		 function );
 
+		return( -1 );
+	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_grab_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4933,31 +11794,152 @@ int libvmdk_handle_get_utf16_parent_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
 		return( -1 );
 	}
 #endif
-	result = libvmdk_descriptor_file_get_utf16_parent_filename(
-	          internal_handle->descriptor_file,
-	          utf16_string,
-	          utf16_string_size,
-	          error );
-
-	if( result == -1 )
+	/* Flat extents have no grain directory and grain tables
+	 */
+	if( internal_handle->extent_table->extent_files_stream != NULL )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve UTF-16 parent filename.",
-		 function );
+		result = 0;
+	}
+	else
+	{
+		if( libvmdk_extent_table_get_number_of_extents(
+		     internal_handle->extent_table,
+		     &number_of_extents,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of extents.",
+			 function );
 
-		goto on_error;
+			goto on_error;
+		}
+		if( ( extent_index < 0 )
+		 || ( extent_index >= number_of_extents ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid extent index value out of bounds.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_table_get_extent_file_by_index(
+		     internal_handle->extent_table,
+		     extent_index,
+		     internal_handle->extent_data_file_io_pool,
+		     &extent_file,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent file: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		/* The extent data file IO pool entry of an extent file is its extent index
+		 */
+		if( libvmdk_extent_file_verify_grain_directories(
+		     extent_file,
+		     internal_handle->extent_data_file_io_pool,
+		     extent_index,
+		     values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify grain directories of extent file: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_file_verify_grains(
+		     extent_file,
+		     internal_handle->extent_data_file_io_pool,
+		     extent_index,
+		     values,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify grains of extent file: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( ( ( verification_flags & LIBVMDK_VERIFICATION_FLAG_DECOMPRESS_GRAINS ) != 0 )
+		 && ( ( extent_file->flags & LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION ) != 0 ) )
+		{
+			if( libvmdk_grain_verifier_initialize(
+			     &grain_verifier,
+			     extent_file->grain_size,
+			     number_of_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create grain verifier.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_grain_verifier_verify_extent_file(
+			     grain_verifier,
+			     extent_file,
+			     internal_handle->extent_data_file_io_pool,
+			     extent_index,
+			     values,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GENERIC,
+				 "%s: unable to verify compressed grains of extent file: %d.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			if( libvmdk_grain_verifier_free(
+			     &grain_verifier,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free grain verifier.",
+				 function );
+
+				goto on_error;
+			}
+		}
 	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -4965,7 +11947,7 @@ int libvmdk_handle_get_utf16_parent_filename(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
 		return( -1 );
@@ -4974,24 +11956,51 @@ int libvmdk_handle_get_utf16_parent_filename(
 	return( result );
 
 on_error:
+	if( grain_verifier != NULL )
+	{
+		libvmdk_grain_verifier_free(
+		 &grain_verifier,
+		 NULL );
+	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
 	return( -1 );
 }
 
-/* Retrieves the number of extents
+/* Calculates the SHA-256 digests of the (media) data per chunk and the root digest
+ * The chunks are read sequentially in the calling thread and hashed by the hashing threads
+ * Chunks that are sparse or only contain 0-byte values are not read but get the digest of 0-byte values
  * Returns 1 if successful or -1 on error
  */
-int libvmdk_handle_get_number_of_extents(
+int libvmdk_handle_calculate_chunk_digests(
      libvmdk_handle_t *handle,
-     int *number_of_extents,
+     size32_t chunk_size,
+     int number_of_threads,
+     uint8_t *chunk_digests,
+     size_t chunk_digests_size,
+     uint8_t *root_digest,
+     size_t root_digest_size,
      libcerror_error_t **error )
 {
+	uint8_t zero_chunk_digest[ LIBVMDK_SHA256_DIGEST_SIZE ];
+
+	libvmdk_chunk_hasher_t *chunk_hasher       = NULL;
 	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_number_of_extents";
+	uint8_t *chunk_data                        = NULL;
+	static char *function                      = "libvmdk_handle_calculate_chunk_digests";
+	size64_t chunk_data_size                   = 0;
+	size64_t range_size                        = 0;
+	ssize_t read_count                         = 0;
+	off64_t chunk_offset                       = 0;
+	off64_t range_offset                       = 0;
+	uint64_t chunk_index                       = 0;
+	uint64_t number_of_chunks                  = 0;
+	uint32_t range_flags                       = 0;
+	int chunk_is_zero                          = 0;
+	int result                                 = 0;
 
 	if( handle == NULL )
 	{
@@ -5006,132 +12015,316 @@ int libvmdk_handle_get_number_of_extents(
 	}
 	internal_handle = (libvmdk_internal_handle_t *) handle;
 
-	if( internal_handle->descriptor_file == NULL )
+	if( internal_handle->io_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
+		 "%s: invalid handle - missing IO handle.",
 		 function );
 
 		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( internal_handle->extent_data_file_io_pool == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid handle - missing extent data file IO pool.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	if( libvmdk_descriptor_file_get_number_of_extents(
-	     internal_handle->descriptor_file,
-	     number_of_extents,
-	     error ) != 1 )
+	if( chunk_size == 0 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of extents.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_ZERO_OR_LESS,
+		 "%s: invalid chunk size value zero or less.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
-	     error ) != 1 )
+	if( chunk_digests == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid chunk digests.",
 		 function );
 
 		return( -1 );
 	}
-#endif
-	return( 1 );
-
-on_error:
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
-	 internal_handle->read_write_lock,
-	 NULL );
-#endif
-	return( -1 );
-}
-
-/* Retrieves a specific extent descriptor
- * Returns 1 if successful or -1 on error
- */
-int libvmdk_handle_get_extent_descriptor(
-     libvmdk_handle_t *handle,
-     int extent_index,
-     libvmdk_extent_descriptor_t **extent_descriptor,
-     libcerror_error_t **error )
-{
-	libvmdk_internal_handle_t *internal_handle = NULL;
-	static char *function                      = "libvmdk_handle_get_extent_descriptor";
+	if( chunk_digests_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid chunk digests size value exceeds maximum.",
+		 function );
 
-	if( handle == NULL )
+		return( -1 );
+	}
+	if( root_digest == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid handle.",
+		 "%s: invalid root digest.",
 		 function );
 
 		return( -1 );
 	}
-	internal_handle = (libvmdk_internal_handle_t *) handle;
+	if( root_digest_size < LIBVMDK_SHA256_DIGEST_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid root digest size value too small.",
+		 function );
 
-	if( internal_handle->descriptor_file == NULL )
+		return( -1 );
+	}
+	number_of_chunks = internal_handle->io_handle->media_size / chunk_size;
+
+	if( ( internal_handle->io_handle->media_size % chunk_size ) != 0 )
+	{
+		number_of_chunks += 1;
+	}
+	if( number_of_chunks > (uint64_t) ( chunk_digests_size / LIBVMDK_SHA256_DIGEST_SIZE ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid chunk digests size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_sha256_calculate_zero_digest(
+	     (size64_t) chunk_size,
+	     zero_chunk_digest,
+	     LIBVMDK_SHA256_DIGEST_SIZE,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: invalid handle - missing descriptor file.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate digest of zero chunk.",
 		 function );
 
 		return( -1 );
 	}
-	if( extent_descriptor == NULL )
+	if( libvmdk_chunk_hasher_initialize(
+	     &chunk_hasher,
+	     (size_t) chunk_size,
+	     number_of_threads,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid extent descriptor.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create chunk hasher.",
 		 function );
 
 		return( -1 );
 	}
-	if( *extent_descriptor != NULL )
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( libcthreads_read_write_lock_grab_for_write(
+	     internal_handle->read_write_lock,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
-		 "%s: invalid extent descriptor value already set.",
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to grab read/write lock for writing.",
 		 function );
 
+		libvmdk_chunk_hasher_free(
+		 &chunk_hasher,
+		 NULL );
+
 		return( -1 );
 	}
+#endif
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		if( internal_handle->io_handle->abort != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_ABORT_REQUESTED,
+			 "%s: abort requested.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_data_size = internal_handle->io_handle->media_size - (size64_t) chunk_offset;
+
+		if( chunk_data_size > (size64_t) chunk_size )
+		{
+			chunk_data_size = (size64_t) chunk_size;
+		}
+		/* The chunk only contains 0-byte values if all of its ranges are sparse or zero
+		 */
+		chunk_is_zero = 1;
+		range_offset  = chunk_offset;
+
+		while( range_offset < (off64_t) ( chunk_offset + chunk_data_size ) )
+		{
+			result = libvmdk_internal_handle_get_data_range_at_offset(
+			          internal_handle,
+			          internal_handle->extent_data_file_io_pool,
+			          range_offset,
+			          (size64_t) ( chunk_offset + chunk_data_size - range_offset ),
+			          &range_size,
+			          &range_flags,
+			          error );
+
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve data range at offset: %" PRIi64 ".",
+				 function,
+				 range_offset );
+
+				goto on_error;
+			}
+			if( ( range_flags & ( LIBVMDK_RANGE_FLAG_IS_SPARSE | LIBVMDK_RANGE_FLAG_IS_ZERO ) ) == 0 )
+			{
+				chunk_is_zero = 0;
+
+				break;
+			}
+			range_offset += (off64_t) range_size;
+		}
+		if( chunk_is_zero != 0 )
+		{
+			if( chunk_data_size < (size64_t) chunk_size )
+			{
+				if( libvmdk_sha256_calculate_zero_digest(
+				     chunk_data_size,
+				     &( chunk_digests[ chunk_index * LIBVMDK_SHA256_DIGEST_SIZE ] ),
+				     LIBVMDK_SHA256_DIGEST_SIZE,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to calculate digest of zero chunk: %" PRIu64 ".",
+					 function,
+					 chunk_index );
+
+					goto on_error;
+				}
+			}
+			else if( memory_copy(
+			          &( chunk_digests[ chunk_index * LIBVMDK_SHA256_DIGEST_SIZE ] ),
+			          zero_chunk_digest,
+			          LIBVMDK_SHA256_DIGEST_SIZE ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+				 "%s: unable to copy digest of zero chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			if( libvmdk_chunk_hasher_get_chunk_data(
+			     chunk_hasher,
+			     &chunk_data,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve data of chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			if( libvmdk_internal_handle_seek_offset(
+			     internal_handle,
+			     chunk_offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek chunk offset: %" PRIi64 ".",
+				 function,
+				 chunk_offset );
+
+				goto on_error;
+			}
+			read_count = libvmdk_internal_handle_read_buffer_from_file_io_pool(
+			              internal_handle,
+			              internal_handle->extent_data_file_io_pool,
+			              chunk_data,
+			              (size_t) chunk_data_size,
+			              error );
+
+			if( read_count != (ssize_t) chunk_data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+			if( libvmdk_chunk_hasher_submit_chunk(
+			     chunk_hasher,
+			     (size_t) chunk_data_size,
+			     &( chunk_digests[ chunk_index * LIBVMDK_SHA256_DIGEST_SIZE ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to submit chunk: %" PRIu64 ".",
+				 function,
+				 chunk_index );
+
+				goto on_error;
+			}
+		}
+		chunk_offset += (off64_t) chunk_data_size;
+	}
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_grab_for_read(
+	if( libcthreads_read_write_lock_release_for_write(
 	     internal_handle->read_write_lock,
 	     error ) != 1 )
 	{
@@ -5139,63 +12332,78 @@ int libvmdk_handle_get_extent_descriptor(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to grab read/write lock for reading.",
+		 "%s: unable to release read/write lock for writing.",
 		 function );
 
+		libvmdk_chunk_hasher_free(
+		 &chunk_hasher,
+		 NULL );
+
 		return( -1 );
 	}
 #endif
-	if( libvmdk_descriptor_file_get_extent_by_index(
-	     internal_handle->descriptor_file,
-	     extent_index,
-	     (libvmdk_internal_extent_descriptor_t **) extent_descriptor,
+	if( libvmdk_chunk_hasher_flush(
+	     chunk_hasher,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve extent: %d from descriptor file.",
-		 function,
-		 extent_index );
+		 "%s: unable to flush chunk hasher.",
+		 function );
 
-		goto on_error;
+		libvmdk_chunk_hasher_free(
+		 &chunk_hasher,
+		 NULL );
+
+		return( -1 );
 	}
-	if( *extent_descriptor == NULL )
+	if( libvmdk_chunk_hasher_free(
+	     &chunk_hasher,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing extent descriptor: %d.",
-		 function,
-		 extent_index );
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free chunk hasher.",
+		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	if( libcthreads_read_write_lock_release_for_read(
-	     internal_handle->read_write_lock,
+	/* The root digest is calculated over the chunk digests in chunk order
+	 */
+	if( libvmdk_sha256_calculate_digest(
+	     chunk_digests,
+	     (size_t) ( number_of_chunks * LIBVMDK_SHA256_DIGEST_SIZE ),
+	     root_digest,
+	     root_digest_size,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-		 "%s: unable to release read/write lock for reading.",
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate root digest.",
 		 function );
 
 		return( -1 );
 	}
-#endif
 	return( 1 );
 
 on_error:
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
-	libcthreads_read_write_lock_release_for_read(
+	libcthreads_read_write_lock_release_for_write(
 	 internal_handle->read_write_lock,
 	 NULL );
 #endif
+	if( chunk_hasher != NULL )
+	{
+		libvmdk_chunk_hasher_free(
+		 &chunk_hasher,
+		 NULL );
+	}
 	return( -1 );
 }
 
@@ -25,6 +25,8 @@
 #include <common.h>
 #include <types.h>
 
+#include "libvmdk_cache_pool.h"
+#include "libvmdk_change_tracking_file.h"
 #include "libvmdk_descriptor_file.h"
 #include "libvmdk_extent_table.h"
 #include "libvmdk_extern.h"
@@ -35,6 +37,7 @@
 #include "libvmdk_libcthreads.h"
 #include "libvmdk_libfcache.h"
 #include "libvmdk_libfdata.h"
+#include "libvmdk_write_io_handle.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -64,10 +67,22 @@ struct libvmdk_internal_handle
 	 */
 	libfcache_cache_t *grains_cache;
 
+	/* The cache pool
+	 */
+	libvmdk_cache_pool_t *cache_pool;
+
+	/* The identifier of the handle in the cache pool
+	 */
+	int cache_pool_handle_identifier;
+
 	/* The io handle
 	 */
 	libvmdk_io_handle_t *io_handle;
 
+	/* The write IO handle
+	 */
+	libvmdk_write_io_handle_t *write_io_handle;
+
 	/* The extent data file IO pool
 	 */
 	libbfio_pool_t *extent_data_file_io_pool;
@@ -84,10 +99,23 @@ struct libvmdk_internal_handle
 	 */
 	int maximum_number_of_open_handles;
 
+	/* The grain size used to create a sparse or delta disk
+	 */
+	size64_t create_grain_size;
+
 	/* The parent handle
 	 */
 	libvmdk_handle_t *parent_handle;
 
+	/* Value to indicate the data ranges should report allocated grains
+	 * that only contain 0-byte values
+	 */
+	uint8_t zero_detection;
+
+	/* The change tracking file
+	 */
+	libvmdk_change_tracking_file_t *change_tracking_file;
+
 #if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
 	/* The read/write lock
 	 */
@@ -135,6 +163,62 @@ int libvmdk_handle_open_file_io_handle(
      int access_flags,
      libcerror_error_t **error );
 
+LIBVMDK_EXTERN \
+int libvmdk_handle_create_child(
+     libvmdk_handle_t *handle,
+     const char *filename,
+     libvmdk_handle_t *parent_handle,
+     const char *parent_filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_create_child_wide(
+     libvmdk_handle_t *handle,
+     const wchar_t *filename,
+     libvmdk_handle_t *parent_handle,
+     const wchar_t *parent_filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_create_sparse(
+     libvmdk_handle_t *handle,
+     const char *filename,
+     size64_t media_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_create_sparse_wide(
+     libvmdk_handle_t *handle,
+     const wchar_t *filename,
+     size64_t media_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_create_split_sparse(
+     libvmdk_handle_t *handle,
+     const char *filename,
+     size64_t media_size,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_create_split_sparse_wide(
+     libvmdk_handle_t *handle,
+     const wchar_t *filename,
+     size64_t media_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
 LIBVMDK_EXTERN \
 int libvmdk_handle_open_extent_data_files(
      libvmdk_handle_t *handle,
@@ -146,6 +230,11 @@ int libvmdk_handle_open_extent_data_files_file_io_pool(
      libbfio_pool_t *file_io_pool,
      libcerror_error_t **error );
 
+LIBVMDK_EXTERN \
+int libvmdk_handle_open_change_tracking_file(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error );
+
 int libvmdk_handle_open_extent_data_file(
      libvmdk_internal_handle_t *internal_handle,
      libbfio_pool_t *file_io_pool,
@@ -176,9 +265,31 @@ int libvmdk_handle_open_read_grain_table(
 
 int libvmdk_handle_open_read_signature(
      libbfio_handle_t *file_io_handle,
+     libvmdk_statistics_t *statistics,
      uint8_t *file_type,
      libcerror_error_t **error );
 
+int libvmdk_internal_handle_grab_grains_cache(
+     libvmdk_internal_handle_t *internal_handle,
+     off64_t offset,
+     libfcache_cache_t **grains_cache,
+     int *partition_index,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_release_grains_cache(
+     libvmdk_internal_handle_t *internal_handle,
+     int partition_index,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_read_grain_data_buffer(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     uint64_t grain_index,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t read_size,
+     libcerror_error_t **error );
+
 ssize_t libvmdk_internal_handle_read_buffer_from_file_io_pool(
          libvmdk_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
@@ -201,12 +312,10 @@ ssize_t libvmdk_handle_read_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
-#ifdef TODO_WRITE_SUPPORT
-
 ssize_t libvmdk_internal_handle_write_buffer_to_file_io_pool(
          libvmdk_internal_handle_t *internal_handle,
          libbfio_pool_t *file_io_pool,
-         void *buffer,
+         const void *buffer,
          size_t buffer_size,
          libcerror_error_t **error );
 
@@ -225,7 +334,94 @@ ssize_t libvmdk_handle_write_buffer_at_offset(
          off64_t offset,
          libcerror_error_t **error );
 
-#endif /* TODO_WRITE_SUPPORT */
+int libvmdk_internal_handle_discard_from_file_io_pool(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_discard(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_flush(
+     libvmdk_handle_t *handle,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_grain_is_zero_at_offset(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libvmdk_internal_handle_get_data_range_at_offset(
+     libvmdk_internal_handle_t *internal_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     size64_t maximum_range_size,
+     size64_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_data_range_at_offset(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     size64_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libvmdk_handle_get_compare_range_at_offset(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     off64_t maximum_offset,
+     off64_t *range_end_offset,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int libvmdk_handle_read_compare_buffer_at_offset(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_next_changed_range(
+     libvmdk_handle_t *handle,
+     libvmdk_handle_t *other_handle,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_utf8_change_identifier_size(
+     libvmdk_handle_t *handle,
+     size_t *utf8_string_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_utf8_change_identifier(
+     libvmdk_handle_t *handle,
+     uint8_t *utf8_string,
+     size_t utf8_string_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_next_changed_block_range(
+     libvmdk_handle_t *handle,
+     const uint8_t *utf8_change_identifier,
+     size_t utf8_change_identifier_length,
+     off64_t offset,
+     off64_t *range_offset,
+     size64_t *range_size,
+     libcerror_error_t **error );
 
 off64_t libvmdk_internal_handle_seek_offset(
          libvmdk_internal_handle_t *internal_handle,
@@ -252,6 +448,65 @@ int libvmdk_handle_set_maximum_number_of_open_handles(
      int maximum_number_of_open_handles,
      libcerror_error_t **error );
 
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_grain_size(
+     libvmdk_handle_t *handle,
+     size64_t grain_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_zero_detection(
+     libvmdk_handle_t *handle,
+     uint8_t zero_detection,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_cache_pool(
+     libvmdk_handle_t *handle,
+     libvmdk_cache_pool_t *cache_pool,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_statistics_flags(
+     libvmdk_handle_t *handle,
+     uint8_t statistics_flags,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_statistics_value(
+     libvmdk_handle_t *handle,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_statistics_histogram(
+     libvmdk_handle_t *handle,
+     int histogram_type,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_open_phase_value(
+     libvmdk_handle_t *handle,
+     int open_phase,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_set_trace_callback(
+     libvmdk_handle_t *handle,
+     void (*trace_callback)(
+            int trace_phase,
+            int trace_event,
+            uint64_t timestamp,
+            uint64_t size,
+            void *callback_data ),
+     void *callback_data,
+     libcerror_error_t **error );
+
 LIBVMDK_EXTERN \
 int libvmdk_handle_set_parent_handle(
      libvmdk_handle_t *handle,
@@ -339,6 +594,35 @@ int libvmdk_handle_get_extent_descriptor(
      libvmdk_extent_descriptor_t **extent_descriptor,
      libcerror_error_t **error );
 
+LIBVMDK_EXTERN \
+int libvmdk_handle_get_extent_allocation_values(
+     libvmdk_handle_t *handle,
+     int extent_index,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_verify_extent(
+     libvmdk_handle_t *handle,
+     int extent_index,
+     uint8_t verification_flags,
+     int number_of_threads,
+     uint64_t *values,
+     int number_of_values,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_handle_calculate_chunk_digests(
+     libvmdk_handle_t *handle,
+     size32_t chunk_size,
+     int number_of_threads,
+     uint8_t *chunk_digests,
+     size_t chunk_digests_size,
+     uint8_t *root_digest,
+     size_t root_digest_size,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
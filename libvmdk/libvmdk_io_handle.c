@@ -30,6 +30,7 @@
 #include "libvmdk_libbfio.h"
 #include "libvmdk_libcerror.h"
 #include "libvmdk_libcnotify.h"
+#include "libvmdk_statistics.h"
 
 /* Creates an IO handle
  * Make sure the value io_handle is referencing, is set to NULL
@@ -141,7 +142,16 @@ int libvmdk_io_handle_clear(
      libvmdk_io_handle_t *io_handle,
      libcerror_error_t **error )
 {
-	static char *function = "libvmdk_io_handle_clear";
+	void (*trace_callback)(
+	       int trace_phase,
+	       int trace_event,
+	       uint64_t timestamp,
+	       uint64_t size,
+	       void *callback_data ) = NULL;
+
+	void *trace_callback_data     = NULL;
+	static char *function         = "libvmdk_io_handle_clear";
+	uint8_t statistics_flags      = 0;
 
 	if( io_handle == NULL )
 	{
@@ -154,6 +164,13 @@ int libvmdk_io_handle_clear(
 
 		return( -1 );
 	}
+	/* The trace callback and statistics flags are set on the handle and are retained
+	 * when the handle is closed
+	 */
+	trace_callback      = io_handle->trace_callback;
+	trace_callback_data = io_handle->trace_callback_data;
+	statistics_flags    = io_handle->statistics.flags;
+
 	if( memory_set(
 	     io_handle,
 	     0,
@@ -168,6 +185,39 @@ int libvmdk_io_handle_clear(
 
 		return( -1 );
 	}
+	io_handle->trace_callback      = trace_callback;
+	io_handle->trace_callback_data = trace_callback_data;
+	io_handle->statistics.flags    = statistics_flags;
+
 	return( 1 );
 }
 
+/* Invokes the trace callback with the current timestamp
+ * The timestamp is 0 if no monotonic clock is available
+ */
+void libvmdk_io_handle_trace(
+      libvmdk_io_handle_t *io_handle,
+      int trace_phase,
+      int trace_event,
+      uint64_t size )
+{
+	uint64_t timestamp = 0;
+
+	if( ( io_handle == NULL )
+	 || ( io_handle->trace_callback == NULL ) )
+	{
+		return;
+	}
+	if( libvmdk_statistics_get_timestamp(
+	     &timestamp ) != 1 )
+	{
+		timestamp = 0;
+	}
+	io_handle->trace_callback(
+	 trace_phase,
+	 trace_event,
+	 timestamp,
+	 size,
+	 io_handle->trace_callback_data );
+}
+
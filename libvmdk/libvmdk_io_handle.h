@@ -27,6 +27,7 @@
 
 #include "libvmdk_libbfio.h"
 #include "libvmdk_libcerror.h"
+#include "libvmdk_statistics.h"
 
 #if defined( __cplusplus )
 extern "C" {
@@ -60,6 +61,23 @@ struct libvmdk_io_handle
 	 */
 	uint16_t compression_method;
 
+	/* The read statistics
+	 */
+	libvmdk_statistics_t statistics;
+
+	/* The trace callback function
+	 */
+	void (*trace_callback)(
+	       int trace_phase,
+	       int trace_event,
+	       uint64_t timestamp,
+	       uint64_t size,
+	       void *callback_data );
+
+	/* The trace callback data
+	 */
+	void *trace_callback_data;
+
 	/* Value to indicate if abort was signalled
 	 */
 	int abort;
@@ -77,6 +95,12 @@ int libvmdk_io_handle_clear(
      libvmdk_io_handle_t *io_handle,
      libcerror_error_t **error );
 
+void libvmdk_io_handle_trace(
+      libvmdk_io_handle_t *io_handle,
+      int trace_phase,
+      int trace_event,
+      uint64_t size );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,554 @@
+/*
+ * SHA-256 functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_sha256.h"
+
+#define libvmdk_sha256_rotate_right( value, number_of_bits ) \
+	( ( ( value ) >> ( number_of_bits ) ) | ( ( value ) << ( 32 - ( number_of_bits ) ) ) )
+
+/* The initial hash values, the first 32 bits of the fractional parts
+ * of the square roots of the first 8 primes
+ */
+static const uint32_t libvmdk_sha256_initial_hash_values[ 8 ] = {
+	0x6a09e667UL, 0xbb67ae85UL, 0x3c6ef372UL, 0xa54ff53aUL,
+	0x510e527fUL, 0x9b05688cUL, 0x1f83d9abUL, 0x5be0cd19UL };
+
+/* The round constants, the first 32 bits of the fractional parts
+ * of the cube roots of the first 64 primes
+ */
+static const uint32_t libvmdk_sha256_round_constants[ 64 ] = {
+	0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL,
+	0xd807aa98UL, 0x12835b01UL, 0x243185beUL, 0x550c7dc3UL, 0x72be5d74UL, 0x80deb1feUL, 0x9bdc06a7UL, 0xc19bf174UL,
+	0xe49b69c1UL, 0xefbe4786UL, 0x0fc19dc6UL, 0x240ca1ccUL, 0x2de92c6fUL, 0x4a7484aaUL, 0x5cb0a9dcUL, 0x76f988daUL,
+	0x983e5152UL, 0xa831c66dUL, 0xb00327c8UL, 0xbf597fc7UL, 0xc6e00bf3UL, 0xd5a79147UL, 0x06ca6351UL, 0x14292967UL,
+	0x27b70a85UL, 0x2e1b2138UL, 0x4d2c6dfcUL, 0x53380d13UL, 0x650a7354UL, 0x766a0abbUL, 0x81c2c92eUL, 0x92722c85UL,
+	0xa2bfe8a1UL, 0xa81a664bUL, 0xc24b8b70UL, 0xc76c51a3UL, 0xd192e819UL, 0xd6990624UL, 0xf40e3585UL, 0x106aa070UL,
+	0x19a4c116UL, 0x1e376c08UL, 0x2748774cUL, 0x34b0bcb5UL, 0x391c0cb3UL, 0x4ed8aa4aUL, 0x5b9cca4fUL, 0x682e6ff3UL,
+	0x748f82eeUL, 0x78a5636fUL, 0x84c87814UL, 0x8cc70208UL, 0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL };
+
+/* Initializes a SHA-256 context
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_sha256_context_initialize(
+     libvmdk_sha256_context_t *context,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_sha256_context_initialize";
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_copy(
+	     context->hash_values,
+	     libvmdk_sha256_initial_hash_values,
+	     sizeof( uint32_t ) * 8 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy initial hash values.",
+		 function );
+
+		return( -1 );
+	}
+	context->number_of_bytes = 0;
+	context->block_data_size = 0;
+
+	return( 1 );
+}
+
+/* Transforms a block of data into the hash values
+ */
+void libvmdk_sha256_context_transform(
+     libvmdk_sha256_context_t *context,
+     const uint8_t *block_data )
+{
+	uint32_t schedule[ 64 ];
+	uint32_t values[ 8 ];
+
+	uint32_t value_32bit1 = 0;
+	uint32_t value_32bit2 = 0;
+	int round_index       = 0;
+	int value_index       = 0;
+
+	for( round_index = 0;
+	     round_index < 16;
+	     round_index++ )
+	{
+		byte_stream_copy_to_uint32_big_endian(
+		 &( block_data[ round_index * 4 ] ),
+		 schedule[ round_index ] );
+	}
+	for( round_index = 16;
+	     round_index < 64;
+	     round_index++ )
+	{
+		value_32bit1 = libvmdk_sha256_rotate_right( schedule[ round_index - 15 ], 7 )
+		             ^ libvmdk_sha256_rotate_right( schedule[ round_index - 15 ], 18 )
+		             ^ ( schedule[ round_index - 15 ] >> 3 );
+
+		value_32bit2 = libvmdk_sha256_rotate_right( schedule[ round_index - 2 ], 17 )
+		             ^ libvmdk_sha256_rotate_right( schedule[ round_index - 2 ], 19 )
+		             ^ ( schedule[ round_index - 2 ] >> 10 );
+
+		schedule[ round_index ] = schedule[ round_index - 16 ] + value_32bit1
+		                        + schedule[ round_index - 7 ] + value_32bit2;
+	}
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		values[ value_index ] = context->hash_values[ value_index ];
+	}
+	for( round_index = 0;
+	     round_index < 64;
+	     round_index++ )
+	{
+		value_32bit1 = values[ 7 ]
+		             + ( libvmdk_sha256_rotate_right( values[ 4 ], 6 )
+		               ^ libvmdk_sha256_rotate_right( values[ 4 ], 11 )
+		               ^ libvmdk_sha256_rotate_right( values[ 4 ], 25 ) )
+		             + ( ( values[ 4 ] & values[ 5 ] ) ^ ( ~( values[ 4 ] ) & values[ 6 ] ) )
+		             + libvmdk_sha256_round_constants[ round_index ]
+		             + schedule[ round_index ];
+
+		value_32bit2 = ( libvmdk_sha256_rotate_right( values[ 0 ], 2 )
+		               ^ libvmdk_sha256_rotate_right( values[ 0 ], 13 )
+		               ^ libvmdk_sha256_rotate_right( values[ 0 ], 22 ) )
+		             + ( ( values[ 0 ] & values[ 1 ] ) ^ ( values[ 0 ] & values[ 2 ] ) ^ ( values[ 1 ] & values[ 2 ] ) );
+
+		values[ 7 ] = values[ 6 ];
+		values[ 6 ] = values[ 5 ];
+		values[ 5 ] = values[ 4 ];
+		values[ 4 ] = values[ 3 ] + value_32bit1;
+		values[ 3 ] = values[ 2 ];
+		values[ 2 ] = values[ 1 ];
+		values[ 1 ] = values[ 0 ];
+		values[ 0 ] = value_32bit1 + value_32bit2;
+	}
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		context->hash_values[ value_index ] += values[ value_index ];
+	}
+}
+
+/* Updates a SHA-256 context with the data in a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_sha256_context_update(
+     libvmdk_sha256_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_sha256_context_update";
+	size_t buffer_offset  = 0;
+	size_t copy_size      = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	context->number_of_bytes += size;
+
+	if( context->block_data_size > 0 )
+	{
+		copy_size = LIBVMDK_SHA256_BLOCK_SIZE - context->block_data_size;
+
+		if( copy_size > size )
+		{
+			copy_size = size;
+		}
+		if( memory_copy(
+		     &( context->block_data[ context->block_data_size ] ),
+		     buffer,
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to block data.",
+			 function );
+
+			return( -1 );
+		}
+		context->block_data_size += copy_size;
+		buffer_offset            += copy_size;
+
+		if( context->block_data_size < LIBVMDK_SHA256_BLOCK_SIZE )
+		{
+			return( 1 );
+		}
+		libvmdk_sha256_context_transform(
+		 context,
+		 context->block_data );
+
+		context->block_data_size = 0;
+	}
+	/* Transform the complete blocks directly from the buffer
+	 */
+	while( ( size - buffer_offset ) >= LIBVMDK_SHA256_BLOCK_SIZE )
+	{
+		libvmdk_sha256_context_transform(
+		 context,
+		 &( buffer[ buffer_offset ] ) );
+
+		buffer_offset += LIBVMDK_SHA256_BLOCK_SIZE;
+	}
+	if( buffer_offset < size )
+	{
+		copy_size = size - buffer_offset;
+
+		if( memory_copy(
+		     context->block_data,
+		     &( buffer[ buffer_offset ] ),
+		     copy_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy buffer to block data.",
+			 function );
+
+			return( -1 );
+		}
+		context->block_data_size = copy_size;
+	}
+	return( 1 );
+}
+
+/* Finalizes a SHA-256 context and retrieves the digest
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_sha256_context_finalize(
+     libvmdk_sha256_context_t *context,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_sha256_context_finalize";
+	uint64_t bit_size     = 0;
+	int value_index       = 0;
+
+	if( context == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid context.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid digest.",
+		 function );
+
+		return( -1 );
+	}
+	if( digest_size < LIBVMDK_SHA256_DIGEST_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid digest size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( context->block_data_size >= LIBVMDK_SHA256_BLOCK_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid context - block data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	bit_size = context->number_of_bytes * 8;
+
+	/* Pad the data with a 1-bit, 0-bits and the 64-bit size in bits
+	 */
+	context->block_data[ context->block_data_size++ ] = 0x80;
+
+	if( context->block_data_size > ( LIBVMDK_SHA256_BLOCK_SIZE - 8 ) )
+	{
+		if( memory_set(
+		     &( context->block_data[ context->block_data_size ] ),
+		     0,
+		     LIBVMDK_SHA256_BLOCK_SIZE - context->block_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block data.",
+			 function );
+
+			return( -1 );
+		}
+		libvmdk_sha256_context_transform(
+		 context,
+		 context->block_data );
+
+		context->block_data_size = 0;
+	}
+	if( memory_set(
+	     &( context->block_data[ context->block_data_size ] ),
+	     0,
+	     LIBVMDK_SHA256_BLOCK_SIZE - 8 - context->block_data_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear block data.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( context->block_data[ LIBVMDK_SHA256_BLOCK_SIZE - 8 ] ),
+	 bit_size );
+
+	libvmdk_sha256_context_transform(
+	 context,
+	 context->block_data );
+
+	context->block_data_size = 0;
+
+	for( value_index = 0;
+	     value_index < 8;
+	     value_index++ )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( digest[ value_index * 4 ] ),
+		 context->hash_values[ value_index ] );
+	}
+	return( 1 );
+}
+
+/* Calculates the SHA-256 digest of a buffer
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_sha256_calculate_digest(
+     const uint8_t *buffer,
+     size_t size,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	libvmdk_sha256_context_t context;
+
+	static char *function = "libvmdk_sha256_calculate_digest";
+
+	if( libvmdk_sha256_context_initialize(
+	     &context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_sha256_context_update(
+	     &context,
+	     buffer,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_sha256_context_finalize(
+	     &context,
+	     digest,
+	     digest_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Calculates the SHA-256 digest of data of a specific size that only contains 0-byte values
+ * without the need to allocate a buffer of that size
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_sha256_calculate_zero_digest(
+     size64_t size,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error )
+{
+	uint8_t zero_block_data[ LIBVMDK_SHA256_BLOCK_SIZE ];
+
+	libvmdk_sha256_context_t context;
+
+	static char *function = "libvmdk_sha256_calculate_zero_digest";
+
+	if( memory_set(
+	     zero_block_data,
+	     0,
+	     LIBVMDK_SHA256_BLOCK_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear zero block data.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_sha256_context_initialize(
+	     &context,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize context.",
+		 function );
+
+		return( -1 );
+	}
+	/* The complete blocks are transformed directly, the remainder is added as a regular update
+	 */
+	context.number_of_bytes = size - ( size % LIBVMDK_SHA256_BLOCK_SIZE );
+
+	while( size >= LIBVMDK_SHA256_BLOCK_SIZE )
+	{
+		libvmdk_sha256_context_transform(
+		 &context,
+		 zero_block_data );
+
+		size -= LIBVMDK_SHA256_BLOCK_SIZE;
+	}
+	if( libvmdk_sha256_context_update(
+	     &context,
+	     zero_block_data,
+	     (size_t) size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to update context.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_sha256_context_finalize(
+	     &context,
+	     digest,
+	     digest_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to finalize context.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
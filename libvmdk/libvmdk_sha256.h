@@ -0,0 +1,99 @@
+/*
+ * SHA-256 functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_SHA256_H )
+#define _LIBVMDK_SHA256_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The size of a SHA-256 block
+ */
+#define LIBVMDK_SHA256_BLOCK_SIZE	64
+
+typedef struct libvmdk_sha256_context libvmdk_sha256_context_t;
+
+struct libvmdk_sha256_context
+{
+	/* The hash values
+	 */
+	uint32_t hash_values[ 8 ];
+
+	/* The number of bytes hashed
+	 */
+	uint64_t number_of_bytes;
+
+	/* The block data
+	 * Contains the data that does not fill a complete block yet
+	 */
+	uint8_t block_data[ LIBVMDK_SHA256_BLOCK_SIZE ];
+
+	/* The block data size
+	 */
+	size_t block_data_size;
+};
+
+int libvmdk_sha256_context_initialize(
+     libvmdk_sha256_context_t *context,
+     libcerror_error_t **error );
+
+void libvmdk_sha256_context_transform(
+     libvmdk_sha256_context_t *context,
+     const uint8_t *block_data );
+
+int libvmdk_sha256_context_update(
+     libvmdk_sha256_context_t *context,
+     const uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int libvmdk_sha256_context_finalize(
+     libvmdk_sha256_context_t *context,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+int libvmdk_sha256_calculate_digest(
+     const uint8_t *buffer,
+     size_t size,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+int libvmdk_sha256_calculate_zero_digest(
+     size64_t size,
+     uint8_t *digest,
+     size_t digest_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_SHA256_H ) */
+
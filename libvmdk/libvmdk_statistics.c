@@ -0,0 +1,587 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_statistics.h"
+
+/* Retrieves a monotonic timestamp in nanoseconds
+ * Returns 1 if successful or 0 if not available
+ */
+int libvmdk_statistics_get_timestamp(
+     uint64_t *timestamp )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+#endif
+
+	if( timestamp == NULL )
+	{
+		return( 0 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		return( 0 );
+	}
+	if( QueryPerformanceCounter(
+	     &counter ) == 0 )
+	{
+		return( 0 );
+	}
+	*timestamp = ( (uint64_t) counter.QuadPart / (uint64_t) frequency.QuadPart ) * 1000000000UL
+	           + ( ( (uint64_t) counter.QuadPart % (uint64_t) frequency.QuadPart ) * 1000000000UL ) / (uint64_t) frequency.QuadPart;
+
+	return( 1 );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		return( 0 );
+	}
+	*timestamp = ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec;
+
+	return( 1 );
+
+#else
+	return( 0 );
+#endif
+}
+
+/* Retrieves the start timestamp of a timed operation
+ * The timestamp is only retrieved if time measurement was enabled
+ * Returns 1 if successful or 0 if not measured
+ */
+int libvmdk_statistics_start_timer(
+     libvmdk_statistics_t *statistics,
+     uint64_t *timestamp )
+{
+	if( statistics == NULL )
+	{
+		return( 0 );
+	}
+	if( ( statistics->flags & LIBVMDK_STATISTICS_FLAG_MEASURE_TIME ) == 0 )
+	{
+		return( 0 );
+	}
+	return( libvmdk_statistics_get_timestamp(
+	         timestamp ) );
+}
+
+/* Determines the histogram bucket index of a duration in nanoseconds
+ * Returns the bucket index
+ */
+int libvmdk_statistics_get_histogram_bucket_index(
+     uint64_t duration )
+{
+	int bucket_index = 0;
+
+	/* Convert the duration into microseconds
+	 */
+	duration /= 1000;
+
+	while( ( duration > 1 )
+	    && ( bucket_index < ( LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS - 1 ) ) )
+	{
+		duration    >>= 1;
+		bucket_index += 1;
+	}
+	return( bucket_index );
+}
+
+/* Adds a decompression time to the statistics
+ */
+void libvmdk_statistics_add_decompression_time(
+      libvmdk_statistics_t *statistics,
+      uint64_t start_timestamp,
+      uint64_t end_timestamp )
+{
+	uint64_t duration = 0;
+	int bucket_index  = 0;
+
+	if( statistics == NULL )
+	{
+		return;
+	}
+	if( end_timestamp > start_timestamp )
+	{
+		duration = end_timestamp - start_timestamp;
+	}
+	bucket_index = libvmdk_statistics_get_histogram_bucket_index(
+	                duration );
+
+	LIBVMDK_STATISTICS_ADD(
+	 statistics->decompression_time,
+	 duration );
+
+	LIBVMDK_STATISTICS_ADD(
+	 statistics->decompression_time_histogram[ bucket_index ],
+	 1 );
+}
+
+/* Adds a read time to the statistics
+ */
+void libvmdk_statistics_add_read_time(
+      libvmdk_statistics_t *statistics,
+      uint64_t start_timestamp,
+      uint64_t end_timestamp )
+{
+	uint64_t duration = 0;
+	int bucket_index  = 0;
+
+	if( statistics == NULL )
+	{
+		return;
+	}
+	if( end_timestamp > start_timestamp )
+	{
+		duration = end_timestamp - start_timestamp;
+	}
+	bucket_index = libvmdk_statistics_get_histogram_bucket_index(
+	                duration );
+
+	LIBVMDK_STATISTICS_ADD(
+	 statistics->read_time,
+	 duration );
+
+	LIBVMDK_STATISTICS_ADD(
+	 statistics->read_time_histogram[ bucket_index ],
+	 1 );
+}
+
+/* Adds a read from an extent file to the statistics
+ * A read that failed is counted without adding to the read size
+ */
+void libvmdk_statistics_add_backing_read(
+      libvmdk_statistics_t *statistics,
+      ssize_t read_count )
+{
+	if( statistics == NULL )
+	{
+		return;
+	}
+	LIBVMDK_STATISTICS_ADD(
+	 statistics->number_of_backing_reads,
+	 1 );
+
+	if( read_count > 0 )
+	{
+		LIBVMDK_STATISTICS_ADD(
+		 statistics->backing_read_size,
+		 (uint64_t) read_count );
+	}
+}
+
+/* Adds a duration to an open phase of the statistics
+ */
+void libvmdk_statistics_add_open_phase_time(
+      libvmdk_statistics_t *statistics,
+      int open_phase,
+      uint64_t start_timestamp,
+      uint64_t end_timestamp )
+{
+	if( ( statistics == NULL )
+	 || ( open_phase < LIBVMDK_OPEN_PHASE_DESCRIPTOR )
+	 || ( open_phase > LIBVMDK_STATISTICS_NUMBER_OF_OPEN_PHASES ) )
+	{
+		return;
+	}
+	if( end_timestamp > start_timestamp )
+	{
+		LIBVMDK_STATISTICS_ADD(
+		 statistics->open_phases[ open_phase - 1 ].duration,
+		 end_timestamp - start_timestamp );
+	}
+}
+
+/* Adds a read to an open phase of the statistics
+ * A read that failed is counted without adding to the read size
+ */
+void libvmdk_statistics_add_open_phase_read(
+      libvmdk_statistics_t *statistics,
+      int open_phase,
+      ssize_t read_count )
+{
+	if( ( statistics == NULL )
+	 || ( open_phase < LIBVMDK_OPEN_PHASE_DESCRIPTOR )
+	 || ( open_phase > LIBVMDK_STATISTICS_NUMBER_OF_OPEN_PHASES ) )
+	{
+		return;
+	}
+	LIBVMDK_STATISTICS_ADD(
+	 statistics->open_phases[ open_phase - 1 ].number_of_reads,
+	 1 );
+
+	if( read_count > 0 )
+	{
+		LIBVMDK_STATISTICS_ADD(
+		 statistics->open_phases[ open_phase - 1 ].read_size,
+		 (uint64_t) read_count );
+	}
+}
+
+/* Adds a seek to an open phase of the statistics
+ */
+void libvmdk_statistics_add_open_phase_seek(
+      libvmdk_statistics_t *statistics,
+      int open_phase )
+{
+	if( ( statistics == NULL )
+	 || ( open_phase < LIBVMDK_OPEN_PHASE_DESCRIPTOR )
+	 || ( open_phase > LIBVMDK_STATISTICS_NUMBER_OF_OPEN_PHASES ) )
+	{
+		return;
+	}
+	LIBVMDK_STATISTICS_ADD(
+	 statistics->open_phases[ open_phase - 1 ].number_of_seeks,
+	 1 );
+}
+
+/* Retrieves a specific statistics value
+ * Returns 1 if successful, 0 if the value type is not supported or -1 on error
+ */
+int libvmdk_statistics_get_value(
+     libvmdk_statistics_t *statistics,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_statistics_get_value";
+	uint64_t lookups      = 0;
+	uint64_t misses       = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	switch( value_type )
+	{
+		case LIBVMDK_STATISTICS_VALUE_NUMBER_OF_READS:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->number_of_reads );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_READ_SIZE:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->read_size );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_NUMBER_OF_SPARSE_GRAINS:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->number_of_sparse_grains );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_NUMBER_OF_ALLOCATED_GRAINS:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->number_of_allocated_grains );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_NUMBER_OF_COMPRESSED_GRAINS:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->number_of_compressed_grains );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_NUMBER_OF_PARENT_READS:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->number_of_parent_reads );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_GRAINS_CACHE_HITS:
+			lookups = LIBVMDK_STATISTICS_GET(
+			           statistics->grains_cache_lookups );
+
+			misses = LIBVMDK_STATISTICS_GET(
+			          statistics->grains_cache_misses );
+
+			if( lookups > misses )
+			{
+				*value = lookups - misses;
+			}
+			else
+			{
+				*value = 0;
+			}
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_GRAINS_CACHE_MISSES:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->grains_cache_misses );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_GRAIN_GROUPS_CACHE_HITS:
+			lookups = LIBVMDK_STATISTICS_GET(
+			           statistics->grain_groups_cache_lookups );
+
+			misses = LIBVMDK_STATISTICS_GET(
+			          statistics->grain_groups_cache_misses );
+
+			if( lookups > misses )
+			{
+				*value = lookups - misses;
+			}
+			else
+			{
+				*value = 0;
+			}
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_GRAIN_GROUPS_CACHE_MISSES:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->grain_groups_cache_misses );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_EXTENT_FILES_CACHE_HITS:
+			lookups = LIBVMDK_STATISTICS_GET(
+			           statistics->extent_files_cache_lookups );
+
+			misses = LIBVMDK_STATISTICS_GET(
+			          statistics->extent_files_cache_misses );
+
+			if( lookups > misses )
+			{
+				*value = lookups - misses;
+			}
+			else
+			{
+				*value = 0;
+			}
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_EXTENT_FILES_CACHE_MISSES:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->extent_files_cache_misses );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_NUMBER_OF_DECOMPRESSIONS:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->number_of_decompressions );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_DECOMPRESSION_TIME:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->decompression_time );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_COMPRESSED_READ_SIZE:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->compressed_read_size );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_NUMBER_OF_BACKING_READS:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->number_of_backing_reads );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_BACKING_READ_SIZE:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->backing_read_size );
+			break;
+
+		case LIBVMDK_STATISTICS_VALUE_READ_TIME:
+			*value = LIBVMDK_STATISTICS_GET(
+			          statistics->read_time );
+			break;
+
+		default:
+			return( 0 );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific statistics histogram
+ * Returns 1 if successful, 0 if the histogram type is not supported or -1 on error
+ */
+int libvmdk_statistics_get_histogram(
+     libvmdk_statistics_t *statistics,
+     int histogram_type,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error )
+{
+	uint64_t *statistics_histogram = NULL;
+	static char *function          = "libvmdk_statistics_get_histogram";
+	int bucket_index               = 0;
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_buckets != LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of buckets value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	switch( histogram_type )
+	{
+		case LIBVMDK_STATISTICS_HISTOGRAM_DECOMPRESSION_TIME:
+			statistics_histogram = statistics->decompression_time_histogram;
+			break;
+
+		case LIBVMDK_STATISTICS_HISTOGRAM_READ_TIME:
+			statistics_histogram = statistics->read_time_histogram;
+			break;
+
+		default:
+			return( 0 );
+	}
+	for( bucket_index = 0;
+	     bucket_index < LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS;
+	     bucket_index++ )
+	{
+		histogram[ bucket_index ] = LIBVMDK_STATISTICS_GET(
+		                             statistics_histogram[ bucket_index ] );
+	}
+	return( 1 );
+}
+
+/* Retrieves a specific value of an open phase
+ * Returns 1 if successful, 0 if the open phase or value type is not supported or -1 on error
+ */
+int libvmdk_statistics_get_open_phase_value(
+     libvmdk_statistics_t *statistics,
+     int open_phase,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	libvmdk_open_phase_statistics_t *open_phase_statistics = NULL;
+	static char *function                                  = "libvmdk_statistics_get_open_phase_value";
+
+	if( statistics == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid statistics.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( open_phase < LIBVMDK_OPEN_PHASE_DESCRIPTOR )
+	 || ( open_phase > LIBVMDK_STATISTICS_NUMBER_OF_OPEN_PHASES ) )
+	{
+		return( 0 );
+	}
+	open_phase_statistics = &( statistics->open_phases[ open_phase - 1 ] );
+
+	switch( value_type )
+	{
+		case LIBVMDK_OPEN_PHASE_VALUE_DURATION:
+			*value = LIBVMDK_STATISTICS_GET(
+			          open_phase_statistics->duration );
+			break;
+
+		case LIBVMDK_OPEN_PHASE_VALUE_NUMBER_OF_READS:
+			*value = LIBVMDK_STATISTICS_GET(
+			          open_phase_statistics->number_of_reads );
+			break;
+
+		case LIBVMDK_OPEN_PHASE_VALUE_READ_SIZE:
+			*value = LIBVMDK_STATISTICS_GET(
+			          open_phase_statistics->read_size );
+			break;
+
+		case LIBVMDK_OPEN_PHASE_VALUE_NUMBER_OF_SEEKS:
+			*value = LIBVMDK_STATISTICS_GET(
+			          open_phase_statistics->number_of_seeks );
+			break;
+
+		default:
+			return( 0 );
+	}
+	return( 1 );
+}
+
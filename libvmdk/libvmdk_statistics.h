@@ -0,0 +1,246 @@
+/*
+ * Statistics functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_STATISTICS_H )
+#define _LIBVMDK_STATISTICS_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The number of open phases
+ */
+#define LIBVMDK_STATISTICS_NUMBER_OF_OPEN_PHASES	6
+
+/* The statistics counters are updated with atomic operations where supported
+ * by the compiler so that they do not depend on the handle being locked
+ */
+#if defined( _MSC_VER ) && defined( _WIN64 )
+#define LIBVMDK_STATISTICS_ADD( counter, value ) \
+	InterlockedExchangeAdd64( (volatile LONG64 *) &( counter ), (LONG64) ( value ) )
+
+#define LIBVMDK_STATISTICS_GET( counter ) \
+	(uint64_t) InterlockedCompareExchange64( (volatile LONG64 *) &( counter ), 0, 0 )
+
+#elif defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 7 ) ) ) )
+#define LIBVMDK_STATISTICS_ADD( counter, value ) \
+	__atomic_fetch_add( &( counter ), (uint64_t) ( value ), __ATOMIC_RELAXED )
+
+#define LIBVMDK_STATISTICS_GET( counter ) \
+	__atomic_load_n( &( counter ), __ATOMIC_RELAXED )
+
+#else
+#define LIBVMDK_STATISTICS_ADD( counter, value ) \
+	( counter ) += (uint64_t) ( value )
+
+#define LIBVMDK_STATISTICS_GET( counter ) \
+	( counter )
+
+#endif
+
+typedef struct libvmdk_open_phase_statistics libvmdk_open_phase_statistics_t;
+
+struct libvmdk_open_phase_statistics
+{
+	/* The duration in nanoseconds
+	 */
+	uint64_t duration;
+
+	/* The number of reads
+	 */
+	uint64_t number_of_reads;
+
+	/* The number of bytes read
+	 */
+	uint64_t read_size;
+
+	/* The number of seeks
+	 */
+	uint64_t number_of_seeks;
+};
+
+typedef struct libvmdk_statistics libvmdk_statistics_t;
+
+struct libvmdk_statistics
+{
+	/* The flags
+	 */
+	uint8_t flags;
+
+	/* The number of reads
+	 */
+	uint64_t number_of_reads;
+
+	/* The number of bytes read
+	 */
+	uint64_t read_size;
+
+	/* The number of sparse grains read
+	 */
+	uint64_t number_of_sparse_grains;
+
+	/* The number of allocated grains read
+	 */
+	uint64_t number_of_allocated_grains;
+
+	/* The number of compressed grains read
+	 */
+	uint64_t number_of_compressed_grains;
+
+	/* The number of reads forwarded to the parent
+	 */
+	uint64_t number_of_parent_reads;
+
+	/* The number of grains cache lookups
+	 * The number of cache hits is the number of lookups minus the number of misses
+	 */
+	uint64_t grains_cache_lookups;
+
+	/* The number of grains cache misses
+	 */
+	uint64_t grains_cache_misses;
+
+	/* The number of grain groups cache lookups
+	 * The number of cache hits is the number of lookups minus the number of misses
+	 */
+	uint64_t grain_groups_cache_lookups;
+
+	/* The number of grain groups cache misses
+	 */
+	uint64_t grain_groups_cache_misses;
+
+	/* The number of extent files cache lookups
+	 * The number of cache hits is the number of lookups minus the number of misses
+	 */
+	uint64_t extent_files_cache_lookups;
+
+	/* The number of extent files cache misses
+	 */
+	uint64_t extent_files_cache_misses;
+
+	/* The number of bytes of compressed grain data read
+	 */
+	uint64_t compressed_read_size;
+
+	/* The number of reads from the extent files
+	 */
+	uint64_t number_of_backing_reads;
+
+	/* The number of bytes read from the extent files
+	 */
+	uint64_t backing_read_size;
+
+	/* The number of decompressions
+	 */
+	uint64_t number_of_decompressions;
+
+	/* The total decompression time in nanoseconds
+	 */
+	uint64_t decompression_time;
+
+	/* The decompression time histogram
+	 */
+	uint64_t decompression_time_histogram[ LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS ];
+
+	/* The total read time in nanoseconds
+	 */
+	uint64_t read_time;
+
+	/* The read time histogram
+	 */
+	uint64_t read_time_histogram[ LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS ];
+
+	/* The open phases statistics
+	 */
+	libvmdk_open_phase_statistics_t open_phases[ LIBVMDK_STATISTICS_NUMBER_OF_OPEN_PHASES ];
+};
+
+int libvmdk_statistics_get_timestamp(
+     uint64_t *timestamp );
+
+int libvmdk_statistics_start_timer(
+     libvmdk_statistics_t *statistics,
+     uint64_t *timestamp );
+
+int libvmdk_statistics_get_histogram_bucket_index(
+     uint64_t duration );
+
+void libvmdk_statistics_add_decompression_time(
+      libvmdk_statistics_t *statistics,
+      uint64_t start_timestamp,
+      uint64_t end_timestamp );
+
+void libvmdk_statistics_add_read_time(
+      libvmdk_statistics_t *statistics,
+      uint64_t start_timestamp,
+      uint64_t end_timestamp );
+
+void libvmdk_statistics_add_backing_read(
+      libvmdk_statistics_t *statistics,
+      ssize_t read_count );
+
+void libvmdk_statistics_add_open_phase_time(
+      libvmdk_statistics_t *statistics,
+      int open_phase,
+      uint64_t start_timestamp,
+      uint64_t end_timestamp );
+
+void libvmdk_statistics_add_open_phase_read(
+      libvmdk_statistics_t *statistics,
+      int open_phase,
+      ssize_t read_count );
+
+void libvmdk_statistics_add_open_phase_seek(
+      libvmdk_statistics_t *statistics,
+      int open_phase );
+
+int libvmdk_statistics_get_value(
+     libvmdk_statistics_t *statistics,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+int libvmdk_statistics_get_histogram(
+     libvmdk_statistics_t *statistics,
+     int histogram_type,
+     uint64_t *histogram,
+     int number_of_buckets,
+     libcerror_error_t **error );
+
+int libvmdk_statistics_get_open_phase_value(
+     libvmdk_statistics_t *statistics,
+     int open_phase,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_STATISTICS_H ) */
+
@@ -0,0 +1,503 @@
+/*
+ * Stream-optimized grain functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_compression.h"
+#include "libvmdk_definitions.h"
+#include "libvmdk_extent_file.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_stream_grain.h"
+
+/* Creates a stream grain
+ * Make sure the value stream_grain is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_grain_initialize(
+     libvmdk_stream_grain_t **stream_grain,
+     size_t grain_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_stream_grain_initialize";
+
+	if( stream_grain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream grain.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_grain != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream grain value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( grain_size == 0 )
+	 || ( grain_size > (size_t) ( SSIZE_MAX / 2 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*stream_grain = memory_allocate_structure(
+	                 libvmdk_stream_grain_t );
+
+	if( *stream_grain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stream grain.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *stream_grain,
+	     0,
+	     sizeof( libvmdk_stream_grain_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stream grain.",
+		 function );
+
+		memory_free(
+		 *stream_grain );
+
+		*stream_grain = NULL;
+
+		return( -1 );
+	}
+	( *stream_grain )->data = (uint8_t *) memory_allocate(
+	                                       sizeof( uint8_t ) * grain_size );
+
+	if( ( *stream_grain )->data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		goto on_error;
+	}
+	( *stream_grain )->data_size = grain_size;
+
+	/* The compressed data can be larger than the uncompressed data
+	 * use the zlib worst case estimate and account for the grain marker
+	 */
+	( *stream_grain )->allocated_block_data_size = 12 + grain_size + ( grain_size / 1000 ) + 13;
+
+	if( ( ( *stream_grain )->allocated_block_data_size % 512 ) != 0 )
+	{
+		( *stream_grain )->allocated_block_data_size += 512 - ( ( *stream_grain )->allocated_block_data_size % 512 );
+	}
+	( *stream_grain )->block_data = (uint8_t *) memory_allocate(
+	                                             sizeof( uint8_t ) * ( *stream_grain )->allocated_block_data_size );
+
+	if( ( *stream_grain )->block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block data.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *stream_grain != NULL )
+	{
+		if( ( *stream_grain )->data != NULL )
+		{
+			memory_free(
+			 ( *stream_grain )->data );
+		}
+		memory_free(
+		 *stream_grain );
+
+		*stream_grain = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a stream grain
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_grain_free(
+     libvmdk_stream_grain_t **stream_grain,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_stream_grain_free";
+
+	if( stream_grain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream grain.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_grain != NULL )
+	{
+		if( ( *stream_grain )->block_data != NULL )
+		{
+			memory_free(
+			 ( *stream_grain )->block_data );
+		}
+		if( ( *stream_grain )->data != NULL )
+		{
+			memory_free(
+			 ( *stream_grain )->data );
+		}
+		memory_free(
+		 *stream_grain );
+
+		*stream_grain = NULL;
+	}
+	return( 1 );
+}
+
+/* Compresses the stream grain data into a grain marker block
+ * Grains that are filled with 0-byte values are marked as sparse and not compressed
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_grain_compress(
+     libvmdk_stream_grain_t *stream_grain,
+     int compression_level,
+     libcerror_error_t **error )
+{
+	uint8_t *reallocation        = NULL;
+	static char *function        = "libvmdk_stream_grain_compress";
+	size_t compressed_data_size  = 0;
+	uint64_t sector_number       = 0;
+	int result                   = 0;
+
+	if( stream_grain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream grain.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( stream_grain->data == NULL )
+	 || ( stream_grain->block_data == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream grain - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	stream_grain->is_sparse       = 0;
+	stream_grain->block_data_size = 0;
+
+	if( stream_grain->data[ 0 ] == 0 )
+	{
+		result = libvmdk_extent_file_check_for_empty_block(
+		          stream_grain->data,
+		          stream_grain->data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if grain data is empty.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			stream_grain->is_sparse = 1;
+
+			return( 1 );
+		}
+	}
+	do
+	{
+		compressed_data_size = stream_grain->allocated_block_data_size - 12;
+
+		result = libvmdk_compress_data(
+		          &( stream_grain->block_data[ 12 ] ),
+		          &compressed_data_size,
+		          LIBVMDK_COMPRESSION_METHOD_DEFLATE,
+		          compression_level,
+		          stream_grain->data,
+		          stream_grain->data_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+			 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+			 "%s: unable to compress grain data.",
+			 function );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			if( ( compressed_data_size == 0 )
+			 || ( compressed_data_size > (size_t) UINT32_MAX )
+			 || ( compressed_data_size > (size_t) ( SSIZE_MAX - 524 ) ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid compressed data size value out of bounds.",
+				 function );
+
+				return( -1 );
+			}
+			compressed_data_size += 12;
+
+			if( ( compressed_data_size % 512 ) != 0 )
+			{
+				compressed_data_size += 512 - ( compressed_data_size % 512 );
+			}
+			reallocation = (uint8_t *) memory_reallocate(
+			                            stream_grain->block_data,
+			                            sizeof( uint8_t ) * compressed_data_size );
+
+			if( reallocation == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to resize block data.",
+				 function );
+
+				return( -1 );
+			}
+			stream_grain->block_data                = reallocation;
+			stream_grain->allocated_block_data_size = compressed_data_size;
+		}
+	}
+	while( result == 0 );
+
+	if( compressed_data_size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	sector_number = stream_grain->grain_index * ( stream_grain->data_size / 512 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 stream_grain->block_data,
+	 sector_number );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( stream_grain->block_data[ 8 ] ),
+	 (uint32_t) compressed_data_size );
+
+	stream_grain->block_data_size = 12 + compressed_data_size;
+
+	if( ( stream_grain->block_data_size % 512 ) != 0 )
+	{
+		if( memory_set(
+		     &( stream_grain->block_data[ stream_grain->block_data_size ] ),
+		     0,
+		     512 - ( stream_grain->block_data_size % 512 ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block data padding.",
+			 function );
+
+			return( -1 );
+		}
+		stream_grain->block_data_size += 512 - ( stream_grain->block_data_size % 512 );
+	}
+	return( 1 );
+}
+
+/* Decompresses the grain marker block into the stream grain data
+ * The grain marker must refer to the grain index and the compressed data
+ * must decompress into exactly the grain size
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_grain_decompress(
+     libvmdk_stream_grain_t *stream_grain,
+     libcerror_error_t **error )
+{
+	static char *function           = "libvmdk_stream_grain_decompress";
+	size_t uncompressed_data_size   = 0;
+	uint64_t expected_sector_number = 0;
+	uint64_t sector_number          = 0;
+	uint32_t compressed_data_size   = 0;
+
+	if( stream_grain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream grain.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( stream_grain->data == NULL )
+	 || ( stream_grain->block_data == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream grain - missing data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( stream_grain->block_data_size < 12 )
+	 || ( stream_grain->block_data_size > stream_grain->allocated_block_data_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid stream grain - block data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 stream_grain->block_data,
+	 sector_number );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( stream_grain->block_data[ 8 ] ),
+	 compressed_data_size );
+
+	expected_sector_number = stream_grain->grain_index * ( stream_grain->data_size / 512 );
+
+	if( sector_number != expected_sector_number )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: mismatch in grain marker sector number: %" PRIu64 " (expected: %" PRIu64 ").",
+		 function,
+		 sector_number,
+		 expected_sector_number );
+
+		return( -1 );
+	}
+	if( ( compressed_data_size == 0 )
+	 || ( (size_t) compressed_data_size > ( stream_grain->block_data_size - 12 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid compressed data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	uncompressed_data_size = stream_grain->data_size;
+
+	if( libvmdk_decompress_data(
+	     &( stream_grain->block_data[ 12 ] ),
+	     (size_t) compressed_data_size,
+	     LIBVMDK_COMPRESSION_METHOD_DEFLATE,
+	     stream_grain->data,
+	     &uncompressed_data_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_DECOMPRESS_FAILED,
+		 "%s: unable to decompress grain data.",
+		 function );
+
+		return( -1 );
+	}
+	if( uncompressed_data_size != stream_grain->data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_VALUE_MISMATCH,
+		 "%s: mismatch in uncompressed data size: %" PRIzd " (expected: %" PRIzd ").",
+		 function,
+		 uncompressed_data_size,
+		 stream_grain->data_size );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
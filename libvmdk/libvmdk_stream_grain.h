@@ -0,0 +1,100 @@
+/*
+ * Stream-optimized grain functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_STREAM_GRAIN_H )
+#define _LIBVMDK_STREAM_GRAIN_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_stream_grain libvmdk_stream_grain_t;
+
+struct libvmdk_stream_grain
+{
+	/* The grain index
+	 */
+	uint64_t grain_index;
+
+	/* The (uncompressed) data
+	 */
+	uint8_t *data;
+
+	/* The (uncompressed) data size
+	 */
+	size_t data_size;
+
+	/* The block data
+	 * Contains the grain marker followed by the compressed data
+	 */
+	uint8_t *block_data;
+
+	/* The allocated block data size
+	 */
+	size_t allocated_block_data_size;
+
+	/* The block data size
+	 * A multitude of the sector size
+	 */
+	size_t block_data_size;
+
+	/* Value to indicate the grain is sparse
+	 */
+	uint8_t is_sparse;
+
+	/* Value to indicate the grain was processed
+	 */
+	uint8_t is_processed;
+
+	/* The result of processing the grain
+	 */
+	int result;
+};
+
+int libvmdk_stream_grain_initialize(
+     libvmdk_stream_grain_t **stream_grain,
+     size_t grain_size,
+     libcerror_error_t **error );
+
+int libvmdk_stream_grain_free(
+     libvmdk_stream_grain_t **stream_grain,
+     libcerror_error_t **error );
+
+int libvmdk_stream_grain_compress(
+     libvmdk_stream_grain_t *stream_grain,
+     int compression_level,
+     libcerror_error_t **error );
+
+int libvmdk_stream_grain_decompress(
+     libvmdk_stream_grain_t *stream_grain,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_STREAM_GRAIN_H ) */
+
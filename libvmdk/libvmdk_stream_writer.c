@@ -0,0 +1,2415 @@
+/*
+ * Stream-optimized writer functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_delta_disk.h"
+#include "libvmdk_extent_file.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcnotify.h"
+#include "libvmdk_libcpath.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_stream_grain.h"
+#include "libvmdk_stream_writer.h"
+
+#include "vmdk_sparse_file_header.h"
+
+/* The number of sectors reserved for the embedded descriptor
+ */
+#define LIBVMDK_STREAM_WRITER_DESCRIPTOR_NUMBER_OF_SECTORS	20
+
+/* Creates a stream writer
+ * Make sure the value stream_writer is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_writer_initialize(
+     libvmdk_stream_writer_t **stream_writer,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_writer_t *internal_stream_writer = NULL;
+	static char *function                                    = "libvmdk_stream_writer_initialize";
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_writer != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream writer value already set.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer = memory_allocate_structure(
+	                          libvmdk_internal_stream_writer_t );
+
+	if( internal_stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     internal_stream_writer,
+	     0,
+	     sizeof( libvmdk_internal_stream_writer_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stream writer.",
+		 function );
+
+		memory_free(
+		 internal_stream_writer );
+
+		return( -1 );
+	}
+	internal_stream_writer->grain_size                    = 128 * 512;
+	internal_stream_writer->number_of_grain_table_entries = 512;
+	internal_stream_writer->compression_level             = 6;
+
+	*stream_writer = (libvmdk_stream_writer_t *) internal_stream_writer;
+
+	return( 1 );
+}
+
+/* Frees a stream writer
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_writer_free(
+     libvmdk_stream_writer_t **stream_writer,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_writer_t *internal_stream_writer = NULL;
+	static char *function                                    = "libvmdk_stream_writer_free";
+	int result                                               = 1;
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( *stream_writer != NULL )
+	{
+		internal_stream_writer = (libvmdk_internal_stream_writer_t *) *stream_writer;
+
+		if( internal_stream_writer->file_io_handle != NULL )
+		{
+			if( libvmdk_stream_writer_close(
+			     *stream_writer,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close stream writer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		*stream_writer = NULL;
+
+		memory_free(
+		 internal_stream_writer );
+	}
+	return( result );
+}
+
+/* Sets the media size
+ * The media size must be set before the stream writer is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_writer_set_media_size(
+     libvmdk_stream_writer_t *stream_writer,
+     size64_t media_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_writer_t *internal_stream_writer = NULL;
+	static char *function                                    = "libvmdk_stream_writer_set_media_size";
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer = (libvmdk_internal_stream_writer_t *) stream_writer;
+
+	if( internal_stream_writer->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream writer - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( media_size == 0 )
+	 || ( ( media_size % 512 ) != 0 )
+	 || ( media_size > (size64_t) INT64_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer->media_size = media_size;
+
+	return( 1 );
+}
+
+/* Sets the grain size
+ * The grain size must be a power of 2 of at least 8 KiB (16 sectors) and at most 1 MiB,
+ * the default is 64 KiB (128 sectors)
+ * The grain size must be set before the stream writer is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_writer_set_grain_size(
+     libvmdk_stream_writer_t *stream_writer,
+     size64_t grain_size,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_writer_t *internal_stream_writer = NULL;
+	static char *function                                    = "libvmdk_stream_writer_set_grain_size";
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer = (libvmdk_internal_stream_writer_t *) stream_writer;
+
+	if( internal_stream_writer->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream writer - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_delta_disk_is_supported_grain_size(
+	     grain_size ) == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported grain size: %" PRIu64 ".",
+		 function,
+		 grain_size );
+
+		return( -1 );
+	}
+	internal_stream_writer->grain_size = grain_size;
+
+	return( 1 );
+}
+
+/* Sets the number of threads used to compress the grains
+ * A value of 0 compresses the grains in the calling thread
+ * The number of threads must be set before the stream writer is opened
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_writer_set_number_of_threads(
+     libvmdk_stream_writer_t *stream_writer,
+     int number_of_threads,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_writer_t *internal_stream_writer = NULL;
+	static char *function                                    = "libvmdk_stream_writer_set_number_of_threads";
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer = (libvmdk_internal_stream_writer_t *) stream_writer;
+
+	if( internal_stream_writer->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream writer - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( number_of_threads < 0 )
+	 || ( number_of_threads > LIBVMDK_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of threads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if !defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: multi-threading not supported.",
+		 function );
+
+		return( -1 );
+	}
+#endif
+	internal_stream_writer->number_of_threads = number_of_threads;
+
+	return( 1 );
+}
+
+/* Opens a stream-optimized VMDK file for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_writer_open(
+     libvmdk_stream_writer_t *stream_writer,
+     const char *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle                         = NULL;
+	libvmdk_internal_stream_writer_t *internal_stream_writer = NULL;
+	const char *basename                                     = NULL;
+	static char *function                                    = "libvmdk_stream_writer_open";
+	size_t basename_length                                   = 0;
+	size_t filename_length                                   = 0;
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer = (libvmdk_internal_stream_writer_t *) stream_writer;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = narrow_string_length(
+	                   filename );
+
+	/* The embedded descriptor refers to the extent by its basename
+	 */
+	basename = narrow_string_search_character_reverse(
+	            filename,
+	            (int) LIBCPATH_SEPARATOR,
+	            filename_length + 1 );
+
+	if( basename != NULL )
+	{
+		basename += 1;
+	}
+	else
+	{
+		basename = filename;
+	}
+	basename_length = narrow_string_length(
+	                   basename );
+
+	if( ( basename_length == 0 )
+	 || ( basename_length >= 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( narrow_string_copy(
+	     internal_stream_writer->extent_filename,
+	     basename,
+	     basename_length + 1 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy extent filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_stream_writer_open_file_io_handle(
+	     stream_writer,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open stream writer using a file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	internal_stream_writer->file_io_handle_created_in_library = 1;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Opens a stream-optimized VMDK file for writing
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_writer_open_wide(
+     libvmdk_stream_writer_t *stream_writer,
+     const wchar_t *filename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle                         = NULL;
+	libvmdk_internal_stream_writer_t *internal_stream_writer = NULL;
+	const wchar_t *basename                                  = NULL;
+	static char *function                                    = "libvmdk_stream_writer_open_wide";
+	size_t basename_index                                    = 0;
+	size_t basename_length                                   = 0;
+	size_t filename_length                                   = 0;
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer = (libvmdk_internal_stream_writer_t *) stream_writer;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = wide_string_length(
+	                   filename );
+
+	/* The embedded descriptor refers to the extent by its basename
+	 */
+	basename = wide_string_search_character_reverse(
+	            filename,
+	            (wint_t) LIBCPATH_SEPARATOR,
+	            filename_length + 1 );
+
+	if( basename != NULL )
+	{
+		basename += 1;
+	}
+	else
+	{
+		basename = filename;
+	}
+	basename_length = wide_string_length(
+	                   basename );
+
+	if( ( basename_length == 0 )
+	 || ( basename_length >= 256 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	/* Non ASCII characters are replaced by an underscore
+	 */
+	for( basename_index = 0;
+	     basename_index < basename_length;
+	     basename_index++ )
+	{
+		if( basename[ basename_index ] < 0x80 )
+		{
+			internal_stream_writer->extent_filename[ basename_index ] = (char) basename[ basename_index ];
+		}
+		else
+		{
+			internal_stream_writer->extent_filename[ basename_index ] = '_';
+		}
+	}
+	internal_stream_writer->extent_filename[ basename_length ] = 0;
+
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_set_name_wide(
+	     file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set name in file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_stream_writer_open_file_io_handle(
+	     stream_writer,
+	     file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open stream writer using a file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	internal_stream_writer->file_io_handle_created_in_library = 1;
+
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Opens a stream-optimized VMDK file for writing using a Basic File IO (bfio) handle
+ * The file IO handle is only written sequentially hence it can refer to a pipe
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_stream_writer_open_file_io_handle(
+     libvmdk_stream_writer_t *stream_writer,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_writer_t *internal_stream_writer = NULL;
+	static char *function                                    = "libvmdk_stream_writer_open_file_io_handle";
+	size64_t grain_table_media_size                          = 0;
+	int file_io_handle_is_open                               = 0;
+	int stream_grain_index                                   = 0;
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer = (libvmdk_internal_stream_writer_t *) stream_writer;
+
+	if( internal_stream_writer->file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid stream writer - file IO handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream_writer->media_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream writer - missing media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream_writer->extent_filename[ 0 ] == 0 )
+	{
+		if( narrow_string_copy(
+		     internal_stream_writer->extent_filename,
+		     "image.vmdk",
+		     11 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy extent filename.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	grain_table_media_size = (size64_t) internal_stream_writer->number_of_grain_table_entries * internal_stream_writer->grain_size;
+
+	if( ( internal_stream_writer->media_size / grain_table_media_size ) >= (size64_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid media size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer->number_of_grain_directory_entries = (uint32_t) ( internal_stream_writer->media_size / grain_table_media_size );
+
+	if( ( internal_stream_writer->media_size % grain_table_media_size ) != 0 )
+	{
+		internal_stream_writer->number_of_grain_directory_entries += 1;
+	}
+	internal_stream_writer->grain_directory_size = (size_t) internal_stream_writer->number_of_grain_directory_entries * 4;
+
+	if( ( internal_stream_writer->grain_directory_size % 512 ) != 0 )
+	{
+		internal_stream_writer->grain_directory_size += 512 - ( internal_stream_writer->grain_directory_size % 512 );
+	}
+	internal_stream_writer->grain_table_size = (size_t) internal_stream_writer->number_of_grain_table_entries * 4;
+
+	internal_stream_writer->grain_directory_data = (uint8_t *) memory_allocate(
+	                                                            sizeof( uint8_t ) * internal_stream_writer->grain_directory_size );
+
+	if( internal_stream_writer->grain_directory_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain directory data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_stream_writer->grain_directory_data,
+	     0,
+	     internal_stream_writer->grain_directory_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain directory data.",
+		 function );
+
+		goto on_error;
+	}
+	internal_stream_writer->grain_table_data = (uint8_t *) memory_allocate(
+	                                                        sizeof( uint8_t ) * internal_stream_writer->grain_table_size );
+
+	if( internal_stream_writer->grain_table_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain table data.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_stream_writer->grain_table_data,
+	     0,
+	     internal_stream_writer->grain_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain table data.",
+		 function );
+
+		goto on_error;
+	}
+	/* Keep twice as many grains as threads in flight so the compression threads
+	 * are kept busy while the oldest grain is being written
+	 */
+	if( internal_stream_writer->number_of_threads > 0 )
+	{
+		internal_stream_writer->number_of_stream_grains = 2 * internal_stream_writer->number_of_threads;
+	}
+	else
+	{
+		internal_stream_writer->number_of_stream_grains = 1;
+	}
+	internal_stream_writer->stream_grains = (libvmdk_stream_grain_t **) memory_allocate(
+	                                                                     sizeof( libvmdk_stream_grain_t * ) * internal_stream_writer->number_of_stream_grains );
+
+	if( internal_stream_writer->stream_grains == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create stream grains.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     internal_stream_writer->stream_grains,
+	     0,
+	     sizeof( libvmdk_stream_grain_t * ) * internal_stream_writer->number_of_stream_grains ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear stream grains.",
+		 function );
+
+		goto on_error;
+	}
+	for( stream_grain_index = 0;
+	     stream_grain_index < internal_stream_writer->number_of_stream_grains;
+	     stream_grain_index++ )
+	{
+		if( libvmdk_stream_grain_initialize(
+		     &( internal_stream_writer->stream_grains[ stream_grain_index ] ),
+		     (size_t) internal_stream_writer->grain_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create stream grain: %d.",
+			 function,
+			 stream_grain_index );
+
+			goto on_error;
+		}
+	}
+	file_io_handle_is_open = libbfio_handle_is_open(
+	                          file_io_handle,
+	                          error );
+
+	if( file_io_handle_is_open == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file.",
+		 function );
+
+		goto on_error;
+	}
+	else if( file_io_handle_is_open == 0 )
+	{
+		if( libbfio_handle_open(
+		     file_io_handle,
+		     LIBBFIO_OPEN_WRITE_TRUNCATE,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+		internal_stream_writer->file_io_handle_opened_in_library = 1;
+	}
+	internal_stream_writer->file_io_handle                   = file_io_handle;
+	internal_stream_writer->content_identifier               = (uint32_t) time( NULL );
+	internal_stream_writer->current_offset                   = 0;
+	internal_stream_writer->file_offset                      = 0;
+	internal_stream_writer->grain_table_index                = 0;
+	internal_stream_writer->number_of_grain_table_grains     = 0;
+	internal_stream_writer->first_pending_stream_grain       = 0;
+	internal_stream_writer->number_of_pending_stream_grains  = 0;
+	internal_stream_writer->stream_grain_data_offset         = 0;
+
+	if( libvmdk_internal_stream_writer_write_header(
+	     internal_stream_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write file header.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( internal_stream_writer->number_of_threads > 0 )
+	{
+		if( libcthreads_mutex_initialize(
+		     &( internal_stream_writer->stream_grains_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create stream grains mutex.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_condition_initialize(
+		     &( internal_stream_writer->stream_grains_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create stream grains condition.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcthreads_thread_pool_create(
+		     &( internal_stream_writer->compression_thread_pool ),
+		     NULL,
+		     internal_stream_writer->number_of_threads,
+		     internal_stream_writer->number_of_stream_grains,
+		     (int (*)(intptr_t *, void *)) &libvmdk_internal_stream_writer_compress_stream_grain_callback,
+		     (void *) internal_stream_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create compression thread pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#endif
+	return( 1 );
+
+on_error:
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( internal_stream_writer->stream_grains_condition != NULL )
+	{
+		libcthreads_condition_free(
+		 &( internal_stream_writer->stream_grains_condition ),
+		 NULL );
+	}
+	if( internal_stream_writer->stream_grains_mutex != NULL )
+	{
+		libcthreads_mutex_free(
+		 &( internal_stream_writer->stream_grains_mutex ),
+		 NULL );
+	}
+#endif
+	if( internal_stream_writer->file_io_handle_opened_in_library != 0 )
+	{
+		libbfio_handle_close(
+		 file_io_handle,
+		 NULL );
+
+		internal_stream_writer->file_io_handle_opened_in_library = 0;
+	}
+	internal_stream_writer->file_io_handle = NULL;
+
+	if( internal_stream_writer->stream_grains != NULL )
+	{
+		for( stream_grain_index = 0;
+		     stream_grain_index < internal_stream_writer->number_of_stream_grains;
+		     stream_grain_index++ )
+		{
+			if( internal_stream_writer->stream_grains[ stream_grain_index ] != NULL )
+			{
+				libvmdk_stream_grain_free(
+				 &( internal_stream_writer->stream_grains[ stream_grain_index ] ),
+				 NULL );
+			}
+		}
+		memory_free(
+		 internal_stream_writer->stream_grains );
+
+		internal_stream_writer->stream_grains = NULL;
+	}
+	internal_stream_writer->number_of_stream_grains = 0;
+
+	if( internal_stream_writer->grain_table_data != NULL )
+	{
+		memory_free(
+		 internal_stream_writer->grain_table_data );
+
+		internal_stream_writer->grain_table_data = NULL;
+	}
+	if( internal_stream_writer->grain_directory_data != NULL )
+	{
+		memory_free(
+		 internal_stream_writer->grain_directory_data );
+
+		internal_stream_writer->grain_directory_data = NULL;
+	}
+	return( -1 );
+}
+
+/* Closes a stream writer
+ * This writes the remaining grains, the last grain table, the grain directory, the footer
+ * and the end-of-stream marker
+ * Returns 0 if successful or -1 on error
+ */
+int libvmdk_stream_writer_close(
+     libvmdk_stream_writer_t *stream_writer,
+     libcerror_error_t **error )
+{
+	libvmdk_internal_stream_writer_t *internal_stream_writer = NULL;
+	libvmdk_stream_grain_t *stream_grain                     = NULL;
+	static char *function                                    = "libvmdk_stream_writer_close";
+	int stream_grain_index                                   = 0;
+	int result                                               = 0;
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer = (libvmdk_internal_stream_writer_t *) stream_writer;
+
+	if( internal_stream_writer->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream writer - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	/* The last grain is padded with 0-byte values
+	 */
+	if( internal_stream_writer->stream_grain_data_offset > 0 )
+	{
+		stream_grain_index = ( internal_stream_writer->first_pending_stream_grain + internal_stream_writer->number_of_pending_stream_grains )
+		                   % internal_stream_writer->number_of_stream_grains;
+
+		stream_grain = internal_stream_writer->stream_grains[ stream_grain_index ];
+
+		if( memory_set(
+		     &( stream_grain->data[ internal_stream_writer->stream_grain_data_offset ] ),
+		     0,
+		     stream_grain->data_size - internal_stream_writer->stream_grain_data_offset ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear grain data.",
+			 function );
+
+			result = -1;
+		}
+		else if( libvmdk_internal_stream_writer_submit_stream_grain(
+		          internal_stream_writer,
+		          error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to submit last grain.",
+			 function );
+
+			result = -1;
+		}
+	}
+	while( ( result == 0 )
+	    && ( internal_stream_writer->number_of_pending_stream_grains > 0 ) )
+	{
+		if( libvmdk_internal_stream_writer_write_pending_stream_grain(
+		     internal_stream_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write pending grain.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( result == 0 )
+	{
+		if( libvmdk_internal_stream_writer_write_footer(
+		     internal_stream_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write footer.",
+			 function );
+
+			result = -1;
+		}
+	}
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* Joining the thread pool waits for the grains that are still being compressed
+	 */
+	if( internal_stream_writer->compression_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_join(
+		     &( internal_stream_writer->compression_thread_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to join compression thread pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_stream_writer->stream_grains_condition != NULL )
+	{
+		if( libcthreads_condition_free(
+		     &( internal_stream_writer->stream_grains_condition ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free stream grains condition.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( internal_stream_writer->stream_grains_mutex != NULL )
+	{
+		if( libcthreads_mutex_free(
+		     &( internal_stream_writer->stream_grains_mutex ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free stream grains mutex.",
+			 function );
+
+			result = -1;
+		}
+	}
+#endif
+	if( internal_stream_writer->file_io_handle_opened_in_library != 0 )
+	{
+		if( libbfio_handle_close(
+		     internal_stream_writer->file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		internal_stream_writer->file_io_handle_opened_in_library = 0;
+	}
+	if( internal_stream_writer->file_io_handle_created_in_library != 0 )
+	{
+		if( libbfio_handle_free(
+		     &( internal_stream_writer->file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		internal_stream_writer->file_io_handle_created_in_library = 0;
+	}
+	internal_stream_writer->file_io_handle = NULL;
+
+	for( stream_grain_index = 0;
+	     stream_grain_index < internal_stream_writer->number_of_stream_grains;
+	     stream_grain_index++ )
+	{
+		if( libvmdk_stream_grain_free(
+		     &( internal_stream_writer->stream_grains[ stream_grain_index ] ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free stream grain: %d.",
+			 function,
+			 stream_grain_index );
+
+			result = -1;
+		}
+	}
+	memory_free(
+	 internal_stream_writer->stream_grains );
+
+	internal_stream_writer->stream_grains                   = NULL;
+	internal_stream_writer->number_of_stream_grains         = 0;
+	internal_stream_writer->number_of_pending_stream_grains = 0;
+
+	memory_free(
+	 internal_stream_writer->grain_table_data );
+
+	internal_stream_writer->grain_table_data = NULL;
+
+	memory_free(
+	 internal_stream_writer->grain_directory_data );
+
+	internal_stream_writer->grain_directory_data = NULL;
+
+	return( result );
+}
+
+/* Copies the sparse file header to the data
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_writer_copy_file_header(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     uint64_t grain_directory_sector_number,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	vmdk_sparse_file_header_t *file_header = NULL;
+	static char *function                  = "libvmdk_internal_stream_writer_copy_file_header";
+	uint64_t metadata_number_of_sectors    = 0;
+
+	if( internal_stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < sizeof( vmdk_sparse_file_header_t ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     data,
+	     0,
+	     sizeof( vmdk_sparse_file_header_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear file header.",
+		 function );
+
+		return( -1 );
+	}
+	file_header = (vmdk_sparse_file_header_t *) data;
+
+	/* The metadata consists of the file header and the embedded descriptor
+	 * and is rounded up to the grain size
+	 */
+	metadata_number_of_sectors = 1 + LIBVMDK_STREAM_WRITER_DESCRIPTOR_NUMBER_OF_SECTORS;
+
+	if( ( metadata_number_of_sectors % ( internal_stream_writer->grain_size / 512 ) ) != 0 )
+	{
+		metadata_number_of_sectors += ( internal_stream_writer->grain_size / 512 )
+		                            - ( metadata_number_of_sectors % ( internal_stream_writer->grain_size / 512 ) );
+	}
+	if( memory_copy(
+	     file_header->signature,
+	     vmdk_sparse_file_signature,
+	     4 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy signature.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->version,
+	 3 );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->flags,
+	 LIBVMDK_FLAG_NEW_LINE_DETECION_VALID | LIBVMDK_FLAG_HAS_GRAIN_COMPRESSION | LIBVMDK_FLAG_HAS_DATA_MARKERS );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->maximum_data_number_of_sectors,
+	 internal_stream_writer->media_size / 512 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->grain_number_of_sectors,
+	 internal_stream_writer->grain_size / 512 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->descriptor_sector_number,
+	 (uint64_t) 1 );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->descriptor_number_of_sectors,
+	 (uint64_t) LIBVMDK_STREAM_WRITER_DESCRIPTOR_NUMBER_OF_SECTORS );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 file_header->number_of_grain_table_entries,
+	 internal_stream_writer->number_of_grain_table_entries );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->primary_grain_directory_sector_number,
+	 grain_directory_sector_number );
+
+	byte_stream_copy_from_uint64_little_endian(
+	 file_header->metadata_number_of_sectors,
+	 metadata_number_of_sectors );
+
+	file_header->single_end_of_line_character        = (uint8_t) '\n';
+	file_header->non_end_of_line_character           = (uint8_t) ' ';
+	file_header->first_double_end_of_line_character  = (uint8_t) '\r';
+	file_header->second_double_end_of_line_character = (uint8_t) '\n';
+
+	byte_stream_copy_from_uint16_little_endian(
+	 file_header->compression_method,
+	 LIBVMDK_COMPRESSION_METHOD_DEFLATE );
+
+	return( 1 );
+}
+
+/* Writes the file header, the embedded descriptor and the metadata padding
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_writer_write_header(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libcerror_error_t **error )
+{
+	uint8_t *metadata                   = NULL;
+	static char *function               = "libvmdk_internal_stream_writer_write_header";
+	size64_t number_of_cylinders        = 0;
+	size_t descriptor_size              = 0;
+	size_t metadata_size                = 0;
+	ssize_t write_count                 = 0;
+	int print_count                     = 0;
+
+	if( internal_stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	metadata_size = 512 + ( LIBVMDK_STREAM_WRITER_DESCRIPTOR_NUMBER_OF_SECTORS * 512 );
+
+	if( ( metadata_size % internal_stream_writer->grain_size ) != 0 )
+	{
+		metadata_size += (size_t) ( internal_stream_writer->grain_size - ( metadata_size % internal_stream_writer->grain_size ) );
+	}
+	metadata = (uint8_t *) memory_allocate(
+	                        sizeof( uint8_t ) * metadata_size );
+
+	if( metadata == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create metadata.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     metadata,
+	     0,
+	     metadata_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear metadata.",
+		 function );
+
+		goto on_error;
+	}
+	/* The grain directory is stored at the end of the stream (GD_AT_END)
+	 * its location is stored in the footer
+	 */
+	if( libvmdk_internal_stream_writer_copy_file_header(
+	     internal_stream_writer,
+	     (uint64_t) -1,
+	     metadata,
+	     512,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to copy file header.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_cylinders = internal_stream_writer->media_size / ( 255 * 63 * 512 );
+
+	if( number_of_cylinders > 65535 )
+	{
+		number_of_cylinders = 65535;
+	}
+	descriptor_size = LIBVMDK_STREAM_WRITER_DESCRIPTOR_NUMBER_OF_SECTORS * 512;
+
+	print_count = narrow_string_snprintf(
+	               (char *) &( metadata[ 512 ] ),
+	               descriptor_size,
+	               "# Disk DescriptorFile\n"
+	               "version=1\n"
+	               "CID=%08" PRIx32 "\n"
+	               "parentCID=ffffffff\n"
+	               "createType=\"streamOptimized\"\n"
+	               "\n"
+	               "# Extent description\n"
+	               "RW %" PRIu64 " SPARSE \"%s\"\n"
+	               "\n"
+	               "# The Disk Data Base\n"
+	               "#DDB\n"
+	               "\n"
+	               "ddb.virtualHWVersion = \"4\"\n"
+	               "ddb.geometry.cylinders = \"%" PRIu64 "\"\n"
+	               "ddb.geometry.heads = \"255\"\n"
+	               "ddb.geometry.sectors = \"63\"\n"
+	               "ddb.adapterType = \"lsilogic\"\n",
+	               internal_stream_writer->content_identifier,
+	               internal_stream_writer->media_size / 512,
+	               internal_stream_writer->extent_filename,
+	               number_of_cylinders );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= descriptor_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               internal_stream_writer->file_io_handle,
+	               metadata,
+	               metadata_size,
+	               error );
+
+	if( write_count != (ssize_t) metadata_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write metadata.",
+		 function );
+
+		goto on_error;
+	}
+	internal_stream_writer->file_offset += (off64_t) metadata_size;
+
+	memory_free(
+	 metadata );
+
+	return( 1 );
+
+on_error:
+	if( metadata != NULL )
+	{
+		memory_free(
+		 metadata );
+	}
+	return( -1 );
+}
+
+/* Writes a metadata marker
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_writer_write_marker(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     uint64_t number_of_sectors,
+     uint32_t marker_type,
+     libcerror_error_t **error )
+{
+	uint8_t marker_data[ 512 ];
+
+	static char *function = "libvmdk_internal_stream_writer_write_marker";
+	ssize_t write_count   = 0;
+
+	if( internal_stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     marker_data,
+	     0,
+	     512 ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear marker data.",
+		 function );
+
+		return( -1 );
+	}
+	/* The value of a metadata marker contains the number of sectors of the metadata
+	 * that follows the marker, the marker data size is 0
+	 */
+	byte_stream_copy_from_uint64_little_endian(
+	 &( marker_data[ 0 ] ),
+	 number_of_sectors );
+
+	byte_stream_copy_from_uint32_little_endian(
+	 &( marker_data[ 12 ] ),
+	 marker_type );
+
+	write_count = libbfio_handle_write_buffer(
+	               internal_stream_writer->file_io_handle,
+	               marker_data,
+	               512,
+	               error );
+
+	if( write_count != (ssize_t) 512 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write marker.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer->file_offset += 512;
+
+	return( 1 );
+}
+
+/* Writes the current grain table
+ * Grain tables without allocated grains are not written
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_writer_write_grain_table(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_internal_stream_writer_write_grain_table";
+	ssize_t write_count   = 0;
+
+	if( internal_stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream_writer->number_of_grain_table_grains == 0 )
+	{
+		return( 1 );
+	}
+	if( internal_stream_writer->grain_table_index >= internal_stream_writer->number_of_grain_directory_entries )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid grain table index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_internal_stream_writer_write_marker(
+	     internal_stream_writer,
+	     (uint64_t) ( internal_stream_writer->grain_table_size / 512 ),
+	     LIBVMDK_MARKER_GRAIN_TABLE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write grain table marker.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( internal_stream_writer->file_offset / 512 ) > (off64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( internal_stream_writer->grain_directory_data[ internal_stream_writer->grain_table_index * 4 ] ),
+	 (uint32_t) ( internal_stream_writer->file_offset / 512 ) );
+
+	write_count = libbfio_handle_write_buffer(
+	               internal_stream_writer->file_io_handle,
+	               internal_stream_writer->grain_table_data,
+	               internal_stream_writer->grain_table_size,
+	               error );
+
+	if( write_count != (ssize_t) internal_stream_writer->grain_table_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write grain table.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer->file_offset += (off64_t) internal_stream_writer->grain_table_size;
+
+	if( memory_set(
+	     internal_stream_writer->grain_table_data,
+	     0,
+	     internal_stream_writer->grain_table_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear grain table data.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer->number_of_grain_table_grains = 0;
+
+	return( 1 );
+}
+
+/* Writes the last grain table, the grain directory, the footer and the end-of-stream marker
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_writer_write_footer(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ 512 ];
+
+	static char *function                  = "libvmdk_internal_stream_writer_write_footer";
+	uint64_t grain_directory_sector_number = 0;
+	ssize_t write_count                    = 0;
+
+	if( internal_stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_internal_stream_writer_write_grain_table(
+	     internal_stream_writer,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write grain table.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_internal_stream_writer_write_marker(
+	     internal_stream_writer,
+	     (uint64_t) ( internal_stream_writer->grain_directory_size / 512 ),
+	     LIBVMDK_MARKER_GRAIN_DIRECTORY,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write grain directory marker.",
+		 function );
+
+		return( -1 );
+	}
+	grain_directory_sector_number = (uint64_t) ( internal_stream_writer->file_offset / 512 );
+
+	write_count = libbfio_handle_write_buffer(
+	               internal_stream_writer->file_io_handle,
+	               internal_stream_writer->grain_directory_data,
+	               internal_stream_writer->grain_directory_size,
+	               error );
+
+	if( write_count != (ssize_t) internal_stream_writer->grain_directory_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer->file_offset += (off64_t) internal_stream_writer->grain_directory_size;
+
+	if( libvmdk_internal_stream_writer_write_marker(
+	     internal_stream_writer,
+	     1,
+	     LIBVMDK_MARKER_FOOTER,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write footer marker.",
+		 function );
+
+		return( -1 );
+	}
+	/* The footer is a copy of the file header that contains the grain directory sector number
+	 */
+	if( libvmdk_internal_stream_writer_copy_file_header(
+	     internal_stream_writer,
+	     grain_directory_sector_number,
+	     file_header_data,
+	     512,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to copy footer.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               internal_stream_writer->file_io_handle,
+	               file_header_data,
+	               512,
+	               error );
+
+	if( write_count != (ssize_t) 512 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write footer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer->file_offset += 512;
+
+	if( libvmdk_internal_stream_writer_write_marker(
+	     internal_stream_writer,
+	     0,
+	     LIBVMDK_MARKER_END_OF_STREAM,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write end-of-stream marker.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Writes a compressed stream grain
+ * The stream grains must be written in order of their grain index
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_writer_write_stream_grain(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libvmdk_stream_grain_t *stream_grain,
+     libcerror_error_t **error )
+{
+	static char *function      = "libvmdk_internal_stream_writer_write_stream_grain";
+	ssize_t write_count        = 0;
+	uint64_t grain_table_index = 0;
+	uint32_t grain_table_entry = 0;
+
+	if( internal_stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( stream_grain == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream grain.",
+		 function );
+
+		return( -1 );
+	}
+	grain_table_index = stream_grain->grain_index / internal_stream_writer->number_of_grain_table_entries;
+	grain_table_entry = (uint32_t) ( stream_grain->grain_index % internal_stream_writer->number_of_grain_table_entries );
+
+	if( grain_table_index != (uint64_t) internal_stream_writer->grain_table_index )
+	{
+		if( libvmdk_internal_stream_writer_write_grain_table(
+		     internal_stream_writer,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write grain table.",
+			 function );
+
+			return( -1 );
+		}
+		internal_stream_writer->grain_table_index = (uint32_t) grain_table_index;
+	}
+	if( stream_grain->is_sparse != 0 )
+	{
+		return( 1 );
+	}
+	if( ( internal_stream_writer->file_offset / 512 ) > (off64_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file offset value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	write_count = libbfio_handle_write_buffer(
+	               internal_stream_writer->file_io_handle,
+	               stream_grain->block_data,
+	               stream_grain->block_data_size,
+	               error );
+
+	if( write_count != (ssize_t) stream_grain->block_data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write grain: %" PRIu64 ".",
+		 function,
+		 stream_grain->grain_index );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_little_endian(
+	 &( internal_stream_writer->grain_table_data[ grain_table_entry * 4 ] ),
+	 (uint32_t) ( internal_stream_writer->file_offset / 512 ) );
+
+	internal_stream_writer->file_offset                  += (off64_t) stream_grain->block_data_size;
+	internal_stream_writer->number_of_grain_table_grains += 1;
+
+	return( 1 );
+}
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+/* Compresses a stream grain from a compression thread
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_writer_compress_stream_grain_callback(
+     libvmdk_stream_grain_t *stream_grain,
+     libvmdk_internal_stream_writer_t *internal_stream_writer )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "libvmdk_internal_stream_writer_compress_stream_grain_callback";
+	int result               = 0;
+
+	if( ( stream_grain == NULL )
+	 || ( internal_stream_writer == NULL ) )
+	{
+		return( -1 );
+	}
+	result = libvmdk_stream_grain_compress(
+	          stream_grain,
+	          internal_stream_writer->compression_level,
+	          &error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress grain: %" PRIu64 ".",
+		 function,
+		 stream_grain->grain_index );
+
+#if defined( HAVE_DEBUG_OUTPUT )
+		if( libcnotify_verbose != 0 )
+		{
+			libcnotify_print_error_backtrace(
+			 error );
+		}
+#endif
+		libcerror_error_free(
+		 &error );
+	}
+	/* Signal the writer that the stream grain was processed
+	 */
+	if( libcthreads_mutex_grab(
+	     internal_stream_writer->stream_grains_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	stream_grain->result       = result;
+	stream_grain->is_processed = 1;
+
+	if( libcthreads_condition_broadcast(
+	     internal_stream_writer->stream_grains_condition,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	if( libcthreads_mutex_release(
+	     internal_stream_writer->stream_grains_mutex,
+	     NULL ) != 1 )
+	{
+		return( -1 );
+	}
+	return( result );
+}
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+/* Submits the stream grain that is being filled for compression
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_writer_submit_stream_grain(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libcerror_error_t **error )
+{
+	libvmdk_stream_grain_t *stream_grain = NULL;
+	static char *function                = "libvmdk_internal_stream_writer_submit_stream_grain";
+	int stream_grain_index               = 0;
+
+	if( internal_stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream_writer->number_of_pending_stream_grains >= internal_stream_writer->number_of_stream_grains )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of pending stream grains value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	stream_grain_index = ( internal_stream_writer->first_pending_stream_grain + internal_stream_writer->number_of_pending_stream_grains )
+	                   % internal_stream_writer->number_of_stream_grains;
+
+	stream_grain = internal_stream_writer->stream_grains[ stream_grain_index ];
+
+	stream_grain->is_processed = 0;
+	stream_grain->result       = 0;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( internal_stream_writer->compression_thread_pool != NULL )
+	{
+		if( libcthreads_thread_pool_push(
+		     internal_stream_writer->compression_thread_pool,
+		     (intptr_t *) stream_grain,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push stream grain onto compression thread pool.",
+			 function );
+
+			return( -1 );
+		}
+		internal_stream_writer->number_of_pending_stream_grains += 1;
+		internal_stream_writer->stream_grain_data_offset         = 0;
+
+		return( 1 );
+	}
+#endif
+	stream_grain->result = libvmdk_stream_grain_compress(
+	                        stream_grain,
+	                        internal_stream_writer->compression_level,
+	                        error );
+
+	if( stream_grain->result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress grain: %" PRIu64 ".",
+		 function,
+		 stream_grain->grain_index );
+
+		return( -1 );
+	}
+	stream_grain->is_processed = 1;
+
+	internal_stream_writer->number_of_pending_stream_grains += 1;
+	internal_stream_writer->stream_grain_data_offset         = 0;
+
+	return( 1 );
+}
+
+/* Writes the first pending stream grain
+ * Waits for the compression threads if the stream grain has not been processed yet
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_internal_stream_writer_write_pending_stream_grain(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libcerror_error_t **error )
+{
+	libvmdk_stream_grain_t *stream_grain = NULL;
+	static char *function                = "libvmdk_internal_stream_writer_write_pending_stream_grain";
+
+	if( internal_stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	if( internal_stream_writer->number_of_pending_stream_grains <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream writer - missing pending stream grains.",
+		 function );
+
+		return( -1 );
+	}
+	stream_grain = internal_stream_writer->stream_grains[ internal_stream_writer->first_pending_stream_grain ];
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	if( internal_stream_writer->compression_thread_pool != NULL )
+	{
+		if( libcthreads_mutex_grab(
+		     internal_stream_writer->stream_grains_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to grab stream grains mutex.",
+			 function );
+
+			return( -1 );
+		}
+		while( stream_grain->is_processed == 0 )
+		{
+			if( libcthreads_condition_wait(
+			     internal_stream_writer->stream_grains_condition,
+			     internal_stream_writer->stream_grains_mutex,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to wait for stream grains condition.",
+				 function );
+
+				libcthreads_mutex_release(
+				 internal_stream_writer->stream_grains_mutex,
+				 NULL );
+
+				return( -1 );
+			}
+		}
+		if( libcthreads_mutex_release(
+		     internal_stream_writer->stream_grains_mutex,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to release stream grains mutex.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	if( stream_grain->result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_COMPRESSION,
+		 LIBCERROR_COMPRESSION_ERROR_COMPRESS_FAILED,
+		 "%s: unable to compress grain: %" PRIu64 ".",
+		 function,
+		 stream_grain->grain_index );
+
+		return( -1 );
+	}
+	if( libvmdk_internal_stream_writer_write_stream_grain(
+	     internal_stream_writer,
+	     stream_grain,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write grain: %" PRIu64 ".",
+		 function,
+		 stream_grain->grain_index );
+
+		return( -1 );
+	}
+	internal_stream_writer->first_pending_stream_grain += 1;
+
+	if( internal_stream_writer->first_pending_stream_grain >= internal_stream_writer->number_of_stream_grains )
+	{
+		internal_stream_writer->first_pending_stream_grain = 0;
+	}
+	internal_stream_writer->number_of_pending_stream_grains -= 1;
+
+	return( 1 );
+}
+
+/* Writes (media) data at the current offset
+ * The data must be written sequentially, grains that only contain 0-byte values are stored sparse
+ * Returns the number of input bytes written, 0 when no longer bytes can be written or -1 on error
+ */
+ssize_t libvmdk_stream_writer_write_buffer(
+         libvmdk_stream_writer_t *stream_writer,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error )
+{
+	libvmdk_internal_stream_writer_t *internal_stream_writer = NULL;
+	libvmdk_stream_grain_t *stream_grain                     = NULL;
+	static char *function                                    = "libvmdk_stream_writer_write_buffer";
+	size_t buffer_offset                                     = 0;
+	size_t write_size                                        = 0;
+	int stream_grain_index                                   = 0;
+
+	if( stream_writer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stream writer.",
+		 function );
+
+		return( -1 );
+	}
+	internal_stream_writer = (libvmdk_internal_stream_writer_t *) stream_writer;
+
+	if( internal_stream_writer->file_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid stream writer - missing file IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( (size64_t) internal_stream_writer->current_offset >= internal_stream_writer->media_size )
+	{
+		return( 0 );
+	}
+	if( (size64_t) buffer_size > ( internal_stream_writer->media_size - internal_stream_writer->current_offset ) )
+	{
+		buffer_size = (size_t) ( internal_stream_writer->media_size - internal_stream_writer->current_offset );
+	}
+	while( buffer_offset < buffer_size )
+	{
+		if( internal_stream_writer->stream_grain_data_offset == 0 )
+		{
+			/* Make sure the next stream grain is no longer in use
+			 */
+			if( internal_stream_writer->number_of_pending_stream_grains >= internal_stream_writer->number_of_stream_grains )
+			{
+				if( libvmdk_internal_stream_writer_write_pending_stream_grain(
+				     internal_stream_writer,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write pending grain.",
+					 function );
+
+					return( -1 );
+				}
+			}
+		}
+		stream_grain_index = ( internal_stream_writer->first_pending_stream_grain + internal_stream_writer->number_of_pending_stream_grains )
+		                   % internal_stream_writer->number_of_stream_grains;
+
+		stream_grain = internal_stream_writer->stream_grains[ stream_grain_index ];
+
+		if( internal_stream_writer->stream_grain_data_offset == 0 )
+		{
+			stream_grain->grain_index = (uint64_t) internal_stream_writer->current_offset / internal_stream_writer->grain_size;
+		}
+		write_size = stream_grain->data_size - internal_stream_writer->stream_grain_data_offset;
+
+		if( write_size > ( buffer_size - buffer_offset ) )
+		{
+			write_size = buffer_size - buffer_offset;
+		}
+		if( memory_copy(
+		     &( stream_grain->data[ internal_stream_writer->stream_grain_data_offset ] ),
+		     &( ( (uint8_t *) buffer )[ buffer_offset ] ),
+		     write_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy grain data.",
+			 function );
+
+			return( -1 );
+		}
+		internal_stream_writer->stream_grain_data_offset += write_size;
+		internal_stream_writer->current_offset           += (off64_t) write_size;
+		buffer_offset                                    += write_size;
+
+		if( internal_stream_writer->stream_grain_data_offset >= stream_grain->data_size )
+		{
+			if( libvmdk_internal_stream_writer_submit_stream_grain(
+			     internal_stream_writer,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to submit grain: %" PRIu64 ".",
+				 function,
+				 stream_grain->grain_index );
+
+				return( -1 );
+			}
+		}
+	}
+	return( (ssize_t) buffer_offset );
+}
+
@@ -0,0 +1,268 @@
+/*
+ * Stream-optimized writer functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_STREAM_WRITER_H )
+#define _LIBVMDK_STREAM_WRITER_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_extern.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcthreads.h"
+#include "libvmdk_stream_grain.h"
+#include "libvmdk_types.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_internal_stream_writer libvmdk_internal_stream_writer_t;
+
+struct libvmdk_internal_stream_writer
+{
+	/* The file IO handle
+	 */
+	libbfio_handle_t *file_io_handle;
+
+	/* Value to indicate if the file IO handle was created inside the library
+	 */
+	uint8_t file_io_handle_created_in_library;
+
+	/* Value to indicate if the file IO handle was opened inside the library
+	 */
+	uint8_t file_io_handle_opened_in_library;
+
+	/* The extent filename stored in the embedded descriptor
+	 */
+	char extent_filename[ 256 ];
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The grain size
+	 */
+	size64_t grain_size;
+
+	/* The content identifier
+	 */
+	uint32_t content_identifier;
+
+	/* The compression level
+	 */
+	int compression_level;
+
+	/* The number of compression threads
+	 */
+	int number_of_threads;
+
+	/* The current (storage media) offset
+	 */
+	off64_t current_offset;
+
+	/* The current file offset
+	 */
+	off64_t file_offset;
+
+	/* The number of grain table entries
+	 */
+	uint32_t number_of_grain_table_entries;
+
+	/* The number of grain directory entries
+	 */
+	uint32_t number_of_grain_directory_entries;
+
+	/* The grain directory data
+	 */
+	uint8_t *grain_directory_data;
+
+	/* The grain directory size
+	 */
+	size_t grain_directory_size;
+
+	/* The grain table data
+	 */
+	uint8_t *grain_table_data;
+
+	/* The grain table size
+	 */
+	size_t grain_table_size;
+
+	/* The index of the current grain table
+	 */
+	uint32_t grain_table_index;
+
+	/* The number of allocated grains in the current grain table
+	 */
+	uint32_t number_of_grain_table_grains;
+
+	/* The stream grains
+	 * Used as a ring buffer of the grains that are being compressed
+	 */
+	libvmdk_stream_grain_t **stream_grains;
+
+	/* The number of stream grains
+	 */
+	int number_of_stream_grains;
+
+	/* The index of the first pending stream grain
+	 */
+	int first_pending_stream_grain;
+
+	/* The number of pending stream grains
+	 */
+	int number_of_pending_stream_grains;
+
+	/* The offset within the data of the stream grain that is being filled
+	 */
+	size_t stream_grain_data_offset;
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+	/* The compression thread pool
+	 */
+	libcthreads_thread_pool_t *compression_thread_pool;
+
+	/* The stream grains mutex
+	 */
+	libcthreads_mutex_t *stream_grains_mutex;
+
+	/* The stream grains condition
+	 */
+	libcthreads_condition_t *stream_grains_condition;
+#endif
+};
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_writer_initialize(
+     libvmdk_stream_writer_t **stream_writer,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_writer_free(
+     libvmdk_stream_writer_t **stream_writer,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_writer_set_media_size(
+     libvmdk_stream_writer_t *stream_writer,
+     size64_t media_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_writer_set_grain_size(
+     libvmdk_stream_writer_t *stream_writer,
+     size64_t grain_size,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_writer_set_number_of_threads(
+     libvmdk_stream_writer_t *stream_writer,
+     int number_of_threads,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_writer_open(
+     libvmdk_stream_writer_t *stream_writer,
+     const char *filename,
+     libcerror_error_t **error );
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_writer_open_wide(
+     libvmdk_stream_writer_t *stream_writer,
+     const wchar_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_writer_open_file_io_handle(
+     libvmdk_stream_writer_t *stream_writer,
+     libbfio_handle_t *file_io_handle,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+int libvmdk_stream_writer_close(
+     libvmdk_stream_writer_t *stream_writer,
+     libcerror_error_t **error );
+
+int libvmdk_internal_stream_writer_copy_file_header(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     uint64_t grain_directory_sector_number,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int libvmdk_internal_stream_writer_write_header(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libcerror_error_t **error );
+
+int libvmdk_internal_stream_writer_write_marker(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     uint64_t number_of_sectors,
+     uint32_t marker_type,
+     libcerror_error_t **error );
+
+int libvmdk_internal_stream_writer_write_grain_table(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libcerror_error_t **error );
+
+int libvmdk_internal_stream_writer_write_footer(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libcerror_error_t **error );
+
+int libvmdk_internal_stream_writer_write_stream_grain(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libvmdk_stream_grain_t *stream_grain,
+     libcerror_error_t **error );
+
+#if defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT )
+
+int libvmdk_internal_stream_writer_compress_stream_grain_callback(
+     libvmdk_stream_grain_t *stream_grain,
+     libvmdk_internal_stream_writer_t *internal_stream_writer );
+
+#endif /* defined( HAVE_LIBVMDK_MULTI_THREAD_SUPPORT ) */
+
+int libvmdk_internal_stream_writer_submit_stream_grain(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libcerror_error_t **error );
+
+int libvmdk_internal_stream_writer_write_pending_stream_grain(
+     libvmdk_internal_stream_writer_t *internal_stream_writer,
+     libcerror_error_t **error );
+
+LIBVMDK_EXTERN \
+ssize_t libvmdk_stream_writer_write_buffer(
+         libvmdk_stream_writer_t *stream_writer,
+         const void *buffer,
+         size_t buffer_size,
+         libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_STREAM_WRITER_H ) */
+
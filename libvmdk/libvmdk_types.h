@@ -34,12 +34,16 @@
 /* The following type definitions hide internal data structures
  */
 #if defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI )
+typedef struct libvmdk_cache_pool {}		libvmdk_cache_pool_t;
 typedef struct libvmdk_extent_descriptor {}	libvmdk_extent_descriptor_t;
 typedef struct libvmdk_handle {}		libvmdk_handle_t;
+typedef struct libvmdk_stream_writer {}	libvmdk_stream_writer_t;
 
 #else
+typedef intptr_t libvmdk_cache_pool_t;
 typedef intptr_t libvmdk_extent_descriptor_t;
 typedef intptr_t libvmdk_handle_t;
+typedef intptr_t libvmdk_stream_writer_t;
 
 #endif /* defined( HAVE_DEBUG_OUTPUT ) && !defined( WINAPI ) */
 
@@ -0,0 +1,761 @@
+/*
+ * Write IO handle functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <types.h>
+
+#include "libvmdk_definitions.h"
+#include "libvmdk_extent_file.h"
+#include "libvmdk_grain_directory.h"
+#include "libvmdk_io_handle.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcdata.h"
+#include "libvmdk_libcerror.h"
+#include "libvmdk_libcnotify.h"
+#include "libvmdk_write_io_handle.h"
+
+/* Creates a write IO handle
+ * Make sure the value write_io_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_write_io_handle_initialize(
+     libvmdk_write_io_handle_t **write_io_handle,
+     libvmdk_io_handle_t *io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_write_io_handle_initialize";
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid write IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	*write_io_handle = memory_allocate_structure(
+	                    libvmdk_write_io_handle_t );
+
+	if( *write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create write IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *write_io_handle,
+	     0,
+	     sizeof( libvmdk_write_io_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear write IO handle.",
+		 function );
+
+		memory_free(
+		 *write_io_handle );
+
+		*write_io_handle = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *write_io_handle )->grain_directories_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create grain directories array.",
+		 function );
+
+		goto on_error;
+	}
+	( *write_io_handle )->io_handle = io_handle;
+
+	return( 1 );
+
+on_error:
+	if( *write_io_handle != NULL )
+	{
+		memory_free(
+		 *write_io_handle );
+
+		*write_io_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a write IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_write_io_handle_free(
+     libvmdk_write_io_handle_t **write_io_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_write_io_handle_free";
+	int result            = 1;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *write_io_handle != NULL )
+	{
+		/* The IO handle reference is freed elsewhere
+		 */
+		if( libcdata_array_free(
+		     &( ( *write_io_handle )->grain_directories_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_grain_directory_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free grain directories array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *write_io_handle );
+
+		*write_io_handle = NULL;
+	}
+	return( result );
+}
+
+/* Appends the grain directory of a sparse extent file
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_write_io_handle_append_extent_file(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t media_offset,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_directory_t *grain_directory = NULL;
+	static char *function                      = "libvmdk_write_io_handle_append_extent_file";
+	int entry_index                            = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_grain_directory_initialize(
+	     &grain_directory,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create grain directory.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_grain_directory_read(
+	     grain_directory,
+	     extent_file,
+	     file_io_pool,
+	     file_io_pool_entry,
+	     media_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain directory of extent file: %d.",
+		 function,
+		 file_io_pool_entry );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     write_io_handle->grain_directories_array,
+	     &entry_index,
+	     (intptr_t *) grain_directory,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append grain directory to array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( grain_directory != NULL )
+	{
+		libvmdk_grain_directory_free(
+		 &grain_directory,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves the grain directory of the extent at a specific (media) offset
+ * Returns 1 if successful, 0 if no such grain directory or -1 on error
+ */
+int libvmdk_write_io_handle_get_grain_directory_at_offset(
+     libvmdk_write_io_handle_t *write_io_handle,
+     off64_t offset,
+     libvmdk_grain_directory_t **grain_directory,
+     off64_t *extent_data_offset,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_directory_t *safe_grain_directory = NULL;
+	static char *function                           = "libvmdk_write_io_handle_get_grain_directory_at_offset";
+	int grain_directory_index                       = 0;
+	int number_of_grain_directories                 = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( grain_directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid grain directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_data_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent data offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     write_io_handle->grain_directories_array,
+	     &number_of_grain_directories,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of grain directories.",
+		 function );
+
+		return( -1 );
+	}
+	/* Consecutive I/O typically stays within the same extent hence start with the current one
+	 */
+	grain_directory_index = write_io_handle->current_grain_directory_index;
+
+	if( ( grain_directory_index < 0 )
+	 || ( grain_directory_index >= number_of_grain_directories ) )
+	{
+		grain_directory_index = 0;
+	}
+	while( number_of_grain_directories > 0 )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     write_io_handle->grain_directories_array,
+		     grain_directory_index,
+		     (intptr_t **) &safe_grain_directory,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain directory: %d.",
+			 function,
+			 grain_directory_index );
+
+			return( -1 );
+		}
+		if( safe_grain_directory == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing grain directory: %d.",
+			 function,
+			 grain_directory_index );
+
+			return( -1 );
+		}
+		if( offset < safe_grain_directory->media_offset )
+		{
+			if( grain_directory_index == 0 )
+			{
+				break;
+			}
+			grain_directory_index--;
+		}
+		else if( (size64_t) ( offset - safe_grain_directory->media_offset ) >= safe_grain_directory->media_size )
+		{
+			grain_directory_index++;
+
+			if( grain_directory_index >= number_of_grain_directories )
+			{
+				break;
+			}
+		}
+		else
+		{
+			write_io_handle->current_grain_directory_index = grain_directory_index;
+
+			*grain_directory    = safe_grain_directory;
+			*extent_data_offset = offset - safe_grain_directory->media_offset;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+/* Retrieves the file offset of the grain at a specific (media) offset
+ * Returns 1 if successful, 0 if the grain is not allocated or -1 on error
+ */
+int libvmdk_write_io_handle_get_grain_offset_at_offset(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *grain_offset,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_directory_t *grain_directory = NULL;
+	static char *function                      = "libvmdk_write_io_handle_get_grain_offset_at_offset";
+	off64_t extent_data_offset                 = 0;
+	int result                                 = 0;
+
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvmdk_write_io_handle_get_grain_directory_at_offset(
+	          write_io_handle,
+	          offset,
+	          &grain_directory,
+	          &extent_data_offset,
+	          error );
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain directory at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	result = libvmdk_grain_directory_get_grain_offset(
+	          grain_directory,
+	          file_io_pool,
+	          extent_data_offset,
+	          grain_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain offset at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	*file_io_pool_entry = grain_directory->file_io_pool_entry;
+
+	return( result );
+}
+
+/* Allocates the grain at a specific (media) offset
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_write_io_handle_allocate_grain_at_offset(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *grain_offset,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_directory_t *grain_directory = NULL;
+	static char *function                      = "libvmdk_write_io_handle_allocate_grain_at_offset";
+	off64_t extent_data_offset                 = 0;
+
+	if( file_io_pool_entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file IO pool entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_write_io_handle_get_grain_directory_at_offset(
+	     write_io_handle,
+	     offset,
+	     &grain_directory,
+	     &extent_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain directory at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( libvmdk_grain_directory_allocate_grain(
+	     grain_directory,
+	     file_io_pool,
+	     extent_data_offset,
+	     grain_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to allocate grain at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	*file_io_pool_entry = grain_directory->file_io_pool_entry;
+
+	return( 1 );
+}
+
+/* Marks the extent file at a specific (media) offset dirty
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_write_io_handle_mark_dirty_at_offset(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_directory_t *grain_directory = NULL;
+	static char *function                      = "libvmdk_write_io_handle_mark_dirty_at_offset";
+	off64_t extent_data_offset                 = 0;
+
+	if( libvmdk_write_io_handle_get_grain_directory_at_offset(
+	     write_io_handle,
+	     offset,
+	     &grain_directory,
+	     &extent_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain directory at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	if( libvmdk_grain_directory_mark_dirty(
+	     grain_directory,
+	     file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to mark grain directory dirty.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Discards the grain at a specific (media) offset
+ * Marks the extent file dirty before its grain table is modified
+ * Returns 1 if successful, 0 if the grain was not allocated or -1 on error
+ */
+int libvmdk_write_io_handle_discard_grain_at_offset(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_directory_t *grain_directory = NULL;
+	static char *function                      = "libvmdk_write_io_handle_discard_grain_at_offset";
+	off64_t extent_data_offset                 = 0;
+	off64_t grain_offset                       = 0;
+	int result                                 = 0;
+
+	if( libvmdk_write_io_handle_get_grain_directory_at_offset(
+	     write_io_handle,
+	     offset,
+	     &grain_directory,
+	     &extent_data_offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain directory at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	result = libvmdk_grain_directory_get_grain_offset(
+	          grain_directory,
+	          file_io_pool,
+	          extent_data_offset,
+	          &grain_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve grain offset at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( libvmdk_grain_directory_mark_dirty(
+	     grain_directory,
+	     file_io_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to mark grain directory dirty.",
+		 function );
+
+		return( -1 );
+	}
+	result = libvmdk_grain_directory_discard_grain(
+	          grain_directory,
+	          file_io_pool,
+	          extent_data_offset,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to discard grain at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+		 function,
+		 offset,
+		 offset );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Flushes the modified metadata of all extent files
+ * Returns 1 if successful or -1 on error
+ */
+int libvmdk_write_io_handle_flush(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error )
+{
+	libvmdk_grain_directory_t *grain_directory = NULL;
+	static char *function                      = "libvmdk_write_io_handle_flush";
+	int grain_directory_index                  = 0;
+	int number_of_grain_directories            = 0;
+
+	if( write_io_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid write IO handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     write_io_handle->grain_directories_array,
+	     &number_of_grain_directories,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of grain directories.",
+		 function );
+
+		return( -1 );
+	}
+	for( grain_directory_index = 0;
+	     grain_directory_index < number_of_grain_directories;
+	     grain_directory_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     write_io_handle->grain_directories_array,
+		     grain_directory_index,
+		     (intptr_t **) &grain_directory,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve grain directory: %d.",
+			 function,
+			 grain_directory_index );
+
+			return( -1 );
+		}
+		if( libvmdk_grain_directory_flush(
+		     grain_directory,
+		     file_io_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush grain directory: %d.",
+			 function,
+			 grain_directory_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
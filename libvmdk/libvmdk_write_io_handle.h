@@ -0,0 +1,118 @@
+/*
+ * Write IO handle functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_WRITE_IO_HANDLE_H )
+#define _LIBVMDK_WRITE_IO_HANDLE_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_extent_file.h"
+#include "libvmdk_grain_directory.h"
+#include "libvmdk_io_handle.h"
+#include "libvmdk_libbfio.h"
+#include "libvmdk_libcdata.h"
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct libvmdk_write_io_handle libvmdk_write_io_handle_t;
+
+struct libvmdk_write_io_handle
+{
+	/* The IO handle
+	 */
+	libvmdk_io_handle_t *io_handle;
+
+	/* The grain directories array, one per extent file
+	 */
+	libcdata_array_t *grain_directories_array;
+
+	/* The (current) grain directory index
+	 */
+	int current_grain_directory_index;
+};
+
+int libvmdk_write_io_handle_initialize(
+     libvmdk_write_io_handle_t **write_io_handle,
+     libvmdk_io_handle_t *io_handle,
+     libcerror_error_t **error );
+
+int libvmdk_write_io_handle_free(
+     libvmdk_write_io_handle_t **write_io_handle,
+     libcerror_error_t **error );
+
+int libvmdk_write_io_handle_append_extent_file(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libvmdk_extent_file_t *extent_file,
+     libbfio_pool_t *file_io_pool,
+     int file_io_pool_entry,
+     off64_t media_offset,
+     libcerror_error_t **error );
+
+int libvmdk_write_io_handle_get_grain_directory_at_offset(
+     libvmdk_write_io_handle_t *write_io_handle,
+     off64_t offset,
+     libvmdk_grain_directory_t **grain_directory,
+     off64_t *extent_data_offset,
+     libcerror_error_t **error );
+
+int libvmdk_write_io_handle_get_grain_offset_at_offset(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *grain_offset,
+     libcerror_error_t **error );
+
+int libvmdk_write_io_handle_allocate_grain_at_offset(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     int *file_io_pool_entry,
+     off64_t *grain_offset,
+     libcerror_error_t **error );
+
+int libvmdk_write_io_handle_mark_dirty_at_offset(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libvmdk_write_io_handle_discard_grain_at_offset(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     off64_t offset,
+     libcerror_error_t **error );
+
+int libvmdk_write_io_handle_flush(
+     libvmdk_write_io_handle_t *write_io_handle,
+     libbfio_pool_t *file_io_pool,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_WRITE_IO_HANDLE_H ) */
+
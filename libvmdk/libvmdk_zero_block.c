@@ -0,0 +1,319 @@
+/*
+ * Zero block functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libcerror.h"
+#include "libvmdk_types.h"
+#include "libvmdk_zero_block.h"
+
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2 )
+#include <immintrin.h>
+
+#if defined( _MSC_VER )
+#include <intrin.h>
+#endif
+
+#elif defined( LIBVMDK_ZERO_BLOCK_HAVE_SSE2 )
+#include <emmintrin.h>
+#endif
+
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2_RUNTIME_CHECK )
+
+/* Cached result of the AVX2 CPU feature check, -1 if not yet determined
+ */
+static int libvmdk_zero_block_avx2_supported = -1;
+
+#endif
+
+/* Checks if a buffer only contains 0-byte values using aligned word-sized reads
+ * Returns 1 if the buffer only contains 0-byte values or 0 if not
+ */
+int libvmdk_zero_block_check_scalar(
+     const uint8_t *data,
+     size_t data_size )
+{
+	const libvmdk_aligned_t *aligned_data_index = NULL;
+	libvmdk_aligned_t aligned_value             = 0;
+	int word_index                              = 0;
+
+	if( data == NULL )
+	{
+		return( 0 );
+	}
+	/* Align the data start
+	 */
+	while( ( data_size > 0 )
+	    && ( ( (intptr_t) data % sizeof( libvmdk_aligned_t ) ) != 0 ) )
+	{
+		if( *data != 0 )
+		{
+			return( 0 );
+		}
+		data      += 1;
+		data_size -= 1;
+	}
+	aligned_data_index = (const libvmdk_aligned_t *) data;
+
+	/* Test 8 words at a time to limit the number of branches
+	 */
+	while( data_size >= ( 8 * sizeof( libvmdk_aligned_t ) ) )
+	{
+		aligned_value = 0;
+
+		for( word_index = 0;
+		     word_index < 8;
+		     word_index++ )
+		{
+			aligned_value |= aligned_data_index[ word_index ];
+		}
+		if( aligned_value != 0 )
+		{
+			return( 0 );
+		}
+		aligned_data_index += 8;
+		data_size          -= 8 * sizeof( libvmdk_aligned_t );
+	}
+	while( data_size >= sizeof( libvmdk_aligned_t ) )
+	{
+		if( *aligned_data_index != 0 )
+		{
+			return( 0 );
+		}
+		aligned_data_index += 1;
+		data_size          -= sizeof( libvmdk_aligned_t );
+	}
+	data = (const uint8_t *) aligned_data_index;
+
+	while( data_size > 0 )
+	{
+		if( *data != 0 )
+		{
+			return( 0 );
+		}
+		data      += 1;
+		data_size -= 1;
+	}
+	return( 1 );
+}
+
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_SSE2 )
+
+/* Checks if a buffer only contains 0-byte values using SSE2
+ * Returns 1 if the buffer only contains 0-byte values or 0 if not
+ */
+int libvmdk_zero_block_check_sse2(
+     const uint8_t *data,
+     size_t data_size )
+{
+	__m128i zero_vector  = _mm_setzero_si128();
+	__m128i value_vector = _mm_setzero_si128();
+
+	if( data == NULL )
+	{
+		return( 0 );
+	}
+	/* Test 64 bytes at a time, the loads do not need to be aligned
+	 */
+	while( data_size >= 64 )
+	{
+		value_vector = _mm_or_si128(
+		                _mm_or_si128(
+		                 _mm_loadu_si128( (const __m128i *) data ),
+		                 _mm_loadu_si128( (const __m128i *) &( data[ 16 ] ) ) ),
+		                _mm_or_si128(
+		                 _mm_loadu_si128( (const __m128i *) &( data[ 32 ] ) ),
+		                 _mm_loadu_si128( (const __m128i *) &( data[ 48 ] ) ) ) );
+
+		if( _mm_movemask_epi8( _mm_cmpeq_epi8( value_vector, zero_vector ) ) != 0xffff )
+		{
+			return( 0 );
+		}
+		data      += 64;
+		data_size -= 64;
+	}
+	return( libvmdk_zero_block_check_scalar(
+	         data,
+	         data_size ) );
+}
+
+#endif /* defined( LIBVMDK_ZERO_BLOCK_HAVE_SSE2 ) */
+
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2 )
+
+/* Determines if the CPU supports AVX2
+ * The result is cached, concurrent callers determine the same value
+ * Returns 1 if AVX2 is supported or 0 if not
+ */
+int libvmdk_zero_block_cpu_supports_avx2(
+     void )
+{
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2_RUNTIME_CHECK )
+#if defined( _MSC_VER )
+	int cpu_information[ 4 ];
+#endif
+	int result = 0;
+
+	if( libvmdk_zero_block_avx2_supported != -1 )
+	{
+		return( libvmdk_zero_block_avx2_supported );
+	}
+#if defined( _MSC_VER )
+	/* AVX2 requires CPUID leaf 7 EBX bit 5 and the OS to save the YMM registers,
+	 * which is indicated by OSXSAVE (leaf 1 ECX bit 27) and XCR0 bits 1 and 2
+	 */
+	__cpuid(
+	 cpu_information,
+	 0 );
+
+	if( cpu_information[ 0 ] >= 7 )
+	{
+		__cpuid(
+		 cpu_information,
+		 1 );
+
+		if( ( ( cpu_information[ 2 ] & ( 1 << 27 ) ) != 0 )
+		 && ( ( cpu_information[ 2 ] & ( 1 << 28 ) ) != 0 )
+		 && ( ( _xgetbv( 0 ) & 0x06 ) == 0x06 ) )
+		{
+			__cpuidex(
+			 cpu_information,
+			 7,
+			 0 );
+
+			if( ( cpu_information[ 1 ] & ( 1 << 5 ) ) != 0 )
+			{
+				result = 1;
+			}
+		}
+	}
+#else
+	__builtin_cpu_init();
+
+	if( __builtin_cpu_supports( "avx2" ) )
+	{
+		result = 1;
+	}
+#endif
+	libvmdk_zero_block_avx2_supported = result;
+
+	return( result );
+#else
+	return( 1 );
+#endif
+}
+
+/* Checks if a buffer only contains 0-byte values using AVX2
+ * The CPU must support AVX2, see libvmdk_zero_block_cpu_supports_avx2
+ * Returns 1 if the buffer only contains 0-byte values or 0 if not
+ */
+LIBVMDK_ZERO_BLOCK_TARGET_AVX2 \
+int libvmdk_zero_block_check_avx2(
+     const uint8_t *data,
+     size_t data_size )
+{
+	__m256i value_vector = _mm256_setzero_si256();
+
+	if( data == NULL )
+	{
+		return( 0 );
+	}
+	/* Test 128 bytes at a time, the loads do not need to be aligned
+	 */
+	while( data_size >= 128 )
+	{
+		value_vector = _mm256_or_si256(
+		                _mm256_or_si256(
+		                 _mm256_loadu_si256( (const __m256i *) data ),
+		                 _mm256_loadu_si256( (const __m256i *) &( data[ 32 ] ) ) ),
+		                _mm256_or_si256(
+		                 _mm256_loadu_si256( (const __m256i *) &( data[ 64 ] ) ),
+		                 _mm256_loadu_si256( (const __m256i *) &( data[ 96 ] ) ) ) );
+
+		if( _mm256_testz_si256( value_vector, value_vector ) == 0 )
+		{
+			return( 0 );
+		}
+		data      += 128;
+		data_size -= 128;
+	}
+	return( libvmdk_zero_block_check_scalar(
+	         data,
+	         data_size ) );
+}
+
+#endif /* defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2 ) */
+
+/* Checks if a buffer only contains 0-byte values
+ * Uses the AVX2 kernel when supported by the CPU, otherwise the widest SIMD kernel
+ * available for the build target
+ * Returns 1 if the buffer only contains 0-byte values, 0 if not or -1 on error
+ */
+int libvmdk_zero_block_check(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "libvmdk_zero_block_check";
+
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2 )
+	if( libvmdk_zero_block_cpu_supports_avx2() != 0 )
+	{
+		return( libvmdk_zero_block_check_avx2(
+		         data,
+		         data_size ) );
+	}
+#endif
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_SSE2 )
+	return( libvmdk_zero_block_check_sse2(
+	         data,
+	         data_size ) );
+
+#else
+	return( libvmdk_zero_block_check_scalar(
+	         data,
+	         data_size ) );
+#endif
+}
+
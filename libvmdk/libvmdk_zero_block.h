@@ -0,0 +1,91 @@
+/*
+ * Zero block functions
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _LIBVMDK_ZERO_BLOCK_H )
+#define _LIBVMDK_ZERO_BLOCK_H
+
+#include <common.h>
+#include <types.h>
+
+#include "libvmdk_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* SSE2 is part of the x86-64 baseline and is selected at compile time
+ */
+#if defined( __SSE2__ ) || defined( _M_X64 ) || ( defined( _M_IX86_FP ) && ( _M_IX86_FP >= 2 ) )
+#define LIBVMDK_ZERO_BLOCK_HAVE_SSE2
+#endif
+
+/* The AVX2 kernel is built when the compiler can generate AVX2 code for a single function,
+ * it is only used when the CPU supports AVX2, unless the compiler already targets AVX2
+ */
+#if defined( __AVX2__ )
+#define LIBVMDK_ZERO_BLOCK_HAVE_AVX2
+#define LIBVMDK_ZERO_BLOCK_TARGET_AVX2
+
+#elif ( defined( __x86_64__ ) || defined( __i386__ ) ) && ( defined( __clang__ ) || ( defined( __GNUC__ ) && ( ( __GNUC__ > 4 ) || ( ( __GNUC__ == 4 ) && ( __GNUC_MINOR__ >= 9 ) ) ) ) )
+#define LIBVMDK_ZERO_BLOCK_HAVE_AVX2
+#define LIBVMDK_ZERO_BLOCK_HAVE_AVX2_RUNTIME_CHECK
+#define LIBVMDK_ZERO_BLOCK_TARGET_AVX2	__attribute__((target("avx2")))
+
+#elif defined( _MSC_VER ) && ( _MSC_VER >= 1700 ) && defined( _M_X64 )
+#define LIBVMDK_ZERO_BLOCK_HAVE_AVX2
+#define LIBVMDK_ZERO_BLOCK_HAVE_AVX2_RUNTIME_CHECK
+#define LIBVMDK_ZERO_BLOCK_TARGET_AVX2
+#endif
+
+int libvmdk_zero_block_check_scalar(
+     const uint8_t *data,
+     size_t data_size );
+
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_SSE2 )
+
+int libvmdk_zero_block_check_sse2(
+     const uint8_t *data,
+     size_t data_size );
+
+#endif /* defined( LIBVMDK_ZERO_BLOCK_HAVE_SSE2 ) */
+
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2 )
+
+int libvmdk_zero_block_cpu_supports_avx2(
+     void );
+
+int libvmdk_zero_block_check_avx2(
+     const uint8_t *data,
+     size_t data_size );
+
+#endif /* defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2 ) */
+
+int libvmdk_zero_block_check(
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _LIBVMDK_ZERO_BLOCK_H ) */
+
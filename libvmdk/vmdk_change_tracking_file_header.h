@@ -0,0 +1,101 @@
+/*
+ * The file header definition of a VMware Virtual Disk (VMDK) change tracking file
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _VMDK_CHANGE_TRACKING_FILE_HEADER_H )
+#define _VMDK_CHANGE_TRACKING_FILE_HEADER_H
+
+#include <common.h>
+#include <types.h>
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct vmdk_change_tracking_file_header vmdk_change_tracking_file_header_t;
+
+struct vmdk_change_tracking_file_header
+{
+	/* The signature
+	 * Consists of 4 bytes
+	 * Contains: 0xa2 0x72 0x19 0xf6
+	 */
+	uint8_t signature[ 4 ];
+
+	/* The version
+	 * Consists of 4 bytes
+	 */
+	uint8_t version[ 4 ];
+
+	/* Unknown (empty values)
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown1[ 4 ];
+
+	/* The block number of sectors
+	 * Consists of 4 bytes
+	 * Contains a value in sectors
+	 */
+	uint8_t block_number_of_sectors[ 4 ];
+
+	/* The number of sectors
+	 * Consists of 8 bytes
+	 * Contains a value in sectors
+	 */
+	uint8_t number_of_sectors[ 8 ];
+
+	/* The number of blocks
+	 * Consists of 8 bytes
+	 */
+	uint8_t number_of_blocks[ 8 ];
+
+	/* The (current) change sequence number
+	 * Consists of 4 bytes
+	 */
+	uint8_t sequence_number[ 4 ];
+
+	/* Unknown
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown2[ 4 ];
+
+	/* Unknown
+	 * Consists of 4 bytes
+	 */
+	uint8_t unknown3[ 4 ];
+
+	/* The change tracking identifier
+	 * Consists of 16 bytes
+	 * Contains an UUID
+	 */
+	uint8_t change_tracking_identifier[ 16 ];
+
+	/* Padding
+	 * Consists of 452 bytes
+	 */
+	uint8_t padding[ 452 ];
+};
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VMDK_CHANGE_TRACKING_FILE_HEADER_H ) */
+
@@ -1,6 +1,6 @@
 dnl Functions for libfuse
 dnl
-dnl Version: 20130409
+dnl Version: 20261018
 
 dnl Function to detect if libfuse is available
 dnl ac_libfuse_dummy is used to prevent AC_CHECK_LIB adding unnecessary -l<library> arguments
@@ -22,14 +22,36 @@ AC_DEFUN([AX_LIBFUSE_CHECK_LIB],
   [dnl Check for a pkg-config file
   AS_IF(
    [test "x$cross_compiling" != "xyes" && test "x$PKGCONFIG" != "x"],
-   [PKG_CHECK_MODULES(
-    [fuse],
-    [fuse >= 2.6],
-    [ac_cv_libfuse=libfuse],
+   [dnl FUSE 3.8 or later is required for lseek support
+   PKG_CHECK_MODULES(
+    [fuse3],
+    [fuse3 >= 3.8],
+    [ac_cv_libfuse=libfuse3],
     [ac_cv_libfuse=no])
+
+   dnl FUSE 3.12 or later is required to limit the number of threads of the multi-threaded loop
+   AS_IF(
+    [test "x$ac_cv_libfuse" = xlibfuse3],
+    [PKG_CHECK_EXISTS(
+     [fuse3 >= 3.12],
+     [ac_cv_libfuse3_loop_config=yes],
+     [ac_cv_libfuse3_loop_config=no])
+    ])
+
+   AS_IF(
+    [test "x$ac_cv_libfuse" = xno],
+    [PKG_CHECK_MODULES(
+     [fuse],
+     [fuse >= 2.6],
+     [ac_cv_libfuse=libfuse],
+     [ac_cv_libfuse=no])
+    ])
    ])
 
   AS_IF(
+   [test "x$ac_cv_libfuse" = xlibfuse3],
+   [ac_cv_libfuse_CPPFLAGS="$pkg_cv_fuse3_CFLAGS"
+   ac_cv_libfuse_LIBADD="$pkg_cv_fuse3_LIBS"],
    [test "x$ac_cv_libfuse" = xlibfuse],
    [ac_cv_libfuse_CPPFLAGS="$pkg_cv_fuse_CFLAGS"
    ac_cv_libfuse_LIBADD="$pkg_cv_fuse_LIBS"],
@@ -125,12 +147,26 @@ AC_DEFUN([AX_LIBFUSE_CHECK_LIB],
   ])
 
  AS_IF(
-  [test "x$ac_cv_libfuse" = xlibfuse],
+  [test "x$ac_cv_libfuse" = xlibfuse || test "x$ac_cv_libfuse" = xlibfuse3],
   [AC_DEFINE(
    [HAVE_LIBFUSE],
    [1],
    [Define to 1 if you have the 'fuse' library (-lfuse).])
   ])
+ AS_IF(
+  [test "x$ac_cv_libfuse" = xlibfuse3],
+  [AC_DEFINE(
+   [HAVE_LIBFUSE3],
+   [1],
+   [Define to 1 if you have the 'fuse3' library (-lfuse3).])
+  ])
+ AS_IF(
+  [test "x$ac_cv_libfuse" = xlibfuse3 && test "x$ac_cv_libfuse3_loop_config" = xyes],
+  [AC_DEFINE(
+   [HAVE_FUSE_LOOP_CFG_SET_MAX_THREADS],
+   [1],
+   [Define to 1 if you have the 'fuse_loop_cfg_set_max_threads' function.])
+  ])
  AS_IF(
   [test "x$ac_cv_libfuse" = xlibosxfuse],
   [AC_DEFINE(
@@ -181,6 +217,12 @@ AC_DEFUN([AX_LIBFUSE_CHECK_ENABLE],
    [ax_libfuse_pc_libs_private],
    [-lfuse])
   ])
+ AS_IF(
+  [test "x$ac_cv_libfuse" = xlibfuse3],
+  [AC_SUBST(
+   [ax_libfuse_pc_libs_private],
+   [-lfuse3])
+  ])
  AS_IF(
   [test "x$ac_cv_libfuse" = xlibosxfuse],
   [AC_SUBST(
@@ -197,5 +239,14 @@ AC_DEFUN([AX_LIBFUSE_CHECK_ENABLE],
    [ax_libfuse_spec_build_requires],
    [fuse-devel])
   ])
+ AS_IF(
+  [test "x$ac_cv_libfuse" = xlibfuse3],
+  [AC_SUBST(
+   [ax_libfuse_spec_requires],
+   [fuse3-libs])
+  AC_SUBST(
+   [ax_libfuse_spec_build_requires],
+   [fuse3-devel])
+  ])
  ])
 
@@ -7,7 +7,7 @@ EXIT_SUCCESS=0;
 EXIT_FAILURE=1;
 EXIT_IGNORE=77;
 
-LIBRARY_TESTS="descriptor_file error extent_descriptor extent_file extent_table grain_data grain_group grain_table io_handle notify";
+LIBRARY_TESTS="cache_pool change_tracking_file chunk_hasher delta_disk descriptor_file error extent_descriptor extent_file extent_table grain_data grain_directory grain_group grain_table grain_verifier io_handle notify sha256 statistics stream_grain stream_writer write_io_handle zero_block";
 LIBRARY_TESTS_WITH_INPUT="handle support";
 OPTION_SETS="";
 
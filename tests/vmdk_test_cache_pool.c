@@ -0,0 +1,1750 @@
+/*
+ * Library cache_pool type test program
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_functions.h"
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_cache_pool.h"
+#include "../libvmdk/libvmdk_io_handle.h"
+
+/* Tests the libvmdk_cache_pool_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_pool_initialize(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libvmdk_cache_pool_t *cache_pool = NULL;
+	int result                       = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests  = 1;
+	int number_of_memset_fail_tests  = 1;
+	int test_number                  = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_cache_pool_initialize(
+	          &cache_pool,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_pool",
+	 cache_pool );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_cache_pool_free(
+	          &cache_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "cache_pool",
+	 cache_pool );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_cache_pool_initialize(
+	          NULL,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	cache_pool = (libvmdk_cache_pool_t *) 0x12345678UL;
+
+	result = libvmdk_cache_pool_initialize(
+	          &cache_pool,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	cache_pool = NULL;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_cache_pool_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_cache_pool_initialize(
+		          &cache_pool,
+		          (size64_t) 1048576,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( cache_pool != NULL )
+			{
+				libvmdk_cache_pool_free(
+				 &cache_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "cache_pool",
+			 cache_pool );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_cache_pool_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_cache_pool_initialize(
+		          &cache_pool,
+		          (size64_t) 1048576,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( cache_pool != NULL )
+			{
+				libvmdk_cache_pool_free(
+				 &cache_pool,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "cache_pool",
+			 cache_pool );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache_pool != NULL )
+	{
+		libvmdk_cache_pool_free(
+		 &cache_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_cache_pool_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_pool_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_cache_pool_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_cache_pool_get_maximum_cache_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_pool_get_maximum_cache_size(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libvmdk_cache_pool_t *cache_pool = NULL;
+	size64_t maximum_cache_size      = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_cache_pool_initialize(
+	          &cache_pool,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_pool",
+	 cache_pool );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_cache_pool_get_maximum_cache_size(
+	          cache_pool,
+	          &maximum_cache_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "maximum_cache_size",
+	 (uint64_t) maximum_cache_size,
+	 (uint64_t) 1048576 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_cache_pool_get_maximum_cache_size(
+	          NULL,
+	          &maximum_cache_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_pool_get_maximum_cache_size(
+	          cache_pool,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_cache_pool_free(
+	          &cache_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "cache_pool",
+	 cache_pool );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache_pool != NULL )
+	{
+		libvmdk_cache_pool_free(
+		 &cache_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_cache_pool_attach_handle and libvmdk_cache_pool_detach_handle functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_pool_attach_handle(
+     void )
+{
+	libcerror_error_t *error                           = NULL;
+	libvmdk_cache_pool_t *cache_pool                   = NULL;
+	libvmdk_internal_cache_pool_t *internal_cache_pool = NULL;
+	libvmdk_io_handle_t *io_handle                     = NULL;
+	int first_handle_identifier                        = 0;
+	int result                                         = 0;
+	int second_handle_identifier                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A cache pool of 1 MiB contains 2 grains of 64 KiB per partition
+	 */
+	result = libvmdk_cache_pool_initialize(
+	          &cache_pool,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	internal_cache_pool = (libvmdk_internal_cache_pool_t *) cache_pool;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "internal_cache_pool->number_of_partition_entries",
+	 internal_cache_pool->number_of_partition_entries,
+	 2 );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_cache_pool_attach_handle(
+	          cache_pool,
+	          (size64_t) 65536,
+	          &first_handle_identifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "internal_cache_pool->number_of_partition_entries",
+	 internal_cache_pool->number_of_partition_entries,
+	 2 );
+
+	/* A handle with grains of 128 KiB reduces the number of cache entries
+	 */
+	result = libvmdk_cache_pool_attach_handle(
+	          cache_pool,
+	          (size64_t) 131072,
+	          &second_handle_identifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "internal_cache_pool->number_of_partition_entries",
+	 internal_cache_pool->number_of_partition_entries,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "internal_cache_pool->grain_size",
+	 (uint64_t) internal_cache_pool->grain_size,
+	 (uint64_t) 131072 );
+
+	/* The number of cache entries remains reduced while handles are attached
+	 */
+	result = libvmdk_cache_pool_detach_handle(
+	          cache_pool,
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "internal_cache_pool->number_of_partition_entries",
+	 internal_cache_pool->number_of_partition_entries,
+	 1 );
+
+	result = libvmdk_cache_pool_detach_handle(
+	          cache_pool,
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "internal_cache_pool->number_of_partition_entries",
+	 internal_cache_pool->number_of_partition_entries,
+	 2 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "internal_cache_pool->grain_size",
+	 (uint64_t) internal_cache_pool->grain_size,
+	 (uint64_t) 65536 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_cache_pool_attach_handle(
+	          NULL,
+	          (size64_t) 65536,
+	          &first_handle_identifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_pool_attach_handle(
+	          cache_pool,
+	          (size64_t) 65536,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_pool_resize_grains_caches(
+	          internal_cache_pool,
+	          (size64_t) 512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_cache_pool_free(
+	          &cache_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache_pool != NULL )
+	{
+		libvmdk_cache_pool_free(
+		 &cache_pool,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_cache_pool_attach_handle and libvmdk_cache_pool_get_partition_index functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_pool_get_partition_index(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libvmdk_cache_pool_t *cache_pool = NULL;
+	int first_handle_identifier      = 0;
+	int first_partition_index        = 0;
+	int partition_index              = 0;
+	int result                       = 0;
+	int second_handle_identifier     = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_cache_pool_initialize(
+	          &cache_pool,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_pool",
+	 cache_pool );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_cache_pool_attach_handle(
+	          cache_pool,
+	          (size64_t) 65536,
+	          &first_handle_identifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_cache_pool_attach_handle(
+	          cache_pool,
+	          (size64_t) 65536,
+	          &second_handle_identifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "second_handle_identifier",
+	 second_handle_identifier,
+	 first_handle_identifier );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_cache_pool_get_partition_index(
+	          cache_pool,
+	          first_handle_identifier,
+	          0,
+	          &first_partition_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* The same region of a different handle maps onto a different partition
+	 */
+	result = libvmdk_cache_pool_get_partition_index(
+	          cache_pool,
+	          second_handle_identifier,
+	          0,
+	          &partition_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "partition_index",
+	 partition_index,
+	 first_partition_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Offsets in the same region map onto the same partition
+	 */
+	result = libvmdk_cache_pool_get_partition_index(
+	          cache_pool,
+	          first_handle_identifier,
+	          ( (off64_t) 1 << LIBVMDK_CACHE_POOL_REGION_SIZE_SHIFT ) - 1,
+	          &partition_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "partition_index",
+	 partition_index,
+	 first_partition_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Consecutive regions map onto different partitions
+	 */
+	result = libvmdk_cache_pool_get_partition_index(
+	          cache_pool,
+	          first_handle_identifier,
+	          (off64_t) 1 << LIBVMDK_CACHE_POOL_REGION_SIZE_SHIFT,
+	          &partition_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "partition_index",
+	 partition_index,
+	 first_partition_index );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_cache_pool_get_partition_index(
+	          NULL,
+	          first_handle_identifier,
+	          0,
+	          &partition_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_pool_get_partition_index(
+	          cache_pool,
+	          first_handle_identifier,
+	          -1,
+	          &partition_index,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_pool_get_partition_index(
+	          cache_pool,
+	          first_handle_identifier,
+	          0,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_cache_pool_free(
+	          &cache_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache_pool != NULL )
+	{
+		libvmdk_cache_pool_free(
+		 &cache_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_cache_pool_grab_grains_cache and libvmdk_cache_pool_release_grains_cache functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_pool_grab_grains_cache(
+     void )
+{
+	libcerror_error_t *error         = NULL;
+	libfcache_cache_t *grains_cache  = NULL;
+	libvmdk_cache_pool_t *cache_pool = NULL;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_cache_pool_initialize(
+	          &cache_pool,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_pool",
+	 cache_pool );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_cache_pool_grab_grains_cache(
+	          cache_pool,
+	          0,
+	          &grains_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grains_cache",
+	 grains_cache );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_cache_pool_release_grains_cache(
+	          cache_pool,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_cache_pool_grab_grains_cache(
+	          NULL,
+	          0,
+	          &grains_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_pool_grab_grains_cache(
+	          cache_pool,
+	          LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS,
+	          &grains_cache,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_pool_grab_grains_cache(
+	          cache_pool,
+	          0,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_pool_release_grains_cache(
+	          NULL,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_cache_pool_release_grains_cache(
+	          cache_pool,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_cache_pool_free(
+	          &cache_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( cache_pool != NULL )
+	{
+		libvmdk_cache_pool_free(
+		 &cache_pool,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MKDTEMP )
+
+/* The media size of the disks created by the shared handles test
+ */
+#define VMDK_TEST_CACHE_POOL_MEDIA_SIZE		( 1024 * 1024 )
+
+/* The grain size of the disks created by the library
+ */
+#define VMDK_TEST_CACHE_POOL_GRAIN_SIZE		65536
+
+/* Creates a sparse disk of which the first grain is filled with a specific byte value
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_cache_pool_create_disk(
+     const char *filename,
+     uint8_t byte_value,
+     libcerror_error_t **error )
+{
+	uint8_t grain_data[ VMDK_TEST_CACHE_POOL_GRAIN_SIZE ];
+
+	libvmdk_handle_t *handle = NULL;
+	static char *function    = "vmdk_test_cache_pool_create_disk";
+	ssize_t write_count      = 0;
+
+	if( memory_set(
+	     grain_data,
+	     byte_value,
+	     VMDK_TEST_CACHE_POOL_GRAIN_SIZE ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to set grain data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_initialize(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_create_sparse(
+	     handle,
+	     filename,
+	     VMDK_TEST_CACHE_POOL_MEDIA_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create sparse disk.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libvmdk_handle_write_buffer_at_offset(
+	               handle,
+	               grain_data,
+	               VMDK_TEST_CACHE_POOL_GRAIN_SIZE,
+	               0,
+	               error );
+
+	if( write_count != (ssize_t) VMDK_TEST_CACHE_POOL_GRAIN_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write grain data.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_free(
+	     &handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free handle.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens a disk read-only using a specific cache pool
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_cache_pool_open_disk(
+     libvmdk_handle_t **handle,
+     const char *filename,
+     libvmdk_cache_pool_t *cache_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "vmdk_test_cache_pool_open_disk";
+
+	if( handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_initialize(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to create handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_set_cache_pool(
+	     *handle,
+	     cache_pool,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set cache pool.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_open(
+	     *handle,
+	     filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     *handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *handle != NULL )
+	{
+		libvmdk_handle_free(
+		 handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Reads the first grain of a disk and compares it with a specific byte value
+ * Returns 1 if the grain data matches, 0 if not or -1 on error
+ */
+int vmdk_test_cache_pool_compare_grain(
+     libvmdk_handle_t *handle,
+     uint8_t byte_value,
+     libcerror_error_t **error )
+{
+	uint8_t grain_data[ VMDK_TEST_CACHE_POOL_GRAIN_SIZE ];
+
+	static char *function = "vmdk_test_cache_pool_compare_grain";
+	size_t data_offset    = 0;
+	ssize_t read_count    = 0;
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              grain_data,
+	              VMDK_TEST_CACHE_POOL_GRAIN_SIZE,
+	              0,
+	              error );
+
+	if( read_count != (ssize_t) VMDK_TEST_CACHE_POOL_GRAIN_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read grain data.",
+		 function );
+
+		return( -1 );
+	}
+	for( data_offset = 0;
+	     data_offset < VMDK_TEST_CACHE_POOL_GRAIN_SIZE;
+	     data_offset++ )
+	{
+		if( grain_data[ data_offset ] != byte_value )
+		{
+			return( 0 );
+		}
+	}
+	return( 1 );
+}
+
+/* Tests sharing a cache pool between handles of disks with the same layout
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_cache_pool_shared_handles(
+     void )
+{
+	char directory_path[ 256 ];
+	char first_filename[ 512 ];
+	char second_filename[ 512 ];
+
+	libcerror_error_t *error         = NULL;
+	libvmdk_cache_pool_t *cache_pool = NULL;
+	libvmdk_handle_t *first_handle   = NULL;
+	libvmdk_handle_t *second_handle  = NULL;
+	int directory_created            = 0;
+	int handle_identifier            = 0;
+	int partition_index              = 0;
+	int result                       = 0;
+
+	result = vmdk_test_create_temporary_directory(
+	          directory_path,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	directory_created = 1;
+
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "first.vmdk",
+	          first_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "second.vmdk",
+	          second_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Create 2 disks with the same layout but different data
+	 */
+	result = vmdk_test_cache_pool_create_disk(
+	          first_filename,
+	          0x41,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_cache_pool_create_disk(
+	          second_filename,
+	          0x42,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_cache_pool_initialize(
+	          &cache_pool,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "cache_pool",
+	 cache_pool );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_cache_pool_open_disk(
+	          &first_handle,
+	          first_filename,
+	          cache_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_cache_pool_compare_grain(
+	          first_handle,
+	          0x41,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Attach handles until the next handle maps onto the same partitions
+	 * as the first handle, so that both handles share the grains caches
+	 */
+	for( partition_index = 1;
+	     partition_index < LIBVMDK_CACHE_POOL_NUMBER_OF_PARTITIONS;
+	     partition_index++ )
+	{
+		result = libvmdk_cache_pool_attach_handle(
+		          cache_pool,
+		          VMDK_TEST_CACHE_POOL_GRAIN_SIZE,
+		          &handle_identifier,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = vmdk_test_cache_pool_open_disk(
+	          &second_handle,
+	          second_filename,
+	          cache_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that each handle reads back its own data
+	 */
+	result = vmdk_test_cache_pool_compare_grain(
+	          second_handle,
+	          0x42,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_cache_pool_compare_grain(
+	          first_handle,
+	          0x41,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the second handle reads back its own data
+	 * after the first handle was closed
+	 */
+	result = libvmdk_handle_close(
+	          first_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_free(
+	          &first_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_cache_pool_compare_grain(
+	          second_handle,
+	          0x42,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_close(
+	          second_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_free(
+	          &second_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_cache_pool_free(
+	          &cache_pool,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_remove_temporary_directory(
+	          directory_path,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( second_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &second_handle,
+		 NULL );
+	}
+	if( first_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &first_handle,
+		 NULL );
+	}
+	if( cache_pool != NULL )
+	{
+		libvmdk_cache_pool_free(
+		 &cache_pool,
+		 NULL );
+	}
+	if( directory_created != 0 )
+	{
+		vmdk_test_remove_temporary_directory(
+		 directory_path,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MKDTEMP ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_pool_initialize",
+	 vmdk_test_cache_pool_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_pool_free",
+	 vmdk_test_cache_pool_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_pool_get_maximum_cache_size",
+	 vmdk_test_cache_pool_get_maximum_cache_size );
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_pool_attach_handle",
+	 vmdk_test_cache_pool_attach_handle );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_pool_get_partition_index",
+	 vmdk_test_cache_pool_get_partition_index );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_pool_grab_grains_cache",
+	 vmdk_test_cache_pool_grab_grains_cache );
+
+#if defined( HAVE_MKDTEMP )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_cache_pool_shared_handles",
+	 vmdk_test_cache_pool_shared_handles );
+
+#endif /* defined( HAVE_MKDTEMP ) */
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,1986 @@
+/*
+ * Library change_tracking_file type test program
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libbfio.h"
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_change_tracking_file.h"
+
+/* A change tracking file of 1000 sectors with blocks of 128 sectors and sequence number 5
+ * The remainder of the file header consists of 0-byte values
+ */
+uint8_t vmdk_test_change_tracking_file_header_data1[ 512 ] = {
+	0xa2, 0x72, 0x19, 0xf6, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00, 0x00, 0x00,
+	0xe8, 0x03, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x01, 0x02, 0x03,
+	0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+
+/* The block sequence numbers: 0, 3, 5, 0, 0, 1, 1, 4
+ */
+uint8_t vmdk_test_change_tracking_file_block_entries_data1[ 32 ] = {
+	0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00 };
+
+const char *vmdk_test_change_tracking_file_change_identifier1 = "52 01 02 03 04 05 06 07-08 09 0a 0b 0c 0d 0e 0f/5";
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Creates a change tracking file from the test data
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_change_tracking_file_create(
+     libvmdk_change_tracking_file_t **change_tracking_file,
+     libcerror_error_t **error )
+{
+	if( libvmdk_change_tracking_file_initialize(
+	     change_tracking_file,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libvmdk_change_tracking_file_read_file_header_data(
+	     *change_tracking_file,
+	     vmdk_test_change_tracking_file_header_data1,
+	     512,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libvmdk_change_tracking_file_read_block_entries_data(
+	     *change_tracking_file,
+	     vmdk_test_change_tracking_file_block_entries_data1,
+	     32,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	libvmdk_change_tracking_file_free(
+	 change_tracking_file,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Tests the libvmdk_change_tracking_file_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_initialize(
+     void )
+{
+	libcerror_error_t *error                             = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	int result                                           = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests                      = 1;
+	int number_of_memset_fail_tests                      = 1;
+	int test_number                                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	change_tracking_file = (libvmdk_change_tracking_file_t *) 0x12345678UL;
+
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	change_tracking_file = NULL;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_change_tracking_file_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_change_tracking_file_initialize(
+		          &change_tracking_file,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( change_tracking_file != NULL )
+			{
+				libvmdk_change_tracking_file_free(
+				 &change_tracking_file,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "change_tracking_file",
+			 change_tracking_file );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_change_tracking_file_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_change_tracking_file_initialize(
+		          &change_tracking_file,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( change_tracking_file != NULL )
+			{
+				libvmdk_change_tracking_file_free(
+				 &change_tracking_file,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "change_tracking_file",
+			 change_tracking_file );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_change_tracking_file_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_change_tracking_file_read_file_header_data function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_read_file_header_data(
+     void )
+{
+	uint8_t header_data[ 512 ];
+
+	libcerror_error_t *error                             = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_header_data1,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "change_tracking_file->block_size",
+	 change_tracking_file->block_size,
+	 (uint64_t) 65536 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "change_tracking_file->media_size",
+	 change_tracking_file->media_size,
+	 (uint64_t) 512000 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "change_tracking_file->number_of_blocks",
+	 change_tracking_file->number_of_blocks,
+	 8 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "change_tracking_file->sequence_number",
+	 change_tracking_file->sequence_number,
+	 5 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          NULL,
+	          vmdk_test_change_tracking_file_header_data1,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          NULL,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_header_data1,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_header_data1,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the signature is invalid
+	 */
+	if( memory_copy(
+	     header_data,
+	     vmdk_test_change_tracking_file_header_data1,
+	     512 ) == NULL )
+	{
+		goto on_error;
+	}
+	header_data[ 0 ] = 0xff;
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          header_data,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the number of blocks does not match the number of sectors
+	 */
+	header_data[ 0 ]  = 0xa2;
+	header_data[ 24 ] = 0x07;
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          header_data,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_change_tracking_file_read_block_entries_data function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_read_block_entries_data(
+     void )
+{
+	libcerror_error_t *error                             = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where the file header was not read
+	 */
+	result = libvmdk_change_tracking_file_read_block_entries_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_block_entries_data1,
+	          32,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_header_data1,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_read_block_entries_data(
+	          NULL,
+	          vmdk_test_change_tracking_file_block_entries_data1,
+	          32,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_read_block_entries_data(
+	          change_tracking_file,
+	          NULL,
+	          32,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_read_block_entries_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_block_entries_data1,
+	          28,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_change_tracking_file_read_block_entries_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_block_entries_data1,
+	          32,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file->block_sequence_numbers",
+	 change_tracking_file->block_sequence_numbers );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "change_tracking_file->block_sequence_numbers[ 2 ]",
+	 change_tracking_file->block_sequence_numbers[ 2 ],
+	 5 );
+
+	/* Test error case where the block sequence numbers were already read
+	 */
+	result = libvmdk_change_tracking_file_read_block_entries_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_block_entries_data1,
+	          32,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Reads a change tracking file from data using a memory range file IO handle
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_change_tracking_file_read_memory_range(
+     libvmdk_change_tracking_file_t *change_tracking_file,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	int result                       = 0;
+
+	if( libbfio_memory_range_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		return( -1 );
+	}
+	if( libbfio_memory_range_set(
+	     file_io_handle,
+	     data,
+	     data_size,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		goto on_error;
+	}
+	result = libvmdk_change_tracking_file_read_file_io_handle(
+	          change_tracking_file,
+	          file_io_handle,
+	          error );
+
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     NULL ) != 0 )
+	{
+		result = -1;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     NULL ) != 1 )
+	{
+		result = -1;
+	}
+	return( result );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Tests the libvmdk_change_tracking_file_read_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_read_file_io_handle(
+     void )
+{
+	uint8_t file_data[ 1056 ];
+
+	libcerror_error_t *error                             = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	void *memset_result                                  = NULL;
+	off64_t range_offset                                 = 0;
+	size64_t range_size                                  = 0;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	memset_result = memory_set(
+	                 file_data,
+	                 0,
+	                 sizeof( uint8_t ) * 1056 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "memset_result",
+	 memset_result );
+
+	memory_copy(
+	 file_data,
+	 vmdk_test_change_tracking_file_header_data1,
+	 512 );
+
+	memory_copy(
+	 &( file_data[ 512 ] ),
+	 vmdk_test_change_tracking_file_block_entries_data1,
+	 32 );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_change_tracking_file_read_memory_range(
+	          change_tracking_file,
+	          file_data,
+	          544,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "change_tracking_file->number_of_blocks",
+	 change_tracking_file->number_of_blocks,
+	 8 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "change_tracking_file->block_sequence_numbers[ 2 ]",
+	 change_tracking_file->block_sequence_numbers[ 2 ],
+	 5 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "change_tracking_file->has_unexpected_values",
+	 (int) change_tracking_file->has_unexpected_values,
+	 0 );
+
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular case with trailing data that consists of 0-byte values
+	 */
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_change_tracking_file_read_memory_range(
+	          change_tracking_file,
+	          file_data,
+	          1056,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "change_tracking_file->has_unexpected_values",
+	 (int) change_tracking_file->has_unexpected_values,
+	 0 );
+
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular case with trailing data that contains unexpected values
+	 * in which case all blocks are considered changed
+	 */
+	file_data[ 1055 ] = 0x01;
+
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_change_tracking_file_read_memory_range(
+	          change_tracking_file,
+	          file_data,
+	          1056,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "change_tracking_file->has_unexpected_values",
+	 (int) change_tracking_file->has_unexpected_values,
+	 1 );
+
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          change_tracking_file,
+	          5,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 512000 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	file_data[ 1055 ] = 0x00;
+
+	/* Test error cases
+	 */
+	result = vmdk_test_change_tracking_file_read_memory_range(
+	          NULL,
+	          file_data,
+	          544,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where the file header is truncated
+	 */
+	result = vmdk_test_change_tracking_file_read_memory_range(
+	          change_tracking_file,
+	          file_data,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the block entries are truncated
+	 */
+	result = vmdk_test_change_tracking_file_read_memory_range(
+	          change_tracking_file,
+	          file_data,
+	          540,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_change_tracking_file_get_utf8_change_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_get_utf8_change_identifier(
+     void )
+{
+	uint8_t utf8_string[ 64 ];
+
+	libcerror_error_t *error                             = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	size_t utf8_string_size                              = 0;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_change_tracking_file_create(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_change_tracking_file_get_utf8_change_identifier_size(
+	          change_tracking_file,
+	          &utf8_string_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "utf8_string_size",
+	 utf8_string_size,
+	 (size_t) 50 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_get_utf8_change_identifier(
+	          change_tracking_file,
+	          utf8_string,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = narrow_string_compare(
+	          (char *) utf8_string,
+	          vmdk_test_change_tracking_file_change_identifier1,
+	          50 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_get_utf8_change_identifier(
+	          NULL,
+	          utf8_string,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_get_utf8_change_identifier(
+	          change_tracking_file,
+	          NULL,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_get_utf8_change_identifier(
+	          change_tracking_file,
+	          utf8_string,
+	          49,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_get_sequence_number_from_utf8_change_identifier(
+     void )
+{
+	libcerror_error_t *error                             = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	uint32_t sequence_number                             = 0;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_change_tracking_file_create(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier(
+	          change_tracking_file,
+	          (uint8_t *) "52 01 02 03 04 05 06 07-08 09 0A 0B 0C 0D 0E 0F/3",
+	          49,
+	          &sequence_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "sequence_number",
+	 sequence_number,
+	 3 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier(
+	          change_tracking_file,
+	          (uint8_t *) "*",
+	          1,
+	          &sequence_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "sequence_number",
+	 sequence_number,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier(
+	          NULL,
+	          (uint8_t *) "*",
+	          1,
+	          &sequence_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier(
+	          change_tracking_file,
+	          (uint8_t *) "*",
+	          1,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the change tracking identifier does not match
+	 */
+	result = libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier(
+	          change_tracking_file,
+	          (uint8_t *) "52 01 02 03 04 05 06 07-08 09 0a 0b 0c 0d 0e ff/3",
+	          49,
+	          &sequence_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the sequence number exceeds the current sequence number
+	 */
+	result = libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier(
+	          change_tracking_file,
+	          (uint8_t *) "52 01 02 03 04 05 06 07-08 09 0a 0b 0c 0d 0e 0f/6",
+	          49,
+	          &sequence_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test error case where the separator is invalid
+	 */
+	result = libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier(
+	          change_tracking_file,
+	          (uint8_t *) "52 01 02 03 04 05 06 07 08 09 0a 0b 0c 0d 0e 0f/3",
+	          49,
+	          &sequence_number,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_change_tracking_file_get_next_changed_block_range function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_change_tracking_file_get_next_changed_block_range(
+     void )
+{
+	uint8_t header_data[ 512 ];
+
+	libcerror_error_t *error                             = NULL;
+	libvmdk_change_tracking_file_t *change_tracking_file = NULL;
+	size64_t range_size                                  = 0;
+	off64_t range_offset                                 = 0;
+	int result                                           = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_change_tracking_file_create(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          change_tracking_file,
+	          2,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 65536 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 131072 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the last range is clipped to the media size
+	 */
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          change_tracking_file,
+	          2,
+	          196608,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 458752 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 53248 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a range starts at an offset inside a changed block
+	 */
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          change_tracking_file,
+	          0,
+	          70000,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 70000 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 126608 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          change_tracking_file,
+	          5,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          change_tracking_file,
+	          0,
+	          512000,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          NULL,
+	          0,
+	          0,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          change_tracking_file,
+	          0,
+	          -1,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          change_tracking_file,
+	          0,
+	          0,
+	          NULL,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          change_tracking_file,
+	          0,
+	          0,
+	          &range_offset,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "change_tracking_file",
+	 change_tracking_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the remainder of the media is considered changed
+	 * when the file header contains an unexpected value
+	 */
+	if( memory_copy(
+	     header_data,
+	     vmdk_test_change_tracking_file_header_data1,
+	     512 ) == NULL )
+	{
+		goto on_error;
+	}
+	header_data[ 36 ] = 0x01;
+
+	result = libvmdk_change_tracking_file_initialize(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_read_file_header_data(
+	          change_tracking_file,
+	          header_data,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_read_block_entries_data(
+	          change_tracking_file,
+	          vmdk_test_change_tracking_file_block_entries_data1,
+	          32,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          change_tracking_file,
+	          5,
+	          70000,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) 70000 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 442000 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_get_next_changed_block_range(
+	          change_tracking_file,
+	          5,
+	          512000,
+	          &range_offset,
+	          &range_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_change_tracking_file_free(
+	          &change_tracking_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( change_tracking_file != NULL )
+	{
+		libvmdk_change_tracking_file_free(
+		 &change_tracking_file,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_initialize",
+	 vmdk_test_change_tracking_file_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_free",
+	 vmdk_test_change_tracking_file_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_read_file_header_data",
+	 vmdk_test_change_tracking_file_read_file_header_data );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_read_block_entries_data",
+	 vmdk_test_change_tracking_file_read_block_entries_data );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_read_file_io_handle",
+	 vmdk_test_change_tracking_file_read_file_io_handle );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_get_utf8_change_identifier",
+	 vmdk_test_change_tracking_file_get_utf8_change_identifier );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_get_sequence_number_from_utf8_change_identifier",
+	 vmdk_test_change_tracking_file_get_sequence_number_from_utf8_change_identifier );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_change_tracking_file_get_next_changed_block_range",
+	 vmdk_test_change_tracking_file_get_next_changed_block_range );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,400 @@
+/*
+ * Library delta_disk functions test program
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_delta_disk.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_delta_disk_is_supported_grain_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_delta_disk_is_supported_grain_size(
+     void )
+{
+	int result = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_delta_disk_is_supported_grain_size(
+	          (size64_t) 8192 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvmdk_delta_disk_is_supported_grain_size(
+	          (size64_t) 65536 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvmdk_delta_disk_is_supported_grain_size(
+	          (size64_t) 1048576 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test unsupported grain sizes
+	 */
+	result = libvmdk_delta_disk_is_supported_grain_size(
+	          0 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvmdk_delta_disk_is_supported_grain_size(
+	          (size64_t) 4096 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvmdk_delta_disk_is_supported_grain_size(
+	          (size64_t) 98304 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvmdk_delta_disk_is_supported_grain_size(
+	          (size64_t) 2097152 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libvmdk_delta_disk_get_metadata_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_delta_disk_get_metadata_size(
+     void )
+{
+	libcerror_error_t *error    = NULL;
+	size_t grain_directory_size = 0;
+	size_t metadata_size        = 0;
+	int result                  = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_delta_disk_get_metadata_size(
+	          (size64_t) 64 * 1024 * 1024,
+	          LIBVMDK_DELTA_DISK_DEFAULT_GRAIN_SIZE,
+	          &grain_directory_size,
+	          &metadata_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "grain_directory_size",
+	 grain_directory_size,
+	 (size_t) 512 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_size",
+	 metadata_size,
+	 (size_t) 65536 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* 8 GiB requires 256 grain directory entries
+	 */
+	result = libvmdk_delta_disk_get_metadata_size(
+	          (size64_t) 8 * 1024 * 1024 * 1024,
+	          LIBVMDK_DELTA_DISK_DEFAULT_GRAIN_SIZE,
+	          &grain_directory_size,
+	          &metadata_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "grain_directory_size",
+	 grain_directory_size,
+	 (size_t) 1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_size",
+	 metadata_size,
+	 (size_t) 65536 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* A grain size of 1 MiB rounds the metadata up to 1 MiB
+	 */
+	result = libvmdk_delta_disk_get_metadata_size(
+	          (size64_t) 64 * 1024 * 1024,
+	          (size64_t) 1024 * 1024,
+	          &grain_directory_size,
+	          &metadata_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "grain_directory_size",
+	 grain_directory_size,
+	 (size_t) 512 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "metadata_size",
+	 metadata_size,
+	 (size_t) 1048576 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_delta_disk_get_metadata_size(
+	          0,
+	          LIBVMDK_DELTA_DISK_DEFAULT_GRAIN_SIZE,
+	          &grain_directory_size,
+	          &metadata_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_delta_disk_get_metadata_size(
+	          (size64_t) 1000,
+	          LIBVMDK_DELTA_DISK_DEFAULT_GRAIN_SIZE,
+	          &grain_directory_size,
+	          &metadata_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_delta_disk_get_metadata_size(
+	          (size64_t) 64 * 1024 * 1024,
+	          (size64_t) 98304,
+	          &grain_directory_size,
+	          &metadata_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_delta_disk_get_metadata_size(
+	          (size64_t) 64 * 1024 * 1024,
+	          LIBVMDK_DELTA_DISK_DEFAULT_GRAIN_SIZE,
+	          NULL,
+	          &metadata_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_delta_disk_get_metadata_size(
+	          (size64_t) 64 * 1024 * 1024,
+	          LIBVMDK_DELTA_DISK_DEFAULT_GRAIN_SIZE,
+	          &grain_directory_size,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_delta_disk_write function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_delta_disk_write(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_delta_disk_write(
+	          NULL,
+	          (size64_t) 64 * 1024 * 1024,
+	          LIBVMDK_DELTA_DISK_DEFAULT_GRAIN_SIZE,
+	          0x12345678UL,
+	          0x87654321UL,
+	          (uint8_t *) "parent.vmdk",
+	          12,
+	          (uint8_t *) "child.vmdk",
+	          11,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_delta_disk_is_supported_grain_size",
+	 vmdk_test_delta_disk_is_supported_grain_size );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_delta_disk_get_metadata_size",
+	 vmdk_test_delta_disk_get_metadata_size );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_delta_disk_write",
+	 vmdk_test_delta_disk_write );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
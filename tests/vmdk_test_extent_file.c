@@ -21,6 +21,7 @@
 
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <types.h>
 
 #if defined( HAVE_STDLIB_H ) || defined( WINAPI )
@@ -338,6 +339,209 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvmdk_extent_file_get_allocation_values function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_extent_file_get_allocation_values(
+     void )
+{
+	uint64_t values[ LIBVMDK_NUMBER_OF_ALLOCATION_VALUES ];
+
+	libcerror_error_t *error           = NULL;
+	libvmdk_extent_file_t *extent_file = NULL;
+	libvmdk_io_handle_t *io_handle     = NULL;
+	int result                         = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_extent_file_initialize(
+	          &extent_file,
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "extent_file",
+	 extent_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( memory_set(
+	     values,
+	     0,
+	     sizeof( uint64_t ) * LIBVMDK_NUMBER_OF_ALLOCATION_VALUES ) == NULL )
+	{
+		goto on_error;
+	}
+	/* Test regular cases
+	 */
+	extent_file->grain_size = 65536;
+
+	result = libvmdk_extent_file_get_allocation_values(
+	          extent_file,
+	          NULL,
+	          values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVMDK_ALLOCATION_VALUE_GRAIN_SIZE ]",
+	 values[ LIBVMDK_ALLOCATION_VALUE_GRAIN_SIZE ],
+	 (uint64_t) 65536 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_GRAIN_TABLES ]",
+	 values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_GRAIN_TABLES ],
+	 (uint64_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_extent_file_get_allocation_values(
+	          NULL,
+	          NULL,
+	          values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_extent_file_get_allocation_values(
+	          extent_file,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	extent_file->grain_size = 0;
+
+	result = libvmdk_extent_file_get_allocation_values(
+	          extent_file,
+	          NULL,
+	          values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_extent_file_free(
+	          &extent_file,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "extent_file",
+	 extent_file );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( extent_file != NULL )
+	{
+		libvmdk_extent_file_free(
+		 &extent_file,
+		 NULL );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 /* The main program
@@ -391,6 +595,10 @@ int main(
 
 	/* TODO: add tests for libvmdk_extent_file_get_grain_group_at_offset */
 
+	VMDK_TEST_RUN(
+	 "libvmdk_extent_file_get_allocation_values",
+	 vmdk_test_extent_file_get_allocation_values );
+
 	/* TODO: add tests for libvmdk_extent_file_read_segment_data */
 
 	/* TODO: add tests for libvmdk_extent_file_seek_segment_offset */
@@ -30,6 +30,12 @@
 #include <stdlib.h>
 #endif
 
+#if defined( HAVE_MKDTEMP )
+#include <dirent.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #include "vmdk_test_libcerror.h"
 #include "vmdk_test_libclocale.h"
 #include "vmdk_test_libuna.h"
@@ -434,3 +440,443 @@ int vmdk_test_get_wide_source(
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+
+#if defined( HAVE_MKDTEMP )
+
+/* Creates a temporary directory
+ * The directory is created in the directory defined by the TMPDIR environment variable or in /tmp
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_create_temporary_directory(
+     char *directory_path,
+     size_t directory_path_size,
+     libcerror_error_t **error )
+{
+	const char *temporary_directory = NULL;
+	static char *function           = "vmdk_test_create_temporary_directory";
+	int print_count                 = 0;
+
+	if( directory_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory path.",
+		 function );
+
+		return( -1 );
+	}
+	if( directory_path_size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid directory path size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	temporary_directory = getenv(
+	                       "TMPDIR" );
+
+	if( ( temporary_directory == NULL )
+	 || ( temporary_directory[ 0 ] == 0 ) )
+	{
+		temporary_directory = "/tmp";
+	}
+	print_count = narrow_string_snprintf(
+	               directory_path,
+	               directory_path_size,
+	               "%s/vmdk_test_XXXXXX",
+	               temporary_directory );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= directory_path_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: directory path too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( mkdtemp(
+	     directory_path ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create temporary directory.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the path of a file in a temporary directory
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_get_temporary_filename(
+     const char *directory_path,
+     const char *name,
+     char *filename,
+     size_t filename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "vmdk_test_get_temporary_filename";
+	int print_count       = 0;
+
+	if( directory_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory path.",
+		 function );
+
+		return( -1 );
+	}
+	if( name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename_size > (size_t) INT_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid filename size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	print_count = narrow_string_snprintf(
+	               filename,
+	               filename_size,
+	               "%s/%s",
+	               directory_path,
+	               name );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= filename_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: filename too small.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Removes a temporary directory including the files it contains
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_remove_temporary_directory(
+     const char *directory_path,
+     libcerror_error_t **error )
+{
+	char filename[ 512 ];
+
+	struct dirent *directory_entry = NULL;
+	DIR *directory                 = NULL;
+	static char *function          = "vmdk_test_remove_temporary_directory";
+
+	if( directory_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid directory path.",
+		 function );
+
+		return( -1 );
+	}
+	directory = opendir(
+	             directory_path );
+
+	if( directory == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open temporary directory.",
+		 function );
+
+		return( -1 );
+	}
+	do
+	{
+		directory_entry = readdir(
+		                   directory );
+
+		if( directory_entry == NULL )
+		{
+			break;
+		}
+		if( ( narrow_string_compare(
+		       directory_entry->d_name,
+		       ".",
+		       2 ) == 0 )
+		 || ( narrow_string_compare(
+		       directory_entry->d_name,
+		       "..",
+		       3 ) == 0 ) )
+		{
+			continue;
+		}
+		if( vmdk_test_get_temporary_filename(
+		     directory_path,
+		     directory_entry->d_name,
+		     filename,
+		     512,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve filename.",
+			 function );
+
+			goto on_error;
+		}
+		if( unlink(
+		     filename ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 "%s: unable to remove file: %s.",
+			 function,
+			 filename );
+
+			goto on_error;
+		}
+	}
+	while( directory_entry != NULL );
+
+	if( closedir(
+	     directory ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close temporary directory.",
+		 function );
+
+		return( -1 );
+	}
+	if( rmdir(
+	     directory_path ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+		 "%s: unable to remove temporary directory.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	closedir(
+	 directory );
+
+	return( -1 );
+}
+
+/* Retrieves the size of a file
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_get_file_size(
+     const char *filename,
+     size64_t *file_size,
+     libcerror_error_t **error )
+{
+	struct stat file_statistics;
+
+	static char *function = "vmdk_test_get_file_size";
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( file_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file size.",
+		 function );
+
+		return( -1 );
+	}
+	if( stat(
+	     filename,
+	     &file_statistics ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_GENERIC,
+		 "%s: unable to retrieve file statistics of: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	*file_size = (size64_t) file_statistics.st_size;
+
+	return( 1 );
+}
+
+/* Reads data from a file
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_read_file_data(
+     const char *filename,
+     off64_t file_offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	FILE *file_stream     = NULL;
+	static char *function = "vmdk_test_read_file_data";
+	size_t read_count     = 0;
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	file_stream = file_stream_open(
+	               filename,
+	               FILE_STREAM_BINARY_OPEN_READ );
+
+	if( file_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file: %s.",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	if( file_stream_seek_offset(
+	     file_stream,
+	     file_offset,
+	     SEEK_SET ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 ".",
+		 function,
+		 file_offset );
+
+		goto on_error;
+	}
+	read_count = file_stream_read(
+	              file_stream,
+	              data,
+	              data_size );
+
+	if( read_count != data_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data.",
+		 function );
+
+		goto on_error;
+	}
+	if( file_stream_close(
+	     file_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+
+on_error:
+	file_stream_close(
+	 file_stream );
+
+	return( -1 );
+}
+
+#endif /* defined( HAVE_MKDTEMP ) */
+
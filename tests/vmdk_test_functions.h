@@ -47,6 +47,38 @@ int vmdk_test_get_wide_source(
 
 #endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
 
+#if defined( HAVE_MKDTEMP )
+
+int vmdk_test_create_temporary_directory(
+     char *directory_path,
+     size_t directory_path_size,
+     libcerror_error_t **error );
+
+int vmdk_test_get_temporary_filename(
+     const char *directory_path,
+     const char *name,
+     char *filename,
+     size_t filename_size,
+     libcerror_error_t **error );
+
+int vmdk_test_remove_temporary_directory(
+     const char *directory_path,
+     libcerror_error_t **error );
+
+int vmdk_test_get_file_size(
+     const char *filename,
+     size64_t *file_size,
+     libcerror_error_t **error );
+
+int vmdk_test_read_file_data(
+     const char *filename,
+     off64_t file_offset,
+     uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_MKDTEMP ) */
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,577 @@
+/*
+ * Library grain_verifier type test program
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_grain_verifier.h"
+#include "../libvmdk/libvmdk_stream_grain.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_grain_verifier_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_verifier_initialize(
+     void )
+{
+	libcerror_error_t *error                 = NULL;
+	libvmdk_grain_verifier_t *grain_verifier = NULL;
+	int result                               = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests          = 6;
+	int number_of_memset_fail_tests          = 2;
+	int test_number                          = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_grain_verifier_initialize(
+	          &grain_verifier,
+	          65536,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_verifier",
+	 grain_verifier );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_verifier->number_of_stream_grains",
+	 grain_verifier->number_of_stream_grains,
+	 1 );
+
+	result = libvmdk_grain_verifier_free(
+	          &grain_verifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grain_verifier",
+	 grain_verifier );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_verifier_initialize(
+	          NULL,
+	          65536,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	grain_verifier = (libvmdk_grain_verifier_t *) 0x12345678UL;
+
+	result = libvmdk_grain_verifier_initialize(
+	          &grain_verifier,
+	          65536,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	grain_verifier = NULL;
+
+	result = libvmdk_grain_verifier_initialize(
+	          &grain_verifier,
+	          1000,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_verifier_initialize(
+	          &grain_verifier,
+	          65536,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_grain_verifier_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_grain_verifier_initialize(
+		          &grain_verifier,
+		          65536,
+		          0,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( grain_verifier != NULL )
+			{
+				libvmdk_grain_verifier_free(
+				 &grain_verifier,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "grain_verifier",
+			 grain_verifier );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_grain_verifier_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_grain_verifier_initialize(
+		          &grain_verifier,
+		          65536,
+		          0,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( grain_verifier != NULL )
+			{
+				libvmdk_grain_verifier_free(
+				 &grain_verifier,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "grain_verifier",
+			 grain_verifier );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grain_verifier != NULL )
+	{
+		libvmdk_grain_verifier_free(
+		 &grain_verifier,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_grain_verifier_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_verifier_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_verifier_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_grain_verifier_submit_stream_grain and libvmdk_grain_verifier_check_pending_stream_grain functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_grain_verifier_submit_stream_grain(
+     void )
+{
+	uint64_t values[ LIBVMDK_NUMBER_OF_VERIFICATION_VALUES ];
+	uint8_t corrupted_grain_groups[ 2 ];
+
+	libcerror_error_t *error                 = NULL;
+	libvmdk_grain_verifier_t *grain_verifier = NULL;
+	libvmdk_stream_grain_t *stream_grain     = NULL;
+	int result                               = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 values,
+	 0,
+	 sizeof( uint64_t ) * LIBVMDK_NUMBER_OF_VERIFICATION_VALUES );
+
+	memory_set(
+	 corrupted_grain_groups,
+	 0,
+	 sizeof( uint8_t ) * 2 );
+
+	result = libvmdk_grain_verifier_initialize(
+	          &grain_verifier,
+	          65536,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "grain_verifier",
+	 grain_verifier );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test a grain with a grain marker of another grain
+	 */
+	stream_grain = grain_verifier->stream_grains[ 0 ];
+
+	memory_set(
+	 stream_grain->block_data,
+	 0,
+	 16 );
+
+	stream_grain->block_data[ 0 ] = 0x80;
+	stream_grain->block_data[ 8 ] = 4;
+	stream_grain->block_data_size = 16;
+	stream_grain->grain_index     = 0;
+
+	result = libvmdk_grain_verifier_submit_stream_grain(
+	          grain_verifier,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_verifier->number_of_pending_stream_grains",
+	 grain_verifier->number_of_pending_stream_grains,
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_verifier_submit_stream_grain(
+	          grain_verifier,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_grain_verifier_check_pending_stream_grain(
+	          grain_verifier,
+	          corrupted_grain_groups,
+	          values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "grain_verifier->number_of_pending_stream_grains",
+	 grain_verifier->number_of_pending_stream_grains,
+	 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_DECOMPRESSED_GRAINS ]",
+	 values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_DECOMPRESSED_GRAINS ],
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_CORRUPTED_GRAINS ]",
+	 values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_CORRUPTED_GRAINS ],
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "corrupted_grain_groups[ 0 ]",
+	 corrupted_grain_groups[ 0 ],
+	 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "corrupted_grain_groups[ 1 ]",
+	 corrupted_grain_groups[ 1 ],
+	 1 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_grain_verifier_check_pending_stream_grain(
+	          grain_verifier,
+	          corrupted_grain_groups,
+	          values,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_grain_verifier_submit_stream_grain(
+	          NULL,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_grain_verifier_free(
+	          &grain_verifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "grain_verifier",
+	 grain_verifier );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( grain_verifier != NULL )
+	{
+		libvmdk_grain_verifier_free(
+		 &grain_verifier,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_verifier_initialize",
+	 vmdk_test_grain_verifier_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_verifier_free",
+	 vmdk_test_grain_verifier_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_grain_verifier_submit_stream_grain",
+	 vmdk_test_grain_verifier_submit_stream_grain );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
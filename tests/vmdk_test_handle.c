@@ -19,8 +19,10 @@
  * along with this software.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <byte_stream.h>
 #include <common.h>
 #include <file_stream.h>
+#include <memory.h>
 #include <narrow_string.h>
 #include <system_string.h>
 #include <types.h>
@@ -240,26 +242,3681 @@ int vmdk_test_handle_close_source(
 	return( result );
 }
 
+#if defined( HAVE_MKDTEMP )
+
+/* The media size of the disks created by the write tests, which spans 2 grain tables
+ */
+#define VMDK_TEST_HANDLE_WRITE_MEDIA_SIZE		( 64 * 1024 * 1024 )
+
+/* The grain size of the disks created by the library
+ */
+#define VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE		65536
+
+/* The media size covered by a grain table of the disks created by the library
+ */
+#define VMDK_TEST_HANDLE_WRITE_GRAIN_TABLE_MEDIA_SIZE	( 512 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE )
+
+/* Retrieves the byte value of the test pattern at a specific (media) offset
+ * A seed of 0 represents 0-byte values
+ */
+uint8_t vmdk_test_handle_get_pattern_byte(
+         off64_t offset,
+         uint8_t seed )
+{
+	if( seed == 0 )
+	{
+		return( 0 );
+	}
+	return( (uint8_t) ( ( offset % 251 ) + seed ) );
+}
+
+/* Writes the test pattern at a specific (media) offset
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_handle_write_pattern(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     size_t size,
+     uint8_t seed,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "vmdk_test_handle_write_pattern";
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		buffer[ buffer_offset ] = vmdk_test_handle_get_pattern_byte(
+		                           offset + (off64_t) buffer_offset,
+		                           seed );
+	}
+	write_count = libvmdk_handle_write_buffer_at_offset(
+	               handle,
+	               buffer,
+	               size,
+	               offset,
+	               error );
+
+	memory_free(
+	 buffer );
+
+	if( write_count != (ssize_t) size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write pattern at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Reads data at a specific (media) offset and compares it with the test pattern
+ * The data in the pattern range is expected to contain the pattern of the seed,
+ * the data outside of it the pattern of the background seed
+ * Returns 1 if the data matches, 0 if not or -1 on error
+ */
+int vmdk_test_handle_compare_pattern(
+     libvmdk_handle_t *handle,
+     off64_t offset,
+     size_t size,
+     off64_t pattern_offset,
+     size_t pattern_size,
+     uint8_t seed,
+     uint8_t background_seed,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer        = NULL;
+	static char *function  = "vmdk_test_handle_compare_pattern";
+	size_t buffer_offset   = 0;
+	ssize_t read_count     = 0;
+	off64_t current_offset = 0;
+	uint8_t expected_byte  = 0;
+	int result             = 1;
+
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		return( -1 );
+	}
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count != (ssize_t) size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read data at offset: %" PRIi64 ".",
+		 function,
+		 offset );
+
+		memory_free(
+		 buffer );
+
+		return( -1 );
+	}
+	for( buffer_offset = 0;
+	     buffer_offset < size;
+	     buffer_offset++ )
+	{
+		current_offset = offset + (off64_t) buffer_offset;
+
+		if( ( current_offset >= pattern_offset )
+		 && ( current_offset < ( pattern_offset + (off64_t) pattern_size ) ) )
+		{
+			expected_byte = vmdk_test_handle_get_pattern_byte(
+			                 current_offset,
+			                 seed );
+		}
+		else
+		{
+			expected_byte = vmdk_test_handle_get_pattern_byte(
+			                 current_offset,
+			                 background_seed );
+		}
+		if( buffer[ buffer_offset ] != expected_byte )
+		{
+			result = 0;
+
+			break;
+		}
+	}
+	memory_free(
+	 buffer );
+
+	return( result );
+}
+
+/* Checks the file header and grain directories of a sparse extent file
+ * Returns 1 if the dirty flag is cleared and the grain tables referenced by
+ * the primary and secondary grain directory match, 0 if not or -1 on error
+ */
+int vmdk_test_handle_check_sparse_file(
+     const char *filename,
+     uint32_t *number_of_grain_tables,
+     libcerror_error_t **error )
+{
+	uint8_t file_header_data[ 512 ];
+
+	uint8_t *primary_grain_directory_data   = NULL;
+	uint8_t *primary_grain_table_data       = NULL;
+	uint8_t *secondary_grain_directory_data = NULL;
+	uint8_t *secondary_grain_table_data     = NULL;
+	static char *function                   = "vmdk_test_handle_check_sparse_file";
+	size_t grain_directory_size             = 0;
+	size_t grain_table_size                 = 0;
+	uint64_t grain_number_of_sectors        = 0;
+	uint64_t maximum_data_number_of_sectors = 0;
+	uint64_t number_of_grain_directory_entries = 0;
+	uint64_t primary_grain_directory_sector = 0;
+	uint64_t secondary_grain_directory_sector = 0;
+	uint32_t grain_directory_entry_index    = 0;
+	uint32_t number_of_grain_table_entries  = 0;
+	uint32_t primary_grain_table_sector     = 0;
+	uint32_t secondary_grain_table_sector   = 0;
+	int result                              = 1;
+
+	if( number_of_grain_tables == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of grain tables.",
+		 function );
+
+		return( -1 );
+	}
+	if( vmdk_test_read_file_data(
+	     filename,
+	     0,
+	     file_header_data,
+	     512,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file header.",
+		 function );
+
+		goto on_error;
+	}
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header_data[ 12 ] ),
+	 maximum_data_number_of_sectors );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header_data[ 20 ] ),
+	 grain_number_of_sectors );
+
+	byte_stream_copy_to_uint32_little_endian(
+	 &( file_header_data[ 44 ] ),
+	 number_of_grain_table_entries );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header_data[ 48 ] ),
+	 secondary_grain_directory_sector );
+
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header_data[ 56 ] ),
+	 primary_grain_directory_sector );
+
+	/* The dirty flag is stored at offset 72
+	 */
+	if( file_header_data[ 72 ] != 0 )
+	{
+		return( 0 );
+	}
+	if( ( grain_number_of_sectors == 0 )
+	 || ( number_of_grain_table_entries == 0 )
+	 || ( number_of_grain_table_entries > 4096 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file header.",
+		 function );
+
+		goto on_error;
+	}
+	number_of_grain_directory_entries = maximum_data_number_of_sectors / ( grain_number_of_sectors * number_of_grain_table_entries );
+
+	if( ( maximum_data_number_of_sectors % ( grain_number_of_sectors * number_of_grain_table_entries ) ) != 0 )
+	{
+		number_of_grain_directory_entries += 1;
+	}
+	grain_directory_size = (size_t) number_of_grain_directory_entries * 4;
+	grain_table_size     = (size_t) number_of_grain_table_entries * 4;
+
+	primary_grain_directory_data = (uint8_t *) memory_allocate(
+	                                            sizeof( uint8_t ) * grain_directory_size );
+
+	secondary_grain_directory_data = (uint8_t *) memory_allocate(
+	                                              sizeof( uint8_t ) * grain_directory_size );
+
+	primary_grain_table_data = (uint8_t *) memory_allocate(
+	                                        sizeof( uint8_t ) * grain_table_size );
+
+	secondary_grain_table_data = (uint8_t *) memory_allocate(
+	                                          sizeof( uint8_t ) * grain_table_size );
+
+	if( ( primary_grain_directory_data == NULL )
+	 || ( secondary_grain_directory_data == NULL )
+	 || ( primary_grain_table_data == NULL )
+	 || ( secondary_grain_table_data == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create grain directory or grain table data.",
+		 function );
+
+		goto on_error;
+	}
+	if( vmdk_test_read_file_data(
+	     filename,
+	     (off64_t) ( primary_grain_directory_sector * 512 ),
+	     primary_grain_directory_data,
+	     grain_directory_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read primary grain directory.",
+		 function );
+
+		goto on_error;
+	}
+	if( vmdk_test_read_file_data(
+	     filename,
+	     (off64_t) ( secondary_grain_directory_sector * 512 ),
+	     secondary_grain_directory_data,
+	     grain_directory_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read secondary grain directory.",
+		 function );
+
+		goto on_error;
+	}
+	*number_of_grain_tables = 0;
+
+	for( grain_directory_entry_index = 0;
+	     grain_directory_entry_index < (uint32_t) number_of_grain_directory_entries;
+	     grain_directory_entry_index++ )
+	{
+		byte_stream_copy_to_uint32_little_endian(
+		 &( primary_grain_directory_data[ grain_directory_entry_index * 4 ] ),
+		 primary_grain_table_sector );
+
+		byte_stream_copy_to_uint32_little_endian(
+		 &( secondary_grain_directory_data[ grain_directory_entry_index * 4 ] ),
+		 secondary_grain_table_sector );
+
+		if( ( primary_grain_table_sector == 0 )
+		 && ( secondary_grain_table_sector == 0 ) )
+		{
+			continue;
+		}
+		if( ( primary_grain_table_sector == 0 )
+		 || ( secondary_grain_table_sector == 0 ) )
+		{
+			result = 0;
+
+			break;
+		}
+		if( vmdk_test_read_file_data(
+		     filename,
+		     (off64_t) primary_grain_table_sector * 512,
+		     primary_grain_table_data,
+		     grain_table_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read primary grain table: %" PRIu32 ".",
+			 function,
+			 grain_directory_entry_index );
+
+			goto on_error;
+		}
+		if( vmdk_test_read_file_data(
+		     filename,
+		     (off64_t) secondary_grain_table_sector * 512,
+		     secondary_grain_table_data,
+		     grain_table_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read secondary grain table: %" PRIu32 ".",
+			 function,
+			 grain_directory_entry_index );
+
+			goto on_error;
+		}
+		if( memory_compare(
+		     primary_grain_table_data,
+		     secondary_grain_table_data,
+		     grain_table_size ) != 0 )
+		{
+			result = 0;
+
+			break;
+		}
+		*number_of_grain_tables += 1;
+	}
+	memory_free(
+	 secondary_grain_table_data );
+	memory_free(
+	 primary_grain_table_data );
+	memory_free(
+	 secondary_grain_directory_data );
+	memory_free(
+	 primary_grain_directory_data );
+
+	return( result );
+
+on_error:
+	if( secondary_grain_table_data != NULL )
+	{
+		memory_free(
+		 secondary_grain_table_data );
+	}
+	if( primary_grain_table_data != NULL )
+	{
+		memory_free(
+		 primary_grain_table_data );
+	}
+	if( secondary_grain_directory_data != NULL )
+	{
+		memory_free(
+		 secondary_grain_directory_data );
+	}
+	if( primary_grain_directory_data != NULL )
+	{
+		memory_free(
+		 primary_grain_directory_data );
+	}
+	return( -1 );
+}
+
+/* Reads the data of a file
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_handle_read_file(
+     const char *filename,
+     uint8_t **data,
+     size_t *data_size,
+     libcerror_error_t **error )
+{
+	static char *function = "vmdk_test_handle_read_file";
+	size64_t file_size    = 0;
+
+	if( ( data == NULL )
+	 || ( data_size == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data or data size.",
+		 function );
+
+		return( -1 );
+	}
+	if( vmdk_test_get_file_size(
+	     filename,
+	     &file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve file size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( file_size == 0 )
+	 || ( file_size > (size64_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid file size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	*data = (uint8_t *) memory_allocate(
+	                     sizeof( uint8_t ) * (size_t) file_size );
+
+	if( *data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create data.",
+		 function );
+
+		return( -1 );
+	}
+	if( vmdk_test_read_file_data(
+	     filename,
+	     0,
+	     *data,
+	     (size_t) file_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read file data.",
+		 function );
+
+		memory_free(
+		 *data );
+
+		*data = NULL;
+
+		return( -1 );
+	}
+	*data_size = (size_t) file_size;
+
+	return( 1 );
+}
+
+/* Closes a created handle and opens it again for reading
+ * The parent handle is optional
+ * Returns 1 if successful or -1 on error
+ */
+int vmdk_test_handle_reopen(
+     libvmdk_handle_t *handle,
+     const char *filename,
+     libvmdk_handle_t *parent_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "vmdk_test_handle_reopen";
+
+	if( libvmdk_handle_close(
+	     handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_open(
+	     handle,
+	     filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_handle != NULL )
+	{
+		if( libvmdk_handle_set_parent_handle(
+		     handle,
+		     parent_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set parent handle.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( HAVE_MKDTEMP ) */
+
 /* Tests the libvmdk_handle_initialize function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_initialize(
+int vmdk_test_handle_initialize(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvmdk_handle_t *handle        = NULL;
+	int result                      = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests = 1;
+	int number_of_memset_fail_tests = 1;
+	int test_number                 = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	handle = (libvmdk_handle_t *) 0x12345678UL;
+
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	handle = NULL;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_handle_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_handle_initialize(
+		          &handle,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( handle != NULL )
+			{
+				libvmdk_handle_free(
+				 &handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "handle",
+			 handle );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_handle_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_handle_initialize(
+		          &handle,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( handle != NULL )
+			{
+				libvmdk_handle_free(
+				 &handle,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "handle",
+			 handle );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_open function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_open(
+     const system_character_t *source )
+{
+	char narrow_source[ 256 ];
+
+	libcerror_error_t *error = NULL;
+	libvmdk_handle_t *handle = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_get_narrow_source(
+	          source,
+	          narrow_source,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	result = libvmdk_handle_open(
+	          handle,
+	          narrow_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_open(
+	          NULL,
+	          narrow_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open(
+	          handle,
+	          NULL,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open(
+	          handle,
+	          narrow_source,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test open when already opened
+	 */
+	result = libvmdk_handle_open(
+	          handle,
+	          narrow_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_WIDE_CHARACTER_TYPE )
+
+/* Tests the libvmdk_handle_open_wide function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_open_wide(
+     const system_character_t *source )
+{
+	wchar_t wide_source[ 256 ];
+
+	libcerror_error_t *error = NULL;
+	libvmdk_handle_t *handle = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = vmdk_test_get_wide_source(
+	          source,
+	          wide_source,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          wide_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_open_wide(
+	          NULL,
+	          wide_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          NULL,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          wide_source,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test open when already opened
+	 */
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          wide_source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
+
+/* Tests the libvmdk_handle_open_file_io_handle function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_open_file_io_handle(
+     const system_character_t *source )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	libcerror_error_t *error         = NULL;
+	libvmdk_handle_t *handle         = NULL;
+	size_t string_length             = 0;
+	int result                       = 0;
+
+	/* Initialize test
+	 */
+	result = libbfio_file_initialize(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VMDK_TEST_ASSERT_IS_NOT_NULL(
+         "file_io_handle",
+         file_io_handle );
+
+        VMDK_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	string_length = system_string_length(
+	                 source );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          source,
+	          string_length,
+	          &error );
+#endif
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+        VMDK_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open
+	 */
+	result = libvmdk_handle_open_file_io_handle(
+	          handle,
+	          file_io_handle,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_open_file_io_handle(
+	          NULL,
+	          file_io_handle,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open_file_io_handle(
+	          handle,
+	          NULL,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_open_file_io_handle(
+	          handle,
+	          file_io_handle,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test open when already opened
+	 */
+	result = libvmdk_handle_open_file_io_handle(
+	          handle,
+	          file_io_handle,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libbfio_handle_free(
+	          &file_io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+         "file_io_handle",
+         file_io_handle );
+
+        VMDK_TEST_ASSERT_IS_NULL(
+         "error",
+         error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_close function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_close(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_close(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_open and libvmdk_handle_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_open_close(
+     const system_character_t *source )
+{
+	libcerror_error_t *error = NULL;
+	libvmdk_handle_t *handle = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+#else
+	result = libvmdk_handle_open(
+	          handle,
+	          source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+#endif
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test open and close a second time to validate clean up on close
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          handle,
+	          source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+#else
+	result = libvmdk_handle_open(
+	          handle,
+	          source,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+#endif
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_signal_abort function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_signal_abort(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_signal_abort(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_signal_abort(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_read_buffer function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_read_buffer(
+     libvmdk_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	off64_t offset           = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reset offset to 0
+	 */
+	offset = libvmdk_handle_seek_offset(
+	          handle,
+	          0,
+	          SEEK_SET,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "offset",
+	 offset,
+	 (int64_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libvmdk_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Set offset to media_size - 8
+		 */
+		offset = libvmdk_handle_seek_offset(
+		          handle,
+		          -8,
+		          SEEK_END,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) media_size - 8 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libvmdk_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libvmdk_handle_read_buffer(
+		              handle,
+		              buffer,
+		              16,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Reset offset to 0
+		 */
+		offset = libvmdk_handle_seek_offset(
+		          handle,
+		          0,
+		          SEEK_SET,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT64(
+		 "offset",
+		 offset,
+		 (int64_t) 0 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	read_count = libvmdk_handle_read_buffer(
+	              NULL,
+	              buffer,
+	              16,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffer(
+	              handle,
+	              NULL,
+	              16,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffer(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_read_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_read_buffer_at_offset(
+     libvmdk_handle_t *handle )
+{
+	uint8_t buffer[ 16 ];
+
+	libcerror_error_t *error = NULL;
+	size64_t media_size      = 0;
+	ssize_t read_count       = 0;
+	int result               = 0;
+
+	/* Determine size
+	 */
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	if( media_size > 16 )
+	{
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              0,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 16 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer on media_size boundary
+		 */
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              media_size - 8,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 8 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* Read buffer beyond media_size boundary
+		 */
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              handle,
+		              buffer,
+		              16,
+		              media_size + 8,
+		              &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "read_count",
+		 read_count,
+		 (ssize_t) 0 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	/* Test error cases
+	 */
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              NULL,
+	              buffer,
+	              16,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              NULL,
+	              16,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              (size_t) SSIZE_MAX + 1,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              buffer,
+	              16,
+	              -1,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MKDTEMP )
+
+/* Tests the libvmdk_handle_write_buffer_at_offset function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_write_buffer_at_offset(
+     void )
+{
+	char directory_path[ 256 ];
+	char filename[ 512 ];
+
+	libcerror_error_t *error        = NULL;
+	libvmdk_handle_t *handle        = NULL;
+	uint32_t number_of_grain_tables = 0;
+	int directory_created           = 0;
+	int result                      = 0;
+
+	result = vmdk_test_create_temporary_directory(
+	          directory_path,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	directory_created = 1;
+
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "sparse.vmdk",
+	          filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Create a sparse disk and write a partial grain, a full grain
+	 * and a range that spans the boundary between 2 grain tables
+	 */
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_create_sparse(
+	          handle,
+	          filename,
+	          VMDK_TEST_HANDLE_WRITE_MEDIA_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_write_pattern(
+	          handle,
+	          1000,
+	          3000,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_write_pattern(
+	          handle,
+	          5 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          2,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_write_pattern(
+	          handle,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_TABLE_MEDIA_SIZE - 4096,
+	          8192,
+	          3,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading back the data from the writable handle
+	 */
+	result = vmdk_test_handle_compare_pattern(
+	          handle,
+	          0,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          1000,
+	          3000,
+	          1,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_flush(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the dirty flag was cleared and that the primary
+	 * and secondary grain directories match
+	 */
+	result = vmdk_test_handle_check_sparse_file(
+	          filename,
+	          &number_of_grain_tables,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "number_of_grain_tables",
+	 number_of_grain_tables,
+	 2 );
+
+	/* Reopen the disk read-only and test the data
+	 */
+	result = libvmdk_handle_open(
+	          handle,
+	          filename,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_open_extent_data_files(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_compare_pattern(
+	          handle,
+	          0,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          1000,
+	          3000,
+	          1,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_compare_pattern(
+	          handle,
+	          4 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          5 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          2,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_compare_pattern(
+	          handle,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_TABLE_MEDIA_SIZE - VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          2 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_TABLE_MEDIA_SIZE - 4096,
+	          8192,
+	          3,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that a grain that was not written reads back as 0-byte values
+	 */
+	result = vmdk_test_handle_compare_pattern(
+	          handle,
+	          100 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          0,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_remove_temporary_directory(
+	          directory_path,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( directory_created != 0 )
+	{
+		vmdk_test_remove_temporary_directory(
+		 directory_path,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MKDTEMP ) */
+
+/* Tests the libvmdk_handle_discard function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_discard(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_discard(
+	          NULL,
+	          0,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test discard on a handle that was not opened for writing
+	 */
+	result = libvmdk_handle_discard(
+	          handle,
+	          0,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MKDTEMP )
+
+/* Tests the libvmdk_handle_discard function on a created disk
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_discard_write(
+     void )
+{
+	char directory_path[ 256 ];
+	char child_filename[ 512 ];
+	char filename[ 512 ];
+
+	libcerror_error_t *error       = NULL;
+	libvmdk_handle_t *child_handle = NULL;
+	libvmdk_handle_t *handle       = NULL;
+	size64_t range_size            = 0;
+	uint32_t range_flags           = 0;
+	int directory_created          = 0;
+	int result                     = 0;
+
+	result = vmdk_test_create_temporary_directory(
+	          directory_path,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	directory_created = 1;
+
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "sparse.vmdk",
+	          filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "child.vmdk",
+	          child_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Create a sparse disk with data in grains 2 and 3
+	 */
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_create_sparse(
+	          handle,
+	          filename,
+	          VMDK_TEST_HANDLE_WRITE_MEDIA_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_write_pattern(
+	          handle,
+	          2 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          2 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test discarding a full grain and part of a grain
+	 */
+	result = libvmdk_handle_discard(
+	          handle,
+	          2 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_discard(
+	          handle,
+	          ( 3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 100,
+	          1000,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reopen the disk read-only and test the discarded data
+	 */
+	result = libvmdk_handle_open(
+	          handle,
+	          filename,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_open_extent_data_files(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_get_data_range_at_offset(
+	          handle,
+	          2 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0;
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE );
+
+	result = vmdk_test_handle_compare_pattern(
+	          handle,
+	          2 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          0,
+	          0,
+	          0,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_compare_pattern(
+	          handle,
+	          3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          ( 3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 100,
+	          1000,
+	          0,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that discard is not supported on a delta disk
+	 */
+	result = libvmdk_handle_initialize(
+	          &child_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_create_child(
+	          child_handle,
+	          child_filename,
+	          handle,
+	          "sparse.vmdk",
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_discard(
+	          child_handle,
+	          2 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_close(
+	          child_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_free(
+	          &child_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_remove_temporary_directory(
+	          directory_path,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( child_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &child_handle,
+		 NULL );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( directory_created != 0 )
+	{
+		vmdk_test_remove_temporary_directory(
+		 directory_path,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Test trace callback that counts the trace events per trace phase
+ */
+void vmdk_test_handle_trace_callback(
+      int trace_phase,
+      int trace_event,
+      uint64_t timestamp VMDK_TEST_ATTRIBUTE_UNUSED,
+      uint64_t size VMDK_TEST_ATTRIBUTE_UNUSED,
+      void *callback_data )
+{
+	int *number_of_trace_events = NULL;
+
+	VMDK_TEST_UNREFERENCED_PARAMETER( timestamp )
+	VMDK_TEST_UNREFERENCED_PARAMETER( size )
+
+	if( ( callback_data == NULL )
+	 || ( trace_phase < LIBVMDK_TRACE_PHASE_EXTENT_LOOKUP )
+	 || ( trace_phase > LIBVMDK_TRACE_PHASE_PARENT_FORWARD )
+	 || ( trace_event < LIBVMDK_TRACE_EVENT_BEGIN )
+	 || ( trace_event > LIBVMDK_TRACE_EVENT_ERROR ) )
+	{
+		return;
+	}
+	number_of_trace_events = (int *) callback_data;
+
+	number_of_trace_events[ ( trace_phase * 4 ) + trace_event ] += 1;
+}
+
+/* Tests the libvmdk_handle_set_trace_callback function when reading
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_trace_read(
+     void )
+{
+	char directory_path[ 256 ];
+	char filename[ 512 ];
+
+	int number_of_trace_events[ 6 * 4 ];
+
+	libcerror_error_t *error = NULL;
+	libvmdk_handle_t *handle = NULL;
+	int directory_created    = 0;
+	int result               = 0;
+	int trace_phase          = 0;
+
+	result = vmdk_test_create_temporary_directory(
+	          directory_path,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	directory_created = 1;
+
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "sparse.vmdk",
+	          filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Create a sparse disk with an allocated first grain
+	 */
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "handle",
+	 handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_create_sparse(
+	          handle,
+	          filename,
+	          VMDK_TEST_HANDLE_WRITE_MEDIA_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_write_pattern(
+	          handle,
+	          0,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reopen the disk read-only and read an allocated and a sparse grain
+	 * with the trace callback set
+	 */
+	result = libvmdk_handle_open(
+	          handle,
+	          filename,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_open_extent_data_files(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( memory_set(
+	     number_of_trace_events,
+	     0,
+	     sizeof( int ) * 6 * 4 ) == NULL )
+	{
+		goto on_error;
+	}
+	result = libvmdk_handle_set_trace_callback(
+	          handle,
+	          &vmdk_test_handle_trace_callback,
+	          (void *) number_of_trace_events,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_compare_pattern(
+	          handle,
+	          0,
+	          2 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          0,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          1,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the trace callback was invoked for the extent lookup of both grains
+	 * and the load of the allocated grain
+	 */
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_trace_events[ EXTENT_LOOKUP, BEGIN ]",
+	 number_of_trace_events[ ( LIBVMDK_TRACE_PHASE_EXTENT_LOOKUP * 4 ) + LIBVMDK_TRACE_EVENT_BEGIN ],
+	 2 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_trace_events[ GRAIN_DATA_LOAD, BEGIN ]",
+	 number_of_trace_events[ ( LIBVMDK_TRACE_PHASE_GRAIN_DATA_LOAD * 4 ) + LIBVMDK_TRACE_EVENT_BEGIN ],
+	 1 );
+
+	/* Test that every begin event is matched by an end event
+	 */
+	for( trace_phase = LIBVMDK_TRACE_PHASE_EXTENT_LOOKUP;
+	     trace_phase <= LIBVMDK_TRACE_PHASE_PARENT_FORWARD;
+	     trace_phase++ )
+	{
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "number_of_trace_events[ END ]",
+		 number_of_trace_events[ ( trace_phase * 4 ) + LIBVMDK_TRACE_EVENT_END ],
+		 number_of_trace_events[ ( trace_phase * 4 ) + LIBVMDK_TRACE_EVENT_BEGIN ] );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "number_of_trace_events[ ERROR ]",
+		 number_of_trace_events[ ( trace_phase * 4 ) + LIBVMDK_TRACE_EVENT_ERROR ],
+		 0 );
+	}
+	/* Test that the trace callback is no longer invoked after it was disabled
+	 */
+	result = libvmdk_handle_set_trace_callback(
+	          handle,
+	          NULL,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_compare_pattern(
+	          handle,
+	          0,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          0,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          1,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "number_of_trace_events[ EXTENT_LOOKUP, BEGIN ]",
+	 number_of_trace_events[ ( LIBVMDK_TRACE_PHASE_EXTENT_LOOKUP * 4 ) + LIBVMDK_TRACE_EVENT_BEGIN ],
+	 2 );
+
+	/* Clean up
+	 */
+	result = libvmdk_handle_close(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_remove_temporary_directory(
+	          directory_path,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( directory_created != 0 )
+	{
+		vmdk_test_remove_temporary_directory(
+		 directory_path,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MKDTEMP ) */
+
+/* Tests the libvmdk_handle_flush function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_flush(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_flush(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_flush(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_create_child function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_create_child(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_create_child(
+	          NULL,
+	          "child.vmdk",
+	          handle,
+	          "parent.vmdk",
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a handle that is already open
+	 */
+	result = libvmdk_handle_create_child(
+	          handle,
+	          "child.vmdk",
+	          handle,
+	          "parent.vmdk",
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MKDTEMP )
+
+/* Tests the libvmdk_handle_create_child function with a write to the child
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_create_child_write(
      void )
 {
-	libcerror_error_t *error        = NULL;
-	libvmdk_handle_t *handle        = NULL;
-	int result                      = 0;
+	char directory_path[ 256 ];
+	char child_filename[ 512 ];
+	char parent_filename[ 512 ];
+	uint8_t utf8_string[ 64 ];
+
+	libcerror_error_t *error              = NULL;
+	libvmdk_handle_t *child_handle        = NULL;
+	libvmdk_handle_t *parent_handle       = NULL;
+	uint8_t *parent_data                  = NULL;
+	uint8_t *parent_data_after_write      = NULL;
+	size_t parent_data_after_write_size   = 0;
+	size_t parent_data_size               = 0;
+	uint32_t content_identifier           = 0;
+	uint32_t parent_content_identifier    = 0;
+	int directory_created                 = 0;
+	int result                            = 0;
+
+	result = vmdk_test_create_temporary_directory(
+	          directory_path,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	directory_created = 1;
+
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "parent.vmdk",
+	          parent_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "child.vmdk",
+	          child_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Create a parent with data in grain 3
+	 */
+	result = libvmdk_handle_initialize(
+	          &parent_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_create_sparse(
+	          parent_handle,
+	          parent_filename,
+	          VMDK_TEST_HANDLE_WRITE_MEDIA_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_write_pattern(
+	          parent_handle,
+	          3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          4,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          parent_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_read_file(
+	          parent_filename,
+	          &parent_data,
+	          &parent_data_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_open(
+	          parent_handle,
+	          parent_filename,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_open_extent_data_files(
+	          parent_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_get_content_identifier(
+	          parent_handle,
+	          &content_identifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Create a child and write part of grain 3
+	 */
+	result = libvmdk_handle_initialize(
+	          &child_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_create_child(
+	          child_handle,
+	          child_filename,
+	          parent_handle,
+	          "parent.vmdk",
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_write_pattern(
+	          child_handle,
+	          ( 3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 100,
+	          1000,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          child_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Reopen the child with the parent and test the data
+	 */
+	result = libvmdk_handle_open(
+	          child_handle,
+	          child_filename,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_open_extent_data_files(
+	          child_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_set_parent_handle(
+	          child_handle,
+	          parent_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_get_parent_content_identifier(
+	          child_handle,
+	          &parent_content_identifier,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "parent_content_identifier",
+	 parent_content_identifier,
+	 content_identifier );
+
+	result = libvmdk_handle_get_utf8_parent_filename(
+	          child_handle,
+	          utf8_string,
+	          64,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-#if defined( HAVE_VMDK_TEST_MEMORY )
-	int number_of_malloc_fail_tests = 1;
-	int number_of_memset_fail_tests = 1;
-	int test_number                 = 0;
-#endif
+	result = narrow_string_compare(
+	          (char *) utf8_string,
+	          "parent.vmdk",
+	          12 );
 
-	/* Test regular cases
-	 */
-	result = libvmdk_handle_initialize(
-	          &handle,
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = vmdk_test_handle_compare_pattern(
+	          child_handle,
+	          3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          ( 3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 100,
+	          1000,
+	          1,
+	          4,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -267,16 +3924,18 @@ int vmdk_test_handle_initialize(
 	 result,
 	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
-
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libvmdk_handle_free(
-	          &handle,
+	result = vmdk_test_handle_compare_pattern(
+	          child_handle,
+	          4 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          0,
+	          0,
+	          0,
+	          0,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -285,138 +3944,136 @@ int vmdk_test_handle_initialize(
 	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
+	 "error",
+	 error );
+
+	/* Test that the parent still contains its own data
+	 */
+	result = vmdk_test_handle_compare_pattern(
+	          parent_handle,
+	          3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          4,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libvmdk_handle_initialize(
-	          NULL,
+	result = libvmdk_handle_close(
+	          child_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 0 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = libvmdk_handle_free(
+	          &child_handle,
+	          &error );
 
-	handle = (libvmdk_handle_t *) 0x12345678UL;
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	result = libvmdk_handle_initialize(
-	          &handle,
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_close(
+	          parent_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 0 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	result = libvmdk_handle_free(
+	          &parent_handle,
+	          &error );
 
-	handle = NULL;
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-#if defined( HAVE_VMDK_TEST_MEMORY )
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	for( test_number = 0;
-	     test_number < number_of_malloc_fail_tests;
-	     test_number++ )
-	{
-		/* Test libvmdk_handle_initialize with malloc failing
-		 */
-		vmdk_test_malloc_attempts_before_fail = test_number;
+	/* Test that the parent file was not changed
+	 */
+	result = vmdk_test_handle_read_file(
+	          parent_filename,
+	          &parent_data_after_write,
+	          &parent_data_after_write_size,
+	          &error );
 
-		result = libvmdk_handle_initialize(
-		          &handle,
-		          &error );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		if( vmdk_test_malloc_attempts_before_fail != -1 )
-		{
-			vmdk_test_malloc_attempts_before_fail = -1;
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-			if( handle != NULL )
-			{
-				libvmdk_handle_free(
-				 &handle,
-				 NULL );
-			}
-		}
-		else
-		{
-			VMDK_TEST_ASSERT_EQUAL_INT(
-			 "result",
-			 result,
-			 -1 );
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "parent_data_after_write_size",
+	 parent_data_after_write_size,
+	 parent_data_size );
 
-			VMDK_TEST_ASSERT_IS_NULL(
-			 "handle",
-			 handle );
+	result = memory_compare(
+	          parent_data_after_write,
+	          parent_data,
+	          parent_data_size );
 
-			VMDK_TEST_ASSERT_IS_NOT_NULL(
-			 "error",
-			 error );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-			libcerror_error_free(
-			 &error );
-		}
-	}
-	for( test_number = 0;
-	     test_number < number_of_memset_fail_tests;
-	     test_number++ )
-	{
-		/* Test libvmdk_handle_initialize with memset failing
-		 */
-		vmdk_test_memset_attempts_before_fail = test_number;
+	memory_free(
+	 parent_data_after_write );
 
-		result = libvmdk_handle_initialize(
-		          &handle,
-		          &error );
+	parent_data_after_write = NULL;
 
-		if( vmdk_test_memset_attempts_before_fail != -1 )
-		{
-			vmdk_test_memset_attempts_before_fail = -1;
+	memory_free(
+	 parent_data );
 
-			if( handle != NULL )
-			{
-				libvmdk_handle_free(
-				 &handle,
-				 NULL );
-			}
-		}
-		else
-		{
-			VMDK_TEST_ASSERT_EQUAL_INT(
-			 "result",
-			 result,
-			 -1 );
+	parent_data = NULL;
 
-			VMDK_TEST_ASSERT_IS_NULL(
-			 "handle",
-			 handle );
+	result = vmdk_test_remove_temporary_directory(
+	          directory_path,
+	          &error );
 
-			VMDK_TEST_ASSERT_IS_NOT_NULL(
-			 "error",
-			 error );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-			libcerror_error_free(
-			 &error );
-		}
-	}
-#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
 	return( 1 );
 
@@ -426,28 +4083,134 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( handle != NULL )
+	if( child_handle != NULL )
 	{
 		libvmdk_handle_free(
-		 &handle,
+		 &child_handle,
+		 NULL );
+	}
+	if( parent_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &parent_handle,
+		 NULL );
+	}
+	if( parent_data_after_write != NULL )
+	{
+		memory_free(
+		 parent_data_after_write );
+	}
+	if( parent_data != NULL )
+	{
+		memory_free(
+		 parent_data );
+	}
+	if( directory_created != 0 )
+	{
+		vmdk_test_remove_temporary_directory(
+		 directory_path,
 		 NULL );
 	}
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_free function
+#endif /* defined( HAVE_MKDTEMP ) */
+
+/* Tests the libvmdk_handle_create_sparse function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_free(
-     void )
+int vmdk_test_handle_create_sparse(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_create_sparse(
+	          NULL,
+	          "sparse.vmdk",
+	          1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a handle that is already open
+	 */
+	result = libvmdk_handle_create_sparse(
+	          handle,
+	          "sparse.vmdk",
+	          1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_create_split_sparse function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_create_split_sparse(
+     libvmdk_handle_t *handle )
 {
 	libcerror_error_t *error = NULL;
 	int result               = 0;
 
-	/* Test error cases
+	/* Test error cases
+	 */
+	result = libvmdk_handle_create_split_sparse(
+	          NULL,
+	          "split.vmdk",
+	          1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Test with a handle that is already open
 	 */
-	result = libvmdk_handle_free(
-	          NULL,
+	result = libvmdk_handle_create_split_sparse(
+	          handle,
+	          "split.vmdk",
+	          1048576,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -473,24 +4236,23 @@ on_error:
 	return( 0 );
 }
 
-/* Tests the libvmdk_handle_open function
+/* Tests the libvmdk_handle_get_data_range_at_offset function
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_open(
-     const system_character_t *source )
+int vmdk_test_handle_get_data_range_at_offset(
+     libvmdk_handle_t *handle )
 {
-	char narrow_source[ 256 ];
-
 	libcerror_error_t *error = NULL;
-	libvmdk_handle_t *handle = NULL;
+	size64_t media_size      = 0;
+	size64_t range_size      = 0;
+	uint32_t range_flags     = 0;
 	int result               = 0;
 
-	/* Initialize test
+	/* Determine size
 	 */
-	result = vmdk_test_get_narrow_source(
-	          source,
-	          narrow_source,
-	          256,
+	result = libvmdk_handle_get_media_size(
+	          handle,
+	          &media_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -502,35 +4264,173 @@ int vmdk_test_handle_open(
 	 "error",
 	 error );
 
-	result = libvmdk_handle_initialize(
-	          &handle,
+	/* Test regular cases
+	 */
+	if( media_size > 0 )
+	{
+		result = libvmdk_handle_get_data_range_at_offset(
+		          handle,
+		          0,
+		          &range_size,
+		          &range_flags,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VMDK_TEST_ASSERT_NOT_EQUAL_INT64(
+		 "range_size",
+		 (int64_t) range_size,
+		 (int64_t) 0 );
+
+		VMDK_TEST_ASSERT_LESS_THAN_UINT64(
+		 "range_size",
+		 (uint64_t) range_size,
+		 (uint64_t) media_size + 1 );
+	}
+	result = libvmdk_handle_get_data_range_at_offset(
+	          handle,
+	          (off64_t) media_size,
+	          &range_size,
+	          &range_flags,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_handle_get_data_range_at_offset(
+	          NULL,
+	          0,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
+	 "error",
+	 error );
 
-	VMDK_TEST_ASSERT_IS_NULL(
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_handle_get_data_range_at_offset(
+	          handle,
+	          -1,
+	          &range_size,
+	          &range_flags,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
-	/* Test open
+	libcerror_error_free(
+	 &error );
+
+	if( media_size > 0 )
+	{
+		result = libvmdk_handle_get_data_range_at_offset(
+		          handle,
+		          0,
+		          NULL,
+		          &range_flags,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+
+		result = libvmdk_handle_get_data_range_at_offset(
+		          handle,
+		          0,
+		          &range_size,
+		          NULL,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_handle_get_next_changed_range function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_get_next_changed_range(
+     libvmdk_handle_t *handle )
+{
+	libcerror_error_t *error = NULL;
+	size64_t range_size      = 0;
+	off64_t range_offset     = 0;
+	int result               = 0;
+
+	/* Test regular cases
 	 */
-	result = libvmdk_handle_open(
+	result = libvmdk_handle_get_next_changed_range(
 	          handle,
-	          narrow_source,
-	          LIBVMDK_OPEN_READ,
+	          handle,
+	          0,
+	          &range_offset,
+	          &range_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 range_size,
+	 (uint64_t) 0 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
@@ -538,10 +4438,12 @@ int vmdk_test_handle_open(
 
 	/* Test error cases
 	 */
-	result = libvmdk_handle_open(
+	result = libvmdk_handle_get_next_changed_range(
 	          NULL,
-	          narrow_source,
-	          LIBVMDK_OPEN_READ,
+	          handle,
+	          0,
+	          &range_offset,
+	          &range_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -556,10 +4458,12 @@ int vmdk_test_handle_open(
 	libcerror_error_free(
 	 &error );
 
-	result = libvmdk_handle_open(
+	result = libvmdk_handle_get_next_changed_range(
 	          handle,
 	          NULL,
-	          LIBVMDK_OPEN_READ,
+	          0,
+	          &range_offset,
+	          &range_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -574,10 +4478,12 @@ int vmdk_test_handle_open(
 	libcerror_error_free(
 	 &error );
 
-	result = libvmdk_handle_open(
+	result = libvmdk_handle_get_next_changed_range(
+	          handle,
 	          handle,
-	          narrow_source,
 	          -1,
+	          &range_offset,
+	          &range_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -592,12 +4498,12 @@ int vmdk_test_handle_open(
 	libcerror_error_free(
 	 &error );
 
-	/* Test open when already opened
-	 */
-	result = libvmdk_handle_open(
+	result = libvmdk_handle_get_next_changed_range(
 	          handle,
-	          narrow_source,
-	          LIBVMDK_OPEN_READ,
+	          handle,
+	          0,
+	          NULL,
+	          &range_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -612,25 +4518,26 @@ int vmdk_test_handle_open(
 	libcerror_error_free(
 	 &error );
 
-	/* Clean up
-	 */
-	result = libvmdk_handle_free(
-	          &handle,
+	result = libvmdk_handle_get_next_changed_range(
+	          handle,
+	          handle,
+	          0,
+	          &range_offset,
+	          NULL,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
-
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
+	 -1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
 	 error );
 
+	libcerror_error_free(
+	 &error );
+
 	return( 1 );
 
 on_error:
@@ -639,35 +4546,58 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
-	if( handle != NULL )
-	{
-		libvmdk_handle_free(
-		 &handle,
-		 NULL );
-	}
 	return( 0 );
 }
 
-#if defined( HAVE_WIDE_CHARACTER_TYPE )
+#if defined( HAVE_MKDTEMP )
 
-/* Tests the libvmdk_handle_open_wide function
+/* Tests the libvmdk_handle_get_next_changed_range function with created disks
+ * The disks are a parent with data in grain 3, 2 children of the parent that both
+ * contain the same data in grain 5 and of which the second also contains a sector
+ * of data in grain 7, and an unrelated disk with the data of the parent and a sector
+ * of data in grain 9
  * Returns 1 if successful or 0 if not
  */
-int vmdk_test_handle_open_wide(
-     const system_character_t *source )
+int vmdk_test_handle_get_next_changed_range_write(
+     void )
 {
-	wchar_t wide_source[ 256 ];
+	char directory_path[ 256 ];
+	char first_child_filename[ 512 ];
+	char parent_filename[ 512 ];
+	char second_child_filename[ 512 ];
+	char unrelated_filename[ 512 ];
+
+	libcerror_error_t *error                = NULL;
+	libvmdk_handle_t *first_child_handle    = NULL;
+	libvmdk_handle_t *parent_handle         = NULL;
+	libvmdk_handle_t *second_child_handle   = NULL;
+	libvmdk_handle_t *unrelated_handle      = NULL;
+	size64_t range_size                     = 0;
+	off64_t range_offset                    = 0;
+	int directory_created                   = 0;
+	int result                              = 0;
+
+	result = vmdk_test_create_temporary_directory(
+	          directory_path,
+	          256,
+	          &error );
 
-	libcerror_error_t *error = NULL;
-	libvmdk_handle_t *handle = NULL;
-	int result               = 0;
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* Initialize test
-	 */
-	result = vmdk_test_get_wide_source(
-	          source,
-	          wide_source,
-	          256,
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	directory_created = 1;
+
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "parent.vmdk",
+	          parent_filename,
+	          512,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -679,8 +4609,11 @@ int vmdk_test_handle_open_wide(
 	 "error",
 	 error );
 
-	result = libvmdk_handle_initialize(
-	          &handle,
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "child1.vmdk",
+	          first_child_filename,
+	          512,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -688,20 +4621,31 @@ int vmdk_test_handle_open_wide(
 	 result,
 	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "child2.vmdk",
+	          second_child_filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test open
-	 */
-	result = libvmdk_handle_open_wide(
-	          handle,
-	          wide_source,
-	          LIBVMDK_OPEN_READ,
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "unrelated.vmdk",
+	          unrelated_filename,
+	          512,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -713,86 +4657,87 @@ int vmdk_test_handle_open_wide(
 	 "error",
 	 error );
 
-	/* Test error cases
+	/* Create the parent with data in grain 3
 	 */
-	result = libvmdk_handle_open_wide(
-	          NULL,
-	          wide_source,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_initialize(
+	          &parent_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_create_sparse(
+	          parent_handle,
+	          parent_filename,
+	          VMDK_TEST_HANDLE_WRITE_MEDIA_SIZE,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libvmdk_handle_open_wide(
-	          handle,
-	          NULL,
-	          LIBVMDK_OPEN_READ,
+	result = vmdk_test_handle_write_pattern(
+	          parent_handle,
+	          3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          4,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libvmdk_handle_open_wide(
-	          handle,
-	          wide_source,
-	          -1,
+	result = vmdk_test_handle_reopen(
+	          parent_handle,
+	          parent_filename,
+	          NULL,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	/* Test open when already opened
+	/* Create the first child with data in grain 5
 	 */
-	result = libvmdk_handle_open_wide(
-	          handle,
-	          wide_source,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_initialize(
+	          &first_child_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	/* Clean up
-	 */
-	result = libvmdk_handle_free(
-	          &handle,
+	result = libvmdk_handle_create_child(
+	          first_child_handle,
+	          first_child_filename,
+	          parent_handle,
+	          "parent.vmdk",
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -800,49 +4745,15 @@ int vmdk_test_handle_open_wide(
 	 result,
 	 1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
-
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( handle != NULL )
-	{
-		libvmdk_handle_free(
-		 &handle,
-		 NULL );
-	}
-	return( 0 );
-}
-
-#endif /* defined( HAVE_WIDE_CHARACTER_TYPE ) */
-
-/* Tests the libvmdk_handle_open_file_io_handle function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_open_file_io_handle(
-     const system_character_t *source )
-{
-	libbfio_handle_t *file_io_handle = NULL;
-	libcerror_error_t *error         = NULL;
-	libvmdk_handle_t *handle         = NULL;
-	size_t string_length             = 0;
-	int result                       = 0;
-
-	/* Initialize test
-	 */
-	result = libbfio_file_initialize(
-	          &file_io_handle,
+	result = vmdk_test_handle_write_pattern(
+	          first_child_handle,
+	          ( 5 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 100,
+	          1000,
+	          1,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -850,41 +4761,29 @@ int vmdk_test_handle_open_file_io_handle(
 	 result,
 	 1 );
 
-        VMDK_TEST_ASSERT_IS_NOT_NULL(
-         "file_io_handle",
-         file_io_handle );
-
-        VMDK_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
-
-	string_length = system_string_length(
-	                 source );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libbfio_file_set_name_wide(
-	          file_io_handle,
-	          source,
-	          string_length,
-	          &error );
-#else
-	result = libbfio_file_set_name(
-	          file_io_handle,
-	          source,
-	          string_length,
+	result = vmdk_test_handle_reopen(
+	          first_child_handle,
+	          first_child_filename,
+	          parent_handle,
 	          &error );
-#endif
+
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
-        VMDK_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
+	/* Create the second child with the same data in grain 5 and a sector of data in grain 7
+	 */
 	result = libvmdk_handle_initialize(
-	          &handle,
+	          &second_child_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -892,20 +4791,15 @@ int vmdk_test_handle_open_file_io_handle(
 	 result,
 	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
-
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test open
-	 */
-	result = libvmdk_handle_open_file_io_handle(
-	          handle,
-	          file_io_handle,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_create_child(
+	          second_child_handle,
+	          second_child_filename,
+	          parent_handle,
+	          "parent.vmdk",
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -917,86 +4811,72 @@ int vmdk_test_handle_open_file_io_handle(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libvmdk_handle_open_file_io_handle(
-	          NULL,
-	          file_io_handle,
-	          LIBVMDK_OPEN_READ,
+	result = vmdk_test_handle_write_pattern(
+	          second_child_handle,
+	          ( 5 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 100,
+	          1000,
+	          1,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libvmdk_handle_open_file_io_handle(
-	          handle,
-	          NULL,
-	          LIBVMDK_OPEN_READ,
+	result = vmdk_test_handle_write_pattern(
+	          second_child_handle,
+	          ( 7 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 512,
+	          512,
+	          2,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	result = libvmdk_handle_open_file_io_handle(
-	          handle,
-	          file_io_handle,
-	          -1,
+	result = vmdk_test_handle_reopen(
+	          second_child_handle,
+	          second_child_filename,
+	          parent_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	/* Test open when already opened
+	/* Create the unrelated disk with the data of the parent in grain 3 and a sector of data in grain 9
 	 */
-	result = libvmdk_handle_open_file_io_handle(
-	          handle,
-	          file_io_handle,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_initialize(
+	          &unrelated_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	/* Clean up
-	 */
-	result = libvmdk_handle_free(
-	          &handle,
+	result = libvmdk_handle_create_sparse(
+	          unrelated_handle,
+	          unrelated_filename,
+	          VMDK_TEST_HANDLE_WRITE_MEDIA_SIZE,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1004,16 +4884,15 @@ int vmdk_test_handle_open_file_io_handle(
 	 result,
 	 1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
-
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libbfio_handle_free(
-	          &file_io_handle,
+	result = vmdk_test_handle_write_pattern(
+	          unrelated_handle,
+	          3 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          4,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1022,88 +4901,48 @@ int vmdk_test_handle_open_file_io_handle(
 	 1 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
-         "file_io_handle",
-         file_io_handle );
-
-        VMDK_TEST_ASSERT_IS_NULL(
-         "error",
-         error );
-
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( handle != NULL )
-	{
-		libvmdk_handle_free(
-		 &handle,
-		 NULL );
-	}
-	if( file_io_handle != NULL )
-	{
-		libbfio_handle_free(
-		 &file_io_handle,
-		 NULL );
-	}
-	return( 0 );
-}
-
-/* Tests the libvmdk_handle_close function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_close(
-     void )
-{
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	 "error",
+	 error );
 
-	/* Test error cases
-	 */
-	result = libvmdk_handle_close(
-	          NULL,
+	result = vmdk_test_handle_write_pattern(
+	          unrelated_handle,
+	          ( 9 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 1024,
+	          512,
+	          3,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 -1 );
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	result = vmdk_test_handle_reopen(
+	          unrelated_handle,
+	          unrelated_filename,
+	          NULL,
+	          &error );
 
-/* Tests the libvmdk_handle_open and libvmdk_handle_close functions
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_open_close(
-     const system_character_t *source )
-{
-	libcerror_error_t *error = NULL;
-	libvmdk_handle_t *handle = NULL;
-	int result               = 0;
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	/* Initialize test
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test the parent and a child, the changed range is the grain allocated in the child
 	 */
-	result = libvmdk_handle_initialize(
-	          &handle,
+	result = libvmdk_handle_get_next_changed_range(
+	          parent_handle,
+	          first_child_handle,
+	          0,
+	          &range_offset,
+	          &range_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1111,41 +4950,53 @@ int vmdk_test_handle_open_close(
 	 result,
 	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
-	 "handle",
-	 handle );
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) ( 5 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test open and close
-	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libvmdk_handle_open_wide(
-	          handle,
-	          source,
-	          LIBVMDK_OPEN_READ,
-	          &error );
-#else
-	result = libvmdk_handle_open(
-	          handle,
-	          source,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_get_next_changed_range(
+	          first_child_handle,
+	          parent_handle,
+	          0,
+	          &range_offset,
+	          &range_size,
 	          &error );
-#endif
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) ( 5 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE );
+
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libvmdk_handle_close(
-	          handle,
+	result = libvmdk_handle_get_next_changed_range(
+	          parent_handle,
+	          first_child_handle,
+	          6 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE,
+	          &range_offset,
+	          &range_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1157,33 +5008,42 @@ int vmdk_test_handle_open_close(
 	 "error",
 	 error );
 
-	/* Test open and close a second time to validate clean up on close
+	/* Test the children that share the parent, the data in grain 5 is the same
+	 * hence the changed range is the sector in grain 7
 	 */
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libvmdk_handle_open_wide(
-	          handle,
-	          source,
-	          LIBVMDK_OPEN_READ,
-	          &error );
-#else
-	result = libvmdk_handle_open(
-	          handle,
-	          source,
-	          LIBVMDK_OPEN_READ,
+	result = libvmdk_handle_get_next_changed_range(
+	          first_child_handle,
+	          second_child_handle,
+	          0,
+	          &range_offset,
+	          &range_size,
 	          &error );
-#endif
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
 	 1 );
 
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) ( ( 7 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 512 ) );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 512 );
+
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	result = libvmdk_handle_close(
-	          handle,
+	result = libvmdk_handle_get_next_changed_range(
+	          first_child_handle,
+	          second_child_handle,
+	          ( 7 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 1024,
+	          &range_offset,
+	          &range_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1195,10 +5055,15 @@ int vmdk_test_handle_open_close(
 	 "error",
 	 error );
 
-	/* Clean up
+	/* Test the parent and the unrelated disk, the data in grain 3 is the same
+	 * hence the changed range is the sector in grain 9
 	 */
-	result = libvmdk_handle_free(
-	          &handle,
+	result = libvmdk_handle_get_next_changed_range(
+	          parent_handle,
+	          unrelated_handle,
+	          0,
+	          &range_offset,
+	          &range_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1206,44 +5071,41 @@ int vmdk_test_handle_open_close(
 	 result,
 	 1 );
 
-	VMDK_TEST_ASSERT_IS_NULL(
-	 "handle",
-	 handle );
+	VMDK_TEST_ASSERT_EQUAL_INT64(
+	 "range_offset",
+	 (int64_t) range_offset,
+	 (int64_t) ( ( 9 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 1024 ) );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 512 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	return( 1 );
+	result = libvmdk_handle_get_next_changed_range(
+	          parent_handle,
+	          unrelated_handle,
+	          ( 9 * VMDK_TEST_HANDLE_WRITE_GRAIN_SIZE ) + 1536,
+	          &range_offset,
+	          &range_size,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	if( handle != NULL )
-	{
-		libvmdk_handle_free(
-		 &handle,
-		 NULL );
-	}
-	return( 0 );
-}
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-/* Tests the libvmdk_handle_signal_abort function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_signal_abort(
-     libvmdk_handle_t *handle )
-{
-	libcerror_error_t *error = NULL;
-	int result               = 0;
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Test regular cases
+	/* Test with an abort signalled
 	 */
 	result = libvmdk_handle_signal_abort(
-	          handle,
+	          unrelated_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1255,10 +5117,12 @@ int vmdk_test_handle_signal_abort(
 	 "error",
 	 error );
 
-	/* Test error cases
-	 */
-	result = libvmdk_handle_signal_abort(
-	          NULL,
+	result = libvmdk_handle_get_next_changed_range(
+	          unrelated_handle,
+	          parent_handle,
+	          0,
+	          &range_offset,
+	          &range_size,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1273,163 +5137,188 @@ int vmdk_test_handle_signal_abort(
 	libcerror_error_free(
 	 &error );
 
-	return( 1 );
+	/* Clean up
+	 */
+	result = vmdk_test_handle_close_source(
+	          &unrelated_handle,
+	          &error );
 
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
-/* Tests the libvmdk_handle_read_buffer function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_read_buffer(
-     libvmdk_handle_t *handle )
-{
-	uint8_t buffer[ 16 ];
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
-	ssize_t read_count       = 0;
-	off64_t offset           = 0;
-	int result               = 0;
+	result = vmdk_test_handle_close_source(
+	          &second_child_handle,
+	          &error );
 
-	/* Determine size
-	 */
-	result = libvmdk_handle_get_media_size(
-	          handle,
-	          &media_size,
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = vmdk_test_handle_close_source(
+	          &first_child_handle,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
 	 "result",
 	 result,
-	 1 );
+	 0 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Reset offset to 0
-	 */
-	offset = libvmdk_handle_seek_offset(
-	          handle,
-	          0,
-	          SEEK_SET,
+	result = vmdk_test_handle_close_source(
+	          &parent_handle,
 	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_INT64(
-	 "offset",
-	 offset,
-	 (int64_t) 0 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
 
 	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	if( media_size > 16 )
-	{
-		read_count = libvmdk_handle_read_buffer(
-		              handle,
-		              buffer,
-		              16,
-		              &error );
+	result = vmdk_test_remove_temporary_directory(
+	          directory_path,
+	          &error );
 
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 16 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		/* Set offset to media_size - 8
-		 */
-		offset = libvmdk_handle_seek_offset(
-		          handle,
-		          -8,
-		          SEEK_END,
-		          &error );
+	return( 1 );
 
-		VMDK_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 (int64_t) media_size - 8 );
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( unrelated_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &unrelated_handle,
+		 NULL );
+	}
+	if( second_child_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &second_child_handle,
+		 NULL );
+	}
+	if( first_child_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &first_child_handle,
+		 NULL );
+	}
+	if( parent_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &parent_handle,
+		 NULL );
+	}
+	if( directory_created != 0 )
+	{
+		vmdk_test_remove_temporary_directory(
+		 directory_path,
+		 NULL );
+	}
+	return( 0 );
+}
 
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+/* Tests the libvmdk_handle_set_grain_size function with a created sparse disk
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_set_grain_size_write(
+     void )
+{
+	uint8_t file_header_data[ 512 ];
+	char directory_path[ 256 ];
+	char filename[ 512 ];
+
+	libcerror_error_t *error         = NULL;
+	libvmdk_handle_t *handle         = NULL;
+	size64_t range_size              = 0;
+	uint64_t grain_number_of_sectors = 0;
+	uint32_t range_flags             = 0;
+	int directory_created            = 0;
+	int result                       = 0;
+
+	result = vmdk_test_create_temporary_directory(
+	          directory_path,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		/* Read buffer on media_size boundary
-		 */
-		read_count = libvmdk_handle_read_buffer(
-		              handle,
-		              buffer,
-		              16,
-		              &error );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 8 );
+	directory_created = 1;
 
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "sparse.vmdk",
+	          filename,
+	          512,
+	          &error );
 
-		/* Read buffer beyond media_size boundary
-		 */
-		read_count = libvmdk_handle_read_buffer(
-		              handle,
-		              buffer,
-		              16,
-		              &error );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 0 );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
 
-		/* Reset offset to 0
-		 */
-		offset = libvmdk_handle_seek_offset(
-		          handle,
-		          0,
-		          SEEK_SET,
-		          &error );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		VMDK_TEST_ASSERT_EQUAL_INT64(
-		 "offset",
-		 offset,
-		 (int64_t) 0 );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
 	/* Test error cases
 	 */
-	read_count = libvmdk_handle_read_buffer(
-	              NULL,
-	              buffer,
-	              16,
-	              &error );
+	result = libvmdk_handle_set_grain_size(
+	          NULL,
+	          1048576,
+	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1438,16 +5327,15 @@ int vmdk_test_handle_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libvmdk_handle_read_buffer(
-	              handle,
-	              NULL,
-	              16,
-	              &error );
+	result = libvmdk_handle_set_grain_size(
+	          handle,
+	          98304,
+	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1456,16 +5344,48 @@ int vmdk_test_handle_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	read_count = libvmdk_handle_read_buffer(
-	              handle,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              &error );
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_set_grain_size(
+	          handle,
+	          1048576,
+	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_create_sparse(
+	          handle,
+	          filename,
+	          VMDK_TEST_HANDLE_WRITE_MEDIA_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error case where the disk was already created
+	 */
+	result = libvmdk_handle_set_grain_size(
+	          handle,
+	          65536,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
 
 	VMDK_TEST_ASSERT_IS_NOT_NULL(
 	 "error",
@@ -1474,35 +5394,28 @@ int vmdk_test_handle_read_buffer(
 	libcerror_error_free(
 	 &error );
 
-	return( 1 );
-
-on_error:
-	if( error != NULL )
-	{
-		libcerror_error_free(
-		 &error );
-	}
-	return( 0 );
-}
+	/* Write data to the second grain
+	 */
+	result = vmdk_test_handle_write_pattern(
+	          handle,
+	          1048576 + 100,
+	          1000,
+	          1,
+	          &error );
 
-/* Tests the libvmdk_handle_read_buffer_at_offset function
- * Returns 1 if successful or 0 if not
- */
-int vmdk_test_handle_read_buffer_at_offset(
-     libvmdk_handle_t *handle )
-{
-	uint8_t buffer[ 16 ];
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	libcerror_error_t *error = NULL;
-	size64_t media_size      = 0;
-	ssize_t read_count       = 0;
-	int result               = 0;
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-	/* Determine size
-	 */
-	result = libvmdk_handle_get_media_size(
+	result = vmdk_test_handle_reopen(
 	          handle,
-	          &media_size,
+	          filename,
+	          NULL,
 	          &error );
 
 	VMDK_TEST_ASSERT_EQUAL_INT(
@@ -1514,140 +5427,132 @@ int vmdk_test_handle_read_buffer_at_offset(
 	 "error",
 	 error );
 
-	/* Test regular cases
-	 */
-	if( media_size > 16 )
-	{
-		read_count = libvmdk_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              16,
-		              0,
-		              &error );
+	result = vmdk_test_read_file_data(
+	          filename,
+	          0,
+	          file_header_data,
+	          512,
+	          &error );
 
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 16 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		/* Read buffer on media_size boundary
-		 */
-		read_count = libvmdk_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              16,
-		              media_size - 8,
-		              &error );
+	byte_stream_copy_to_uint64_little_endian(
+	 &( file_header_data[ 20 ] ),
+	 grain_number_of_sectors );
 
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 8 );
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "grain_number_of_sectors",
+	 grain_number_of_sectors,
+	 (uint64_t) 2048 );
 
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
+	result = vmdk_test_handle_compare_pattern(
+	          handle,
+	          1048576 + 100,
+	          1000,
+	          1048576 + 100,
+	          1000,
+	          1,
+	          0,
+	          &error );
 
-		/* Read buffer beyond media_size boundary
-		 */
-		read_count = libvmdk_handle_read_buffer_at_offset(
-		              handle,
-		              buffer,
-		              16,
-		              media_size + 8,
-		              &error );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-		VMDK_TEST_ASSERT_EQUAL_SSIZE(
-		 "read_count",
-		 read_count,
-		 (ssize_t) 0 );
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
 
-		VMDK_TEST_ASSERT_IS_NULL(
-		 "error",
-		 error );
-	}
-	/* Test error cases
+	/* The first grain is sparse and the second grain is allocated as a whole
 	 */
-	read_count = libvmdk_handle_read_buffer_at_offset(
-	              NULL,
-	              buffer,
-	              16,
-	              0,
-	              &error );
+	result = libvmdk_handle_get_data_range_at_offset(
+	          handle,
+	          0,
+	          &range_size,
+	          &range_flags,
+	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 1048576 );
 
-	read_count = libvmdk_handle_read_buffer_at_offset(
-	              handle,
-	              NULL,
-	              16,
-	              0,
-	              &error );
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 (uint32_t) LIBVMDK_RANGE_FLAG_IS_SPARSE );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	result = libvmdk_handle_get_data_range_at_offset(
+	          handle,
+	          1048576,
+	          &range_size,
+	          &range_flags,
+	          &error );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "range_size",
+	 (uint64_t) range_size,
+	 (uint64_t) 1048576 );
 
-	read_count = libvmdk_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              (size_t) SSIZE_MAX + 1,
-	              0,
-	              &error );
+	VMDK_TEST_ASSERT_EQUAL_UINT32(
+	 "range_flags",
+	 range_flags,
+	 0 );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	/* Clean up
+	 */
+	result = vmdk_test_handle_close_source(
+	          &handle,
+	          &error );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
-	read_count = libvmdk_handle_read_buffer_at_offset(
-	              handle,
-	              buffer,
-	              16,
-	              -1,
-	              &error );
+	result = vmdk_test_remove_temporary_directory(
+	          directory_path,
+	          &error );
 
-	VMDK_TEST_ASSERT_EQUAL_SSIZE(
-	 "read_count",
-	 read_count,
-	 (ssize_t) -1 );
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
 
-	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	VMDK_TEST_ASSERT_IS_NULL(
 	 "error",
 	 error );
 
-	libcerror_error_free(
-	 &error );
-
 	return( 1 );
 
 on_error:
@@ -1656,9 +5561,23 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( directory_created != 0 )
+	{
+		vmdk_test_remove_temporary_directory(
+		 directory_path,
+		 NULL );
+	}
 	return( 0 );
 }
 
+#endif /* defined( HAVE_MKDTEMP ) */
+
 /* Tests the libvmdk_handle_seek_offset function
  * Returns 1 if successful or 0 if not
  */
@@ -2692,6 +6611,208 @@ on_error:
 	return( 0 );
 }
 
+/* Tests the libvmdk_handle_open_change_tracking_file function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_handle_open_change_tracking_file(
+     libvmdk_handle_t *handle )
+{
+	uint8_t utf8_change_identifier[ 64 ];
+
+	libcerror_error_t *error           = NULL;
+	off64_t offset                     = 0;
+	off64_t range_offset               = 0;
+	size64_t media_size                = 0;
+	size64_t range_size                = 0;
+	size_t utf8_change_identifier_size = 0;
+	int number_of_ranges               = 0;
+	int result                         = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_handle_open_change_tracking_file(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	if( result != 0 )
+	{
+		result = libvmdk_handle_get_media_size(
+		          handle,
+		          &media_size,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = libvmdk_handle_get_utf8_change_identifier_size(
+		          handle,
+		          &utf8_change_identifier_size,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		VMDK_TEST_ASSERT_GREATER_THAN_INT(
+		 "utf8_change_identifier_size",
+		 (int) utf8_change_identifier_size,
+		 1 );
+
+		VMDK_TEST_ASSERT_LESS_THAN_INT(
+		 "utf8_change_identifier_size",
+		 (int) utf8_change_identifier_size,
+		 65 );
+
+		result = libvmdk_handle_get_utf8_change_identifier(
+		          handle,
+		          utf8_change_identifier,
+		          64,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The current change identifier should report no changed ranges,
+		 * unless the change tracking file contains unexpected values
+		 * in which case all blocks are considered changed
+		 */
+		result = libvmdk_handle_get_next_changed_block_range(
+		          handle,
+		          utf8_change_identifier,
+		          utf8_change_identifier_size - 1,
+		          0,
+		          &range_offset,
+		          &range_size,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		/* The ranges changed since change tracking was enabled should be
+		 * ascending and within the media data
+		 */
+		do
+		{
+			result = libvmdk_handle_get_next_changed_block_range(
+			          handle,
+			          (uint8_t *) "*",
+			          1,
+			          offset,
+			          &range_offset,
+			          &range_size,
+			          &error );
+
+			VMDK_TEST_ASSERT_NOT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "error",
+			 error );
+
+			if( result == 0 )
+			{
+				break;
+			}
+			VMDK_TEST_ASSERT_LESS_THAN_UINT64(
+			 "offset",
+			 (uint64_t) offset,
+			 (uint64_t) range_offset + 1 );
+
+			VMDK_TEST_ASSERT_NOT_EQUAL_INT64(
+			 "range_size",
+			 (int64_t) range_size,
+			 (int64_t) 0 );
+
+			VMDK_TEST_ASSERT_LESS_THAN_UINT64(
+			 "range_offset + range_size",
+			 (uint64_t) range_offset + range_size,
+			 (uint64_t) media_size + 1 );
+
+			offset = range_offset + (off64_t) range_size;
+
+			number_of_ranges++;
+		}
+		while( number_of_ranges < 65536 );
+
+		/* Test error cases
+		 */
+		result = libvmdk_handle_open_change_tracking_file(
+		          handle,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 -1 );
+
+		VMDK_TEST_ASSERT_IS_NOT_NULL(
+		 "error",
+		 error );
+
+		libcerror_error_free(
+		 &error );
+	}
+	result = libvmdk_handle_open_change_tracking_file(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
 /* The main program
  */
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
@@ -2749,6 +6870,34 @@ int main(
 	 "libvmdk_handle_free",
 	 vmdk_test_handle_free );
 
+#if defined( HAVE_MKDTEMP )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_handle_write_buffer_at_offset",
+	 vmdk_test_handle_write_buffer_at_offset );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_handle_create_child_write",
+	 vmdk_test_handle_create_child_write );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_handle_discard_write",
+	 vmdk_test_handle_discard_write );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_handle_trace_read",
+	 vmdk_test_handle_trace_read );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_handle_get_next_changed_range_write",
+	 vmdk_test_handle_get_next_changed_range_write );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_handle_set_grain_size_write",
+	 vmdk_test_handle_set_grain_size_write );
+
+#endif /* defined( HAVE_MKDTEMP ) */
+
 #if !defined( __BORLANDC__ ) || ( __BORLANDC__ >= 0x0560 )
 	if( source != NULL )
 	{
@@ -2895,7 +7044,40 @@ int main(
 
 		/* TODO: add tests for libvmdk_handle_write_buffer */
 
-		/* TODO: add tests for libvmdk_handle_write_buffer_at_offset */
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_discard",
+		 vmdk_test_handle_discard,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_flush",
+		 vmdk_test_handle_flush,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_create_child",
+		 vmdk_test_handle_create_child,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_create_sparse",
+		 vmdk_test_handle_create_sparse,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_create_split_sparse",
+		 vmdk_test_handle_create_split_sparse,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_data_range_at_offset",
+		 vmdk_test_handle_get_data_range_at_offset,
+		 handle );
+
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_get_next_changed_range",
+		 vmdk_test_handle_get_next_changed_range,
+		 handle );
 
 		VMDK_TEST_RUN_WITH_ARGS(
 		 "libvmdk_handle_seek_offset",
@@ -2956,6 +7138,11 @@ int main(
 		 vmdk_test_handle_get_number_of_extents,
 		 handle );
 
+		VMDK_TEST_RUN_WITH_ARGS(
+		 "libvmdk_handle_open_change_tracking_file",
+		 vmdk_test_handle_open_change_tracking_file,
+		 handle );
+
 		/* TODO: add tests for libvmdk_handle_get_extent_descriptor */
 
 		/* Clean up
@@ -368,6 +368,152 @@ on_error:
 	return( 0 );
 }
 
+/* The number of times the test trace callback was invoked
+ */
+int vmdk_test_io_handle_number_of_trace_callbacks = 0;
+
+/* Test trace callback
+ */
+void vmdk_test_io_handle_trace_callback(
+      int trace_phase,
+      int trace_event,
+      uint64_t timestamp VMDK_TEST_ATTRIBUTE_UNUSED,
+      uint64_t size,
+      void *callback_data )
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( timestamp )
+
+	if( ( trace_phase == LIBVMDK_TRACE_PHASE_DECOMPRESSION )
+	 && ( trace_event == LIBVMDK_TRACE_EVENT_END )
+	 && ( size == 4096 )
+	 && ( callback_data == (void *) &vmdk_test_io_handle_number_of_trace_callbacks ) )
+	{
+		vmdk_test_io_handle_number_of_trace_callbacks += 1;
+	}
+}
+
+/* Tests the libvmdk_io_handle_trace function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_io_handle_trace(
+     void )
+{
+	libcerror_error_t *error       = NULL;
+	libvmdk_io_handle_t *io_handle = NULL;
+	int result                     = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_io_handle_initialize(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	vmdk_test_io_handle_number_of_trace_callbacks = 0;
+
+	/* Test without a trace callback
+	 */
+	libvmdk_io_handle_trace(
+	 io_handle,
+	 LIBVMDK_TRACE_PHASE_DECOMPRESSION,
+	 LIBVMDK_TRACE_EVENT_END,
+	 4096 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "vmdk_test_io_handle_number_of_trace_callbacks",
+	 vmdk_test_io_handle_number_of_trace_callbacks,
+	 0 );
+
+	/* Test regular cases
+	 */
+	io_handle->trace_callback      = &vmdk_test_io_handle_trace_callback;
+	io_handle->trace_callback_data = (void *) &vmdk_test_io_handle_number_of_trace_callbacks;
+
+	libvmdk_io_handle_trace(
+	 io_handle,
+	 LIBVMDK_TRACE_PHASE_DECOMPRESSION,
+	 LIBVMDK_TRACE_EVENT_END,
+	 4096 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "vmdk_test_io_handle_number_of_trace_callbacks",
+	 vmdk_test_io_handle_number_of_trace_callbacks,
+	 1 );
+
+	/* Test if the trace callback is retained when the IO handle is cleared
+	 */
+	result = libvmdk_io_handle_clear(
+	          io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	libvmdk_io_handle_trace(
+	 io_handle,
+	 LIBVMDK_TRACE_PHASE_DECOMPRESSION,
+	 LIBVMDK_TRACE_EVENT_END,
+	 4096 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "vmdk_test_io_handle_number_of_trace_callbacks",
+	 vmdk_test_io_handle_number_of_trace_callbacks,
+	 2 );
+
+	/* Clean up
+	 */
+	result = libvmdk_io_handle_free(
+	          &io_handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "io_handle",
+	 io_handle );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( io_handle != NULL )
+	{
+		libvmdk_io_handle_free(
+		 &io_handle,
+		 NULL );
+	}
+	return( 0 );
+}
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 /* The main program
@@ -399,6 +545,10 @@ int main(
 	 "libvmdk_io_handle_clear",
 	 vmdk_test_io_handle_clear );
 
+	VMDK_TEST_RUN(
+	 "libvmdk_io_handle_trace",
+	 vmdk_test_io_handle_trace );
+
 #endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
 
 #if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
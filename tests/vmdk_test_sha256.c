@@ -0,0 +1,478 @@
+/*
+ * Library sha256 functions test program
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_sha256.h"
+
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_sha256_calculate_digest function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_sha256_calculate_digest(
+     void )
+{
+	uint8_t expected_digest1[ LIBVMDK_SHA256_DIGEST_SIZE ] = {
+		0xe3, 0xb0, 0xc4, 0x42, 0x98, 0xfc, 0x1c, 0x14, 0x9a, 0xfb, 0xf4, 0xc8, 0x99, 0x6f, 0xb9, 0x24,
+		0x27, 0xae, 0x41, 0xe4, 0x64, 0x9b, 0x93, 0x4c, 0xa4, 0x95, 0x99, 0x1b, 0x78, 0x52, 0xb8, 0x55 };
+
+	uint8_t expected_digest2[ LIBVMDK_SHA256_DIGEST_SIZE ] = {
+		0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+		0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad };
+
+	uint8_t expected_digest3[ LIBVMDK_SHA256_DIGEST_SIZE ] = {
+		0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+		0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1 };
+
+	uint8_t digest[ LIBVMDK_SHA256_DIGEST_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_sha256_calculate_digest(
+	          (uint8_t *) "",
+	          0,
+	          digest,
+	          LIBVMDK_SHA256_DIGEST_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          digest,
+	          expected_digest1,
+	          LIBVMDK_SHA256_DIGEST_SIZE );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvmdk_sha256_calculate_digest(
+	          (uint8_t *) "abc",
+	          3,
+	          digest,
+	          LIBVMDK_SHA256_DIGEST_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          digest,
+	          expected_digest2,
+	          LIBVMDK_SHA256_DIGEST_SIZE );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test data that requires an additional block for the padding
+	 */
+	result = libvmdk_sha256_calculate_digest(
+	          (uint8_t *) "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq",
+	          56,
+	          digest,
+	          LIBVMDK_SHA256_DIGEST_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          digest,
+	          expected_digest3,
+	          LIBVMDK_SHA256_DIGEST_SIZE );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_sha256_calculate_digest(
+	          NULL,
+	          3,
+	          digest,
+	          LIBVMDK_SHA256_DIGEST_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_sha256_calculate_digest(
+	          (uint8_t *) "abc",
+	          3,
+	          NULL,
+	          LIBVMDK_SHA256_DIGEST_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_sha256_calculate_digest(
+	          (uint8_t *) "abc",
+	          3,
+	          digest,
+	          16,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_sha256_context_update function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_sha256_context_update(
+     void )
+{
+	uint8_t expected_digest[ LIBVMDK_SHA256_DIGEST_SIZE ] = {
+		0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+		0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1 };
+
+	uint8_t digest[ LIBVMDK_SHA256_DIGEST_SIZE ];
+
+	libvmdk_sha256_context_t context;
+
+	libcerror_error_t *error = NULL;
+	const uint8_t *data      = (const uint8_t *) "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+	size_t data_offset       = 0;
+	int result               = 0;
+
+	/* Test regular cases
+	 */
+	result = libvmdk_sha256_context_initialize(
+	          &context,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test data that is added in parts of different sizes
+	 */
+	for( data_offset = 0;
+	     data_offset < 56;
+	     data_offset += 7 )
+	{
+		result = libvmdk_sha256_context_update(
+		          &context,
+		          &( data[ data_offset ] ),
+		          7,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+	}
+	result = libvmdk_sha256_context_finalize(
+	          &context,
+	          digest,
+	          LIBVMDK_SHA256_DIGEST_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          digest,
+	          expected_digest,
+	          LIBVMDK_SHA256_DIGEST_SIZE );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_sha256_context_update(
+	          NULL,
+	          data,
+	          7,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_sha256_context_update(
+	          &context,
+	          NULL,
+	          7,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_sha256_calculate_zero_digest function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_sha256_calculate_zero_digest(
+     void )
+{
+	uint8_t data[ 1000 ];
+	uint8_t digest[ LIBVMDK_SHA256_DIGEST_SIZE ];
+	uint8_t expected_digest[ LIBVMDK_SHA256_DIGEST_SIZE ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Initialize test
+	 */
+	memory_set(
+	 data,
+	 0,
+	 1000 );
+
+	result = libvmdk_sha256_calculate_digest(
+	          data,
+	          1000,
+	          expected_digest,
+	          LIBVMDK_SHA256_DIGEST_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_sha256_calculate_zero_digest(
+	          1000,
+	          digest,
+	          LIBVMDK_SHA256_DIGEST_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          digest,
+	          expected_digest,
+	          LIBVMDK_SHA256_DIGEST_SIZE );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test error cases
+	 */
+	result = libvmdk_sha256_calculate_zero_digest(
+	          1000,
+	          NULL,
+	          LIBVMDK_SHA256_DIGEST_SIZE,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_sha256_calculate_digest",
+	 vmdk_test_sha256_calculate_digest );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_sha256_context_update",
+	 vmdk_test_sha256_context_update );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_sha256_calculate_zero_digest",
+	 vmdk_test_sha256_calculate_zero_digest );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
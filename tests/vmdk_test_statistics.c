@@ -0,0 +1,750 @@
+/*
+ * Library statistics functions test program
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_statistics.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_statistics_get_histogram_bucket_index function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_statistics_get_histogram_bucket_index(
+     void )
+{
+	int bucket_index = 0;
+
+	/* Test regular cases
+	 */
+	bucket_index = libvmdk_statistics_get_histogram_bucket_index(
+	                0 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 0 );
+
+	bucket_index = libvmdk_statistics_get_histogram_bucket_index(
+	                1999 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 0 );
+
+	bucket_index = libvmdk_statistics_get_histogram_bucket_index(
+	                2000 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 1 );
+
+	bucket_index = libvmdk_statistics_get_histogram_bucket_index(
+	                1024000 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 10 );
+
+	/* Test durations that exceed the last bucket
+	 */
+	bucket_index = libvmdk_statistics_get_histogram_bucket_index(
+	                (uint64_t) 0xffffffffffffffffULL );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "bucket_index",
+	 bucket_index,
+	 LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS - 1 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libvmdk_statistics_start_timer function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_statistics_start_timer(
+     void )
+{
+	libvmdk_statistics_t statistics;
+	uint64_t timestamp              = 0;
+	int result                      = 0;
+
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvmdk_statistics_t ) ) == NULL )
+	{
+		return( 0 );
+	}
+	/* Test regular cases
+	 */
+	result = libvmdk_statistics_start_timer(
+	          &statistics,
+	          &timestamp );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "timestamp",
+	 timestamp,
+	 (uint64_t) 0 );
+
+	statistics.flags = LIBVMDK_STATISTICS_FLAG_MEASURE_TIME;
+
+	result = libvmdk_statistics_start_timer(
+	          &statistics,
+	          &timestamp );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 libvmdk_statistics_get_timestamp(
+	  &timestamp ) );
+
+	/* Test error cases
+	 */
+	result = libvmdk_statistics_start_timer(
+	          NULL,
+	          &timestamp );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	result = libvmdk_statistics_start_timer(
+	          &statistics,
+	          NULL );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+/* Tests the libvmdk_statistics_get_value function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_statistics_get_value(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvmdk_statistics_t statistics;
+	uint64_t value                  = 0;
+	int result                      = 0;
+
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvmdk_statistics_t ) ) == NULL )
+	{
+		return( 0 );
+	}
+	statistics.grain_groups_cache_lookups = 10;
+	statistics.grain_groups_cache_misses  = 7;
+	statistics.grains_cache_misses        = 1;
+
+	libvmdk_statistics_add_backing_read(
+	 &statistics,
+	 4096 );
+
+	libvmdk_statistics_add_backing_read(
+	 &statistics,
+	 -1 );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_statistics_get_value(
+	          &statistics,
+	          LIBVMDK_STATISTICS_VALUE_GRAIN_GROUPS_CACHE_MISSES,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 7 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_get_value(
+	          &statistics,
+	          LIBVMDK_STATISTICS_VALUE_GRAIN_GROUPS_CACHE_HITS,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 3 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test that the number of hits does not underflow
+	 */
+	result = libvmdk_statistics_get_value(
+	          &statistics,
+	          LIBVMDK_STATISTICS_VALUE_GRAINS_CACHE_HITS,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_get_value(
+	          &statistics,
+	          LIBVMDK_STATISTICS_VALUE_NUMBER_OF_BACKING_READS,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 2 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_get_value(
+	          &statistics,
+	          LIBVMDK_STATISTICS_VALUE_BACKING_READ_SIZE,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 4096 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_get_value(
+	          &statistics,
+	          -1,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_statistics_get_value(
+	          NULL,
+	          LIBVMDK_STATISTICS_VALUE_NUMBER_OF_READS,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_statistics_get_value(
+	          &statistics,
+	          LIBVMDK_STATISTICS_VALUE_NUMBER_OF_READS,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_statistics_get_histogram function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_statistics_get_histogram(
+     void )
+{
+	uint64_t histogram[ LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS ];
+
+	libcerror_error_t *error        = NULL;
+	libvmdk_statistics_t statistics;
+	int result                      = 0;
+
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvmdk_statistics_t ) ) == NULL )
+	{
+		return( 0 );
+	}
+	libvmdk_statistics_add_decompression_time(
+	 &statistics,
+	 1000,
+	 5000 );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_statistics_get_histogram(
+	          &statistics,
+	          LIBVMDK_STATISTICS_HISTOGRAM_DECOMPRESSION_TIME,
+	          histogram,
+	          LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "histogram[ 2 ]",
+	 histogram[ 2 ],
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics.decompression_time",
+	 statistics.decompression_time,
+	 (uint64_t) 4000 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	libvmdk_statistics_add_read_time(
+	 &statistics,
+	 1000,
+	 1001000 );
+
+	result = libvmdk_statistics_get_histogram(
+	          &statistics,
+	          LIBVMDK_STATISTICS_HISTOGRAM_READ_TIME,
+	          histogram,
+	          LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "histogram[ 9 ]",
+	 histogram[ 9 ],
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "statistics.read_time",
+	 statistics.read_time,
+	 (uint64_t) 1000000 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_statistics_get_histogram(
+	          &statistics,
+	          LIBVMDK_STATISTICS_HISTOGRAM_DECOMPRESSION_TIME,
+	          histogram,
+	          1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_statistics_get_open_phase_value function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_statistics_get_open_phase_value(
+     void )
+{
+	libcerror_error_t *error        = NULL;
+	libvmdk_statistics_t statistics;
+	uint64_t value                  = 0;
+	int result                      = 0;
+
+	if( memory_set(
+	     &statistics,
+	     0,
+	     sizeof( libvmdk_statistics_t ) ) == NULL )
+	{
+		return( 0 );
+	}
+	libvmdk_statistics_add_open_phase_seek(
+	 &statistics,
+	 LIBVMDK_OPEN_PHASE_GRAIN_DIRECTORY );
+
+	libvmdk_statistics_add_open_phase_read(
+	 &statistics,
+	 LIBVMDK_OPEN_PHASE_GRAIN_DIRECTORY,
+	 512 );
+
+	libvmdk_statistics_add_open_phase_read(
+	 &statistics,
+	 LIBVMDK_OPEN_PHASE_GRAIN_DIRECTORY,
+	 -1 );
+
+	libvmdk_statistics_add_open_phase_time(
+	 &statistics,
+	 LIBVMDK_OPEN_PHASE_GRAIN_DIRECTORY,
+	 1000,
+	 5000 );
+
+	/* Values of an unsupported open phase are ignored
+	 */
+	libvmdk_statistics_add_open_phase_seek(
+	 &statistics,
+	 0 );
+
+	libvmdk_statistics_add_open_phase_read(
+	 &statistics,
+	 LIBVMDK_STATISTICS_NUMBER_OF_OPEN_PHASES + 1,
+	 512 );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_statistics_get_open_phase_value(
+	          &statistics,
+	          LIBVMDK_OPEN_PHASE_GRAIN_DIRECTORY,
+	          LIBVMDK_OPEN_PHASE_VALUE_DURATION,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 4000 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_get_open_phase_value(
+	          &statistics,
+	          LIBVMDK_OPEN_PHASE_GRAIN_DIRECTORY,
+	          LIBVMDK_OPEN_PHASE_VALUE_NUMBER_OF_READS,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 2 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_get_open_phase_value(
+	          &statistics,
+	          LIBVMDK_OPEN_PHASE_GRAIN_DIRECTORY,
+	          LIBVMDK_OPEN_PHASE_VALUE_READ_SIZE,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 512 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_get_open_phase_value(
+	          &statistics,
+	          LIBVMDK_OPEN_PHASE_GRAIN_DIRECTORY,
+	          LIBVMDK_OPEN_PHASE_VALUE_NUMBER_OF_SEEKS,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_get_open_phase_value(
+	          &statistics,
+	          LIBVMDK_OPEN_PHASE_DESCRIPTOR,
+	          LIBVMDK_OPEN_PHASE_VALUE_NUMBER_OF_READS,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT64(
+	 "value",
+	 value,
+	 (uint64_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test unsupported open phase and value type
+	 */
+	result = libvmdk_statistics_get_open_phase_value(
+	          &statistics,
+	          0,
+	          LIBVMDK_OPEN_PHASE_VALUE_DURATION,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_statistics_get_open_phase_value(
+	          &statistics,
+	          LIBVMDK_OPEN_PHASE_GRAIN_DIRECTORY,
+	          -1,
+	          &value,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_statistics_get_open_phase_value(
+	          &statistics,
+	          LIBVMDK_OPEN_PHASE_GRAIN_DIRECTORY,
+	          LIBVMDK_OPEN_PHASE_VALUE_DURATION,
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_statistics_get_histogram_bucket_index",
+	 vmdk_test_statistics_get_histogram_bucket_index );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_statistics_start_timer",
+	 vmdk_test_statistics_start_timer );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_statistics_get_value",
+	 vmdk_test_statistics_get_value );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_statistics_get_histogram",
+	 vmdk_test_statistics_get_histogram );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_statistics_get_open_phase_value",
+	 vmdk_test_statistics_get_open_phase_value );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,695 @@
+/*
+ * Library stream_grain type test program
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <byte_stream.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_stream_grain.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_stream_grain_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_grain_initialize(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libvmdk_stream_grain_t *stream_grain = NULL;
+	int result                           = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests      = 3;
+	int number_of_memset_fail_tests      = 1;
+	int test_number                      = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_stream_grain_initialize(
+	          &stream_grain,
+	          65536,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "stream_grain",
+	 stream_grain );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_grain_free(
+	          &stream_grain,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "stream_grain",
+	 stream_grain );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_grain_initialize(
+	          NULL,
+	          65536,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	stream_grain = (libvmdk_stream_grain_t *) 0x12345678UL;
+
+	result = libvmdk_stream_grain_initialize(
+	          &stream_grain,
+	          65536,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	stream_grain = NULL;
+
+	result = libvmdk_stream_grain_initialize(
+	          &stream_grain,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_stream_grain_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_stream_grain_initialize(
+		          &stream_grain,
+		          65536,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( stream_grain != NULL )
+			{
+				libvmdk_stream_grain_free(
+				 &stream_grain,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "stream_grain",
+			 stream_grain );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_stream_grain_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_stream_grain_initialize(
+		          &stream_grain,
+		          65536,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( stream_grain != NULL )
+			{
+				libvmdk_stream_grain_free(
+				 &stream_grain,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "stream_grain",
+			 stream_grain );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream_grain != NULL )
+	{
+		libvmdk_stream_grain_free(
+		 &stream_grain,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_stream_grain_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_grain_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_grain_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_stream_grain_compress function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_grain_compress(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libvmdk_stream_grain_t *stream_grain = NULL;
+	int result                           = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_stream_grain_initialize(
+	          &stream_grain,
+	          65536,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "stream_grain",
+	 stream_grain );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	memory_set(
+	 stream_grain->data,
+	 0,
+	 stream_grain->data_size );
+
+	result = libvmdk_stream_grain_compress(
+	          stream_grain,
+	          6,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "stream_grain->is_sparse",
+	 stream_grain->is_sparse,
+	 1 );
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	memory_set(
+	 stream_grain->data,
+	 'A',
+	 stream_grain->data_size );
+
+	stream_grain->grain_index = 2;
+
+	result = libvmdk_stream_grain_compress(
+	          stream_grain,
+	          6,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "stream_grain->is_sparse",
+	 stream_grain->is_sparse,
+	 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_SIZE(
+	 "stream_grain->block_data_size",
+	 stream_grain->block_data_size,
+	 (size_t) 512 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "stream_grain->block_data[ 0 ]",
+	 stream_grain->block_data[ 0 ],
+	 0 );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "stream_grain->block_data[ 1 ]",
+	 stream_grain->block_data[ 1 ],
+	 1 );
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_grain_compress(
+	          NULL,
+	          6,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_stream_grain_free(
+	          &stream_grain,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "stream_grain",
+	 stream_grain );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream_grain != NULL )
+	{
+		libvmdk_stream_grain_free(
+		 &stream_grain,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_stream_grain_decompress function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_grain_decompress(
+     void )
+{
+	libcerror_error_t *error             = NULL;
+	libvmdk_stream_grain_t *stream_grain = NULL;
+	int result                           = 0;
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	uint32_t compressed_data_size        = 0;
+#endif
+
+	/* Initialize test
+	 */
+	result = libvmdk_stream_grain_initialize(
+	          &stream_grain,
+	          65536,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "stream_grain",
+	 stream_grain );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+#if ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL )
+	memory_set(
+	 stream_grain->data,
+	 'A',
+	 stream_grain->data_size );
+
+	stream_grain->grain_index = 2;
+
+	result = libvmdk_stream_grain_compress(
+	          stream_grain,
+	          6,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	memory_set(
+	 stream_grain->data,
+	 0,
+	 stream_grain->data_size );
+
+	result = libvmdk_stream_grain_decompress(
+	          stream_grain,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	VMDK_TEST_ASSERT_EQUAL_UINT8(
+	 "stream_grain->data[ 65535 ]",
+	 stream_grain->data[ 65535 ],
+	 'A' );
+
+	/* Test a grain marker of another grain
+	 */
+	stream_grain->grain_index = 3;
+
+	result = libvmdk_stream_grain_decompress(
+	          stream_grain,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	stream_grain->grain_index = 2;
+
+	/* Test a corrupted Adler-32 checksum
+	 */
+	byte_stream_copy_to_uint32_little_endian(
+	 &( stream_grain->block_data[ 8 ] ),
+	 compressed_data_size );
+
+	stream_grain->block_data[ 12 + compressed_data_size - 1 ] ^= 0xff;
+
+	result = libvmdk_stream_grain_decompress(
+	          stream_grain,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+#endif /* ( defined( HAVE_ZLIB ) && defined( HAVE_ZLIB_COMPRESS2 ) ) || defined( ZLIB_DLL ) */
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_grain_decompress(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	stream_grain->block_data_size = 8;
+
+	result = libvmdk_stream_grain_decompress(
+	          stream_grain,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_stream_grain_free(
+	          &stream_grain,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "stream_grain",
+	 stream_grain );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream_grain != NULL )
+	{
+		libvmdk_stream_grain_free(
+		 &stream_grain,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_grain_initialize",
+	 vmdk_test_stream_grain_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_grain_free",
+	 vmdk_test_stream_grain_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_grain_compress",
+	 vmdk_test_stream_grain_compress );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_grain_decompress",
+	 vmdk_test_stream_grain_decompress );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
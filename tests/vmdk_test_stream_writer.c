@@ -0,0 +1,1145 @@
+/*
+ * Library stream_writer type test program
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_functions.h"
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_memory.h"
+#include "vmdk_test_unused.h"
+
+/* Tests the libvmdk_stream_writer_initialize function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_writer_initialize(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libvmdk_stream_writer_t *stream_writer = NULL;
+	int result                             = 0;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+	int number_of_malloc_fail_tests        = 1;
+	int number_of_memset_fail_tests        = 1;
+	int test_number                        = 0;
+#endif
+
+	/* Test regular cases
+	 */
+	result = libvmdk_stream_writer_initialize(
+	          &stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "stream_writer",
+	 stream_writer );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_writer_free(
+	          &stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "stream_writer",
+	 stream_writer );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_writer_initialize(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	stream_writer = (libvmdk_stream_writer_t *) 0x12345678UL;
+
+	result = libvmdk_stream_writer_initialize(
+	          &stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	stream_writer = NULL;
+
+#if defined( HAVE_VMDK_TEST_MEMORY )
+
+	for( test_number = 0;
+	     test_number < number_of_malloc_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_stream_writer_initialize with malloc failing
+		 */
+		vmdk_test_malloc_attempts_before_fail = test_number;
+
+		result = libvmdk_stream_writer_initialize(
+		          &stream_writer,
+		          &error );
+
+		if( vmdk_test_malloc_attempts_before_fail != -1 )
+		{
+			vmdk_test_malloc_attempts_before_fail = -1;
+
+			if( stream_writer != NULL )
+			{
+				libvmdk_stream_writer_free(
+				 &stream_writer,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "stream_writer",
+			 stream_writer );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	for( test_number = 0;
+	     test_number < number_of_memset_fail_tests;
+	     test_number++ )
+	{
+		/* Test libvmdk_stream_writer_initialize with memset failing
+		 */
+		vmdk_test_memset_attempts_before_fail = test_number;
+
+		result = libvmdk_stream_writer_initialize(
+		          &stream_writer,
+		          &error );
+
+		if( vmdk_test_memset_attempts_before_fail != -1 )
+		{
+			vmdk_test_memset_attempts_before_fail = -1;
+
+			if( stream_writer != NULL )
+			{
+				libvmdk_stream_writer_free(
+				 &stream_writer,
+				 NULL );
+			}
+		}
+		else
+		{
+			VMDK_TEST_ASSERT_EQUAL_INT(
+			 "result",
+			 result,
+			 -1 );
+
+			VMDK_TEST_ASSERT_IS_NULL(
+			 "stream_writer",
+			 stream_writer );
+
+			VMDK_TEST_ASSERT_IS_NOT_NULL(
+			 "error",
+			 error );
+
+			libcerror_error_free(
+			 &error );
+		}
+	}
+#endif /* defined( HAVE_VMDK_TEST_MEMORY ) */
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream_writer != NULL )
+	{
+		libvmdk_stream_writer_free(
+		 &stream_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_stream_writer_free function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_writer_free(
+     void )
+{
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_writer_free(
+	          NULL,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_stream_writer_set_media_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_writer_set_media_size(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libvmdk_stream_writer_t *stream_writer = NULL;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_stream_writer_initialize(
+	          &stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "stream_writer",
+	 stream_writer );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_stream_writer_set_media_size(
+	          stream_writer,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_writer_set_media_size(
+	          NULL,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_stream_writer_set_media_size(
+	          stream_writer,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_stream_writer_set_media_size(
+	          stream_writer,
+	          (size64_t) 1000,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_stream_writer_free(
+	          &stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "stream_writer",
+	 stream_writer );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream_writer != NULL )
+	{
+		libvmdk_stream_writer_free(
+		 &stream_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_stream_writer_set_grain_size function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_writer_set_grain_size(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libvmdk_stream_writer_t *stream_writer = NULL;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_stream_writer_initialize(
+	          &stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "stream_writer",
+	 stream_writer );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_stream_writer_set_grain_size(
+	          stream_writer,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_writer_set_grain_size(
+	          NULL,
+	          (size64_t) 1048576,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_stream_writer_set_grain_size(
+	          stream_writer,
+	          (size64_t) 4096,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_stream_writer_set_grain_size(
+	          stream_writer,
+	          (size64_t) 98304,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_stream_writer_free(
+	          &stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "stream_writer",
+	 stream_writer );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream_writer != NULL )
+	{
+		libvmdk_stream_writer_free(
+		 &stream_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+/* Tests the libvmdk_stream_writer_set_number_of_threads function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_writer_set_number_of_threads(
+     void )
+{
+	libcerror_error_t *error               = NULL;
+	libvmdk_stream_writer_t *stream_writer = NULL;
+	int result                             = 0;
+
+	/* Initialize test
+	 */
+	result = libvmdk_stream_writer_initialize(
+	          &stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "stream_writer",
+	 stream_writer );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_stream_writer_set_number_of_threads(
+	          stream_writer,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_stream_writer_set_number_of_threads(
+	          NULL,
+	          0,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_stream_writer_set_number_of_threads(
+	          stream_writer,
+	          -1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	/* Clean up
+	 */
+	result = libvmdk_stream_writer_free(
+	          &stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "stream_writer",
+	 stream_writer );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( stream_writer != NULL )
+	{
+		libvmdk_stream_writer_free(
+		 &stream_writer,
+		 NULL );
+	}
+	return( 0 );
+}
+
+#if defined( HAVE_MKDTEMP )
+
+/* The number of grains of the media written by the stream writer tests
+ */
+#define VMDK_TEST_STREAM_WRITER_NUMBER_OF_GRAINS	16
+
+/* The grain size used by the stream writer
+ */
+#define VMDK_TEST_STREAM_WRITER_GRAIN_SIZE		65536
+
+/* Determines if a grain of the test media only contains 0-byte values
+ * Returns 1 if the grain only contains 0-byte values or 0 if not
+ */
+int vmdk_test_stream_writer_is_zero_grain(
+     int grain_index )
+{
+	if( ( grain_index == 0 )
+	 || ( grain_index == 2 )
+	 || ( grain_index == 5 )
+	 || ( grain_index == ( VMDK_TEST_STREAM_WRITER_NUMBER_OF_GRAINS - 1 ) ) )
+	{
+		return( 0 );
+	}
+	return( 1 );
+}
+
+/* Tests the libvmdk_stream_writer_open, libvmdk_stream_writer_write_buffer
+ * and libvmdk_stream_writer_close functions
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_stream_writer_open_write_close(
+     void )
+{
+	char directory_path[ 256 ];
+	char filename[ 512 ];
+
+	libcerror_error_t *error               = NULL;
+	libvmdk_handle_t *handle               = NULL;
+	libvmdk_stream_writer_t *stream_writer = NULL;
+	uint8_t *media_data                    = NULL;
+	uint8_t *read_data                     = NULL;
+	size64_t range_size                    = 0;
+	size_t media_data_offset               = 0;
+	size_t media_size                      = 0;
+	size_t write_size                      = 0;
+	ssize_t read_count                     = 0;
+	ssize_t write_count                    = 0;
+	uint32_t range_flags                   = 0;
+	int directory_created                  = 0;
+	int grain_index                        = 0;
+	int number_of_threads                  = 0;
+	int result                             = 0;
+
+#if defined( HAVE_MULTI_THREAD_SUPPORT )
+	number_of_threads = 4;
+#endif
+	/* Initialize test
+	 */
+	media_size = VMDK_TEST_STREAM_WRITER_NUMBER_OF_GRAINS * VMDK_TEST_STREAM_WRITER_GRAIN_SIZE;
+
+	media_data = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * media_size );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "media_data",
+	 media_data );
+
+	read_data = (uint8_t *) memory_allocate(
+	                         sizeof( uint8_t ) * media_size );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "read_data",
+	 read_data );
+
+	for( media_data_offset = 0;
+	     media_data_offset < media_size;
+	     media_data_offset++ )
+	{
+		grain_index = (int) ( media_data_offset / VMDK_TEST_STREAM_WRITER_GRAIN_SIZE );
+
+		if( vmdk_test_stream_writer_is_zero_grain(
+		     grain_index ) != 0 )
+		{
+			media_data[ media_data_offset ] = 0;
+		}
+		else
+		{
+			media_data[ media_data_offset ] = (uint8_t) ( ( media_data_offset % 251 ) + 1 );
+		}
+	}
+	result = vmdk_test_create_temporary_directory(
+	          directory_path,
+	          256,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	directory_created = 1;
+
+	result = vmdk_test_get_temporary_filename(
+	          directory_path,
+	          "stream.vmdk",
+	          filename,
+	          512,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_writer_initialize(
+	          &stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "stream_writer",
+	 stream_writer );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_writer_set_media_size(
+	          stream_writer,
+	          (size64_t) media_size,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_writer_set_number_of_threads(
+	          stream_writer,
+	          number_of_threads,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test regular cases
+	 */
+	result = libvmdk_stream_writer_open(
+	          stream_writer,
+	          filename,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Write the data in parts that are not aligned with the grains
+	 */
+	media_data_offset = 0;
+
+	while( media_data_offset < media_size )
+	{
+		write_size = media_size - media_data_offset;
+
+		if( write_size > 100000 )
+		{
+			write_size = 100000;
+		}
+		write_count = libvmdk_stream_writer_write_buffer(
+		               stream_writer,
+		               &( media_data[ media_data_offset ] ),
+		               write_size,
+		               &error );
+
+		VMDK_TEST_ASSERT_EQUAL_SSIZE(
+		 "write_count",
+		 write_count,
+		 (ssize_t) write_size );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		media_data_offset += write_size;
+	}
+	/* Test writing beyond the media size
+	 */
+	write_count = libvmdk_stream_writer_write_buffer(
+	               stream_writer,
+	               media_data,
+	               512,
+	               &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "write_count",
+	 write_count,
+	 (ssize_t) 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_writer_close(
+	          stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_stream_writer_free(
+	          &stream_writer,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test reading back the data
+	 */
+	result = libvmdk_handle_initialize(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_open(
+	          handle,
+	          filename,
+	          LIBVMDK_OPEN_READ,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_open_extent_data_files(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              handle,
+	              read_data,
+	              media_size,
+	              0,
+	              &error );
+
+	VMDK_TEST_ASSERT_EQUAL_SSIZE(
+	 "read_count",
+	 read_count,
+	 (ssize_t) media_size );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = memory_compare(
+	          read_data,
+	          media_data,
+	          media_size );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	/* Test that the grains that only contain 0-byte values were not stored
+	 */
+	for( grain_index = 0;
+	     grain_index < VMDK_TEST_STREAM_WRITER_NUMBER_OF_GRAINS;
+	     grain_index++ )
+	{
+		result = libvmdk_handle_get_data_range_at_offset(
+		          handle,
+		          (off64_t) grain_index * VMDK_TEST_STREAM_WRITER_GRAIN_SIZE,
+		          &range_size,
+		          &range_flags,
+		          &error );
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 1 );
+
+		VMDK_TEST_ASSERT_IS_NULL(
+		 "error",
+		 error );
+
+		result = ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0;
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 vmdk_test_stream_writer_is_zero_grain(
+		  grain_index ) );
+	}
+	result = libvmdk_handle_close(
+	          handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	result = libvmdk_handle_free(
+	          &handle,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Clean up
+	 */
+	result = vmdk_test_remove_temporary_directory(
+	          directory_path,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	memory_free(
+	 read_data );
+
+	memory_free(
+	 media_data );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	if( handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &handle,
+		 NULL );
+	}
+	if( stream_writer != NULL )
+	{
+		libvmdk_stream_writer_free(
+		 &stream_writer,
+		 NULL );
+	}
+	if( directory_created != 0 )
+	{
+		vmdk_test_remove_temporary_directory(
+		 directory_path,
+		 NULL );
+	}
+	if( read_data != NULL )
+	{
+		memory_free(
+		 read_data );
+	}
+	if( media_data != NULL )
+	{
+		memory_free(
+		 media_data );
+	}
+	return( 0 );
+}
+
+#endif /* defined( HAVE_MKDTEMP ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_writer_initialize",
+	 vmdk_test_stream_writer_initialize );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_writer_free",
+	 vmdk_test_stream_writer_free );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_writer_set_media_size",
+	 vmdk_test_stream_writer_set_media_size );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_writer_set_grain_size",
+	 vmdk_test_stream_writer_set_grain_size );
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_writer_set_number_of_threads",
+	 vmdk_test_stream_writer_set_number_of_threads );
+
+#if defined( HAVE_MKDTEMP )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_stream_writer_open_write_close",
+	 vmdk_test_stream_writer_open_write_close );
+
+#endif /* defined( HAVE_MKDTEMP ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
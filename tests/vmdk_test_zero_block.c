@@ -0,0 +1,513 @@
+/*
+ * Library zero_block functions test program
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "vmdk_test_libcerror.h"
+#include "vmdk_test_libvmdk.h"
+#include "vmdk_test_macros.h"
+#include "vmdk_test_unused.h"
+
+#include "../libvmdk/libvmdk_zero_block.h"
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+/* Tests the libvmdk_zero_block_check_scalar function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_zero_block_check_scalar(
+     void )
+{
+	uint8_t data[ 1024 ];
+
+	size_t data_offset = 0;
+	size_t data_size   = 0;
+	int result         = 0;
+
+	if( memory_set(
+	     data,
+	     0,
+	     1024 ) == NULL )
+	{
+		return( 0 );
+	}
+	/* Test regular cases
+	 */
+	result = libvmdk_zero_block_check_scalar(
+	          data,
+	          1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test unaligned buffers of sizes that are not a multiple of the vector size
+	 */
+	result = libvmdk_zero_block_check_scalar(
+	          &( data[ 3 ] ),
+	          1013 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvmdk_zero_block_check_scalar(
+	          data,
+	          0 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test a non 0-byte value at every position
+	 */
+	for( data_offset = 0;
+	     data_offset < 1024;
+	     data_offset++ )
+	{
+		data[ data_offset ] = 0x01;
+
+		result = libvmdk_zero_block_check_scalar(
+		          data,
+		          1024 );
+
+		data[ data_offset ] = 0;
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test a non 0-byte value in the trailing bytes of an unaligned buffer
+	 */
+	for( data_size = 1;
+	     data_size < 200;
+	     data_size++ )
+	{
+		data[ data_size ] = 0x80;
+
+		result = libvmdk_zero_block_check_scalar(
+		          &( data[ 1 ] ),
+		          data_size );
+
+		data[ data_size ] = 0;
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libvmdk_zero_block_check_scalar(
+	          NULL,
+	          1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_SSE2 )
+
+/* Tests the libvmdk_zero_block_check_sse2 function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_zero_block_check_sse2(
+     void )
+{
+	uint8_t data[ 1024 ];
+
+	size_t data_offset = 0;
+	size_t data_size   = 0;
+	int result         = 0;
+
+	if( memory_set(
+	     data,
+	     0,
+	     1024 ) == NULL )
+	{
+		return( 0 );
+	}
+	/* Test regular cases
+	 */
+	result = libvmdk_zero_block_check_sse2(
+	          data,
+	          1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test unaligned buffers of sizes that are not a multiple of the vector size
+	 */
+	result = libvmdk_zero_block_check_sse2(
+	          &( data[ 3 ] ),
+	          1013 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvmdk_zero_block_check_sse2(
+	          data,
+	          0 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test a non 0-byte value at every position
+	 */
+	for( data_offset = 0;
+	     data_offset < 1024;
+	     data_offset++ )
+	{
+		data[ data_offset ] = 0x01;
+
+		result = libvmdk_zero_block_check_sse2(
+		          data,
+		          1024 );
+
+		data[ data_offset ] = 0;
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test a non 0-byte value in the trailing bytes of an unaligned buffer
+	 */
+	for( data_size = 1;
+	     data_size < 200;
+	     data_size++ )
+	{
+		data[ data_size ] = 0x80;
+
+		result = libvmdk_zero_block_check_sse2(
+		          &( data[ 1 ] ),
+		          data_size );
+
+		data[ data_size ] = 0;
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libvmdk_zero_block_check_sse2(
+	          NULL,
+	          1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* defined( LIBVMDK_ZERO_BLOCK_HAVE_SSE2 ) */
+
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2 )
+
+/* Tests the libvmdk_zero_block_check_avx2 function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_zero_block_check_avx2(
+     void )
+{
+	uint8_t data[ 1024 ];
+
+	size_t data_offset = 0;
+	size_t data_size   = 0;
+	int result         = 0;
+
+	if( memory_set(
+	     data,
+	     0,
+	     1024 ) == NULL )
+	{
+		return( 0 );
+	}
+	/* Test regular cases
+	 */
+	result = libvmdk_zero_block_check_avx2(
+	          data,
+	          1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test unaligned buffers of sizes that are not a multiple of the vector size
+	 */
+	result = libvmdk_zero_block_check_avx2(
+	          &( data[ 3 ] ),
+	          1013 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	result = libvmdk_zero_block_check_avx2(
+	          data,
+	          0 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	/* Test a non 0-byte value at every position
+	 */
+	for( data_offset = 0;
+	     data_offset < 1024;
+	     data_offset++ )
+	{
+		data[ data_offset ] = 0x01;
+
+		result = libvmdk_zero_block_check_avx2(
+		          data,
+		          1024 );
+
+		data[ data_offset ] = 0;
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test a non 0-byte value in the trailing bytes of an unaligned buffer
+	 */
+	for( data_size = 1;
+	     data_size < 200;
+	     data_size++ )
+	{
+		data[ data_size ] = 0x80;
+
+		result = libvmdk_zero_block_check_avx2(
+		          &( data[ 1 ] ),
+		          data_size );
+
+		data[ data_size ] = 0;
+
+		VMDK_TEST_ASSERT_EQUAL_INT(
+		 "result",
+		 result,
+		 0 );
+	}
+	/* Test error cases
+	 */
+	result = libvmdk_zero_block_check_avx2(
+	          NULL,
+	          1024 );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	return( 1 );
+
+on_error:
+	return( 0 );
+}
+
+#endif /* defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2 ) */
+
+/* Tests the libvmdk_zero_block_check function
+ * Returns 1 if successful or 0 if not
+ */
+int vmdk_test_zero_block_check(
+     void )
+{
+	uint8_t data[ 65536 ];
+
+	libcerror_error_t *error = NULL;
+	int result               = 0;
+
+	if( memory_set(
+	     data,
+	     0,
+	     65536 ) == NULL )
+	{
+		return( 0 );
+	}
+	/* Test regular cases
+	 */
+	result = libvmdk_zero_block_check(
+	          data,
+	          65536,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 1 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	data[ 65535 ] = 0xff;
+
+	result = libvmdk_zero_block_check(
+	          data,
+	          65536,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 0 );
+
+	VMDK_TEST_ASSERT_IS_NULL(
+	 "error",
+	 error );
+
+	/* Test error cases
+	 */
+	result = libvmdk_zero_block_check(
+	          NULL,
+	          65536,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	result = libvmdk_zero_block_check(
+	          data,
+	          (size_t) SSIZE_MAX + 1,
+	          &error );
+
+	VMDK_TEST_ASSERT_EQUAL_INT(
+	 "result",
+	 result,
+	 -1 );
+
+	VMDK_TEST_ASSERT_IS_NOT_NULL(
+	 "error",
+	 error );
+
+	libcerror_error_free(
+	 &error );
+
+	return( 1 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcerror_error_free(
+		 &error );
+	}
+	return( 0 );
+}
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     wchar_t * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#else
+int main(
+     int argc VMDK_TEST_ATTRIBUTE_UNUSED,
+     char * const argv[] VMDK_TEST_ATTRIBUTE_UNUSED )
+#endif
+{
+	VMDK_TEST_UNREFERENCED_PARAMETER( argc )
+	VMDK_TEST_UNREFERENCED_PARAMETER( argv )
+
+#if defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_zero_block_check_scalar",
+	 vmdk_test_zero_block_check_scalar );
+
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_SSE2 )
+
+	VMDK_TEST_RUN(
+	 "libvmdk_zero_block_check_sse2",
+	 vmdk_test_zero_block_check_sse2 );
+
+#endif /* defined( LIBVMDK_ZERO_BLOCK_HAVE_SSE2 ) */
+
+#if defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2 )
+
+	if( libvmdk_zero_block_cpu_supports_avx2() != 0 )
+	{
+		VMDK_TEST_RUN(
+		 "libvmdk_zero_block_check_avx2",
+		 vmdk_test_zero_block_check_avx2 );
+	}
+
+#endif /* defined( LIBVMDK_ZERO_BLOCK_HAVE_AVX2 ) */
+
+	VMDK_TEST_RUN(
+	 "libvmdk_zero_block_check",
+	 vmdk_test_zero_block_check );
+
+#endif /* defined( __GNUC__ ) && !defined( LIBVMDK_DLL_IMPORT ) */
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	return( EXIT_FAILURE );
+}
+
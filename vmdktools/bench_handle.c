@@ -0,0 +1,2977 @@
+/*
+ * Bench handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "bench_handle.h"
+#include "byte_size_string.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libcpath.h"
+#include "vmdktools_libcthreads.h"
+#include "vmdktools_libfvalue.h"
+#include "vmdktools_libvmdk.h"
+
+#define BENCH_HANDLE_NOTIFY_STREAM		stdout
+
+/* The statistics values reported per pass
+ */
+static int bench_handle_statistics_value_types[ BENCH_HANDLE_NUMBER_OF_STATISTICS_VALUES ] = {
+	LIBVMDK_STATISTICS_VALUE_NUMBER_OF_SPARSE_GRAINS,
+	LIBVMDK_STATISTICS_VALUE_NUMBER_OF_ALLOCATED_GRAINS,
+	LIBVMDK_STATISTICS_VALUE_NUMBER_OF_COMPRESSED_GRAINS,
+	LIBVMDK_STATISTICS_VALUE_NUMBER_OF_DECOMPRESSIONS,
+	LIBVMDK_STATISTICS_VALUE_NUMBER_OF_PARENT_READS,
+	LIBVMDK_STATISTICS_VALUE_GRAINS_CACHE_HITS,
+	LIBVMDK_STATISTICS_VALUE_GRAINS_CACHE_MISSES,
+	LIBVMDK_STATISTICS_VALUE_GRAIN_GROUPS_CACHE_HITS,
+	LIBVMDK_STATISTICS_VALUE_GRAIN_GROUPS_CACHE_MISSES };
+
+static const char *bench_handle_statistics_value_descriptions[ BENCH_HANDLE_NUMBER_OF_STATISTICS_VALUES ] = {
+	"Sparse grain reads\t\t",
+	"Allocated grain reads\t\t",
+	"Compressed grain reads\t\t",
+	"Decompressions\t\t\t",
+	"Parent reads\t\t\t",
+	"Grains cache hits\t\t",
+	"Grains cache misses\t\t",
+	"Grain groups cache hits\t\t",
+	"Grain groups cache misses\t" };
+
+/* Creates a bench handle
+ * Make sure the value bench_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_initialize";
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid bench handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*bench_handle = memory_allocate_structure(
+	                bench_handle_t );
+
+	if( *bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create bench handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *bench_handle,
+	     0,
+	     sizeof( bench_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear bench handle.",
+		 function );
+
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *bench_handle )->input_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handles array.",
+		 function );
+
+		goto on_error;
+	}
+	( *bench_handle )->access_patterns   = BENCH_HANDLE_ACCESS_PATTERN_ALL;
+	( *bench_handle )->block_size        = BENCH_HANDLE_DEFAULT_BLOCK_SIZE;
+	( *bench_handle )->number_of_reads   = BENCH_HANDLE_DEFAULT_NUMBER_OF_READS;
+	( *bench_handle )->number_of_threads = BENCH_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+	( *bench_handle )->seed              = BENCH_HANDLE_DEFAULT_SEED;
+	( *bench_handle )->notify_stream     = BENCH_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *bench_handle != NULL )
+	{
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a bench handle
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_free";
+	int result            = 1;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *bench_handle != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *bench_handle )->input_handles_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handles array.",
+			 function );
+
+			result = -1;
+		}
+		/* The cache pool must outlive the input handles
+		 */
+		if( ( *bench_handle )->cache_pool != NULL )
+		{
+			if( libvmdk_cache_pool_free(
+			     &( ( *bench_handle )->cache_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free cache pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *bench_handle )->read_latencies != NULL )
+		{
+			memory_free(
+			 ( *bench_handle )->read_latencies );
+		}
+		if( ( *bench_handle )->read_offsets != NULL )
+		{
+			memory_free(
+			 ( *bench_handle )->read_offsets );
+		}
+		if( ( *bench_handle )->basename != NULL )
+		{
+			memory_free(
+			 ( *bench_handle )->basename );
+		}
+		if( ( *bench_handle )->filename != NULL )
+		{
+			memory_free(
+			 ( *bench_handle )->filename );
+		}
+		memory_free(
+		 *bench_handle );
+
+		*bench_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the bench handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "bench_handle_signal_abort";
+	int input_handle_index         = 0;
+	int number_of_input_handles    = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->abort = 1;
+
+	if( libcdata_array_get_number_of_entries(
+	     bench_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( input_handle_index = 0;
+	     input_handle_index < number_of_input_handles;
+	     input_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     bench_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		if( libvmdk_handle_signal_abort(
+		     input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle: %d to abort.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the access patterns
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_access_patterns(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_access_patterns";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 3 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "all" ),
+		     3 ) == 0 )
+		{
+			bench_handle->access_patterns = BENCH_HANDLE_ACCESS_PATTERN_ALL;
+
+			result = 1;
+		}
+	}
+	else if( string_length == 6 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "random" ),
+		     6 ) == 0 )
+		{
+			bench_handle->access_patterns = BENCH_HANDLE_ACCESS_PATTERN_RANDOM;
+
+			result = 1;
+		}
+	}
+	else if( string_length == 10 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "sequential" ),
+		     10 ) == 0 )
+		{
+			bench_handle->access_patterns = BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL;
+
+			result = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the block size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_block_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_block_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine block size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The block size must be a multiple of the sector size
+	 */
+	if( ( size_value == 0 )
+	 || ( size_value > (uint64_t) BENCH_HANDLE_MAXIMUM_BLOCK_SIZE )
+	 || ( ( size_value % 512 ) != 0 ) )
+	{
+		return( 0 );
+	}
+	bench_handle->block_size = (size32_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the maximum cache size in MiB
+ * The cache pool is created when the input is opened
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_maximum_cache_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_maximum_cache_size";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) BENCH_HANDLE_MAXIMUM_CACHE_SIZE ) )
+	{
+		return( 0 );
+	}
+	bench_handle->maximum_cache_size = (size64_t) value_64bit * 1024 * 1024;
+
+	return( 1 );
+}
+
+/* Sets the number of reads per pass
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_number_of_reads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_number_of_reads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) BENCH_HANDLE_MAXIMUM_NUMBER_OF_READS ) )
+	{
+		return( 0 );
+	}
+	bench_handle->number_of_reads = value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the number of threads
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
+	{
+		return( 0 );
+	}
+	/* Reading from multiple threads requires a library with multi-threading support
+	 */
+#if !defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT ) || !defined( LIBVMDK_HAVE_MULTI_THREAD_SUPPORT )
+	if( value_64bit > 1 )
+	{
+		return( 0 );
+	}
+#endif
+	bench_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the seed of the random offsets
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_seed(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "bench_handle_set_seed";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->seed = value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the filename of the source
+ * The basename of the filename is used to locate the parent images
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_filename(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	system_character_t *basename_end = NULL;
+	static char *function            = "bench_handle_set_filename";
+	size_t basename_length           = 0;
+	size_t filename_length           = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->filename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid bench handle - filename already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( SSIZE_MAX / sizeof( system_character_t ) ) - 1 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->filename = system_string_allocate(
+	                          filename_length + 1 );
+
+	if( bench_handle->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     bench_handle->filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle->filename[ filename_length ] = 0;
+
+	bench_handle->filename_size = filename_length + 1;
+
+	basename_end = system_string_search_character_reverse(
+	                filename,
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
+
+	if( basename_end != NULL )
+	{
+		basename_length = (size_t) ( basename_end - filename ) + 1;
+	}
+	if( basename_length > 0 )
+	{
+		bench_handle->basename = system_string_allocate(
+		                          basename_length );
+
+		if( bench_handle->basename == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create basename string.",
+			 function );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     bench_handle->basename,
+		     filename,
+		     basename_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy basename.",
+			 function );
+
+			goto on_error;
+		}
+		bench_handle->basename[ basename_length - 1 ] = 0;
+
+		bench_handle->basename_size = basename_length;
+	}
+	return( 1 );
+
+on_error:
+	if( bench_handle->basename != NULL )
+	{
+		memory_free(
+		 bench_handle->basename );
+
+		bench_handle->basename = NULL;
+	}
+	bench_handle->basename_size = 0;
+
+	if( bench_handle->filename != NULL )
+	{
+		memory_free(
+		 bench_handle->filename );
+
+		bench_handle->filename = NULL;
+	}
+	bench_handle->filename_size = 0;
+
+	return( -1 );
+}
+
+/* Opens the input of the bench handle
+ * The input is opened together with its parents using the parent filename hints
+ * When a maximum cache size was set a new cache pool is shared by the input handles
+ * Returns 1 if successful, 0 if disk type is not supported or -1 on error
+ */
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle     = NULL;
+	static char *function              = "bench_handle_open_input";
+	uint32_t parent_content_identifier = 0;
+	int disk_type                      = 0;
+	int entry_index                    = 0;
+	int result                         = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid bench handle - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->input_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid bench handle - input handle already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->maximum_cache_size != 0 )
+	{
+		if( libvmdk_cache_pool_initialize(
+		     &( bench_handle->cache_pool ),
+		     bench_handle->maximum_cache_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize cache pool.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( bench_handle->cache_pool != NULL )
+	{
+		if( libvmdk_handle_set_cache_pool(
+		     input_handle,
+		     bench_handle->cache_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache pool of input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     input_handle,
+	     bench_handle->filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     input_handle,
+	     bench_handle->filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The input handle is the first entry in the array so that the parents
+	 * are freed after the handles that refer to them
+	 */
+	if( libcdata_array_append_entry(
+	     bench_handle->input_handles_array,
+	     &entry_index,
+	     (intptr_t *) input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append input handle to array.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle->input_handle = input_handle;
+
+	input_handle = NULL;
+
+	if( libvmdk_handle_get_disk_type(
+	     bench_handle->input_handle,
+	     &disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( disk_type != LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	{
+		/* Unsupported disk type
+		 */
+		return( 0 );
+	}
+	result = libvmdk_handle_get_parent_content_identifier(
+		  bench_handle->input_handle,
+		  &parent_content_identifier,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		result = bench_handle_open_input_parent_handle(
+		          bench_handle,
+		          bench_handle->input_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     bench_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_get_media_size(
+	     bench_handle->input_handle,
+	     &( bench_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( input_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &input_handle,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 bench_handle->input_handles_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+	 NULL );
+
+	bench_handle->input_handle = NULL;
+
+	if( bench_handle->cache_pool != NULL )
+	{
+		libvmdk_cache_pool_free(
+		 &( bench_handle->cache_pool ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the parent input handle
+ * Returns 1 if successful, 0 if no parent or -1 on error
+ */
+int bench_handle_open_input_parent_handle(
+     bench_handle_t *bench_handle,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_input_handle = NULL;
+	system_character_t *parent_filename   = NULL;
+	system_character_t *parent_path       = NULL;
+	static char *function                 = "bench_handle_open_input_parent_handle";
+	size_t parent_filename_size           = 0;
+	size_t parent_path_size               = 0;
+	uint32_t parent_content_identifier    = 0;
+	int entry_index                       = 0;
+	int parent_disk_type                  = 0;
+	int result                            = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_filename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_filename_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * parent_filename_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid parent filename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+			   parent_filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename(
+		  input_handle,
+		  (uint16_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename(
+		  input_handle,
+		  (uint8_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( bench_handle->basename == NULL )
+	{
+		parent_path      = parent_filename;
+		parent_path_size = parent_filename_size;
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &parent_path,
+		     &parent_path_size,
+		     bench_handle->basename,
+		     bench_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &parent_path,
+		     &parent_path_size,
+		     bench_handle->basename,
+		     bench_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &parent_input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( bench_handle->cache_pool != NULL )
+	{
+		if( libvmdk_handle_set_cache_pool(
+		     parent_input_handle,
+		     bench_handle->cache_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache pool of parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent input handle: %" PRIs_SYSTEM ".",
+		 function,
+		 parent_path );
+
+		goto on_error;
+	}
+	if( parent_path != NULL )
+	{
+		if( bench_handle->basename != NULL )
+		{
+			memory_free(
+			 parent_path );
+		}
+		parent_path = NULL;
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+
+		parent_filename = NULL;
+	}
+	if( libvmdk_handle_get_disk_type(
+	     parent_input_handle,
+	     &parent_disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	{
+		result = libvmdk_handle_get_parent_content_identifier(
+			  parent_input_handle,
+			  &parent_content_identifier,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent content identifier.",
+			 function );
+
+			goto on_error;
+		}
+		else if( ( result != 0 )
+		      && ( parent_content_identifier != 0xffffffffUL ) )
+		{
+			result = bench_handle_open_input_parent_handle(
+				  bench_handle,
+				  parent_input_handle,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open parent input handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			result = 1;
+		}
+	}
+	else
+	{
+		/* Unsupported disk type
+		 */
+		result = 0;
+	}
+	if( result != 0 )
+	{
+		if( libvmdk_handle_open_extent_data_files(
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent extent data files.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_set_parent_handle(
+		     input_handle,
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     bench_handle->input_handles_array,
+		     &entry_index,
+		     (intptr_t *) parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append parent input handle to array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libvmdk_handle_close(
+		     parent_input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_free(
+		     &parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( parent_input_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &parent_input_handle,
+		 NULL );
+	}
+	if( ( parent_path != NULL )
+	 && ( bench_handle->basename != NULL ) )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+/* Closes the bench handle
+ * The input handles and the cache pool are freed so that the input can be opened again with cold caches
+ * Returns the 0 if succesful or -1 on error
+ */
+int bench_handle_close(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "bench_handle_close";
+	int input_handle_index         = 0;
+	int number_of_input_handles    = 0;
+	int result                     = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     bench_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	/* Close the delta disks before their parents
+	 */
+	for( input_handle_index = 0;
+	     input_handle_index < number_of_input_handles;
+	     input_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     bench_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		if( libvmdk_handle_close(
+		     input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_empty(
+	     bench_handle->input_handles_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to empty input handles array.",
+		 function );
+
+		result = -1;
+	}
+	bench_handle->input_handle = NULL;
+
+	if( bench_handle->cache_pool != NULL )
+	{
+		if( libvmdk_cache_pool_free(
+		     &( bench_handle->cache_pool ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free cache pool.",
+			 function );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Retrieves a monotonic timestamp in nanoseconds
+ * Returns 1 if successful or 0 if not available
+ */
+int bench_handle_get_timestamp(
+     uint64_t *timestamp )
+{
+#if defined( WINAPI )
+	LARGE_INTEGER counter;
+	LARGE_INTEGER frequency;
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	struct timespec time_value;
+#endif
+
+	if( timestamp == NULL )
+	{
+		return( 0 );
+	}
+#if defined( WINAPI )
+	if( ( QueryPerformanceFrequency(
+	       &frequency ) == 0 )
+	 || ( frequency.QuadPart <= 0 ) )
+	{
+		return( 0 );
+	}
+	if( QueryPerformanceCounter(
+	     &counter ) == 0 )
+	{
+		return( 0 );
+	}
+	*timestamp = ( (uint64_t) counter.QuadPart / (uint64_t) frequency.QuadPart ) * 1000000000UL
+	           + ( ( (uint64_t) counter.QuadPart % (uint64_t) frequency.QuadPart ) * 1000000000UL ) / (uint64_t) frequency.QuadPart;
+
+	return( 1 );
+
+#elif defined( HAVE_CLOCK_GETTIME ) && defined( CLOCK_MONOTONIC )
+	if( clock_gettime(
+	     CLOCK_MONOTONIC,
+	     &time_value ) != 0 )
+	{
+		return( 0 );
+	}
+	*timestamp = ( (uint64_t) time_value.tv_sec * 1000000000UL ) + (uint64_t) time_value.tv_nsec;
+
+	return( 1 );
+
+#else
+	return( 0 );
+#endif
+}
+
+/* Retrieves the next value of a xorshift64* pseudo random number generator
+ * A fixed generator is used so that the random offsets are the same on every platform
+ * Returns the random value
+ */
+uint64_t bench_handle_get_random_value(
+          uint64_t *random_state )
+{
+	uint64_t value = 0;
+
+	if( random_state == NULL )
+	{
+		return( 0 );
+	}
+	value = *random_state;
+
+	if( value == 0 )
+	{
+		value = 0x9e3779b97f4a7c15ULL;
+	}
+	value ^= value >> 12;
+	value ^= value << 25;
+	value ^= value >> 27;
+
+	*random_state = value;
+
+	return( value * 0x2545f4914f6cdd1dULL );
+}
+
+/* Compares two latencies
+ * Returns -1 if the first is smaller, 0 if equal or 1 if the first is larger
+ */
+int bench_handle_compare_latencies(
+     const uint64_t *first_latency,
+     const uint64_t *second_latency )
+{
+	if( *first_latency < *second_latency )
+	{
+		return( -1 );
+	}
+	else if( *first_latency > *second_latency )
+	{
+		return( 1 );
+	}
+	return( 0 );
+}
+
+/* Retrieves a latency percentile from sorted latencies using the nearest rank
+ * Returns 1 if successful or 0 if no latencies are available
+ */
+int bench_handle_get_latency_percentile(
+     const uint64_t *latencies,
+     uint64_t number_of_latencies,
+     int per_mille,
+     uint64_t *latency )
+{
+	uint64_t latency_index = 0;
+
+	if( ( latencies == NULL )
+	 || ( number_of_latencies == 0 )
+	 || ( per_mille < 0 )
+	 || ( per_mille > 1000 )
+	 || ( latency == NULL ) )
+	{
+		return( 0 );
+	}
+	latency_index = ( ( number_of_latencies * (uint64_t) per_mille ) + 999 ) / 1000;
+
+	if( latency_index > 0 )
+	{
+		latency_index -= 1;
+	}
+	*latency = latencies[ latency_index ];
+
+	return( 1 );
+}
+
+/* Prints a latency in microseconds
+ */
+void bench_handle_latency_fprint(
+      FILE *stream,
+      const char *description,
+      uint64_t latency )
+{
+	if( ( stream == NULL )
+	 || ( description == NULL ) )
+	{
+		return;
+	}
+	fprintf(
+	 stream,
+	 "\t%s: %" PRIu64 ".%03" PRIu64 " us\n",
+	 description,
+	 latency / 1000,
+	 latency % 1000 );
+}
+
+/* Reads blocks at the read offsets and stores the latency of every read
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int bench_handle_read_blocks(
+     bench_handle_t *bench_handle,
+     uint8_t *buffer,
+     uint64_t first_read_index,
+     uint64_t number_of_reads,
+     libcerror_error_t **error )
+{
+	static char *function    = "bench_handle_read_blocks";
+	size_t read_size         = 0;
+	ssize_t read_count       = 0;
+	uint64_t end_timestamp   = 0;
+	uint64_t read_index      = 0;
+	uint64_t start_timestamp = 0;
+	off64_t read_offset      = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bench_handle->read_offsets == NULL )
+	 || ( bench_handle->read_latencies == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid bench handle - missing read offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	for( read_index = first_read_index;
+	     read_index < first_read_index + number_of_reads;
+	     read_index++ )
+	{
+		if( bench_handle->abort != 0 )
+		{
+			return( 0 );
+		}
+		read_offset = bench_handle->read_offsets[ read_index ];
+		read_size   = (size_t) bench_handle->block_size;
+
+		if( read_size > (size_t) ( bench_handle->media_size - read_offset ) )
+		{
+			read_size = (size_t) ( bench_handle->media_size - read_offset );
+		}
+		bench_handle_get_timestamp(
+		 &start_timestamp );
+
+		read_count = libvmdk_handle_read_buffer_at_offset(
+		              bench_handle->input_handle,
+		              buffer,
+		              read_size,
+		              read_offset,
+		              error );
+
+		bench_handle_get_timestamp(
+		 &end_timestamp );
+
+		if( read_count != (ssize_t) read_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read block at offset: %" PRIi64 " (0x%08" PRIx64 ").",
+			 function,
+			 read_offset,
+			 read_offset );
+
+			return( -1 );
+		}
+		bench_handle->read_latencies[ read_index ] = end_timestamp - start_timestamp;
+	}
+	return( 1 );
+}
+
+/* Reads blocks from a separate thread
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int bench_handle_read_blocks_thread_function(
+     bench_handle_thread_arguments_t *thread_arguments )
+{
+	if( thread_arguments == NULL )
+	{
+		return( -1 );
+	}
+	thread_arguments->result = bench_handle_read_blocks(
+	                            thread_arguments->bench_handle,
+	                            thread_arguments->buffer,
+	                            thread_arguments->first_read_index,
+	                            thread_arguments->number_of_reads,
+	                            &( thread_arguments->error ) );
+
+	return( thread_arguments->result );
+}
+
+/* Retrieves the statistics values summed over the input handle and its parents
+ * The values must contain BENCH_HANDLE_NUMBER_OF_STATISTICS_VALUES entries
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_get_statistics_values(
+     bench_handle_t *bench_handle,
+     uint64_t *values,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "bench_handle_get_statistics_values";
+	uint64_t value                 = 0;
+	int input_handle_index         = 0;
+	int number_of_input_handles    = 0;
+	int result                     = 0;
+	int value_index                = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( values == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid values.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     values,
+	     0,
+	     sizeof( uint64_t ) * BENCH_HANDLE_NUMBER_OF_STATISTICS_VALUES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear values.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     bench_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( input_handle_index = 0;
+	     input_handle_index < number_of_input_handles;
+	     input_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     bench_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		for( value_index = 0;
+		     value_index < BENCH_HANDLE_NUMBER_OF_STATISTICS_VALUES;
+		     value_index++ )
+		{
+			result = libvmdk_handle_get_statistics_value(
+			          input_handle,
+			          bench_handle_statistics_value_types[ value_index ],
+			          &value,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve statistics value: %d of input handle: %d.",
+				 function,
+				 bench_handle_statistics_value_types[ value_index ],
+				 input_handle_index );
+
+				return( -1 );
+			}
+			else if( result != 0 )
+			{
+				values[ value_index ] += value;
+			}
+		}
+	}
+	return( 1 );
+}
+
+/* Determines the read offsets of an access pattern
+ * The sequential offsets start at the beginning of the media
+ * The random offsets are block aligned and determined by the seed
+ * Returns 1 if successful or -1 on error
+ */
+int bench_handle_set_read_offsets(
+     bench_handle_t *bench_handle,
+     int access_pattern,
+     uint64_t *number_of_reads,
+     libcerror_error_t **error )
+{
+	static char *function     = "bench_handle_set_read_offsets";
+	uint64_t block_index      = 0;
+	uint64_t number_of_blocks = 0;
+	uint64_t random_state     = 0;
+	uint64_t read_index       = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid bench handle - missing block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->read_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid bench handle - missing read offsets.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( access_pattern != BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL )
+	 && ( access_pattern != BENCH_HANDLE_ACCESS_PATTERN_RANDOM ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported access pattern.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reads == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid number of reads.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_blocks = bench_handle->media_size / bench_handle->block_size;
+
+	if( ( bench_handle->media_size % bench_handle->block_size ) != 0 )
+	{
+		number_of_blocks += 1;
+	}
+	*number_of_reads = bench_handle->number_of_reads;
+
+	if( number_of_blocks == 0 )
+	{
+		*number_of_reads = 0;
+	}
+	else if( ( access_pattern == BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL )
+	      && ( *number_of_reads > number_of_blocks ) )
+	{
+		*number_of_reads = number_of_blocks;
+	}
+	random_state = bench_handle->seed;
+
+	for( read_index = 0;
+	     read_index < *number_of_reads;
+	     read_index++ )
+	{
+		if( access_pattern == BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL )
+		{
+			block_index = read_index;
+		}
+		else
+		{
+			block_index = bench_handle_get_random_value(
+			               &random_state ) % number_of_blocks;
+		}
+		bench_handle->read_offsets[ read_index ] = (off64_t) ( block_index * bench_handle->block_size );
+	}
+	return( 1 );
+}
+
+/* Runs a benchmark pass over the read offsets and prints the results
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int bench_handle_run_pass(
+     bench_handle_t *bench_handle,
+     const char *description,
+     uint64_t number_of_reads,
+     libcerror_error_t **error )
+{
+	uint64_t end_values[ BENCH_HANDLE_NUMBER_OF_STATISTICS_VALUES ];
+	uint64_t start_values[ BENCH_HANDLE_NUMBER_OF_STATISTICS_VALUES ];
+
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+	bench_handle_thread_arguments_t *thread_arguments = NULL;
+	libcthreads_thread_t **threads                    = NULL;
+	uint64_t first_read_index                         = 0;
+	uint64_t thread_number_of_reads                   = 0;
+	int thread_index                                  = 0;
+#endif
+	uint8_t *buffers                                  = NULL;
+	static char *function                             = "bench_handle_run_pass";
+	size_t buffers_size                               = 0;
+	uint64_t duration                                 = 0;
+	uint64_t end_timestamp                            = 0;
+	uint64_t latency                                  = 0;
+	uint64_t read_index                               = 0;
+	uint64_t read_size                                = 0;
+	uint64_t start_timestamp                          = 0;
+	double throughput                                 = 0.0;
+	int number_of_threads                             = 1;
+	int result                                        = 1;
+	int value_index                                   = 0;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( description == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid description.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_reads > bench_handle->number_of_reads )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid number of reads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+	if( bench_handle->number_of_threads > 1 )
+	{
+		number_of_threads = bench_handle->number_of_threads;
+
+		if( (uint64_t) number_of_threads > number_of_reads )
+		{
+			number_of_threads = (int) number_of_reads;
+		}
+		if( number_of_threads < 1 )
+		{
+			number_of_threads = 1;
+		}
+	}
+#endif
+	buffers_size = (size_t) bench_handle->block_size * number_of_threads;
+
+	buffers = (uint8_t *) memory_allocate(
+	                       sizeof( uint8_t ) * buffers_size );
+
+	if( buffers == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffers.",
+		 function );
+
+		goto on_error;
+	}
+	if( bench_handle_get_statistics_values(
+	     bench_handle,
+	     start_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics values.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle_get_timestamp(
+	 &start_timestamp );
+
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+	if( number_of_threads > 1 )
+	{
+		thread_arguments = (bench_handle_thread_arguments_t *) memory_allocate(
+		                                                        sizeof( bench_handle_thread_arguments_t ) * number_of_threads );
+
+		if( thread_arguments == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create thread arguments.",
+			 function );
+
+			goto on_error;
+		}
+		threads = (libcthreads_thread_t **) memory_allocate(
+		                                     sizeof( libcthreads_thread_t * ) * number_of_threads );
+
+		if( threads == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create threads.",
+			 function );
+
+			goto on_error;
+		}
+		if( memory_set(
+		     threads,
+		     0,
+		     sizeof( libcthreads_thread_t * ) * number_of_threads ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear threads.",
+			 function );
+
+			goto on_error;
+		}
+		/* Every thread reads a consecutive part of the read offsets
+		 */
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			thread_number_of_reads = number_of_reads / number_of_threads;
+
+			if( (uint64_t) thread_index < ( number_of_reads % number_of_threads ) )
+			{
+				thread_number_of_reads += 1;
+			}
+			thread_arguments[ thread_index ].bench_handle     = bench_handle;
+			thread_arguments[ thread_index ].buffer           = &( buffers[ (size_t) bench_handle->block_size * thread_index ] );
+			thread_arguments[ thread_index ].first_read_index = first_read_index;
+			thread_arguments[ thread_index ].number_of_reads  = thread_number_of_reads;
+			thread_arguments[ thread_index ].result           = 0;
+			thread_arguments[ thread_index ].error            = NULL;
+
+			first_read_index += thread_number_of_reads;
+		}
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			if( libcthreads_thread_create(
+			     &( threads[ thread_index ] ),
+			     NULL,
+			     (int (*)(void *)) &bench_handle_read_blocks_thread_function,
+			     (void *) &( thread_arguments[ thread_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to create thread: %d.",
+				 function,
+				 thread_index );
+
+				/* Make sure the threads that were created stop
+				 */
+				bench_handle->abort = 1;
+
+				result = -1;
+
+				break;
+			}
+		}
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			if( threads[ thread_index ] == NULL )
+			{
+				continue;
+			}
+			if( libcthreads_thread_join(
+			     &( threads[ thread_index ] ),
+			     ( result == 1 ) ? error : NULL ) != 1 )
+			{
+				if( result == 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to join thread: %d.",
+					 function,
+					 thread_index );
+				}
+				result = -1;
+			}
+		}
+		for( thread_index = 0;
+		     thread_index < number_of_threads;
+		     thread_index++ )
+		{
+			if( thread_arguments[ thread_index ].error != NULL )
+			{
+				libcnotify_print_error_backtrace(
+				 thread_arguments[ thread_index ].error );
+				libcerror_error_free(
+				 &( thread_arguments[ thread_index ].error ) );
+			}
+			if( ( result == 1 )
+			 && ( thread_arguments[ thread_index ].result != 1 ) )
+			{
+				result = thread_arguments[ thread_index ].result;
+			}
+		}
+		memory_free(
+		 threads );
+
+		threads = NULL;
+
+		memory_free(
+		 thread_arguments );
+
+		thread_arguments = NULL;
+
+		if( result == -1 )
+		{
+			if( ( error != NULL )
+			 && ( *error == NULL ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_READ_FAILED,
+				 "%s: unable to read blocks.",
+				 function );
+			}
+			goto on_error;
+		}
+	}
+	else
+#endif
+	{
+		result = bench_handle_read_blocks(
+		          bench_handle,
+		          buffers,
+		          0,
+		          number_of_reads,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 "%s: unable to read blocks.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	bench_handle_get_timestamp(
+	 &end_timestamp );
+
+	memory_free(
+	 buffers );
+
+	buffers = NULL;
+
+	if( result == 0 )
+	{
+		return( 0 );
+	}
+	if( bench_handle_get_statistics_values(
+	     bench_handle,
+	     end_values,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve statistics values.",
+		 function );
+
+		goto on_error;
+	}
+	duration = end_timestamp - start_timestamp;
+
+	for( read_index = 0;
+	     read_index < number_of_reads;
+	     read_index++ )
+	{
+		if( ( bench_handle->media_size - (size64_t) bench_handle->read_offsets[ read_index ] ) < (size64_t) bench_handle->block_size )
+		{
+			read_size += bench_handle->media_size - (size64_t) bench_handle->read_offsets[ read_index ];
+		}
+		else
+		{
+			read_size += bench_handle->block_size;
+		}
+	}
+	if( duration > 0 )
+	{
+		throughput = ( (double) read_size * 1000000000.0 ) / ( (double) duration * 1024.0 * 1024.0 );
+	}
+	fprintf(
+	 bench_handle->notify_stream,
+	 "%s:\n",
+	 description );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tNumber of reads\t\t\t: %" PRIu64 "\n",
+	 number_of_reads );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tNumber of threads\t\t: %d\n",
+	 number_of_threads );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tBytes read\t\t\t: %" PRIu64 "\n",
+	 read_size );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tDuration\t\t\t: %" PRIu64 ".%06" PRIu64 " seconds\n",
+	 duration / 1000000000UL,
+	 ( duration % 1000000000UL ) / 1000 );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\tThroughput\t\t\t: %.2f MiB/s\n",
+	 throughput );
+
+	if( number_of_reads > 0 )
+	{
+		qsort(
+		 bench_handle->read_latencies,
+		 (size_t) number_of_reads,
+		 sizeof( uint64_t ),
+		 (int (*)(const void *, const void *)) &bench_handle_compare_latencies );
+
+		bench_handle_latency_fprint(
+		 bench_handle->notify_stream,
+		 "Latency minimum\t\t\t",
+		 bench_handle->read_latencies[ 0 ] );
+
+		if( bench_handle_get_latency_percentile(
+		     bench_handle->read_latencies,
+		     number_of_reads,
+		     500,
+		     &latency ) == 1 )
+		{
+			bench_handle_latency_fprint(
+			 bench_handle->notify_stream,
+			 "Latency 50th percentile\t\t",
+			 latency );
+		}
+		if( bench_handle_get_latency_percentile(
+		     bench_handle->read_latencies,
+		     number_of_reads,
+		     900,
+		     &latency ) == 1 )
+		{
+			bench_handle_latency_fprint(
+			 bench_handle->notify_stream,
+			 "Latency 90th percentile\t\t",
+			 latency );
+		}
+		if( bench_handle_get_latency_percentile(
+		     bench_handle->read_latencies,
+		     number_of_reads,
+		     990,
+		     &latency ) == 1 )
+		{
+			bench_handle_latency_fprint(
+			 bench_handle->notify_stream,
+			 "Latency 99th percentile\t\t",
+			 latency );
+		}
+		if( bench_handle_get_latency_percentile(
+		     bench_handle->read_latencies,
+		     number_of_reads,
+		     999,
+		     &latency ) == 1 )
+		{
+			bench_handle_latency_fprint(
+			 bench_handle->notify_stream,
+			 "Latency 99.9th percentile\t",
+			 latency );
+		}
+		bench_handle_latency_fprint(
+		 bench_handle->notify_stream,
+		 "Latency maximum\t\t\t",
+		 bench_handle->read_latencies[ number_of_reads - 1 ] );
+	}
+	for( value_index = 0;
+	     value_index < BENCH_HANDLE_NUMBER_OF_STATISTICS_VALUES;
+	     value_index++ )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "\t%s: %" PRIu64 "\n",
+		 bench_handle_statistics_value_descriptions[ value_index ],
+		 end_values[ value_index ] - start_values[ value_index ] );
+	}
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+
+on_error:
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+	if( threads != NULL )
+	{
+		memory_free(
+		 threads );
+	}
+	if( thread_arguments != NULL )
+	{
+		memory_free(
+		 thread_arguments );
+	}
+#endif
+	if( buffers != NULL )
+	{
+		memory_free(
+		 buffers );
+	}
+	return( -1 );
+}
+
+/* Runs the benchmark and prints the results
+ * Every access pattern is run with cold caches on a newly opened input
+ * followed by a pass over the same offsets with warm caches
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error )
+{
+	const char *cold_description  = NULL;
+	const char *warm_description  = NULL;
+	static char *function         = "bench_handle_run";
+	uint64_t number_of_reads      = 0;
+	uint64_t timestamp            = 0;
+	int access_pattern            = 0;
+	int number_of_input_handles   = 0;
+	int number_of_passes          = 0;
+	int result                    = 1;
+
+	if( bench_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid bench handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid bench handle - missing input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle->read_offsets != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid bench handle - read offsets already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( bench_handle->number_of_reads == 0 )
+	 || ( bench_handle->number_of_reads > (uint64_t) BENCH_HANDLE_MAXIMUM_NUMBER_OF_READS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid bench handle - number of reads value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( bench_handle_get_timestamp(
+	     &timestamp ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: monotonic clock not available.",
+		 function );
+
+		return( -1 );
+	}
+	bench_handle->read_offsets = (off64_t *) memory_allocate(
+	                                          sizeof( off64_t ) * (size_t) bench_handle->number_of_reads );
+
+	if( bench_handle->read_offsets == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read offsets.",
+		 function );
+
+		goto on_error;
+	}
+	bench_handle->read_latencies = (uint64_t *) memory_allocate(
+	                                             sizeof( uint64_t ) * (size_t) bench_handle->number_of_reads );
+
+	if( bench_handle->read_latencies == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create read latencies.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     bench_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 bench_handle->notify_stream,
+	 "Media size\t\t\t: %" PRIu64 " bytes\n",
+	 bench_handle->media_size );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "Number of images\t\t: %d\n",
+	 number_of_input_handles );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "Block size\t\t\t: %" PRIu32 " bytes\n",
+	 bench_handle->block_size );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "Number of reads per pass\t: %" PRIu64 "\n",
+	 bench_handle->number_of_reads );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "Number of threads\t\t: %d\n",
+	 bench_handle->number_of_threads );
+
+	fprintf(
+	 bench_handle->notify_stream,
+	 "Random seed\t\t\t: %" PRIu64 "\n",
+	 bench_handle->seed );
+
+	if( bench_handle->maximum_cache_size == 0 )
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "Maximum cache size\t\t: default\n" );
+	}
+	else
+	{
+		fprintf(
+		 bench_handle->notify_stream,
+		 "Maximum cache size\t\t: %" PRIu64 " MiB\n",
+		 bench_handle->maximum_cache_size / ( 1024 * 1024 ) );
+	}
+	fprintf(
+	 bench_handle->notify_stream,
+	 "\n" );
+
+	for( access_pattern = BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL;
+	     access_pattern <= BENCH_HANDLE_ACCESS_PATTERN_RANDOM;
+	     access_pattern <<= 1 )
+	{
+		if( ( bench_handle->access_patterns & access_pattern ) == 0 )
+		{
+			continue;
+		}
+		if( access_pattern == BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL )
+		{
+			cold_description = "Sequential read with cold cache";
+			warm_description = "Sequential read with warm cache";
+		}
+		else
+		{
+			cold_description = "Random read with cold cache";
+			warm_description = "Random read with warm cache";
+		}
+		/* Reopen the input so that the caches of the previous passes are not reused
+		 */
+		if( number_of_passes > 0 )
+		{
+			if( bench_handle_close(
+			     bench_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close input.",
+				 function );
+
+				goto on_error;
+			}
+			if( bench_handle_open_input(
+			     bench_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to reopen input.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		if( bench_handle_set_read_offsets(
+		     bench_handle,
+		     access_pattern,
+		     &number_of_reads,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set read offsets.",
+			 function );
+
+			goto on_error;
+		}
+		result = bench_handle_run_pass(
+		          bench_handle,
+		          cold_description,
+		          number_of_reads,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run pass: %s.",
+			 function,
+			 cold_description );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		result = bench_handle_run_pass(
+		          bench_handle,
+		          warm_description,
+		          number_of_reads,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to run pass: %s.",
+			 function,
+			 warm_description );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		number_of_passes++;
+	}
+	memory_free(
+	 bench_handle->read_latencies );
+
+	bench_handle->read_latencies = NULL;
+
+	memory_free(
+	 bench_handle->read_offsets );
+
+	bench_handle->read_offsets = NULL;
+
+	return( result );
+
+on_error:
+	if( bench_handle->read_latencies != NULL )
+	{
+		memory_free(
+		 bench_handle->read_latencies );
+
+		bench_handle->read_latencies = NULL;
+	}
+	if( bench_handle->read_offsets != NULL )
+	{
+		memory_free(
+		 bench_handle->read_offsets );
+
+		bench_handle->read_offsets = NULL;
+	}
+	return( -1 );
+}
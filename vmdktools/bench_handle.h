@@ -0,0 +1,304 @@
+/*
+ * Bench handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _BENCH_HANDLE_H )
+#define _BENCH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default block size
+ */
+#define BENCH_HANDLE_DEFAULT_BLOCK_SIZE			( 64 * 1024 )
+
+/* The maximum block size
+ */
+#define BENCH_HANDLE_MAXIMUM_BLOCK_SIZE			( 64 * 1024 * 1024 )
+
+/* The default number of reads per pass
+ */
+#define BENCH_HANDLE_DEFAULT_NUMBER_OF_READS		4096
+
+/* The maximum number of reads per pass
+ */
+#define BENCH_HANDLE_MAXIMUM_NUMBER_OF_READS		( 16 * 1024 * 1024 )
+
+/* The default number of threads
+ */
+#define BENCH_HANDLE_DEFAULT_NUMBER_OF_THREADS		1
+
+/* The maximum number of threads
+ */
+#define BENCH_HANDLE_MAXIMUM_NUMBER_OF_THREADS		64
+
+/* The maximum cache size in MiB
+ */
+#define BENCH_HANDLE_MAXIMUM_CACHE_SIZE			1048576
+
+/* The default seed of the random offsets
+ */
+#define BENCH_HANDLE_DEFAULT_SEED			1
+
+enum BENCH_HANDLE_ACCESS_PATTERNS
+{
+	BENCH_HANDLE_ACCESS_PATTERN_SEQUENTIAL		= 0x01,
+	BENCH_HANDLE_ACCESS_PATTERN_RANDOM		= 0x02,
+	BENCH_HANDLE_ACCESS_PATTERN_ALL			= 0x03
+};
+
+/* The number of statistics values reported per pass
+ */
+#define BENCH_HANDLE_NUMBER_OF_STATISTICS_VALUES	9
+
+typedef struct bench_handle bench_handle_t;
+
+struct bench_handle
+{
+	/* The source filename
+	 */
+	system_character_t *filename;
+
+	/* The source filename size
+	 */
+	size_t filename_size;
+
+	/* The basename
+	 */
+	system_character_t *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
+	/* The input handles array
+	 * The first entry contains the input handle followed by its parents
+	 */
+	libcdata_array_t *input_handles_array;
+
+	/* The input handle
+	 */
+	libvmdk_handle_t *input_handle;
+
+	/* The cache pool
+	 */
+	libvmdk_cache_pool_t *cache_pool;
+
+	/* The maximum cache size
+	 */
+	size64_t maximum_cache_size;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The access patterns
+	 */
+	int access_patterns;
+
+	/* The block size
+	 */
+	size32_t block_size;
+
+	/* The number of reads per pass
+	 */
+	uint64_t number_of_reads;
+
+	/* The number of threads
+	 */
+	int number_of_threads;
+
+	/* The seed of the random offsets
+	 */
+	uint64_t seed;
+
+	/* The read offsets
+	 */
+	off64_t *read_offsets;
+
+	/* The read latencies in nanoseconds
+	 */
+	uint64_t *read_latencies;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+typedef struct bench_handle_thread_arguments bench_handle_thread_arguments_t;
+
+struct bench_handle_thread_arguments
+{
+	/* The bench handle
+	 */
+	bench_handle_t *bench_handle;
+
+	/* The read buffer
+	 */
+	uint8_t *buffer;
+
+	/* The index of the first read
+	 */
+	uint64_t first_read_index;
+
+	/* The number of reads
+	 */
+	uint64_t number_of_reads;
+
+	/* The result
+	 */
+	int result;
+
+	/* The error
+	 */
+	libcerror_error_t *error;
+};
+
+int bench_handle_initialize(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_free(
+     bench_handle_t **bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_signal_abort(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_set_access_patterns(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_block_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_maximum_cache_size(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_reads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_number_of_threads(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_seed(
+     bench_handle_t *bench_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int bench_handle_set_filename(
+     bench_handle_t *bench_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int bench_handle_open_input(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_open_input_parent_handle(
+     bench_handle_t *bench_handle,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error );
+
+int bench_handle_close(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+int bench_handle_get_timestamp(
+     uint64_t *timestamp );
+
+uint64_t bench_handle_get_random_value(
+          uint64_t *random_state );
+
+int bench_handle_get_latency_percentile(
+     const uint64_t *latencies,
+     uint64_t number_of_latencies,
+     int per_mille,
+     uint64_t *latency );
+
+void bench_handle_latency_fprint(
+      FILE *stream,
+      const char *description,
+      uint64_t latency );
+
+int bench_handle_compare_latencies(
+     const uint64_t *first_latency,
+     const uint64_t *second_latency );
+
+int bench_handle_read_blocks(
+     bench_handle_t *bench_handle,
+     uint8_t *buffer,
+     uint64_t first_read_index,
+     uint64_t number_of_reads,
+     libcerror_error_t **error );
+
+int bench_handle_read_blocks_thread_function(
+     bench_handle_thread_arguments_t *thread_arguments );
+
+int bench_handle_get_statistics_values(
+     bench_handle_t *bench_handle,
+     uint64_t *values,
+     libcerror_error_t **error );
+
+int bench_handle_set_read_offsets(
+     bench_handle_t *bench_handle,
+     int access_pattern,
+     uint64_t *number_of_reads,
+     libcerror_error_t **error );
+
+int bench_handle_run_pass(
+     bench_handle_t *bench_handle,
+     const char *description,
+     uint64_t number_of_reads,
+     libcerror_error_t **error );
+
+int bench_handle_run(
+     bench_handle_t *bench_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _BENCH_HANDLE_H ) */
+
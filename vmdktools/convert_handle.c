@@ -0,0 +1,2865 @@
+/*
+ * Convert handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "convert_handle.h"
+#include "vmdktools_libbfio.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libcpath.h"
+#include "vmdktools_libfvalue.h"
+#include "vmdktools_libuna.h"
+#include "vmdktools_libvmdk.h"
+
+#define CONVERT_HANDLE_NOTIFY_STREAM		stdout
+
+/* Creates a convert handle
+ * Make sure the value convert_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int convert_handle_initialize(
+     convert_handle_t **convert_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "convert_handle_initialize";
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *convert_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid convert handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*convert_handle = memory_allocate_structure(
+	                 convert_handle_t );
+
+	if( *convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create convert handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *convert_handle,
+	     0,
+	     sizeof( convert_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear convert handle.",
+		 function );
+
+		memory_free(
+		 *convert_handle );
+
+		*convert_handle = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *convert_handle )->input_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handles array.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_initialize(
+	     &( ( *convert_handle )->output_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize output handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *convert_handle )->input_format        = CONVERT_HANDLE_INPUT_FORMAT_AUTO;
+	( *convert_handle )->output_format       = CONVERT_HANDLE_OUTPUT_FORMAT_SPARSE;
+	( *convert_handle )->number_of_threads   = CONVERT_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+	( *convert_handle )->process_buffer_size = CONVERT_HANDLE_DEFAULT_PROCESS_BUFFER_SIZE;
+	( *convert_handle )->notify_stream       = CONVERT_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *convert_handle != NULL )
+	{
+		if( ( *convert_handle )->input_handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *convert_handle )->input_handles_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *convert_handle );
+
+		*convert_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a convert handle
+ * Returns 1 if successful or -1 on error
+ */
+int convert_handle_free(
+     convert_handle_t **convert_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "convert_handle_free";
+	int result            = 1;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *convert_handle != NULL )
+	{
+		if( ( *convert_handle )->basename != NULL )
+		{
+			memory_free(
+			 ( *convert_handle )->basename );
+		}
+		if( libvmdk_handle_free(
+		     &( ( *convert_handle )->output_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output handle.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *convert_handle )->output_stream_writer != NULL )
+		{
+			if( libvmdk_stream_writer_free(
+			     &( ( *convert_handle )->output_stream_writer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free output stream writer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *convert_handle )->output_file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( ( *convert_handle )->output_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free output file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *convert_handle )->input_file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( ( *convert_handle )->input_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcdata_array_free(
+		     &( ( *convert_handle )->input_handles_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handles array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *convert_handle );
+
+		*convert_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the convert handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int convert_handle_signal_abort(
+     convert_handle_t *convert_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "convert_handle_signal_abort";
+	int input_handle_index         = 0;
+	int number_of_input_handles    = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	convert_handle->abort = 1;
+
+	if( libcdata_array_get_number_of_entries(
+	     convert_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( input_handle_index = 0;
+	     input_handle_index < number_of_input_handles;
+	     input_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     convert_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		if( libvmdk_handle_signal_abort(
+		     input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle: %d to abort.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the input format
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int convert_handle_set_input_format(
+     convert_handle_t *convert_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "convert_handle_set_input_format";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 3 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "raw" ),
+		     3 ) == 0 )
+		{
+			convert_handle->input_format = CONVERT_HANDLE_INPUT_FORMAT_RAW;
+			result                       = 1;
+		}
+	}
+	else if( string_length == 4 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "auto" ),
+		     4 ) == 0 )
+		{
+			convert_handle->input_format = CONVERT_HANDLE_INPUT_FORMAT_AUTO;
+			result                       = 1;
+		}
+		else if( system_string_compare(
+		          string,
+		          _SYSTEM_STRING( "vmdk" ),
+		          4 ) == 0 )
+		{
+			convert_handle->input_format = CONVERT_HANDLE_INPUT_FORMAT_VMDK;
+			result                       = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the output format
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int convert_handle_set_output_format(
+     convert_handle_t *convert_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "convert_handle_set_output_format";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 3 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "raw" ),
+		     3 ) == 0 )
+		{
+			convert_handle->output_format = CONVERT_HANDLE_OUTPUT_FORMAT_RAW;
+			result                        = 1;
+		}
+	}
+	else if( string_length == 4 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "flat" ),
+		     4 ) == 0 )
+		{
+			convert_handle->output_format = CONVERT_HANDLE_OUTPUT_FORMAT_FLAT;
+			result                        = 1;
+		}
+	}
+	else if( string_length == 5 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "split" ),
+		     5 ) == 0 )
+		{
+			convert_handle->output_format = CONVERT_HANDLE_OUTPUT_FORMAT_SPLIT_SPARSE;
+			result                        = 1;
+		}
+	}
+	else if( string_length == 6 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "sparse" ),
+		     6 ) == 0 )
+		{
+			convert_handle->output_format = CONVERT_HANDLE_OUTPUT_FORMAT_SPARSE;
+			result                        = 1;
+		}
+		else if( system_string_compare(
+		          string,
+		          _SYSTEM_STRING( "stream" ),
+		          6 ) == 0 )
+		{
+			convert_handle->output_format = CONVERT_HANDLE_OUTPUT_FORMAT_STREAM_OPTIMIZED;
+			result                        = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the number of threads used to compress stream-optimized output
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int convert_handle_set_number_of_threads(
+     convert_handle_t *convert_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "convert_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) CONVERT_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+	{
+		return( 0 );
+	}
+	convert_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Opens the input of the convert handle
+ * A VMDK input is opened together with its parents using the parent filename hints,
+ * any other input is opened as a raw image
+ * Returns 1 if successful, 0 if disk type is not supported or -1 on error
+ */
+int convert_handle_open_input(
+     convert_handle_t *convert_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle     = NULL;
+	system_character_t *basename_end   = NULL;
+	static char *function              = "convert_handle_open_input";
+	size_t basename_length             = 0;
+	size_t filename_length             = 0;
+	uint32_t parent_content_identifier = 0;
+	int disk_type                      = 0;
+	int entry_index                    = 0;
+	int result                         = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( convert_handle->input_format == CONVERT_HANDLE_INPUT_FORMAT_AUTO )
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		result = libvmdk_check_file_signature_wide(
+		          filename,
+		          error );
+#else
+		result = libvmdk_check_file_signature(
+		          filename,
+		          error );
+#endif
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to check file signature.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			convert_handle->input_format = CONVERT_HANDLE_INPUT_FORMAT_VMDK;
+		}
+		else
+		{
+			convert_handle->input_format = CONVERT_HANDLE_INPUT_FORMAT_RAW;
+		}
+	}
+	if( convert_handle->input_format == CONVERT_HANDLE_INPUT_FORMAT_RAW )
+	{
+		return( convert_handle_open_raw_input(
+		         convert_handle,
+		         filename,
+		         error ) );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	basename_end = system_string_search_character_reverse(
+	                filename,
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
+
+	if( basename_end != NULL )
+	{
+		basename_length = (size_t) ( basename_end - filename ) + 1;
+	}
+	if( basename_length > 0 )
+	{
+		if( convert_handle_set_basename(
+		     convert_handle,
+		     filename,
+		     basename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     input_handle,
+	     filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     input_handle,
+	     filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The input handle is the first entry in the array so that the parents
+	 * are freed after the handles that refer to them
+	 */
+	if( libcdata_array_append_entry(
+	     convert_handle->input_handles_array,
+	     &entry_index,
+	     (intptr_t *) input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append input handle to array.",
+		 function );
+
+		goto on_error;
+	}
+	convert_handle->input_handle = input_handle;
+
+	input_handle = NULL;
+
+	if( libvmdk_handle_get_disk_type(
+	     convert_handle->input_handle,
+	     &disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( disk_type != LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	{
+		/* Unsupported disk type
+		 */
+		return( 0 );
+	}
+	result = libvmdk_handle_get_parent_content_identifier(
+		  convert_handle->input_handle,
+		  &parent_content_identifier,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		result = convert_handle_open_input_parent_handle(
+		          convert_handle,
+		          convert_handle->input_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     convert_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_get_media_size(
+	     convert_handle->input_handle,
+	     &( convert_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( input_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &input_handle,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 convert_handle->input_handles_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+	 NULL );
+
+	convert_handle->input_handle = NULL;
+
+	return( -1 );
+}
+
+/* Opens the parent input handle
+ * Returns 1 if successful, 0 if no parent or -1 on error
+ */
+int convert_handle_open_input_parent_handle(
+     convert_handle_t *convert_handle,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_input_handle = NULL;
+	system_character_t *parent_filename   = NULL;
+	system_character_t *parent_path       = NULL;
+	static char *function                 = "convert_handle_open_input_parent_handle";
+	size_t parent_filename_size           = 0;
+	size_t parent_path_size               = 0;
+	uint32_t parent_content_identifier    = 0;
+	int entry_index                       = 0;
+	int parent_disk_type                  = 0;
+	int result                            = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_filename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_filename_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * parent_filename_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid parent filename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+			   parent_filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename(
+		  input_handle,
+		  (uint16_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename(
+		  input_handle,
+		  (uint8_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( convert_handle->basename == NULL )
+	{
+		parent_path      = parent_filename;
+		parent_path_size = parent_filename_size;
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &parent_path,
+		     &parent_path_size,
+		     convert_handle->basename,
+		     convert_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &parent_path,
+		     &parent_path_size,
+		     convert_handle->basename,
+		     convert_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &parent_input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent input handle: %" PRIs_SYSTEM ".",
+		 function,
+		 parent_path );
+
+		goto on_error;
+	}
+	if( parent_path != NULL )
+	{
+		if( convert_handle->basename != NULL )
+		{
+			memory_free(
+			 parent_path );
+		}
+		parent_path = NULL;
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+
+		parent_filename = NULL;
+	}
+	if( libvmdk_handle_get_disk_type(
+	     parent_input_handle,
+	     &parent_disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	{
+		result = libvmdk_handle_get_parent_content_identifier(
+			  parent_input_handle,
+			  &parent_content_identifier,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent content identifier.",
+			 function );
+
+			goto on_error;
+		}
+		else if( ( result != 0 )
+		      && ( parent_content_identifier != 0xffffffffUL ) )
+		{
+			result = convert_handle_open_input_parent_handle(
+				  convert_handle,
+				  parent_input_handle,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open parent input handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			result = 1;
+		}
+	}
+	else
+	{
+		/* Unsupported disk type
+		 */
+		result = 0;
+	}
+	if( result != 0 )
+	{
+		if( libvmdk_handle_open_extent_data_files(
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent extent data files.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_set_parent_handle(
+		     input_handle,
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     convert_handle->input_handles_array,
+		     &entry_index,
+		     (intptr_t *) parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append parent input handle to array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libvmdk_handle_close(
+		     parent_input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_free(
+		     &parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( parent_input_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &parent_input_handle,
+		 NULL );
+	}
+	if( ( parent_path != NULL )
+	 && ( convert_handle->basename != NULL ) )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+/* Opens a raw image as the input of the convert handle
+ * Returns 1 if successful or -1 on error
+ */
+int convert_handle_open_raw_input(
+     convert_handle_t *convert_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "convert_handle_open_raw_input";
+	size_t filename_length = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( convert_handle->input_file_io_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid convert handle - input file IO handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( libbfio_file_initialize(
+	     &( convert_handle->input_file_io_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libbfio_file_set_name_wide(
+	     convert_handle->input_file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+#else
+	if( libbfio_file_set_name(
+	     convert_handle->input_file_io_handle,
+	     filename,
+	     filename_length + 1,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set input filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     convert_handle->input_file_io_handle,
+	     LIBBFIO_OPEN_READ,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_get_size(
+	     convert_handle->input_file_io_handle,
+	     &( convert_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input size.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( convert_handle->input_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( convert_handle->input_file_io_handle ),
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the output of the convert handle
+ * For the flat output format the filename is that of the descriptor file
+ * and the extent file is created next to it with a -flat.vmdk suffix
+ * Returns 1 if successful or -1 on error
+ */
+int convert_handle_open_output(
+     convert_handle_t *convert_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	system_character_t *extent_basename = NULL;
+	system_character_t *extent_filename = NULL;
+	static char *function               = "convert_handle_open_output";
+	size_t extent_filename_size         = 0;
+	size_t filename_length              = 0;
+	size_t prefix_length                = 0;
+	int result                          = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( convert_handle->output_is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid convert handle - output already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( convert_handle->input_handle == NULL )
+	 && ( convert_handle->input_file_io_handle == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid convert handle - missing input.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	/* The VMDK formats store the media size in sectors
+	 */
+	if( ( convert_handle->output_format != CONVERT_HANDLE_OUTPUT_FORMAT_RAW )
+	 && ( ( convert_handle->media_size == 0 )
+	  || ( ( convert_handle->media_size % 512 ) != 0 ) ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported media size: %" PRIu64 " not a multiple of the sector size.",
+		 function,
+		 convert_handle->media_size );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	switch( convert_handle->output_format )
+	{
+		case CONVERT_HANDLE_OUTPUT_FORMAT_FLAT:
+			prefix_length = filename_length;
+
+			if( ( filename_length > 5 )
+			 && ( system_string_compare_no_case(
+			       &( filename[ filename_length - 5 ] ),
+			       _SYSTEM_STRING( ".vmdk" ),
+			       5 ) == 0 ) )
+			{
+				prefix_length -= 5;
+			}
+			extent_filename_size = prefix_length + 11;
+
+			extent_filename = system_string_allocate(
+			                   extent_filename_size );
+
+			if( extent_filename == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create extent filename.",
+				 function );
+
+				goto on_error;
+			}
+			if( system_string_copy(
+			     extent_filename,
+			     filename,
+			     prefix_length ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy extent filename prefix.",
+				 function );
+
+				goto on_error;
+			}
+			if( system_string_copy(
+			     &( extent_filename[ prefix_length ] ),
+			     _SYSTEM_STRING( "-flat.vmdk" ),
+			     10 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy extent filename suffix.",
+				 function );
+
+				goto on_error;
+			}
+			extent_filename[ extent_filename_size - 1 ] = 0;
+
+			/* The descriptor refers to the extent file by its basename
+			 */
+			extent_basename = system_string_search_character_reverse(
+			                   extent_filename,
+			                   (system_character_t) LIBCPATH_SEPARATOR,
+			                   extent_filename_size );
+
+			if( extent_basename != NULL )
+			{
+				extent_basename += 1;
+			}
+			else
+			{
+				extent_basename = extent_filename;
+			}
+			if( convert_handle_write_flat_descriptor(
+			     convert_handle,
+			     filename,
+			     extent_basename,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write descriptor file.",
+				 function );
+
+				goto on_error;
+			}
+			filename        = extent_filename;
+			filename_length = extent_filename_size - 1;
+
+		/* Fall through */
+		case CONVERT_HANDLE_OUTPUT_FORMAT_RAW:
+			if( libbfio_file_initialize(
+			     &( convert_handle->output_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize output file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			result = libbfio_file_set_name_wide(
+			          convert_handle->output_file_io_handle,
+			          filename,
+			          filename_length + 1,
+			          error );
+#else
+			result = libbfio_file_set_name(
+			          convert_handle->output_file_io_handle,
+			          filename,
+			          filename_length + 1,
+			          error );
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set output filename.",
+				 function );
+
+				goto on_error;
+			}
+			if( libbfio_handle_open(
+			     convert_handle->output_file_io_handle,
+			     LIBBFIO_OPEN_WRITE_TRUNCATE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open output file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+
+		case CONVERT_HANDLE_OUTPUT_FORMAT_SPARSE:
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			result = libvmdk_handle_create_sparse_wide(
+			          convert_handle->output_handle,
+			          filename,
+			          convert_handle->media_size,
+			          error );
+#else
+			result = libvmdk_handle_create_sparse(
+			          convert_handle->output_handle,
+			          filename,
+			          convert_handle->media_size,
+			          error );
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to create output handle.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+
+		case CONVERT_HANDLE_OUTPUT_FORMAT_SPLIT_SPARSE:
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			result = libvmdk_handle_create_split_sparse_wide(
+			          convert_handle->output_handle,
+			          filename,
+			          convert_handle->media_size,
+			          error );
+#else
+			result = libvmdk_handle_create_split_sparse(
+			          convert_handle->output_handle,
+			          filename,
+			          convert_handle->media_size,
+			          error );
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to create output handle.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+
+		case CONVERT_HANDLE_OUTPUT_FORMAT_STREAM_OPTIMIZED:
+			if( libvmdk_stream_writer_initialize(
+			     &( convert_handle->output_stream_writer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize output stream writer.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_stream_writer_set_media_size(
+			     convert_handle->output_stream_writer,
+			     convert_handle->media_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set media size of output stream writer.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_stream_writer_set_number_of_threads(
+			     convert_handle->output_stream_writer,
+			     convert_handle->number_of_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set number of threads of output stream writer.",
+				 function );
+
+				goto on_error;
+			}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			result = libvmdk_stream_writer_open_wide(
+			          convert_handle->output_stream_writer,
+			          filename,
+			          error );
+#else
+			result = libvmdk_stream_writer_open(
+			          convert_handle->output_stream_writer,
+			          filename,
+			          error );
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open output stream writer.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported output format.",
+			 function );
+
+			goto on_error;
+	}
+	if( extent_filename != NULL )
+	{
+		memory_free(
+		 extent_filename );
+
+		extent_filename = NULL;
+	}
+	convert_handle->output_end_offset = 0;
+	convert_handle->output_is_open    = 1;
+
+	return( 1 );
+
+on_error:
+	if( convert_handle->output_stream_writer != NULL )
+	{
+		libvmdk_stream_writer_free(
+		 &( convert_handle->output_stream_writer ),
+		 NULL );
+	}
+	if( convert_handle->output_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( convert_handle->output_file_io_handle ),
+		 NULL );
+	}
+	if( extent_filename != NULL )
+	{
+		memory_free(
+		 extent_filename );
+	}
+	return( -1 );
+}
+
+/* Writes the descriptor file of a monolithic flat output
+ * Returns 1 if successful or -1 on error
+ */
+int convert_handle_write_flat_descriptor(
+     convert_handle_t *convert_handle,
+     const system_character_t *filename,
+     const system_character_t *extent_basename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	uint8_t *descriptor              = NULL;
+	uint8_t *utf8_extent_basename    = NULL;
+	static char *function            = "convert_handle_write_flat_descriptor";
+	size64_t number_of_cylinders     = 0;
+	size_t descriptor_size           = 0;
+	size_t utf8_extent_basename_size = 0;
+	ssize_t write_count              = 0;
+	uint32_t content_identifier      = 0;
+	int print_count                  = 0;
+	int result                       = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent basename.",
+		 function );
+
+		return( -1 );
+	}
+	/* The descriptor is stored as UTF-8
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_size_from_utf32(
+	          (libuna_utf32_character_t *) extent_basename,
+	          system_string_length( extent_basename ) + 1,
+	          &utf8_extent_basename_size,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_size_from_utf16(
+	          (libuna_utf16_character_t *) extent_basename,
+	          system_string_length( extent_basename ) + 1,
+	          &utf8_extent_basename_size,
+	          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine UTF-8 extent basename size.",
+		 function );
+
+		goto on_error;
+	}
+	utf8_extent_basename = (uint8_t *) memory_allocate(
+	                                    sizeof( uint8_t ) * utf8_extent_basename_size );
+
+	if( utf8_extent_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create UTF-8 extent basename.",
+		 function );
+
+		goto on_error;
+	}
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_copy_from_utf32(
+	          utf8_extent_basename,
+	          utf8_extent_basename_size,
+	          (libuna_utf32_character_t *) extent_basename,
+	          system_string_length( extent_basename ) + 1,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_copy_from_utf16(
+	          utf8_extent_basename,
+	          utf8_extent_basename_size,
+	          (libuna_utf16_character_t *) extent_basename,
+	          system_string_length( extent_basename ) + 1,
+	          error );
+#endif /* SIZEOF_WCHAR_T */
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set UTF-8 extent basename.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	utf8_extent_basename_size = system_string_length( extent_basename ) + 1;
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	descriptor_size = 1024 + utf8_extent_basename_size;
+
+	descriptor = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * descriptor_size );
+
+	if( descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	content_identifier = (uint32_t) time( NULL );
+
+	if( content_identifier == 0xffffffffUL )
+	{
+		content_identifier ^= 0x00000001UL;
+	}
+	number_of_cylinders = convert_handle->media_size / ( 255 * 63 * 512 );
+
+	if( number_of_cylinders > 65535 )
+	{
+		number_of_cylinders = 65535;
+	}
+	print_count = narrow_string_snprintf(
+	               (char *) descriptor,
+	               descriptor_size,
+	               "# Disk DescriptorFile\n"
+	               "version=1\n"
+	               "encoding=\"UTF-8\"\n"
+	               "CID=%08" PRIx32 "\n"
+	               "parentCID=ffffffff\n"
+	               "createType=\"monolithicFlat\"\n"
+	               "\n"
+	               "# Extent description\n"
+	               "RW %" PRIu64 " FLAT \"%s\" 0\n"
+	               "\n"
+	               "# The Disk Data Base\n"
+	               "#DDB\n"
+	               "\n"
+	               "ddb.virtualHWVersion = \"4\"\n"
+	               "ddb.geometry.cylinders = \"%" PRIu64 "\"\n"
+	               "ddb.geometry.heads = \"255\"\n"
+	               "ddb.geometry.sectors = \"63\"\n"
+	               "ddb.adapterType = \"lsilogic\"\n",
+	               content_identifier,
+	               convert_handle->media_size / 512,
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	               (char *) utf8_extent_basename,
+#else
+	               extent_basename,
+#endif
+	               number_of_cylinders );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= descriptor_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          filename,
+	          system_string_length( filename ) + 1,
+	          error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          filename,
+	          system_string_length( filename ) + 1,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               descriptor,
+	               (size_t) print_count,
+	               error );
+
+	if( write_count != (ssize_t) print_count )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 descriptor );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	memory_free(
+	 utf8_extent_basename );
+#endif
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( descriptor != NULL )
+	{
+		memory_free(
+		 descriptor );
+	}
+	if( utf8_extent_basename != NULL )
+	{
+		memory_free(
+		 utf8_extent_basename );
+	}
+	return( -1 );
+}
+
+/* Closes the convert handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int convert_handle_close(
+     convert_handle_t *convert_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "convert_handle_close";
+	int input_handle_index         = 0;
+	int number_of_input_handles    = 0;
+	int result                     = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( convert_handle->output_is_open != 0 )
+	{
+		if( convert_handle->output_stream_writer != NULL )
+		{
+			/* Closing the stream writer writes the remaining grains and the metadata
+			 */
+			if( libvmdk_stream_writer_close(
+			     convert_handle->output_stream_writer,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close output stream writer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		else if( convert_handle->output_file_io_handle != NULL )
+		{
+			if( libbfio_handle_close(
+			     convert_handle->output_file_io_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close output file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		else
+		{
+			if( libvmdk_handle_close(
+			     convert_handle->output_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close output handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		convert_handle->output_is_open = 0;
+	}
+	if( convert_handle->input_file_io_handle != NULL )
+	{
+		if( libbfio_handle_close(
+		     convert_handle->input_file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input file IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     convert_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	/* Close the delta disks before their parents
+	 */
+	for( input_handle_index = 0;
+	     input_handle_index < number_of_input_handles;
+	     input_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     convert_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		if( libvmdk_handle_close(
+		     input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Writes a buffer at a specific offset to the output
+ * The stream-optimized output is written sequentially and stores blocks that only
+ * contain 0-byte values sparse by itself, for the other output formats consecutive
+ * blocks that contain data are combined into a single write and the other blocks are skipped
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t convert_handle_write_buffer_at_offset(
+         convert_handle_t *convert_handle,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "convert_handle_write_buffer_at_offset";
+	size_t block_index    = 0;
+	size_t block_offset   = 0;
+	size_t block_size     = 0;
+	size_t data_offset    = 0;
+	size_t data_size      = 0;
+	ssize_t write_count   = 0;
+	int is_sparse         = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( convert_handle->output_stream_writer != NULL )
+	{
+		write_count = libvmdk_stream_writer_write_buffer(
+		               convert_handle->output_stream_writer,
+		               buffer,
+		               buffer_size,
+		               error );
+
+		if( write_count != (ssize_t) buffer_size )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write buffer to output stream writer.",
+			 function );
+
+			return( -1 );
+		}
+		return( write_count );
+	}
+	while( block_offset <= buffer_size )
+	{
+		is_sparse = 1;
+
+		if( block_offset < buffer_size )
+		{
+			block_size = CONVERT_HANDLE_BLOCK_SIZE;
+
+			if( block_size > ( buffer_size - block_offset ) )
+			{
+				block_size = buffer_size - block_offset;
+			}
+			for( block_index = 0;
+			     block_index < block_size;
+			     block_index++ )
+			{
+				if( buffer[ block_offset + block_index ] != 0 )
+				{
+					is_sparse = 0;
+
+					break;
+				}
+			}
+		}
+		if( is_sparse == 0 )
+		{
+			data_size += block_size;
+		}
+		else if( data_size > 0 )
+		{
+			if( convert_handle->output_file_io_handle != NULL )
+			{
+				if( libbfio_handle_seek_offset(
+				     convert_handle->output_file_io_handle,
+				     offset + (off64_t) data_offset,
+				     SEEK_SET,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to seek offset: %" PRIi64 " in output file IO handle.",
+					 function,
+					 offset + (off64_t) data_offset );
+
+					return( -1 );
+				}
+				write_count = libbfio_handle_write_buffer(
+				               convert_handle->output_file_io_handle,
+				               &( buffer[ data_offset ] ),
+				               data_size,
+				               error );
+			}
+			else
+			{
+				write_count = libvmdk_handle_write_buffer_at_offset(
+				               convert_handle->output_handle,
+				               &( buffer[ data_offset ] ),
+				               data_size,
+				               offset + (off64_t) data_offset,
+				               error );
+			}
+			if( write_count != (ssize_t) data_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write data at offset: %" PRIi64 " to output.",
+				 function,
+				 offset + (off64_t) data_offset );
+
+				return( -1 );
+			}
+			if( ( offset + (off64_t) ( data_offset + data_size ) ) > convert_handle->output_end_offset )
+			{
+				convert_handle->output_end_offset = offset + (off64_t) ( data_offset + data_size );
+			}
+			convert_handle->copied_size += data_size;
+
+			data_size = 0;
+		}
+		if( block_offset == buffer_size )
+		{
+			break;
+		}
+		if( is_sparse != 0 )
+		{
+			convert_handle->sparse_size += block_size;
+
+			data_offset = block_offset + block_size;
+		}
+		block_offset += block_size;
+	}
+	return( (ssize_t) buffer_size );
+}
+
+/* Converts the input into the output
+ * Ranges of the input that are sparse in the grain tables of all the layers are
+ * not read, they are skipped in the output or, for the stream-optimized output that
+ * is written sequentially, written as blocks of 0-byte values that are stored sparse
+ * The other ranges are copied using reads and writes of the process buffer size
+ * that are aligned to the process buffer size
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int convert_handle_convert(
+     convert_handle_t *convert_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "convert_handle_convert";
+	size64_t range_size   = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	ssize_t write_count   = 0;
+	off64_t offset        = 0;
+	uint32_t range_flags  = 0;
+	int result            = 0;
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( convert_handle->input_handle == NULL )
+	 && ( convert_handle->input_file_io_handle == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid convert handle - missing input.",
+		 function );
+
+		return( -1 );
+	}
+	if( convert_handle->output_is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid convert handle - output not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( convert_handle->process_buffer_size == 0 )
+	 || ( convert_handle->process_buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid convert handle - process buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * convert_handle->process_buffer_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	convert_handle->copied_size = 0;
+	convert_handle->sparse_size = 0;
+
+	if( convert_handle->input_file_io_handle != NULL )
+	{
+		if( libbfio_handle_seek_offset(
+		     convert_handle->input_file_io_handle,
+		     0,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: 0 in input file IO handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	while( (size64_t) offset < convert_handle->media_size )
+	{
+		if( convert_handle->abort != 0 )
+		{
+			break;
+		}
+		if( convert_handle->input_handle != NULL )
+		{
+			result = libvmdk_handle_get_data_range_at_offset(
+			          convert_handle->input_handle,
+			          offset,
+			          &range_size,
+			          &range_flags,
+			          error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve data range at offset: %" PRIi64 ".",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+			else if( ( result == 0 )
+			      || ( range_size == 0 ) )
+			{
+				break;
+			}
+		}
+		else
+		{
+			/* A raw image has no allocation information
+			 */
+			range_size  = convert_handle->media_size - (size64_t) offset;
+			range_flags = 0;
+		}
+		while( range_size > 0 )
+		{
+			if( convert_handle->abort != 0 )
+			{
+				break;
+			}
+			/* Keep the reads and writes aligned to the process buffer size
+			 */
+			read_size = convert_handle->process_buffer_size
+			          - (size_t) ( (size64_t) offset % convert_handle->process_buffer_size );
+
+			if( (size64_t) read_size > range_size )
+			{
+				read_size = (size_t) range_size;
+			}
+			if( ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+			{
+				if( convert_handle->output_stream_writer != NULL )
+				{
+					if( memory_set(
+					     buffer,
+					     0,
+					     read_size ) == NULL )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_MEMORY,
+						 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+						 "%s: unable to clear buffer.",
+						 function );
+
+						goto on_error;
+					}
+					write_count = convert_handle_write_buffer_at_offset(
+					               convert_handle,
+					               buffer,
+					               read_size,
+					               offset,
+					               error );
+
+					if( write_count != (ssize_t) read_size )
+					{
+						libcerror_error_set(
+						 error,
+						 LIBCERROR_ERROR_DOMAIN_IO,
+						 LIBCERROR_IO_ERROR_WRITE_FAILED,
+						 "%s: unable to write buffer at offset: %" PRIi64 " to output.",
+						 function,
+						 offset );
+
+						goto on_error;
+					}
+				}
+				convert_handle->sparse_size += read_size;
+			}
+			else
+			{
+				if( convert_handle->input_handle != NULL )
+				{
+					/* The data is read through the input handle which resolves
+					 * the grains of the delta disks before those of their parents
+					 */
+					read_count = libvmdk_handle_read_buffer_at_offset(
+					              convert_handle->input_handle,
+					              buffer,
+					              read_size,
+					              offset,
+					              error );
+				}
+				else
+				{
+					read_count = libbfio_handle_read_buffer(
+					              convert_handle->input_file_io_handle,
+					              buffer,
+					              read_size,
+					              error );
+				}
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer at offset: %" PRIi64 " from input.",
+					 function,
+					 offset );
+
+					goto on_error;
+				}
+				write_count = convert_handle_write_buffer_at_offset(
+				               convert_handle,
+				               buffer,
+				               read_size,
+				               offset,
+				               error );
+
+				if( write_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write buffer at offset: %" PRIi64 " to output.",
+					 function,
+					 offset );
+
+					goto on_error;
+				}
+				if( convert_handle->output_stream_writer != NULL )
+				{
+					convert_handle->copied_size += read_size;
+				}
+			}
+			offset     += (off64_t) read_size;
+			range_size -= read_size;
+		}
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( convert_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	if( convert_handle->output_file_io_handle != NULL )
+	{
+		/* Write the last byte so the output has the size of the media when it ends with a sparse range
+		 */
+		if( (size64_t) convert_handle->output_end_offset < convert_handle->media_size )
+		{
+			offset = (off64_t) convert_handle->media_size - 1;
+
+			if( libbfio_handle_seek_offset(
+			     convert_handle->output_file_io_handle,
+			     offset,
+			     SEEK_SET,
+			     error ) == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_SEEK_FAILED,
+				 "%s: unable to seek offset: %" PRIi64 " in output file IO handle.",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+			write_count = libbfio_handle_write_buffer(
+			               convert_handle->output_file_io_handle,
+			               (uint8_t *) "",
+			               1,
+			               error );
+
+			if( write_count != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write last byte to output file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+			convert_handle->output_end_offset = (off64_t) convert_handle->media_size;
+		}
+	}
+	else if( convert_handle->output_stream_writer == NULL )
+	{
+		if( libvmdk_handle_flush(
+		     convert_handle->output_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to flush output handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( convert_handle->notify_stream != NULL )
+	{
+		fprintf(
+		 convert_handle->notify_stream,
+		 "Copied: %" PRIu64 " bytes, skipped sparse: %" PRIu64 " bytes.\n",
+		 convert_handle->copied_size,
+		 convert_handle->sparse_size );
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Sets the basename
+ * Returns 1 if successful or -1 on error
+ */
+int convert_handle_set_basename(
+     convert_handle_t *convert_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "convert_handle_set_basename";
+
+	if( convert_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid convert handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing basename.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( basename_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * basename_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid basename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( convert_handle->basename != NULL )
+	{
+		memory_free(
+		 convert_handle->basename );
+
+		convert_handle->basename      = NULL;
+		convert_handle->basename_size = 0;
+	}
+	convert_handle->basename = system_string_allocate(
+	                          basename_size );
+
+	if( convert_handle->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     convert_handle->basename,
+	     basename,
+	     basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy basename.",
+		 function );
+
+		goto on_error;
+	}
+	convert_handle->basename[ basename_size - 1 ] = 0;
+
+	convert_handle->basename_size = basename_size;
+
+	return( 1 );
+
+on_error:
+	if( convert_handle->basename != NULL )
+	{
+		memory_free(
+		 convert_handle->basename );
+
+		convert_handle->basename = NULL;
+	}
+	convert_handle->basename_size = 0;
+
+	return( -1 );
+}
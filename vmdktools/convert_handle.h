@@ -0,0 +1,231 @@
+/*
+ * Convert handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _CONVERT_HANDLE_H )
+#define _CONVERT_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vmdktools_libbfio.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default process buffer size, a multiple of the grain size
+ */
+#define CONVERT_HANDLE_DEFAULT_PROCESS_BUFFER_SIZE	( 8 * 1024 * 1024 )
+
+/* The size of the blocks that are checked for 0-byte values, which is the grain size
+ */
+#define CONVERT_HANDLE_BLOCK_SIZE			( 64 * 1024 )
+
+/* The default number of threads used to compress stream-optimized output
+ */
+#define CONVERT_HANDLE_DEFAULT_NUMBER_OF_THREADS	4
+
+/* The maximum number of threads supported by the stream writer
+ */
+#define CONVERT_HANDLE_MAXIMUM_NUMBER_OF_THREADS	64
+
+enum CONVERT_HANDLE_INPUT_FORMATS
+{
+	CONVERT_HANDLE_INPUT_FORMAT_AUTO,
+	CONVERT_HANDLE_INPUT_FORMAT_RAW,
+	CONVERT_HANDLE_INPUT_FORMAT_VMDK
+};
+
+enum CONVERT_HANDLE_OUTPUT_FORMATS
+{
+	CONVERT_HANDLE_OUTPUT_FORMAT_FLAT,
+	CONVERT_HANDLE_OUTPUT_FORMAT_RAW,
+	CONVERT_HANDLE_OUTPUT_FORMAT_SPARSE,
+	CONVERT_HANDLE_OUTPUT_FORMAT_SPLIT_SPARSE,
+	CONVERT_HANDLE_OUTPUT_FORMAT_STREAM_OPTIMIZED
+};
+
+typedef struct convert_handle convert_handle_t;
+
+struct convert_handle
+{
+	/* The input format
+	 */
+	int input_format;
+
+	/* The output format
+	 */
+	int output_format;
+
+	/* The number of threads used to compress stream-optimized output
+	 */
+	int number_of_threads;
+
+	/* The basename
+	 */
+	system_character_t *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
+	/* The input handles array
+	 * The first entry contains the input handle followed by its parents
+	 */
+	libcdata_array_t *input_handles_array;
+
+	/* The input handle
+	 */
+	libvmdk_handle_t *input_handle;
+
+	/* The raw input file IO handle
+	 */
+	libbfio_handle_t *input_file_io_handle;
+
+	/* The output handle
+	 */
+	libvmdk_handle_t *output_handle;
+
+	/* The stream-optimized output stream writer
+	 */
+	libvmdk_stream_writer_t *output_stream_writer;
+
+	/* The raw or flat extent output file IO handle
+	 */
+	libbfio_handle_t *output_file_io_handle;
+
+	/* Value to indicate the output is open
+	 */
+	int output_is_open;
+
+	/* The end offset of the data written to the raw or flat extent output
+	 */
+	off64_t output_end_offset;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The process buffer size
+	 */
+	size_t process_buffer_size;
+
+	/* The number of bytes copied
+	 */
+	size64_t copied_size;
+
+	/* The number of bytes that were not written since they were sparse
+	 */
+	size64_t sparse_size;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int convert_handle_initialize(
+     convert_handle_t **convert_handle,
+     libcerror_error_t **error );
+
+int convert_handle_free(
+     convert_handle_t **convert_handle,
+     libcerror_error_t **error );
+
+int convert_handle_signal_abort(
+     convert_handle_t *convert_handle,
+     libcerror_error_t **error );
+
+int convert_handle_set_input_format(
+     convert_handle_t *convert_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int convert_handle_set_output_format(
+     convert_handle_t *convert_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int convert_handle_set_number_of_threads(
+     convert_handle_t *convert_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int convert_handle_open_input(
+     convert_handle_t *convert_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int convert_handle_open_input_parent_handle(
+     convert_handle_t *convert_handle,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error );
+
+int convert_handle_open_raw_input(
+     convert_handle_t *convert_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int convert_handle_open_output(
+     convert_handle_t *convert_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int convert_handle_write_flat_descriptor(
+     convert_handle_t *convert_handle,
+     const system_character_t *filename,
+     const system_character_t *extent_basename,
+     libcerror_error_t **error );
+
+int convert_handle_close(
+     convert_handle_t *convert_handle,
+     libcerror_error_t **error );
+
+ssize_t convert_handle_write_buffer_at_offset(
+         convert_handle_t *convert_handle,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int convert_handle_convert(
+     convert_handle_t *convert_handle,
+     libcerror_error_t **error );
+
+int convert_handle_set_basename(
+     convert_handle_t *convert_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _CONVERT_HANDLE_H ) */
+
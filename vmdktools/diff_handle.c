@@ -0,0 +1,1294 @@
+/*
+ * Diff handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "diff_handle.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcpath.h"
+#include "vmdktools_libvmdk.h"
+
+#define DIFF_HANDLE_NOTIFY_STREAM		stdout
+
+/* Creates a diff handle
+ * Make sure the value diff_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_initialize(
+     diff_handle_t **diff_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "diff_handle_initialize";
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *diff_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid diff handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*diff_handle = memory_allocate_structure(
+	               diff_handle_t );
+
+	if( *diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create diff handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *diff_handle,
+	     0,
+	     sizeof( diff_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear diff handle.",
+		 function );
+
+		memory_free(
+		 *diff_handle );
+
+		*diff_handle = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *diff_handle )->input_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handles array.",
+		 function );
+
+		goto on_error;
+	}
+	( *diff_handle )->notify_stream = DIFF_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *diff_handle != NULL )
+	{
+		if( ( *diff_handle )->input_handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *diff_handle )->input_handles_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *diff_handle );
+
+		*diff_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a diff handle
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_free(
+     diff_handle_t **diff_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "diff_handle_free";
+	int result            = 1;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *diff_handle != NULL )
+	{
+		if( ( *diff_handle )->basename != NULL )
+		{
+			memory_free(
+			 ( *diff_handle )->basename );
+		}
+		if( libcdata_array_free(
+		     &( ( *diff_handle )->input_handles_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handles array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *diff_handle );
+
+		*diff_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the diff handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_signal_abort(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "diff_handle_signal_abort";
+	int input_handle_index         = 0;
+	int number_of_input_handles    = 0;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	diff_handle->abort = 1;
+
+	if( libcdata_array_get_number_of_entries(
+	     diff_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( input_handle_index = 0;
+	     input_handle_index < number_of_input_handles;
+	     input_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     diff_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		if( libvmdk_handle_signal_abort(
+		     input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle: %d to abort.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the basename
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_set_basename(
+     diff_handle_t *diff_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "diff_handle_set_basename";
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing basename.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( basename_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * basename_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid basename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( diff_handle->basename != NULL )
+	{
+		memory_free(
+		 diff_handle->basename );
+
+		diff_handle->basename      = NULL;
+		diff_handle->basename_size = 0;
+	}
+	diff_handle->basename = system_string_allocate(
+	                        basename_size );
+
+	if( diff_handle->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     diff_handle->basename,
+	     basename,
+	     basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy basename.",
+		 function );
+
+		goto on_error;
+	}
+	diff_handle->basename[ basename_size - 1 ] = 0;
+
+	diff_handle->basename_size = basename_size;
+
+	return( 1 );
+
+on_error:
+	if( diff_handle->basename != NULL )
+	{
+		memory_free(
+		 diff_handle->basename );
+
+		diff_handle->basename = NULL;
+	}
+	diff_handle->basename_size = 0;
+
+	return( -1 );
+}
+
+/* Opens an input of the diff handle
+ * The input is opened together with its parents using the parent filename hints
+ * Returns 1 if successful, 0 if disk type is not supported or -1 on error
+ */
+int diff_handle_open_input(
+     diff_handle_t *diff_handle,
+     const system_character_t *filename,
+     libvmdk_handle_t **input_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *safe_input_handle = NULL;
+	system_character_t *basename_end    = NULL;
+	static char *function               = "diff_handle_open_input";
+	size_t basename_length              = 0;
+	size_t filename_length              = 0;
+	uint32_t parent_content_identifier  = 0;
+	int disk_type                       = 0;
+	int entry_index                     = 0;
+	int result                          = 0;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input handle.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	basename_end = system_string_search_character_reverse(
+	                filename,
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
+
+	if( basename_end != NULL )
+	{
+		basename_length = (size_t) ( basename_end - filename ) + 1;
+	}
+	if( basename_length > 0 )
+	{
+		if( diff_handle_set_basename(
+		     diff_handle,
+		     filename,
+		     basename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else if( diff_handle->basename != NULL )
+	{
+		memory_free(
+		 diff_handle->basename );
+
+		diff_handle->basename      = NULL;
+		diff_handle->basename_size = 0;
+	}
+	if( libvmdk_handle_initialize(
+	     &safe_input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     safe_input_handle,
+	     filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     safe_input_handle,
+	     filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The input handle is appended before its parents so that the parents
+	 * are freed after the handles that refer to them
+	 */
+	if( libcdata_array_append_entry(
+	     diff_handle->input_handles_array,
+	     &entry_index,
+	     (intptr_t *) safe_input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append input handle to array.",
+		 function );
+
+		goto on_error;
+	}
+	*input_handle = safe_input_handle;
+
+	safe_input_handle = NULL;
+
+	if( libvmdk_handle_get_disk_type(
+	     *input_handle,
+	     &disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( disk_type != LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	{
+		/* Unsupported disk type
+		 */
+		return( 0 );
+	}
+	result = libvmdk_handle_get_parent_content_identifier(
+		  *input_handle,
+		  &parent_content_identifier,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		result = diff_handle_open_input_parent_handle(
+		          diff_handle,
+		          *input_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     *input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( safe_input_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &safe_input_handle,
+		 NULL );
+	}
+	/* The input handles array also contains the handles of the other input
+	 */
+	libcdata_array_empty(
+	 diff_handle->input_handles_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+	 NULL );
+
+	diff_handle->input_handle       = NULL;
+	diff_handle->other_input_handle = NULL;
+
+	*input_handle = NULL;
+
+	return( -1 );
+}
+
+/* Opens the inputs of the diff handle
+ * Returns 1 if successful, 0 if disk type is not supported or -1 on error
+ */
+int diff_handle_open_inputs(
+     diff_handle_t *diff_handle,
+     const system_character_t *filename,
+     const system_character_t *other_filename,
+     libcerror_error_t **error )
+{
+	static char *function = "diff_handle_open_inputs";
+	int result            = 0;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( diff_handle->input_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid diff handle - input handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	result = diff_handle_open_input(
+	          diff_handle,
+	          filename,
+	          &( diff_handle->input_handle ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		return( 0 );
+	}
+	result = diff_handle_open_input(
+	          diff_handle,
+	          other_filename,
+	          &( diff_handle->other_input_handle ),
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open other input: %" PRIs_SYSTEM ".",
+		 function,
+		 other_filename );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Opens the parent input handle
+ * Returns 1 if successful, 0 if no parent or -1 on error
+ */
+int diff_handle_open_input_parent_handle(
+     diff_handle_t *diff_handle,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_input_handle = NULL;
+	system_character_t *parent_filename   = NULL;
+	system_character_t *parent_path       = NULL;
+	static char *function                 = "diff_handle_open_input_parent_handle";
+	size_t parent_filename_size           = 0;
+	size_t parent_path_size               = 0;
+	uint32_t parent_content_identifier    = 0;
+	int entry_index                       = 0;
+	int parent_disk_type                  = 0;
+	int result                            = 0;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_filename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_filename_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * parent_filename_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid parent filename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+			   parent_filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename(
+		  input_handle,
+		  (uint16_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename(
+		  input_handle,
+		  (uint8_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( diff_handle->basename == NULL )
+	{
+		parent_path      = parent_filename;
+		parent_path_size = parent_filename_size;
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &parent_path,
+		     &parent_path_size,
+		     diff_handle->basename,
+		     diff_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &parent_path,
+		     &parent_path_size,
+		     diff_handle->basename,
+		     diff_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &parent_input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent input handle: %" PRIs_SYSTEM ".",
+		 function,
+		 parent_path );
+
+		goto on_error;
+	}
+	if( parent_path != NULL )
+	{
+		if( diff_handle->basename != NULL )
+		{
+			memory_free(
+			 parent_path );
+		}
+		parent_path = NULL;
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+
+		parent_filename = NULL;
+	}
+	if( libvmdk_handle_get_disk_type(
+	     parent_input_handle,
+	     &parent_disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	{
+		result = libvmdk_handle_get_parent_content_identifier(
+			  parent_input_handle,
+			  &parent_content_identifier,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent content identifier.",
+			 function );
+
+			goto on_error;
+		}
+		else if( ( result != 0 )
+		      && ( parent_content_identifier != 0xffffffffUL ) )
+		{
+			result = diff_handle_open_input_parent_handle(
+				  diff_handle,
+				  parent_input_handle,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open parent input handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			result = 1;
+		}
+	}
+	else
+	{
+		/* Unsupported disk type
+		 */
+		result = 0;
+	}
+	if( result != 0 )
+	{
+		if( libvmdk_handle_open_extent_data_files(
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent extent data files.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_set_parent_handle(
+		     input_handle,
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     diff_handle->input_handles_array,
+		     &entry_index,
+		     (intptr_t *) parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append parent input handle to array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libvmdk_handle_close(
+		     parent_input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_free(
+		     &parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( parent_input_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &parent_input_handle,
+		 NULL );
+	}
+	if( ( parent_path != NULL )
+	 && ( diff_handle->basename != NULL ) )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+/* Closes the diff handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int diff_handle_close(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "diff_handle_close";
+	int input_handle_index         = 0;
+	int number_of_input_handles    = 0;
+	int result                     = 0;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     diff_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	/* Close the delta disks before their parents
+	 */
+	for( input_handle_index = 0;
+	     input_handle_index < number_of_input_handles;
+	     input_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     diff_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		if( libvmdk_handle_close(
+		     input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Prints the ranges of the media data that differ between the inputs
+ * Returns 1 if successful or -1 on error
+ */
+int diff_handle_changed_ranges_fprint(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error )
+{
+	static char *function      = "diff_handle_changed_ranges_fprint";
+	size64_t changed_data_size = 0;
+	size64_t media_size        = 0;
+	size64_t other_media_size  = 0;
+	size64_t range_size        = 0;
+	off64_t offset             = 0;
+	off64_t range_offset       = 0;
+	uint64_t number_of_ranges  = 0;
+	int result                 = 0;
+
+	if( diff_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid diff handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     diff_handle->input_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     diff_handle->other_input_handle,
+	     &other_media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve other media size.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 diff_handle->notify_stream,
+	 "Media size\t\t\t: %" PRIu64 " bytes\n",
+	 media_size );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "Other media size\t\t: %" PRIu64 " bytes\n",
+	 other_media_size );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\n" );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "Changed ranges:\n" );
+
+	do
+	{
+		if( diff_handle->abort != 0 )
+		{
+			return( -1 );
+		}
+		result = libvmdk_handle_get_next_changed_range(
+		          diff_handle->input_handle,
+		          diff_handle->other_input_handle,
+		          offset,
+		          &range_offset,
+		          &range_size,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve next changed range at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( result != 0 )
+		{
+			fprintf(
+			 diff_handle->notify_stream,
+			 "\tat offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIu64 " bytes\n",
+			 range_offset,
+			 range_offset,
+			 range_size );
+
+			changed_data_size += range_size;
+			number_of_ranges  += 1;
+
+			offset = range_offset + (off64_t) range_size;
+		}
+	}
+	while( result != 0 );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\n" );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "Number of changed ranges\t: %" PRIu64 "\n",
+	 number_of_ranges );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "Changed data size\t\t: %" PRIu64 " bytes\n",
+	 changed_data_size );
+
+	fprintf(
+	 diff_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
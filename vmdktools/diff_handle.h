@@ -0,0 +1,119 @@
+/*
+ * Diff handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _DIFF_HANDLE_H )
+#define _DIFF_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct diff_handle diff_handle_t;
+
+struct diff_handle
+{
+	/* The basename
+	 */
+	system_character_t *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
+	/* The input handles array
+	 * Contains the input handles followed by their parents
+	 */
+	libcdata_array_t *input_handles_array;
+
+	/* The input handle
+	 */
+	libvmdk_handle_t *input_handle;
+
+	/* The other input handle
+	 */
+	libvmdk_handle_t *other_input_handle;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int diff_handle_initialize(
+     diff_handle_t **diff_handle,
+     libcerror_error_t **error );
+
+int diff_handle_free(
+     diff_handle_t **diff_handle,
+     libcerror_error_t **error );
+
+int diff_handle_signal_abort(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error );
+
+int diff_handle_set_basename(
+     diff_handle_t *diff_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error );
+
+int diff_handle_open_input(
+     diff_handle_t *diff_handle,
+     const system_character_t *filename,
+     libvmdk_handle_t **input_handle,
+     libcerror_error_t **error );
+
+int diff_handle_open_inputs(
+     diff_handle_t *diff_handle,
+     const system_character_t *filename,
+     const system_character_t *other_filename,
+     libcerror_error_t **error );
+
+int diff_handle_open_input_parent_handle(
+     diff_handle_t *diff_handle,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error );
+
+int diff_handle_close(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error );
+
+int diff_handle_changed_ranges_fprint(
+     diff_handle_t *diff_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _DIFF_HANDLE_H ) */
+
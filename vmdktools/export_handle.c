@@ -0,0 +1,2394 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/* copy_file_range and splice are GNU extensions
+ */
+#if !defined( _GNU_SOURCE )
+#define _GNU_SOURCE 1
+#endif
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_FCNTL_H ) || defined( WINAPI )
+#include <fcntl.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+#include <io.h>
+#endif
+
+#include "export_handle.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcpath.h"
+#include "vmdktools_libvmdk.h"
+
+#define EXPORT_HANDLE_NOTIFY_STREAM		stderr
+
+/* Creates a export handle
+ * Make sure the value export_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_initialize";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*export_handle = memory_allocate_structure(
+	                 export_handle_t );
+
+	if( *export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *export_handle,
+	     0,
+	     sizeof( export_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export handle.",
+		 function );
+
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *export_handle )->input_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handles array.",
+		 function );
+
+		goto on_error;
+	}
+	( *export_handle )->use_copy_offload    = 1;
+	( *export_handle )->process_buffer_size = EXPORT_HANDLE_DEFAULT_PROCESS_BUFFER_SIZE;
+	( *export_handle )->notify_stream       = EXPORT_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->input_handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *export_handle )->input_handles_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a export handle
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_free";
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export_handle != NULL )
+	{
+		if( ( *export_handle )->basename != NULL )
+		{
+			memory_free(
+			 ( *export_handle )->basename );
+		}
+		if( ( *export_handle )->flat_extents != NULL )
+		{
+			if( export_handle_close_flat_extents(
+			     *export_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close flat extents.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( libcdata_array_free(
+		     &( ( *export_handle )->input_handles_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handles array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *export_handle );
+
+		*export_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the export handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "export_handle_signal_abort";
+	int input_handle_index         = 0;
+	int number_of_input_handles    = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->abort = 1;
+
+	if( libcdata_array_get_number_of_entries(
+	     export_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( input_handle_index = 0;
+	     input_handle_index < number_of_input_handles;
+	     input_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     export_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		if( libvmdk_handle_signal_abort(
+		     input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle: %d to abort.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Opens the input of the export handle
+ * The input is opened together with its parents using the parent filename hints
+ * Returns 1 if successful, 0 if disk type is not supported or -1 on error
+ */
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle     = NULL;
+	system_character_t *basename_end   = NULL;
+	static char *function              = "export_handle_open_input";
+	size_t basename_length             = 0;
+	size_t filename_length             = 0;
+	uint32_t parent_content_identifier = 0;
+	int disk_type                      = 0;
+	int entry_index                    = 0;
+	int result                         = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	basename_end = system_string_search_character_reverse(
+	                filename,
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
+
+	if( basename_end != NULL )
+	{
+		basename_length = (size_t) ( basename_end - filename ) + 1;
+	}
+	if( basename_length > 0 )
+	{
+		if( export_handle_set_basename(
+		     export_handle,
+		     filename,
+		     basename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     input_handle,
+	     filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     input_handle,
+	     filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The input handle is the first entry in the array so that the parents
+	 * are freed after the handles that refer to them
+	 */
+	if( libcdata_array_append_entry(
+	     export_handle->input_handles_array,
+	     &entry_index,
+	     (intptr_t *) input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append input handle to array.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->input_handle = input_handle;
+
+	input_handle = NULL;
+
+	if( libvmdk_handle_get_disk_type(
+	     export_handle->input_handle,
+	     &disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( disk_type != LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	{
+		/* Unsupported disk type
+		 */
+		return( 0 );
+	}
+	result = libvmdk_handle_get_parent_content_identifier(
+		  export_handle->input_handle,
+		  &parent_content_identifier,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		result = export_handle_open_input_parent_handle(
+		          export_handle,
+		          export_handle->input_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     export_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_get_media_size(
+	     export_handle->input_handle,
+	     &( export_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->use_copy_offload != 0 )
+	{
+		if( export_handle_open_flat_extents(
+		     export_handle,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open flat extents.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( 1 );
+
+on_error:
+	if( input_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &input_handle,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 export_handle->input_handles_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+	 NULL );
+
+	export_handle->input_handle = NULL;
+
+	return( -1 );
+}
+
+/* Opens the parent input handle
+ * Returns 1 if successful, 0 if no parent or -1 on error
+ */
+int export_handle_open_input_parent_handle(
+     export_handle_t *export_handle,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_input_handle = NULL;
+	system_character_t *parent_filename   = NULL;
+	system_character_t *parent_path       = NULL;
+	static char *function                 = "export_handle_open_input_parent_handle";
+	size_t parent_filename_size           = 0;
+	size_t parent_path_size               = 0;
+	uint32_t parent_content_identifier    = 0;
+	int entry_index                       = 0;
+	int parent_disk_type                  = 0;
+	int result                            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_filename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_filename_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * parent_filename_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid parent filename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+			   parent_filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename(
+		  input_handle,
+		  (uint16_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename(
+		  input_handle,
+		  (uint8_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->basename == NULL )
+	{
+		parent_path      = parent_filename;
+		parent_path_size = parent_filename_size;
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &parent_path,
+		     &parent_path_size,
+		     export_handle->basename,
+		     export_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &parent_path,
+		     &parent_path_size,
+		     export_handle->basename,
+		     export_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &parent_input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent input handle: %" PRIs_SYSTEM ".",
+		 function,
+		 parent_path );
+
+		goto on_error;
+	}
+	if( parent_path != NULL )
+	{
+		if( export_handle->basename != NULL )
+		{
+			memory_free(
+			 parent_path );
+		}
+		parent_path = NULL;
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+
+		parent_filename = NULL;
+	}
+	if( libvmdk_handle_get_disk_type(
+	     parent_input_handle,
+	     &parent_disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	{
+		result = libvmdk_handle_get_parent_content_identifier(
+			  parent_input_handle,
+			  &parent_content_identifier,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent content identifier.",
+			 function );
+
+			goto on_error;
+		}
+		else if( ( result != 0 )
+		      && ( parent_content_identifier != 0xffffffffUL ) )
+		{
+			result = export_handle_open_input_parent_handle(
+				  export_handle,
+				  parent_input_handle,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open parent input handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			result = 1;
+		}
+	}
+	else
+	{
+		/* Unsupported disk type
+		 */
+		result = 0;
+	}
+	if( result != 0 )
+	{
+		if( libvmdk_handle_open_extent_data_files(
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent extent data files.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_set_parent_handle(
+		     input_handle,
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     export_handle->input_handles_array,
+		     &entry_index,
+		     (intptr_t *) parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append parent input handle to array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libvmdk_handle_close(
+		     parent_input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_free(
+		     &parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( parent_input_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &parent_input_handle,
+		 NULL );
+	}
+	if( ( parent_path != NULL )
+	 && ( export_handle->basename != NULL ) )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+/* Opens the flat extents of the input for copy offload
+ * Copy offload is only used when the input has no parents, since the data of
+ * a delta disk needs to be resolved by the library, extents that are not flat
+ * are marked as not supporting copy offload
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int export_handle_open_flat_extents(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+#if defined( EXPORT_HANDLE_HAVE_COPY_OFFLOAD )
+	libvmdk_extent_descriptor_t *extent_descriptor = NULL;
+	export_handle_flat_extent_t *flat_extent       = NULL;
+	char *extent_filename                          = NULL;
+	char *extent_filename_start                    = NULL;
+	char *extent_path                              = NULL;
+	size64_t extent_size                           = 0;
+	size_t extent_filename_size                    = 0;
+	size_t extent_path_size                        = 0;
+	off64_t extent_offset                          = 0;
+	off64_t media_offset                           = 0;
+	int extent_index                               = 0;
+	int extent_type                                = 0;
+	int number_of_extents                          = 0;
+	int number_of_input_handles                    = 0;
+#endif
+	static char *function                          = "export_handle_open_flat_extents";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->flat_extents != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - flat extents value already set.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( EXPORT_HANDLE_HAVE_COPY_OFFLOAD )
+	if( libcdata_array_get_number_of_entries(
+	     export_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( number_of_input_handles != 1 )
+	{
+		return( 0 );
+	}
+	if( libvmdk_handle_get_number_of_extents(
+	     export_handle->input_handle,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( number_of_extents <= 0 )
+	 || ( (size_t) number_of_extents > ( (size_t) SSIZE_MAX / sizeof( export_handle_flat_extent_t ) ) ) )
+	{
+		return( 0 );
+	}
+	export_handle->flat_extents = (export_handle_flat_extent_t *) memory_allocate(
+	                                                               sizeof( export_handle_flat_extent_t ) * number_of_extents );
+
+	if( export_handle->flat_extents == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create flat extents.",
+		 function );
+
+		goto on_error;
+	}
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		export_handle->flat_extents[ extent_index ].media_offset    = 0;
+		export_handle->flat_extents[ extent_index ].file_offset     = 0;
+		export_handle->flat_extents[ extent_index ].size            = 0;
+		export_handle->flat_extents[ extent_index ].file_descriptor = -1;
+	}
+	export_handle->number_of_flat_extents = number_of_extents;
+
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		flat_extent = &( export_handle->flat_extents[ extent_index ] );
+
+		if( libvmdk_handle_get_extent_descriptor(
+		     export_handle->input_handle,
+		     extent_index,
+		     &extent_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent descriptor: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_descriptor_get_type(
+		     extent_descriptor,
+		     &extent_type,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d type.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		if( libvmdk_extent_descriptor_get_range(
+		     extent_descriptor,
+		     &extent_offset,
+		     &extent_size,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d range.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		flat_extent->media_offset = media_offset;
+		flat_extent->file_offset  = extent_offset;
+		flat_extent->size         = extent_size;
+
+		if( ( extent_type == LIBVMDK_EXTENT_TYPE_FLAT )
+		 || ( extent_type == LIBVMDK_EXTENT_TYPE_VMFS_FLAT ) )
+		{
+			if( libvmdk_extent_descriptor_get_utf8_filename_size(
+			     extent_descriptor,
+			     &extent_filename_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent: %d filename size.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			if( ( extent_filename_size == 0 )
+			 || ( extent_filename_size > (size_t) SSIZE_MAX ) )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+				 "%s: invalid extent: %d filename size value out of bounds.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			extent_filename = narrow_string_allocate(
+			                   extent_filename_size );
+
+			if( extent_filename == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create extent filename.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_extent_descriptor_get_utf8_filename(
+			     extent_descriptor,
+			     (uint8_t *) extent_filename,
+			     extent_filename_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve extent: %d filename.",
+				 function,
+				 extent_index );
+
+				goto on_error;
+			}
+			/* The extent data file is looked up in the directory of the descriptor
+			 * file in the same way the library opens the extent data files
+			 */
+			extent_filename_start = narrow_string_search_character_reverse(
+			                         extent_filename,
+			                         (int) LIBCPATH_SEPARATOR,
+			                         extent_filename_size );
+
+			if( extent_filename_start != NULL )
+			{
+				extent_filename_start++;
+			}
+			else
+			{
+				extent_filename_start = extent_filename;
+			}
+			if( export_handle->basename == NULL )
+			{
+				extent_path = extent_filename_start;
+			}
+			else
+			{
+				if( libcpath_path_join(
+				     &extent_path,
+				     &extent_path_size,
+				     export_handle->basename,
+				     export_handle->basename_size - 1,
+				     extent_filename_start,
+				     narrow_string_length(
+				      extent_filename_start ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+					 "%s: unable to create extent: %d path.",
+					 function,
+					 extent_index );
+
+					goto on_error;
+				}
+			}
+			/* If the extent data file cannot be opened its data is read through the library
+			 */
+			flat_extent->file_descriptor = open(
+			                                extent_path,
+			                                O_RDONLY );
+
+			if( export_handle->basename != NULL )
+			{
+				memory_free(
+				 extent_path );
+			}
+			extent_path = NULL;
+
+			memory_free(
+			 extent_filename );
+
+			extent_filename = NULL;
+		}
+		if( libvmdk_extent_descriptor_free(
+		     &extent_descriptor,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free extent descriptor: %d.",
+			 function,
+			 extent_index );
+
+			goto on_error;
+		}
+		media_offset += (off64_t) extent_size;
+	}
+	return( 1 );
+
+on_error:
+	if( ( extent_path != NULL )
+	 && ( export_handle->basename != NULL ) )
+	{
+		memory_free(
+		 extent_path );
+	}
+	if( extent_filename != NULL )
+	{
+		memory_free(
+		 extent_filename );
+	}
+	if( extent_descriptor != NULL )
+	{
+		libvmdk_extent_descriptor_free(
+		 &extent_descriptor,
+		 NULL );
+	}
+	if( export_handle->flat_extents != NULL )
+	{
+		export_handle_close_flat_extents(
+		 export_handle,
+		 NULL );
+	}
+	return( -1 );
+#else
+	return( 0 );
+#endif /* defined( EXPORT_HANDLE_HAVE_COPY_OFFLOAD ) */
+}
+
+/* Closes the flat extents
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_close_flat_extents(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_close_flat_extents";
+	int extent_index      = 0;
+	int result            = 1;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->flat_extents == NULL )
+	{
+		return( 1 );
+	}
+	for( extent_index = 0;
+	     extent_index < export_handle->number_of_flat_extents;
+	     extent_index++ )
+	{
+#if defined( EXPORT_HANDLE_HAVE_COPY_OFFLOAD )
+		if( export_handle->flat_extents[ extent_index ].file_descriptor != -1 )
+		{
+			if( close(
+			     export_handle->flat_extents[ extent_index ].file_descriptor ) != 0 )
+			{
+				libcerror_system_set_error(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 errno,
+				 "%s: unable to close flat extent: %d file descriptor.",
+				 function,
+				 extent_index );
+
+				result = -1;
+			}
+		}
+#endif
+		export_handle->flat_extents[ extent_index ].file_descriptor = -1;
+	}
+	memory_free(
+	 export_handle->flat_extents );
+
+	export_handle->flat_extents           = NULL;
+	export_handle->number_of_flat_extents = 0;
+
+	return( result );
+}
+
+/* Opens the output of the export handle
+ * The filename "-" refers to stdout
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_open_output(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_open_output";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_stream != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export handle - output stream value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( filename[ 0 ] == (system_character_t) '-' )
+	 && ( filename[ 1 ] == 0 ) )
+	{
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+		if( _setmode(
+		     _fileno(
+		      stdout ),
+		     _O_BINARY ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to set stdout to binary mode.",
+			 function );
+
+			return( -1 );
+		}
+#endif
+		export_handle->output_stream    = stdout;
+		export_handle->output_is_stdout = 1;
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		export_handle->output_stream = file_stream_open_wide(
+		                                filename,
+		                                _SYSTEM_STRING( FILE_STREAM_BINARY_OPEN_WRITE ) );
+#else
+		export_handle->output_stream = file_stream_open(
+		                                filename,
+		                                FILE_STREAM_BINARY_OPEN_WRITE );
+#endif
+		if( export_handle->output_stream == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open output file: %" PRIs_SYSTEM ".",
+			 function,
+			 filename );
+
+			return( -1 );
+		}
+		export_handle->output_is_stdout = 0;
+	}
+	/* A pipe cannot be seeked, in which case the sparse ranges are written as 0-byte values
+	 */
+	if( file_stream_seek_offset(
+	     export_handle->output_stream,
+	     0,
+	     SEEK_SET ) == 0 )
+	{
+		export_handle->output_is_seekable = 1;
+	}
+	else
+	{
+		export_handle->output_is_seekable = 0;
+	}
+	export_handle->output_offset     = 0;
+	export_handle->output_end_offset = 0;
+
+	return( 1 );
+}
+
+/* Closes the export handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int export_handle_close(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "export_handle_close";
+	int input_handle_index         = 0;
+	int number_of_input_handles    = 0;
+	int result                     = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_stream != NULL )
+	{
+		if( export_handle->output_is_stdout != 0 )
+		{
+			if( fflush(
+			     export_handle->output_stream ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush stdout.",
+				 function );
+
+				result = -1;
+			}
+		}
+		else if( file_stream_close(
+		          export_handle->output_stream ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close output stream.",
+			 function );
+
+			result = -1;
+		}
+		export_handle->output_stream = NULL;
+	}
+	if( export_handle_close_flat_extents(
+	     export_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close flat extents.",
+		 function );
+
+		result = -1;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     export_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	/* Close the delta disks before their parents
+	 */
+	for( input_handle_index = 0;
+	     input_handle_index < number_of_input_handles;
+	     input_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     export_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		if( libvmdk_handle_close(
+		     input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Seeks a specific offset in the output
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_seek_output_offset(
+     export_handle_t *export_handle,
+     off64_t offset,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_seek_output_offset";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset == export_handle->output_offset )
+	{
+		return( 1 );
+	}
+	if( export_handle->output_is_seekable == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in output that is not seekable.",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	if( file_stream_seek_offset(
+	     export_handle->output_stream,
+	     offset,
+	     SEEK_SET ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in output stream.",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	export_handle->output_offset = offset;
+
+	return( 1 );
+}
+
+/* Writes a buffer at a specific offset to the output
+ * Returns the number of bytes written or -1 on error
+ */
+ssize_t export_handle_write_buffer_at_offset(
+         export_handle_t *export_handle,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	static char *function = "export_handle_write_buffer_at_offset";
+	size_t write_count    = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( buffer_size > (size_t) SSIZE_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid buffer size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle_seek_output_offset(
+	     export_handle,
+	     offset,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_SEEK_FAILED,
+		 "%s: unable to seek offset: %" PRIi64 " in output.",
+		 function,
+		 offset );
+
+		return( -1 );
+	}
+	write_count = file_stream_write(
+	               export_handle->output_stream,
+	               buffer,
+	               buffer_size );
+
+	if( write_count != buffer_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer to output stream.",
+		 function );
+
+		return( -1 );
+	}
+	export_handle->output_offset += (off64_t) buffer_size;
+
+	if( export_handle->output_end_offset < export_handle->output_offset )
+	{
+		export_handle->output_end_offset = export_handle->output_offset;
+	}
+	return( (ssize_t) buffer_size );
+}
+
+/* Copies data of a flat extent at a specific offset to the output using kernel copy offload
+ * The data is copied with copy_file_range when the output is seekable and with
+ * splice when the output is a pipe, without passing through the process buffer
+ * At most the data up to the end of the flat extent is copied
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int export_handle_copy_offload_at_offset(
+     export_handle_t *export_handle,
+     off64_t offset,
+     size64_t size,
+     size64_t *copied_size,
+     libcerror_error_t **error )
+{
+#if defined( EXPORT_HANDLE_HAVE_COPY_OFFLOAD )
+	export_handle_flat_extent_t *flat_extent = NULL;
+	size_t copy_size                         = 0;
+	ssize_t copy_count                       = 0;
+	off_t input_offset                       = 0;
+	int extent_index                         = 0;
+	int output_file_descriptor               = 0;
+
+#if defined( HAVE_COPY_FILE_RANGE )
+	off_t output_offset                      = 0;
+#endif
+#endif
+	static char *function                    = "export_handle_copy_offload_at_offset";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( copied_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid copied size.",
+		 function );
+
+		return( -1 );
+	}
+	*copied_size = 0;
+
+#if defined( EXPORT_HANDLE_HAVE_COPY_OFFLOAD )
+	if( ( export_handle->use_copy_offload == 0 )
+	 || ( export_handle->flat_extents == NULL ) )
+	{
+		return( 0 );
+	}
+#if !defined( HAVE_COPY_FILE_RANGE )
+	if( export_handle->output_is_seekable != 0 )
+	{
+		return( 0 );
+	}
+#endif
+#if !defined( HAVE_SPLICE )
+	if( export_handle->output_is_seekable == 0 )
+	{
+		return( 0 );
+	}
+#endif
+	for( extent_index = 0;
+	     extent_index < export_handle->number_of_flat_extents;
+	     extent_index++ )
+	{
+		flat_extent = &( export_handle->flat_extents[ extent_index ] );
+
+		if( ( offset >= flat_extent->media_offset )
+		 && ( (size64_t) ( offset - flat_extent->media_offset ) < flat_extent->size ) )
+		{
+			break;
+		}
+		flat_extent = NULL;
+	}
+	if( ( flat_extent == NULL )
+	 || ( flat_extent->file_descriptor == -1 ) )
+	{
+		return( 0 );
+	}
+	if( size > ( flat_extent->size - (size64_t) ( offset - flat_extent->media_offset ) ) )
+	{
+		size = flat_extent->size - (size64_t) ( offset - flat_extent->media_offset );
+	}
+	/* The data written through the output stream must reach the file descriptor first
+	 */
+	if( fflush(
+	     export_handle->output_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush output stream.",
+		 function );
+
+		return( -1 );
+	}
+	output_file_descriptor = fileno(
+	                          export_handle->output_stream );
+
+	input_offset = (off_t) ( flat_extent->file_offset + ( offset - flat_extent->media_offset ) );
+
+	while( *copied_size < size )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		copy_size = export_handle->process_buffer_size;
+
+		if( (size64_t) copy_size > ( size - *copied_size ) )
+		{
+			copy_size = (size_t) ( size - *copied_size );
+		}
+		if( export_handle->output_is_seekable != 0 )
+		{
+#if defined( HAVE_COPY_FILE_RANGE )
+			/* copy_file_range does not change the offset of the output file descriptor
+			 */
+			output_offset = (off_t) ( offset + *copied_size );
+
+			copy_count = copy_file_range(
+			              flat_extent->file_descriptor,
+			              &input_offset,
+			              output_file_descriptor,
+			              &output_offset,
+			              copy_size,
+			              0 );
+#endif
+		}
+		else
+		{
+#if defined( HAVE_SPLICE )
+			copy_count = splice(
+			              flat_extent->file_descriptor,
+			              &input_offset,
+			              output_file_descriptor,
+			              NULL,
+			              copy_size,
+			              SPLICE_F_MORE );
+#endif
+		}
+		if( copy_count == -1 )
+		{
+			/* Fall back to copying through the process buffer if the file systems
+			 * or the kind of output do not support copy offload
+			 */
+			if( ( *copied_size == 0 )
+			 && ( ( errno == EXDEV )
+			  ||  ( errno == EINVAL )
+			  ||  ( errno == ENOSYS )
+#if defined( EOPNOTSUPP )
+			  ||  ( errno == EOPNOTSUPP )
+#endif
+			  ||  ( errno == EBADF ) ) )
+			{
+				export_handle->use_copy_offload = 0;
+
+				return( 0 );
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to copy flat extent: %d data at offset: %" PRIi64 " to output.",
+			 function,
+			 extent_index,
+			 offset + (off64_t) *copied_size );
+
+			return( -1 );
+		}
+		else if( copy_count == 0 )
+		{
+			/* The extent file is smaller than the extent, the remaining data is read through the library
+			 */
+			break;
+		}
+		*copied_size += (size64_t) copy_count;
+	}
+	if( *copied_size == 0 )
+	{
+		return( 0 );
+	}
+	if( export_handle->output_is_seekable != 0 )
+	{
+		/* Force the next write through the output stream to seek
+		 */
+		export_handle->output_offset = -1;
+	}
+	else
+	{
+		export_handle->output_offset += (off64_t) *copied_size;
+	}
+	if( export_handle->output_end_offset < ( offset + (off64_t) *copied_size ) )
+	{
+		export_handle->output_end_offset = offset + (off64_t) *copied_size;
+	}
+	export_handle->offloaded_size += *copied_size;
+
+	return( 1 );
+#else
+	return( 0 );
+#endif /* defined( EXPORT_HANDLE_HAVE_COPY_OFFLOAD ) */
+}
+
+/* Exports the input to the output
+ * Ranges of the input that are sparse in the grain tables of all the layers are
+ * not read, they are seeked over so the output stays sparse or, when the output
+ * is a pipe, written as 0-byte values
+ * The data of flat extents is copied using kernel copy offload when available,
+ * the other ranges, such as compressed grains or data that is not aligned to an
+ * extent, are streamed through a process buffer of a bounded size
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int export_handle_export(
+     export_handle_t *export_handle,
+     libcerror_error_t **error )
+{
+	uint8_t *buffer       = NULL;
+	static char *function = "export_handle_export";
+	size64_t copied_size  = 0;
+	size64_t range_size   = 0;
+	size_t read_size      = 0;
+	ssize_t read_count    = 0;
+	ssize_t write_count   = 0;
+	off64_t offset        = 0;
+	uint32_t range_flags  = 0;
+	int result            = 0;
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( export_handle->output_stream == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid export handle - missing output stream.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( export_handle->process_buffer_size == 0 )
+	 || ( export_handle->process_buffer_size > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid export handle - process buffer size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	buffer = (uint8_t *) memory_allocate(
+	                      sizeof( uint8_t ) * export_handle->process_buffer_size );
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create buffer.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->copied_size    = 0;
+	export_handle->offloaded_size = 0;
+	export_handle->sparse_size    = 0;
+
+	while( (size64_t) offset < export_handle->media_size )
+	{
+		if( export_handle->abort != 0 )
+		{
+			break;
+		}
+		result = libvmdk_handle_get_data_range_at_offset(
+		          export_handle->input_handle,
+		          offset,
+		          &range_size,
+		          &range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			goto on_error;
+		}
+		else if( ( result == 0 )
+		      || ( range_size == 0 ) )
+		{
+			break;
+		}
+		if( ( ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+		 && ( export_handle->output_is_seekable != 0 ) )
+		{
+			export_handle->sparse_size += range_size;
+
+			offset += (off64_t) range_size;
+
+			continue;
+		}
+		while( range_size > 0 )
+		{
+			if( export_handle->abort != 0 )
+			{
+				break;
+			}
+			if( ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) == 0 )
+			{
+				result = export_handle_copy_offload_at_offset(
+				          export_handle,
+				          offset,
+				          range_size,
+				          &copied_size,
+				          error );
+
+				if( result == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to copy data at offset: %" PRIi64 " to output.",
+					 function,
+					 offset );
+
+					goto on_error;
+				}
+				else if( result != 0 )
+				{
+					offset     += (off64_t) copied_size;
+					range_size -= copied_size;
+
+					continue;
+				}
+			}
+			/* Keep the reads and writes aligned to the process buffer size
+			 */
+			read_size = export_handle->process_buffer_size
+			          - (size_t) ( (size64_t) offset % export_handle->process_buffer_size );
+
+			if( (size64_t) read_size > range_size )
+			{
+				read_size = (size_t) range_size;
+			}
+			if( ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+			{
+				if( memory_set(
+				     buffer,
+				     0,
+				     read_size ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear buffer.",
+					 function );
+
+					goto on_error;
+				}
+				export_handle->sparse_size += read_size;
+			}
+			else
+			{
+				/* The data is read through the input handle which resolves
+				 * the grains of the delta disks before those of their parents
+				 */
+				read_count = libvmdk_handle_read_buffer_at_offset(
+				              export_handle->input_handle,
+				              buffer,
+				              read_size,
+				              offset,
+				              error );
+
+				if( read_count != (ssize_t) read_size )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read buffer at offset: %" PRIi64 " from input.",
+					 function,
+					 offset );
+
+					goto on_error;
+				}
+				export_handle->copied_size += read_size;
+			}
+			write_count = export_handle_write_buffer_at_offset(
+			               export_handle,
+			               buffer,
+			               read_size,
+			               offset,
+			               error );
+
+			if( write_count != (ssize_t) read_size )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write buffer at offset: %" PRIi64 " to output.",
+				 function,
+				 offset );
+
+				goto on_error;
+			}
+			offset     += (off64_t) read_size;
+			range_size -= read_size;
+		}
+	}
+	memory_free(
+	 buffer );
+
+	buffer = NULL;
+
+	if( export_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	/* Write the last byte so the output has the size of the media when it ends with a sparse range
+	 */
+	if( (size64_t) export_handle->output_end_offset < export_handle->media_size )
+	{
+		offset = (off64_t) export_handle->media_size - 1;
+
+		write_count = export_handle_write_buffer_at_offset(
+		               export_handle,
+		               (uint8_t *) "",
+		               1,
+		               offset,
+		               error );
+
+		if( write_count != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write last byte to output.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( fflush(
+	     export_handle->output_stream ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to flush output stream.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->notify_stream != NULL )
+	{
+		fprintf(
+		 export_handle->notify_stream,
+		 "Copied: %" PRIu64 " bytes, copy offloaded: %" PRIu64 " bytes, sparse: %" PRIu64 " bytes.\n",
+		 export_handle->copied_size,
+		 export_handle->offloaded_size,
+		 export_handle->sparse_size );
+	}
+	return( 1 );
+
+on_error:
+	if( buffer != NULL )
+	{
+		memory_free(
+		 buffer );
+	}
+	return( -1 );
+}
+
+/* Sets the basename
+ * Returns 1 if successful or -1 on error
+ */
+int export_handle_set_basename(
+     export_handle_t *export_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "export_handle_set_basename";
+
+	if( export_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing basename.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( basename_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * basename_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid basename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( export_handle->basename != NULL )
+	{
+		memory_free(
+		 export_handle->basename );
+
+		export_handle->basename      = NULL;
+		export_handle->basename_size = 0;
+	}
+	export_handle->basename = system_string_allocate(
+	                          basename_size );
+
+	if( export_handle->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     export_handle->basename,
+	     basename,
+	     basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy basename.",
+		 function );
+
+		goto on_error;
+	}
+	export_handle->basename[ basename_size - 1 ] = 0;
+
+	export_handle->basename_size = basename_size;
+
+	return( 1 );
+
+on_error:
+	if( export_handle->basename != NULL )
+	{
+		memory_free(
+		 export_handle->basename );
+
+		export_handle->basename = NULL;
+	}
+	export_handle->basename_size = 0;
+
+	return( -1 );
+}
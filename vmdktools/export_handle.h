@@ -0,0 +1,224 @@
+/*
+ * Export handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _EXPORT_HANDLE_H )
+#define _EXPORT_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The data of flat extents can be copied by the kernel without passing through
+ * the process buffer when copy_file_range or splice is available
+ */
+#if !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && defined( HAVE_FILENO ) && defined( HAVE_OPEN ) && ( defined( HAVE_COPY_FILE_RANGE ) || defined( HAVE_SPLICE ) )
+#define EXPORT_HANDLE_HAVE_COPY_OFFLOAD
+#endif
+
+/* The default process buffer size, a multiple of the grain size
+ */
+#define EXPORT_HANDLE_DEFAULT_PROCESS_BUFFER_SIZE	( 8 * 1024 * 1024 )
+
+typedef struct export_handle_flat_extent export_handle_flat_extent_t;
+
+struct export_handle_flat_extent
+{
+	/* The offset of the extent in the media data
+	 */
+	off64_t media_offset;
+
+	/* The offset of the extent data in the extent file
+	 */
+	off64_t file_offset;
+
+	/* The size of the extent data
+	 */
+	size64_t size;
+
+	/* The extent file descriptor or -1 if the extent is not flat
+	 */
+	int file_descriptor;
+};
+
+typedef struct export_handle export_handle_t;
+
+struct export_handle
+{
+	/* The basename
+	 */
+	system_character_t *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
+	/* The input handles array
+	 * The first entry contains the input handle followed by its parents
+	 */
+	libcdata_array_t *input_handles_array;
+
+	/* The input handle
+	 */
+	libvmdk_handle_t *input_handle;
+
+	/* The flat extents of the input used for copy offload
+	 */
+	export_handle_flat_extent_t *flat_extents;
+
+	/* The number of flat extents
+	 */
+	int number_of_flat_extents;
+
+	/* Value to indicate copy offload should be used
+	 */
+	int use_copy_offload;
+
+	/* The output stream
+	 */
+	FILE *output_stream;
+
+	/* Value to indicate the output stream is stdout
+	 */
+	uint8_t output_is_stdout;
+
+	/* Value to indicate the output stream is seekable
+	 */
+	uint8_t output_is_seekable;
+
+	/* The current offset of the output stream
+	 */
+	off64_t output_offset;
+
+	/* The end offset of the data written to the output stream
+	 */
+	off64_t output_end_offset;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The process buffer size
+	 */
+	size_t process_buffer_size;
+
+	/* The number of bytes copied through the process buffer
+	 */
+	size64_t copied_size;
+
+	/* The number of bytes copied by the kernel
+	 */
+	size64_t offloaded_size;
+
+	/* The number of bytes that were not written since they were sparse
+	 */
+	size64_t sparse_size;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int export_handle_initialize(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_free(
+     export_handle_t **export_handle,
+     libcerror_error_t **error );
+
+int export_handle_signal_abort(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_open_input(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_open_input_parent_handle(
+     export_handle_t *export_handle,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error );
+
+int export_handle_open_flat_extents(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_close_flat_extents(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_open_output(
+     export_handle_t *export_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int export_handle_close(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_seek_output_offset(
+     export_handle_t *export_handle,
+     off64_t offset,
+     libcerror_error_t **error );
+
+ssize_t export_handle_write_buffer_at_offset(
+         export_handle_t *export_handle,
+         const uint8_t *buffer,
+         size_t buffer_size,
+         off64_t offset,
+         libcerror_error_t **error );
+
+int export_handle_copy_offload_at_offset(
+     export_handle_t *export_handle,
+     off64_t offset,
+     size64_t size,
+     size64_t *copied_size,
+     libcerror_error_t **error );
+
+int export_handle_export(
+     export_handle_t *export_handle,
+     libcerror_error_t **error );
+
+int export_handle_set_basename(
+     export_handle_t *export_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _EXPORT_HANDLE_H ) */
+
@@ -0,0 +1,3436 @@
+/*
+ * Generate handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+#include <wide_string.h>
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include "byte_size_string.h"
+#include "generate_handle.h"
+#include "vmdktools_libbfio.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libcpath.h"
+#include "vmdktools_libfvalue.h"
+#include "vmdktools_libuna.h"
+#include "vmdktools_libvmdk.h"
+
+#define GENERATE_HANDLE_NOTIFY_STREAM		stdout
+
+/* The size of the header at the start of every generated sector
+ * that contains the media offset and the layer index
+ */
+#define GENERATE_HANDLE_SECTOR_HEADER_SIZE	16
+
+/* Creates a generate handle
+ * Make sure the value generate_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_initialize(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_initialize";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *generate_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid generate handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*generate_handle = memory_allocate_structure(
+	                    generate_handle_t );
+
+	if( *generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create generate handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *generate_handle,
+	     0,
+	     sizeof( generate_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear generate handle.",
+		 function );
+
+		memory_free(
+		 *generate_handle );
+
+		*generate_handle = NULL;
+
+		return( -1 );
+	}
+	( *generate_handle )->output_format         = GENERATE_HANDLE_OUTPUT_FORMAT_SPARSE;
+	( *generate_handle )->media_size            = GENERATE_HANDLE_DEFAULT_MEDIA_SIZE;
+	( *generate_handle )->grain_size            = GENERATE_HANDLE_DEFAULT_GRAIN_SIZE;
+	( *generate_handle )->block_size            = GENERATE_HANDLE_DEFAULT_BLOCK_SIZE;
+	( *generate_handle )->fill_percentage       = GENERATE_HANDLE_DEFAULT_FILL_PERCENTAGE;
+	( *generate_handle )->delta_fill_percentage = GENERATE_HANDLE_DEFAULT_DELTA_FILL_PERCENTAGE;
+	( *generate_handle )->compressibility       = GENERATE_HANDLE_DEFAULT_COMPRESSIBILITY;
+	( *generate_handle )->fragmentation         = GENERATE_HANDLE_DEFAULT_FRAGMENTATION;
+	( *generate_handle )->number_of_threads     = GENERATE_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+	( *generate_handle )->seed                  = GENERATE_HANDLE_DEFAULT_SEED;
+	( *generate_handle )->notify_stream         = GENERATE_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *generate_handle != NULL )
+	{
+		memory_free(
+		 *generate_handle );
+
+		*generate_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a generate handle
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_free(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_free";
+	int layer_index       = 0;
+	int result            = 1;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *generate_handle != NULL )
+	{
+		if( ( *generate_handle )->layer_handles != NULL )
+		{
+			/* Free the delta disks before their parents
+			 */
+			for( layer_index = ( *generate_handle )->number_of_layer_handles - 1;
+			     layer_index >= 0;
+			     layer_index-- )
+			{
+				if( libvmdk_handle_free(
+				     &( ( *generate_handle )->layer_handles[ layer_index ] ),
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+					 "%s: unable to free layer handle: %d.",
+					 function,
+					 layer_index );
+
+					result = -1;
+				}
+			}
+			memory_free(
+			 ( *generate_handle )->layer_handles );
+		}
+		if( ( *generate_handle )->output_handle != NULL )
+		{
+			if( libvmdk_handle_free(
+			     &( ( *generate_handle )->output_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free output handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *generate_handle )->output_stream_writer != NULL )
+		{
+			if( libvmdk_stream_writer_free(
+			     &( ( *generate_handle )->output_stream_writer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free output stream writer.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *generate_handle )->output_file_io_handle != NULL )
+		{
+			if( libbfio_handle_free(
+			     &( ( *generate_handle )->output_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free output file IO handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *generate_handle )->block_data != NULL )
+		{
+			memory_free(
+			 ( *generate_handle )->block_data );
+		}
+		if( ( *generate_handle )->prefix != NULL )
+		{
+			memory_free(
+			 ( *generate_handle )->prefix );
+		}
+		if( ( *generate_handle )->filename != NULL )
+		{
+			memory_free(
+			 ( *generate_handle )->filename );
+		}
+		memory_free(
+		 *generate_handle );
+
+		*generate_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the generate handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_signal_abort(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_signal_abort";
+	int layer_index       = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	generate_handle->abort = 1;
+
+	if( generate_handle->output_handle != NULL )
+	{
+		if( libvmdk_handle_signal_abort(
+		     generate_handle->output_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal output handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	for( layer_index = 0;
+	     layer_index < generate_handle->number_of_layer_handles;
+	     layer_index++ )
+	{
+		if( libvmdk_handle_signal_abort(
+		     generate_handle->layer_handles[ layer_index ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal layer handle: %d to abort.",
+			 function,
+			 layer_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the output format
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_output_format(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_output_format";
+	size_t string_length  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( string_length == 4 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "flat" ),
+		     4 ) == 0 )
+		{
+			generate_handle->output_format = GENERATE_HANDLE_OUTPUT_FORMAT_FLAT;
+			result                         = 1;
+		}
+	}
+	else if( string_length == 5 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "split" ),
+		     5 ) == 0 )
+		{
+			generate_handle->output_format = GENERATE_HANDLE_OUTPUT_FORMAT_SPLIT_SPARSE;
+			result                         = 1;
+		}
+	}
+	else if( string_length == 6 )
+	{
+		if( system_string_compare(
+		     string,
+		     _SYSTEM_STRING( "sparse" ),
+		     6 ) == 0 )
+		{
+			generate_handle->output_format = GENERATE_HANDLE_OUTPUT_FORMAT_SPARSE;
+			result                         = 1;
+		}
+		else if( system_string_compare(
+		          string,
+		          _SYSTEM_STRING( "stream" ),
+		          6 ) == 0 )
+		{
+			generate_handle->output_format = GENERATE_HANDLE_OUTPUT_FORMAT_STREAM_OPTIMIZED;
+			result                         = 1;
+		}
+	}
+	return( result );
+}
+
+/* Sets the media size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_media_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_media_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine media size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The VMDK formats store the media size in sectors
+	 */
+	if( ( size_value == 0 )
+	 || ( size_value > (uint64_t) INT64_MAX )
+	 || ( ( size_value % 512 ) != 0 ) )
+	{
+		return( 0 );
+	}
+	generate_handle->media_size = (size64_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the grain size
+ * The grain size must be a power of 2 between 8 KiB and 1 MiB
+ * The block size is set to the grain size, hence the block size should be set afterwards
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_grain_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_grain_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine grain size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_value < (uint64_t) GENERATE_HANDLE_MINIMUM_GRAIN_SIZE )
+	 || ( size_value > (uint64_t) GENERATE_HANDLE_MAXIMUM_GRAIN_SIZE )
+	 || ( ( size_value & ( size_value - 1 ) ) != 0 ) )
+	{
+		return( 0 );
+	}
+	generate_handle->grain_size = (size32_t) size_value;
+	generate_handle->block_size = (size32_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the block size
+ * The block size must be a multiple of the grain size so that every block
+ * covers whole grains of the sparse formats
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_block_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_block_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( size_value == 0 )
+	 || ( size_value > (uint64_t) GENERATE_HANDLE_MAXIMUM_BLOCK_SIZE )
+	 || ( ( size_value % generate_handle->grain_size ) != 0 ) )
+	{
+		return( 0 );
+	}
+	generate_handle->block_size = (size32_t) size_value;
+
+	return( 1 );
+}
+
+/* Retrieves a percentage from a string
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_get_percentage(
+     const system_character_t *string,
+     int *percentage,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_get_percentage";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	if( percentage == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid percentage.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > 100 )
+	{
+		return( 0 );
+	}
+	*percentage = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the percentage of the blocks of the base image that contain data
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_fill_percentage(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_fill_percentage";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( generate_handle_get_percentage(
+	         string,
+	         &( generate_handle->fill_percentage ),
+	         error ) );
+}
+
+/* Sets the percentage of the blocks that are written to each delta disk
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_delta_fill_percentage(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_delta_fill_percentage";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( generate_handle_get_percentage(
+	         string,
+	         &( generate_handle->delta_fill_percentage ),
+	         error ) );
+}
+
+/* Sets the percentage of the data that is compressible
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_compressibility(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_compressibility";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( generate_handle_get_percentage(
+	         string,
+	         &( generate_handle->compressibility ),
+	         error ) );
+}
+
+/* Sets the fragmentation percentage
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_fragmentation(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_fragmentation";
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( generate_handle_get_percentage(
+	         string,
+	         &( generate_handle->fragmentation ),
+	         error ) );
+}
+
+/* Sets the number of delta disks
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_number_of_delta_disks(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_number_of_delta_disks";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) GENERATE_HANDLE_MAXIMUM_NUMBER_OF_DELTA_DISKS )
+	{
+		return( 0 );
+	}
+	generate_handle->number_of_delta_disks = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the number of threads used to compress stream-optimized output
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int generate_handle_set_number_of_threads(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) GENERATE_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+	{
+		return( 0 );
+	}
+	generate_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the seed of the generated layout and data
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_set_seed(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_set_seed";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	generate_handle->seed = value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the filename of the base image
+ * The filenames of the delta disks are derived from it by replacing
+ * the .vmdk extension with a -######.vmdk suffix
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_set_filename(
+     generate_handle_t *generate_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	static char *function  = "generate_handle_set_filename";
+	size_t filename_length = 0;
+	size_t prefix_length   = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->filename != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid generate handle - filename already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	if( ( filename_length == 0 )
+	 || ( filename_length > (size_t) ( SSIZE_MAX / sizeof( system_character_t ) ) - 16 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename length value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	prefix_length = filename_length;
+
+	if( ( filename_length > 5 )
+	 && ( system_string_compare_no_case(
+	       &( filename[ filename_length - 5 ] ),
+	       _SYSTEM_STRING( ".vmdk" ),
+	       5 ) == 0 ) )
+	{
+		prefix_length -= 5;
+	}
+	generate_handle->filename = system_string_allocate(
+	                             filename_length + 1 );
+
+	if( generate_handle->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     generate_handle->filename,
+	     filename,
+	     filename_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy filename.",
+		 function );
+
+		goto on_error;
+	}
+	generate_handle->filename[ filename_length ] = 0;
+
+	generate_handle->filename_size = filename_length + 1;
+
+	generate_handle->prefix = system_string_allocate(
+	                           prefix_length + 1 );
+
+	if( generate_handle->prefix == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create prefix string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     generate_handle->prefix,
+	     filename,
+	     prefix_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy prefix.",
+		 function );
+
+		goto on_error;
+	}
+	generate_handle->prefix[ prefix_length ] = 0;
+
+	generate_handle->prefix_size = prefix_length + 1;
+
+	return( 1 );
+
+on_error:
+	if( generate_handle->prefix != NULL )
+	{
+		memory_free(
+		 generate_handle->prefix );
+
+		generate_handle->prefix = NULL;
+	}
+	generate_handle->prefix_size = 0;
+
+	if( generate_handle->filename != NULL )
+	{
+		memory_free(
+		 generate_handle->filename );
+
+		generate_handle->filename = NULL;
+	}
+	generate_handle->filename_size = 0;
+
+	return( -1 );
+}
+
+/* Retrieves the filename of a layer
+ * The layer index 0 refers to the base image and the other layers to the delta disks
+ * The filename size should be at least the prefix size + 12
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_get_layer_filename(
+     generate_handle_t *generate_handle,
+     int layer_index,
+     system_character_t *filename,
+     size_t filename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_get_layer_filename";
+	int print_count       = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( generate_handle->filename == NULL )
+	 || ( generate_handle->prefix == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid generate handle - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( layer_index < 0 )
+	 || ( layer_index > GENERATE_HANDLE_MAXIMUM_NUMBER_OF_DELTA_DISKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid layer index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename_size < ( generate_handle->prefix_size + 12 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid filename size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( layer_index == 0 )
+	{
+		if( system_string_copy(
+		     filename,
+		     generate_handle->filename,
+		     generate_handle->filename_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy filename.",
+			 function );
+
+			return( -1 );
+		}
+		return( 1 );
+	}
+	print_count = system_string_sprintf(
+	               filename,
+	               filename_size,
+	               _SYSTEM_STRING( "%" ) _SYSTEM_STRING( PRIs_SYSTEM ) _SYSTEM_STRING( "-%06d.vmdk" ),
+	               generate_handle->prefix,
+	               layer_index );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= filename_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens the output of the base image
+ * For the flat output format the filename is that of the descriptor file
+ * and the extent file is created next to it with a -flat.vmdk suffix
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_open_output(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	system_character_t *extent_basename = NULL;
+	system_character_t *extent_filename = NULL;
+	static char *function               = "generate_handle_open_output";
+	size_t extent_filename_size         = 0;
+	size_t prefix_length                = 0;
+	int result                          = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->output_is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid generate handle - output already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( generate_handle->filename == NULL )
+	 || ( generate_handle->prefix == NULL ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid generate handle - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( generate_handle->media_size == 0 )
+	 || ( ( generate_handle->media_size % 512 ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported media size: %" PRIu64 " not a multiple of the sector size.",
+		 function,
+		 generate_handle->media_size );
+
+		return( -1 );
+	}
+	switch( generate_handle->output_format )
+	{
+		case GENERATE_HANDLE_OUTPUT_FORMAT_FLAT:
+			prefix_length        = generate_handle->prefix_size - 1;
+			extent_filename_size = prefix_length + 11;
+
+			extent_filename = system_string_allocate(
+			                   extent_filename_size );
+
+			if( extent_filename == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_MEMORY,
+				 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+				 "%s: unable to create extent filename.",
+				 function );
+
+				goto on_error;
+			}
+			if( system_string_copy(
+			     extent_filename,
+			     generate_handle->prefix,
+			     prefix_length ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy extent filename prefix.",
+				 function );
+
+				goto on_error;
+			}
+			if( system_string_copy(
+			     &( extent_filename[ prefix_length ] ),
+			     _SYSTEM_STRING( "-flat.vmdk" ),
+			     10 ) == NULL )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+				 "%s: unable to copy extent filename suffix.",
+				 function );
+
+				goto on_error;
+			}
+			extent_filename[ extent_filename_size - 1 ] = 0;
+
+			/* The descriptor refers to the extent file by its basename
+			 */
+			extent_basename = system_string_search_character_reverse(
+			                   extent_filename,
+			                   (system_character_t) LIBCPATH_SEPARATOR,
+			                   extent_filename_size );
+
+			if( extent_basename != NULL )
+			{
+				extent_basename += 1;
+			}
+			else
+			{
+				extent_basename = extent_filename;
+			}
+			if( generate_handle_write_flat_descriptor(
+			     generate_handle,
+			     extent_basename,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write descriptor file.",
+				 function );
+
+				goto on_error;
+			}
+			if( libbfio_file_initialize(
+			     &( generate_handle->output_file_io_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize output file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			result = libbfio_file_set_name_wide(
+			          generate_handle->output_file_io_handle,
+			          extent_filename,
+			          extent_filename_size,
+			          error );
+#else
+			result = libbfio_file_set_name(
+			          generate_handle->output_file_io_handle,
+			          extent_filename,
+			          extent_filename_size,
+			          error );
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set output filename.",
+				 function );
+
+				goto on_error;
+			}
+			if( libbfio_handle_open(
+			     generate_handle->output_file_io_handle,
+			     LIBBFIO_OPEN_WRITE_TRUNCATE,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open output file IO handle.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+
+		case GENERATE_HANDLE_OUTPUT_FORMAT_SPARSE:
+		case GENERATE_HANDLE_OUTPUT_FORMAT_SPLIT_SPARSE:
+			if( libvmdk_handle_initialize(
+			     &( generate_handle->output_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize output handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_handle_set_grain_size(
+			     generate_handle->output_handle,
+			     (size64_t) generate_handle->grain_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set grain size of output handle.",
+				 function );
+
+				goto on_error;
+			}
+			if( generate_handle->output_format == GENERATE_HANDLE_OUTPUT_FORMAT_SPARSE )
+			{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+				result = libvmdk_handle_create_sparse_wide(
+				          generate_handle->output_handle,
+				          generate_handle->filename,
+				          generate_handle->media_size,
+				          error );
+#else
+				result = libvmdk_handle_create_sparse(
+				          generate_handle->output_handle,
+				          generate_handle->filename,
+				          generate_handle->media_size,
+				          error );
+#endif
+			}
+			else
+			{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+				result = libvmdk_handle_create_split_sparse_wide(
+				          generate_handle->output_handle,
+				          generate_handle->filename,
+				          generate_handle->media_size,
+				          error );
+#else
+				result = libvmdk_handle_create_split_sparse(
+				          generate_handle->output_handle,
+				          generate_handle->filename,
+				          generate_handle->media_size,
+				          error );
+#endif
+			}
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to create output handle.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+
+		case GENERATE_HANDLE_OUTPUT_FORMAT_STREAM_OPTIMIZED:
+			if( libvmdk_stream_writer_initialize(
+			     &( generate_handle->output_stream_writer ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+				 "%s: unable to initialize output stream writer.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_stream_writer_set_media_size(
+			     generate_handle->output_stream_writer,
+			     generate_handle->media_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set media size of output stream writer.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_stream_writer_set_grain_size(
+			     generate_handle->output_stream_writer,
+			     (size64_t) generate_handle->grain_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set grain size of output stream writer.",
+				 function );
+
+				goto on_error;
+			}
+			if( libvmdk_stream_writer_set_number_of_threads(
+			     generate_handle->output_stream_writer,
+			     generate_handle->number_of_threads,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set number of threads of output stream writer.",
+				 function );
+
+				goto on_error;
+			}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+			result = libvmdk_stream_writer_open_wide(
+			          generate_handle->output_stream_writer,
+			          generate_handle->filename,
+			          error );
+#else
+			result = libvmdk_stream_writer_open(
+			          generate_handle->output_stream_writer,
+			          generate_handle->filename,
+			          error );
+#endif
+			if( result != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open output stream writer.",
+				 function );
+
+				goto on_error;
+			}
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported output format.",
+			 function );
+
+			goto on_error;
+	}
+	if( extent_filename != NULL )
+	{
+		memory_free(
+		 extent_filename );
+
+		extent_filename = NULL;
+	}
+	generate_handle->output_end_offset = 0;
+	generate_handle->output_is_open    = 1;
+
+	return( 1 );
+
+on_error:
+	if( generate_handle->output_stream_writer != NULL )
+	{
+		libvmdk_stream_writer_free(
+		 &( generate_handle->output_stream_writer ),
+		 NULL );
+	}
+	if( generate_handle->output_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &( generate_handle->output_handle ),
+		 NULL );
+	}
+	if( generate_handle->output_file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &( generate_handle->output_file_io_handle ),
+		 NULL );
+	}
+	if( extent_filename != NULL )
+	{
+		memory_free(
+		 extent_filename );
+	}
+	return( -1 );
+}
+
+/* Writes the descriptor file of a monolithic flat base image
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_write_flat_descriptor(
+     generate_handle_t *generate_handle,
+     const system_character_t *extent_basename,
+     libcerror_error_t **error )
+{
+	libbfio_handle_t *file_io_handle = NULL;
+	uint8_t *descriptor              = NULL;
+	uint8_t *utf8_extent_basename    = NULL;
+	static char *function            = "generate_handle_write_flat_descriptor";
+	size64_t number_of_cylinders     = 0;
+	size_t descriptor_size           = 0;
+	size_t utf8_extent_basename_size = 0;
+	ssize_t write_count              = 0;
+	uint32_t content_identifier      = 0;
+	int print_count                  = 0;
+	int result                       = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid generate handle - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( extent_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid extent basename.",
+		 function );
+
+		return( -1 );
+	}
+	/* The descriptor is stored as UTF-8
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_size_from_utf32(
+	          (libuna_utf32_character_t *) extent_basename,
+	          system_string_length( extent_basename ) + 1,
+	          &utf8_extent_basename_size,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_size_from_utf16(
+	          (libuna_utf16_character_t *) extent_basename,
+	          system_string_length( extent_basename ) + 1,
+	          &utf8_extent_basename_size,
+	          error );
+#else
+#error Unsupported size of wchar_t
+#endif /* SIZEOF_WCHAR_T */
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to determine UTF-8 extent basename size.",
+		 function );
+
+		goto on_error;
+	}
+	utf8_extent_basename = (uint8_t *) memory_allocate(
+	                                    sizeof( uint8_t ) * utf8_extent_basename_size );
+
+	if( utf8_extent_basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create UTF-8 extent basename.",
+		 function );
+
+		goto on_error;
+	}
+#if SIZEOF_WCHAR_T == 4
+	result = libuna_utf8_string_copy_from_utf32(
+	          utf8_extent_basename,
+	          utf8_extent_basename_size,
+	          (libuna_utf32_character_t *) extent_basename,
+	          system_string_length( extent_basename ) + 1,
+	          error );
+#elif SIZEOF_WCHAR_T == 2
+	result = libuna_utf8_string_copy_from_utf16(
+	          utf8_extent_basename,
+	          utf8_extent_basename_size,
+	          (libuna_utf16_character_t *) extent_basename,
+	          system_string_length( extent_basename ) + 1,
+	          error );
+#endif /* SIZEOF_WCHAR_T */
+
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_CONVERSION,
+		 LIBCERROR_CONVERSION_ERROR_GENERIC,
+		 "%s: unable to set UTF-8 extent basename.",
+		 function );
+
+		goto on_error;
+	}
+#else
+	utf8_extent_basename_size = system_string_length( extent_basename ) + 1;
+#endif /* defined( HAVE_WIDE_SYSTEM_CHARACTER ) */
+
+	descriptor_size = 1024 + utf8_extent_basename_size;
+
+	descriptor = (uint8_t *) memory_allocate(
+	                          sizeof( uint8_t ) * descriptor_size );
+
+	if( descriptor == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	content_identifier = (uint32_t) time( NULL );
+
+	if( content_identifier == 0xffffffffUL )
+	{
+		content_identifier ^= 0x00000001UL;
+	}
+	number_of_cylinders = generate_handle->media_size / ( 255 * 63 * 512 );
+
+	if( number_of_cylinders > 65535 )
+	{
+		number_of_cylinders = 65535;
+	}
+	print_count = narrow_string_snprintf(
+	               (char *) descriptor,
+	               descriptor_size,
+	               "# Disk DescriptorFile\n"
+	               "version=1\n"
+	               "encoding=\"UTF-8\"\n"
+	               "CID=%08" PRIx32 "\n"
+	               "parentCID=ffffffff\n"
+	               "createType=\"monolithicFlat\"\n"
+	               "\n"
+	               "# Extent description\n"
+	               "RW %" PRIu64 " FLAT \"%s\" 0\n"
+	               "\n"
+	               "# The Disk Data Base\n"
+	               "#DDB\n"
+	               "\n"
+	               "ddb.virtualHWVersion = \"4\"\n"
+	               "ddb.geometry.cylinders = \"%" PRIu64 "\"\n"
+	               "ddb.geometry.heads = \"255\"\n"
+	               "ddb.geometry.sectors = \"63\"\n"
+	               "ddb.adapterType = \"lsilogic\"\n",
+	               content_identifier,
+	               generate_handle->media_size / 512,
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	               (char *) utf8_extent_basename,
+#else
+	               extent_basename,
+#endif
+	               number_of_cylinders );
+
+	if( ( print_count < 0 )
+	 || ( (size_t) print_count >= descriptor_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_file_initialize(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libbfio_file_set_name_wide(
+	          file_io_handle,
+	          generate_handle->filename,
+	          generate_handle->filename_size,
+	          error );
+#else
+	result = libbfio_file_set_name(
+	          file_io_handle,
+	          generate_handle->filename,
+	          generate_handle->filename_size,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_open(
+	     file_io_handle,
+	     LIBBFIO_OPEN_WRITE_TRUNCATE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	write_count = libbfio_handle_write_buffer(
+	               file_io_handle,
+	               descriptor,
+	               (size_t) print_count,
+	               error );
+
+	if( write_count != (ssize_t) print_count )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write descriptor.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_close(
+	     file_io_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libbfio_handle_free(
+	     &file_io_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free file IO handle.",
+		 function );
+
+		goto on_error;
+	}
+	memory_free(
+	 descriptor );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	memory_free(
+	 utf8_extent_basename );
+#endif
+	return( 1 );
+
+on_error:
+	if( file_io_handle != NULL )
+	{
+		libbfio_handle_free(
+		 &file_io_handle,
+		 NULL );
+	}
+	if( descriptor != NULL )
+	{
+		memory_free(
+		 descriptor );
+	}
+	if( utf8_extent_basename != NULL )
+	{
+		memory_free(
+		 utf8_extent_basename );
+	}
+	return( -1 );
+}
+
+/* Closes the output of the base image
+ * This writes the remaining grains and metadata of the stream-optimized output
+ * Returns 0 if successful or -1 on error
+ */
+int generate_handle_close_output(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_close_output";
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->output_is_open == 0 )
+	{
+		return( 0 );
+	}
+	if( generate_handle->output_stream_writer != NULL )
+	{
+		if( libvmdk_stream_writer_close(
+		     generate_handle->output_stream_writer,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close output stream writer.",
+			 function );
+
+			result = -1;
+		}
+		if( libvmdk_stream_writer_free(
+		     &( generate_handle->output_stream_writer ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output stream writer.",
+			 function );
+
+			result = -1;
+		}
+	}
+	else if( generate_handle->output_file_io_handle != NULL )
+	{
+		if( libbfio_handle_close(
+		     generate_handle->output_file_io_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close output file IO handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libbfio_handle_free(
+		     &( generate_handle->output_file_io_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output file IO handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	else if( generate_handle->output_handle != NULL )
+	{
+		if( libvmdk_handle_close(
+		     generate_handle->output_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close output handle.",
+			 function );
+
+			result = -1;
+		}
+		if( libvmdk_handle_free(
+		     &( generate_handle->output_handle ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free output handle.",
+			 function );
+
+			result = -1;
+		}
+	}
+	generate_handle->output_is_open = 0;
+
+	return( result );
+}
+
+/* Opens the base image for reading as the first layer of the delta disks
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_open_layers(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *layer_handle = NULL;
+	static char *function          = "generate_handle_open_layers";
+	size_t layer_handles_size      = 0;
+	int result                     = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->layer_handles != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid generate handle - layer handles already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid generate handle - missing filename.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->output_is_open != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid generate handle - output still open.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( generate_handle->number_of_delta_disks < 0 )
+	 || ( generate_handle->number_of_delta_disks > GENERATE_HANDLE_MAXIMUM_NUMBER_OF_DELTA_DISKS ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid generate handle - number of delta disks value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	layer_handles_size = sizeof( libvmdk_handle_t * ) * (size_t) ( generate_handle->number_of_delta_disks + 1 );
+
+	generate_handle->layer_handles = (libvmdk_handle_t **) memory_allocate(
+	                                                        layer_handles_size );
+
+	if( generate_handle->layer_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create layer handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     generate_handle->layer_handles,
+	     0,
+	     layer_handles_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear layer handles.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_initialize(
+	     &layer_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize layer handle: 0.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_open_wide(
+	          layer_handle,
+	          generate_handle->filename,
+	          LIBVMDK_OPEN_READ,
+	          error );
+#else
+	result = libvmdk_handle_open(
+	          layer_handle,
+	          generate_handle->filename,
+	          LIBVMDK_OPEN_READ,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open layer handle: 0.",
+		 function );
+
+		goto on_error;
+	}
+	generate_handle->layer_handles[ 0 ]       = layer_handle;
+	generate_handle->number_of_layer_handles = 1;
+
+	layer_handle = NULL;
+
+	if( libvmdk_handle_open_extent_data_files(
+	     generate_handle->layer_handles[ 0 ],
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files of layer handle: 0.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( layer_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &layer_handle,
+		 NULL );
+	}
+	if( generate_handle->layer_handles != NULL )
+	{
+		if( generate_handle->layer_handles[ 0 ] != NULL )
+		{
+			libvmdk_handle_close(
+			 generate_handle->layer_handles[ 0 ],
+			 NULL );
+			libvmdk_handle_free(
+			 &( generate_handle->layer_handles[ 0 ] ),
+			 NULL );
+		}
+		memory_free(
+		 generate_handle->layer_handles );
+
+		generate_handle->layer_handles = NULL;
+	}
+	generate_handle->number_of_layer_handles = 0;
+
+	return( -1 );
+}
+
+/* Creates a delta disk on top of the previous layer
+ * The delta disk refers to its parent by the basename of the parent filename
+ * since both are created in the same directory
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_create_delta_disk(
+     generate_handle_t *generate_handle,
+     int layer_index,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *layer_handle      = NULL;
+	system_character_t *filename        = NULL;
+	system_character_t *parent_basename = NULL;
+	system_character_t *parent_filename = NULL;
+	static char *function               = "generate_handle_create_delta_disk";
+	size_t filename_size                = 0;
+	int result                          = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->layer_handles == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid generate handle - missing layer handles.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( layer_index < 1 )
+	 || ( layer_index > generate_handle->number_of_delta_disks )
+	 || ( layer_index != generate_handle->number_of_layer_handles ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid layer index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	filename_size = generate_handle->prefix_size + 12;
+
+	filename = system_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+	                   filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( generate_handle_get_layer_filename(
+	     generate_handle,
+	     layer_index,
+	     filename,
+	     filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename of layer: %d.",
+		 function,
+		 layer_index );
+
+		goto on_error;
+	}
+	if( generate_handle_get_layer_filename(
+	     generate_handle,
+	     layer_index - 1,
+	     parent_filename,
+	     filename_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve filename of layer: %d.",
+		 function,
+		 layer_index - 1 );
+
+		goto on_error;
+	}
+	parent_basename = system_string_search_character_reverse(
+	                   parent_filename,
+	                   (system_character_t) LIBCPATH_SEPARATOR,
+	                   system_string_length( parent_filename ) + 1 );
+
+	if( parent_basename != NULL )
+	{
+		parent_basename += 1;
+	}
+	else
+	{
+		parent_basename = parent_filename;
+	}
+	if( libvmdk_handle_initialize(
+	     &layer_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize layer handle: %d.",
+		 function,
+		 layer_index );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_set_grain_size(
+	     layer_handle,
+	     (size64_t) generate_handle->grain_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set grain size of layer handle: %d.",
+		 function,
+		 layer_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_create_child_wide(
+	          layer_handle,
+	          filename,
+	          generate_handle->layer_handles[ layer_index - 1 ],
+	          parent_basename,
+	          error );
+#else
+	result = libvmdk_handle_create_child(
+	          layer_handle,
+	          filename,
+	          generate_handle->layer_handles[ layer_index - 1 ],
+	          parent_basename,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to create delta disk: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	generate_handle->layer_handles[ layer_index ] = layer_handle;
+	generate_handle->number_of_layer_handles    += 1;
+
+	memory_free(
+	 parent_filename );
+
+	memory_free(
+	 filename );
+
+	return( 1 );
+
+on_error:
+	if( layer_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &layer_handle,
+		 NULL );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	return( -1 );
+}
+
+/* Closes the generate handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int generate_handle_close(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_close";
+	int layer_index       = 0;
+	int result            = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle_close_output(
+	     generate_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close output.",
+		 function );
+
+		result = -1;
+	}
+	if( generate_handle->layer_handles != NULL )
+	{
+		/* Close the delta disks before their parents
+		 */
+		for( layer_index = generate_handle->number_of_layer_handles - 1;
+		     layer_index >= 0;
+		     layer_index-- )
+		{
+			if( libvmdk_handle_close(
+			     generate_handle->layer_handles[ layer_index ],
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close layer handle: %d.",
+				 function,
+				 layer_index );
+
+				result = -1;
+			}
+			if( libvmdk_handle_free(
+			     &( generate_handle->layer_handles[ layer_index ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free layer handle: %d.",
+				 function,
+				 layer_index );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 generate_handle->layer_handles );
+
+		generate_handle->layer_handles           = NULL;
+		generate_handle->number_of_layer_handles = 0;
+	}
+	return( result );
+}
+
+/* Retrieves the next value of a xorshift64* pseudo random number generator
+ * A fixed generator is used so that the generated images are the same on every platform
+ * Returns the random value
+ */
+uint64_t generate_handle_get_random_value(
+          uint64_t *random_state )
+{
+	uint64_t value = 0;
+
+	if( random_state == NULL )
+	{
+		return( 0 );
+	}
+	value = *random_state;
+
+	if( value == 0 )
+	{
+		value = 0x9e3779b97f4a7c15ULL;
+	}
+	value ^= value >> 12;
+	value ^= value << 25;
+	value ^= value >> 27;
+
+	*random_state = value;
+
+	return( value * 0x2545f4914f6cdd1dULL );
+}
+
+/* Retrieves the cluster size in blocks for a specific fragmentation
+ * Every cluster contains a single run of blocks with data, hence a fragmentation
+ * of 0 stores the data in a single run and a fragmentation of 100 spreads the data
+ * over the media in runs of a single block. The cluster size is a power of 2
+ * that scales logarithmically between these extremes
+ * Returns the cluster size
+ */
+uint64_t generate_handle_get_cluster_size(
+          uint64_t number_of_blocks,
+          int fragmentation )
+{
+	int number_of_bits = 0;
+
+	if( ( fragmentation <= 0 )
+	 || ( number_of_blocks <= 1 ) )
+	{
+		return( number_of_blocks );
+	}
+	if( fragmentation > 100 )
+	{
+		fragmentation = 100;
+	}
+	while( ( number_of_blocks >> number_of_bits ) > 1 )
+	{
+		number_of_bits++;
+	}
+	number_of_bits = ( number_of_bits * ( 100 - fragmentation ) ) / 100;
+
+	return( (uint64_t) 1 << number_of_bits );
+}
+
+/* Fills the block data for a specific layer and media offset
+ * Every sector starts with its media offset and the layer index, as 64-bit
+ * little-endian values, followed by pseudo random data and a repeated fill value.
+ * The size of the fill value is determined by the compressibility
+ */
+void generate_handle_fill_block(
+      generate_handle_t *generate_handle,
+      int layer_index,
+      off64_t block_offset,
+      size_t block_size )
+{
+	uint8_t *sector_data  = NULL;
+	size_t data_offset    = 0;
+	size_t random_size    = 0;
+	size_t sector_offset  = 0;
+	uint64_t random_state = 0;
+	uint64_t random_value = 0;
+	uint64_t media_offset = 0;
+	uint8_t fill_value    = 0;
+
+	if( ( generate_handle == NULL )
+	 || ( generate_handle->block_data == NULL )
+	 || ( block_size > (size_t) generate_handle->block_size ) )
+	{
+		return;
+	}
+	random_size = ( ( 512 - GENERATE_HANDLE_SECTOR_HEADER_SIZE ) * (size_t) ( 100 - generate_handle->compressibility ) ) / 100;
+
+	/* The fill value is non-zero so that the sectors are never stored sparse
+	 */
+	fill_value = (uint8_t) ( 'A' + ( layer_index % 26 ) );
+
+	for( sector_offset = 0;
+	     ( sector_offset + 512 ) <= block_size;
+	     sector_offset += 512 )
+	{
+		sector_data  = &( generate_handle->block_data[ sector_offset ] );
+		media_offset = (uint64_t) block_offset + sector_offset;
+
+		byte_stream_copy_from_uint64_little_endian(
+		 sector_data,
+		 media_offset );
+
+		byte_stream_copy_from_uint64_little_endian(
+		 &( sector_data[ 8 ] ),
+		 (uint64_t) layer_index );
+
+		/* The random data only depends on the seed, the layer and the media offset
+		 * so that it does not depend on the order in which the blocks are generated
+		 */
+		random_state = generate_handle->seed
+		             ^ ( media_offset * 0x9e3779b97f4a7c15ULL )
+		             ^ ( (uint64_t) layer_index << 56 );
+
+		for( data_offset = 0;
+		     data_offset < random_size;
+		     data_offset++ )
+		{
+			if( ( data_offset % 8 ) == 0 )
+			{
+				random_value = generate_handle_get_random_value(
+				                &random_state );
+			}
+			sector_data[ GENERATE_HANDLE_SECTOR_HEADER_SIZE + data_offset ] = (uint8_t) ( random_value & 0xff );
+
+			random_value >>= 8;
+		}
+		memory_set(
+		 &( sector_data[ GENERATE_HANDLE_SECTOR_HEADER_SIZE + random_size ] ),
+		 fill_value,
+		 512 - GENERATE_HANDLE_SECTOR_HEADER_SIZE - random_size );
+	}
+}
+
+/* Writes a block of a specific layer
+ * Blocks without data are only written to the stream-optimized output, which is
+ * written sequentially and stores blocks of 0-byte values sparse, the other outputs
+ * leave them unallocated
+ * Returns 1 if successful or -1 on error
+ */
+int generate_handle_write_block(
+     generate_handle_t *generate_handle,
+     int layer_index,
+     off64_t block_offset,
+     size_t block_size,
+     uint8_t is_allocated,
+     libcerror_error_t **error )
+{
+	static char *function = "generate_handle_write_block";
+	ssize_t write_count   = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid generate handle - missing block data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( block_size == 0 )
+	 || ( block_size > (size_t) generate_handle->block_size ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( layer_index == 0 )
+	{
+		if( generate_handle->output_is_open == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid generate handle - output not open.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else if( ( layer_index < 0 )
+	      || ( layer_index >= generate_handle->number_of_layer_handles ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid layer index value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( is_allocated == 0 )
+	{
+		if( ( layer_index != 0 )
+		 || ( generate_handle->output_stream_writer == NULL ) )
+		{
+			return( 1 );
+		}
+		if( memory_set(
+		     generate_handle->block_data,
+		     0,
+		     block_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear block data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+	{
+		generate_handle_fill_block(
+		 generate_handle,
+		 layer_index,
+		 block_offset,
+		 block_size );
+	}
+	if( layer_index != 0 )
+	{
+		write_count = libvmdk_handle_write_buffer_at_offset(
+		               generate_handle->layer_handles[ layer_index ],
+		               generate_handle->block_data,
+		               block_size,
+		               block_offset,
+		               error );
+	}
+	else if( generate_handle->output_stream_writer != NULL )
+	{
+		write_count = libvmdk_stream_writer_write_buffer(
+		               generate_handle->output_stream_writer,
+		               generate_handle->block_data,
+		               block_size,
+		               error );
+	}
+	else if( generate_handle->output_file_io_handle != NULL )
+	{
+		if( libbfio_handle_seek_offset(
+		     generate_handle->output_file_io_handle,
+		     block_offset,
+		     SEEK_SET,
+		     error ) == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_SEEK_FAILED,
+			 "%s: unable to seek offset: %" PRIi64 " in output file IO handle.",
+			 function,
+			 block_offset );
+
+			return( -1 );
+		}
+		write_count = libbfio_handle_write_buffer(
+		               generate_handle->output_file_io_handle,
+		               generate_handle->block_data,
+		               block_size,
+		               error );
+	}
+	else
+	{
+		write_count = libvmdk_handle_write_buffer_at_offset(
+		               generate_handle->output_handle,
+		               generate_handle->block_data,
+		               block_size,
+		               block_offset,
+		               error );
+	}
+	if( write_count != (ssize_t) block_size )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write block at offset: %" PRIi64 " of layer: %d.",
+		 function,
+		 block_offset,
+		 layer_index );
+
+		return( -1 );
+	}
+	if( ( layer_index == 0 )
+	 && ( ( block_offset + (off64_t) block_size ) > generate_handle->output_end_offset ) )
+	{
+		generate_handle->output_end_offset = block_offset + (off64_t) block_size;
+	}
+	if( is_allocated != 0 )
+	{
+		generate_handle->number_of_allocated_blocks += 1;
+		generate_handle->written_size               += block_size;
+	}
+	return( 1 );
+}
+
+/* Writes the blocks of a specific layer
+ * The media is divided into clusters of the cluster size, which is determined by
+ * the fragmentation. Every cluster contains a single run of blocks with data at
+ * a pseudo random position, the number of blocks in the run is determined by
+ * the fill percentage
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int generate_handle_write_layer(
+     generate_handle_t *generate_handle,
+     int layer_index,
+     int fill_percentage,
+     libcerror_error_t **error )
+{
+	static char *function          = "generate_handle_write_layer";
+	size_t block_size              = 0;
+	uint64_t block_index           = 0;
+	uint64_t cluster_end_index     = 0;
+	uint64_t cluster_size          = 0;
+	uint64_t cluster_start_index   = 0;
+	uint64_t number_of_blocks      = 0;
+	uint64_t number_of_data_blocks = 0;
+	uint64_t random_state          = 0;
+	uint64_t run_end_index         = 0;
+	uint64_t run_start_index       = 0;
+	off64_t block_offset           = 0;
+	uint8_t is_sequential          = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->block_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid generate handle - missing block size.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( fill_percentage < 0 )
+	 || ( fill_percentage > 100 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid fill percentage value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	generate_handle->number_of_allocated_blocks = 0;
+	generate_handle->written_size               = 0;
+
+	if( ( layer_index == 0 )
+	 && ( generate_handle->output_stream_writer != NULL ) )
+	{
+		is_sequential = 1;
+	}
+	number_of_blocks = generate_handle->media_size / generate_handle->block_size;
+
+	if( ( generate_handle->media_size % generate_handle->block_size ) != 0 )
+	{
+		number_of_blocks += 1;
+	}
+	cluster_size = generate_handle_get_cluster_size(
+	                number_of_blocks,
+	                generate_handle->fragmentation );
+
+	random_state = generate_handle->seed ^ ( ( (uint64_t) layer_index + 1 ) * 0xbf58476d1ce4e5b9ULL );
+
+	for( cluster_start_index = 0;
+	     cluster_start_index < number_of_blocks;
+	     cluster_start_index += cluster_size )
+	{
+		cluster_end_index = cluster_start_index + cluster_size;
+
+		if( cluster_end_index > number_of_blocks )
+		{
+			cluster_end_index = number_of_blocks;
+		}
+		/* The number of blocks with data is derived from the cumulative number
+		 * of blocks so that the total matches the fill percentage
+		 */
+		number_of_data_blocks = ( ( cluster_end_index * (uint64_t) fill_percentage ) / 100 )
+		                      - ( ( cluster_start_index * (uint64_t) fill_percentage ) / 100 );
+
+		run_start_index = cluster_start_index
+		                + ( generate_handle_get_random_value( &random_state )
+		                  % ( cluster_end_index - cluster_start_index - number_of_data_blocks + 1 ) );
+
+		run_end_index = run_start_index + number_of_data_blocks;
+
+		if( is_sequential != 0 )
+		{
+			block_index = cluster_start_index;
+		}
+		else
+		{
+			block_index       = run_start_index;
+			cluster_end_index = run_end_index;
+		}
+		while( block_index < cluster_end_index )
+		{
+			if( generate_handle->abort != 0 )
+			{
+				return( 0 );
+			}
+			block_offset = (off64_t) ( block_index * generate_handle->block_size );
+			block_size   = (size_t) generate_handle->block_size;
+
+			if( block_size > ( generate_handle->media_size - (size64_t) block_offset ) )
+			{
+				block_size = (size_t) ( generate_handle->media_size - (size64_t) block_offset );
+			}
+			if( generate_handle_write_block(
+			     generate_handle,
+			     layer_index,
+			     block_offset,
+			     block_size,
+			     (uint8_t) ( ( block_index >= run_start_index ) && ( block_index < run_end_index ) ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write block: %" PRIu64 " of layer: %d.",
+				 function,
+				 block_index,
+				 layer_index );
+
+				return( -1 );
+			}
+			block_index++;
+		}
+	}
+	return( 1 );
+}
+
+/* Generates the base image and the delta disks
+ * Returns 1 if successful, 0 if aborted or -1 on error
+ */
+int generate_handle_generate(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error )
+{
+	system_character_t *filename = NULL;
+	const char *format_string    = NULL;
+	static char *function        = "generate_handle_generate";
+	size_t filename_size         = 0;
+	ssize_t write_count          = 0;
+	off64_t offset               = 0;
+	int fill_percentage          = 0;
+	int layer_index              = 0;
+	int result                   = 0;
+
+	if( generate_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid generate handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->output_is_open == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid generate handle - output not open.",
+		 function );
+
+		return( -1 );
+	}
+	if( generate_handle->block_data != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid generate handle - block data already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( generate_handle->grain_size == 0 )
+	 || ( generate_handle->block_size == 0 )
+	 || ( generate_handle->block_size > (size32_t) GENERATE_HANDLE_MAXIMUM_BLOCK_SIZE )
+	 || ( ( generate_handle->block_size % generate_handle->grain_size ) != 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid generate handle - block size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	switch( generate_handle->output_format )
+	{
+		case GENERATE_HANDLE_OUTPUT_FORMAT_FLAT:
+			format_string = "flat";
+			break;
+
+		case GENERATE_HANDLE_OUTPUT_FORMAT_SPARSE:
+			format_string = "sparse";
+			break;
+
+		case GENERATE_HANDLE_OUTPUT_FORMAT_SPLIT_SPARSE:
+			format_string = "split";
+			break;
+
+		case GENERATE_HANDLE_OUTPUT_FORMAT_STREAM_OPTIMIZED:
+			format_string = "stream";
+			break;
+
+		default:
+			format_string = "unknown";
+			break;
+	}
+	generate_handle->block_data = (uint8_t *) memory_allocate(
+	                                           sizeof( uint8_t ) * generate_handle->block_size );
+
+	if( generate_handle->block_data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create block data.",
+		 function );
+
+		goto on_error;
+	}
+	filename_size = generate_handle->prefix_size + 12;
+
+	filename = system_string_allocate(
+	            filename_size );
+
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( generate_handle->notify_stream != NULL )
+	{
+		fprintf(
+		 generate_handle->notify_stream,
+		 "Format\t\t\t\t: %s\n"
+		 "Media size\t\t\t: %" PRIu64 " bytes\n"
+		 "Grain size\t\t\t: %" PRIu32 " bytes\n"
+		 "Block size\t\t\t: %" PRIu32 " bytes\n"
+		 "Fill percentage\t\t\t: %d\n"
+		 "Compressibility\t\t\t: %d\n"
+		 "Fragmentation\t\t\t: %d\n"
+		 "Number of delta disks\t\t: %d\n",
+		 format_string,
+		 generate_handle->media_size,
+		 generate_handle->grain_size,
+		 generate_handle->block_size,
+		 generate_handle->fill_percentage,
+		 generate_handle->compressibility,
+		 generate_handle->fragmentation,
+		 generate_handle->number_of_delta_disks );
+
+		if( generate_handle->number_of_delta_disks > 0 )
+		{
+			fprintf(
+			 generate_handle->notify_stream,
+			 "Delta fill percentage\t\t: %d\n",
+			 generate_handle->delta_fill_percentage );
+		}
+		fprintf(
+		 generate_handle->notify_stream,
+		 "Seed\t\t\t\t: %" PRIu64 "\n"
+		 "\n",
+		 generate_handle->seed );
+	}
+	for( layer_index = 0;
+	     layer_index <= generate_handle->number_of_delta_disks;
+	     layer_index++ )
+	{
+		if( layer_index == 0 )
+		{
+			fill_percentage = generate_handle->fill_percentage;
+		}
+		else
+		{
+			if( layer_index == 1 )
+			{
+				if( generate_handle_open_layers(
+				     generate_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_OPEN_FAILED,
+					 "%s: unable to open base image.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			if( generate_handle_create_delta_disk(
+			     generate_handle,
+			     layer_index,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to create delta disk: %d.",
+				 function,
+				 layer_index );
+
+				goto on_error;
+			}
+			fill_percentage = generate_handle->delta_fill_percentage;
+		}
+		result = generate_handle_write_layer(
+		          generate_handle,
+		          layer_index,
+		          fill_percentage,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write layer: %d.",
+			 function,
+			 layer_index );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			break;
+		}
+		if( layer_index == 0 )
+		{
+			/* Write the last byte so the flat extent has the size of the media when it ends without data
+			 */
+			if( ( generate_handle->output_file_io_handle != NULL )
+			 && ( (size64_t) generate_handle->output_end_offset < generate_handle->media_size ) )
+			{
+				offset = (off64_t) generate_handle->media_size - 1;
+
+				if( libbfio_handle_seek_offset(
+				     generate_handle->output_file_io_handle,
+				     offset,
+				     SEEK_SET,
+				     error ) == -1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_SEEK_FAILED,
+					 "%s: unable to seek offset: %" PRIi64 " in output file IO handle.",
+					 function,
+					 offset );
+
+					goto on_error;
+				}
+				write_count = libbfio_handle_write_buffer(
+				               generate_handle->output_file_io_handle,
+				               (uint8_t *) "",
+				               1,
+				               error );
+
+				if( write_count != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write last byte to output file IO handle.",
+					 function );
+
+					goto on_error;
+				}
+				generate_handle->output_end_offset = (off64_t) generate_handle->media_size;
+			}
+			if( generate_handle->output_handle != NULL )
+			{
+				if( libvmdk_handle_flush(
+				     generate_handle->output_handle,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to flush output handle.",
+					 function );
+
+					goto on_error;
+				}
+			}
+			/* The base image is reopened for reading when the delta disks are created
+			 */
+			if( generate_handle_close_output(
+			     generate_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close output.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			if( libvmdk_handle_flush(
+			     generate_handle->layer_handles[ layer_index ],
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to flush layer handle: %d.",
+				 function,
+				 layer_index );
+
+				goto on_error;
+			}
+		}
+		if( generate_handle->notify_stream != NULL )
+		{
+			if( generate_handle_get_layer_filename(
+			     generate_handle,
+			     layer_index,
+			     filename,
+			     filename_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve filename of layer: %d.",
+				 function,
+				 layer_index );
+
+				goto on_error;
+			}
+			fprintf(
+			 generate_handle->notify_stream,
+			 "Layer: %d\t\t\t\t: %" PRIs_SYSTEM "\n"
+			 "\tBlocks with data\t\t: %" PRIu64 "\n"
+			 "\tBytes written\t\t\t: %" PRIu64 "\n"
+			 "\n",
+			 layer_index,
+			 filename,
+			 generate_handle->number_of_allocated_blocks,
+			 generate_handle->written_size );
+		}
+	}
+	memory_free(
+	 filename );
+
+	filename = NULL;
+
+	memory_free(
+	 generate_handle->block_data );
+
+	generate_handle->block_data = NULL;
+
+	if( generate_handle->abort != 0 )
+	{
+		return( 0 );
+	}
+	return( 1 );
+
+on_error:
+	if( filename != NULL )
+	{
+		memory_free(
+		 filename );
+	}
+	if( generate_handle->block_data != NULL )
+	{
+		memory_free(
+		 generate_handle->block_data );
+
+		generate_handle->block_data = NULL;
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,361 @@
+/*
+ * Generate handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _GENERATE_HANDLE_H )
+#define _GENERATE_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vmdktools_libbfio.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default grain size of the sparse and stream-optimized images
+ */
+#define GENERATE_HANDLE_DEFAULT_GRAIN_SIZE		( 64 * 1024 )
+
+/* The minimum grain size
+ */
+#define GENERATE_HANDLE_MINIMUM_GRAIN_SIZE		( 8 * 1024 )
+
+/* The maximum grain size
+ */
+#define GENERATE_HANDLE_MAXIMUM_GRAIN_SIZE		( 1024 * 1024 )
+
+/* The default block size, which is the unit in which data is allocated
+ */
+#define GENERATE_HANDLE_DEFAULT_BLOCK_SIZE		GENERATE_HANDLE_DEFAULT_GRAIN_SIZE
+
+/* The maximum block size
+ */
+#define GENERATE_HANDLE_MAXIMUM_BLOCK_SIZE		( 64 * 1024 * 1024 )
+
+/* The default media size
+ */
+#define GENERATE_HANDLE_DEFAULT_MEDIA_SIZE		( 1024 * 1024 * 1024 )
+
+/* The default percentage of the blocks that contain data
+ */
+#define GENERATE_HANDLE_DEFAULT_FILL_PERCENTAGE		50
+
+/* The default percentage of the blocks that are written to each delta disk
+ */
+#define GENERATE_HANDLE_DEFAULT_DELTA_FILL_PERCENTAGE	10
+
+/* The default percentage of the data that is compressible
+ */
+#define GENERATE_HANDLE_DEFAULT_COMPRESSIBILITY		50
+
+/* The default fragmentation percentage
+ */
+#define GENERATE_HANDLE_DEFAULT_FRAGMENTATION		50
+
+/* The maximum number of delta disks
+ */
+#define GENERATE_HANDLE_MAXIMUM_NUMBER_OF_DELTA_DISKS	64
+
+/* The default number of threads used to compress stream-optimized output
+ */
+#define GENERATE_HANDLE_DEFAULT_NUMBER_OF_THREADS	4
+
+/* The maximum number of threads supported by the stream writer
+ */
+#define GENERATE_HANDLE_MAXIMUM_NUMBER_OF_THREADS	64
+
+/* The default seed of the generated layout and data
+ */
+#define GENERATE_HANDLE_DEFAULT_SEED			1
+
+enum GENERATE_HANDLE_OUTPUT_FORMATS
+{
+	GENERATE_HANDLE_OUTPUT_FORMAT_FLAT,
+	GENERATE_HANDLE_OUTPUT_FORMAT_SPARSE,
+	GENERATE_HANDLE_OUTPUT_FORMAT_SPLIT_SPARSE,
+	GENERATE_HANDLE_OUTPUT_FORMAT_STREAM_OPTIMIZED
+};
+
+typedef struct generate_handle generate_handle_t;
+
+struct generate_handle
+{
+	/* The output format of the base image
+	 */
+	int output_format;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The grain size of the sparse and stream-optimized images
+	 */
+	size32_t grain_size;
+
+	/* The block size
+	 */
+	size32_t block_size;
+
+	/* The percentage of the blocks of the base image that contain data
+	 */
+	int fill_percentage;
+
+	/* The percentage of the blocks that are written to each delta disk
+	 */
+	int delta_fill_percentage;
+
+	/* The percentage of the data that is compressible
+	 */
+	int compressibility;
+
+	/* The fragmentation percentage
+	 */
+	int fragmentation;
+
+	/* The number of delta disks
+	 */
+	int number_of_delta_disks;
+
+	/* The number of threads used to compress stream-optimized output
+	 */
+	int number_of_threads;
+
+	/* The seed of the generated layout and data
+	 */
+	uint64_t seed;
+
+	/* The filename of the base image
+	 */
+	system_character_t *filename;
+
+	/* The filename size
+	 */
+	size_t filename_size;
+
+	/* The filename prefix of the delta disks
+	 */
+	system_character_t *prefix;
+
+	/* The prefix size
+	 */
+	size_t prefix_size;
+
+	/* The layer handles
+	 * The first entry contains the base image followed by the delta disks
+	 */
+	libvmdk_handle_t **layer_handles;
+
+	/* The number of layer handles
+	 */
+	int number_of_layer_handles;
+
+	/* The (sparse) output handle
+	 */
+	libvmdk_handle_t *output_handle;
+
+	/* The stream-optimized output stream writer
+	 */
+	libvmdk_stream_writer_t *output_stream_writer;
+
+	/* The flat extent output file IO handle
+	 */
+	libbfio_handle_t *output_file_io_handle;
+
+	/* Value to indicate the output is open
+	 */
+	int output_is_open;
+
+	/* The end offset of the data written to the flat extent output
+	 */
+	off64_t output_end_offset;
+
+	/* The block data
+	 */
+	uint8_t *block_data;
+
+	/* The number of blocks that contain data
+	 */
+	uint64_t number_of_allocated_blocks;
+
+	/* The number of bytes written
+	 */
+	size64_t written_size;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int generate_handle_initialize(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_free(
+     generate_handle_t **generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_signal_abort(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_set_output_format(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_media_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_grain_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_block_size(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_get_percentage(
+     const system_character_t *string,
+     int *percentage,
+     libcerror_error_t **error );
+
+int generate_handle_set_fill_percentage(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_delta_fill_percentage(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_compressibility(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_fragmentation(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_number_of_delta_disks(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_number_of_threads(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_seed(
+     generate_handle_t *generate_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int generate_handle_set_filename(
+     generate_handle_t *generate_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int generate_handle_get_layer_filename(
+     generate_handle_t *generate_handle,
+     int layer_index,
+     system_character_t *filename,
+     size_t filename_size,
+     libcerror_error_t **error );
+
+int generate_handle_open_output(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_write_flat_descriptor(
+     generate_handle_t *generate_handle,
+     const system_character_t *extent_basename,
+     libcerror_error_t **error );
+
+int generate_handle_close_output(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_open_layers(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+int generate_handle_create_delta_disk(
+     generate_handle_t *generate_handle,
+     int layer_index,
+     libcerror_error_t **error );
+
+int generate_handle_close(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+uint64_t generate_handle_get_random_value(
+          uint64_t *random_state );
+
+uint64_t generate_handle_get_cluster_size(
+          uint64_t number_of_blocks,
+          int fragmentation );
+
+void generate_handle_fill_block(
+      generate_handle_t *generate_handle,
+      int layer_index,
+      off64_t block_offset,
+      size_t block_size );
+
+int generate_handle_write_block(
+     generate_handle_t *generate_handle,
+     int layer_index,
+     off64_t block_offset,
+     size_t block_size,
+     uint8_t is_allocated,
+     libcerror_error_t **error );
+
+int generate_handle_write_layer(
+     generate_handle_t *generate_handle,
+     int layer_index,
+     int fill_percentage,
+     libcerror_error_t **error );
+
+int generate_handle_generate(
+     generate_handle_t *generate_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _GENERATE_HANDLE_H ) */
+
@@ -0,0 +1,1409 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "byte_size_string.h"
+#include "hash_handle.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcpath.h"
+#include "vmdktools_libfvalue.h"
+#include "vmdktools_libvmdk.h"
+
+#define HASH_HANDLE_NOTIFY_STREAM		stdout
+
+/* Creates a hash handle
+ * Make sure the value hash_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_initialize";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid hash handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*hash_handle = memory_allocate_structure(
+	               hash_handle_t );
+
+	if( *hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create hash handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *hash_handle,
+	     0,
+	     sizeof( hash_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear hash handle.",
+		 function );
+
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *hash_handle )->input_handles_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handles array.",
+		 function );
+
+		goto on_error;
+	}
+	( *hash_handle )->chunk_size        = HASH_HANDLE_DEFAULT_CHUNK_SIZE;
+	( *hash_handle )->number_of_threads = HASH_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+	( *hash_handle )->notify_stream     = HASH_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *hash_handle != NULL )
+	{
+		if( ( *hash_handle )->input_handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *hash_handle )->input_handles_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a hash handle
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_free";
+	int result            = 1;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *hash_handle != NULL )
+	{
+		if( ( *hash_handle )->basename != NULL )
+		{
+			memory_free(
+			 ( *hash_handle )->basename );
+		}
+		if( libcdata_array_free(
+		     &( ( *hash_handle )->input_handles_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handles array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *hash_handle );
+
+		*hash_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the hash handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "hash_handle_signal_abort";
+	int input_handle_index         = 0;
+	int number_of_input_handles    = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	hash_handle->abort = 1;
+
+	if( libcdata_array_get_number_of_entries(
+	     hash_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( input_handle_index = 0;
+	     input_handle_index < number_of_input_handles;
+	     input_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     hash_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		if( libvmdk_handle_signal_abort(
+		     input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle: %d to abort.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Sets the chunk size
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int hash_handle_set_chunk_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_chunk_size";
+	size_t string_length  = 0;
+	uint64_t size_value   = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+	if( byte_size_string_convert(
+	     string,
+	     string_length,
+	     &size_value,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	/* The chunk size must be a multiple of the sector size
+	 */
+	if( ( size_value == 0 )
+	 || ( size_value > (uint64_t) HASH_HANDLE_MAXIMUM_CHUNK_SIZE )
+	 || ( ( size_value % 512 ) != 0 ) )
+	{
+		return( 0 );
+	}
+	hash_handle->chunk_size = (size32_t) size_value;
+
+	return( 1 );
+}
+
+/* Sets the number of threads used to hash the chunks
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int hash_handle_set_number_of_threads(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) HASH_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+	{
+		return( 0 );
+	}
+#if !defined( LIBVMDK_HAVE_MULTI_THREAD_SUPPORT )
+	if( value_64bit > 0 )
+	{
+		return( 0 );
+	}
+#endif
+	hash_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+/* Sets the basename
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_set_basename(
+     hash_handle_t *hash_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error )
+{
+	static char *function = "hash_handle_set_basename";
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid basename.",
+		 function );
+
+		return( -1 );
+	}
+	if( basename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing basename.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( basename_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * basename_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid basename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle->basename != NULL )
+	{
+		memory_free(
+		 hash_handle->basename );
+
+		hash_handle->basename      = NULL;
+		hash_handle->basename_size = 0;
+	}
+	hash_handle->basename = system_string_allocate(
+	                        basename_size );
+
+	if( hash_handle->basename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create basename string.",
+		 function );
+
+		goto on_error;
+	}
+	if( system_string_copy(
+	     hash_handle->basename,
+	     basename,
+	     basename_size ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy basename.",
+		 function );
+
+		goto on_error;
+	}
+	hash_handle->basename[ basename_size - 1 ] = 0;
+
+	hash_handle->basename_size = basename_size;
+
+	return( 1 );
+
+on_error:
+	if( hash_handle->basename != NULL )
+	{
+		memory_free(
+		 hash_handle->basename );
+
+		hash_handle->basename = NULL;
+	}
+	hash_handle->basename_size = 0;
+
+	return( -1 );
+}
+
+/* Opens the input of the hash handle
+ * The input is opened together with its parents using the parent filename hints
+ * Returns 1 if successful, 0 if disk type is not supported or -1 on error
+ */
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle     = NULL;
+	system_character_t *basename_end   = NULL;
+	static char *function              = "hash_handle_open_input";
+	size_t basename_length             = 0;
+	size_t filename_length             = 0;
+	uint32_t parent_content_identifier = 0;
+	int disk_type                      = 0;
+	int entry_index                    = 0;
+	int result                         = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	basename_end = system_string_search_character_reverse(
+	                filename,
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
+
+	if( basename_end != NULL )
+	{
+		basename_length = (size_t) ( basename_end - filename ) + 1;
+	}
+	if( basename_length > 0 )
+	{
+		if( hash_handle_set_basename(
+		     hash_handle,
+		     filename,
+		     basename_length,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     input_handle,
+	     filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     input_handle,
+	     filename,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		goto on_error;
+	}
+	/* The input handle is the first entry in the array so that the parents
+	 * are freed after the handles that refer to them
+	 */
+	if( libcdata_array_append_entry(
+	     hash_handle->input_handles_array,
+	     &entry_index,
+	     (intptr_t *) input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append input handle to array.",
+		 function );
+
+		goto on_error;
+	}
+	hash_handle->input_handle = input_handle;
+
+	input_handle = NULL;
+
+	if( libvmdk_handle_get_disk_type(
+	     hash_handle->input_handle,
+	     &disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( disk_type != LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 && ( disk_type != LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	{
+		/* Unsupported disk type
+		 */
+		return( 0 );
+	}
+	result = libvmdk_handle_get_parent_content_identifier(
+		  hash_handle->input_handle,
+		  &parent_content_identifier,
+		  error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier.",
+		 function );
+
+		goto on_error;
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		result = hash_handle_open_input_parent_handle(
+		          hash_handle,
+		          hash_handle->input_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			return( 0 );
+		}
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     hash_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_get_media_size(
+	     hash_handle->input_handle,
+	     &( hash_handle->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( input_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &input_handle,
+		 NULL );
+	}
+	libcdata_array_empty(
+	 hash_handle->input_handles_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+	 NULL );
+
+	hash_handle->input_handle = NULL;
+
+	return( -1 );
+}
+
+/* Opens the parent input handle
+ * Returns 1 if successful, 0 if no parent or -1 on error
+ */
+int hash_handle_open_input_parent_handle(
+     hash_handle_t *hash_handle,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_input_handle = NULL;
+	system_character_t *parent_filename   = NULL;
+	system_character_t *parent_path       = NULL;
+	static char *function                 = "hash_handle_open_input_parent_handle";
+	size_t parent_filename_size           = 0;
+	size_t parent_path_size               = 0;
+	uint32_t parent_content_identifier    = 0;
+	int entry_index                       = 0;
+	int parent_disk_type                  = 0;
+	int result                            = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_filename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_filename_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * parent_filename_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid parent filename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+			   parent_filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename(
+		  input_handle,
+		  (uint16_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename(
+		  input_handle,
+		  (uint8_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( hash_handle->basename == NULL )
+	{
+		parent_path      = parent_filename;
+		parent_path_size = parent_filename_size;
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &parent_path,
+		     &parent_path_size,
+		     hash_handle->basename,
+		     hash_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &parent_path,
+		     &parent_path_size,
+		     hash_handle->basename,
+		     hash_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &parent_input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent input handle: %" PRIs_SYSTEM ".",
+		 function,
+		 parent_path );
+
+		goto on_error;
+	}
+	if( parent_path != NULL )
+	{
+		if( hash_handle->basename != NULL )
+		{
+			memory_free(
+			 parent_path );
+		}
+		parent_path = NULL;
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+
+		parent_filename = NULL;
+	}
+	if( libvmdk_handle_get_disk_type(
+	     parent_input_handle,
+	     &parent_disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	{
+		result = libvmdk_handle_get_parent_content_identifier(
+			  parent_input_handle,
+			  &parent_content_identifier,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent content identifier.",
+			 function );
+
+			goto on_error;
+		}
+		else if( ( result != 0 )
+		      && ( parent_content_identifier != 0xffffffffUL ) )
+		{
+			result = hash_handle_open_input_parent_handle(
+				  hash_handle,
+				  parent_input_handle,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open parent input handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			result = 1;
+		}
+	}
+	else
+	{
+		/* Unsupported disk type
+		 */
+		result = 0;
+	}
+	if( result != 0 )
+	{
+		if( libvmdk_handle_open_extent_data_files(
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent extent data files.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_set_parent_handle(
+		     input_handle,
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     hash_handle->input_handles_array,
+		     &entry_index,
+		     (intptr_t *) parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append parent input handle to array.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	else
+	{
+		if( libvmdk_handle_close(
+		     parent_input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_free(
+		     &parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	return( result );
+
+on_error:
+	if( parent_input_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &parent_input_handle,
+		 NULL );
+	}
+	if( ( parent_path != NULL )
+	 && ( hash_handle->basename != NULL ) )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+/* Closes the hash handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int hash_handle_close(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "hash_handle_close";
+	int input_handle_index         = 0;
+	int number_of_input_handles    = 0;
+	int result                     = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     hash_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	/* Close the delta disks before their parents
+	 */
+	for( input_handle_index = 0;
+	     input_handle_index < number_of_input_handles;
+	     input_handle_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     hash_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		if( libvmdk_handle_close(
+		     input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			result = -1;
+		}
+	}
+	return( result );
+}
+
+/* Prints a digest as a hexadecimal string
+ */
+void hash_handle_digest_fprint(
+      FILE *stream,
+      const uint8_t *digest )
+{
+	size_t digest_index = 0;
+
+	if( ( stream == NULL )
+	 || ( digest == NULL ) )
+	{
+		return;
+	}
+	for( digest_index = 0;
+	     digest_index < LIBVMDK_SHA256_DIGEST_SIZE;
+	     digest_index++ )
+	{
+		fprintf(
+		 stream,
+		 "%02" PRIx8 "",
+		 digest[ digest_index ] );
+	}
+}
+
+/* Calculates the chunk digests and the root digest of the input and prints them
+ * Every chunk is printed as its offset, size and SHA-256 digest
+ * Returns 1 if successful or -1 on error
+ */
+int hash_handle_calculate_digests(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error )
+{
+	uint8_t root_digest[ LIBVMDK_SHA256_DIGEST_SIZE ];
+
+	uint8_t *chunk_digests     = NULL;
+	static char *function      = "hash_handle_calculate_digests";
+	size64_t chunk_data_size   = 0;
+	size_t chunk_digests_size  = 0;
+	off64_t chunk_offset       = 0;
+	uint64_t chunk_index       = 0;
+	uint64_t number_of_chunks  = 0;
+
+	if( hash_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid hash handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( hash_handle->chunk_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid hash handle - missing chunk size.",
+		 function );
+
+		return( -1 );
+	}
+	number_of_chunks = hash_handle->media_size / hash_handle->chunk_size;
+
+	if( ( hash_handle->media_size % hash_handle->chunk_size ) != 0 )
+	{
+		number_of_chunks += 1;
+	}
+	if( number_of_chunks == 0 )
+	{
+		chunk_digests_size = LIBVMDK_SHA256_DIGEST_SIZE;
+	}
+	else
+	{
+		if( number_of_chunks > (uint64_t) ( SSIZE_MAX / LIBVMDK_SHA256_DIGEST_SIZE ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+			 "%s: invalid number of chunks value exceeds maximum.",
+			 function );
+
+			goto on_error;
+		}
+		chunk_digests_size = (size_t) ( number_of_chunks * LIBVMDK_SHA256_DIGEST_SIZE );
+	}
+	chunk_digests = (uint8_t *) memory_allocate(
+	                             sizeof( uint8_t ) * chunk_digests_size );
+
+	if( chunk_digests == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create chunk digests.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_calculate_chunk_digests(
+	     hash_handle->input_handle,
+	     hash_handle->chunk_size,
+	     hash_handle->number_of_threads,
+	     chunk_digests,
+	     chunk_digests_size,
+	     root_digest,
+	     LIBVMDK_SHA256_DIGEST_SIZE,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to calculate chunk digests.",
+		 function );
+
+		goto on_error;
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "Chunk size\t\t\t: %" PRIu32 " bytes\n",
+	 hash_handle->chunk_size );
+
+	fprintf(
+	 hash_handle->notify_stream,
+	 "Number of chunks\t\t: %" PRIu64 "\n",
+	 number_of_chunks );
+
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\n" );
+
+	for( chunk_index = 0;
+	     chunk_index < number_of_chunks;
+	     chunk_index++ )
+	{
+		chunk_data_size = hash_handle->media_size - (size64_t) chunk_offset;
+
+		if( chunk_data_size > (size64_t) hash_handle->chunk_size )
+		{
+			chunk_data_size = (size64_t) hash_handle->chunk_size;
+		}
+		fprintf(
+		 hash_handle->notify_stream,
+		 "%" PRIi64 "\t%" PRIu64 "\t",
+		 chunk_offset,
+		 chunk_data_size );
+
+		hash_handle_digest_fprint(
+		 hash_handle->notify_stream,
+		 &( chunk_digests[ chunk_index * LIBVMDK_SHA256_DIGEST_SIZE ] ) );
+
+		fprintf(
+		 hash_handle->notify_stream,
+		 "\n" );
+
+		chunk_offset += (off64_t) chunk_data_size;
+	}
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\n" );
+
+	fprintf(
+	 hash_handle->notify_stream,
+	 "Root digest (SHA-256)\t\t: " );
+
+	hash_handle_digest_fprint(
+	 hash_handle->notify_stream,
+	 root_digest );
+
+	fprintf(
+	 hash_handle->notify_stream,
+	 "\n\n" );
+
+	memory_free(
+	 chunk_digests );
+
+	return( 1 );
+
+on_error:
+	if( chunk_digests != NULL )
+	{
+		memory_free(
+		 chunk_digests );
+	}
+	return( -1 );
+}
+
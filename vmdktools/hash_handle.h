@@ -0,0 +1,154 @@
+/*
+ * Hash handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _HASH_HANDLE_H )
+#define _HASH_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default chunk size
+ */
+#define HASH_HANDLE_DEFAULT_CHUNK_SIZE			( 1024 * 1024 )
+
+/* The maximum chunk size
+ */
+#define HASH_HANDLE_MAXIMUM_CHUNK_SIZE			( 64 * 1024 * 1024 )
+
+/* The default number of threads used to hash the chunks
+ */
+#if defined( LIBVMDK_HAVE_MULTI_THREAD_SUPPORT )
+#define HASH_HANDLE_DEFAULT_NUMBER_OF_THREADS		4
+#else
+#define HASH_HANDLE_DEFAULT_NUMBER_OF_THREADS		0
+#endif
+
+/* The maximum number of threads supported by the library
+ */
+#define HASH_HANDLE_MAXIMUM_NUMBER_OF_THREADS		64
+
+typedef struct hash_handle hash_handle_t;
+
+struct hash_handle
+{
+	/* The basename
+	 */
+	system_character_t *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
+	/* The input handles array
+	 * The first entry contains the input handle followed by its parents
+	 */
+	libcdata_array_t *input_handles_array;
+
+	/* The input handle
+	 */
+	libvmdk_handle_t *input_handle;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The chunk size
+	 */
+	size32_t chunk_size;
+
+	/* The number of threads used to hash the chunks
+	 */
+	int number_of_threads;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int hash_handle_initialize(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_free(
+     hash_handle_t **hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_signal_abort(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+int hash_handle_set_chunk_size(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_number_of_threads(
+     hash_handle_t *hash_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int hash_handle_set_basename(
+     hash_handle_t *hash_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error );
+
+int hash_handle_open_input(
+     hash_handle_t *hash_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int hash_handle_open_input_parent_handle(
+     hash_handle_t *hash_handle,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error );
+
+int hash_handle_close(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+void hash_handle_digest_fprint(
+      FILE *stream,
+      const uint8_t *digest );
+
+int hash_handle_calculate_digests(
+     hash_handle_t *hash_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _HASH_HANDLE_H ) */
+
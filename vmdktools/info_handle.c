@@ -206,6 +206,46 @@ int info_handle_signal_abort(
 			return( -1 );
 		}
 	}
+	info_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Sets the statistics flags of the input handle
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_set_statistics_flags(
+     info_handle_t *info_handle,
+     uint8_t statistics_flags,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_set_statistics_flags";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_set_statistics_flags(
+	     info_handle->input_handle,
+	     statistics_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set statistics flags of input handle.",
+		 function );
+
+		return( -1 );
+	}
 	return( 1 );
 }
 
@@ -279,6 +319,49 @@ int info_handle_open_input(
 	return( 1 );
 }
 
+/* Opens the extent data files of the input
+ * The extent data files are only opened once
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_open_extent_data_files(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "info_handle_open_extent_data_files";
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle->extent_data_files_opened != 0 )
+	{
+		return( 1 );
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     info_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		return( -1 );
+	}
+	info_handle->extent_data_files_opened = 1;
+
+	return( 1 );
+}
+
 /* Closes the info handle
  * Returns the 0 if succesful or -1 on error
  */
@@ -959,3 +1042,513 @@ on_error:
 	return( -1 );
 }
 
+/* Prints the zero data statistics
+ * Reads the allocated grains to determine which ones only contain 0-byte values
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_zero_statistics_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	static char *function    = "info_handle_zero_statistics_fprint";
+	size64_t allocated_size  = 0;
+	size64_t media_size      = 0;
+	size64_t parent_size     = 0;
+	size64_t range_size      = 0;
+	size64_t sparse_size     = 0;
+	size64_t zero_size       = 0;
+	off64_t offset           = 0;
+	uint32_t range_flags     = 0;
+	int result               = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle_open_extent_data_files(
+	     info_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_set_zero_detection(
+	     info_handle->input_handle,
+	     1,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to enable zero detection.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     info_handle->input_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	while( (size64_t) offset < media_size )
+	{
+		if( info_handle->abort != 0 )
+		{
+			return( -1 );
+		}
+		result = libvmdk_handle_get_data_range_at_offset(
+		          info_handle->input_handle,
+		          offset,
+		          &range_size,
+		          &range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( ( result == 0 )
+		      || ( range_size == 0 ) )
+		{
+			break;
+		}
+		if( ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			sparse_size += range_size;
+		}
+		else if( ( range_flags & LIBVMDK_RANGE_FLAG_IN_PARENT ) != 0 )
+		{
+			parent_size += range_size;
+		}
+		else
+		{
+			allocated_size += range_size;
+
+			if( ( range_flags & LIBVMDK_RANGE_FLAG_IS_ZERO ) != 0 )
+			{
+				zero_size += range_size;
+			}
+		}
+		offset += (off64_t) range_size;
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Zero data statistics:\n" );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tAllocated data size:\t\t%" PRIu64 " bytes\n",
+	 allocated_size );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tAllocated zero data size:\t%" PRIu64 " bytes\n",
+	 zero_size );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tSparse data size:\t\t%" PRIu64 " bytes\n",
+	 sparse_size );
+
+	if( parent_size > 0 )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tParent data size:\t\t%" PRIu64 " bytes\n",
+		 parent_size );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Prints the open phases
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_open_phases_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	const char *open_phase_descriptions[ 6 ] = {
+		"Descriptor",
+		"Extent data files",
+		"File header",
+		"File footer",
+		"Grain directory",
+		"Backup grain directory" };
+
+	uint64_t values[ 4 ];
+
+	static char *function = "info_handle_open_phases_fprint";
+	int open_phase        = 0;
+	int value_type        = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle_open_extent_data_files(
+	     info_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Open phases:\n" );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\t%-24s %14s %10s %10s %14s\n",
+	 "Phase",
+	 "Duration (ms)",
+	 "Reads",
+	 "Seeks",
+	 "Bytes read" );
+
+	for( open_phase = LIBVMDK_OPEN_PHASE_DESCRIPTOR;
+	     open_phase <= LIBVMDK_OPEN_PHASE_BACKUP_GRAIN_DIRECTORY;
+	     open_phase++ )
+	{
+		for( value_type = LIBVMDK_OPEN_PHASE_VALUE_DURATION;
+		     value_type <= LIBVMDK_OPEN_PHASE_VALUE_NUMBER_OF_SEEKS;
+		     value_type++ )
+		{
+			if( libvmdk_handle_get_open_phase_value(
+			     info_handle->input_handle,
+			     open_phase,
+			     value_type,
+			     &( values[ value_type - 1 ] ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve value: %d of open phase: %d.",
+				 function,
+				 value_type,
+				 open_phase );
+
+				return( -1 );
+			}
+		}
+		fprintf(
+		 info_handle->notify_stream,
+		 "\t%-24s %10" PRIu64 ".%03" PRIu64 " %10" PRIu64 " %10" PRIu64 " %14" PRIu64 "\n",
+		 open_phase_descriptions[ open_phase - 1 ],
+		 values[ LIBVMDK_OPEN_PHASE_VALUE_DURATION - 1 ] / 1000000,
+		 ( values[ LIBVMDK_OPEN_PHASE_VALUE_DURATION - 1 ] / 1000 ) % 1000,
+		 values[ LIBVMDK_OPEN_PHASE_VALUE_NUMBER_OF_READS - 1 ],
+		 values[ LIBVMDK_OPEN_PHASE_VALUE_NUMBER_OF_SEEKS - 1 ],
+		 values[ LIBVMDK_OPEN_PHASE_VALUE_READ_SIZE - 1 ] );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\n" );
+
+	return( 1 );
+}
+
+/* Prints the allocation values of an extent or of all extents
+ */
+void info_handle_allocation_values_fprint(
+      info_handle_t *info_handle,
+      const uint64_t *values,
+      uint64_t uncompressed_data_size )
+{
+	uint64_t percentage = 0;
+
+	if( ( info_handle == NULL )
+	 || ( values == NULL ) )
+	{
+		return;
+	}
+	if( values[ LIBVMDK_ALLOCATION_VALUE_GRAIN_SIZE ] != 0 )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tGrain size:\t\t\t%" PRIu64 " bytes\n",
+		 values[ LIBVMDK_ALLOCATION_VALUE_GRAIN_SIZE ] );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tNumber of grains:\t\t%" PRIu64 "\n",
+	 values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_GRAINS ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tNumber of allocated grains:\t%" PRIu64 "\n",
+	 values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_ALLOCATED_GRAINS ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tNumber of sparse grains:\t%" PRIu64 "\n",
+	 values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_SPARSE_GRAINS ] );
+
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tNumber of compressed grains:\t%" PRIu64 "\n",
+	 values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_COMPRESSED_GRAINS ] );
+
+	if( uncompressed_data_size > 0 )
+	{
+		/* The percentage is printed with 2 decimals hence it is calculated in hundredths
+		 */
+		percentage = ( values[ LIBVMDK_ALLOCATION_VALUE_COMPRESSED_DATA_SIZE ] * 10000 ) / uncompressed_data_size;
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tCompressed data size:\t\t%" PRIu64 " bytes (%" PRIu64 ".%02" PRIu64 "%% of %" PRIu64 " bytes)\n",
+		 values[ LIBVMDK_ALLOCATION_VALUE_COMPRESSED_DATA_SIZE ],
+		 percentage / 100,
+		 percentage % 100,
+		 uncompressed_data_size );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tNumber of grain tables:\t\t%" PRIu64 " (%" PRIu64 " allocated)\n",
+	 values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_GRAIN_TABLES ],
+	 values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_ALLOCATED_GRAIN_TABLES ] );
+
+	if( values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_GRAIN_TABLE_ENTRIES ] > 0 )
+	{
+		percentage = ( values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_ALLOCATED_GRAINS ] * 10000 )
+		           / values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_GRAIN_TABLE_ENTRIES ];
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tGrain table fill:\t\t%" PRIu64 ".%02" PRIu64 "%%\n",
+		 percentage / 100,
+		 percentage % 100 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "\tNumber of fragments:\t\t%" PRIu64 "\n",
+	 values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_FRAGMENTS ] );
+
+	/* The fragmentation is 0% when the allocated grains are stored contiguously
+	 * and 100% when none of them is stored directly after the previous one
+	 */
+	if( values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_ALLOCATED_GRAINS ] > 1 )
+	{
+		percentage = ( ( values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_FRAGMENTS ] - 1 ) * 10000 )
+		           / ( values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_ALLOCATED_GRAINS ] - 1 );
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tFragmentation:\t\t\t%" PRIu64 ".%02" PRIu64 "%%\n",
+		 percentage / 100,
+		 percentage % 100 );
+	}
+}
+
+/* Prints the allocation and compression statistics
+ * The statistics are determined from the grain directories and grain tables only
+ * Returns 1 if successful or -1 on error
+ */
+int info_handle_allocation_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error )
+{
+	uint64_t total_values[ LIBVMDK_NUMBER_OF_ALLOCATION_VALUES ];
+	uint64_t values[ LIBVMDK_NUMBER_OF_ALLOCATION_VALUES ];
+
+	static char *function                 = "info_handle_allocation_fprint";
+	uint64_t total_uncompressed_data_size = 0;
+	uint64_t uncompressed_data_size       = 0;
+	int extent_index                      = 0;
+	int number_of_extents                 = 0;
+	int number_of_sparse_extents          = 0;
+	int result                            = 0;
+	int value_index                       = 0;
+
+	if( info_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid info handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( info_handle_open_extent_data_files(
+	     info_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_number_of_extents(
+	     info_handle->input_handle,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     total_values,
+	     0,
+	     sizeof( uint64_t ) * LIBVMDK_NUMBER_OF_ALLOCATION_VALUES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear total values.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 info_handle->notify_stream,
+	 "Allocation statistics:\n" );
+
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( info_handle->abort != 0 )
+		{
+			return( -1 );
+		}
+		result = libvmdk_handle_get_extent_allocation_values(
+		          info_handle->input_handle,
+		          extent_index,
+		          values,
+		          LIBVMDK_NUMBER_OF_ALLOCATION_VALUES,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve extent: %d allocation values.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		uncompressed_data_size = values[ LIBVMDK_ALLOCATION_VALUE_NUMBER_OF_COMPRESSED_GRAINS ]
+		                       * values[ LIBVMDK_ALLOCATION_VALUE_GRAIN_SIZE ];
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "Extent: %d\n",
+		 extent_index + 1 );
+
+		info_handle_allocation_values_fprint(
+		 info_handle,
+		 values,
+		 uncompressed_data_size );
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
+
+		for( value_index = 0;
+		     value_index < LIBVMDK_NUMBER_OF_ALLOCATION_VALUES;
+		     value_index++ )
+		{
+			total_values[ value_index ] += values[ value_index ];
+		}
+		total_uncompressed_data_size += uncompressed_data_size;
+
+		number_of_sparse_extents++;
+	}
+	if( number_of_sparse_extents == 0 )
+	{
+		fprintf(
+		 info_handle->notify_stream,
+		 "\tNot available for extents without grain tables.\n\n" );
+	}
+	else if( number_of_sparse_extents > 1 )
+	{
+		/* The grain size can differ between extents
+		 */
+		total_values[ LIBVMDK_ALLOCATION_VALUE_GRAIN_SIZE ] = 0;
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "Total:\n" );
+
+		info_handle_allocation_values_fprint(
+		 info_handle,
+		 total_values,
+		 total_uncompressed_data_size );
+
+		fprintf(
+		 info_handle->notify_stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
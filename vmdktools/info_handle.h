@@ -42,9 +42,17 @@ struct info_handle
 	 */
 	libvmdk_handle_t *input_handle;
 
+	/* Value to indicate the extent data files were opened
+	 */
+	uint8_t extent_data_files_opened;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
 };
 
 int info_handle_initialize(
@@ -59,12 +67,21 @@ int info_handle_signal_abort(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_set_statistics_flags(
+     info_handle_t *info_handle,
+     uint8_t statistics_flags,
+     libcerror_error_t **error );
+
 int info_handle_open_input(
      info_handle_t *info_handle,
      system_character_t * const * filenames,
      int number_of_filenames,
      libcerror_error_t **error );
 
+int info_handle_open_extent_data_files(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 int info_handle_close(
      info_handle_t *info_handle,
      libcerror_error_t **error );
@@ -73,6 +90,23 @@ int info_handle_file_fprint(
      info_handle_t *info_handle,
      libcerror_error_t **error );
 
+int info_handle_zero_statistics_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
+int info_handle_open_phases_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
+void info_handle_allocation_values_fprint(
+      info_handle_t *info_handle,
+      const uint64_t *values,
+      uint64_t uncompressed_data_size );
+
+int info_handle_allocation_fprint(
+     info_handle_t *info_handle,
+     libcerror_error_t **error );
+
 #if defined( __cplusplus )
 }
 #endif
@@ -0,0 +1,141 @@
+/*
+ * Merge handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _MERGE_HANDLE_H )
+#define _MERGE_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default process buffer size, a multiple of the grain size
+ */
+#define MERGE_HANDLE_DEFAULT_PROCESS_BUFFER_SIZE	( 8 * 1024 * 1024 )
+
+typedef struct merge_handle merge_handle_t;
+
+struct merge_handle
+{
+	/* The basename
+	 */
+	system_character_t *basename;
+
+	/* The basename size
+	 */
+	size_t basename_size;
+
+	/* The input handles array
+	 * The first entry contains the input handle followed by its parents
+	 */
+	libcdata_array_t *input_handles_array;
+
+	/* The input handle
+	 */
+	libvmdk_handle_t *input_handle;
+
+	/* The output handle
+	 */
+	libvmdk_handle_t *output_handle;
+
+	/* Value to indicate the output handle is open
+	 */
+	int output_is_open;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The process buffer size
+	 */
+	size_t process_buffer_size;
+
+	/* The number of bytes copied
+	 */
+	size64_t copied_size;
+
+	/* The number of bytes that were sparse in all layers
+	 */
+	size64_t sparse_size;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int merge_handle_initialize(
+     merge_handle_t **merge_handle,
+     libcerror_error_t **error );
+
+int merge_handle_free(
+     merge_handle_t **merge_handle,
+     libcerror_error_t **error );
+
+int merge_handle_signal_abort(
+     merge_handle_t *merge_handle,
+     libcerror_error_t **error );
+
+int merge_handle_open_input(
+     merge_handle_t *merge_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int merge_handle_open_input_parent_handle(
+     merge_handle_t *merge_handle,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error );
+
+int merge_handle_open_output(
+     merge_handle_t *merge_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+int merge_handle_close(
+     merge_handle_t *merge_handle,
+     libcerror_error_t **error );
+
+int merge_handle_merge(
+     merge_handle_t *merge_handle,
+     libcerror_error_t **error );
+
+int merge_handle_set_basename(
+     merge_handle_t *merge_handle,
+     const system_character_t *basename,
+     size_t basename_size,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _MERGE_HANDLE_H ) */
+
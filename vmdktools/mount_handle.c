@@ -27,10 +27,13 @@
 #include <wide_string.h>
 
 #include "mount_handle.h"
+#include "parent_registry.h"
 #include "vmdktools_libcdata.h"
 #include "vmdktools_libcerror.h"
 #include "vmdktools_libcnotify.h"
 #include "vmdktools_libcpath.h"
+#include "vmdktools_libcthreads.h"
+#include "vmdktools_libfvalue.h"
 #include "vmdktools_libvmdk.h"
 
 /* Creates a mount handle
@@ -93,6 +96,8 @@ int mount_handle_initialize(
 
 		goto on_error;
 	}
+	( *mount_handle )->number_of_threads = 1;
+
 	if( libcdata_array_initialize(
 	     &( ( *mount_handle )->input_handles_array ),
 	     0,
@@ -107,11 +112,32 @@ int mount_handle_initialize(
 
 		goto on_error;
 	}
+	if( libcdata_array_initialize(
+	     &( ( *mount_handle )->readers_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize readers array.",
+		 function );
+
+		goto on_error;
+	}
 	return( 1 );
 
 on_error:
 	if( *mount_handle != NULL )
 	{
+		if( ( *mount_handle )->input_handles_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *mount_handle )->input_handles_array ),
+			 NULL,
+			 NULL );
+		}
 		memory_free(
 		 *mount_handle );
 
@@ -162,6 +188,58 @@ int mount_handle_free(
 
 			result = -1;
 		}
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+		if( ( *mount_handle )->readers_queue != NULL )
+		{
+			/* The input handles arrays in the queue are owned by the readers array
+			 */
+			if( libcthreads_queue_free(
+			     &( ( *mount_handle )->readers_queue ),
+			     NULL,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free readers queue.",
+				 function );
+
+				result = -1;
+			}
+		}
+#endif
+		if( libcdata_array_free(
+		     &( ( *mount_handle )->readers_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &mount_handle_free_input_handles_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free readers array.",
+			 function );
+
+			result = -1;
+		}
+		if( ( ( *mount_handle )->cache_pool_created_in_handle != 0 )
+		 && ( ( *mount_handle )->cache_pool != NULL ) )
+		{
+			if( libvmdk_cache_pool_free(
+			     &( ( *mount_handle )->cache_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free cache pool.",
+				 function );
+
+				result = -1;
+			}
+		}
 		memory_free(
 		 *mount_handle );
 
@@ -177,10 +255,13 @@ int mount_handle_signal_abort(
      mount_handle_t *mount_handle,
      libcerror_error_t **error )
 {
-	libvmdk_handle_t *input_handle = NULL;
-	static char *function          = "mount_handle_signal_abort";	
-	int input_handle_index         = 0;
-	int number_of_input_handles    = 0;
+	libcdata_array_t *input_handles_array = NULL;
+	libvmdk_handle_t *input_handle        = NULL;
+	static char *function                 = "mount_handle_signal_abort";
+	int input_handle_index                = 0;
+	int number_of_input_handles           = 0;
+	int number_of_readers                 = 0;
+	int reader_index                      = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -242,27 +323,108 @@ int mount_handle_signal_abort(
 			return( -1 );
 		}
 	}
+	if( libcdata_array_get_number_of_entries(
+	     mount_handle->readers_array,
+	     &number_of_readers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of readers.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 1;
+	     reader_index <= number_of_readers;
+	     reader_index++ )
+	{
+		if( mount_handle_get_reader(
+		     mount_handle,
+		     reader_index,
+		     &input_handles_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader: %d.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+		if( libcdata_array_get_number_of_entries(
+		     input_handles_array,
+		     &number_of_input_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of input handles of reader: %d.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+		for( input_handle_index = number_of_input_handles - 1;
+		     input_handle_index >= 0;
+		     input_handle_index-- )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     input_handles_array,
+			     input_handle_index,
+			     (intptr_t **) &input_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve input handle: %d of reader: %d.",
+				 function,
+				 input_handle_index,
+				 reader_index );
+
+				return( -1 );
+			}
+			if( libvmdk_handle_signal_abort(
+			     input_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to signal input handle: %d of reader: %d to abort.",
+				 function,
+				 input_handle_index,
+				 reader_index );
+
+				return( -1 );
+			}
+		}
+	}
 	return( 1 );
 }
 
-/* Opens the input of the mount handle
- * Returns 1 if successful, 0 if disk type is not supported or -1 on error
+/* Sets the number of threads used to serve requests
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
  */
-int mount_handle_open_input(
+int mount_handle_set_number_of_threads(
      mount_handle_t *mount_handle,
-     system_character_t * const * filenames,
-     int number_of_filenames,
+     const system_character_t *string,
      libcerror_error_t **error )
 {
-	libvmdk_handle_t *input_handle     = NULL;
-	system_character_t *basename_end   = NULL;
-	static char *function              = "mount_handle_open_input";
-	size_t basename_length             = 0;
-	size_t filename_length             = 0;
-	uint32_t parent_content_identifier = 0;
-	int disk_type                      = 0;
-	int entry_index                    = 0;
-	int result                         = 0;
+	static char *function = "mount_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -275,274 +437,255 @@ int mount_handle_open_input(
 
 		return( -1 );
 	}
-	if( filenames == NULL )
+	if( string == NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid filenames.",
+		 "%s: invalid string.",
 		 function );
 
 		return( -1 );
 	}
-	if( number_of_filenames <= 0 )
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-		 "%s: number of filenames value out of bounds.",
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
 		 function );
 
 		return( -1 );
 	}
-	filename_length = system_string_length(
-	                   filenames[ 0 ] );
-
-	basename_end = system_string_search_character_reverse(
-	                filenames[ 0 ],
-	                (system_character_t) LIBCPATH_SEPARATOR,
-	                filename_length + 1 );
-
-	if( basename_end != NULL )
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) MOUNT_HANDLE_MAXIMUM_NUMBER_OF_THREADS ) )
 	{
-		basename_length = (size_t) ( basename_end - filenames[ 0 ] ) + 1;
+		return( 0 );
 	}
-	if( basename_length > 0 )
+	mount_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Copies a cache size in MiB from a string
+ * Returns 1 if successful, 0 if the cache size is not supported or -1 on error
+ */
+int mount_handle_copy_string_to_cache_size(
+     const system_character_t *string,
+     size64_t *cache_size,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_copy_string_to_cache_size";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( string == NULL )
 	{
-		if( mount_handle_set_basename(
-		     mount_handle,
-		     filenames[ 0 ],
-		     basename_length,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set basename.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
 
-			goto on_error;
-		}
+		return( -1 );
 	}
-	if( libvmdk_handle_initialize(
-	     &input_handle,
-	     error ) != 1 )
+	if( cache_size == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize input handle.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid cache size.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
+	string_length = system_string_length(
+	                 string );
+
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	if( libvmdk_handle_open_wide(
-	     input_handle,
-	     filenames[ 0 ],
-	     LIBVMDK_OPEN_READ,
-	     error ) != 1 )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
 #else
-	if( libvmdk_handle_open(
-	     input_handle,
-	     filenames[ 0 ],
-	     LIBVMDK_OPEN_READ,
-	     error ) != 1 )
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
 #endif
+	if( result != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open input handle.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( libvmdk_handle_get_disk_type(
-	     input_handle,
-	     &disk_type,
-	     error ) != 1 )
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) MOUNT_HANDLE_MAXIMUM_CACHE_SIZE ) )
+	{
+		return( 0 );
+	}
+	*cache_size = (size64_t) value_64bit * 1024 * 1024;
+
+	return( 1 );
+}
+
+/* Sets the maximum cache size in MiB
+ * Creates a cache pool that is shared by the input handles
+ * Returns 1 if successful, 0 if the cache size is not supported or -1 on error
+ */
+int mount_handle_set_maximum_cache_size(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function       = "mount_handle_set_maximum_cache_size";
+	size64_t maximum_cache_size = 0;
+	int result                  = 0;
+
+	if( mount_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve disk type.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
-	 || ( disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
-	 || ( disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
-	 || ( disk_type == LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
-	 || ( disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT )
-	 || ( disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
-	 || ( disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
-	 || ( disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE )
-	 || ( disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	if( mount_handle->cache_pool != NULL )
 	{
-		result = libvmdk_handle_get_parent_content_identifier(
-			  input_handle,
-			  &parent_content_identifier,
-			  error );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mount handle - cache pool already set.",
+		 function );
+
+		return( -1 );
+	}
+	result = mount_handle_copy_string_to_cache_size(
+	          string,
+	          &maximum_cache_size,
+	          error );
 
+	if( result != 1 )
+	{
 		if( result == -1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve parent content identifier.",
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy string to cache size.",
 			 function );
-
-			goto on_error;
 		}
-		else if( ( result != 0 )
-		      && ( parent_content_identifier != 0xffffffffUL ) )
-		{
-			result = mount_handle_open_input_parent_handle(
-			          mount_handle,
-			          input_handle,
-			          error );
+		return( result );
+	}
+	if( libvmdk_cache_pool_initialize(
+	     &( mount_handle->cache_pool ),
+	     maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize cache pool.",
+		 function );
 
-			if( result == -1 )
-			{
-				libcerror_error_set(
-				 error,
-				 LIBCERROR_ERROR_DOMAIN_IO,
-				 LIBCERROR_IO_ERROR_OPEN_FAILED,
-				 "%s: unable to open parent input handle.",
-				 function );
+		return( -1 );
+	}
+	mount_handle->cache_pool_created_in_handle = 1;
 
-				goto on_error;
-			}
-		}
-		else
-		{
-			result = 1;
-		}
-	}
-	else
-	{
-		/* Unsupported disk type
-		 */
-		result = 0;
-	}
-	if( result != 0 )
-	{
-/* TODO add support for passing extent data files ? */
-		if( number_of_filenames != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
-			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
-			 "%s: unsupported number of filenames.",
-			 function );
-
-			goto on_error;
-		}
-		result = libvmdk_handle_open_extent_data_files(
-			  input_handle,
-			  error );
-
-		if( result != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to open extent data files.",
-			 function );
+	return( 1 );
+}
 
-			goto on_error;
-		}
-		if( libcdata_array_append_entry(
-		     mount_handle->input_handles_array,
-		     &entry_index,
-		     (intptr_t *) input_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append input handle to array.",
-			 function );
+/* Sets a cache pool that is shared by the input handles
+ * The cache pool is not managed by the mount handle and must outlive it
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_set_cache_pool(
+     mount_handle_t *mount_handle,
+     libvmdk_cache_pool_t *cache_pool,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_set_cache_pool";
 
-			goto on_error;
-		}
-	}
-	else
+	if( mount_handle == NULL )
 	{
-		if( libvmdk_handle_close(
-		     input_handle,
-		     error ) != 0 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close input handle.",
-			 function );
-
-			goto on_error;
-		}
-		if( libvmdk_handle_free(
-		     &input_handle,
-		     error ) != 1 )
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free input handle.",
-			 function );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
 
-			goto on_error;
-		}
+		return( -1 );
 	}
-	return( result );
-
-on_error:
-	if( input_handle != NULL )
+	if( mount_handle->cache_pool != NULL )
 	{
-		libvmdk_handle_free(
-		 &input_handle,
-		 NULL );
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mount handle - cache pool already set.",
+		 function );
+
+		return( -1 );
 	}
-	libcdata_array_empty(
-	 mount_handle->input_handles_array,
-	 (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
-	 NULL );
+	mount_handle->cache_pool                   = cache_pool;
+	mount_handle->cache_pool_created_in_handle = 0;
 
-	return( -1 );
+	return( 1 );
 }
 
-/* Opens the parent input handle
- * Returns 1 if successful, 0 if no parent or -1 on error
+/* Sets a parent registry that is used to share the parent input handles
+ * The parent registry is not managed by the mount handle and must outlive it
+ * Returns 1 if successful or -1 on error
  */
-int mount_handle_open_input_parent_handle(
+int mount_handle_set_parent_registry(
      mount_handle_t *mount_handle,
-     libvmdk_handle_t *input_handle,
+     parent_registry_t *parent_registry,
      libcerror_error_t **error )
 {
-	libvmdk_handle_t *parent_input_handle = NULL;
-	system_character_t *parent_filename   = NULL;
-	system_character_t *parent_path       = NULL;
-	static char *function                 = "mount_handle_open_input_parent_handle";
-	size_t parent_filename_size           = 0;
-	size_t parent_path_size               = 0;
-	uint32_t parent_content_identifier    = 0;
-	int entry_index                       = 0;
-	int parent_disk_type                  = 0;
-	int result                            = 0;
+	static char *function = "mount_handle_set_parent_registry";
 
 	if( mount_handle == NULL )
 	{
@@ -555,150 +698,297 @@ int mount_handle_open_input_parent_handle(
 
 		return( -1 );
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libvmdk_handle_get_utf16_parent_filename_size(
-		  input_handle,
-		  &parent_filename_size,
-		  error );
-#else
-	result = libvmdk_handle_get_utf8_parent_filename_size(
-		  input_handle,
-		  &parent_filename_size,
-		  error );
-#endif
-	if( result != 1 )
+	if( mount_handle->parent_registry != NULL )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve parent filename size.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mount handle - parent registry already set.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( parent_filename_size == 0 )
+	mount_handle->parent_registry = parent_registry;
+
+	return( 1 );
+}
+
+/* Frees an input handles array
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_free_input_handles_array(
+     libcdata_array_t **input_handles_array,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_free_input_handles_array";
+
+	if( libcdata_array_free(
+	     input_handles_array,
+	     (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
-		 "%s: missing parent filename.",
+		 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+		 "%s: unable to free input handles array.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( ( parent_filename_size > (size_t) SSIZE_MAX )
-	 || ( ( sizeof( system_character_t ) * parent_filename_size ) > (size_t) SSIZE_MAX ) )
+	return( 1 );
+}
+
+/* Opens the input of the mount handle
+ * Returns 1 if successful, 0 if disk type is not supported or -1 on error
+ */
+int mount_handle_open_input(
+     mount_handle_t *mount_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	system_character_t *basename_end = NULL;
+	static char *function            = "mount_handle_open_input";
+	size_t basename_length           = 0;
+	size_t filename_length           = 0;
+	int access_flags                 = LIBVMDK_OPEN_READ;
+	int result                       = 0;
+
+	if( mount_handle == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
-		 "%s: invalid parent filename size value exceeds maximum.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	parent_filename = system_string_allocate(
-			   parent_filename_size );
-
-	if( parent_filename == NULL )
+	if( filenames == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_MEMORY,
-		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
-		 "%s: unable to create parent filename string.",
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-	result = libvmdk_handle_get_utf16_parent_filename(
-		  input_handle,
-		  (uint16_t *) parent_filename,
-		  parent_filename_size,
-		  error );
-#else
-	result = libvmdk_handle_get_utf8_parent_filename(
-		  input_handle,
-		  (uint8_t *) parent_filename,
-		  parent_filename_size,
-		  error );
-#endif
-	if( result != 1 )
+	if( number_of_filenames <= 0 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve parent filename.",
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of filenames value out of bounds.",
 		 function );
 
-		goto on_error;
+		return( -1 );
 	}
-	if( mount_handle->basename == NULL )
+/* TODO add support for passing extent data files ? */
+	if( number_of_filenames != 1 )
 	{
-		parent_path      = parent_filename;
-		parent_path_size = parent_filename_size;
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported number of filenames.",
+		 function );
+
+		return( -1 );
 	}
-	else
+	filename_length = system_string_length(
+	                   filenames[ 0 ] );
+
+	basename_end = system_string_search_character_reverse(
+	                filenames[ 0 ],
+	                (system_character_t) LIBCPATH_SEPARATOR,
+	                filename_length + 1 );
+
+	if( basename_end != NULL )
 	{
-#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
-		if( libcpath_path_join_wide(
-		     &parent_path,
-		     &parent_path_size,
-		     mount_handle->basename,
-		     mount_handle->basename_size - 1,
-		     parent_filename,
-		     parent_filename_size - 1,
+		basename_length = (size_t) ( basename_end - filenames[ 0 ] ) + 1;
+	}
+	if( basename_length > 0 )
+	{
+		if( mount_handle_set_basename(
+		     mount_handle,
+		     filenames[ 0 ],
+		     basename_length,
 		     error ) != 1 )
-#else
-		if( libcpath_path_join(
-		     &parent_path,
-		     &parent_path_size,
-		     mount_handle->basename,
-		     mount_handle->basename_size - 1,
-		     parent_filename,
-		     parent_filename_size - 1,
-		     error ) != 1 )
-#endif
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-			 "%s: unable to create parent path.",
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set basename.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( mount_handle->write_access != 0 )
+	{
+		access_flags = LIBVMDK_OPEN_READ_WRITE;
+	}
+	result = mount_handle_open_input_handle(
+	          mount_handle,
+	          filenames[ 0 ],
+	          access_flags,
+	          mount_handle->input_handles_array,
+	          mount_handle->parent_registry,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+	/* Writes are served by the input handles array only, hence additional
+	 * readers are only used when the input is read-only
+	 */
+	if( ( result != 0 )
+	 && ( mount_handle->write_access == 0 )
+	 && ( mount_handle->number_of_threads > 1 ) )
+	{
+		if( mount_handle_open_readers(
+		     mount_handle,
+		     filenames[ 0 ],
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open readers.",
 			 function );
 
 			goto on_error;
 		}
 	}
+#endif
+	return( result );
+
+on_error:
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+	if( mount_handle->readers_queue != NULL )
+	{
+		libcthreads_queue_free(
+		 &( mount_handle->readers_queue ),
+		 NULL,
+		 NULL );
+	}
+#endif
+	libcdata_array_empty(
+	 mount_handle->readers_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &mount_handle_free_input_handles_array,
+	 NULL );
+
+	libcdata_array_empty(
+	 mount_handle->input_handles_array,
+	 (int (*)(intptr_t **, libcerror_error_t **)) &libvmdk_handle_free,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Opens an input handle and its parents
+ * The input handle is appended to the input handles array after its parents,
+ * the parents are managed by the parent registry if provided
+ * Returns 1 if successful, 0 if disk type is not supported or -1 on error
+ */
+int mount_handle_open_input_handle(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     int access_flags,
+     libcdata_array_t *input_handles_array,
+     parent_registry_t *parent_registry,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle     = NULL;
+	static char *function              = "mount_handle_open_input_handle";
+	uint32_t parent_content_identifier = 0;
+	int disk_type                      = 0;
+	int entry_index                    = 0;
+	int result                         = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
 	if( libvmdk_handle_initialize(
-	     &parent_input_handle,
+	     &input_handle,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
-		 "%s: unable to initialize parent input handle.",
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_set_statistics_flags(
+	     input_handle,
+	     mount_handle->statistics_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set statistics flags of input handle.",
 		 function );
 
 		goto on_error;
 	}
+	if( mount_handle->cache_pool != NULL )
+	{
+		if( libvmdk_handle_set_cache_pool(
+		     input_handle,
+		     mount_handle->cache_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache pool of input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
 #if defined( HAVE_WIDE_SYSTEM_CHARACTER )
 	if( libvmdk_handle_open_wide(
-	     parent_input_handle,
-	     parent_path,
-	     LIBVMDK_OPEN_READ,
+	     input_handle,
+	     filename,
+	     access_flags,
 	     error ) != 1 )
 #else
 	if( libvmdk_handle_open(
-	     parent_input_handle,
-	     parent_path,
-	     LIBVMDK_OPEN_READ,
+	     input_handle,
+	     filename,
+	     access_flags,
 	     error ) != 1 )
 #endif
 	{
@@ -706,31 +996,14 @@ int mount_handle_open_input_parent_handle(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_IO,
 		 LIBCERROR_IO_ERROR_OPEN_FAILED,
-		 "%s: unable to open parent input handle: %" PRIs_SYSTEM ".",
-		 function,
-		 parent_path );
+		 "%s: unable to open input handle.",
+		 function );
 
 		goto on_error;
 	}
-	if( parent_path != NULL )
-	{
-		if( mount_handle->basename != NULL )
-		{
-			memory_free(
-			 parent_path );
-		}
-		parent_path = NULL;
-	}
-	if( parent_filename != NULL )
-	{
-		memory_free(
-		 parent_filename );
-
-		parent_filename = NULL;
-	}
 	if( libvmdk_handle_get_disk_type(
-	     parent_input_handle,
-	     &parent_disk_type,
+	     input_handle,
+	     &disk_type,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -742,18 +1015,18 @@ int mount_handle_open_input_parent_handle(
 
 		goto on_error;
 	}
-	if( ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
-	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
-	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
-	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
-	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT )
-	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
-	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
-	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE )
-	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	if( ( disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 || ( disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 || ( disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 || ( disk_type == LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 || ( disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 || ( disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 || ( disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 || ( disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 || ( disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
 	{
 		result = libvmdk_handle_get_parent_content_identifier(
-			  parent_input_handle,
+			  input_handle,
 			  &parent_content_identifier,
 			  error );
 
@@ -772,9 +1045,11 @@ int mount_handle_open_input_parent_handle(
 		      && ( parent_content_identifier != 0xffffffffUL ) )
 		{
 			result = mount_handle_open_input_parent_handle(
-				  mount_handle,
-				  parent_input_handle,
-				  error );
+			          mount_handle,
+			          input_handle,
+			          input_handles_array,
+			          parent_registry,
+			          error );
 
 			if( result == -1 )
 			{
@@ -801,112 +1076,1703 @@ int mount_handle_open_input_parent_handle(
 	}
 	if( result != 0 )
 	{
-		if( libvmdk_handle_open_extent_data_files(
-		     parent_input_handle,
-		     error ) != 1 )
+		result = libvmdk_handle_open_extent_data_files(
+			  input_handle,
+			  error );
+
+		if( result != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_IO,
 			 LIBCERROR_IO_ERROR_OPEN_FAILED,
-			 "%s: unable to open parent extent data files.",
+			 "%s: unable to open extent data files.",
 			 function );
 
 			goto on_error;
 		}
-		if( libvmdk_handle_set_parent_handle(
-		     input_handle,
-		     parent_input_handle,
+		if( libcdata_array_append_entry(
+		     input_handles_array,
+		     &entry_index,
+		     (intptr_t *) input_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
-			 "%s: unable to set parent input handle.",
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append input handle to array.",
 			 function );
 
 			goto on_error;
 		}
-		if( libcdata_array_append_entry(
-		     mount_handle->input_handles_array,
-		     &entry_index,
-		     (intptr_t *) parent_input_handle,
+	}
+	else
+	{
+		if( libvmdk_handle_close(
+		     input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_free(
+		     &input_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
-			 "%s: unable to append parent input handle to array.",
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free input handle.",
 			 function );
 
 			goto on_error;
 		}
 	}
-	else
+	return( result );
+
+on_error:
+	if( input_handle != NULL )
 	{
-		if( libvmdk_handle_close(
-		     parent_input_handle,
-		     error ) != 0 )
+		libvmdk_handle_free(
+		 &input_handle,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Opens the parent input handle
+ * The parent input handle is appended to the input handles array after its parents
+ * or to the parent registry if provided
+ * Returns 1 if successful, 0 if no parent or -1 on error
+ */
+int mount_handle_open_input_parent_handle(
+     mount_handle_t *mount_handle,
+     libvmdk_handle_t *input_handle,
+     libcdata_array_t *input_handles_array,
+     parent_registry_t *parent_registry,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *parent_input_handle = NULL;
+	system_character_t *parent_filename   = NULL;
+	system_character_t *parent_path       = NULL;
+	static char *function                 = "mount_handle_open_input_parent_handle";
+	size_t parent_filename_size           = 0;
+	size_t parent_path_size               = 0;
+	uint32_t content_identifier           = 0;
+	uint32_t parent_content_identifier    = 0;
+	int entry_index                       = 0;
+	int parent_disk_type                  = 0;
+	int result                            = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename_size(
+		  input_handle,
+		  &parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename size.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_filename_size == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: missing parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_filename_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * parent_filename_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid parent filename size value exceeds maximum.",
+		 function );
+
+		goto on_error;
+	}
+	parent_filename = system_string_allocate(
+			   parent_filename_size );
+
+	if( parent_filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent filename string.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libvmdk_handle_get_utf16_parent_filename(
+		  input_handle,
+		  (uint16_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#else
+	result = libvmdk_handle_get_utf8_parent_filename(
+		  input_handle,
+		  (uint8_t *) parent_filename,
+		  parent_filename_size,
+		  error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent filename.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_handle->basename == NULL )
+	{
+		parent_path      = parent_filename;
+		parent_path_size = parent_filename_size;
+	}
+	else
+	{
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		if( libcpath_path_join_wide(
+		     &parent_path,
+		     &parent_path_size,
+		     mount_handle->basename,
+		     mount_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#else
+		if( libcpath_path_join(
+		     &parent_path,
+		     &parent_path_size,
+		     mount_handle->basename,
+		     mount_handle->basename_size - 1,
+		     parent_filename,
+		     parent_filename_size - 1,
+		     error ) != 1 )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to create parent path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( parent_registry != NULL )
+	{
+		if( libvmdk_handle_get_parent_content_identifier(
+		     input_handle,
+		     &content_identifier,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent content identifier.",
+			 function );
+
+			goto on_error;
+		}
+		result = parent_registry_get_input_handle(
+		          parent_registry,
+		          parent_path,
+		          parent_path_size,
+		          content_identifier,
+		          &parent_input_handle,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent input handle from registry.",
+			 function );
+
+			goto on_error;
+		}
+		else if( result != 0 )
+		{
+			/* The parent input handle, and its parents, were already opened
+			 * for another input handle and are managed by the registry
+			 */
+			if( libvmdk_handle_set_parent_handle(
+			     input_handle,
+			     parent_input_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+				 "%s: unable to set parent input handle.",
+				 function );
+
+				parent_input_handle = NULL;
+
+				goto on_error;
+			}
+			if( mount_handle->basename != NULL )
+			{
+				memory_free(
+				 parent_path );
+			}
+			memory_free(
+			 parent_filename );
+
+			return( 1 );
+		}
+	}
+	if( libvmdk_handle_initialize(
+	     &parent_input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_set_statistics_flags(
+	     parent_input_handle,
+	     mount_handle->statistics_flags,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set statistics flags of parent input handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( mount_handle->cache_pool != NULL )
+	{
+		if( libvmdk_handle_set_cache_pool(
+		     parent_input_handle,
+		     mount_handle->cache_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache pool of parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     parent_input_handle,
+	     parent_path,
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open parent input handle: %" PRIs_SYSTEM ".",
+		 function,
+		 parent_path );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_get_disk_type(
+	     parent_input_handle,
+	     &parent_disk_type,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve disk type.",
+		 function );
+
+		goto on_error;
+	}
+	if( ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_2GB_EXTENT_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_MONOLITHIC_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_STREAM_OPTIMIZED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_PRE_ALLOCATED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_FLAT_ZEROED )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE )
+	 || ( parent_disk_type == LIBVMDK_DISK_TYPE_VMFS_SPARSE_THIN ) )
+	{
+		result = libvmdk_handle_get_parent_content_identifier(
+			  parent_input_handle,
+			  &parent_content_identifier,
+			  error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve parent content identifier.",
+			 function );
+
+			goto on_error;
+		}
+		else if( ( result != 0 )
+		      && ( parent_content_identifier != 0xffffffffUL ) )
+		{
+			result = mount_handle_open_input_parent_handle(
+				  mount_handle,
+				  parent_input_handle,
+				  input_handles_array,
+				  parent_registry,
+				  error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_OPEN_FAILED,
+				 "%s: unable to open parent input handle.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			result = 1;
+		}
+	}
+	else
+	{
+		/* Unsupported disk type
+		 */
+		result = 0;
+	}
+	if( result != 0 )
+	{
+		if( libvmdk_handle_open_extent_data_files(
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open parent extent data files.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_set_parent_handle(
+		     input_handle,
+		     parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( parent_registry != NULL )
+		{
+			if( parent_registry_append_input_handle(
+			     parent_registry,
+			     parent_path,
+			     parent_path_size,
+			     content_identifier,
+			     parent_input_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append parent input handle to registry.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		else
+		{
+			if( libcdata_array_append_entry(
+			     input_handles_array,
+			     &entry_index,
+			     (intptr_t *) parent_input_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+				 "%s: unable to append parent input handle to array.",
+				 function );
+
+				goto on_error;
+			}
+		}
+		parent_input_handle = NULL;
+	}
+	else
+	{
+		if( libvmdk_handle_close(
+		     parent_input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+		if( libvmdk_handle_free(
+		     &parent_input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent input handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( mount_handle->basename != NULL )
+	{
+		memory_free(
+		 parent_path );
+	}
+	memory_free(
+	 parent_filename );
+
+	return( result );
+
+on_error:
+	if( parent_input_handle != NULL )
+	{
+		libvmdk_handle_free(
+		 &parent_input_handle,
+		 NULL );
+	}
+	if( ( parent_path != NULL )
+	 && ( mount_handle->basename != NULL ) )
+	{
+		memory_free(
+		 parent_path );
+	}
+	if( parent_filename != NULL )
+	{
+		memory_free(
+		 parent_filename );
+	}
+	return( -1 );
+}
+
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+
+/* Opens the readers of the mount handle
+ * Every thread used to serve requests is provided with its own input handles
+ * so that reads are not serialized by the lock of a shared input handle,
+ * the input handles array is used as the first reader
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_open_readers(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *input_handles_array = NULL;
+	static char *function                 = "mount_handle_open_readers";
+	int entry_index                       = 0;
+	int reader_index                      = 0;
+	int result                            = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( mount_handle->readers_queue != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid mount handle - readers queue already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcthreads_queue_initialize(
+	     &( mount_handle->readers_queue ),
+	     mount_handle->number_of_threads,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize readers queue.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcthreads_queue_push(
+	     mount_handle->readers_queue,
+	     (intptr_t *) mount_handle->input_handles_array,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to push input handles array onto readers queue.",
+		 function );
+
+		goto on_error;
+	}
+	for( reader_index = 1;
+	     reader_index < mount_handle->number_of_threads;
+	     reader_index++ )
+	{
+		if( libcdata_array_initialize(
+		     &input_handles_array,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+			 "%s: unable to initialize input handles array of reader: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		/* The parent registry is not used since the parent input handles
+		 * it manages are shared by all the readers
+		 */
+		result = mount_handle_open_input_handle(
+		          mount_handle,
+		          filename,
+		          LIBVMDK_OPEN_READ,
+		          input_handles_array,
+		          NULL,
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_OPEN_FAILED,
+			 "%s: unable to open input handle of reader: %d.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( libcdata_array_append_entry(
+		     mount_handle->readers_array,
+		     &entry_index,
+		     (intptr_t *) input_handles_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to append reader: %d to array.",
+			 function,
+			 reader_index );
+
+			goto on_error;
+		}
+		if( libcthreads_queue_push(
+		     mount_handle->readers_queue,
+		     (intptr_t *) input_handles_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push reader: %d onto queue.",
+			 function,
+			 reader_index );
+
+			input_handles_array = NULL;
+
+			goto on_error;
+		}
+		input_handles_array = NULL;
+	}
+	return( 1 );
+
+on_error:
+	if( input_handles_array != NULL )
+	{
+		mount_handle_free_input_handles_array(
+		 &input_handles_array,
+		 NULL );
+	}
+	return( -1 );
+}
+
+#endif /* defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT ) */
+
+/* Retrieves a specific reader
+ * Reader 0 is the input handles array, the other readers are stored in the readers array
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_reader(
+     mount_handle_t *mount_handle,
+     int reader_index,
+     libcdata_array_t **input_handles_array,
+     libcerror_error_t **error )
+{
+	static char *function = "mount_handle_get_reader";
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_handles_array == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input handles array.",
+		 function );
+
+		return( -1 );
+	}
+	if( reader_index == 0 )
+	{
+		*input_handles_array = mount_handle->input_handles_array;
+	}
+	else if( libcdata_array_get_entry_by_index(
+	          mount_handle->readers_array,
+	          reader_index - 1,
+	          (intptr_t **) input_handles_array,
+	          error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve reader: %d.",
+		 function,
+		 reader_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Retrieves the input handle of a reader that corresponds to a specific input handle
+ * The input handle is stored after its parents, the input handles array of a reader
+ * can contain more parents than the input handles array when the parent registry is used,
+ * hence the input handles are matched from the end of the arrays
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_reader_input_handle(
+     mount_handle_t *mount_handle,
+     libcdata_array_t *input_handles_array,
+     int input_handle_index,
+     libvmdk_handle_t **input_handle,
+     libcerror_error_t **error )
+{
+	static char *function        = "mount_handle_get_reader_input_handle";
+	int number_of_input_handles  = 0;
+	int number_of_reader_handles = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_handles_array != mount_handle->input_handles_array )
+	{
+		if( libcdata_array_get_number_of_entries(
+		     mount_handle->input_handles_array,
+		     &number_of_input_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of input handles.",
+			 function );
+
+			return( -1 );
+		}
+		if( libcdata_array_get_number_of_entries(
+		     input_handles_array,
+		     &number_of_reader_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of input handles of reader.",
+			 function );
+
+			return( -1 );
+		}
+		if( ( input_handle_index < 0 )
+		 || ( input_handle_index >= number_of_input_handles )
+		 || ( number_of_reader_handles < number_of_input_handles ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid input handle index value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		input_handle_index += number_of_reader_handles - number_of_input_handles;
+	}
+	if( libcdata_array_get_entry_by_index(
+	     input_handles_array,
+	     input_handle_index,
+	     (intptr_t **) input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input handle: %d.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the mount handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int mount_handle_close(
+     mount_handle_t *mount_handle,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *input_handles_array = NULL;
+	libvmdk_handle_t *input_handle        = NULL;
+	static char *function                 = "mount_handle_close";
+	int input_handle_index                = 0;
+	int number_of_input_handles           = 0;
+	int number_of_readers                 = 0;
+	int reader_index                      = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     mount_handle->input_handles_array,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		return( -1 );
+	}
+	for( input_handle_index = number_of_input_handles - 1;
+	     input_handle_index > 0;
+	     input_handle_index-- )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     mount_handle->input_handles_array,
+		     input_handle_index,
+		     (intptr_t **) &input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		if( libvmdk_handle_close(
+		     input_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close input handle: %d.",
+			 function,
+			 input_handle_index );
+
+			return( -1 );
+		}
+	}
+	if( libcdata_array_get_number_of_entries(
+	     mount_handle->readers_array,
+	     &number_of_readers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of readers.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 1;
+	     reader_index <= number_of_readers;
+	     reader_index++ )
+	{
+		if( mount_handle_get_reader(
+		     mount_handle,
+		     reader_index,
+		     &input_handles_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader: %d.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+		if( libcdata_array_get_number_of_entries(
+		     input_handles_array,
+		     &number_of_input_handles,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve number of input handles of reader: %d.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+		for( input_handle_index = number_of_input_handles - 1;
+		     input_handle_index >= 0;
+		     input_handle_index-- )
+		{
+			if( libcdata_array_get_entry_by_index(
+			     input_handles_array,
+			     input_handle_index,
+			     (intptr_t **) &input_handle,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve input handle: %d of reader: %d.",
+				 function,
+				 input_handle_index,
+				 reader_index );
+
+				return( -1 );
+			}
+			if( libvmdk_handle_close(
+			     input_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close input handle: %d of reader: %d.",
+				 function,
+				 input_handle_index,
+				 reader_index );
+
+				return( -1 );
+			}
+		}
+	}
+	return( 0 );
+}
+
+/* Reads a buffer at a specific offset from a specific input handle
+ * The read does not change the current offset of the input handle, it is safe
+ * to call from multiple threads, when readers were opened every read is served
+ * by the input handles of a reader that is not in use by another thread,
+ * otherwise reads of the same input handle are serialized by the lock of the handle
+ * Returns the number of bytes read if successful or -1 on error
+ */
+ssize_t mount_handle_read_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         int input_handle_index,
+         uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libcdata_array_t *input_handles_array = NULL;
+	libvmdk_handle_t *input_handle        = NULL;
+	static char *function                 = "mount_handle_read_buffer_at_offset";
+	ssize_t read_count                    = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+	if( mount_handle->readers_queue != NULL )
+	{
+		/* Blocks until a reader is available
+		 */
+		if( libcthreads_queue_pop(
+		     mount_handle->readers_queue,
+		     (intptr_t **) &input_handles_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to pop reader from queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	else
+#endif
+	{
+		input_handles_array = mount_handle->input_handles_array;
+	}
+	if( mount_handle_get_reader_input_handle(
+	     mount_handle,
+	     input_handles_array,
+	     input_handle_index,
+	     &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input handle: %d.",
+		 function,
+		 input_handle_index );
+
+		goto on_error;
+	}
+	read_count = libvmdk_handle_read_buffer_at_offset(
+	              input_handle,
+	              buffer,
+	              size,
+	              offset,
+	              error );
+
+	if( read_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_READ_FAILED,
+		 "%s: unable to read buffer at offset: %" PRIi64 " from input handle: %d.",
+		 function,
+		 offset,
+		 input_handle_index );
+
+		goto on_error;
+	}
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+	if( mount_handle->readers_queue != NULL )
+	{
+		if( libcthreads_queue_push(
+		     mount_handle->readers_queue,
+		     (intptr_t *) input_handles_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+			 "%s: unable to push reader onto queue.",
+			 function );
+
+			return( -1 );
+		}
+	}
+#endif
+	return( read_count );
+
+on_error:
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+	if( mount_handle->readers_queue != NULL )
+	{
+		libcthreads_queue_push(
+		 mount_handle->readers_queue,
+		 (intptr_t *) input_handles_array,
+		 NULL );
+	}
+#endif
+	return( -1 );
+}
+
+/* Writes a buffer at a specific offset to a specific input handle
+ * The write does not change the current offset of the input handle
+ * Returns the number of bytes written if successful or -1 on error
+ */
+ssize_t mount_handle_write_buffer_at_offset(
+         mount_handle_t *mount_handle,
+         int input_handle_index,
+         const uint8_t *buffer,
+         size_t size,
+         off64_t offset,
+         libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "mount_handle_write_buffer_at_offset";
+	ssize_t write_count            = 0;
+	int result                     = 0;
+
+	result = mount_handle_is_writable(
+	          mount_handle,
+	          input_handle_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if input handle: %d is writable.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: input handle: %d is not writable.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     mount_handle->input_handles_array,
+	     input_handle_index,
+	     (intptr_t **) &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input handle: %d.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	write_count = libvmdk_handle_write_buffer_at_offset(
+	               input_handle,
+	               buffer,
+	               size,
+	               offset,
+	               error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write buffer at offset: %" PRIi64 " to input handle: %d.",
+		 function,
+		 offset,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	return( write_count );
+}
+
+/* Discards data of a specific input handle
+ * Discard is not supported on a delta disk, since the parent data would become visible
+ * Returns 1 if successful, 0 if not supported or -1 on error
+ */
+int mount_handle_discard(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle     = NULL;
+	static char *function              = "mount_handle_discard";
+	uint32_t parent_content_identifier = 0;
+	int result                         = 0;
+
+	result = mount_handle_is_writable(
+	          mount_handle,
+	          input_handle_index,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to determine if input handle: %d is writable.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+		 "%s: input handle: %d is not writable.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     mount_handle->input_handles_array,
+	     input_handle_index,
+	     (intptr_t **) &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input handle: %d.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	result = libvmdk_handle_get_parent_content_identifier(
+	          input_handle,
+	          &parent_content_identifier,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve parent content identifier of input handle: %d.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	else if( ( result != 0 )
+	      && ( parent_content_identifier != 0xffffffffUL ) )
+	{
+		return( 0 );
+	}
+	if( libvmdk_handle_discard(
+	     input_handle,
+	     offset,
+	     size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to discard data in input handle: %d.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Finds the next data or hole offset in a specific input handle
+ * Data stored in the input handle or one of its parents is considered data,
+ * sparse data is considered a hole and the end of the media is considered a hole
+ * Returns 1 if successful, 0 if no such offset or -1 on error
+ */
+int mount_handle_find_data_offset(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     off64_t offset,
+     uint8_t find_hole,
+     off64_t *found_offset,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "mount_handle_find_data_offset";
+	size64_t media_size            = 0;
+	size64_t range_size            = 0;
+	uint32_t range_flags           = 0;
+	uint8_t is_hole                = 0;
+	int result                     = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		return( -1 );
+	}
+	if( found_offset == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid found offset.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     mount_handle->input_handles_array,
+	     input_handle_index,
+	     (intptr_t **) &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input handle: %d.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     input_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size from input handle: %d.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	if( (size64_t) offset >= media_size )
+	{
+		return( 0 );
+	}
+	while( (size64_t) offset < media_size )
+	{
+		result = libvmdk_handle_get_data_range_at_offset(
+		          input_handle,
+		          offset,
+		          &range_size,
+		          &range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range at offset: %" PRIi64 " from input handle: %d.",
+			 function,
+			 offset,
+			 input_handle_index );
+
+			return( -1 );
+		}
+		else if( ( result == 0 )
+		      || ( range_size == 0 ) )
+		{
+			break;
+		}
+		if( ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			is_hole = 1;
+		}
+		else
+		{
+			is_hole = 0;
+		}
+		if( is_hole == find_hole )
+		{
+			*found_offset = offset;
+
+			return( 1 );
+		}
+		offset += (off64_t) range_size;
+	}
+	if( find_hole == 0 )
+	{
+		return( 0 );
+	}
+	/* The end of the media is considered a hole
+	 */
+	*found_offset = (off64_t) media_size;
+
+	return( 1 );
+}
+
+/* Retrieves the data range at a specific offset of a specific input handle
+ * Returns 1 if successful, 0 if the offset is beyond the media size or -1 on error
+ */
+int mount_handle_get_data_range_at_offset(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     off64_t offset,
+     size64_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error )
+{
+	libvmdk_handle_t *input_handle = NULL;
+	static char *function          = "mount_handle_get_data_range_at_offset";
+	int result                     = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_entry_by_index(
+	     mount_handle->input_handles_array,
+	     input_handle_index,
+	     (intptr_t **) &input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve input handle: %d.",
+		 function,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	result = libvmdk_handle_get_data_range_at_offset(
+	          input_handle,
+	          offset,
+	          range_size,
+	          range_flags,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve data range at offset: %" PRIi64 " from input handle: %d.",
+		 function,
+		 offset,
+		 input_handle_index );
+
+		return( -1 );
+	}
+	return( result );
+}
+
+/* Retrieves a specific statistics value of a specific input handle
+ * The value is summed over the input handle and the corresponding input handles of the readers
+ * Returns 1 if successful or -1 on error
+ */
+int mount_handle_get_statistics_value(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error )
+{
+	libcdata_array_t *input_handles_array = NULL;
+	libvmdk_handle_t *input_handle        = NULL;
+	static char *function                 = "mount_handle_get_statistics_value";
+	uint64_t reader_value                 = 0;
+	int number_of_readers                 = 0;
+	int reader_index                      = 0;
+
+	if( mount_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid mount handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( value == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid value.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     mount_handle->readers_array,
+	     &number_of_readers,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of readers.",
+		 function );
+
+		return( -1 );
+	}
+	*value = 0;
+
+	for( reader_index = 0;
+	     reader_index <= number_of_readers;
+	     reader_index++ )
+	{
+		if( mount_handle_get_reader(
+		     mount_handle,
+		     reader_index,
+		     &input_handles_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader: %d.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+		if( mount_handle_get_reader_input_handle(
+		     mount_handle,
+		     input_handles_array,
+		     input_handle_index,
+		     &input_handle,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close parent input handle.",
-			 function );
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve input handle: %d of reader: %d.",
+			 function,
+			 input_handle_index,
+			 reader_index );
 
-			goto on_error;
+			return( -1 );
 		}
-		if( libvmdk_handle_free(
-		     &parent_input_handle,
+		if( libvmdk_handle_get_statistics_value(
+		     input_handle,
+		     value_type,
+		     &reader_value,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
-			 "%s: unable to free parent input handle.",
-			 function );
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics value: %d from input handle: %d of reader: %d.",
+			 function,
+			 value_type,
+			 input_handle_index,
+			 reader_index );
 
-			goto on_error;
+			return( -1 );
 		}
+		*value += reader_value;
 	}
-	return( result );
-
-on_error:
-	if( parent_input_handle != NULL )
-	{
-		libvmdk_handle_free(
-		 &parent_input_handle,
-		 NULL );
-	}
-	if( ( parent_path != NULL )
-	 && ( mount_handle->basename != NULL ) )
-	{
-		memory_free(
-		 parent_path );
-	}
-	if( parent_filename != NULL )
-	{
-		memory_free(
-		 parent_filename );
-	}
-	return( -1 );
+	return( 1 );
 }
 
-/* Closes the mount handle
- * Returns the 0 if succesful or -1 on error
+/* Retrieves a specific statistics histogram of a specific input handle
+ * The histogram must contain LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS buckets
+ * and is summed over the input handle and the corresponding input handles of the readers
+ * Returns 1 if successful or -1 on error
  */
-int mount_handle_close(
+int mount_handle_get_statistics_histogram(
      mount_handle_t *mount_handle,
+     int input_handle_index,
+     int histogram_type,
+     uint64_t *histogram,
      libcerror_error_t **error )
 {
-	libvmdk_handle_t *input_handle = NULL;
-	static char *function          = "mount_handle_close";
-	int input_handle_index         = 0;
-	int number_of_input_handles    = 0;
+	uint64_t reader_histogram[ LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS ];
+
+	libcdata_array_t *input_handles_array = NULL;
+	libvmdk_handle_t *input_handle        = NULL;
+	static char *function                 = "mount_handle_get_statistics_histogram";
+	int bucket_index                      = 0;
+	int number_of_readers                 = 0;
+	int reader_index                      = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -919,71 +2785,164 @@ int mount_handle_close(
 
 		return( -1 );
 	}
+	if( histogram == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid histogram.",
+		 function );
+
+		return( -1 );
+	}
 	if( libcdata_array_get_number_of_entries(
-	     mount_handle->input_handles_array,
-	     &number_of_input_handles,
+	     mount_handle->readers_array,
+	     &number_of_readers,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve number of input handles.",
+		 "%s: unable to retrieve number of readers.",
 		 function );
 
 		return( -1 );
 	}
-	for( input_handle_index = number_of_input_handles - 1;
-	     input_handle_index > 0;
-	     input_handle_index-- )
+	if( memory_set(
+	     histogram,
+	     0,
+	     sizeof( uint64_t ) * LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS ) == NULL )
 	{
-		if( libcdata_array_get_entry_by_index(
-		     mount_handle->input_handles_array,
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear histogram.",
+		 function );
+
+		return( -1 );
+	}
+	for( reader_index = 0;
+	     reader_index <= number_of_readers;
+	     reader_index++ )
+	{
+		if( mount_handle_get_reader(
+		     mount_handle,
+		     reader_index,
+		     &input_handles_array,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve reader: %d.",
+			 function,
+			 reader_index );
+
+			return( -1 );
+		}
+		if( mount_handle_get_reader_input_handle(
+		     mount_handle,
+		     input_handles_array,
 		     input_handle_index,
-		     (intptr_t **) &input_handle,
+		     &input_handle,
 		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve input handle: %d.",
+			 "%s: unable to retrieve input handle: %d of reader: %d.",
 			 function,
-			 input_handle_index );
+			 input_handle_index,
+			 reader_index );
 
 			return( -1 );
 		}
-		if( libvmdk_handle_close(
+		if( libvmdk_handle_get_statistics_histogram(
 		     input_handle,
-		     error ) != 0 )
+		     histogram_type,
+		     reader_histogram,
+		     LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS,
+		     error ) != 1 )
 		{
 			libcerror_error_set(
 			 error,
-			 LIBCERROR_ERROR_DOMAIN_IO,
-			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
-			 "%s: unable to close input handle: %d.",
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve histogram: %d from input handle: %d of reader: %d.",
 			 function,
-			 input_handle_index );
+			 histogram_type,
+			 input_handle_index,
+			 reader_index );
 
 			return( -1 );
 		}
+		for( bucket_index = 0;
+		     bucket_index < LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS;
+		     bucket_index++ )
+		{
+			histogram[ bucket_index ] += reader_histogram[ bucket_index ];
+		}
 	}
-	return( 0 );
+	return( 1 );
 }
 
-/* Read a buffer from a specific input handle
- * Returns the number of bytes read if successful or -1 on error
+/* Retrieves a string describing the read statistics of a specific input handle
+ * The statistics are summed over the input handle and the corresponding input handles of the readers
+ * The string is terminated by an end-of-string character
+ * Returns 1 if successful or -1 on error
  */
-ssize_t mount_handle_read_buffer(
-         mount_handle_t *mount_handle,
-         int input_handle_index,
-         uint8_t *buffer,
-         size_t size,
-         libcerror_error_t **error )
+int mount_handle_get_statistics_string(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     char *string,
+     size_t string_size,
+     size_t *string_length,
+     libcerror_error_t **error )
 {
-	libvmdk_handle_t *input_handle = NULL;
-	static char *function          = "mount_handle_read_buffer";
-	ssize_t read_count             = 0;
+	uint64_t histogram[ LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS ];
+	uint64_t values[ LIBVMDK_STATISTICS_VALUE_READ_TIME + 1 ];
+
+	const char *value_names[ LIBVMDK_STATISTICS_VALUE_READ_TIME + 1 ] = {
+		NULL,
+		"reads",
+		"bytes read",
+		"sparse grains",
+		"allocated grains",
+		"compressed grains",
+		"parent reads",
+		"grains cache hits",
+		"grains cache misses",
+		"grain groups cache hits",
+		"grain groups cache misses",
+		"extent files cache hits",
+		"extent files cache misses",
+		"decompressions",
+		"decompression time (ns)",
+		"compressed bytes read",
+		"extent file reads",
+		"extent file bytes read",
+		"read time (ns)" };
+
+	const char *histogram_names[ 3 ] = {
+		NULL,
+		"decompression time",
+		"read time" };
+
+	const char *cache_name     = NULL;
+	static char *function      = "mount_handle_get_statistics_string";
+	size_t string_index        = 0;
+	uint64_t number_of_lookups = 0;
+	uint64_t hit_rate          = 0;
+	int bucket_index           = 0;
+	int histogram_type         = 0;
+	int print_count            = 0;
+	int result                 = 0;
+	int value_type             = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -996,55 +2955,237 @@ ssize_t mount_handle_read_buffer(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
-	     mount_handle->input_handles_array,
-	     input_handle_index,
-	     (intptr_t **) &input_handle,
-	     error ) != 1 )
+	if( string == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve input handle: %d.",
-		 function,
-		 input_handle_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
 
 		return( -1 );
 	}
-	read_count = libvmdk_handle_read_buffer(
-	              input_handle,
-	              buffer,
-	              size,
-	              error );
+	if( ( string_size == 0 )
+	 || ( string_size > (size_t) INT_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid string size value out of bounds.",
+		 function );
 
-	if( read_count == -1 )
+		return( -1 );
+	}
+	if( string_length == NULL )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_READ_FAILED,
-		 "%s: unable to read buffer from input handle: %d.",
-		 function,
-		 input_handle_index );
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string length.",
+		 function );
 
 		return( -1 );
 	}
-	return( read_count );
+	for( value_type = LIBVMDK_STATISTICS_VALUE_NUMBER_OF_READS;
+	     value_type <= LIBVMDK_STATISTICS_VALUE_READ_TIME;
+	     value_type++ )
+	{
+		result = mount_handle_get_statistics_value(
+		          mount_handle,
+		          input_handle_index,
+		          value_type,
+		          &( values[ value_type ] ),
+		          error );
+
+		if( result != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics value: %d from input handle: %d.",
+			 function,
+			 value_type,
+			 input_handle_index );
+
+			return( -1 );
+		}
+	}
+	for( value_type = LIBVMDK_STATISTICS_VALUE_NUMBER_OF_READS;
+	     value_type <= LIBVMDK_STATISTICS_VALUE_READ_TIME;
+	     value_type++ )
+	{
+		print_count = narrow_string_snprintf(
+		               &( string[ string_index ] ),
+		               string_size - string_index,
+		               "%s: %" PRIu64 "\n",
+		               value_names[ value_type ],
+		               values[ value_type ] );
+
+		if( ( print_count < 0 )
+		 || ( (size_t) print_count >= ( string_size - string_index ) ) )
+		{
+			goto on_string_too_small;
+		}
+		string_index += (size_t) print_count;
+
+		switch( value_type )
+		{
+			case LIBVMDK_STATISTICS_VALUE_GRAINS_CACHE_MISSES:
+				cache_name = "grains";
+				break;
+
+			case LIBVMDK_STATISTICS_VALUE_GRAIN_GROUPS_CACHE_MISSES:
+				cache_name = "grain groups";
+				break;
+
+			case LIBVMDK_STATISTICS_VALUE_EXTENT_FILES_CACHE_MISSES:
+				cache_name = "extent files";
+				break;
+
+			default:
+				cache_name = NULL;
+				break;
+		}
+		/* The cache misses directly follow the cache hits
+		 */
+		if( cache_name != NULL )
+		{
+			number_of_lookups = values[ value_type - 1 ] + values[ value_type ];
+			hit_rate          = 0;
+
+			if( number_of_lookups > 0 )
+			{
+				hit_rate = ( values[ value_type - 1 ] * 10000 ) / number_of_lookups;
+			}
+			print_count = narrow_string_snprintf(
+			               &( string[ string_index ] ),
+			               string_size - string_index,
+			               "%s cache hit rate: %" PRIu64 ".%02" PRIu64 "%%\n",
+			               cache_name,
+			               hit_rate / 100,
+			               hit_rate % 100 );
+
+			if( ( print_count < 0 )
+			 || ( (size_t) print_count >= ( string_size - string_index ) ) )
+			{
+				goto on_string_too_small;
+			}
+			string_index += (size_t) print_count;
+		}
+	}
+	/* The histograms are only maintained when the times are measured
+	 */
+	if( ( mount_handle->statistics_flags & LIBVMDK_STATISTICS_FLAG_MEASURE_TIME ) != 0 )
+	{
+		for( histogram_type = LIBVMDK_STATISTICS_HISTOGRAM_DECOMPRESSION_TIME;
+		     histogram_type <= LIBVMDK_STATISTICS_HISTOGRAM_READ_TIME;
+		     histogram_type++ )
+		{
+			if( mount_handle_get_statistics_histogram(
+			     mount_handle,
+			     input_handle_index,
+			     histogram_type,
+			     histogram,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve %s histogram from input handle: %d.",
+				 function,
+				 histogram_names[ histogram_type ],
+				 input_handle_index );
+
+				return( -1 );
+			}
+			print_count = narrow_string_snprintf(
+			               &( string[ string_index ] ),
+			               string_size - string_index,
+			               "%s histogram:\n",
+			               histogram_names[ histogram_type ] );
+
+			if( ( print_count < 0 )
+			 || ( (size_t) print_count >= ( string_size - string_index ) ) )
+			{
+				goto on_string_too_small;
+			}
+			string_index += (size_t) print_count;
+
+			for( bucket_index = 0;
+			     bucket_index < LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS;
+			     bucket_index++ )
+			{
+				if( histogram[ bucket_index ] == 0 )
+				{
+					continue;
+				}
+				if( bucket_index == 0 )
+				{
+					print_count = narrow_string_snprintf(
+					               &( string[ string_index ] ),
+					               string_size - string_index,
+					               "\t< 2 us: %" PRIu64 "\n",
+					               histogram[ bucket_index ] );
+				}
+				else if( bucket_index == ( LIBVMDK_STATISTICS_NUMBER_OF_HISTOGRAM_BUCKETS - 1 ) )
+				{
+					print_count = narrow_string_snprintf(
+					               &( string[ string_index ] ),
+					               string_size - string_index,
+					               "\t>= %" PRIu64 " us: %" PRIu64 "\n",
+					               (uint64_t) 1 << bucket_index,
+					               histogram[ bucket_index ] );
+				}
+				else
+				{
+					print_count = narrow_string_snprintf(
+					               &( string[ string_index ] ),
+					               string_size - string_index,
+					               "\t%" PRIu64 " - %" PRIu64 " us: %" PRIu64 "\n",
+					               (uint64_t) 1 << bucket_index,
+					               (uint64_t) 1 << ( bucket_index + 1 ),
+					               histogram[ bucket_index ] );
+				}
+				if( ( print_count < 0 )
+				 || ( (size_t) print_count >= ( string_size - string_index ) ) )
+				{
+					goto on_string_too_small;
+				}
+				string_index += (size_t) print_count;
+			}
+		}
+	}
+	*string_length = string_index;
+
+	return( 1 );
+
+on_string_too_small:
+	libcerror_error_set(
+	 error,
+	 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+	 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+	 "%s: string size value too small.",
+	 function );
+
+	return( -1 );
 }
 
-/* Seeks a specific offset in a specific input handle
- * Returns the offset if successful or -1 on error
+/* Retrieves the media size of a specific input handle
+ * Returns 1 if successful or -1 on error
  */
-off64_t mount_handle_seek_offset(
-         mount_handle_t *mount_handle,
-         int input_handle_index,
-         off64_t offset,
-         int whence,
-         libcerror_error_t **error )
+int mount_handle_get_media_size(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     size64_t *size,
+     libcerror_error_t **error )
 {
 	libvmdk_handle_t *input_handle = NULL;
-	static char *function          = "mount_handle_seek_offset";
+	static char *function          = "mount_handle_get_media_size";
 
 	if( mount_handle == NULL )
 	{
@@ -1073,38 +3214,35 @@ off64_t mount_handle_seek_offset(
 
 		return( -1 );
 	}
-	offset = libvmdk_handle_seek_offset(
-	          input_handle,
-	          offset,
-	          whence,
-	          error );
-
-	if( offset == -1 )
+	if( libvmdk_handle_get_media_size(
+	     input_handle,
+	     size,
+	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset in input handle: %d.",
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size from input handle: %d.",
 		 function,
 		 input_handle_index );
 
 		return( -1 );
 	}
-	return( offset );
+	return( 1 );
 }
 
-/* Retrieves the media size of a specific input handle
- * Returns 1 if successful or -1 on error
+/* Determines if a specific input handle is writable
+ * Only the input handle, which is stored after its parents, is writable
+ * Returns 1 if writable, 0 if not or -1 on error
  */
-int mount_handle_get_media_size(
+int mount_handle_is_writable(
      mount_handle_t *mount_handle,
      int input_handle_index,
-     size64_t *size,
      libcerror_error_t **error )
 {
-	libvmdk_handle_t *input_handle = NULL;
-	static char *function          = "mount_handle_get_media_size";
+	static char *function       = "mount_handle_is_writable";
+	int number_of_input_handles = 0;
 
 	if( mount_handle == NULL )
 	{
@@ -1117,36 +3255,27 @@ int mount_handle_get_media_size(
 
 		return( -1 );
 	}
-	if( libcdata_array_get_entry_by_index(
+	if( mount_handle->write_access == 0 )
+	{
+		return( 0 );
+	}
+	if( libcdata_array_get_number_of_entries(
 	     mount_handle->input_handles_array,
-	     input_handle_index,
-	     (intptr_t **) &input_handle,
+	     &number_of_input_handles,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
 		 error,
 		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve input handle: %d.",
-		 function,
-		 input_handle_index );
+		 "%s: unable to retrieve number of input handles.",
+		 function );
 
 		return( -1 );
 	}
-	if( libvmdk_handle_get_media_size(
-	     input_handle,
-	     size,
-	     error ) != 1 )
+	if( input_handle_index != ( number_of_input_handles - 1 ) )
 	{
-		libcerror_error_set(
-		 error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-		 "%s: unable to retrieve media size from input handle: %d.",
-		 function,
-		 input_handle_index );
-
-		return( -1 );
+		return( 0 );
 	}
 	return( 1 );
 }
@@ -26,15 +26,29 @@
 #include <file_stream.h>
 #include <types.h>
 
+#include "parent_registry.h"
 #include "vmdktools_libcdata.h"
 #include "vmdktools_libcerror.h"
 #include "vmdktools_libcnotify.h"
+#include "vmdktools_libcthreads.h"
 #include "vmdktools_libvmdk.h"
 
 #if defined( __cplusplus )
 extern "C" {
 #endif
 
+/* The maximum number of threads used to serve requests
+ */
+#define MOUNT_HANDLE_MAXIMUM_NUMBER_OF_THREADS	64
+
+/* The maximum size of the cache pool in MiB
+ */
+#define MOUNT_HANDLE_MAXIMUM_CACHE_SIZE		1048576
+
+/* The size of the buffer needed to describe the read statistics of an input handle
+ */
+#define MOUNT_HANDLE_STATISTICS_STRING_SIZE	8192
+
 typedef struct mount_handle mount_handle_t;
 
 struct mount_handle
@@ -48,9 +62,49 @@ struct mount_handle
 	size_t basename_size;
 
 	/* The input handles array
+	 * The parent input handles are stored before the input handle
+	 * unless they are managed by the parent registry
 	 */
 	libcdata_array_t *input_handles_array;
 
+	/* Value to indicate the input handle should be opened with write access
+	 * The parent input handles are always opened read-only
+	 */
+	int write_access;
+
+	/* The number of threads used to serve requests
+	 */
+	int number_of_threads;
+
+	/* The readers array
+	 * Every entry contains an array of input handles that were opened read-only
+	 * on the same files as the input handles array, so that reads can be served
+	 * concurrently, the parent input handles are never shared with the parent registry
+	 */
+	libcdata_array_t *readers_array;
+
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+	/* The queue of the input handles arrays that are available to serve reads
+	 */
+	libcthreads_queue_t *readers_queue;
+#endif
+
+	/* The statistics flags of the input handles
+	 */
+	uint8_t statistics_flags;
+
+	/* The cache pool shared by the input handles
+	 */
+	libvmdk_cache_pool_t *cache_pool;
+
+	/* Value to indicate if the cache pool was created inside the mount handle
+	 */
+	uint8_t cache_pool_created_in_handle;
+
+	/* The parent registry used to share the parent input handles
+	 */
+	parent_registry_t *parent_registry;
+
 	/* The notification output stream
 	 */
 	FILE *notify_stream;
@@ -73,41 +127,154 @@ int mount_handle_set_format(
      const system_character_t *string,
      libcerror_error_t **error );
 
+int mount_handle_set_number_of_threads(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int mount_handle_copy_string_to_cache_size(
+     const system_character_t *string,
+     size64_t *cache_size,
+     libcerror_error_t **error );
+
+int mount_handle_set_maximum_cache_size(
+     mount_handle_t *mount_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int mount_handle_set_cache_pool(
+     mount_handle_t *mount_handle,
+     libvmdk_cache_pool_t *cache_pool,
+     libcerror_error_t **error );
+
+int mount_handle_set_parent_registry(
+     mount_handle_t *mount_handle,
+     parent_registry_t *parent_registry,
+     libcerror_error_t **error );
+
+int mount_handle_free_input_handles_array(
+     libcdata_array_t **input_handles_array,
+     libcerror_error_t **error );
+
 int mount_handle_open_input(
      mount_handle_t *mount_handle,
      system_character_t * const * filenames,
      int number_of_filenames,
      libcerror_error_t **error );
 
+int mount_handle_open_input_handle(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     int access_flags,
+     libcdata_array_t *input_handles_array,
+     parent_registry_t *parent_registry,
+     libcerror_error_t **error );
+
 int mount_handle_open_input_parent_handle(
      mount_handle_t *mount_handle,
      libvmdk_handle_t *input_handle,
+     libcdata_array_t *input_handles_array,
+     parent_registry_t *parent_registry,
+     libcerror_error_t **error );
+
+#if defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT )
+
+int mount_handle_open_readers(
+     mount_handle_t *mount_handle,
+     const system_character_t *filename,
+     libcerror_error_t **error );
+
+#endif /* defined( HAVE_VMDKTOOLS_MULTI_THREAD_SUPPORT ) */
+
+int mount_handle_get_reader(
+     mount_handle_t *mount_handle,
+     int reader_index,
+     libcdata_array_t **input_handles_array,
+     libcerror_error_t **error );
+
+int mount_handle_get_reader_input_handle(
+     mount_handle_t *mount_handle,
+     libcdata_array_t *input_handles_array,
+     int input_handle_index,
+     libvmdk_handle_t **input_handle,
      libcerror_error_t **error );
 
 int mount_handle_close(
      mount_handle_t *mount_handle,
      libcerror_error_t **error );
 
-ssize_t mount_handle_read_buffer(
+ssize_t mount_handle_read_buffer_at_offset(
          mount_handle_t *mount_handle,
          int input_handle_index,
          uint8_t *buffer,
          size_t size,
+         off64_t offset,
          libcerror_error_t **error );
 
-off64_t mount_handle_seek_offset(
+ssize_t mount_handle_write_buffer_at_offset(
          mount_handle_t *mount_handle,
          int input_handle_index,
+         const uint8_t *buffer,
+         size_t size,
          off64_t offset,
-         int whence,
          libcerror_error_t **error );
 
+int mount_handle_discard(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     off64_t offset,
+     size64_t size,
+     libcerror_error_t **error );
+
+int mount_handle_find_data_offset(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     off64_t offset,
+     uint8_t find_hole,
+     off64_t *found_offset,
+     libcerror_error_t **error );
+
+int mount_handle_get_data_range_at_offset(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     off64_t offset,
+     size64_t *range_size,
+     uint32_t *range_flags,
+     libcerror_error_t **error );
+
+int mount_handle_get_statistics_value(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     int value_type,
+     uint64_t *value,
+     libcerror_error_t **error );
+
+int mount_handle_get_statistics_histogram(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     int histogram_type,
+     uint64_t *histogram,
+     libcerror_error_t **error );
+
+int mount_handle_get_statistics_string(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     char *string,
+     size_t string_size,
+     size_t *string_length,
+     libcerror_error_t **error );
+
 int mount_handle_get_media_size(
      mount_handle_t *mount_handle,
      int input_handle_index,
      size64_t *size,
      libcerror_error_t **error );
 
+int mount_handle_is_writable(
+     mount_handle_t *mount_handle,
+     int input_handle_index,
+     libcerror_error_t **error );
+
 int mount_handle_get_number_of_input_handles(
      mount_handle_t *mount_handle,
      int *number_of_input_handles,
@@ -0,0 +1,3251 @@
+/*
+ * Network Block Device (NBD) handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <byte_stream.h>
+#include <common.h>
+#include <memory.h>
+#include <narrow_string.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_ERRNO_H )
+#include <errno.h>
+#endif
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#include "nbd_handle.h"
+
+#if defined( NBD_HANDLE_HAVE_SOCKET_SUPPORT )
+
+#if defined( TIME_WITH_SYS_TIME )
+#include <sys/time.h>
+#include <time.h>
+#elif defined( HAVE_SYS_TIME_H )
+#include <sys/time.h>
+#else
+#include <time.h>
+#endif
+
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+
+#if defined( HAVE_NETINET_TCP_H )
+#include <netinet/tcp.h>
+#endif
+
+#endif /* defined( NBD_HANDLE_HAVE_SOCKET_SUPPORT ) */
+
+#include "mount_handle.h"
+#include "parent_registry.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libcpath.h"
+#include "vmdktools_libfvalue.h"
+#include "vmdktools_libvmdk.h"
+
+#if !defined( MSG_NOSIGNAL )
+#define MSG_NOSIGNAL	0
+#endif
+
+#if !defined( MSG_MORE )
+#define MSG_MORE	0
+#endif
+
+/* Frees an export
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_export_free(
+     nbd_handle_export_t **export,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_export_free";
+	int result            = 1;
+
+	if( export == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export.",
+		 function );
+
+		return( -1 );
+	}
+	if( *export != NULL )
+	{
+		if( ( *export )->mount_handle != NULL )
+		{
+			if( mount_handle_close(
+			     ( *export )->mount_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close mount handle.",
+				 function );
+
+				result = -1;
+			}
+			if( mount_handle_free(
+			     &( ( *export )->mount_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free mount handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *export )->name != NULL )
+		{
+			memory_free(
+			 ( *export )->name );
+		}
+		memory_free(
+		 *export );
+
+		*export = NULL;
+	}
+	return( result );
+}
+
+/* Creates a NBD handle
+ * Make sure the value nbd_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_initialize(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_initialize";
+	int client_index      = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*nbd_handle = memory_allocate_structure(
+	               nbd_handle_t );
+
+	if( *nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create NBD handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *nbd_handle,
+	     0,
+	     sizeof( nbd_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear NBD handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_handle )->socket_descriptor = -1;
+
+	for( client_index = 0;
+	     client_index < NBD_HANDLE_MAXIMUM_NUMBER_OF_CLIENTS;
+	     client_index++ )
+	{
+		( *nbd_handle )->clients[ client_index ].socket_descriptor = -1;
+	}
+	if( libcdata_array_initialize(
+	     &( ( *nbd_handle )->exports_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize exports array.",
+		 function );
+
+		goto on_error;
+	}
+	if( parent_registry_initialize(
+	     &( ( *nbd_handle )->parent_registry ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize parent registry.",
+		 function );
+
+		goto on_error;
+	}
+	( *nbd_handle )->notify_stream = stderr;
+
+	return( 1 );
+
+on_error:
+	if( *nbd_handle != NULL )
+	{
+		if( ( *nbd_handle )->exports_array != NULL )
+		{
+			libcdata_array_free(
+			 &( ( *nbd_handle )->exports_array ),
+			 NULL,
+			 NULL );
+		}
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a NBD handle
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_free(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_free";
+	int result            = 1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *nbd_handle != NULL )
+	{
+#if defined( NBD_HANDLE_HAVE_SOCKET_SUPPORT )
+		if( nbd_handle_close(
+		     *nbd_handle,
+		     error ) != 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 "%s: unable to close NBD handle.",
+			 function );
+
+			result = -1;
+		}
+#endif
+		if( ( *nbd_handle )->socket_path != NULL )
+		{
+			memory_free(
+			 ( *nbd_handle )->socket_path );
+		}
+		if( ( *nbd_handle )->buffer != NULL )
+		{
+			memory_free(
+			 ( *nbd_handle )->buffer );
+		}
+		if( libcdata_array_free(
+		     &( ( *nbd_handle )->exports_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &nbd_handle_export_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free exports array.",
+			 function );
+
+			result = -1;
+		}
+		/* The parent registry is freed after the exports since their input handles
+		 * refer to the parent input handles
+		 */
+		if( parent_registry_free(
+		     &( ( *nbd_handle )->parent_registry ),
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free parent registry.",
+			 function );
+
+			result = -1;
+		}
+		if( ( *nbd_handle )->cache_pool != NULL )
+		{
+			if( libvmdk_cache_pool_free(
+			     &( ( *nbd_handle )->cache_pool ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free cache pool.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *nbd_handle );
+
+		*nbd_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the NBD handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_signal_abort(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_signal_abort";
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	nbd_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Sets the TCP port
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int nbd_handle_set_port(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_set_port";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( value_64bit == 0 )
+	 || ( value_64bit > (uint64_t) UINT16_MAX ) )
+	{
+		return( 0 );
+	}
+	nbd_handle->port = (uint16_t) value_64bit;
+
+	return( 1 );
+}
+
+/* Sets the maximum cache size in MiB
+ * Creates a cache pool that is shared by all the exports
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int nbd_handle_set_maximum_cache_size(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function       = "nbd_handle_set_maximum_cache_size";
+	size64_t maximum_cache_size = 0;
+	int result                  = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->cache_pool != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle - cache pool already set.",
+		 function );
+
+		return( -1 );
+	}
+	result = mount_handle_copy_string_to_cache_size(
+	          string,
+	          &maximum_cache_size,
+	          error );
+
+	if( result != 1 )
+	{
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+			 "%s: unable to copy string to cache size.",
+			 function );
+		}
+		return( result );
+	}
+	if( libvmdk_cache_pool_initialize(
+	     &( nbd_handle->cache_pool ),
+	     maximum_cache_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize cache pool.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Opens an input image and adds it as an export
+ * The export name is the filename without its directory
+ * Returns 1 if successful, 0 if disk type is not supported or -1 on error
+ */
+int nbd_handle_open_input(
+     nbd_handle_t *nbd_handle,
+     system_character_t *filename,
+     libcerror_error_t **error )
+{
+	nbd_handle_export_t *existing_export = NULL;
+	nbd_handle_export_t *export          = NULL;
+	system_character_t *name_start       = NULL;
+	static char *function                = "nbd_handle_open_input";
+	size_t filename_length               = 0;
+	size_t name_length                   = 0;
+	int entry_index                      = 0;
+	int number_of_input_handles          = 0;
+	int result                           = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filename == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filename.",
+		 function );
+
+		return( -1 );
+	}
+	filename_length = system_string_length(
+	                   filename );
+
+	name_start = system_string_search_character_reverse(
+	              filename,
+	              (system_character_t) LIBCPATH_SEPARATOR,
+	              filename_length + 1 );
+
+	if( name_start != NULL )
+	{
+		name_start++;
+	}
+	else
+	{
+		name_start = filename;
+	}
+	name_length = filename_length - (size_t) ( name_start - filename );
+
+	if( name_length == 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid filename value missing name.",
+		 function );
+
+		return( -1 );
+	}
+	result = nbd_handle_get_export_by_name(
+	          nbd_handle,
+	          (uint8_t *) name_start,
+	          name_length,
+	          &existing_export,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve export by name.",
+		 function );
+
+		return( -1 );
+	}
+	else if( result != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid export name: %" PRIs_SYSTEM " value already in use.",
+		 function,
+		 name_start );
+
+		return( -1 );
+	}
+	export = memory_allocate_structure(
+	          nbd_handle_export_t );
+
+	if( export == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     export,
+	     0,
+	     sizeof( nbd_handle_export_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear export.",
+		 function );
+
+		memory_free(
+		 export );
+
+		return( -1 );
+	}
+	export->name_size = name_length + 1;
+
+	export->name = narrow_string_allocate(
+	                export->name_size );
+
+	if( export->name == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create export name.",
+		 function );
+
+		goto on_error;
+	}
+	if( narrow_string_copy(
+	     export->name,
+	     name_start,
+	     name_length ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+		 "%s: unable to copy export name.",
+		 function );
+
+		goto on_error;
+	}
+	export->name[ name_length ] = 0;
+
+	if( mount_handle_initialize(
+	     &( export->mount_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize mount handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( nbd_handle->cache_pool != NULL )
+	{
+		if( mount_handle_set_cache_pool(
+		     export->mount_handle,
+		     nbd_handle->cache_pool,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set cache pool of mount handle.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( mount_handle_set_parent_registry(
+	     export->mount_handle,
+	     nbd_handle->parent_registry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 "%s: unable to set parent registry of mount handle.",
+		 function );
+
+		goto on_error;
+	}
+	result = mount_handle_open_input(
+	          export->mount_handle,
+	          &filename,
+	          1,
+	          error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input: %" PRIs_SYSTEM ".",
+		 function,
+		 filename );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		nbd_handle_export_free(
+		 &export,
+		 NULL );
+
+		return( 0 );
+	}
+	if( mount_handle_get_number_of_input_handles(
+	     export->mount_handle,
+	     &number_of_input_handles,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of input handles.",
+		 function );
+
+		goto on_error;
+	}
+	/* The input handle is stored after its parents
+	 */
+	export->input_handle_index = number_of_input_handles - 1;
+
+	if( mount_handle_get_media_size(
+	     export->mount_handle,
+	     export->input_handle_index,
+	     &( export->media_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_append_entry(
+	     nbd_handle->exports_array,
+	     &entry_index,
+	     (intptr_t *) export,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append export to array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( export != NULL )
+	{
+		nbd_handle_export_free(
+		 &export,
+		 NULL );
+	}
+	return( -1 );
+}
+
+/* Retrieves an export by its name
+ * An empty name refers to the first export
+ * Returns 1 if successful, 0 if no such export or -1 on error
+ */
+int nbd_handle_get_export_by_name(
+     nbd_handle_t *nbd_handle,
+     const uint8_t *name,
+     size_t name_length,
+     nbd_handle_export_t **export,
+     libcerror_error_t **error )
+{
+	nbd_handle_export_t *safe_export = NULL;
+	static char *function            = "nbd_handle_get_export_by_name";
+	int export_index                 = 0;
+	int number_of_exports            = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( name == NULL )
+	 && ( name_length > 0 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid name.",
+		 function );
+
+		return( -1 );
+	}
+	if( export == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export.",
+		 function );
+
+		return( -1 );
+	}
+	if( libcdata_array_get_number_of_entries(
+	     nbd_handle->exports_array,
+	     &number_of_exports,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of exports.",
+		 function );
+
+		return( -1 );
+	}
+	for( export_index = 0;
+	     export_index < number_of_exports;
+	     export_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     nbd_handle->exports_array,
+		     export_index,
+		     (intptr_t **) &safe_export,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve export: %d.",
+			 function,
+			 export_index );
+
+			return( -1 );
+		}
+		if( name_length == 0 )
+		{
+			*export = safe_export;
+
+			return( 1 );
+		}
+		if( ( safe_export->name_size == ( name_length + 1 ) )
+		 && ( memory_compare(
+		       safe_export->name,
+		       name,
+		       name_length ) == 0 ) )
+		{
+			*export = safe_export;
+
+			return( 1 );
+		}
+	}
+	return( 0 );
+}
+
+#if defined( NBD_HANDLE_HAVE_SOCKET_SUPPORT )
+
+/* Opens the listening socket
+ * If a socket path is provided a Unix domain socket is created at the path,
+ * otherwise a TCP socket is bound to the port on the loopback address
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_open_socket(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *socket_path,
+     libcerror_error_t **error )
+{
+	struct sockaddr_in inet_address;
+	struct sockaddr_un unix_address;
+
+	struct sockaddr *address      = NULL;
+	static char *function         = "nbd_handle_open_socket";
+	socklen_t address_size        = 0;
+	size_t socket_path_length     = 0;
+	int option_value              = 1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->socket_descriptor != -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid NBD handle - socket already open.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_path != NULL )
+	{
+		socket_path_length = system_string_length(
+		                      socket_path );
+
+		if( ( socket_path_length == 0 )
+		 || ( socket_path_length >= sizeof( unix_address.sun_path ) ) )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid socket path length value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     &unix_address,
+		     0,
+		     sizeof( struct sockaddr_un ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear Unix domain socket address.",
+			 function );
+
+			return( -1 );
+		}
+		unix_address.sun_family = AF_UNIX;
+
+		if( narrow_string_copy(
+		     unix_address.sun_path,
+		     socket_path,
+		     socket_path_length ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy socket path.",
+			 function );
+
+			return( -1 );
+		}
+		address      = (struct sockaddr *) &unix_address;
+		address_size = (socklen_t) sizeof( struct sockaddr_un );
+
+		nbd_handle->socket_descriptor = socket(
+		                                 AF_UNIX,
+		                                 SOCK_STREAM,
+		                                 0 );
+	}
+	else
+	{
+		if( nbd_handle->port == 0 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid NBD handle - missing port.",
+			 function );
+
+			return( -1 );
+		}
+		if( memory_set(
+		     &inet_address,
+		     0,
+		     sizeof( struct sockaddr_in ) ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear TCP socket address.",
+			 function );
+
+			return( -1 );
+		}
+		inet_address.sin_family      = AF_INET;
+		inet_address.sin_port        = htons( nbd_handle->port );
+		inet_address.sin_addr.s_addr = htonl( INADDR_LOOPBACK );
+
+		address      = (struct sockaddr *) &inet_address;
+		address_size = (socklen_t) sizeof( struct sockaddr_in );
+
+		nbd_handle->socket_descriptor = socket(
+		                                 AF_INET,
+		                                 SOCK_STREAM,
+		                                 0 );
+	}
+	if( nbd_handle->socket_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to create socket.",
+		 function );
+
+		return( -1 );
+	}
+	if( socket_path == NULL )
+	{
+		if( setsockopt(
+		     nbd_handle->socket_descriptor,
+		     SOL_SOCKET,
+		     SO_REUSEADDR,
+		     &option_value,
+		     (socklen_t) sizeof( int ) ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 errno,
+			 "%s: unable to set socket option: SO_REUSEADDR.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( bind(
+	     nbd_handle->socket_descriptor,
+	     address,
+	     address_size ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to bind socket.",
+		 function );
+
+		goto on_error;
+	}
+	if( socket_path != NULL )
+	{
+		/* The socket file is created by bind and removed on close
+		 */
+		nbd_handle->socket_path = system_string_allocate(
+		                           socket_path_length + 1 );
+
+		if( nbd_handle->socket_path == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create socket path.",
+			 function );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     nbd_handle->socket_path,
+		     socket_path,
+		     socket_path_length + 1 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy socket path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	if( listen(
+	     nbd_handle->socket_descriptor,
+	     NBD_HANDLE_MAXIMUM_NUMBER_OF_CLIENTS ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to listen on socket.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	nbd_handle_close(
+	 nbd_handle,
+	 NULL );
+
+	return( -1 );
+}
+
+/* Closes the listening socket and the connected clients
+ * Returns the 0 if succesful or -1 on error
+ */
+int nbd_handle_close(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_close";
+	int client_index      = 0;
+	int result            = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	for( client_index = 0;
+	     client_index < NBD_HANDLE_MAXIMUM_NUMBER_OF_CLIENTS;
+	     client_index++ )
+	{
+		nbd_handle_close_client(
+		 &( nbd_handle->clients[ client_index ] ) );
+	}
+	if( nbd_handle->socket_descriptor != -1 )
+	{
+		if( close(
+		     nbd_handle->socket_descriptor ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+			 errno,
+			 "%s: unable to close socket.",
+			 function );
+
+			result = -1;
+		}
+		nbd_handle->socket_descriptor = -1;
+	}
+	if( nbd_handle->socket_path != NULL )
+	{
+		if( unlink(
+		     nbd_handle->socket_path ) != 0 )
+		{
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_UNLINK_FAILED,
+			 errno,
+			 "%s: unable to remove socket: %" PRIs_SYSTEM ".",
+			 function,
+			 nbd_handle->socket_path );
+
+			result = -1;
+		}
+		memory_free(
+		 nbd_handle->socket_path );
+
+		nbd_handle->socket_path = NULL;
+	}
+	return( result );
+}
+
+/* Reads a message of a specific size from a socket
+ * Returns 1 if successful, 0 if the connection was closed or -1 on error
+ */
+int nbd_handle_read_message(
+     int socket_descriptor,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_read_message";
+	size_t buffer_offset  = 0;
+	ssize_t read_count    = 0;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	while( buffer_offset < size )
+	{
+		read_count = recv(
+		              socket_descriptor,
+		              &( buffer[ buffer_offset ] ),
+		              size - buffer_offset,
+		              0 );
+
+		if( read_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_READ_FAILED,
+			 errno,
+			 "%s: unable to read from socket.",
+			 function );
+
+			return( -1 );
+		}
+		else if( read_count == 0 )
+		{
+			return( 0 );
+		}
+		buffer_offset += (size_t) read_count;
+	}
+	return( 1 );
+}
+
+/* Writes a message of a specific size to a socket
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_write_message(
+     int socket_descriptor,
+     const uint8_t *buffer,
+     size_t size,
+     int more_data,
+     libcerror_error_t **error )
+{
+	static char *function = "nbd_handle_write_message";
+	size_t buffer_offset  = 0;
+	ssize_t write_count   = 0;
+	int flags             = MSG_NOSIGNAL;
+
+	if( buffer == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid buffer.",
+		 function );
+
+		return( -1 );
+	}
+	if( more_data != 0 )
+	{
+		flags |= MSG_MORE;
+	}
+	while( buffer_offset < size )
+	{
+		write_count = send(
+		               socket_descriptor,
+		               &( buffer[ buffer_offset ] ),
+		               size - buffer_offset,
+		               flags );
+
+		if( write_count == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 errno,
+			 "%s: unable to write to socket.",
+			 function );
+
+			return( -1 );
+		}
+		buffer_offset += (size_t) write_count;
+	}
+	return( 1 );
+}
+
+/* Accepts a client connection and sends the handshake
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_accept_client(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	struct timeval timeout;
+
+	uint8_t handshake_data[ 18 ];
+
+	nbd_handle_client_t *client = NULL;
+	static char *function       = "nbd_handle_accept_client";
+	int client_index            = 0;
+	int option_value            = 1;
+	int socket_descriptor       = -1;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	socket_descriptor = accept(
+	                     nbd_handle->socket_descriptor,
+	                     NULL,
+	                     NULL );
+
+	if( socket_descriptor == -1 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 errno,
+		 "%s: unable to accept client connection.",
+		 function );
+
+		return( -1 );
+	}
+	for( client_index = 0;
+	     client_index < NBD_HANDLE_MAXIMUM_NUMBER_OF_CLIENTS;
+	     client_index++ )
+	{
+		if( nbd_handle->clients[ client_index ].state == NBD_HANDLE_CLIENT_STATE_UNUSED )
+		{
+			client = &( nbd_handle->clients[ client_index ] );
+
+			break;
+		}
+	}
+	if( client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: maximum number of clients reached.",
+		 function );
+
+		goto on_error;
+	}
+	/* Prevent a client that stalls in the middle of a message from blocking the other clients
+	 */
+	timeout.tv_sec  = NBD_HANDLE_CLIENT_TIMEOUT;
+	timeout.tv_usec = 0;
+
+	if( setsockopt(
+	     socket_descriptor,
+	     SOL_SOCKET,
+	     SO_RCVTIMEO,
+	     &timeout,
+	     (socklen_t) sizeof( struct timeval ) ) != 0 )
+	{
+		libcerror_system_set_error(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+		 errno,
+		 "%s: unable to set socket option: SO_RCVTIMEO.",
+		 function );
+
+		goto on_error;
+	}
+#if defined( HAVE_NETINET_TCP_H ) && defined( TCP_NODELAY )
+	if( nbd_handle->socket_path == NULL )
+	{
+		/* Ignore the result since the option only reduces the reply latency
+		 */
+		setsockopt(
+		 socket_descriptor,
+		 IPPROTO_TCP,
+		 TCP_NODELAY,
+		 &option_value,
+		 (socklen_t) sizeof( int ) );
+	}
+#endif
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 0 ] ),
+	 NBD_HANDLE_MAGIC_INIT_PASSWORD );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( handshake_data[ 8 ] ),
+	 NBD_HANDLE_MAGIC_OPTION );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( handshake_data[ 16 ] ),
+	 NBD_HANDLE_FLAG_FIXED_NEWSTYLE | NBD_HANDLE_FLAG_NO_ZEROES );
+
+	if( nbd_handle_write_message(
+	     socket_descriptor,
+	     handshake_data,
+	     18,
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write handshake.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     client,
+	     0,
+	     sizeof( nbd_handle_client_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear client.",
+		 function );
+
+		goto on_error;
+	}
+	client->state             = NBD_HANDLE_CLIENT_STATE_CLIENT_FLAGS;
+	client->socket_descriptor = socket_descriptor;
+
+	return( 1 );
+
+on_error:
+	close(
+	 socket_descriptor );
+
+	return( -1 );
+}
+
+/* Closes a client connection
+ */
+void nbd_handle_close_client(
+      nbd_handle_client_t *client )
+{
+	if( client == NULL )
+	{
+		return;
+	}
+	if( client->socket_descriptor != -1 )
+	{
+		close(
+		 client->socket_descriptor );
+	}
+	client->state             = NBD_HANDLE_CLIENT_STATE_UNUSED;
+	client->socket_descriptor = -1;
+	client->export            = NULL;
+}
+
+/* Writes an option reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_write_option_reply(
+     nbd_handle_client_t *client,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_data[ 20 ];
+
+	static char *function = "nbd_handle_write_option_reply";
+
+	if( client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid client.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) UINT32_MAX )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_data[ 0 ] ),
+	 NBD_HANDLE_MAGIC_OPTION_REPLY );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_data[ 8 ] ),
+	 option );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_data[ 12 ] ),
+	 reply_type );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_data[ 16 ] ),
+	 (uint32_t) data_size );
+
+	if( nbd_handle_write_message(
+	     client->socket_descriptor,
+	     reply_data,
+	     20,
+	     data_size > 0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write option reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_handle_write_message(
+		     client->socket_descriptor,
+		     data,
+		     data_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write option reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Processes an option during the handshake phase
+ * Returns 1 if successful, 0 if the connection should be closed or -1 on error
+ */
+int nbd_handle_process_option(
+     nbd_handle_t *nbd_handle,
+     nbd_handle_client_t *client,
+     libcerror_error_t **error )
+{
+	uint8_t option_header[ 16 ];
+	uint8_t reply_data[ 134 ];
+
+	nbd_handle_export_t *export   = NULL;
+	uint8_t *option_data          = NULL;
+	static char *function         = "nbd_handle_process_option";
+	size_t data_offset            = 0;
+	size_t reply_data_size        = 0;
+	uint64_t magic                = 0;
+	uint32_t name_length          = 0;
+	uint32_t option               = 0;
+	uint32_t option_data_size     = 0;
+	uint16_t information_type     = 0;
+	uint16_t number_of_requests   = 0;
+	uint16_t request_index        = 0;
+	uint8_t send_block_size       = 0;
+	int export_index              = 0;
+	int number_of_exports         = 0;
+	int result                    = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid client.",
+		 function );
+
+		return( -1 );
+	}
+	option_data = nbd_handle->option_data;
+
+	result = nbd_handle_read_message(
+	          client->socket_descriptor,
+	          option_header,
+	          16,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	byte_stream_copy_to_uint64_big_endian(
+	 &( option_header[ 0 ] ),
+	 magic );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( option_header[ 8 ] ),
+	 option );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( option_header[ 12 ] ),
+	 option_data_size );
+
+	if( magic != NBD_HANDLE_MAGIC_OPTION )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+		 "%s: unsupported option magic.",
+		 function );
+
+		return( -1 );
+	}
+	if( option_data_size > (uint32_t) NBD_HANDLE_MAXIMUM_OPTION_DATA_SIZE )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid option: %" PRIu32 " data size value out of bounds.",
+		 function,
+		 option );
+
+		return( -1 );
+	}
+	if( option_data_size > 0 )
+	{
+		result = nbd_handle_read_message(
+		          client->socket_descriptor,
+		          option_data,
+		          (size_t) option_data_size,
+		          error );
+
+		if( result != 1 )
+		{
+			return( result );
+		}
+	}
+	switch( option )
+	{
+		case NBD_HANDLE_OPTION_EXPORT_NAME:
+			result = nbd_handle_get_export_by_name(
+			          nbd_handle,
+			          option_data,
+			          (size_t) option_data_size,
+			          &export,
+			          error );
+
+			if( result != 1 )
+			{
+				/* The export name option has no error reply
+				 */
+				return( result );
+			}
+			byte_stream_copy_from_uint64_big_endian(
+			 &( reply_data[ 0 ] ),
+			 export->media_size );
+
+			byte_stream_copy_from_uint16_big_endian(
+			 &( reply_data[ 8 ] ),
+			 NBD_HANDLE_FLAG_HAS_FLAGS | NBD_HANDLE_FLAG_READ_ONLY | NBD_HANDLE_FLAG_SEND_FLUSH | NBD_HANDLE_FLAG_CAN_MULTI_CONN );
+
+			reply_data_size = 10;
+
+			if( ( client->client_flags & NBD_HANDLE_FLAG_NO_ZEROES ) == 0 )
+			{
+				if( memory_set(
+				     &( reply_data[ 10 ] ),
+				     0,
+				     124 ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+					 "%s: unable to clear reply data.",
+					 function );
+
+					return( -1 );
+				}
+				reply_data_size += 124;
+			}
+			if( nbd_handle_write_message(
+			     client->socket_descriptor,
+			     reply_data,
+			     reply_data_size,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write export information.",
+				 function );
+
+				return( -1 );
+			}
+			client->export = export;
+			client->state  = NBD_HANDLE_CLIENT_STATE_TRANSMISSION;
+
+			return( 1 );
+
+		case NBD_HANDLE_OPTION_ABORT:
+			/* Ignore write errors since the client can close the connection before reading the reply
+			 */
+			nbd_handle_write_option_reply(
+			 client,
+			 option,
+			 NBD_HANDLE_REPLY_ACK,
+			 NULL,
+			 0,
+			 NULL );
+
+			return( 0 );
+
+		case NBD_HANDLE_OPTION_LIST:
+			if( option_data_size != 0 )
+			{
+				break;
+			}
+			if( libcdata_array_get_number_of_entries(
+			     nbd_handle->exports_array,
+			     &number_of_exports,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve number of exports.",
+				 function );
+
+				return( -1 );
+			}
+			for( export_index = 0;
+			     export_index < number_of_exports;
+			     export_index++ )
+			{
+				if( libcdata_array_get_entry_by_index(
+				     nbd_handle->exports_array,
+				     export_index,
+				     (intptr_t **) &export,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+					 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+					 "%s: unable to retrieve export: %d.",
+					 function,
+					 export_index );
+
+					return( -1 );
+				}
+				name_length = (uint32_t) ( export->name_size - 1 );
+
+				byte_stream_copy_from_uint32_big_endian(
+				 &( option_data[ 0 ] ),
+				 name_length );
+
+				if( memory_copy(
+				     &( option_data[ 4 ] ),
+				     export->name,
+				     (size_t) name_length ) == NULL )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_MEMORY,
+					 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+					 "%s: unable to copy export name.",
+					 function );
+
+					return( -1 );
+				}
+				if( nbd_handle_write_option_reply(
+				     client,
+				     option,
+				     NBD_HANDLE_REPLY_SERVER,
+				     option_data,
+				     4 + (size_t) name_length,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write export: %d.",
+					 function,
+					 export_index );
+
+					return( -1 );
+				}
+			}
+			result = nbd_handle_write_option_reply(
+			          client,
+			          option,
+			          NBD_HANDLE_REPLY_ACK,
+			          NULL,
+			          0,
+			          error );
+
+			return( result );
+
+		case NBD_HANDLE_OPTION_INFO:
+		case NBD_HANDLE_OPTION_GO:
+			if( option_data_size < 6 )
+			{
+				break;
+			}
+			byte_stream_copy_to_uint32_big_endian(
+			 &( option_data[ 0 ] ),
+			 name_length );
+
+			if( name_length > ( option_data_size - 6 ) )
+			{
+				break;
+			}
+			data_offset = 4 + (size_t) name_length;
+
+			byte_stream_copy_to_uint16_big_endian(
+			 &( option_data[ data_offset ] ),
+			 number_of_requests );
+
+			data_offset += 2;
+
+			if( ( data_offset + ( 2 * (size_t) number_of_requests ) ) != (size_t) option_data_size )
+			{
+				break;
+			}
+			for( request_index = 0;
+			     request_index < number_of_requests;
+			     request_index++ )
+			{
+				byte_stream_copy_to_uint16_big_endian(
+				 &( option_data[ data_offset ] ),
+				 information_type );
+
+				data_offset += 2;
+
+				if( information_type == NBD_HANDLE_INFO_BLOCK_SIZE )
+				{
+					send_block_size = 1;
+				}
+			}
+			result = nbd_handle_get_export_by_name(
+			          nbd_handle,
+			          &( option_data[ 4 ] ),
+			          (size_t) name_length,
+			          &export,
+			          error );
+
+			if( result == -1 )
+			{
+				return( -1 );
+			}
+			else if( result == 0 )
+			{
+				result = nbd_handle_write_option_reply(
+				          client,
+				          option,
+				          NBD_HANDLE_REPLY_ERROR_UNKNOWN,
+				          NULL,
+				          0,
+				          error );
+
+				return( result );
+			}
+			byte_stream_copy_from_uint16_big_endian(
+			 &( reply_data[ 0 ] ),
+			 NBD_HANDLE_INFO_EXPORT );
+
+			byte_stream_copy_from_uint64_big_endian(
+			 &( reply_data[ 2 ] ),
+			 export->media_size );
+
+			byte_stream_copy_from_uint16_big_endian(
+			 &( reply_data[ 10 ] ),
+			 NBD_HANDLE_FLAG_HAS_FLAGS | NBD_HANDLE_FLAG_READ_ONLY | NBD_HANDLE_FLAG_SEND_FLUSH | NBD_HANDLE_FLAG_CAN_MULTI_CONN );
+
+			if( nbd_handle_write_option_reply(
+			     client,
+			     option,
+			     NBD_HANDLE_REPLY_INFO,
+			     reply_data,
+			     12,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write export information.",
+				 function );
+
+				return( -1 );
+			}
+			if( send_block_size != 0 )
+			{
+				byte_stream_copy_from_uint16_big_endian(
+				 &( reply_data[ 0 ] ),
+				 NBD_HANDLE_INFO_BLOCK_SIZE );
+
+				byte_stream_copy_from_uint32_big_endian(
+				 &( reply_data[ 2 ] ),
+				 1 );
+
+				byte_stream_copy_from_uint32_big_endian(
+				 &( reply_data[ 6 ] ),
+				 NBD_HANDLE_PREFERRED_BLOCK_SIZE );
+
+				byte_stream_copy_from_uint32_big_endian(
+				 &( reply_data[ 10 ] ),
+				 NBD_HANDLE_MAXIMUM_REQUEST_SIZE );
+
+				if( nbd_handle_write_option_reply(
+				     client,
+				     option,
+				     NBD_HANDLE_REPLY_INFO,
+				     reply_data,
+				     14,
+				     error ) != 1 )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_WRITE_FAILED,
+					 "%s: unable to write block size information.",
+					 function );
+
+					return( -1 );
+				}
+			}
+			if( nbd_handle_write_option_reply(
+			     client,
+			     option,
+			     NBD_HANDLE_REPLY_ACK,
+			     NULL,
+			     0,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_WRITE_FAILED,
+				 "%s: unable to write acknowledgement.",
+				 function );
+
+				return( -1 );
+			}
+			if( option == NBD_HANDLE_OPTION_GO )
+			{
+				client->export = export;
+				client->state  = NBD_HANDLE_CLIENT_STATE_TRANSMISSION;
+			}
+			return( 1 );
+
+		case NBD_HANDLE_OPTION_STRUCTURED_REPLY:
+			if( option_data_size != 0 )
+			{
+				break;
+			}
+			client->structured_replies = 1;
+
+			result = nbd_handle_write_option_reply(
+			          client,
+			          option,
+			          NBD_HANDLE_REPLY_ACK,
+			          NULL,
+			          0,
+			          error );
+
+			return( result );
+
+		case NBD_HANDLE_OPTION_LIST_META_CONTEXT:
+		case NBD_HANDLE_OPTION_SET_META_CONTEXT:
+			result = nbd_handle_process_meta_context_option(
+			          nbd_handle,
+			          client,
+			          option,
+			          option_data,
+			          (size_t) option_data_size,
+			          error );
+
+			return( result );
+
+		default:
+			result = nbd_handle_write_option_reply(
+			          client,
+			          option,
+			          NBD_HANDLE_REPLY_ERROR_UNSUPPORTED,
+			          NULL,
+			          0,
+			          error );
+
+			return( result );
+	}
+	/* The option data is malformed
+	 */
+	result = nbd_handle_write_option_reply(
+	          client,
+	          option,
+	          NBD_HANDLE_REPLY_ERROR_INVALID,
+	          NULL,
+	          0,
+	          error );
+
+	return( result );
+}
+
+/* Processes a list or set meta context option
+ * Only the base:allocation meta context is supported
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_process_meta_context_option(
+     nbd_handle_t *nbd_handle,
+     nbd_handle_client_t *client,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_data[ 19 ];
+
+	const char *context_name       = "base:allocation";
+	nbd_handle_export_t *export    = NULL;
+	static char *function          = "nbd_handle_process_meta_context_option";
+	size_t data_offset             = 0;
+	uint32_t name_length           = 0;
+	uint32_t number_of_queries     = 0;
+	uint32_t query_index           = 0;
+	uint32_t query_length          = 0;
+	uint8_t base_allocation        = 0;
+	int result                     = 0;
+
+	if( client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid client.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( option == NBD_HANDLE_OPTION_SET_META_CONTEXT )
+	 && ( client->structured_replies == 0 ) )
+	{
+		result = nbd_handle_write_option_reply(
+		          client,
+		          option,
+		          NBD_HANDLE_REPLY_ERROR_INVALID,
+		          NULL,
+		          0,
+		          error );
+
+		return( result );
+	}
+	if( data_size < 8 )
+	{
+		result = nbd_handle_write_option_reply(
+		          client,
+		          option,
+		          NBD_HANDLE_REPLY_ERROR_INVALID,
+		          NULL,
+		          0,
+		          error );
+
+		return( result );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 &( data[ 0 ] ),
+	 name_length );
+
+	if( name_length > ( data_size - 8 ) )
+	{
+		result = nbd_handle_write_option_reply(
+		          client,
+		          option,
+		          NBD_HANDLE_REPLY_ERROR_INVALID,
+		          NULL,
+		          0,
+		          error );
+
+		return( result );
+	}
+	result = nbd_handle_get_export_by_name(
+	          nbd_handle,
+	          &( data[ 4 ] ),
+	          (size_t) name_length,
+	          &export,
+	          error );
+
+	if( result == -1 )
+	{
+		return( -1 );
+	}
+	else if( result == 0 )
+	{
+		result = nbd_handle_write_option_reply(
+		          client,
+		          option,
+		          NBD_HANDLE_REPLY_ERROR_UNKNOWN,
+		          NULL,
+		          0,
+		          error );
+
+		return( result );
+	}
+	data_offset = 4 + (size_t) name_length;
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( data[ data_offset ] ),
+	 number_of_queries );
+
+	data_offset += 4;
+
+	if( ( option == NBD_HANDLE_OPTION_LIST_META_CONTEXT )
+	 && ( number_of_queries == 0 ) )
+	{
+		base_allocation = 1;
+	}
+	for( query_index = 0;
+	     query_index < number_of_queries;
+	     query_index++ )
+	{
+		if( ( data_size - data_offset ) < 4 )
+		{
+			break;
+		}
+		byte_stream_copy_to_uint32_big_endian(
+		 &( data[ data_offset ] ),
+		 query_length );
+
+		data_offset += 4;
+
+		if( (size_t) query_length > ( data_size - data_offset ) )
+		{
+			break;
+		}
+		if( ( query_length == 15 )
+		 && ( memory_compare(
+		       &( data[ data_offset ] ),
+		       context_name,
+		       15 ) == 0 ) )
+		{
+			base_allocation = 1;
+		}
+		/* Listing the base namespace returns all its contexts
+		 */
+		else if( ( option == NBD_HANDLE_OPTION_LIST_META_CONTEXT )
+		      && ( query_length == 5 )
+		      && ( memory_compare(
+		            &( data[ data_offset ] ),
+		            context_name,
+		            5 ) == 0 ) )
+		{
+			base_allocation = 1;
+		}
+		data_offset += (size_t) query_length;
+	}
+	if( ( query_index != number_of_queries )
+	 || ( data_offset != data_size ) )
+	{
+		result = nbd_handle_write_option_reply(
+		          client,
+		          option,
+		          NBD_HANDLE_REPLY_ERROR_INVALID,
+		          NULL,
+		          0,
+		          error );
+
+		return( result );
+	}
+	if( option == NBD_HANDLE_OPTION_SET_META_CONTEXT )
+	{
+		client->base_allocation = base_allocation;
+	}
+	if( base_allocation != 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( reply_data[ 0 ] ),
+		 NBD_HANDLE_META_CONTEXT_BASE_ALLOCATION );
+
+		if( memory_copy(
+		     &( reply_data[ 4 ] ),
+		     context_name,
+		     15 ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy meta context name.",
+			 function );
+
+			return( -1 );
+		}
+		if( nbd_handle_write_option_reply(
+		     client,
+		     option,
+		     NBD_HANDLE_REPLY_META_CONTEXT,
+		     reply_data,
+		     19,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write meta context.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	result = nbd_handle_write_option_reply(
+	          client,
+	          option,
+	          NBD_HANDLE_REPLY_ACK,
+	          NULL,
+	          0,
+	          error );
+
+	return( result );
+}
+
+/* Writes a simple reply
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_write_simple_reply(
+     nbd_handle_client_t *client,
+     uint64_t cookie,
+     uint32_t error_value,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_data[ 16 ];
+
+	static char *function = "nbd_handle_write_simple_reply";
+
+	if( client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid client.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_data[ 0 ] ),
+	 NBD_HANDLE_MAGIC_SIMPLE_REPLY );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_data[ 4 ] ),
+	 error_value );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_data[ 8 ] ),
+	 cookie );
+
+	if( nbd_handle_write_message(
+	     client->socket_descriptor,
+	     reply_data,
+	     16,
+	     data_size > 0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_handle_write_message(
+		     client->socket_descriptor,
+		     data,
+		     data_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Writes a structured reply that consists of a single chunk
+ * The payload consists of the header data followed by the data
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_write_structured_reply(
+     nbd_handle_client_t *client,
+     uint64_t cookie,
+     uint16_t chunk_type,
+     const uint8_t *header_data,
+     size_t header_data_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error )
+{
+	uint8_t reply_data[ 40 ];
+
+	static char *function = "nbd_handle_write_structured_reply";
+
+	if( client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid client.",
+		 function );
+
+		return( -1 );
+	}
+	if( header_data_size > 20 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid header data size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > (size_t) ( UINT32_MAX - 20 ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid data size value exceeds maximum.",
+		 function );
+
+		return( -1 );
+	}
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_data[ 0 ] ),
+	 NBD_HANDLE_MAGIC_STRUCTURED_REPLY );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply_data[ 4 ] ),
+	 NBD_HANDLE_CHUNK_FLAG_DONE );
+
+	byte_stream_copy_from_uint16_big_endian(
+	 &( reply_data[ 6 ] ),
+	 chunk_type );
+
+	byte_stream_copy_from_uint64_big_endian(
+	 &( reply_data[ 8 ] ),
+	 cookie );
+
+	byte_stream_copy_from_uint32_big_endian(
+	 &( reply_data[ 16 ] ),
+	 (uint32_t) ( header_data_size + data_size ) );
+
+	if( header_data_size > 0 )
+	{
+		if( memory_copy(
+		     &( reply_data[ 20 ] ),
+		     header_data,
+		     header_data_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy header data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	if( nbd_handle_write_message(
+	     client->socket_descriptor,
+	     reply_data,
+	     20 + header_data_size,
+	     data_size > 0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write reply chunk header.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size > 0 )
+	{
+		if( nbd_handle_write_message(
+		     client->socket_descriptor,
+		     data,
+		     data_size,
+		     0,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_WRITE_FAILED,
+			 "%s: unable to write reply chunk data.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	return( 1 );
+}
+
+/* Retrieves the base:allocation block status descriptors of a range of an export
+ * The descriptors are determined from the grain tables, adjacent ranges with
+ * the same state are merged and the last descriptor is clipped to the range
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_get_block_status(
+     nbd_handle_export_t *export,
+     uint64_t offset,
+     uint32_t length,
+     uint8_t request_one,
+     uint8_t *data,
+     size_t data_size,
+     size_t *descriptors_data_size,
+     libcerror_error_t **error )
+{
+	static char *function         = "nbd_handle_get_block_status";
+	size_t data_offset            = 0;
+	size64_t range_size           = 0;
+	uint64_t end_offset           = 0;
+	uint32_t descriptor_length    = 0;
+	uint32_t descriptor_state     = 0;
+	uint32_t range_flags          = 0;
+	uint32_t range_state          = 0;
+	int result                    = 0;
+
+	if( export == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid export.",
+		 function );
+
+		return( -1 );
+	}
+	if( data == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid data.",
+		 function );
+
+		return( -1 );
+	}
+	if( data_size < 8 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_TOO_SMALL,
+		 "%s: invalid data size value too small.",
+		 function );
+
+		return( -1 );
+	}
+	if( descriptors_data_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid descriptors data size.",
+		 function );
+
+		return( -1 );
+	}
+	end_offset = offset + length;
+
+	while( offset < end_offset )
+	{
+		result = mount_handle_get_data_range_at_offset(
+		          export->mount_handle,
+		          export->input_handle_index,
+		          (off64_t) offset,
+		          &range_size,
+		          &range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range at offset: %" PRIu64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( ( result == 0 )
+		      || ( range_size == 0 ) )
+		{
+			break;
+		}
+		if( range_size > ( end_offset - offset ) )
+		{
+			range_size = end_offset - offset;
+		}
+		/* Sparse data is read as 0-byte values
+		 */
+		if( ( range_flags & LIBVMDK_RANGE_FLAG_IS_SPARSE ) != 0 )
+		{
+			range_state = NBD_HANDLE_STATE_HOLE | NBD_HANDLE_STATE_ZERO;
+		}
+		else if( ( range_flags & LIBVMDK_RANGE_FLAG_IS_ZERO ) != 0 )
+		{
+			range_state = NBD_HANDLE_STATE_ZERO;
+		}
+		else
+		{
+			range_state = 0;
+		}
+		if( ( descriptor_length > 0 )
+		 && ( range_state != descriptor_state ) )
+		{
+			byte_stream_copy_from_uint32_big_endian(
+			 &( data[ data_offset ] ),
+			 descriptor_length );
+
+			byte_stream_copy_from_uint32_big_endian(
+			 &( data[ data_offset + 4 ] ),
+			 descriptor_state );
+
+			data_offset      += 8;
+			descriptor_length = 0;
+
+			if( ( request_one != 0 )
+			 || ( ( data_size - data_offset ) < 8 ) )
+			{
+				break;
+			}
+		}
+		descriptor_state   = range_state;
+		descriptor_length += (uint32_t) range_size;
+		offset            += range_size;
+	}
+	if( descriptor_length > 0 )
+	{
+		byte_stream_copy_from_uint32_big_endian(
+		 &( data[ data_offset ] ),
+		 descriptor_length );
+
+		byte_stream_copy_from_uint32_big_endian(
+		 &( data[ data_offset + 4 ] ),
+		 descriptor_state );
+
+		data_offset += 8;
+	}
+	*descriptors_data_size = data_offset;
+
+	return( 1 );
+}
+
+/* Processes a request during the transmission phase
+ * Returns 1 if successful, 0 if the connection should be closed or -1 on error
+ */
+int nbd_handle_process_request(
+     nbd_handle_t *nbd_handle,
+     nbd_handle_client_t *client,
+     libcerror_error_t **error )
+{
+	uint8_t header_data[ 8 ];
+	uint8_t request_data[ 28 ];
+
+	static char *function         = "nbd_handle_process_request";
+	size_t data_size              = 0;
+	size_t read_size              = 0;
+	ssize_t read_count            = 0;
+	uint64_t cookie               = 0;
+	uint64_t offset               = 0;
+	uint32_t error_value          = 0;
+	uint32_t length               = 0;
+	uint32_t magic                = 0;
+	uint16_t command              = 0;
+	uint16_t command_flags        = 0;
+	int result                    = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid client.",
+		 function );
+
+		return( -1 );
+	}
+	if( client->export == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid client - missing export.",
+		 function );
+
+		return( -1 );
+	}
+	result = nbd_handle_read_message(
+	          client->socket_descriptor,
+	          request_data,
+	          28,
+	          error );
+
+	if( result != 1 )
+	{
+		return( result );
+	}
+	byte_stream_copy_to_uint32_big_endian(
+	 &( request_data[ 0 ] ),
+	 magic );
+
+	byte_stream_copy_to_uint16_big_endian(
+	 &( request_data[ 4 ] ),
+	 command_flags );
+
+	byte_stream_copy_to_uint16_big_endian(
+	 &( request_data[ 6 ] ),
+	 command );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( request_data[ 8 ] ),
+	 cookie );
+
+	byte_stream_copy_to_uint64_big_endian(
+	 &( request_data[ 16 ] ),
+	 offset );
+
+	byte_stream_copy_to_uint32_big_endian(
+	 &( request_data[ 24 ] ),
+	 length );
+
+	if( magic != NBD_HANDLE_MAGIC_REQUEST )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_INPUT,
+		 LIBCERROR_INPUT_ERROR_SIGNATURE_MISMATCH,
+		 "%s: unsupported request magic.",
+		 function );
+
+		return( -1 );
+	}
+	switch( command )
+	{
+		case NBD_HANDLE_COMMAND_READ:
+			if( ( length > (uint32_t) NBD_HANDLE_MAXIMUM_REQUEST_SIZE )
+			 || ( offset > client->export->media_size )
+			 || ( (size64_t) length > ( client->export->media_size - offset ) ) )
+			{
+				error_value = NBD_HANDLE_ERROR_EINVAL;
+
+				break;
+			}
+			if( length > 0 )
+			{
+				read_count = mount_handle_read_buffer_at_offset(
+				              client->export->mount_handle,
+				              client->export->input_handle_index,
+				              nbd_handle->buffer,
+				              (size_t) length,
+				              (off64_t) offset,
+				              error );
+
+				if( read_count != (ssize_t) length )
+				{
+					libcerror_error_set(
+					 error,
+					 LIBCERROR_ERROR_DOMAIN_IO,
+					 LIBCERROR_IO_ERROR_READ_FAILED,
+					 "%s: unable to read data at offset: %" PRIu64 ".",
+					 function,
+					 offset );
+
+					libcnotify_print_error_backtrace(
+					 *error );
+					libcerror_error_free(
+					 error );
+
+					error_value = NBD_HANDLE_ERROR_EIO;
+
+					break;
+				}
+			}
+			if( client->structured_replies == 0 )
+			{
+				result = nbd_handle_write_simple_reply(
+				          client,
+				          cookie,
+				          0,
+				          nbd_handle->buffer,
+				          (size_t) length,
+				          error );
+			}
+			else if( length == 0 )
+			{
+				result = nbd_handle_write_structured_reply(
+				          client,
+				          cookie,
+				          NBD_HANDLE_CHUNK_TYPE_NONE,
+				          NULL,
+				          0,
+				          NULL,
+				          0,
+				          error );
+			}
+			else
+			{
+				byte_stream_copy_from_uint64_big_endian(
+				 header_data,
+				 offset );
+
+				result = nbd_handle_write_structured_reply(
+				          client,
+				          cookie,
+				          NBD_HANDLE_CHUNK_TYPE_OFFSET_DATA,
+				          header_data,
+				          8,
+				          nbd_handle->buffer,
+				          (size_t) length,
+				          error );
+			}
+			return( result );
+
+		case NBD_HANDLE_COMMAND_WRITE:
+			/* Discard the write data to keep the connection in sync
+			 */
+			while( length > 0 )
+			{
+				read_size = (size_t) length;
+
+				if( read_size > (size_t) NBD_HANDLE_MAXIMUM_REQUEST_SIZE )
+				{
+					read_size = (size_t) NBD_HANDLE_MAXIMUM_REQUEST_SIZE;
+				}
+				result = nbd_handle_read_message(
+				          client->socket_descriptor,
+				          nbd_handle->buffer,
+				          read_size,
+				          error );
+
+				if( result != 1 )
+				{
+					return( result );
+				}
+				length -= (uint32_t) read_size;
+			}
+			error_value = NBD_HANDLE_ERROR_EPERM;
+
+			break;
+
+		case NBD_HANDLE_COMMAND_TRIM:
+		case NBD_HANDLE_COMMAND_WRITE_ZEROES:
+			error_value = NBD_HANDLE_ERROR_EPERM;
+
+			break;
+
+		case NBD_HANDLE_COMMAND_DISCONNECT:
+			return( 0 );
+
+		case NBD_HANDLE_COMMAND_FLUSH:
+			break;
+
+		case NBD_HANDLE_COMMAND_BLOCK_STATUS:
+			if( ( client->structured_replies == 0 )
+			 || ( client->base_allocation == 0 )
+			 || ( length == 0 )
+			 || ( offset > client->export->media_size )
+			 || ( (size64_t) length > ( client->export->media_size - offset ) ) )
+			{
+				error_value = NBD_HANDLE_ERROR_EINVAL;
+
+				break;
+			}
+			if( nbd_handle_get_block_status(
+			     client->export,
+			     offset,
+			     length,
+			     (uint8_t) ( ( command_flags & NBD_HANDLE_COMMAND_FLAG_REQUEST_ONE ) != 0 ),
+			     nbd_handle->buffer,
+			     NBD_HANDLE_MAXIMUM_NUMBER_OF_DESCRIPTORS * 8,
+			     &data_size,
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to retrieve block status at offset: %" PRIu64 ".",
+				 function,
+				 offset );
+
+				libcnotify_print_error_backtrace(
+				 *error );
+				libcerror_error_free(
+				 error );
+
+				error_value = NBD_HANDLE_ERROR_EIO;
+
+				break;
+			}
+			byte_stream_copy_from_uint32_big_endian(
+			 header_data,
+			 NBD_HANDLE_META_CONTEXT_BASE_ALLOCATION );
+
+			result = nbd_handle_write_structured_reply(
+			          client,
+			          cookie,
+			          NBD_HANDLE_CHUNK_TYPE_BLOCK_STATUS,
+			          header_data,
+			          4,
+			          nbd_handle->buffer,
+			          data_size,
+			          error );
+
+			return( result );
+
+		default:
+			error_value = NBD_HANDLE_ERROR_EINVAL;
+
+			break;
+	}
+	if( ( error_value != 0 )
+	 && ( client->structured_replies != 0 ) )
+	{
+		/* The error chunk consists of the error value and an empty message
+		 */
+		byte_stream_copy_from_uint32_big_endian(
+		 &( header_data[ 0 ] ),
+		 error_value );
+
+		byte_stream_copy_from_uint16_big_endian(
+		 &( header_data[ 4 ] ),
+		 0 );
+
+		result = nbd_handle_write_structured_reply(
+		          client,
+		          cookie,
+		          NBD_HANDLE_CHUNK_TYPE_ERROR,
+		          header_data,
+		          6,
+		          NULL,
+		          0,
+		          error );
+	}
+	else
+	{
+		result = nbd_handle_write_simple_reply(
+		          client,
+		          cookie,
+		          error_value,
+		          NULL,
+		          0,
+		          error );
+	}
+	return( result );
+}
+
+/* Processes the next message of a client
+ * Returns 1 if successful, 0 if the connection should be closed or -1 on error
+ */
+int nbd_handle_process_client(
+     nbd_handle_t *nbd_handle,
+     nbd_handle_client_t *client,
+     libcerror_error_t **error )
+{
+	uint8_t client_flags_data[ 4 ];
+
+	static char *function = "nbd_handle_process_client";
+	int result            = 0;
+
+	if( client == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid client.",
+		 function );
+
+		return( -1 );
+	}
+	switch( client->state )
+	{
+		case NBD_HANDLE_CLIENT_STATE_CLIENT_FLAGS:
+			result = nbd_handle_read_message(
+			          client->socket_descriptor,
+			          client_flags_data,
+			          4,
+			          error );
+
+			if( result != 1 )
+			{
+				break;
+			}
+			byte_stream_copy_to_uint32_big_endian(
+			 client_flags_data,
+			 client->client_flags );
+
+			if( ( client->client_flags & ~( (uint32_t) ( NBD_HANDLE_FLAG_FIXED_NEWSTYLE | NBD_HANDLE_FLAG_NO_ZEROES ) ) ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+				 "%s: unsupported client flags: 0x%08" PRIx32 ".",
+				 function,
+				 client->client_flags );
+
+				result = -1;
+
+				break;
+			}
+			client->state = NBD_HANDLE_CLIENT_STATE_OPTIONS;
+
+			break;
+
+		case NBD_HANDLE_CLIENT_STATE_OPTIONS:
+			result = nbd_handle_process_option(
+			          nbd_handle,
+			          client,
+			          error );
+			break;
+
+		case NBD_HANDLE_CLIENT_STATE_TRANSMISSION:
+			result = nbd_handle_process_request(
+			          nbd_handle,
+			          client,
+			          error );
+			break;
+
+		default:
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported client state: %d.",
+			 function,
+			 client->state );
+
+			result = -1;
+
+			break;
+	}
+	return( result );
+}
+
+/* Serves the exports until abort is signalled
+ * Every client is processed one message at a time, hence requests that are
+ * pipelined by a client are processed in order and the requests of different
+ * clients and connections are interleaved
+ * Returns 1 if successful or -1 on error
+ */
+int nbd_handle_serve(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error )
+{
+	struct pollfd poll_descriptors[ NBD_HANDLE_MAXIMUM_NUMBER_OF_CLIENTS + 1 ];
+	int client_indexes[ NBD_HANDLE_MAXIMUM_NUMBER_OF_CLIENTS + 1 ];
+
+	nbd_handle_client_t *client    = NULL;
+	static char *function          = "nbd_handle_serve";
+	int client_index               = 0;
+	int number_of_poll_descriptors = 0;
+	int poll_index                 = 0;
+	int result                     = 0;
+
+	if( nbd_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid NBD handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->socket_descriptor == -1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid NBD handle - missing socket.",
+		 function );
+
+		return( -1 );
+	}
+	if( nbd_handle->buffer == NULL )
+	{
+		nbd_handle->buffer = (uint8_t *) memory_allocate(
+		                                  sizeof( uint8_t ) * NBD_HANDLE_MAXIMUM_REQUEST_SIZE );
+
+		if( nbd_handle->buffer == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create buffer.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	while( nbd_handle->abort == 0 )
+	{
+		poll_descriptors[ 0 ].fd      = nbd_handle->socket_descriptor;
+		poll_descriptors[ 0 ].events  = POLLIN;
+		poll_descriptors[ 0 ].revents = 0;
+
+		number_of_poll_descriptors = 1;
+
+		for( client_index = 0;
+		     client_index < NBD_HANDLE_MAXIMUM_NUMBER_OF_CLIENTS;
+		     client_index++ )
+		{
+			if( nbd_handle->clients[ client_index ].state == NBD_HANDLE_CLIENT_STATE_UNUSED )
+			{
+				continue;
+			}
+			poll_descriptors[ number_of_poll_descriptors ].fd      = nbd_handle->clients[ client_index ].socket_descriptor;
+			poll_descriptors[ number_of_poll_descriptors ].events  = POLLIN;
+			poll_descriptors[ number_of_poll_descriptors ].revents = 0;
+
+			client_indexes[ number_of_poll_descriptors ] = client_index;
+
+			number_of_poll_descriptors++;
+		}
+		/* Use a timeout so that an abort signal is noticed
+		 */
+		result = poll(
+		          poll_descriptors,
+		          (nfds_t) number_of_poll_descriptors,
+		          1000 );
+
+		if( result == -1 )
+		{
+			if( errno == EINTR )
+			{
+				continue;
+			}
+			libcerror_system_set_error(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_IO,
+			 LIBCERROR_IO_ERROR_GENERIC,
+			 errno,
+			 "%s: unable to poll sockets.",
+			 function );
+
+			return( -1 );
+		}
+		for( poll_index = 1;
+		     poll_index < number_of_poll_descriptors;
+		     poll_index++ )
+		{
+			if( ( poll_descriptors[ poll_index ].revents & ( POLLIN | POLLHUP | POLLERR | POLLNVAL ) ) == 0 )
+			{
+				continue;
+			}
+			client = &( nbd_handle->clients[ client_indexes[ poll_index ] ] );
+
+			result = nbd_handle_process_client(
+			          nbd_handle,
+			          client,
+			          error );
+
+			if( result == -1 )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+				libcerror_error_free(
+				 error );
+			}
+			if( result != 1 )
+			{
+				nbd_handle_close_client(
+				 client );
+			}
+		}
+		if( ( poll_descriptors[ 0 ].revents & POLLIN ) != 0 )
+		{
+			if( nbd_handle_accept_client(
+			     nbd_handle,
+			     error ) != 1 )
+			{
+				libcnotify_print_error_backtrace(
+				 *error );
+				libcerror_error_free(
+				 error );
+			}
+		}
+	}
+	return( 1 );
+}
+
+#endif /* defined( NBD_HANDLE_HAVE_SOCKET_SUPPORT ) */
+
@@ -0,0 +1,401 @@
+/*
+ * Network Block Device (NBD) handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _NBD_HANDLE_H )
+#define _NBD_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "mount_handle.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The NBD handle requires BSD sockets and narrow system strings
+ */
+#if !defined( WINAPI ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && defined( HAVE_SYS_SOCKET_H ) && defined( HAVE_SYS_UN_H ) && defined( HAVE_NETINET_IN_H ) && defined( HAVE_POLL_H )
+#define NBD_HANDLE_HAVE_SOCKET_SUPPORT	1
+#endif
+
+/* The maximum number of concurrently connected clients
+ */
+#define NBD_HANDLE_MAXIMUM_NUMBER_OF_CLIENTS		64
+
+/* The maximum size of the data of a read request, which is also the maximum block size
+ */
+#define NBD_HANDLE_MAXIMUM_REQUEST_SIZE			( 32 * 1024 * 1024 )
+
+/* The maximum size of the data of an option
+ */
+#define NBD_HANDLE_MAXIMUM_OPTION_DATA_SIZE		( 64 * 1024 )
+
+/* The maximum number of descriptors in a block status reply
+ */
+#define NBD_HANDLE_MAXIMUM_NUMBER_OF_DESCRIPTORS	4096
+
+/* The preferred block size, which is the default grain size
+ */
+#define NBD_HANDLE_PREFERRED_BLOCK_SIZE			( 64 * 1024 )
+
+/* The number of seconds a client can stall while sending a message
+ */
+#define NBD_HANDLE_CLIENT_TIMEOUT			30
+
+/* The NBD protocol magic values
+ */
+#define NBD_HANDLE_MAGIC_INIT_PASSWORD			0x4e42444d41474943ULL
+#define NBD_HANDLE_MAGIC_OPTION				0x49484156454f5054ULL
+#define NBD_HANDLE_MAGIC_OPTION_REPLY			0x0003e889045565a9ULL
+#define NBD_HANDLE_MAGIC_REQUEST			0x25609513UL
+#define NBD_HANDLE_MAGIC_SIMPLE_REPLY			0x67446698UL
+#define NBD_HANDLE_MAGIC_STRUCTURED_REPLY		0x668e33efUL
+
+/* The NBD handshake flags
+ */
+#define NBD_HANDLE_FLAG_FIXED_NEWSTYLE			0x0001
+#define NBD_HANDLE_FLAG_NO_ZEROES			0x0002
+
+/* The NBD transmission flags
+ */
+#define NBD_HANDLE_FLAG_HAS_FLAGS			0x0001
+#define NBD_HANDLE_FLAG_READ_ONLY			0x0002
+#define NBD_HANDLE_FLAG_SEND_FLUSH			0x0004
+#define NBD_HANDLE_FLAG_CAN_MULTI_CONN			0x0100
+
+/* The NBD options
+ */
+#define NBD_HANDLE_OPTION_EXPORT_NAME			1
+#define NBD_HANDLE_OPTION_ABORT				2
+#define NBD_HANDLE_OPTION_LIST				3
+#define NBD_HANDLE_OPTION_INFO				6
+#define NBD_HANDLE_OPTION_GO				7
+#define NBD_HANDLE_OPTION_STRUCTURED_REPLY		8
+#define NBD_HANDLE_OPTION_LIST_META_CONTEXT		9
+#define NBD_HANDLE_OPTION_SET_META_CONTEXT		10
+
+/* The NBD option reply types
+ */
+#define NBD_HANDLE_REPLY_ACK				1
+#define NBD_HANDLE_REPLY_SERVER				2
+#define NBD_HANDLE_REPLY_INFO				3
+#define NBD_HANDLE_REPLY_META_CONTEXT			4
+#define NBD_HANDLE_REPLY_ERROR_UNSUPPORTED		0x80000001UL
+#define NBD_HANDLE_REPLY_ERROR_INVALID			0x80000003UL
+#define NBD_HANDLE_REPLY_ERROR_UNKNOWN			0x80000006UL
+
+/* The NBD information types
+ */
+#define NBD_HANDLE_INFO_EXPORT				0
+#define NBD_HANDLE_INFO_BLOCK_SIZE			3
+
+/* The NBD commands
+ */
+#define NBD_HANDLE_COMMAND_READ				0
+#define NBD_HANDLE_COMMAND_WRITE			1
+#define NBD_HANDLE_COMMAND_DISCONNECT			2
+#define NBD_HANDLE_COMMAND_FLUSH			3
+#define NBD_HANDLE_COMMAND_TRIM				4
+#define NBD_HANDLE_COMMAND_WRITE_ZEROES			6
+#define NBD_HANDLE_COMMAND_BLOCK_STATUS			7
+
+/* The NBD command flags
+ */
+#define NBD_HANDLE_COMMAND_FLAG_REQUEST_ONE		0x0008
+
+/* The NBD structured reply chunk types and flags
+ */
+#define NBD_HANDLE_CHUNK_FLAG_DONE			0x0001
+#define NBD_HANDLE_CHUNK_TYPE_NONE			0
+#define NBD_HANDLE_CHUNK_TYPE_OFFSET_DATA		1
+#define NBD_HANDLE_CHUNK_TYPE_BLOCK_STATUS		5
+#define NBD_HANDLE_CHUNK_TYPE_ERROR			32769
+
+/* The NBD block status flags of the base:allocation meta context
+ */
+#define NBD_HANDLE_STATE_HOLE				0x00000001UL
+#define NBD_HANDLE_STATE_ZERO				0x00000002UL
+
+/* The identifier of the base:allocation meta context
+ */
+#define NBD_HANDLE_META_CONTEXT_BASE_ALLOCATION		1
+
+/* The NBD error values
+ */
+#define NBD_HANDLE_ERROR_EPERM				1
+#define NBD_HANDLE_ERROR_EIO				5
+#define NBD_HANDLE_ERROR_EINVAL				22
+
+enum NBD_HANDLE_CLIENT_STATES
+{
+	NBD_HANDLE_CLIENT_STATE_UNUSED,
+	NBD_HANDLE_CLIENT_STATE_CLIENT_FLAGS,
+	NBD_HANDLE_CLIENT_STATE_OPTIONS,
+	NBD_HANDLE_CLIENT_STATE_TRANSMISSION
+};
+
+typedef struct nbd_handle_export nbd_handle_export_t;
+
+struct nbd_handle_export
+{
+	/* The mount handle
+	 */
+	mount_handle_t *mount_handle;
+
+	/* The index of the input handle that is exported
+	 */
+	int input_handle_index;
+
+	/* The media size
+	 */
+	size64_t media_size;
+
+	/* The export name
+	 */
+	char *name;
+
+	/* The export name size
+	 */
+	size_t name_size;
+};
+
+typedef struct nbd_handle_client nbd_handle_client_t;
+
+struct nbd_handle_client
+{
+	/* The state
+	 */
+	int state;
+
+	/* The socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The client flags
+	 */
+	uint32_t client_flags;
+
+	/* Value to indicate structured replies were negotiated
+	 */
+	uint8_t structured_replies;
+
+	/* Value to indicate the base:allocation meta context was negotiated
+	 */
+	uint8_t base_allocation;
+
+	/* The export
+	 */
+	nbd_handle_export_t *export;
+};
+
+typedef struct nbd_handle nbd_handle_t;
+
+struct nbd_handle
+{
+	/* The exports array
+	 */
+	libcdata_array_t *exports_array;
+
+	/* The cache pool shared by the exports
+	 */
+	libvmdk_cache_pool_t *cache_pool;
+
+	/* The parent registry used to share the parent input handles of the exports
+	 */
+	parent_registry_t *parent_registry;
+
+	/* The TCP port
+	 */
+	uint16_t port;
+
+	/* The Unix domain socket path
+	 */
+	system_character_t *socket_path;
+
+	/* The listening socket descriptor
+	 */
+	int socket_descriptor;
+
+	/* The clients
+	 */
+	nbd_handle_client_t clients[ NBD_HANDLE_MAXIMUM_NUMBER_OF_CLIENTS ];
+
+	/* The option data
+	 */
+	uint8_t option_data[ NBD_HANDLE_MAXIMUM_OPTION_DATA_SIZE ];
+
+	/* The request data buffer
+	 */
+	uint8_t *buffer;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int nbd_handle_export_free(
+     nbd_handle_export_t **export,
+     libcerror_error_t **error );
+
+int nbd_handle_initialize(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_free(
+     nbd_handle_t **nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_signal_abort(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_set_port(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int nbd_handle_set_maximum_cache_size(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int nbd_handle_open_input(
+     nbd_handle_t *nbd_handle,
+     system_character_t *filename,
+     libcerror_error_t **error );
+
+#if defined( NBD_HANDLE_HAVE_SOCKET_SUPPORT )
+
+int nbd_handle_open_socket(
+     nbd_handle_t *nbd_handle,
+     const system_character_t *socket_path,
+     libcerror_error_t **error );
+
+int nbd_handle_close(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+int nbd_handle_read_message(
+     int socket_descriptor,
+     uint8_t *buffer,
+     size_t size,
+     libcerror_error_t **error );
+
+int nbd_handle_write_message(
+     int socket_descriptor,
+     const uint8_t *buffer,
+     size_t size,
+     int more_data,
+     libcerror_error_t **error );
+
+int nbd_handle_accept_client(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+void nbd_handle_close_client(
+      nbd_handle_client_t *client );
+
+int nbd_handle_get_export_by_name(
+     nbd_handle_t *nbd_handle,
+     const uint8_t *name,
+     size_t name_length,
+     nbd_handle_export_t **export,
+     libcerror_error_t **error );
+
+int nbd_handle_write_option_reply(
+     nbd_handle_client_t *client,
+     uint32_t option,
+     uint32_t reply_type,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_handle_process_option(
+     nbd_handle_t *nbd_handle,
+     nbd_handle_client_t *client,
+     libcerror_error_t **error );
+
+int nbd_handle_process_meta_context_option(
+     nbd_handle_t *nbd_handle,
+     nbd_handle_client_t *client,
+     uint32_t option,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_handle_write_simple_reply(
+     nbd_handle_client_t *client,
+     uint64_t cookie,
+     uint32_t error_value,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_handle_write_structured_reply(
+     nbd_handle_client_t *client,
+     uint64_t cookie,
+     uint16_t chunk_type,
+     const uint8_t *header_data,
+     size_t header_data_size,
+     const uint8_t *data,
+     size_t data_size,
+     libcerror_error_t **error );
+
+int nbd_handle_get_block_status(
+     nbd_handle_export_t *export,
+     uint64_t offset,
+     uint32_t length,
+     uint8_t request_one,
+     uint8_t *data,
+     size_t data_size,
+     size_t *descriptors_data_size,
+     libcerror_error_t **error );
+
+int nbd_handle_process_request(
+     nbd_handle_t *nbd_handle,
+     nbd_handle_client_t *client,
+     libcerror_error_t **error );
+
+int nbd_handle_process_client(
+     nbd_handle_t *nbd_handle,
+     nbd_handle_client_t *client,
+     libcerror_error_t **error );
+
+int nbd_handle_serve(
+     nbd_handle_t *nbd_handle,
+     libcerror_error_t **error );
+
+#endif /* defined( NBD_HANDLE_HAVE_SOCKET_SUPPORT ) */
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _NBD_HANDLE_H ) */
+
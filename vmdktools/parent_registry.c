@@ -0,0 +1,777 @@
+/*
+ * Parent registry
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "parent_registry.h"
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+/* Frees a parent registry entry
+ * The parent input handle is closed and freed
+ * Returns 1 if successful or -1 on error
+ */
+int parent_registry_entry_free(
+     parent_registry_entry_t **entry,
+     libcerror_error_t **error )
+{
+	static char *function = "parent_registry_entry_free";
+	int result            = 1;
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid entry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *entry != NULL )
+	{
+		if( ( *entry )->input_handle != NULL )
+		{
+			if( libvmdk_handle_close(
+			     ( *entry )->input_handle,
+			     error ) != 0 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_IO,
+				 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+				 "%s: unable to close input handle.",
+				 function );
+
+				result = -1;
+			}
+			if( libvmdk_handle_free(
+			     &( ( *entry )->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		if( ( *entry )->path != NULL )
+		{
+			memory_free(
+			 ( *entry )->path );
+		}
+		memory_free(
+		 *entry );
+
+		*entry = NULL;
+	}
+	return( result );
+}
+
+/* Creates a parent registry
+ * Make sure the value parent_registry is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int parent_registry_initialize(
+     parent_registry_t **parent_registry,
+     libcerror_error_t **error )
+{
+	static char *function = "parent_registry_initialize";
+
+	if( parent_registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent registry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parent_registry != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid parent registry value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*parent_registry = memory_allocate_structure(
+	                    parent_registry_t );
+
+	if( *parent_registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create parent registry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *parent_registry,
+	     0,
+	     sizeof( parent_registry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear parent registry.",
+		 function );
+
+		memory_free(
+		 *parent_registry );
+
+		*parent_registry = NULL;
+
+		return( -1 );
+	}
+	if( libcdata_array_initialize(
+	     &( ( *parent_registry )->entries_array ),
+	     0,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize entries array.",
+		 function );
+
+		goto on_error;
+	}
+	return( 1 );
+
+on_error:
+	if( *parent_registry != NULL )
+	{
+		memory_free(
+		 *parent_registry );
+
+		*parent_registry = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a parent registry
+ * The parent input handles are closed and freed, hence the registry
+ * must be freed after the handles that refer to them
+ * Returns 1 if successful or -1 on error
+ */
+int parent_registry_free(
+     parent_registry_t **parent_registry,
+     libcerror_error_t **error )
+{
+	static char *function = "parent_registry_free";
+	int result            = 1;
+
+	if( parent_registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent registry.",
+		 function );
+
+		return( -1 );
+	}
+	if( *parent_registry != NULL )
+	{
+		if( libcdata_array_free(
+		     &( ( *parent_registry )->entries_array ),
+		     (int (*)(intptr_t **, libcerror_error_t **)) &parent_registry_entry_free,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+			 "%s: unable to free entries array.",
+			 function );
+
+			result = -1;
+		}
+		memory_free(
+		 *parent_registry );
+
+		*parent_registry = NULL;
+	}
+	return( result );
+}
+
+/* Retrieves the canonical path of a path
+ * The canonical path is an absolute path, on POSIX systems symbolic links
+ * and . and .. path segments are resolved as well. If the path cannot be
+ * resolved, for example since it does not exist, a copy of the path is provided
+ * Returns 1 if successful or -1 on error
+ */
+int parent_registry_get_canonical_path(
+     const system_character_t *path,
+     size_t path_size,
+     system_character_t **canonical_path,
+     size_t *canonical_path_size,
+     libcerror_error_t **error )
+{
+	static char *function             = "parent_registry_get_canonical_path";
+	size_t resolved_path_size         = 0;
+
+#if defined( WINAPI )
+	DWORD full_path_length            = 0;
+
+#elif defined( HAVE_REALPATH ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	system_character_t *resolved_path = NULL;
+#endif
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( path_size == 0 )
+	 || ( path_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * path_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( canonical_path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid canonical path.",
+		 function );
+
+		return( -1 );
+	}
+	if( *canonical_path != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid canonical path value already set.",
+		 function );
+
+		return( -1 );
+	}
+	if( canonical_path_size == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid canonical path size.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( WINAPI )
+	/* The returned length includes the end-of-string character
+	 * if the buffer is too small
+	 */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	full_path_length = GetFullPathNameW(
+	                    path,
+	                    0,
+	                    NULL,
+	                    NULL );
+#else
+	full_path_length = GetFullPathNameA(
+	                    path,
+	                    0,
+	                    NULL,
+	                    NULL );
+#endif
+	if( ( full_path_length > 0 )
+	 && ( (size_t) full_path_length <= ( (size_t) SSIZE_MAX / sizeof( system_character_t ) ) ) )
+	{
+		resolved_path_size = (size_t) full_path_length;
+
+		*canonical_path = system_string_allocate(
+		                   resolved_path_size );
+
+		if( *canonical_path == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create canonical path.",
+			 function );
+
+			goto on_error;
+		}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+		full_path_length = GetFullPathNameW(
+		                    path,
+		                    (DWORD) resolved_path_size,
+		                    *canonical_path,
+		                    NULL );
+#else
+		full_path_length = GetFullPathNameA(
+		                    path,
+		                    (DWORD) resolved_path_size,
+		                    *canonical_path,
+		                    NULL );
+#endif
+		/* On success the returned length does not include
+		 * the end-of-string character
+		 */
+		if( ( full_path_length == 0 )
+		 || ( (size_t) full_path_length >= resolved_path_size ) )
+		{
+			memory_free(
+			 *canonical_path );
+
+			*canonical_path = NULL;
+		}
+		else
+		{
+			resolved_path_size = (size_t) full_path_length + 1;
+		}
+	}
+#elif defined( HAVE_REALPATH ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	resolved_path = realpath(
+	                 path,
+	                 NULL );
+
+	if( resolved_path != NULL )
+	{
+		resolved_path_size = system_string_length(
+		                      resolved_path ) + 1;
+
+		*canonical_path = system_string_allocate(
+		                   resolved_path_size );
+
+		if( *canonical_path == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create canonical path.",
+			 function );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     *canonical_path,
+		     resolved_path,
+		     resolved_path_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy canonical path.",
+			 function );
+
+			goto on_error;
+		}
+		/* The resolved path was allocated by realpath
+		 */
+		free(
+		 resolved_path );
+
+		resolved_path = NULL;
+	}
+#endif
+	if( *canonical_path == NULL )
+	{
+		resolved_path_size = path_size;
+
+		*canonical_path = system_string_allocate(
+		                   resolved_path_size );
+
+		if( *canonical_path == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create canonical path.",
+			 function );
+
+			goto on_error;
+		}
+		if( system_string_copy(
+		     *canonical_path,
+		     path,
+		     resolved_path_size ) == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy canonical path.",
+			 function );
+
+			goto on_error;
+		}
+	}
+	( *canonical_path )[ resolved_path_size - 1 ] = 0;
+
+	*canonical_path_size = resolved_path_size;
+
+	return( 1 );
+
+on_error:
+#if defined( HAVE_REALPATH ) && !defined( HAVE_WIDE_SYSTEM_CHARACTER ) && !defined( WINAPI )
+	if( resolved_path != NULL )
+	{
+		free(
+		 resolved_path );
+	}
+#endif
+	if( *canonical_path != NULL )
+	{
+		memory_free(
+		 *canonical_path );
+
+		*canonical_path = NULL;
+	}
+	return( -1 );
+}
+
+/* Retrieves the parent input handle of a specific path and content identifier
+ * Returns 1 if successful, 0 if no such handle or -1 on error
+ */
+int parent_registry_get_input_handle(
+     parent_registry_t *parent_registry,
+     const system_character_t *path,
+     size_t path_size,
+     uint32_t content_identifier,
+     libvmdk_handle_t **input_handle,
+     libcerror_error_t **error )
+{
+	parent_registry_entry_t *entry     = NULL;
+	system_character_t *canonical_path = NULL;
+	static char *function              = "parent_registry_get_input_handle";
+	size_t canonical_path_size         = 0;
+	int entry_index                    = 0;
+	int number_of_entries              = 0;
+	int result                         = 0;
+
+	if( parent_registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent registry.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( parent_registry_get_canonical_path(
+	     path,
+	     path_size,
+	     &canonical_path,
+	     &canonical_path_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve canonical path.",
+		 function );
+
+		goto on_error;
+	}
+	if( libcdata_array_get_number_of_entries(
+	     parent_registry->entries_array,
+	     &number_of_entries,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of entries.",
+		 function );
+
+		goto on_error;
+	}
+	for( entry_index = 0;
+	     entry_index < number_of_entries;
+	     entry_index++ )
+	{
+		if( libcdata_array_get_entry_by_index(
+		     parent_registry->entries_array,
+		     entry_index,
+		     (intptr_t **) &entry,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( entry == NULL )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: missing entry: %d.",
+			 function,
+			 entry_index );
+
+			goto on_error;
+		}
+		if( ( entry->content_identifier != content_identifier )
+		 || ( entry->path_size != canonical_path_size ) )
+		{
+			continue;
+		}
+		if( system_string_compare(
+		     entry->path,
+		     canonical_path,
+		     canonical_path_size ) == 0 )
+		{
+			*input_handle = entry->input_handle;
+
+			result = 1;
+
+			break;
+		}
+	}
+	memory_free(
+	 canonical_path );
+
+	return( result );
+
+on_error:
+	if( canonical_path != NULL )
+	{
+		memory_free(
+		 canonical_path );
+	}
+	return( -1 );
+}
+
+/* Appends a parent input handle to the registry
+ * The registry takes over the management of the input handle
+ * Returns 1 if successful or -1 on error
+ */
+int parent_registry_append_input_handle(
+     parent_registry_t *parent_registry,
+     const system_character_t *path,
+     size_t path_size,
+     uint32_t content_identifier,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error )
+{
+	parent_registry_entry_t *entry = NULL;
+	static char *function          = "parent_registry_append_input_handle";
+	int entry_index                = 0;
+
+	if( parent_registry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid parent registry.",
+		 function );
+
+		return( -1 );
+	}
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		return( -1 );
+	}
+	if( ( path_size == 0 )
+	 || ( path_size > (size_t) SSIZE_MAX )
+	 || ( ( sizeof( system_character_t ) * path_size ) > (size_t) SSIZE_MAX ) )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid path size value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+	if( input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid input handle.",
+		 function );
+
+		return( -1 );
+	}
+	entry = memory_allocate_structure(
+	         parent_registry_entry_t );
+
+	if( entry == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create entry.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     entry,
+	     0,
+	     sizeof( parent_registry_entry_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear entry.",
+		 function );
+
+		goto on_error;
+	}
+	/* The path is stored in its canonical form so that different paths
+	 * of the same parent, such as relative paths or symbolic links,
+	 * refer to the same entry
+	 */
+	if( parent_registry_get_canonical_path(
+	     path,
+	     path_size,
+	     &( entry->path ),
+	     &( entry->path_size ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve canonical path.",
+		 function );
+
+		goto on_error;
+	}
+	entry->content_identifier = content_identifier;
+
+	if( libcdata_array_append_entry(
+	     parent_registry->entries_array,
+	     &entry_index,
+	     (intptr_t *) entry,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_APPEND_FAILED,
+		 "%s: unable to append entry.",
+		 function );
+
+		goto on_error;
+	}
+	/* The input handle is only set after the entry was appended
+	 * so that the caller remains responsible for it on error
+	 */
+	entry->input_handle = input_handle;
+
+	return( 1 );
+
+on_error:
+	if( entry != NULL )
+	{
+		parent_registry_entry_free(
+		 &entry,
+		 NULL );
+	}
+	return( -1 );
+}
+
@@ -0,0 +1,106 @@
+/*
+ * Parent registry
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#if !defined( _PARENT_REGISTRY_H )
+#define _PARENT_REGISTRY_H
+
+#include <common.h>
+#include <types.h>
+
+#include "vmdktools_libcdata.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+typedef struct parent_registry_entry parent_registry_entry_t;
+
+struct parent_registry_entry
+{
+	/* The path
+	 */
+	system_character_t *path;
+
+	/* The path size
+	 */
+	size_t path_size;
+
+	/* The content identifier expected by the children
+	 */
+	uint32_t content_identifier;
+
+	/* The parent input handle
+	 */
+	libvmdk_handle_t *input_handle;
+};
+
+typedef struct parent_registry parent_registry_t;
+
+struct parent_registry
+{
+	/* The entries array
+	 */
+	libcdata_array_t *entries_array;
+};
+
+int parent_registry_entry_free(
+     parent_registry_entry_t **entry,
+     libcerror_error_t **error );
+
+int parent_registry_initialize(
+     parent_registry_t **parent_registry,
+     libcerror_error_t **error );
+
+int parent_registry_free(
+     parent_registry_t **parent_registry,
+     libcerror_error_t **error );
+
+int parent_registry_get_canonical_path(
+     const system_character_t *path,
+     size_t path_size,
+     system_character_t **canonical_path,
+     size_t *canonical_path_size,
+     libcerror_error_t **error );
+
+int parent_registry_get_input_handle(
+     parent_registry_t *parent_registry,
+     const system_character_t *path,
+     size_t path_size,
+     uint32_t content_identifier,
+     libvmdk_handle_t **input_handle,
+     libcerror_error_t **error );
+
+int parent_registry_append_input_handle(
+     parent_registry_t *parent_registry,
+     const system_character_t *path,
+     size_t path_size,
+     uint32_t content_identifier,
+     libvmdk_handle_t *input_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _PARENT_REGISTRY_H ) */
+
@@ -0,0 +1,737 @@
+/*
+ * Verification handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#include "verify_handle.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libfvalue.h"
+#include "vmdktools_libvmdk.h"
+
+#define VERIFY_HANDLE_NOTIFY_STREAM		stdout
+
+/* Creates a verification handle
+ * Make sure the value verify_handle is referencing, is set to NULL
+ * Returns 1 if successful or -1 on error
+ */
+int verify_handle_initialize(
+     verify_handle_t **verify_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_handle_initialize";
+
+	if( verify_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *verify_handle != NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_ALREADY_SET,
+		 "%s: invalid verification handle value already set.",
+		 function );
+
+		return( -1 );
+	}
+	*verify_handle = memory_allocate_structure(
+	                  verify_handle_t );
+
+	if( *verify_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+		 "%s: unable to create verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( memory_set(
+	     *verify_handle,
+	     0,
+	     sizeof( verify_handle_t ) ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear verification handle.",
+		 function );
+
+		goto on_error;
+	}
+	if( libvmdk_handle_initialize(
+	     &( ( *verify_handle )->input_handle ),
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_INITIALIZE_FAILED,
+		 "%s: unable to initialize input handle.",
+		 function );
+
+		goto on_error;
+	}
+	( *verify_handle )->number_of_threads = VERIFY_HANDLE_DEFAULT_NUMBER_OF_THREADS;
+	( *verify_handle )->notify_stream     = VERIFY_HANDLE_NOTIFY_STREAM;
+
+	return( 1 );
+
+on_error:
+	if( *verify_handle != NULL )
+	{
+		memory_free(
+		 *verify_handle );
+
+		*verify_handle = NULL;
+	}
+	return( -1 );
+}
+
+/* Frees a verification handle
+ * Returns 1 if successful or -1 on error
+ */
+int verify_handle_free(
+     verify_handle_t **verify_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_handle_free";
+	int result            = 1;
+
+	if( verify_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( *verify_handle != NULL )
+	{
+		if( ( *verify_handle )->input_handle != NULL )
+		{
+			if( libvmdk_handle_free(
+			     &( ( *verify_handle )->input_handle ),
+			     error ) != 1 )
+			{
+				libcerror_error_set(
+				 error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_FINALIZE_FAILED,
+				 "%s: unable to free input handle.",
+				 function );
+
+				result = -1;
+			}
+		}
+		memory_free(
+		 *verify_handle );
+
+		*verify_handle = NULL;
+	}
+	return( result );
+}
+
+/* Signals the verification handle to abort
+ * Returns 1 if successful or -1 on error
+ */
+int verify_handle_signal_abort(
+     verify_handle_t *verify_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_handle_signal_abort";
+
+	if( verify_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verify_handle->input_handle != NULL )
+	{
+		if( libvmdk_handle_signal_abort(
+		     verify_handle->input_handle,
+		     error ) != 1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to signal input handle to abort.",
+			 function );
+
+			return( -1 );
+		}
+	}
+	verify_handle->abort = 1;
+
+	return( 1 );
+}
+
+/* Sets the number of threads used to decompress the compressed grains
+ * Returns 1 if successful, 0 if unsupported value or -1 on error
+ */
+int verify_handle_set_number_of_threads(
+     verify_handle_t *verify_handle,
+     const system_character_t *string,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_handle_set_number_of_threads";
+	size_t string_length  = 0;
+	uint64_t value_64bit  = 0;
+	int result            = 0;
+
+	if( verify_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( string == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid string.",
+		 function );
+
+		return( -1 );
+	}
+	string_length = system_string_length(
+	                 string );
+
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	result = libfvalue_utf16_string_copy_to_integer(
+	          (uint16_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#else
+	result = libfvalue_utf8_string_copy_to_integer(
+	          (uint8_t *) string,
+	          string_length + 1,
+	          &value_64bit,
+	          64,
+	          LIBFVALUE_INTEGER_FORMAT_TYPE_DECIMAL_UNSIGNED,
+	          error );
+#endif
+	if( result != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_COPY_FAILED,
+		 "%s: unable to copy string to integer.",
+		 function );
+
+		return( -1 );
+	}
+	if( value_64bit > (uint64_t) VERIFY_HANDLE_MAXIMUM_NUMBER_OF_THREADS )
+	{
+		return( 0 );
+	}
+#if !defined( LIBVMDK_HAVE_MULTI_THREAD_SUPPORT )
+	if( value_64bit > 0 )
+	{
+		return( 0 );
+	}
+#endif
+	verify_handle->number_of_threads = (int) value_64bit;
+
+	return( 1 );
+}
+
+/* Opens the input of the verification handle including its extent data files
+ * Returns 1 if successful or -1 on error
+ */
+int verify_handle_open_input(
+     verify_handle_t *verify_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_handle_open_input";
+
+	if( verify_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( filenames == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid filenames.",
+		 function );
+
+		return( -1 );
+	}
+	if( number_of_filenames <= 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: number of filenames value out of bounds.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+	if( libvmdk_handle_open_wide(
+	     verify_handle->input_handle,
+	     filenames[ 0 ],
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#else
+	if( libvmdk_handle_open(
+	     verify_handle->input_handle,
+	     filenames[ 0 ],
+	     LIBVMDK_OPEN_READ,
+	     error ) != 1 )
+#endif
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_open_extent_data_files(
+	     verify_handle->input_handle,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_OPEN_FAILED,
+		 "%s: unable to open extent data files.",
+		 function );
+
+		return( -1 );
+	}
+	return( 1 );
+}
+
+/* Closes the verification handle
+ * Returns the 0 if succesful or -1 on error
+ */
+int verify_handle_close(
+     verify_handle_t *verify_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_handle_close";
+
+	if( verify_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( verify_handle->input_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+		 "%s: invalid verification handle - missing input handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_close(
+	     verify_handle->input_handle,
+	     error ) != 0 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_CLOSE_FAILED,
+		 "%s: unable to close input handle.",
+		 function );
+
+		return( -1 );
+	}
+	return( 0 );
+}
+
+/* Prints the verification values of an extent or of all extents
+ */
+void verify_handle_values_fprint(
+      verify_handle_t *verify_handle,
+      const uint64_t *values )
+{
+	if( ( verify_handle == NULL )
+	 || ( values == NULL ) )
+	{
+		return;
+	}
+	fprintf(
+	 verify_handle->notify_stream,
+	 "\tGrain directory mismatches:\t%" PRIu64 "\n",
+	 values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_GRAIN_DIRECTORY_MISMATCHES ] );
+
+	fprintf(
+	 verify_handle->notify_stream,
+	 "\tGrain table mismatches:\t\t%" PRIu64 "\n",
+	 values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_GRAIN_TABLE_MISMATCHES ] );
+
+	fprintf(
+	 verify_handle->notify_stream,
+	 "\tGrain tables out of bounds:\t%" PRIu64 "\n",
+	 values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_GRAIN_TABLES_OUT_OF_BOUNDS ] );
+
+	fprintf(
+	 verify_handle->notify_stream,
+	 "\tGrains out of bounds:\t\t%" PRIu64 "\n",
+	 values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_GRAINS_OUT_OF_BOUNDS ] );
+
+	fprintf(
+	 verify_handle->notify_stream,
+	 "\tOverlapping grains:\t\t%" PRIu64 "\n",
+	 values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_OVERLAPPING_GRAINS ] );
+
+	if( ( verify_handle->verification_flags & LIBVMDK_VERIFICATION_FLAG_DECOMPRESS_GRAINS ) != 0 )
+	{
+		fprintf(
+		 verify_handle->notify_stream,
+		 "\tDecompressed grains:\t\t%" PRIu64 "\n",
+		 values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_DECOMPRESSED_GRAINS ] );
+
+		fprintf(
+		 verify_handle->notify_stream,
+		 "\tCorrupted grains:\t\t%" PRIu64 "\n",
+		 values[ LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_CORRUPTED_GRAINS ] );
+	}
+}
+
+/* Verifies the extents and prints the verification values
+ * The number of issues found is added to the verification handle
+ * Returns 1 if successful or -1 on error
+ */
+int verify_handle_verify_extents(
+     verify_handle_t *verify_handle,
+     libcerror_error_t **error )
+{
+	uint64_t total_values[ LIBVMDK_NUMBER_OF_VERIFICATION_VALUES ];
+	uint64_t values[ LIBVMDK_NUMBER_OF_VERIFICATION_VALUES ];
+
+	static char *function        = "verify_handle_verify_extents";
+	int extent_index             = 0;
+	int number_of_extents        = 0;
+	int number_of_sparse_extents = 0;
+	int result                   = 0;
+	int value_index              = 0;
+
+	if( verify_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_number_of_extents(
+	     verify_handle->input_handle,
+	     &number_of_extents,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve number of extents.",
+		 function );
+
+		return( -1 );
+	}
+	if( memory_set(
+	     total_values,
+	     0,
+	     sizeof( uint64_t ) * LIBVMDK_NUMBER_OF_VERIFICATION_VALUES ) == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_MEMORY,
+		 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+		 "%s: unable to clear total values.",
+		 function );
+
+		return( -1 );
+	}
+	fprintf(
+	 verify_handle->notify_stream,
+	 "Verification results:\n" );
+
+	for( extent_index = 0;
+	     extent_index < number_of_extents;
+	     extent_index++ )
+	{
+		if( verify_handle->abort != 0 )
+		{
+			return( -1 );
+		}
+		result = libvmdk_handle_verify_extent(
+		          verify_handle->input_handle,
+		          extent_index,
+		          verify_handle->verification_flags,
+		          verify_handle->number_of_threads,
+		          values,
+		          LIBVMDK_NUMBER_OF_VERIFICATION_VALUES,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GENERIC,
+			 "%s: unable to verify extent: %d.",
+			 function,
+			 extent_index );
+
+			return( -1 );
+		}
+		else if( result == 0 )
+		{
+			continue;
+		}
+		fprintf(
+		 verify_handle->notify_stream,
+		 "Extent: %d\n",
+		 extent_index + 1 );
+
+		verify_handle_values_fprint(
+		 verify_handle,
+		 values );
+
+		fprintf(
+		 verify_handle->notify_stream,
+		 "\n" );
+
+		for( value_index = 0;
+		     value_index < LIBVMDK_NUMBER_OF_VERIFICATION_VALUES;
+		     value_index++ )
+		{
+			total_values[ value_index ] += values[ value_index ];
+		}
+		number_of_sparse_extents++;
+	}
+	if( number_of_sparse_extents == 0 )
+	{
+		fprintf(
+		 verify_handle->notify_stream,
+		 "\tNot available for extents without grain tables.\n\n" );
+	}
+	else if( number_of_sparse_extents > 1 )
+	{
+		fprintf(
+		 verify_handle->notify_stream,
+		 "Total:\n" );
+
+		verify_handle_values_fprint(
+		 verify_handle,
+		 total_values );
+
+		fprintf(
+		 verify_handle->notify_stream,
+		 "\n" );
+	}
+	/* The number of decompressed grains is the only value that does not indicate an issue
+	 */
+	for( value_index = 0;
+	     value_index < LIBVMDK_NUMBER_OF_VERIFICATION_VALUES;
+	     value_index++ )
+	{
+		if( value_index != LIBVMDK_VERIFICATION_VALUE_NUMBER_OF_DECOMPRESSED_GRAINS )
+		{
+			verify_handle->number_of_issues += total_values[ value_index ];
+		}
+	}
+	return( 1 );
+}
+
+/* Prints the tainted and corrupted ranges of the media data
+ * This only reads the grain directories and grain tables and should be called after verify_handle_verify_extents
+ * Returns 1 if successful or -1 on error
+ */
+int verify_handle_ranges_fprint(
+     verify_handle_t *verify_handle,
+     libcerror_error_t **error )
+{
+	static char *function = "verify_handle_ranges_fprint";
+	size64_t media_size   = 0;
+	size64_t range_size   = 0;
+	off64_t offset        = 0;
+	uint32_t range_flags  = 0;
+	int number_of_ranges  = 0;
+	int result            = 0;
+
+	if( verify_handle == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid verification handle.",
+		 function );
+
+		return( -1 );
+	}
+	if( libvmdk_handle_get_media_size(
+	     verify_handle->input_handle,
+	     &media_size,
+	     error ) != 1 )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to retrieve media size.",
+		 function );
+
+		return( -1 );
+	}
+	while( (size64_t) offset < media_size )
+	{
+		if( verify_handle->abort != 0 )
+		{
+			return( -1 );
+		}
+		result = libvmdk_handle_get_data_range_at_offset(
+		          verify_handle->input_handle,
+		          offset,
+		          &range_size,
+		          &range_flags,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve data range at offset: %" PRIi64 ".",
+			 function,
+			 offset );
+
+			return( -1 );
+		}
+		else if( ( result == 0 )
+		      || ( range_size == 0 ) )
+		{
+			break;
+		}
+		if( ( range_flags & ( LIBVMDK_RANGE_FLAG_IS_TAINTED | LIBVMDK_RANGE_FLAG_IS_CORRUPTED ) ) != 0 )
+		{
+			if( number_of_ranges == 0 )
+			{
+				fprintf(
+				 verify_handle->notify_stream,
+				 "Affected ranges:\n" );
+			}
+			fprintf(
+			 verify_handle->notify_stream,
+			 "\tat offset: %" PRIi64 " (0x%08" PRIx64 ") of size: %" PRIu64 " bytes:",
+			 offset,
+			 offset,
+			 range_size );
+
+			if( ( range_flags & LIBVMDK_RANGE_FLAG_IS_CORRUPTED ) != 0 )
+			{
+				fprintf(
+				 verify_handle->notify_stream,
+				 " corrupted" );
+			}
+			if( ( range_flags & LIBVMDK_RANGE_FLAG_IS_TAINTED ) != 0 )
+			{
+				fprintf(
+				 verify_handle->notify_stream,
+				 " tainted" );
+			}
+			fprintf(
+			 verify_handle->notify_stream,
+			 "\n" );
+
+			number_of_ranges++;
+		}
+		offset += (off64_t) range_size;
+	}
+	if( number_of_ranges > 0 )
+	{
+		fprintf(
+		 verify_handle->notify_stream,
+		 "\n" );
+	}
+	return( 1 );
+}
+
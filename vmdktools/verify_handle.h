@@ -0,0 +1,122 @@
+/*
+ * Verification handle
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#if !defined( _VERIFY_HANDLE_H )
+#define _VERIFY_HANDLE_H
+
+#include <common.h>
+#include <file_stream.h>
+#include <types.h>
+
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libvmdk.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/* The default number of threads used to decompress the compressed grains
+ */
+#if defined( LIBVMDK_HAVE_MULTI_THREAD_SUPPORT )
+#define VERIFY_HANDLE_DEFAULT_NUMBER_OF_THREADS		4
+#else
+#define VERIFY_HANDLE_DEFAULT_NUMBER_OF_THREADS		0
+#endif
+
+/* The maximum number of threads supported by the library
+ */
+#define VERIFY_HANDLE_MAXIMUM_NUMBER_OF_THREADS		64
+
+typedef struct verify_handle verify_handle_t;
+
+struct verify_handle
+{
+	/* The libvmdk input handle
+	 */
+	libvmdk_handle_t *input_handle;
+
+	/* The verification flags
+	 */
+	uint8_t verification_flags;
+
+	/* The number of threads used to decompress the compressed grains
+	 */
+	int number_of_threads;
+
+	/* The number of issues found
+	 */
+	uint64_t number_of_issues;
+
+	/* The notification output stream
+	 */
+	FILE *notify_stream;
+
+	/* Value to indicate if abort was signalled
+	 */
+	int abort;
+};
+
+int verify_handle_initialize(
+     verify_handle_t **verify_handle,
+     libcerror_error_t **error );
+
+int verify_handle_free(
+     verify_handle_t **verify_handle,
+     libcerror_error_t **error );
+
+int verify_handle_signal_abort(
+     verify_handle_t *verify_handle,
+     libcerror_error_t **error );
+
+int verify_handle_set_number_of_threads(
+     verify_handle_t *verify_handle,
+     const system_character_t *string,
+     libcerror_error_t **error );
+
+int verify_handle_open_input(
+     verify_handle_t *verify_handle,
+     system_character_t * const * filenames,
+     int number_of_filenames,
+     libcerror_error_t **error );
+
+int verify_handle_close(
+     verify_handle_t *verify_handle,
+     libcerror_error_t **error );
+
+void verify_handle_values_fprint(
+      verify_handle_t *verify_handle,
+      const uint64_t *values );
+
+int verify_handle_verify_extents(
+     verify_handle_t *verify_handle,
+     libcerror_error_t **error );
+
+int verify_handle_ranges_fprint(
+     verify_handle_t *verify_handle,
+     libcerror_error_t **error );
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* !defined( _VERIFY_HANDLE_H ) */
+
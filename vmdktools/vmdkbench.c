@@ -0,0 +1,546 @@
+/*
+ * Benchmarks reading the media data of a VMware Virtual Disk (VMDK) file
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "bench_handle.h"
+#include "vmdktools_getopt.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libclocale.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libvmdk.h"
+#include "vmdktools_output.h"
+#include "vmdktools_signal.h"
+#include "vmdktools_unused.h"
+
+bench_handle_t *vmdkbench_bench_handle = NULL;
+int vmdkbench_abort                  = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vmdkbench to measure the read throughput and latency of the media data\n"
+	                 "of a VMware Virtual Disk (VMDK) image file.\n\n" );
+
+	fprintf( stream, "Usage: vmdkbench [ -b block_size ] [ -c cache_size ] [ -m mode ]\n"
+	                 "                 [ -n number_of_reads ] [ -s seed ] [ -t threads ]\n"
+	                 "                 [ -hvV ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file\n\n" );
+
+	fprintf( stream, "\t-b:     specify the block size, must be a multiple of 512 and\n"
+	                 "\t        not exceed %d MiB, default is %d KiB\n",
+	         BENCH_HANDLE_MAXIMUM_BLOCK_SIZE / ( 1024 * 1024 ),
+	         BENCH_HANDLE_DEFAULT_BLOCK_SIZE / 1024 );
+	fprintf( stream, "\t-c:     specify the maximum size of the grain data cache in MiB,\n"
+	                 "\t        the cache is shared by the image file and its parents\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-m:     specify the access mode, options: all (default),\n"
+	                 "\t        random, sequential\n" );
+	fprintf( stream, "\t-n:     specify the number of reads per pass, default is %d\n",
+	         BENCH_HANDLE_DEFAULT_NUMBER_OF_READS );
+	fprintf( stream, "\t-s:     specify the seed of the random offsets, default is %d\n",
+	         BENCH_HANDLE_DEFAULT_SEED );
+	fprintf( stream, "\t-t:     specify the number of threads reading concurrently,\n"
+	                 "\t        default is %d\n",
+	         BENCH_HANDLE_DEFAULT_NUMBER_OF_THREADS );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for vmdkbench
+ */
+void vmdkbench_signal_handler(
+      vmdktools_signal_t signal VMDKTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "vmdkbench_signal_handler";
+
+	VMDKTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vmdkbench_abort = 1;
+
+	if( vmdkbench_bench_handle != NULL )
+	{
+		if( bench_handle_signal_abort(
+		     vmdkbench_bench_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal bench handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libvmdk_error_t *error                        = NULL;
+	system_character_t *option_access_mode        = NULL;
+	system_character_t *option_block_size         = NULL;
+	system_character_t *option_maximum_cache_size = NULL;
+	system_character_t *option_number_of_reads    = NULL;
+	system_character_t *option_number_of_threads  = NULL;
+	system_character_t *option_seed               = NULL;
+	system_character_t *source                    = NULL;
+	char *program                                 = "vmdkbench";
+	system_integer_t option                       = 0;
+	int result                                    = 0;
+	int verbose                                   = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "vmdktools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+        if( vmdktools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vmdkoutput_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vmdktools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:c:hm:n:s:t:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_block_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'c':
+				option_maximum_cache_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'm':
+				option_access_mode = optarg;
+
+				break;
+
+			case (system_integer_t) 'n':
+				option_number_of_reads = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_seed = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vmdkoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvmdk_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvmdk_notify_set_verbose(
+	 verbose );
+
+	if( bench_handle_initialize(
+	     &vmdkbench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize bench handle.\n" );
+
+		goto on_error;
+	}
+	if( option_access_mode != NULL )
+	{
+		result = bench_handle_set_access_patterns(
+		          vmdkbench_bench_handle,
+		          option_access_mode,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set access mode.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported access mode.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_block_size != NULL )
+	{
+		result = bench_handle_set_block_size(
+		          vmdkbench_bench_handle,
+		          option_block_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set block size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported block size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_maximum_cache_size != NULL )
+	{
+		result = bench_handle_set_maximum_cache_size(
+		          vmdkbench_bench_handle,
+		          option_maximum_cache_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum cache size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum cache size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_reads != NULL )
+	{
+		result = bench_handle_set_number_of_reads(
+		          vmdkbench_bench_handle,
+		          option_number_of_reads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of reads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of reads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		result = bench_handle_set_number_of_threads(
+		          vmdkbench_bench_handle,
+		          option_number_of_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_seed != NULL )
+	{
+		if( bench_handle_set_seed(
+		     vmdkbench_bench_handle,
+		     option_seed,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set seed.\n" );
+
+			goto on_error;
+		}
+	}
+	if( bench_handle_set_filename(
+	     vmdkbench_bench_handle,
+	     source,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set source filename.\n" );
+
+		goto on_error;
+	}
+	result = bench_handle_open_input(
+	          vmdkbench_bench_handle,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source file.\n" );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported disk type.\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_signal_attach(
+	     vmdkbench_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = bench_handle_run(
+	          vmdkbench_bench_handle,
+	          &error );
+
+	if( vmdktools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( result == -1 )
+	 && ( vmdkbench_abort == 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to run benchmark.\n" );
+
+		goto on_error;
+	}
+	if( bench_handle_close(
+	     vmdkbench_bench_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close bench handle.\n" );
+
+		goto on_error;
+	}
+	if( vmdkbench_abort != 0 )
+	{
+		if( error != NULL )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		bench_handle_free(
+		 &vmdkbench_bench_handle,
+		 NULL );
+
+		fprintf(
+		 stdout,
+		 "Bench: ABORTED\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( bench_handle_free(
+	     &vmdkbench_bench_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free bench handle.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Bench: SUCCESS\n" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vmdkbench_bench_handle != NULL )
+	{
+		bench_handle_close(
+		 vmdkbench_bench_handle,
+		 NULL );
+		bench_handle_free(
+		 &vmdkbench_bench_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,462 @@
+/*
+ * Converts between VMware Virtual Disk (VMDK) layouts and raw images
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "convert_handle.h"
+#include "vmdktools_getopt.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libclocale.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libvmdk.h"
+#include "vmdktools_output.h"
+#include "vmdktools_signal.h"
+#include "vmdktools_unused.h"
+
+convert_handle_t *vmdkconvert_convert_handle = NULL;
+int vmdkconvert_abort                    = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vmdkconvert to convert a VMware Virtual Disk (VMDK) image, including\n"
+	                 "its parents, or a raw image into another VMDK layout or a raw image.\n\n" );
+
+	fprintf( stream, "Usage: vmdkconvert [ -f format ] [ -i format ] [ -t threads ]\n"
+	                 "                   [ -hvV ] source destination\n\n" );
+
+	fprintf( stream, "\tsource:      the source file\n" );
+	fprintf( stream, "\tdestination: the destination file, for the flat and split formats\n"
+	                 "\t             the destination is the descriptor file\n\n" );
+
+	fprintf( stream, "\t-f:          specify the output format, options: flat, raw,\n"
+	                 "\t             sparse (default), split, stream\n" );
+	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-i:          specify the input format, options: auto (default),\n"
+	                 "\t             raw, vmdk\n" );
+	fprintf( stream, "\t-t:          specify the number of threads used to compress\n"
+	                 "\t             the stream format, default is 4\n" );
+	fprintf( stream, "\t-v:          verbose output to stderr\n" );
+	fprintf( stream, "\t-V:          print version\n" );
+}
+
+/* Signal handler for vmdkconvert
+ */
+void vmdkconvert_signal_handler(
+      vmdktools_signal_t signal VMDKTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "vmdkconvert_signal_handler";
+
+	VMDKTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vmdkconvert_abort = 1;
+
+	if( vmdkconvert_convert_handle != NULL )
+	{
+		if( convert_handle_signal_abort(
+		     vmdkconvert_convert_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal convert handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libvmdk_error_t *error                       = NULL;
+	system_character_t *destination              = NULL;
+	system_character_t *option_input_format      = NULL;
+	system_character_t *option_number_of_threads = NULL;
+	system_character_t *option_output_format     = NULL;
+	system_character_t *source                   = NULL;
+	char *program                                = "vmdkconvert";
+	system_integer_t option                      = 0;
+	int result                                   = 0;
+	int verbose                                  = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "vmdktools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+        if( vmdktools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vmdkoutput_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vmdktools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "f:hi:t:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'f':
+				option_output_format = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'i':
+				option_input_format = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vmdkoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing destination file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	destination = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvmdk_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvmdk_notify_set_verbose(
+	 verbose );
+
+	if( convert_handle_initialize(
+	     &vmdkconvert_convert_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize convert handle.\n" );
+
+		goto on_error;
+	}
+	if( option_input_format != NULL )
+	{
+		result = convert_handle_set_input_format(
+		          vmdkconvert_convert_handle,
+		          option_input_format,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set input format.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported input format.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_output_format != NULL )
+	{
+		result = convert_handle_set_output_format(
+		          vmdkconvert_convert_handle,
+		          option_output_format,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set output format.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported output format.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		result = convert_handle_set_number_of_threads(
+		          vmdkconvert_convert_handle,
+		          option_number_of_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	result = convert_handle_open_input(
+	          vmdkconvert_convert_handle,
+	          source,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source file.\n" );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported disk type.\n" );
+
+		goto on_error;
+	}
+	if( convert_handle_open_output(
+	     vmdkconvert_convert_handle,
+	     destination,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create destination file.\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_signal_attach(
+	     vmdkconvert_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = convert_handle_convert(
+	          vmdkconvert_convert_handle,
+	          &error );
+
+	if( vmdktools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to convert image.\n" );
+
+		goto on_error;
+	}
+	if( convert_handle_close(
+	     vmdkconvert_convert_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close convert handle.\n" );
+
+		goto on_error;
+	}
+	if( convert_handle_free(
+	     &vmdkconvert_convert_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free convert handle.\n" );
+
+		goto on_error;
+	}
+	if( vmdkconvert_abort != 0 )
+	{
+		fprintf(
+		 stdout,
+		 "Convert: ABORTED\n" );
+
+		return( EXIT_FAILURE );
+	}
+	fprintf(
+	 stdout,
+	 "Convert: SUCCESS\n" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vmdkconvert_convert_handle != NULL )
+	{
+		convert_handle_close(
+		 vmdkconvert_convert_handle,
+		 NULL );
+		convert_handle_free(
+		 &vmdkconvert_convert_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
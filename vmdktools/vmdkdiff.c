@@ -0,0 +1,366 @@
+/*
+ * Shows the differences between two VMware Virtual Disk (VMDK) files
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "diff_handle.h"
+#include "vmdktools_getopt.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libclocale.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libvmdk.h"
+#include "vmdktools_output.h"
+#include "vmdktools_signal.h"
+#include "vmdktools_unused.h"
+
+diff_handle_t *vmdkdiff_diff_handle = NULL;
+int vmdkdiff_abort                  = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vmdkdiff to list the ranges of the media data that differ between\n"
+	                 "two VMware Virtual Disk (VMDK) image files, such as a delta disk and its\n"
+	                 "parent.\n\n" );
+
+	fprintf( stream, "Usage: vmdkdiff [ -hvV ] source other_source\n\n" );
+
+	fprintf( stream, "\tsource:       the source file\n" );
+	fprintf( stream, "\tother_source: the other source file\n\n" );
+
+	fprintf( stream, "\t-h:           shows this help\n" );
+	fprintf( stream, "\t-v:           verbose output to stderr\n" );
+	fprintf( stream, "\t-V:           print version\n" );
+}
+
+/* Signal handler for vmdkdiff
+ */
+void vmdkdiff_signal_handler(
+      vmdktools_signal_t signal VMDKTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "vmdkdiff_signal_handler";
+
+	VMDKTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vmdkdiff_abort = 1;
+
+	if( vmdkdiff_diff_handle != NULL )
+	{
+		if( diff_handle_signal_abort(
+		     vmdkdiff_diff_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal diff handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libvmdk_error_t *error           = NULL;
+	system_character_t *other_source = NULL;
+	system_character_t *source       = NULL;
+	char *program                    = "vmdkdiff";
+	system_integer_t option          = 0;
+	int result                       = 0;
+	int verbose                      = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "vmdktools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+        if( vmdktools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vmdkoutput_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vmdktools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hvV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vmdkoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing other source file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	other_source = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvmdk_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvmdk_notify_set_verbose(
+	 verbose );
+
+	if( diff_handle_initialize(
+	     &vmdkdiff_diff_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize diff handle.\n" );
+
+		goto on_error;
+	}
+	result = diff_handle_open_inputs(
+	          vmdkdiff_diff_handle,
+	          source,
+	          other_source,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source files.\n" );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported disk type.\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_signal_attach(
+	     vmdkdiff_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = diff_handle_changed_ranges_fprint(
+	          vmdkdiff_diff_handle,
+	          &error );
+
+	if( vmdktools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( result == -1 )
+	 && ( vmdkdiff_abort == 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to determine changed ranges.\n" );
+
+		goto on_error;
+	}
+	if( diff_handle_close(
+	     vmdkdiff_diff_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close diff handle.\n" );
+
+		goto on_error;
+	}
+	if( vmdkdiff_abort != 0 )
+	{
+		if( error != NULL )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		diff_handle_free(
+		 &vmdkdiff_diff_handle,
+		 NULL );
+
+		fprintf(
+		 stdout,
+		 "Diff: ABORTED\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( diff_handle_free(
+	     &vmdkdiff_diff_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free diff handle.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Diff: SUCCESS\n" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vmdkdiff_diff_handle != NULL )
+	{
+		diff_handle_close(
+		 vmdkdiff_diff_handle,
+		 NULL );
+		diff_handle_free(
+		 &vmdkdiff_diff_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,375 @@
+/*
+ * Exports a VMware Virtual Disk (VMDK) image to a raw image or stdout
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "export_handle.h"
+#include "vmdktools_getopt.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libclocale.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libvmdk.h"
+#include "vmdktools_output.h"
+#include "vmdktools_signal.h"
+#include "vmdktools_unused.h"
+
+export_handle_t *vmdkexport_export_handle = NULL;
+int vmdkexport_abort                  = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vmdkexport to export the data of a VMware Virtual Disk (VMDK)\n"
+	                 "image, including its parents, to a raw image or stdout.\n\n" );
+
+	fprintf( stream, "Usage: vmdkexport [ -hnvV ] source destination\n\n" );
+
+	fprintf( stream, "\tsource:      the source file\n" );
+	fprintf( stream, "\tdestination: the destination file or - for stdout\n\n" );
+
+	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-n:          do not use kernel copy offload for flat extents\n" );
+	fprintf( stream, "\t-v:          verbose output to stderr\n" );
+	fprintf( stream, "\t-V:          print version\n" );
+}
+
+/* Signal handler for vmdkexport
+ */
+void vmdkexport_signal_handler(
+      vmdktools_signal_t signal VMDKTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "vmdkexport_signal_handler";
+
+	VMDKTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vmdkexport_abort = 1;
+
+	if( vmdkexport_export_handle != NULL )
+	{
+		if( export_handle_signal_abort(
+		     vmdkexport_export_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal export handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libvmdk_error_t *error          = NULL;
+	system_character_t *destination = NULL;
+	system_character_t *source      = NULL;
+	char *program                   = "vmdkexport";
+	system_integer_t option         = 0;
+	int result                      = 0;
+	int use_copy_offload            = 1;
+	int verbose                     = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "vmdktools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+        if( vmdktools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	/* The destination can be stdout so the other output is written to stderr
+	 */
+	vmdkoutput_version_fprint(
+	 stderr,
+	 program );
+
+	while( ( option = vmdktools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "hnvV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stderr );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stderr );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'n':
+				use_copy_offload = 0;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vmdkoutput_copyright_fprint(
+				 stderr );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file.\n" );
+
+		usage_fprint(
+		 stderr );
+
+		return( EXIT_FAILURE );
+	}
+	source = argv[ optind++ ];
+
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing destination file.\n" );
+
+		usage_fprint(
+		 stderr );
+
+		return( EXIT_FAILURE );
+	}
+	destination = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvmdk_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvmdk_notify_set_verbose(
+	 verbose );
+
+	if( export_handle_initialize(
+	     &vmdkexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize export handle.\n" );
+
+		goto on_error;
+	}
+	vmdkexport_export_handle->use_copy_offload = use_copy_offload;
+
+	result = export_handle_open_input(
+	          vmdkexport_export_handle,
+	          source,
+	          &error );
+
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source file.\n" );
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unsupported disk type.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_open_output(
+	     vmdkexport_export_handle,
+	     destination,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open destination.\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_signal_attach(
+	     vmdkexport_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = export_handle_export(
+	          vmdkexport_export_handle,
+	          &error );
+
+	if( vmdktools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result == -1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to export image.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_close(
+	     vmdkexport_export_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close export handle.\n" );
+
+		goto on_error;
+	}
+	if( export_handle_free(
+	     &vmdkexport_export_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free export handle.\n" );
+
+		goto on_error;
+	}
+	if( vmdkexport_abort != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Export: ABORTED\n" );
+
+		return( EXIT_FAILURE );
+	}
+	fprintf(
+	 stderr,
+	 "Export: SUCCESS\n" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vmdkexport_export_handle != NULL )
+	{
+		export_handle_close(
+		 vmdkexport_export_handle,
+		 NULL );
+		export_handle_free(
+		 &vmdkexport_export_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
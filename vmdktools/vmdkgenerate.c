@@ -0,0 +1,708 @@
+/*
+ * Generates synthetic VMware Virtual Disk (VMDK) image files
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "generate_handle.h"
+#include "vmdktools_getopt.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libclocale.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libvmdk.h"
+#include "vmdktools_output.h"
+#include "vmdktools_signal.h"
+#include "vmdktools_unused.h"
+
+generate_handle_t *vmdkgenerate_generate_handle = NULL;
+int vmdkgenerate_abort                           = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vmdkgenerate to generate a synthetic VMware Virtual Disk (VMDK) image\n"
+	                 "file with reproducible contents and optionally a chain of delta disks.\n\n" );
+
+	fprintf( stream, "Usage: vmdkgenerate [ -b block_size ] [ -c compressibility ]\n"
+	                 "                    [ -d number_of_delta_disks ] [ -D delta_fill ]\n"
+	                 "                    [ -f format ] [ -F fill ] [ -g grain_size ]\n"
+	                 "                    [ -m media_size ] [ -r fragmentation ] [ -s seed ]\n"
+	                 "                    [ -t threads ] [ -hvV ] destination\n\n" );
+
+	fprintf( stream, "\tdestination: the destination file\n\n" );
+
+	fprintf( stream, "\t-b:     specify the block size, which is the unit in which data is\n"
+	                 "\t        allocated, must be a multiple of the grain size and not\n"
+	                 "\t        exceed %d MiB, default is the grain size\n",
+	         GENERATE_HANDLE_MAXIMUM_BLOCK_SIZE / ( 1024 * 1024 ) );
+	fprintf( stream, "\t-c:     specify the percentage of the data that is compressible,\n"
+	                 "\t        default is %d\n",
+	         GENERATE_HANDLE_DEFAULT_COMPRESSIBILITY );
+	fprintf( stream, "\t-d:     specify the number of delta disks, at most %d, default is 0\n",
+	         GENERATE_HANDLE_MAXIMUM_NUMBER_OF_DELTA_DISKS );
+	fprintf( stream, "\t-D:     specify the percentage of the blocks written to each delta\n"
+	                 "\t        disk, default is %d\n",
+	         GENERATE_HANDLE_DEFAULT_DELTA_FILL_PERCENTAGE );
+	fprintf( stream, "\t-f:     specify the output format of the base image, options:\n"
+	                 "\t        flat, sparse (default), split, stream\n" );
+	fprintf( stream, "\t-F:     specify the percentage of the blocks of the base image that\n"
+	                 "\t        contain data, default is %d\n",
+	         GENERATE_HANDLE_DEFAULT_FILL_PERCENTAGE );
+	fprintf( stream, "\t-g:     specify the grain size of sparse and stream-optimized\n"
+	                 "\t        images, must be a power of 2 between %d KiB and %d MiB,\n"
+	                 "\t        default is %d KiB\n",
+	         GENERATE_HANDLE_MINIMUM_GRAIN_SIZE / 1024,
+	         GENERATE_HANDLE_MAXIMUM_GRAIN_SIZE / ( 1024 * 1024 ),
+	         GENERATE_HANDLE_DEFAULT_GRAIN_SIZE / 1024 );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-m:     specify the media size, must be a multiple of 512,\n"
+	                 "\t        default is %d GiB\n",
+	         GENERATE_HANDLE_DEFAULT_MEDIA_SIZE / ( 1024 * 1024 * 1024 ) );
+	fprintf( stream, "\t-r:     specify the fragmentation percentage, 0 stores the data in\n"
+	                 "\t        a single run, 100 in runs of a single block, default is %d\n",
+	         GENERATE_HANDLE_DEFAULT_FRAGMENTATION );
+	fprintf( stream, "\t-s:     specify the seed of the generated layout and data,\n"
+	                 "\t        default is %d\n",
+	         GENERATE_HANDLE_DEFAULT_SEED );
+	fprintf( stream, "\t-t:     specify the number of threads used to compress\n"
+	                 "\t        stream-optimized output, default is %d\n",
+	         GENERATE_HANDLE_DEFAULT_NUMBER_OF_THREADS );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for vmdkgenerate
+ */
+void vmdkgenerate_signal_handler(
+      vmdktools_signal_t signal VMDKTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "vmdkgenerate_signal_handler";
+
+	VMDKTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vmdkgenerate_abort = 1;
+
+	if( vmdkgenerate_generate_handle != NULL )
+	{
+		if( generate_handle_signal_abort(
+		     vmdkgenerate_generate_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal generate handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libvmdk_error_t *error                           = NULL;
+	system_character_t *destination                  = NULL;
+	system_character_t *option_block_size            = NULL;
+	system_character_t *option_compressibility       = NULL;
+	system_character_t *option_delta_fill_percentage = NULL;
+	system_character_t *option_fill_percentage       = NULL;
+	system_character_t *option_format                = NULL;
+	system_character_t *option_fragmentation         = NULL;
+	system_character_t *option_grain_size            = NULL;
+	system_character_t *option_media_size            = NULL;
+	system_character_t *option_number_of_delta_disks = NULL;
+	system_character_t *option_number_of_threads     = NULL;
+	system_character_t *option_seed                  = NULL;
+	char *program                                    = "vmdkgenerate";
+	system_integer_t option                          = 0;
+	int result                                       = 0;
+	int verbose                                      = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "vmdktools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+        if( vmdktools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vmdkoutput_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vmdktools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "b:c:d:D:f:F:g:hm:r:s:t:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'b':
+				option_block_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'c':
+				option_compressibility = optarg;
+
+				break;
+
+			case (system_integer_t) 'd':
+				option_number_of_delta_disks = optarg;
+
+				break;
+
+			case (system_integer_t) 'D':
+				option_delta_fill_percentage = optarg;
+
+				break;
+
+			case (system_integer_t) 'f':
+				option_format = optarg;
+
+				break;
+
+			case (system_integer_t) 'F':
+				option_fill_percentage = optarg;
+
+				break;
+
+			case (system_integer_t) 'g':
+				option_grain_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'm':
+				option_media_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'r':
+				option_fragmentation = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				option_seed = optarg;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vmdkoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing destination file.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	destination = argv[ optind ];
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvmdk_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvmdk_notify_set_verbose(
+	 verbose );
+
+	if( generate_handle_initialize(
+	     &vmdkgenerate_generate_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize generate handle.\n" );
+
+		goto on_error;
+	}
+	if( option_format != NULL )
+	{
+		result = generate_handle_set_output_format(
+		          vmdkgenerate_generate_handle,
+		          option_format,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set output format.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported output format.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_media_size != NULL )
+	{
+		result = generate_handle_set_media_size(
+		          vmdkgenerate_generate_handle,
+		          option_media_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set media size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported media size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_grain_size != NULL )
+	{
+		result = generate_handle_set_grain_size(
+		          vmdkgenerate_generate_handle,
+		          option_grain_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set grain size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported grain size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_block_size != NULL )
+	{
+		result = generate_handle_set_block_size(
+		          vmdkgenerate_generate_handle,
+		          option_block_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set block size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported block size.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_fill_percentage != NULL )
+	{
+		result = generate_handle_set_fill_percentage(
+		          vmdkgenerate_generate_handle,
+		          option_fill_percentage,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set fill percentage.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported fill percentage.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_delta_fill_percentage != NULL )
+	{
+		result = generate_handle_set_delta_fill_percentage(
+		          vmdkgenerate_generate_handle,
+		          option_delta_fill_percentage,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set delta fill percentage.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported delta fill percentage.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_compressibility != NULL )
+	{
+		result = generate_handle_set_compressibility(
+		          vmdkgenerate_generate_handle,
+		          option_compressibility,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set compressibility.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported compressibility.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_fragmentation != NULL )
+	{
+		result = generate_handle_set_fragmentation(
+		          vmdkgenerate_generate_handle,
+		          option_fragmentation,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set fragmentation.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported fragmentation.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_delta_disks != NULL )
+	{
+		result = generate_handle_set_number_of_delta_disks(
+		          vmdkgenerate_generate_handle,
+		          option_number_of_delta_disks,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of delta disks.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of delta disks.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_number_of_threads != NULL )
+	{
+		result = generate_handle_set_number_of_threads(
+		          vmdkgenerate_generate_handle,
+		          option_number_of_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_seed != NULL )
+	{
+		if( generate_handle_set_seed(
+		     vmdkgenerate_generate_handle,
+		     option_seed,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set seed.\n" );
+
+			goto on_error;
+		}
+	}
+	if( generate_handle_set_filename(
+	     vmdkgenerate_generate_handle,
+	     destination,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to set destination filename.\n" );
+
+		goto on_error;
+	}
+	if( generate_handle_open_output(
+	     vmdkgenerate_generate_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open destination file.\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_signal_attach(
+	     vmdkgenerate_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = generate_handle_generate(
+	          vmdkgenerate_generate_handle,
+	          &error );
+
+	if( vmdktools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( result == -1 )
+	 && ( vmdkgenerate_abort == 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to generate image.\n" );
+
+		goto on_error;
+	}
+	if( generate_handle_close(
+	     vmdkgenerate_generate_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close generate handle.\n" );
+
+		goto on_error;
+	}
+	if( vmdkgenerate_abort != 0 )
+	{
+		if( error != NULL )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		generate_handle_free(
+		 &vmdkgenerate_generate_handle,
+		 NULL );
+
+		fprintf(
+		 stdout,
+		 "Generate: ABORTED\n" );
+
+		return( EXIT_FAILURE );
+	}
+	if( generate_handle_free(
+	     &vmdkgenerate_generate_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free generate handle.\n" );
+
+		goto on_error;
+	}
+	fprintf(
+	 stdout,
+	 "Generate: SUCCESS\n" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vmdkgenerate_generate_handle != NULL )
+	{
+		generate_handle_close(
+		 vmdkgenerate_generate_handle,
+		 NULL );
+		generate_handle_free(
+		 &vmdkgenerate_generate_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -58,13 +58,18 @@ void usage_fprint(
 	fprintf( stream, "Use vmdkinfo to determine information about a VMware Virtual Disk (VMDK)\n"
 	                 "image file.\n\n" );
 
-	fprintf( stream, "Usage: vmdkinfo [ -hvV ] source\n\n" );
+	fprintf( stream, "Usage: vmdkinfo [ -ahvVz ] source\n\n" );
 
 	fprintf( stream, "\tsource: the source file(s)\n\n" );
 
+	fprintf( stream, "\t-a:     shows the allocated, sparse and compressed grains and the\n"
+	                 "\t        fragmentation, this only reads the grain directories and\n"
+	                 "\t        grain tables\n" );
 	fprintf( stream, "\t-h:     shows this help\n" );
 	fprintf( stream, "\t-v:     verbose output to stderr\n" );
 	fprintf( stream, "\t-V:     print version\n" );
+	fprintf( stream, "\t-z:     shows the allocated data that only contains 0-byte values,\n"
+	                 "\t        this reads all the allocated grains\n" );
 }
 
 /* Signal handler for vmdkinfo
@@ -124,6 +129,8 @@ int main( int argc, char * const argv[] )
 	char *program                                = "vmdkinfo";
 	system_integer_t option                      = 0;
 	int number_of_source_filenames               = 0;
+	int print_allocation                         = 0;
+	int print_zero_statistics                    = 0;
 	int verbose                                  = 0;
 
 	libcnotify_stream_set(
@@ -159,7 +166,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = vmdktools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hvV" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "ahvVz" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -175,6 +182,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+			case (system_integer_t) 'a':
+				print_allocation = 1;
+
+				break;
+
 			case (system_integer_t) 'h':
 				usage_fprint(
 				 stdout );
@@ -191,6 +203,11 @@ int main( int argc, char * const argv[] )
 				 stdout );
 
 				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'z':
+				print_zero_statistics = 1;
+
+				break;
 		}
 	}
 	if( optind == argc )
@@ -225,6 +242,22 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( verbose != 0 )
+	{
+		/* The open phases are printed in verbose mode
+		 */
+		if( info_handle_set_statistics_flags(
+		     vmdkinfo_info_handle,
+		     LIBVMDK_STATISTICS_FLAG_MEASURE_TIME,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set statistics flags.\n" );
+
+			goto on_error;
+		}
+	}
 	if( info_handle_open_input(
 	     vmdkinfo_info_handle,
 	     source_filenames,
@@ -247,6 +280,45 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	if( print_allocation != 0 )
+	{
+		if( info_handle_allocation_fprint(
+		     vmdkinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print allocation statistics.\n" );
+
+			goto on_error;
+		}
+	}
+	if( print_zero_statistics != 0 )
+	{
+		if( info_handle_zero_statistics_fprint(
+		     vmdkinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print zero data statistics.\n" );
+
+			goto on_error;
+		}
+	}
+	if( verbose != 0 )
+	{
+		if( info_handle_open_phases_fprint(
+		     vmdkinfo_info_handle,
+		     &error ) != 1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to print open phases.\n" );
+
+			goto on_error;
+		}
+	}
 	if( info_handle_close(
 	     vmdkinfo_info_handle,
 	     &error ) != 0 )
@@ -51,7 +51,13 @@
 #endif
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
+#if defined( HAVE_FUSE_LOOP_CFG_SET_MAX_THREADS )
+#define FUSE_USE_VERSION	312
+#elif defined( HAVE_LIBFUSE3 )
+#define FUSE_USE_VERSION	35
+#else
 #define FUSE_USE_VERSION	26
+#endif
 
 #if defined( HAVE_LIBFUSE )
 #include <fuse.h>
@@ -60,6 +66,40 @@
 #include <osxfuse/fuse.h>
 #endif
 
+#if defined( HAVE_LIBFUSE ) && ( FUSE_VERSION >= 29 )
+#define VMDKMOUNT_HAVE_FUSE_FALLOCATE
+
+#if defined( HAVE_FCNTL_H )
+#include <fcntl.h>
+#endif
+
+/* The fallocate mode flags as defined by Linux
+ */
+#if !defined( FALLOC_FL_KEEP_SIZE )
+#define FALLOC_FL_KEEP_SIZE	0x01
+#endif
+
+#if !defined( FALLOC_FL_PUNCH_HOLE )
+#define FALLOC_FL_PUNCH_HOLE	0x02
+#endif
+
+#endif /* defined( HAVE_LIBFUSE ) && ( FUSE_VERSION >= 29 ) */
+
+#if defined( HAVE_LIBFUSE3 )
+#define VMDKMOUNT_HAVE_FUSE_LSEEK
+
+/* The lseek whence values as defined by Linux
+ */
+#if !defined( SEEK_DATA )
+#define SEEK_DATA	3
+#endif
+
+#if !defined( SEEK_HOLE )
+#define SEEK_HOLE	4
+#endif
+
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
 #elif defined( HAVE_LIBDOKAN )
 #include <dokan.h>
 #endif
@@ -89,16 +129,34 @@ void usage_fprint(
 	fprintf( stream, "Use vmdkmount to mount the VMware Virtual Disk (VMDK)\n"
                          "image file\n\n" );
 
-	fprintf( stream, "Usage: vmdkmount [ -X extended_options ] [ -hvV ]\n"
-	                 "                 vmdk_file mount_point\n\n" );
+	fprintf( stream, "Usage: vmdkmount [ -c cache_size ] [ -t threads ] [ -X extended_options ]\n"
+	                 "                 [ -hsvVw ] vmdk_file mount_point\n\n" );
 
 	fprintf( stream, "\tvmdk_file:   the VMDK image file\n\n" );
-	fprintf( stream, "\tmount_point: the directory to serve as mount point\n\n" );
+	fprintf( stream, "\tmount_point: the directory to serve as mount point, the image data\n"
+	                 "\t             is provided as vmdk1 and its read statistics as\n"
+	                 "\t             vmdk1.stats\n\n" );
 
+	fprintf( stream, "\t-c:          specify the maximum size of the grain data cache in MiB,\n"
+	                 "\t             the cache is shared by the image file and its parents\n" );
 	fprintf( stream, "\t-h:          shows this help\n" );
+	fprintf( stream, "\t-s:          measure the read and decompression times, the times\n"
+	                 "\t             and their histograms are provided in the read\n"
+	                 "\t             statistics\n" );
 	fprintf( stream, "\t-v:          verbose output to stderr\n"
 	                 "\t             vmdkmount will remain running in the foreground\n" );
+	fprintf( stream, "\t-t:          specify the number of threads used to serve requests,\n"
+	                 "\t             the default is 1, when mounted read-only the image\n"
+	                 "\t             file and its parents are opened once per thread so\n"
+	                 "\t             that the image data can be read concurrently, with\n"
+	                 "\t             write access the reads and writes of the image data\n"
+	                 "\t             are serialized. FUSE 3 before 3.12 only limits the\n"
+	                 "\t             number of idle threads, the additional threads wait\n"
+	                 "\t             for a reader to become available\n" );
 	fprintf( stream, "\t-V:          print version\n" );
+	fprintf( stream, "\t-w:          mount the image file with write access, only the\n"
+	                 "\t             last file is writable, the parent files remain\n"
+	                 "\t             read-only\n" );
 	fprintf( stream, "\t-X:          extended options to pass to sub system\n" );
 }
 
@@ -152,13 +210,80 @@ void vmdkmount_signal_handler(
 #error Size of off_t not supported
 #endif
 
-static char *vmdkmount_fuse_path_prefix         = "/vmdk";
-static size_t vmdkmount_fuse_path_prefix_length = 5;
+#if defined( HAVE_LIBFUSE3 )
+
+/* The default options, which request reads and readahead of up to 1 MiB
+ */
+#define VMDKMOUNT_FUSE_DEFAULT_OPTIONS	"max_read=1048576,max_readahead=1048576"
+
+#endif
+
+static char *vmdkmount_fuse_path_prefix                    = "/vmdk";
+static size_t vmdkmount_fuse_path_prefix_length            = 5;
+
+static char *vmdkmount_fuse_statistics_path_suffix         = ".stats";
+static size_t vmdkmount_fuse_statistics_path_suffix_length = 6;
 
 #if defined( HAVE_TIME )
-time_t vmdkmount_timestamp                      = 0;
+time_t vmdkmount_timestamp                                 = 0;
 #endif
 
+/* Determines the input handle index of a statistics file path, such as "/vmdk1.stats"
+ * Returns 1 if the path is a statistics file path or 0 if not
+ */
+int vmdkmount_fuse_get_statistics_input_handle_index(
+     const char *path,
+     size_t path_length,
+     int *input_handle_index )
+{
+	size_t number_of_digits = 0;
+	size_t string_index     = 0;
+
+	if( ( path == NULL )
+	 || ( input_handle_index == NULL ) )
+	{
+		return( 0 );
+	}
+	if( ( path_length <= ( vmdkmount_fuse_path_prefix_length + vmdkmount_fuse_statistics_path_suffix_length ) )
+	 || ( path_length > ( vmdkmount_fuse_path_prefix_length + 3 + vmdkmount_fuse_statistics_path_suffix_length ) ) )
+	{
+		return( 0 );
+	}
+	number_of_digits = path_length - vmdkmount_fuse_path_prefix_length - vmdkmount_fuse_statistics_path_suffix_length;
+
+	if( narrow_string_compare(
+	     path,
+	     vmdkmount_fuse_path_prefix,
+	     vmdkmount_fuse_path_prefix_length ) != 0 )
+	{
+		return( 0 );
+	}
+	if( narrow_string_compare(
+	     &( path[ vmdkmount_fuse_path_prefix_length + number_of_digits ] ),
+	     vmdkmount_fuse_statistics_path_suffix,
+	     vmdkmount_fuse_statistics_path_suffix_length ) != 0 )
+	{
+		return( 0 );
+	}
+	*input_handle_index = 0;
+
+	for( string_index = vmdkmount_fuse_path_prefix_length;
+	     string_index < ( vmdkmount_fuse_path_prefix_length + number_of_digits );
+	     string_index++ )
+	{
+		if( ( path[ string_index ] < '0' )
+		 || ( path[ string_index ] > '9' ) )
+		{
+			return( 0 );
+		}
+		*input_handle_index *= 10;
+		*input_handle_index += path[ string_index ] - '0';
+	}
+	*input_handle_index -= 1;
+
+	return( 1 );
+}
+
 /* Opens a file or directory
  * Returns 0 if successful or a negative errno value otherwise
  */
@@ -167,9 +292,13 @@ int vmdkmount_fuse_open(
      struct fuse_file_info *file_info )
 {
 	libcerror_error_t *error = NULL;
+	char *statistics_string  = NULL;
 	static char *function    = "vmdkmount_fuse_open";
 	size_t path_length       = 0;
+	size_t string_length     = 0;
+	int input_handle_index   = 0;
 	int result               = 0;
+	int string_index         = 0;
 
 	if( path == NULL )
 	{
@@ -217,18 +346,139 @@ int vmdkmount_fuse_open(
 
 		goto on_error;
 	}
+	if( vmdkmount_fuse_get_statistics_input_handle_index(
+	     path,
+	     path_length,
+	     &input_handle_index ) != 0 )
+	{
+		if( ( file_info->flags & 0x03 ) != O_RDONLY )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: write access not supported.",
+			 function );
+
+			result = -EACCES;
+
+			goto on_error;
+		}
+		/* The statistics are captured when the file is opened
+		 * so that all reads of the file see the same values
+		 */
+		statistics_string = narrow_string_allocate(
+		                     MOUNT_HANDLE_STATISTICS_STRING_SIZE );
+
+		if( statistics_string == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_INSUFFICIENT,
+			 "%s: unable to create statistics string.",
+			 function );
+
+			result = -ENOMEM;
+
+			goto on_error;
+		}
+		if( mount_handle_get_statistics_string(
+		     vmdkmount_mount_handle,
+		     input_handle_index,
+		     statistics_string,
+		     MOUNT_HANDLE_STATISTICS_STRING_SIZE,
+		     &string_length,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics string.",
+			 function );
+
+			result = -ENOENT;
+
+			goto on_error;
+		}
+		/* The size of the statistics file changes hence the kernel
+		 * should not cache its data
+		 */
+		file_info->fh        = (uint64_t) (intptr_t) statistics_string;
+		file_info->direct_io = 1;
+
+		return( 0 );
+	}
 	if( ( file_info->flags & 0x03 ) != O_RDONLY )
 	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-		 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
-		 "%s: write access currently not supported.",
-		 function );
+		if( path_length > ( vmdkmount_fuse_path_prefix_length + 3 ) )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+			 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+			 "%s: unsupported path.",
+			 function );
 
-		result = -EACCES;
+			result = -ENOENT;
 
-		goto on_error;
+			goto on_error;
+		}
+		string_index = (int) vmdkmount_fuse_path_prefix_length;
+
+		input_handle_index = path[ string_index++ ] - '0';
+
+		if( string_index < (int) path_length )
+		{
+			input_handle_index *= 10;
+			input_handle_index += path[ string_index++ ] - '0';
+		}
+		if( string_index < (int) path_length )
+		{
+			input_handle_index *= 10;
+			input_handle_index += path[ string_index++ ] - '0';
+		}
+		input_handle_index -= 1;
+
+		result = mount_handle_is_writable(
+		          vmdkmount_mount_handle,
+		          input_handle_index,
+		          &error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if mount handle is writable.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_UNSUPPORTED_VALUE,
+			 "%s: write access not supported.",
+			 function );
+
+			result = -EACCES;
+
+			goto on_error;
+		}
+	}
+	else if( vmdkmount_mount_handle->write_access == 0 )
+	{
+		/* The image is immutable hence the kernel can keep its page cache
+		 * between opens
+		 */
+		file_info->keep_cache = 1;
 	}
 	return( 0 );
 
@@ -240,6 +490,11 @@ on_error:
 		libcerror_error_free(
 		 &error );
 	}
+	if( statistics_string != NULL )
+	{
+		memory_free(
+		 statistics_string );
+	}
 	return( result );
 }
 
@@ -254,8 +509,10 @@ int vmdkmount_fuse_read(
      struct fuse_file_info *file_info )
 {
 	libcerror_error_t *error = NULL;
+	char *statistics_string  = NULL;
 	static char *function    = "vmdkmount_fuse_read";
 	size_t path_length       = 0;
+	size_t string_length     = 0;
 	ssize_t read_count       = 0;
 	int input_handle_index   = 0;
 	int result               = 0;
@@ -303,6 +560,56 @@ int vmdkmount_fuse_read(
 	path_length = narrow_string_length(
 	               path );
 
+	if( vmdkmount_fuse_get_statistics_input_handle_index(
+	     path,
+	     path_length,
+	     &input_handle_index ) != 0 )
+	{
+		statistics_string = (char *) (intptr_t) file_info->fh;
+
+		if( statistics_string == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_MISSING,
+			 "%s: invalid file info - missing statistics string.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		string_length = narrow_string_length(
+		                 statistics_string );
+
+		if( ( offset < 0 )
+		 || ( (size_t) offset >= string_length ) )
+		{
+			return( 0 );
+		}
+		if( size > ( string_length - (size_t) offset ) )
+		{
+			size = string_length - (size_t) offset;
+		}
+		if( memory_copy(
+		     buffer,
+		     &( statistics_string[ offset ] ),
+		     size ) == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy statistics string.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		return( (int) size );
+	}
 	if( ( path_length <= vmdkmount_fuse_path_prefix_length )
 	 || ( path_length > ( vmdkmount_fuse_path_prefix_length + 3 ) )
 	 || ( narrow_string_compare(
@@ -337,29 +644,12 @@ int vmdkmount_fuse_read(
 	}
 	input_handle_index -= 1;
 
-	if( mount_handle_seek_offset(
-	     vmdkmount_mount_handle,
-	     input_handle_index,
-	     (off64_t) offset,
-	     SEEK_SET,
-	     &error ) == -1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset in mount handle.",
-		 function );
-
-		result = -EIO;
-
-		goto on_error;
-	}
-	read_count = mount_handle_read_buffer(
+	read_count = mount_handle_read_buffer_at_offset(
 	              vmdkmount_mount_handle,
 	              input_handle_index,
 	              (uint8_t *) buffer,
 	              size,
+	              (off64_t) offset,
 	              &error );
 
 	if( read_count == -1 )
@@ -388,70 +678,574 @@ on_error:
 	return( result );
 }
 
-/* Sets the values in a stat info structure
- * Returns 1 if successful or -1 on error
+/* Writes a buffer of data at the specified offset
+ * Returns number of bytes written if successful or a negative errno value otherwise
  */
-int vmdkmount_fuse_set_stat_info(
-     struct stat *stat_info,
-     size64_t size,
-     int number_of_sub_items,
-     uint8_t use_mount_time,
-     libcerror_error_t **error )
+int vmdkmount_fuse_write(
+     const char *path,
+     const char *buffer,
+     size_t size,
+     off_t offset,
+     struct fuse_file_info *file_info )
 {
-	static char *function = "vmdkmount_fuse_set_stat_info";
+	libcerror_error_t *error = NULL;
+	static char *function    = "vmdkmount_fuse_write";
+	size_t path_length       = 0;
+	ssize_t write_count      = 0;
+	int input_handle_index   = 0;
+	int result               = 0;
+	int string_index         = 0;
 
-	if( stat_info == NULL )
+	if( path == NULL )
 	{
 		libcerror_error_set(
-		 error,
+		 &error,
 		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
 		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
-		 "%s: invalid stat info.",
+		 "%s: invalid path.",
 		 function );
 
-		return( -1 );
-	}
-#if defined( HAVE_TIME )
-	if( use_mount_time != 0 )
-	{
-		if( vmdkmount_timestamp == 0 )
-		{
-			if( time(
-			     &vmdkmount_timestamp ) == (time_t) -1 )
-			{
-				vmdkmount_timestamp = 0;
-			}
-		}
-		stat_info->st_atime = vmdkmount_timestamp;
-		stat_info->st_mtime = vmdkmount_timestamp;
-		stat_info->st_ctime = vmdkmount_timestamp;
+		result = -EINVAL;
+
+		goto on_error;
 	}
-#endif
-	if( size != 0 )
+	if( size > (size_t) INT_MAX )
 	{
-#if SIZEOF_OFF_T <= 4
-		if( size > (size64_t) UINT32_MAX )
-#else
-		if( size > (size64_t) INT64_MAX )
-#endif
-		{
-			libcerror_error_set(
-			 error,
-			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
-			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
-			 "%s: invalid size value out of bounds.",
-			 function );
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_EXCEEDS_MAXIMUM,
+		 "%s: invalid size value exceeds maximum.",
+		 function );
 
-			return( -1 );
-		}
-		stat_info->st_size = (off_t) size;
+		result = -EINVAL;
+
+		goto on_error;
 	}
-	if( number_of_sub_items > 0 )
+	if( file_info == NULL )
 	{
-		stat_info->st_mode  = S_IFDIR | 0555;
-		stat_info->st_nlink = 2;
-	}
-	else
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	path_length = narrow_string_length(
+	               path );
+
+	if( ( path_length <= vmdkmount_fuse_path_prefix_length )
+	 || ( path_length > ( vmdkmount_fuse_path_prefix_length + 3 ) )
+	 || ( narrow_string_compare(
+	       path,
+	       vmdkmount_fuse_path_prefix,
+	       vmdkmount_fuse_path_prefix_length ) != 0 ) )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported path.",
+		 function );
+
+		result = -ENOENT;
+
+		goto on_error;
+	}
+	string_index = (int) vmdkmount_fuse_path_prefix_length;
+
+	input_handle_index = path[ string_index++ ] - '0';
+
+	if( string_index < (int) path_length )
+	{
+		input_handle_index *= 10;
+		input_handle_index += path[ string_index++ ] - '0';
+	}
+	if( string_index < (int) path_length )
+	{
+		input_handle_index *= 10;
+		input_handle_index += path[ string_index++ ] - '0';
+	}
+	input_handle_index -= 1;
+
+	write_count = mount_handle_write_buffer_at_offset(
+	               vmdkmount_mount_handle,
+	               input_handle_index,
+	               (const uint8_t *) buffer,
+	               size,
+	               (off64_t) offset,
+	               &error );
+
+	if( write_count == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to write to mount handle.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	return( (int) write_count );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#if defined( VMDKMOUNT_HAVE_FUSE_FALLOCATE )
+
+/* Allocates or deallocates space of a file
+ * Only deallocation, i.e. FALLOC_FL_PUNCH_HOLE combined with FALLOC_FL_KEEP_SIZE, is supported
+ * and deallocation is not supported on a delta disk
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int vmdkmount_fuse_fallocate(
+     const char *path,
+     int mode,
+     off_t offset,
+     off_t size,
+     struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vmdkmount_fuse_fallocate";
+	size_t path_length       = 0;
+	int discard_result       = 0;
+	int input_handle_index   = 0;
+	int result               = 0;
+	int string_index         = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( ( offset < 0 )
+	 || ( size <= 0 ) )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_OUT_OF_BOUNDS,
+		 "%s: invalid offset or size value out of bounds.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( mode != ( FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE ) )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported mode: 0x%08x.",
+		 function,
+		 mode );
+
+		result = -EOPNOTSUPP;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	path_length = narrow_string_length(
+	               path );
+
+	if( ( path_length <= vmdkmount_fuse_path_prefix_length )
+	 || ( path_length > ( vmdkmount_fuse_path_prefix_length + 3 ) )
+	 || ( narrow_string_compare(
+	       path,
+	       vmdkmount_fuse_path_prefix,
+	       vmdkmount_fuse_path_prefix_length ) != 0 ) )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported path.",
+		 function );
+
+		result = -ENOENT;
+
+		goto on_error;
+	}
+	string_index = (int) vmdkmount_fuse_path_prefix_length;
+
+	input_handle_index = path[ string_index++ ] - '0';
+
+	if( string_index < (int) path_length )
+	{
+		input_handle_index *= 10;
+		input_handle_index += path[ string_index++ ] - '0';
+	}
+	if( string_index < (int) path_length )
+	{
+		input_handle_index *= 10;
+		input_handle_index += path[ string_index++ ] - '0';
+	}
+	input_handle_index -= 1;
+
+	discard_result = mount_handle_discard(
+	                  vmdkmount_mount_handle,
+	                  input_handle_index,
+	                  (off64_t) offset,
+	                  (size64_t) size,
+	                  &error );
+
+	if( discard_result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_IO,
+		 LIBCERROR_IO_ERROR_WRITE_FAILED,
+		 "%s: unable to discard data in mount handle.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	else if( discard_result == 0 )
+	{
+		return( -EOPNOTSUPP );
+	}
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+#endif /* defined( VMDKMOUNT_HAVE_FUSE_FALLOCATE ) */
+
+#if defined( VMDKMOUNT_HAVE_FUSE_LSEEK )
+
+/* Seeks the next data or hole offset
+ * Only SEEK_DATA and SEEK_HOLE are supported, which are answered from the grain tables
+ * Returns the offset if successful or a negative errno value otherwise
+ */
+off_t vmdkmount_fuse_lseek(
+       const char *path,
+       off_t offset,
+       int whence,
+       struct fuse_file_info *file_info VMDKTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function    = "vmdkmount_fuse_lseek";
+	size_t path_length       = 0;
+	off64_t found_offset     = 0;
+	int input_handle_index   = 0;
+	int result               = 0;
+	int string_index         = 0;
+	uint8_t find_hole        = 0;
+
+	VMDKTOOLS_UNREFERENCED_PARAMETER( file_info )
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( offset < 0 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_VALUE_LESS_THAN_ZERO,
+		 "%s: invalid offset value less than zero.",
+		 function );
+
+		result = -ENXIO;
+
+		goto on_error;
+	}
+	if( whence == SEEK_DATA )
+	{
+		find_hole = 0;
+	}
+	else if( whence == SEEK_HOLE )
+	{
+		find_hole = 1;
+	}
+	else
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported whence.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	path_length = narrow_string_length(
+	               path );
+
+	if( ( path_length <= vmdkmount_fuse_path_prefix_length )
+	 || ( path_length > ( vmdkmount_fuse_path_prefix_length + 3 ) )
+	 || ( narrow_string_compare(
+	       path,
+	       vmdkmount_fuse_path_prefix,
+	       vmdkmount_fuse_path_prefix_length ) != 0 ) )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_UNSUPPORTED_VALUE,
+		 "%s: unsupported path.",
+		 function );
+
+		result = -ENOENT;
+
+		goto on_error;
+	}
+	string_index = (int) vmdkmount_fuse_path_prefix_length;
+
+	input_handle_index = path[ string_index++ ] - '0';
+
+	if( string_index < (int) path_length )
+	{
+		input_handle_index *= 10;
+		input_handle_index += path[ string_index++ ] - '0';
+	}
+	if( string_index < (int) path_length )
+	{
+		input_handle_index *= 10;
+		input_handle_index += path[ string_index++ ] - '0';
+	}
+	input_handle_index -= 1;
+
+	result = mount_handle_find_data_offset(
+	          vmdkmount_mount_handle,
+	          input_handle_index,
+	          (off64_t) offset,
+	          find_hole,
+	          &found_offset,
+	          &error );
+
+	if( result == -1 )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+		 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+		 "%s: unable to find data or hole offset in mount handle.",
+		 function );
+
+		result = -EIO;
+
+		goto on_error;
+	}
+	else if( result == 0 )
+	{
+		return( -ENXIO );
+	}
+	return( (off_t) found_offset );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( (off_t) result );
+}
+
+#endif /* defined( VMDKMOUNT_HAVE_FUSE_LSEEK ) */
+
+/* Releases a file
+ * Returns 0 if successful or a negative errno value otherwise
+ */
+int vmdkmount_fuse_release(
+     const char *path,
+     struct fuse_file_info *file_info )
+{
+	libcerror_error_t *error = NULL;
+	char *statistics_string  = NULL;
+	static char *function    = "vmdkmount_fuse_release";
+	size_t path_length       = 0;
+	int input_handle_index   = 0;
+	int result               = 0;
+
+	if( path == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid path.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	if( file_info == NULL )
+	{
+		libcerror_error_set(
+		 &error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid file info.",
+		 function );
+
+		result = -EINVAL;
+
+		goto on_error;
+	}
+	path_length = narrow_string_length(
+	               path );
+
+	if( vmdkmount_fuse_get_statistics_input_handle_index(
+	     path,
+	     path_length,
+	     &input_handle_index ) != 0 )
+	{
+		statistics_string = (char *) (intptr_t) file_info->fh;
+
+		if( statistics_string != NULL )
+		{
+			memory_free(
+			 statistics_string );
+
+			file_info->fh = 0;
+		}
+	}
+	return( 0 );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	return( result );
+}
+
+/* Sets the values in a stat info structure
+ * Returns 1 if successful or -1 on error
+ */
+int vmdkmount_fuse_set_stat_info(
+     struct stat *stat_info,
+     size64_t size,
+     int number_of_sub_items,
+     uint8_t use_mount_time,
+     uint8_t is_writable,
+     libcerror_error_t **error )
+{
+	static char *function = "vmdkmount_fuse_set_stat_info";
+
+	if( stat_info == NULL )
+	{
+		libcerror_error_set(
+		 error,
+		 LIBCERROR_ERROR_DOMAIN_ARGUMENTS,
+		 LIBCERROR_ARGUMENT_ERROR_INVALID_VALUE,
+		 "%s: invalid stat info.",
+		 function );
+
+		return( -1 );
+	}
+#if defined( HAVE_TIME )
+	if( use_mount_time != 0 )
+	{
+		if( vmdkmount_timestamp == 0 )
+		{
+			if( time(
+			     &vmdkmount_timestamp ) == (time_t) -1 )
+			{
+				vmdkmount_timestamp = 0;
+			}
+		}
+		stat_info->st_atime = vmdkmount_timestamp;
+		stat_info->st_mtime = vmdkmount_timestamp;
+		stat_info->st_ctime = vmdkmount_timestamp;
+	}
+#endif
+	if( size != 0 )
+	{
+#if SIZEOF_OFF_T <= 4
+		if( size > (size64_t) UINT32_MAX )
+#else
+		if( size > (size64_t) INT64_MAX )
+#endif
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_VALUE_OUT_OF_BOUNDS,
+			 "%s: invalid size value out of bounds.",
+			 function );
+
+			return( -1 );
+		}
+		stat_info->st_size = (off_t) size;
+	}
+	if( number_of_sub_items > 0 )
+	{
+		stat_info->st_mode  = S_IFDIR | 0555;
+		stat_info->st_nlink = 2;
+	}
+	else if( is_writable != 0 )
+	{
+		stat_info->st_mode  = S_IFREG | 0644;
+		stat_info->st_nlink = 1;
+	}
+	else
 	{
 		stat_info->st_mode  = S_IFREG | 0444;
 		stat_info->st_nlink = 1;
@@ -482,6 +1276,8 @@ int vmdkmount_fuse_filldir(
 	static char *function   = "vmdkmount_fuse_filldir";
 	size64_t media_size     = 0;
 	int number_of_sub_items = 0;
+	int result              = 0;
+	uint8_t is_writable     = 0;
 
 	if( filler == NULL )
 	{
@@ -510,11 +1306,28 @@ int vmdkmount_fuse_filldir(
 			 error,
 			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
 			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
-			 "%s: unable to retrieve media size.",
+			 "%s: unable to retrieve media size.",
+			 function );
+
+			return( -1 );
+		}
+		result = mount_handle_is_writable(
+		          mount_handle,
+		          input_handle_index,
+		          error );
+
+		if( result == -1 )
+		{
+			libcerror_error_set(
+			 error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to determine if input handle is writable.",
 			 function );
 
 			return( -1 );
 		}
+		is_writable = (uint8_t) result;
 	}
 	if( memory_set(
 	     stat_info,
@@ -535,6 +1348,7 @@ int vmdkmount_fuse_filldir(
 	     media_size,
 	     number_of_sub_items,
 	     use_mount_time,
+	     is_writable,
 	     error ) != 1 )
 	{
 		libcerror_error_set(
@@ -546,11 +1360,20 @@ int vmdkmount_fuse_filldir(
 
 		return( -1 );
 	}
+#if defined( HAVE_LIBFUSE3 )
+	if( filler(
+	     buffer,
+	     name,
+	     stat_info,
+	     0,
+	     0 ) == 1 )
+#else
 	if( filler(
 	     buffer,
 	     name,
 	     stat_info,
 	     0 ) == 1 )
+#endif
 	{
 		libcerror_error_set(
 		 error,
@@ -572,9 +1395,14 @@ int vmdkmount_fuse_readdir(
      void *buffer,
      fuse_fill_dir_t filler,
      off_t offset VMDKTOOLS_ATTRIBUTE_UNUSED,
+#if defined( HAVE_LIBFUSE3 )
+     struct fuse_file_info *file_info VMDKTOOLS_ATTRIBUTE_UNUSED,
+     enum fuse_readdir_flags flags VMDKTOOLS_ATTRIBUTE_UNUSED )
+#else
      struct fuse_file_info *file_info VMDKTOOLS_ATTRIBUTE_UNUSED )
+#endif
 {
-	char vmdkmount_fuse_path[ 10 ];
+	char vmdkmount_fuse_path[ 16 ];
 
 	libcerror_error_t *error    = NULL;
 	struct stat *stat_info      = NULL;
@@ -587,6 +1415,9 @@ int vmdkmount_fuse_readdir(
 
 	VMDKTOOLS_UNREFERENCED_PARAMETER( offset )
 	VMDKTOOLS_UNREFERENCED_PARAMETER( file_info )
+#if defined( HAVE_LIBFUSE3 )
+	VMDKTOOLS_UNREFERENCED_PARAMETER( flags )
+#endif
 
 	if( path == NULL )
 	{
@@ -761,6 +1592,85 @@ int vmdkmount_fuse_readdir(
 
 			result = -EIO;
 
+			goto on_error;
+		}
+		if( narrow_string_copy(
+		     &( vmdkmount_fuse_path[ string_index - 1 ] ),
+		     vmdkmount_fuse_statistics_path_suffix,
+		     vmdkmount_fuse_statistics_path_suffix_length + 1 ) == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_COPY_FAILED,
+			 "%s: unable to copy statistics path suffix.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		string_index += vmdkmount_fuse_statistics_path_suffix_length;
+
+		if( memory_set(
+		     stat_info,
+		     0,
+		     sizeof( struct stat ) ) == NULL )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_MEMORY,
+			 LIBCERROR_MEMORY_ERROR_SET_FAILED,
+			 "%s: unable to clear stat info.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+		if( vmdkmount_fuse_set_stat_info(
+		     stat_info,
+		     0,
+		     0,
+		     1,
+		     0,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set stat info.",
+			 function );
+
+			result = -EIO;
+
+			goto on_error;
+		}
+#if defined( HAVE_LIBFUSE3 )
+		if( filler(
+		     buffer,
+		     &( vmdkmount_fuse_path[ 1 ] ),
+		     stat_info,
+		     0,
+		     0 ) == 1 )
+#else
+		if( filler(
+		     buffer,
+		     &( vmdkmount_fuse_path[ 1 ] ),
+		     stat_info,
+		     0 ) == 1 )
+#endif
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_SET_FAILED,
+			 "%s: unable to set directory entry.",
+			 function );
+
+			result = -EIO;
+
 			goto on_error;
 		}
 	}
@@ -788,20 +1698,35 @@ on_error:
 /* Retrieves the file stat info
  * Returns 0 if successful or a negative errno value otherwise
  */
+#if defined( HAVE_LIBFUSE3 )
+int vmdkmount_fuse_getattr(
+     const char *path,
+     struct stat *stat_info,
+     struct fuse_file_info *file_info VMDKTOOLS_ATTRIBUTE_UNUSED )
+#else
 int vmdkmount_fuse_getattr(
      const char *path,
      struct stat *stat_info )
+#endif
 {
+	char statistics_string[ MOUNT_HANDLE_STATISTICS_STRING_SIZE ];
+
 	libcerror_error_t *error = NULL;
 	static char *function    = "vmdkmount_fuse_getattr";
 	size64_t media_size      = 0;
 	size_t path_length       = 0;
+	size_t string_length     = 0;
 	int input_handle_index   = 0;
 	int number_of_sub_items  = 0;
 	int result               = -ENOENT;
 	int string_index         = 0;
+	uint8_t is_writable      = 0;
 	uint8_t use_mount_time   = 0;
 
+#if defined( HAVE_LIBFUSE3 )
+	VMDKTOOLS_UNREFERENCED_PARAMETER( file_info )
+#endif
+
 	if( path == NULL )
 	{
 		libcerror_error_set(
@@ -897,10 +1822,57 @@ int vmdkmount_fuse_getattr(
 
 				goto on_error;
 			}
+			result = mount_handle_is_writable(
+			          vmdkmount_mount_handle,
+			          input_handle_index,
+			          &error );
+
+			if( result == -1 )
+			{
+				libcerror_error_set(
+				 &error,
+				 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+				 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+				 "%s: unable to determine if input handle is writable.",
+				 function );
+
+				result = -EIO;
+
+				goto on_error;
+			}
+			is_writable    = (uint8_t) result;
 			use_mount_time = 1;
 			result         = 0;
 		}
 	}
+	else if( vmdkmount_fuse_get_statistics_input_handle_index(
+	          path,
+	          path_length,
+	          &input_handle_index ) != 0 )
+	{
+		if( mount_handle_get_statistics_string(
+		     vmdkmount_mount_handle,
+		     input_handle_index,
+		     statistics_string,
+		     MOUNT_HANDLE_STATISTICS_STRING_SIZE,
+		     &string_length,
+		     &error ) != 1 )
+		{
+			libcerror_error_set(
+			 &error,
+			 LIBCERROR_ERROR_DOMAIN_RUNTIME,
+			 LIBCERROR_RUNTIME_ERROR_GET_FAILED,
+			 "%s: unable to retrieve statistics string.",
+			 function );
+
+			result = -ENOENT;
+
+			goto on_error;
+		}
+		media_size     = (size64_t) string_length;
+		use_mount_time = 1;
+		result         = 0;
+	}
 	if( result == 0 )
 	{
 		if( vmdkmount_fuse_set_stat_info(
@@ -908,6 +1880,7 @@ int vmdkmount_fuse_getattr(
 		     media_size,
 		     number_of_sub_items,
 		     use_mount_time,
+		     is_writable,
 		     &error ) != 1 )
 		{
 			libcerror_error_set(
@@ -1309,29 +2282,12 @@ int __stdcall vmdkmount_dokan_ReadFile(
 	}
 	input_handle_index -= 1;
 
-	if( mount_handle_seek_offset(
-	     vmdkmount_mount_handle,
-	     input_handle_index,
-	     (off64_t) offset,
-	     SEEK_SET,
-	     &error ) == -1 )
-	{
-		libcerror_error_set(
-		 &error,
-		 LIBCERROR_ERROR_DOMAIN_IO,
-		 LIBCERROR_IO_ERROR_SEEK_FAILED,
-		 "%s: unable to seek offset in mount handle.",
-		 function );
-
-		result = -ERROR_SEEK_ON_DEVICE;
-
-		goto on_error;
-	}
-	read_count = mount_handle_read_buffer(
+	read_count = mount_handle_read_buffer_at_offset(
 		      vmdkmount_mount_handle,
 		      input_handle_index,
 		      (uint8_t *) buffer,
 		      (size_t) number_of_bytes_to_read,
+		      (off64_t) offset,
 		      &error );
 
 	if( read_count == -1 )
@@ -2075,22 +3031,33 @@ int wmain( int argc, wchar_t * const argv[] )
 int main( int argc, char * const argv[] )
 #endif
 {
-	system_character_t * const *source_filenames = NULL;
-	libvmdk_error_t *error                       = NULL;
-	system_character_t *mount_point              = NULL;
-	system_character_t *option_extended_options  = NULL;
-	char *program                                = "vmdkmount";
-	system_integer_t option                      = 0;
-	int number_of_source_filenames               = 0;
-	int result                                   = 0;
-	int verbose                                  = 0;
+	system_character_t * const *source_filenames  = NULL;
+	libvmdk_error_t *error                        = NULL;
+	system_character_t *mount_point               = NULL;
+	system_character_t *option_extended_options   = NULL;
+	system_character_t *option_maximum_cache_size = NULL;
+	system_character_t *option_number_of_threads  = NULL;
+	char *program                                 = "vmdkmount";
+	system_integer_t option                       = 0;
+	int measure_time                              = 0;
+	int number_of_source_filenames                = 0;
+	int result                                    = 0;
+	int verbose                                   = 0;
+	int write_access                              = 0;
 
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
 	struct fuse_operations vmdkmount_fuse_operations;
 
-	struct fuse_args vmdkmount_fuse_arguments    = FUSE_ARGS_INIT(0, NULL);
-	struct fuse_chan *vmdkmount_fuse_channel     = NULL;
-	struct fuse *vmdkmount_fuse_handle           = NULL;
+	struct fuse_args vmdkmount_fuse_arguments     = FUSE_ARGS_INIT(0, NULL);
+	struct fuse *vmdkmount_fuse_handle            = NULL;
+
+#if defined( HAVE_FUSE_LOOP_CFG_SET_MAX_THREADS )
+	struct fuse_loop_config *vmdkmount_fuse_loop_config = NULL;
+#elif defined( HAVE_LIBFUSE3 )
+	struct fuse_loop_config vmdkmount_fuse_loop_config;
+#else
+	struct fuse_chan *vmdkmount_fuse_channel      = NULL;
+#endif
 
 #elif defined( HAVE_LIBDOKAN )
 	DOKAN_OPERATIONS vmdkmount_dokan_operations;
@@ -2130,7 +3097,7 @@ int main( int argc, char * const argv[] )
 	while( ( option = vmdktools_getopt(
 	                   argc,
 	                   argv,
-	                   _SYSTEM_STRING( "hvVX:" ) ) ) != (system_integer_t) -1 )
+	                   _SYSTEM_STRING( "c:hst:vVwX:" ) ) ) != (system_integer_t) -1 )
 	{
 		switch( option )
 		{
@@ -2146,12 +3113,27 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_FAILURE );
 
+			case (system_integer_t) 'c':
+				option_maximum_cache_size = optarg;
+
+				break;
+
 			case (system_integer_t) 'h':
 				usage_fprint(
 				 stdout );
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 's':
+				measure_time = 1;
+
+				break;
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
 			case (system_integer_t) 'v':
 				verbose = 1;
 
@@ -2163,6 +3145,11 @@ int main( int argc, char * const argv[] )
 
 				return( EXIT_SUCCESS );
 
+			case (system_integer_t) 'w':
+				write_access = 1;
+
+				break;
+
 			case (system_integer_t) 'X':
 				option_extended_options = optarg;
 
@@ -2214,6 +3201,61 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+	vmdkmount_mount_handle->write_access = write_access;
+
+	if( measure_time != 0 )
+	{
+		vmdkmount_mount_handle->statistics_flags = LIBVMDK_STATISTICS_FLAG_MEASURE_TIME;
+	}
+
+	if( option_number_of_threads != NULL )
+	{
+		result = mount_handle_set_number_of_threads(
+		          vmdkmount_mount_handle,
+		          option_number_of_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( option_maximum_cache_size != NULL )
+	{
+		result = mount_handle_set_maximum_cache_size(
+		          vmdkmount_mount_handle,
+		          option_maximum_cache_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum cache size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum cache size.\n" );
+
+			goto on_error;
+		}
+	}
 	result = mount_handle_open_input(
 	          vmdkmount_mount_handle,
 	          source_filenames,
@@ -2248,8 +3290,45 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBFUSE3 )
+	/* This argument is required but ignored
+	 */
+	if( fuse_opt_add_arg(
+	     &vmdkmount_fuse_arguments,
+	     "" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	/* Request large reads by default, these can be overridden by the extended options
+	 */
+	if( fuse_opt_add_arg(
+	     &vmdkmount_fuse_arguments,
+	     "-o" ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+	if( fuse_opt_add_arg(
+	     &vmdkmount_fuse_arguments,
+	     VMDKMOUNT_FUSE_DEFAULT_OPTIONS ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable add fuse arguments.\n" );
+
+		goto on_error;
+	}
+#endif
 	if( option_extended_options != NULL )
 	{
+#if !defined( HAVE_LIBFUSE3 )
 		/* This argument is required but ignored
 		 */
 		if( fuse_opt_add_arg(
@@ -2262,6 +3341,7 @@ int main( int argc, char * const argv[] )
 
 			goto on_error;
 		}
+#endif
 		if( fuse_opt_add_arg(
 		     &vmdkmount_fuse_arguments,
 		     "-o" ) != 0 )
@@ -2285,10 +3365,51 @@ int main( int argc, char * const argv[] )
 	}
 	vmdkmount_fuse_operations.open    = &vmdkmount_fuse_open;
 	vmdkmount_fuse_operations.read    = &vmdkmount_fuse_read;
+	vmdkmount_fuse_operations.release = &vmdkmount_fuse_release;
 	vmdkmount_fuse_operations.readdir = &vmdkmount_fuse_readdir;
 	vmdkmount_fuse_operations.getattr = &vmdkmount_fuse_getattr;
 	vmdkmount_fuse_operations.destroy = &vmdkmount_fuse_destroy;
 
+	if( write_access != 0 )
+	{
+		vmdkmount_fuse_operations.write     = &vmdkmount_fuse_write;
+#if defined( VMDKMOUNT_HAVE_FUSE_FALLOCATE )
+		vmdkmount_fuse_operations.fallocate = &vmdkmount_fuse_fallocate;
+#endif
+	}
+#if defined( VMDKMOUNT_HAVE_FUSE_LSEEK )
+	vmdkmount_fuse_operations.lseek = &vmdkmount_fuse_lseek;
+#endif
+
+#if defined( HAVE_LIBFUSE3 )
+	vmdkmount_fuse_handle = fuse_new(
+	                         &vmdkmount_fuse_arguments,
+	                         &vmdkmount_fuse_operations,
+	                         sizeof( struct fuse_operations ),
+	                         vmdkmount_mount_handle );
+
+	if( vmdkmount_fuse_handle == NULL )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to create fuse handle.\n" );
+
+		goto on_error;
+	}
+	result = fuse_mount(
+	          vmdkmount_fuse_handle,
+	          mount_point );
+
+	if( result != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to fuse mount file system.\n" );
+
+		goto on_error;
+	}
+#else
+
 	vmdkmount_fuse_channel = fuse_mount(
 	                          mount_point,
 	                          &vmdkmount_fuse_arguments );
@@ -2316,6 +3437,8 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+#endif /* defined( HAVE_LIBFUSE3 ) */
+
 	if( verbose == 0 )
 	{
 		if( fuse_daemonize(
@@ -2328,8 +3451,64 @@ int main( int argc, char * const argv[] )
 			goto on_error;
 		}
 	}
-	result = fuse_loop(
-	          vmdkmount_fuse_handle );
+	if( vmdkmount_mount_handle->number_of_threads > 1 )
+	{
+		/* The reads and writes are positional hence the requests
+		 * can be served by multiple threads, the mount handle provides
+		 * every read with input handles that are not in use by another thread
+		 */
+#if defined( HAVE_FUSE_LOOP_CFG_SET_MAX_THREADS )
+		vmdkmount_fuse_loop_config = fuse_loop_cfg_create();
+
+		if( vmdkmount_fuse_loop_config == NULL )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to create fuse loop configuration.\n" );
+
+			goto on_error;
+		}
+		fuse_loop_cfg_set_clone_fd(
+		 vmdkmount_fuse_loop_config,
+		 0 );
+
+		fuse_loop_cfg_set_max_threads(
+		 vmdkmount_fuse_loop_config,
+		 (unsigned int) vmdkmount_mount_handle->number_of_threads );
+
+		fuse_loop_cfg_set_idle_threads(
+		 vmdkmount_fuse_loop_config,
+		 (unsigned int) vmdkmount_mount_handle->number_of_threads );
+
+		result = fuse_loop_mt(
+		          vmdkmount_fuse_handle,
+		          vmdkmount_fuse_loop_config );
+
+		fuse_loop_cfg_destroy(
+		 vmdkmount_fuse_loop_config );
+
+		vmdkmount_fuse_loop_config = NULL;
+
+#elif defined( HAVE_LIBFUSE3 )
+		/* Before FUSE 3.12 the number of threads of the multi-threaded loop
+		 * cannot be limited, only the number of idle threads
+		 */
+		vmdkmount_fuse_loop_config.clone_fd         = 0;
+		vmdkmount_fuse_loop_config.max_idle_threads = (unsigned int) vmdkmount_mount_handle->number_of_threads;
+
+		result = fuse_loop_mt(
+		          vmdkmount_fuse_handle,
+		          &vmdkmount_fuse_loop_config );
+#else
+		result = fuse_loop_mt(
+		          vmdkmount_fuse_handle );
+#endif
+	}
+	else
+	{
+		result = fuse_loop(
+		          vmdkmount_fuse_handle );
+	}
 
 	if( result != 0 )
 	{
@@ -2339,6 +3518,10 @@ int main( int argc, char * const argv[] )
 
 		goto on_error;
 	}
+#if defined( HAVE_LIBFUSE3 )
+	fuse_unmount(
+	 vmdkmount_fuse_handle );
+#endif
 	fuse_destroy(
 	 vmdkmount_fuse_handle );
 
@@ -2372,6 +3555,11 @@ int main( int argc, char * const argv[] )
 	}
 	vmdkmount_dokan_options.Version     = 600;
 	vmdkmount_dokan_options.ThreadCount = 0;
+
+	if( option_number_of_threads != NULL )
+	{
+		vmdkmount_dokan_options.ThreadCount = (USHORT) vmdkmount_mount_handle->number_of_threads;
+	}
 	vmdkmount_dokan_options.MountPoint  = mount_point;
 
 	if( verbose != 0 )
@@ -2482,6 +3670,13 @@ on_error:
 		 &error );
 	}
 #if defined( HAVE_LIBFUSE ) || defined( HAVE_LIBOSXFUSE )
+#if defined( HAVE_FUSE_LOOP_CFG_SET_MAX_THREADS )
+	if( vmdkmount_fuse_loop_config != NULL )
+	{
+		fuse_loop_cfg_destroy(
+		 vmdkmount_fuse_loop_config );
+	}
+#endif
 	if( vmdkmount_fuse_handle != NULL )
 	{
 		fuse_destroy(
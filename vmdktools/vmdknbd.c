@@ -0,0 +1,444 @@
+/*
+ * Serves VMware Virtual Disk (VMDK) images read-only using the
+ * Network Block Device (NBD) protocol
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "nbd_handle.h"
+#include "vmdktools_getopt.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libclocale.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libvmdk.h"
+#include "vmdktools_output.h"
+#include "vmdktools_signal.h"
+#include "vmdktools_unused.h"
+
+nbd_handle_t *vmdknbd_nbd_handle = NULL;
+int vmdknbd_abort                = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vmdknbd to serve the data of one or more VMware Virtual Disk (VMDK)\n"
+	                 "images, including their parents, read-only using the Network Block\n"
+	                 "Device (NBD) protocol.\n\n" );
+
+	fprintf( stream, "Usage: vmdknbd [ -c cache_size ] [ -p port ] [ -s socket ] [ -hvV ]\n"
+	                 "               image [ image ... ]\n\n" );
+
+	fprintf( stream, "\timage:     a VMDK image, exported using its filename without directory\n\n" );
+
+	fprintf( stream, "\t-c:        specify the maximum size of the grain data cache in MiB,\n"
+	                 "\t           the cache is shared by all images and their parents\n" );
+	fprintf( stream, "\t-h:        shows this help\n" );
+	fprintf( stream, "\t-p:        listen on a TCP port of the loopback address\n" );
+	fprintf( stream, "\t-s:        listen on a Unix domain socket at the path\n" );
+	fprintf( stream, "\t-v:        verbose output to stderr\n" );
+	fprintf( stream, "\t-V:        print version\n" );
+}
+
+/* Signal handler for vmdknbd
+ */
+void vmdknbd_signal_handler(
+      vmdktools_signal_t signal VMDKTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "vmdknbd_signal_handler";
+
+	VMDKTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vmdknbd_abort = 1;
+
+	if( vmdknbd_nbd_handle != NULL )
+	{
+		if( nbd_handle_signal_abort(
+		     vmdknbd_nbd_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal NBD handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	libvmdk_error_t *error                        = NULL;
+	system_character_t *option_maximum_cache_size = NULL;
+	system_character_t *option_port               = NULL;
+	system_character_t *socket_path               = NULL;
+	char *program                                 = "vmdknbd";
+	system_integer_t option                       = 0;
+	int result                                    = 0;
+	int verbose                                   = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "vmdktools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vmdkoutput_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vmdktools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "c:hp:s:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'c':
+				option_maximum_cache_size = optarg;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 'p':
+				option_port = optarg;
+
+				break;
+
+			case (system_integer_t) 's':
+				socket_path = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vmdkoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source image.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	if( ( option_port == NULL )
+	 && ( socket_path == NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Missing port or socket.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	if( ( option_port != NULL )
+	 && ( socket_path != NULL ) )
+	{
+		fprintf(
+		 stderr,
+		 "Port and socket cannot be combined.\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	libcnotify_verbose_set(
+	 verbose );
+	libvmdk_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvmdk_notify_set_verbose(
+	 verbose );
+
+#if defined( NBD_HANDLE_HAVE_SOCKET_SUPPORT )
+	if( nbd_handle_initialize(
+	     &vmdknbd_nbd_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize NBD handle.\n" );
+
+		goto on_error;
+	}
+	if( option_port != NULL )
+	{
+		result = nbd_handle_set_port(
+		          vmdknbd_nbd_handle,
+		          option_port,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set port.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported port: %" PRIs_SYSTEM ".\n",
+			 option_port );
+
+			goto on_error;
+		}
+	}
+	if( option_maximum_cache_size != NULL )
+	{
+		result = nbd_handle_set_maximum_cache_size(
+		          vmdknbd_nbd_handle,
+		          option_maximum_cache_size,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set maximum cache size.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported maximum cache size: %" PRIs_SYSTEM ".\n",
+			 option_maximum_cache_size );
+
+			goto on_error;
+		}
+	}
+	while( optind < argc )
+	{
+		result = nbd_handle_open_input(
+		          vmdknbd_nbd_handle,
+		          argv[ optind ],
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to open source image: %" PRIs_SYSTEM ".\n",
+			 argv[ optind ] );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported disk type: %" PRIs_SYSTEM ".\n",
+			 argv[ optind ] );
+
+			goto on_error;
+		}
+		optind++;
+	}
+	if( nbd_handle_open_socket(
+	     vmdknbd_nbd_handle,
+	     socket_path,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open socket.\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_signal_attach(
+	     vmdknbd_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( socket_path != NULL )
+	{
+		fprintf(
+		 stdout,
+		 "Serving on Unix domain socket: %" PRIs_SYSTEM "\n",
+		 socket_path );
+	}
+	else
+	{
+		fprintf(
+		 stdout,
+		 "Serving on: 127.0.0.1:%" PRIu16 "\n",
+		 vmdknbd_nbd_handle->port );
+	}
+	result = nbd_handle_serve(
+	          vmdknbd_nbd_handle,
+	          &error );
+
+	if( vmdktools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to serve images.\n" );
+
+		goto on_error;
+	}
+	if( nbd_handle_close(
+	     vmdknbd_nbd_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close NBD handle.\n" );
+
+		goto on_error;
+	}
+	if( nbd_handle_free(
+	     &vmdknbd_nbd_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free NBD handle.\n" );
+
+		goto on_error;
+	}
+	return( EXIT_SUCCESS );
+#else
+	fprintf(
+	 stderr,
+	 "No socket support to serve VMDK.\n" );
+
+	return( EXIT_FAILURE );
+#endif
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vmdknbd_nbd_handle != NULL )
+	{
+		nbd_handle_free(
+		 &vmdknbd_nbd_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+
@@ -0,0 +1,406 @@
+/*
+ * Verifies the integrity of a VMware Virtual Disk (VMDK) file
+ *
+ * Copyright (C) 2009-2017, Joachim Metz <joachim.metz@gmail.com>
+ *
+ * Refer to AUTHORS for acknowledgements.
+ *
+ * This software is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+
+#include <common.h>
+#include <file_stream.h>
+#include <memory.h>
+#include <system_string.h>
+#include <types.h>
+
+#if defined( HAVE_UNISTD_H )
+#include <unistd.h>
+#endif
+
+#if defined( HAVE_STDLIB_H ) || defined( WINAPI )
+#include <stdlib.h>
+#endif
+
+#include "verify_handle.h"
+#include "vmdktools_getopt.h"
+#include "vmdktools_libcerror.h"
+#include "vmdktools_libclocale.h"
+#include "vmdktools_libcnotify.h"
+#include "vmdktools_libvmdk.h"
+#include "vmdktools_output.h"
+#include "vmdktools_signal.h"
+#include "vmdktools_unused.h"
+
+verify_handle_t *vmdkverify_verify_handle = NULL;
+int vmdkverify_abort                      = 0;
+
+/* Prints the executable usage information
+ */
+void usage_fprint(
+      FILE *stream )
+{
+	if( stream == NULL )
+	{
+		return;
+	}
+	fprintf( stream, "Use vmdkverify to verify the integrity of a VMware Virtual Disk (VMDK)\n"
+	                 "image file.\n\n" );
+
+	fprintf( stream, "Usage: vmdkverify [ -t threads ] [ -dhvV ] source\n\n" );
+
+	fprintf( stream, "\tsource: the source file(s)\n\n" );
+
+	fprintf( stream, "\t-d:     decompresses all compressed grains to validate their deflate\n"
+	                 "\t        streams and Adler-32 checksums, by default only the grain\n"
+	                 "\t        directories and grain tables are verified\n" );
+	fprintf( stream, "\t-h:     shows this help\n" );
+	fprintf( stream, "\t-t:     specify the number of threads used to decompress\n"
+	                 "\t        the compressed grains, default is %d\n",
+	         VERIFY_HANDLE_DEFAULT_NUMBER_OF_THREADS );
+	fprintf( stream, "\t-v:     verbose output to stderr\n" );
+	fprintf( stream, "\t-V:     print version\n" );
+}
+
+/* Signal handler for vmdkverify
+ */
+void vmdkverify_signal_handler(
+      vmdktools_signal_t signal VMDKTOOLS_ATTRIBUTE_UNUSED )
+{
+	libcerror_error_t *error = NULL;
+	static char *function   = "vmdkverify_signal_handler";
+
+	VMDKTOOLS_UNREFERENCED_PARAMETER( signal )
+
+	vmdkverify_abort = 1;
+
+	if( vmdkverify_verify_handle != NULL )
+	{
+		if( verify_handle_signal_abort(
+		     vmdkverify_verify_handle,
+		     &error ) != 1 )
+		{
+			libcnotify_printf(
+			 "%s: unable to signal verification handle to abort.\n",
+			 function );
+
+			libcnotify_print_error_backtrace(
+			 error );
+			libcerror_error_free(
+			 &error );
+		}
+	}
+	/* Force stdin to close otherwise any function reading it will remain blocked
+	 */
+#if defined( WINAPI ) && !defined( __CYGWIN__ )
+	if( _close(
+	     0 ) != 0 )
+#else
+	if( close(
+	     0 ) != 0 )
+#endif
+	{
+		libcnotify_printf(
+		 "%s: unable to close stdin.\n",
+		 function );
+	}
+}
+
+/* The main program
+ */
+#if defined( HAVE_WIDE_SYSTEM_CHARACTER )
+int wmain( int argc, wchar_t * const argv[] )
+#else
+int main( int argc, char * const argv[] )
+#endif
+{
+	system_character_t * const *source_filenames = NULL;
+	libvmdk_error_t *error                       = NULL;
+	system_character_t *option_number_of_threads = NULL;
+	char *program                                = "vmdkverify";
+	system_integer_t option                      = 0;
+	uint8_t verification_flags                   = 0;
+	int number_of_source_filenames               = 0;
+	int result                                   = 0;
+	int verbose                                  = 0;
+
+	libcnotify_stream_set(
+	 stderr,
+	 NULL );
+	libcnotify_verbose_set(
+	 1 );
+
+	if( libclocale_initialize(
+             "vmdktools",
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize locale values.\n" );
+
+		goto on_error;
+	}
+        if( vmdktools_output_initialize(
+             _IONBF,
+             &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize output settings.\n" );
+
+		goto on_error;
+	}
+	vmdkoutput_version_fprint(
+	 stdout,
+	 program );
+
+	while( ( option = vmdktools_getopt(
+	                   argc,
+	                   argv,
+	                   _SYSTEM_STRING( "dht:vV" ) ) ) != (system_integer_t) -1 )
+	{
+		switch( option )
+		{
+			case (system_integer_t) '?':
+			default:
+				fprintf(
+				 stderr,
+				 "Invalid argument: %" PRIs_SYSTEM "\n",
+				 argv[ optind - 1 ] );
+
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_FAILURE );
+
+			case (system_integer_t) 'd':
+				verification_flags |= LIBVMDK_VERIFICATION_FLAG_DECOMPRESS_GRAINS;
+
+				break;
+
+			case (system_integer_t) 'h':
+				usage_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+
+			case (system_integer_t) 't':
+				option_number_of_threads = optarg;
+
+				break;
+
+			case (system_integer_t) 'v':
+				verbose = 1;
+
+				break;
+
+			case (system_integer_t) 'V':
+				vmdkoutput_copyright_fprint(
+				 stdout );
+
+				return( EXIT_SUCCESS );
+		}
+	}
+	if( optind == argc )
+	{
+		fprintf(
+		 stderr,
+		 "Missing source file(s).\n" );
+
+		usage_fprint(
+		 stdout );
+
+		return( EXIT_FAILURE );
+	}
+	source_filenames           = &( argv[ optind ] );
+	number_of_source_filenames = argc - optind;
+
+	libcnotify_verbose_set(
+	 verbose );
+	libvmdk_notify_set_stream(
+	 stderr,
+	 NULL );
+	libvmdk_notify_set_verbose(
+	 verbose );
+
+	if( verify_handle_initialize(
+	     &vmdkverify_verify_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to initialize verification handle.\n" );
+
+		goto on_error;
+	}
+	vmdkverify_verify_handle->verification_flags = verification_flags;
+
+	if( option_number_of_threads != NULL )
+	{
+		result = verify_handle_set_number_of_threads(
+		          vmdkverify_verify_handle,
+		          option_number_of_threads,
+		          &error );
+
+		if( result == -1 )
+		{
+			fprintf(
+			 stderr,
+			 "Unable to set number of threads.\n" );
+
+			goto on_error;
+		}
+		else if( result == 0 )
+		{
+			fprintf(
+			 stderr,
+			 "Unsupported number of threads.\n" );
+
+			goto on_error;
+		}
+	}
+	if( verify_handle_open_input(
+	     vmdkverify_verify_handle,
+	     source_filenames,
+	     number_of_source_filenames,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to open source file(s).\n" );
+
+		goto on_error;
+	}
+	if( vmdktools_signal_attach(
+	     vmdkverify_signal_handler,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to attach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	result = verify_handle_verify_extents(
+	          vmdkverify_verify_handle,
+	          &error );
+
+	if( result == 1 )
+	{
+		result = verify_handle_ranges_fprint(
+		          vmdkverify_verify_handle,
+		          &error );
+	}
+	if( vmdktools_signal_detach(
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to detach signal handler.\n" );
+
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( ( result == -1 )
+	 && ( vmdkverify_abort == 0 ) )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to verify image.\n" );
+
+		goto on_error;
+	}
+	if( verify_handle_close(
+	     vmdkverify_verify_handle,
+	     &error ) != 0 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to close verification handle.\n" );
+
+		goto on_error;
+	}
+	if( vmdkverify_abort != 0 )
+	{
+		if( error != NULL )
+		{
+			libcerror_error_free(
+			 &error );
+		}
+		verify_handle_free(
+		 &vmdkverify_verify_handle,
+		 NULL );
+
+		fprintf(
+		 stdout,
+		 "Verify: ABORTED\n" );
+
+		return( EXIT_FAILURE );
+	}
+	/* Any grain directory mismatch, out of bounds or overlapping grain or corrupted grain fails the verification
+	 */
+	if( vmdkverify_verify_handle->number_of_issues != 0 )
+	{
+		result = 0;
+	}
+	if( verify_handle_free(
+	     &vmdkverify_verify_handle,
+	     &error ) != 1 )
+	{
+		fprintf(
+		 stderr,
+		 "Unable to free verification handle.\n" );
+
+		goto on_error;
+	}
+	if( result != 1 )
+	{
+		fprintf(
+		 stdout,
+		 "Verify: FAILURE\n" );
+
+		return( EXIT_FAILURE );
+	}
+	fprintf(
+	 stdout,
+	 "Verify: SUCCESS\n" );
+
+	return( EXIT_SUCCESS );
+
+on_error:
+	if( error != NULL )
+	{
+		libcnotify_print_error_backtrace(
+		 error );
+		libcerror_error_free(
+		 &error );
+	}
+	if( vmdkverify_verify_handle != NULL )
+	{
+		verify_handle_close(
+		 vmdkverify_verify_handle,
+		 NULL );
+		verify_handle_free(
+		 &vmdkverify_verify_handle,
+		 NULL );
+	}
+	return( EXIT_FAILURE );
+}
+